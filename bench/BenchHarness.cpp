@@ -0,0 +1,276 @@
+#include "BenchHarness.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+
+namespace VulkanGameEngine {
+namespace Bench {
+
+namespace {
+
+struct Entry {
+    const char* name;
+    BenchmarkFunction function;
+};
+
+std::vector<Entry>& getRegistry() {
+    static std::vector<Entry> registry;
+    return registry;
+}
+
+/**
+ * Result of one benchmark over all repetitions
+ */
+struct Result {
+    std::string name;
+    bool skipped = false;
+    std::string skipReason;
+    uint64_t iterations = 0;
+    double medianNs = 0.0;                  // Per iteration
+    double minNs = 0.0;
+    double maxNs = 0.0;
+    double itemsPerSecond = 0.0;
+    double bytesPerSecond = 0.0;
+};
+
+// Upper bound on calibrated iterations, so near-empty loops still finish
+constexpr uint64_t MAX_ITERATIONS = 1ull << 32;
+
+double runOnce(BenchmarkFunction function, State& state) {
+    function(state);
+    return state.getElapsedNs();
+}
+
+Result runBenchmark(const Entry& entry, const Options& options) {
+    Result result;
+    result.name = entry.name;
+
+    // Calibrate: grow the iteration count until one run reaches the minimum time
+    const double minTimeNs = options.minTimeSeconds * 1e9;
+    uint64_t iterations = 1;
+    for (;;) {
+        State state(iterations);
+        const double elapsedNs = runOnce(entry.function, state);
+        if (!state.getSkipReason().empty()) {
+            result.skipped = true;
+            result.skipReason = state.getSkipReason();
+            return result;
+        }
+        if (elapsedNs >= minTimeNs || iterations >= MAX_ITERATIONS) {
+            break;
+        }
+        // Aim slightly past the target, growing at most 10x per step
+        const double scale = elapsedNs > 0.0 ? minTimeNs * 1.2 / elapsedNs : 10.0;
+        iterations = std::min<uint64_t>(MAX_ITERATIONS,
+            static_cast<uint64_t>(static_cast<double>(iterations) * std::max(2.0, std::min(10.0, scale))));
+    }
+
+    std::vector<double> perIterationNs;
+    uint64_t itemsPerIteration = 0;
+    uint64_t bytesPerIteration = 0;
+    for (uint32_t repetition = 0; repetition < std::max(1u, options.repetitions); ++repetition) {
+        State state(iterations);
+        const double elapsedNs = runOnce(entry.function, state);
+        perIterationNs.push_back(elapsedNs / static_cast<double>(iterations));
+        itemsPerIteration = state.getItemsPerIteration();
+        bytesPerIteration = state.getBytesPerIteration();
+    }
+
+    std::sort(perIterationNs.begin(), perIterationNs.end());
+    result.iterations = iterations;
+    result.minNs = perIterationNs.front();
+    result.maxNs = perIterationNs.back();
+    result.medianNs = perIterationNs[perIterationNs.size() / 2];
+    if (result.medianNs > 0.0) {
+        result.itemsPerSecond = static_cast<double>(itemsPerIteration) * 1e9 / result.medianNs;
+        result.bytesPerSecond = static_cast<double>(bytesPerIteration) * 1e9 / result.medianNs;
+    }
+    return result;
+}
+
+bool writeJson(const std::string& path, const std::vector<Result>& results) {
+    std::ofstream file(path, std::ios::out | std::ios::trunc);
+    if (!file.is_open()) {
+        std::cerr << "Cannot write " << path << std::endl;
+        return false;
+    }
+
+    // One benchmark per line, so baselines can be read back without a JSON parser
+    file << "{\n  \"benchmarks\": [\n";
+    bool first = true;
+    char line[512];
+    for (const Result& result : results) {
+        if (result.skipped) {
+            continue;
+        }
+        std::snprintf(line, sizeof(line),
+                      "%s    {\"name\": \"%s\", \"iterations\": %llu, \"medianNs\": %.3f, \"minNs\": %.3f, "
+                      "\"maxNs\": %.3f, \"itemsPerSecond\": %.1f, \"bytesPerSecond\": %.1f}",
+                      first ? "" : ",\n", result.name.c_str(), static_cast<unsigned long long>(result.iterations),
+                      result.medianNs, result.minNs, result.maxNs, result.itemsPerSecond, result.bytesPerSecond);
+        file << line;
+        first = false;
+    }
+    file << "\n  ]\n}\n";
+    return file.good();
+}
+
+/**
+ * Reads name -> medianNs from a file written by writeJson
+ */
+bool readBaseline(const std::string& path, std::map<std::string, double>& medians) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "Cannot read baseline " << path << std::endl;
+        return false;
+    }
+
+    const std::string nameKey = "\"name\": \"";
+    const std::string medianKey = "\"medianNs\": ";
+    std::string line;
+    while (std::getline(file, line)) {
+        const size_t nameStart = line.find(nameKey);
+        const size_t medianStart = line.find(medianKey);
+        if (nameStart == std::string::npos || medianStart == std::string::npos) {
+            continue;
+        }
+        const size_t valueStart = nameStart + nameKey.size();
+        const size_t valueEnd = line.find('"', valueStart);
+        if (valueEnd == std::string::npos) {
+            continue;
+        }
+        medians[line.substr(valueStart, valueEnd - valueStart)] =
+            std::strtod(line.c_str() + medianStart + medianKey.size(), nullptr);
+    }
+    return true;
+}
+
+void printUsage() {
+    std::cout << "Usage: engine_bench [options]\n"
+              << "  --filter <text>          Run benchmarks whose name contains <text>\n"
+              << "  --min-time <seconds>     Minimum duration of one repetition (default 0.2)\n"
+              << "  --repetitions <n>        Repetitions per benchmark (default 5)\n"
+              << "  --json <path>            Write results as JSON\n"
+              << "  --baseline <path>        Compare medians against a previous --json file\n"
+              << "  --max-regression <pct>   Slowdown that fails the comparison (default 10)\n"
+              << "  --list                   List benchmarks without running them\n";
+}
+
+} // anonymous namespace
+
+bool State::startOrFinish() {
+    if (!m_started) {
+        m_started = true;
+        m_start = std::chrono::steady_clock::now();
+        m_end = m_start;
+        if (!m_skipReason.empty() || m_iterations == 0) {
+            return false;
+        }
+        m_remaining = m_iterations - 1;
+        return true;
+    }
+    m_end = std::chrono::steady_clock::now();
+    return false;
+}
+
+Registrar::Registrar(const char* name, BenchmarkFunction function) {
+    getRegistry().push_back({name, function});
+}
+
+#if defined(_MSC_VER)
+void useCharPointer(const volatile char*) {}
+#endif
+
+bool parseOptions(int argc, char* argv[], Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string argument = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (argument == "--filter" && hasValue) {
+            options.filter = argv[++i];
+        } else if (argument == "--min-time" && hasValue) {
+            options.minTimeSeconds = std::strtod(argv[++i], nullptr);
+        } else if (argument == "--repetitions" && hasValue) {
+            options.repetitions = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (argument == "--json" && hasValue) {
+            options.jsonPath = argv[++i];
+        } else if (argument == "--baseline" && hasValue) {
+            options.baselinePath = argv[++i];
+        } else if (argument == "--max-regression" && hasValue) {
+            options.maxRegressionPercent = std::strtod(argv[++i], nullptr);
+        } else if (argument == "--list") {
+            options.listOnly = true;
+        } else {
+            std::cerr << "Unknown argument: " << argument << std::endl;
+            printUsage();
+            return false;
+        }
+    }
+    return true;
+}
+
+int runBenchmarks(const Options& options) {
+    std::vector<Entry> entries = getRegistry();
+    std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+        return std::string(a.name) < std::string(b.name);
+    });
+
+    std::map<std::string, double> baseline;
+    if (!options.baselinePath.empty() && !readBaseline(options.baselinePath, baseline)) {
+        return 1;
+    }
+
+    std::printf("%-40s %12s %14s %14s %14s %10s\n", "Benchmark", "Iterations", "Median ns/op", "Min ns/op",
+                "Items/s", baseline.empty() ? "" : "vs base");
+
+    std::vector<Result> results;
+    uint32_t regressions = 0;
+    for (const Entry& entry : entries) {
+        if (!options.filter.empty() && std::string(entry.name).find(options.filter) == std::string::npos) {
+            continue;
+        }
+        if (options.listOnly) {
+            std::printf("%s\n", entry.name);
+            continue;
+        }
+
+        const Result result = runBenchmark(entry, options);
+        results.push_back(result);
+        if (result.skipped) {
+            std::printf("%-40s skipped: %s\n", result.name.c_str(), result.skipReason.c_str());
+            continue;
+        }
+
+        char change[32] = "";
+        auto previous = baseline.find(result.name);
+        if (previous != baseline.end() && previous->second > 0.0) {
+            const double percent = (result.medianNs / previous->second - 1.0) * 100.0;
+            const bool regressed = percent > options.maxRegressionPercent;
+            regressions += regressed ? 1 : 0;
+            std::snprintf(change, sizeof(change), "%+.1f%%%s", percent, regressed ? " !" : "");
+        }
+
+        char items[32] = "-";
+        if (result.itemsPerSecond > 0.0) {
+            std::snprintf(items, sizeof(items), "%.3g", result.itemsPerSecond);
+        }
+        std::printf("%-40s %12llu %14.1f %14.1f %14s %10s\n", result.name.c_str(),
+                    static_cast<unsigned long long>(result.iterations), result.medianNs, result.minNs, items, change);
+        std::fflush(stdout);
+    }
+
+    if (!options.jsonPath.empty() && writeJson(options.jsonPath, results)) {
+        std::printf("Results written to %s\n", options.jsonPath.c_str());
+    }
+    if (regressions > 0) {
+        std::printf("%u benchmark(s) regressed by more than %.1f%% against %s\n", regressions,
+                    options.maxRegressionPercent, options.baselinePath.c_str());
+        return 1;
+    }
+    return 0;
+}
+
+} // namespace Bench
+} // namespace VulkanGameEngine
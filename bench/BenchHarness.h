@@ -0,0 +1,160 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace VulkanGameEngine {
+namespace Bench {
+
+/**
+ * Minimal microbenchmark harness for engine_bench.
+ *
+ * A benchmark is a function that does its setup, then loops on
+ * state.keepRunning() around the code being measured:
+ *
+ *   void benchParseFace(Bench::State& state) {
+ *       ObjLoader::OBJData data = makeData();
+ *       while (state.keepRunning()) {
+ *           ObjLoader::parseFaceLine("f 1/1/1 2/2/2 3/3/3", data);
+ *       }
+ *       state.setItemsPerIteration(1);
+ *   }
+ *   ENGINE_BENCHMARK("obj/parse_face_line", benchParseFace);
+ *
+ * The runner grows the iteration count until one run takes at least the
+ * minimum time, then repeats the run and reports the median and minimum
+ * time per iteration. Results can be written as JSON and compared against
+ * a baseline file to catch regressions.
+ */
+class State {
+public:
+    explicit State(uint64_t iterations)
+        : m_iterations(iterations)
+        , m_remaining(0)
+        , m_started(false)
+        , m_itemsPerIteration(0)
+        , m_bytesPerIteration(0) {
+    }
+
+    /**
+     * Returns true while iterations remain. The first call starts the clock
+     * and the final call (returning false) stops it.
+     */
+    bool keepRunning() {
+        if (m_remaining > 0) {
+            --m_remaining;
+            return true;
+        }
+        return startOrFinish();
+    }
+
+    uint64_t getIterations() const { return m_iterations; }
+
+    /**
+     * Items (vertices, lines, log records, ...) one iteration processes; reported as items/s
+     */
+    void setItemsPerIteration(uint64_t items) { m_itemsPerIteration = items; }
+
+    /**
+     * Bytes one iteration processes; reported as bytes/s in the JSON results
+     */
+    void setBytesPerIteration(uint64_t bytes) { m_bytesPerIteration = bytes; }
+
+    /**
+     * Marks the benchmark as not runnable (missing asset, ...); it is listed but not timed
+     */
+    void skip(const std::string& reason) { m_skipReason = reason; m_remaining = 0; }
+
+    /**
+     * Excludes per-iteration setup from the measured time
+     */
+    void pauseTiming() { m_pausedAt = std::chrono::steady_clock::now(); }
+    void resumeTiming() { m_start += std::chrono::steady_clock::now() - m_pausedAt; }
+
+    // Results, read by the runner once keepRunning() has returned false
+    double getElapsedNs() const { return std::chrono::duration<double, std::nano>(m_end - m_start).count(); }
+    const std::string& getSkipReason() const { return m_skipReason; }
+    uint64_t getItemsPerIteration() const { return m_itemsPerIteration; }
+    uint64_t getBytesPerIteration() const { return m_bytesPerIteration; }
+
+private:
+    uint64_t m_iterations;
+    uint64_t m_remaining;
+    bool m_started;
+    uint64_t m_itemsPerIteration;
+    uint64_t m_bytesPerIteration;
+    std::string m_skipReason;
+    std::chrono::steady_clock::time_point m_start;
+    std::chrono::steady_clock::time_point m_end;
+    std::chrono::steady_clock::time_point m_pausedAt;
+
+    bool startOrFinish();
+};
+
+using BenchmarkFunction = void (*)(State&);
+
+/**
+ * Adds a benchmark to the global list at static initialization
+ */
+struct Registrar {
+    Registrar(const char* name, BenchmarkFunction function);
+};
+
+/**
+ * Keeps the compiler from optimizing away a value that is otherwise unused
+ */
+#if defined(_MSC_VER)
+void useCharPointer(const volatile char* pointer);
+
+template <typename T>
+inline void doNotOptimize(const T& value) {
+    useCharPointer(&reinterpret_cast<const volatile char&>(value));
+    _ReadWriteBarrier();
+}
+#else
+template <typename T>
+inline void doNotOptimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+#endif
+
+/**
+ * Command-line options of the runner
+ */
+struct Options {
+    std::string filter;                     // Only run benchmarks whose name contains this
+    double minTimeSeconds = 0.2;            // Minimum duration of one repetition
+    uint32_t repetitions = 5;
+    std::string jsonPath;                   // Write results here (empty = no file)
+    std::string baselinePath;               // Compare against a previous JSON result
+    double maxRegressionPercent = 10.0;     // Median slowdown that fails the comparison
+    bool listOnly = false;
+};
+
+/**
+ * Parses runner options
+ *
+ * @return false (after printing usage) on unknown arguments
+ */
+bool parseOptions(int argc, char* argv[], Options& options);
+
+/**
+ * Runs every registered benchmark matching the filter and prints a table
+ *
+ * @return Process exit code: non-zero if a baseline comparison found regressions
+ */
+int runBenchmarks(const Options& options);
+
+} // namespace Bench
+} // namespace VulkanGameEngine
+
+#define BENCH_CONCAT_INNER(a, b) a##b
+#define BENCH_CONCAT(a, b) BENCH_CONCAT_INNER(a, b)
+#define ENGINE_BENCHMARK(name, function) \
+    static VulkanGameEngine::Bench::Registrar BENCH_CONCAT(_benchRegistrar, __LINE__)(name, function)
@@ -0,0 +1,824 @@
+#include "BenchHarness.h"
+#include "Common.h"
+#include "ObjLoader.h"
+#include "MeshProcessing.h"
+#include "MeshAsset.h"
+#include "GeometryCodec.h"
+#include "AnimationSystem.h"
+#include "MainCharacter.h"
+#include "VulkanEngine.h"
+#include "NullRenderBackend.h"
+#include "CommandList.h"
+#include "DynamicMesh.h"
+#include "Scene.h"
+#include "SceneGenerator.h"
+#include "Logger.h"
+#include "Profiler.h"
+#include "Metrics.h"
+#include "HitchDetector.h"
+#include "AllocationTracker.h"
+#include "VulkanCallStats.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+using namespace VulkanGameEngine;
+
+/**
+ * engine_bench: CPU microbenchmarks of the engine's loader and per-frame paths.
+ *
+ * Nothing here needs a GPU: meshes are parsed from memory (or the bundled
+ * asset when it is found), and the frame benchmarks render through the null
+ * backend. Run from the repository root so assets/FinalBaseMesh.obj is found.
+ */
+
+namespace {
+
+constexpr const char* CHARACTER_ASSET = "assets/FinalBaseMesh.obj";
+
+// Vertices per side of the synthetic grid mesh (quads are triangulated by the loader)
+constexpr uint32_t GRID_SIZE = 100;
+
+/**
+ * Builds OBJ text for a GRID_SIZE x GRID_SIZE grid with positions, texture
+ * coordinates, normals and quad faces in v/vt/vn form
+ */
+const std::string& getGridOBJ() {
+    static const std::string text = [] {
+        std::string out;
+        char line[128];
+        for (uint32_t z = 0; z < GRID_SIZE; ++z) {
+            for (uint32_t x = 0; x < GRID_SIZE; ++x) {
+                std::snprintf(line, sizeof(line), "v %.4f %.4f %.4f\n", x * 0.1f, 0.01f * ((x * z) % 17), z * 0.1f);
+                out += line;
+            }
+        }
+        for (uint32_t z = 0; z < GRID_SIZE; ++z) {
+            for (uint32_t x = 0; x < GRID_SIZE; ++x) {
+                std::snprintf(line, sizeof(line), "vt %.4f %.4f\n", x / float(GRID_SIZE - 1), z / float(GRID_SIZE - 1));
+                out += line;
+            }
+        }
+        out += "vn 0.0000 1.0000 0.0000\n";
+        for (uint32_t z = 0; z + 1 < GRID_SIZE; ++z) {
+            for (uint32_t x = 0; x + 1 < GRID_SIZE; ++x) {
+                const uint32_t a = z * GRID_SIZE + x + 1;   // OBJ indices are 1-based
+                const uint32_t b = a + 1;
+                const uint32_t c = a + GRID_SIZE + 1;
+                const uint32_t d = a + GRID_SIZE;
+                std::snprintf(line, sizeof(line), "f %u/%u/1 %u/%u/1 %u/%u/1 %u/%u/1\n", a, a, b, b, c, c, d, d);
+                out += line;
+            }
+        }
+        return out;
+    }();
+    return text;
+}
+
+ObjLoader::OBJData makeGridData() {
+    ObjLoader::OBJData data;
+    std::istringstream stream(getGridOBJ());
+    ObjLoader::parseOBJStream(stream, data);
+    return data;
+}
+
+// --- OBJ loading --------------------------------------------------------------
+
+void benchParseStream(Bench::State& state) {
+    const std::string& text = getGridOBJ();
+    ObjLoader::OBJData data;
+    while (state.keepRunning()) {
+        std::istringstream stream(text);
+        Bench::doNotOptimize(ObjLoader::parseOBJStream(stream, data));
+    }
+    state.setBytesPerIteration(text.size());
+    state.setItemsPerIteration((GRID_SIZE - 1) * (GRID_SIZE - 1));  // Faces
+}
+ENGINE_BENCHMARK("obj/parse_stream_grid", benchParseStream);
+
+void benchParseAsset(Bench::State& state) {
+    std::ifstream probe(CHARACTER_ASSET);
+    if (!probe.is_open()) {
+        state.skip(std::string(CHARACTER_ASSET) + " not found (run from the repository root)");
+    }
+    probe.seekg(0, std::ios::end);
+    const uint64_t bytes = static_cast<uint64_t>(std::max<std::streamoff>(probe.tellg(), 0));
+
+    ObjLoader::OBJData data;
+    while (state.keepRunning()) {
+        Bench::doNotOptimize(ObjLoader::parseOBJFile(CHARACTER_ASSET, data));
+    }
+    state.setBytesPerIteration(bytes);
+}
+ENGINE_BENCHMARK("obj/parse_file_character", benchParseAsset);
+
+template <size_t N>
+void benchParseFace(Bench::State& state, const char* const (&lines)[N]) {
+    ObjLoader::OBJData data;
+    data.positions.assign(16, glm::vec3(0.0f));
+    data.indices.reserve(64);
+    data.texCoordIndices.reserve(64);
+    data.normalIndices.reserve(64);
+    size_t next = 0;
+    while (state.keepRunning()) {
+        data.indices.clear();
+        data.texCoordIndices.clear();
+        data.normalIndices.clear();
+        Bench::doNotOptimize(ObjLoader::parseFaceLine(lines[next], data));
+        next = (next + 1) % N;
+    }
+    state.setItemsPerIteration(1);
+}
+
+void benchParseFacePositions(Bench::State& state) {
+    static const char* const lines[] = {"f 1 2 3", "f 4 5 6", "f 7 8 9"};
+    benchParseFace(state, lines);
+}
+ENGINE_BENCHMARK("obj/parse_face_line/positions", benchParseFacePositions);
+
+void benchParseFaceTexCoords(Bench::State& state) {
+    static const char* const lines[] = {"f 1/1 2/2 3/3", "f 4/4 5/5 6/6", "f 7/7 8/8 9/9"};
+    benchParseFace(state, lines);
+}
+ENGINE_BENCHMARK("obj/parse_face_line/tex_coords", benchParseFaceTexCoords);
+
+void benchParseFaceNormals(Bench::State& state) {
+    static const char* const lines[] = {"f 1//1 2//1 3//1", "f 4//2 5//2 6//2", "f 7//3 8//3 9//3"};
+    benchParseFace(state, lines);
+}
+ENGINE_BENCHMARK("obj/parse_face_line/normals", benchParseFaceNormals);
+
+void benchParseFaceFull(Bench::State& state) {
+    static const char* const lines[] = {"f 1/1/1 2/2/1 3/3/1", "f 4/4/2 5/5/2 6/6/2", "f 7/7/3 8/8/3 9/9/3"};
+    benchParseFace(state, lines);
+}
+ENGINE_BENCHMARK("obj/parse_face_line/full", benchParseFaceFull);
+
+void benchParseFaceQuad(Bench::State& state) {
+    static const char* const lines[] = {"f 1/1/1 2/2/1 3/3/1 4/4/1", "f 5/5/2 6/6/2 7/7/2 8/8/2"};
+    benchParseFace(state, lines);
+}
+ENGINE_BENCHMARK("obj/parse_face_line/quad", benchParseFaceQuad);
+
+void benchConvertToVertices(Bench::State& state) {
+    const ObjLoader::OBJData data = makeGridData();
+    std::vector<Vertex> vertices;
+    std::vector<uint32_t> indices;
+    while (state.keepRunning()) {
+        ObjLoader::convertOBJToVertices(data, vertices, indices);
+        Bench::doNotOptimize(vertices.data());
+    }
+    state.setItemsPerIteration(data.indices.size());
+}
+ENGINE_BENCHMARK("obj/convert_to_vertices", benchConvertToVertices);
+
+// --- Geometry processing ------------------------------------------------------
+
+/**
+ * Times fn on fresh copies of a mesh (the copy is not timed)
+ */
+template <typename Fn>
+void benchMeshPass(Bench::State& state, const std::vector<Vertex>& baseVertices,
+                   const std::vector<uint32_t>& baseIndices, Fn fn) {
+    std::vector<Vertex> vertices;
+    std::vector<uint32_t> indices;
+    while (state.keepRunning()) {
+        state.pauseTiming();
+        vertices = baseVertices;
+        indices = baseIndices;
+        state.resumeTiming();
+        fn(vertices, indices);
+        Bench::doNotOptimize(vertices.data());
+    }
+    state.setItemsPerIteration(baseIndices.size() / 3);    // Triangles
+}
+
+void benchGenerateNormalsGrid(Bench::State& state) {
+    std::vector<Vertex> vertices;
+    std::vector<uint32_t> indices;
+    ObjLoader::convertOBJToVertices(makeGridData(), vertices, indices);
+    benchMeshPass(state, vertices, indices, [](std::vector<Vertex>& v, std::vector<uint32_t>& i) {
+        MeshProcessing::generateNormals(v, i);
+    });
+}
+ENGINE_BENCHMARK("geometry/normals_grid", benchGenerateNormalsGrid);
+
+void benchGenerateTangentsGrid(Bench::State& state) {
+    std::vector<Vertex> vertices;
+    std::vector<uint32_t> indices;
+    ObjLoader::convertOBJToVertices(makeGridData(), vertices, indices);
+    benchMeshPass(state, vertices, indices, [](std::vector<Vertex>& v, std::vector<uint32_t>& i) {
+        MeshProcessing::generateTangents(v, i);
+    });
+}
+ENGINE_BENCHMARK("geometry/tangents_grid", benchGenerateTangentsGrid);
+
+void benchGenerateNormalsCharacter(Bench::State& state) {
+    ObjLoader::OBJData data;
+    if (!ObjLoader::parseOBJFile(CHARACTER_ASSET, data)) {
+        state.skip(std::string(CHARACTER_ASSET) + " not found (run from the repository root)");
+    }
+    // Positions only, as from an OBJ file without vn data
+    std::vector<Vertex> vertices(data.positions.size(), Vertex{});
+    for (size_t i = 0; i < data.positions.size(); ++i) {
+        vertices[i].position = data.positions[i];
+    }
+    benchMeshPass(state, vertices, data.indices, [](std::vector<Vertex>& v, std::vector<uint32_t>& i) {
+        MeshProcessing::generateNormals(v, i);
+    });
+}
+ENGINE_BENCHMARK("geometry/normals_character", benchGenerateNormalsCharacter);
+
+void benchVertexCacheGrid(Bench::State& state) {
+    std::vector<Vertex> vertices;
+    std::vector<uint32_t> indices;
+    ObjLoader::convertOBJToVertices(makeGridData(), vertices, indices);
+    benchMeshPass(state, vertices, indices, [](std::vector<Vertex>& v, std::vector<uint32_t>& i) {
+        MeshProcessing::optimizeVertexCache(i, v.size());
+    });
+}
+ENGINE_BENCHMARK("geometry/vertex_cache_grid", benchVertexCacheGrid);
+
+// Loading a cooked mesh, the runtime replacement for obj/parse_stream_grid plus the geometry passes
+void benchLoadCookedGrid(Bench::State& state) {
+    std::vector<char> bytes;
+    MeshAsset::cook(makeGridData(), 0, MeshAsset::CookOptions()).serialize(bytes);
+
+    MeshAsset asset;
+    std::string error;
+    while (state.keepRunning()) {
+        Bench::doNotOptimize(MeshAsset::deserialize(bytes, asset, error));
+    }
+    state.setBytesPerIteration(bytes.size());
+}
+ENGINE_BENCHMARK("asset/load_cooked_grid", benchLoadCookedGrid);
+
+// Decoded bytes per second of the cooked mesh streams
+void benchDecodeVerticesGrid(Bench::State& state) {
+    const MeshAsset asset = MeshAsset::cook(makeGridData(), 0, MeshAsset::CookOptions());
+    std::vector<uint8_t> stream;
+    GeometryCodec::encodeVertices(asset.vertices.data(), asset.vertices.size(), sizeof(Vertex), stream);
+
+    std::vector<Vertex> vertices(asset.vertices.size());
+    while (state.keepRunning()) {
+        Bench::doNotOptimize(GeometryCodec::decodeVertices(vertices.data(), vertices.size(), sizeof(Vertex),
+                                                           stream.data(), stream.size()));
+    }
+    state.setBytesPerIteration(vertices.size() * sizeof(Vertex));
+}
+ENGINE_BENCHMARK("asset/decode_vertices_grid", benchDecodeVerticesGrid);
+
+// Strides past sizeof(Vertex), up to the codec's limit, with a vertex count that leaves a partial block
+void benchDecodeVerticesWideStride(Bench::State& state) {
+    const size_t count = 4099;
+    const size_t strides[] = {68, 70, 128, 255, 256};
+    std::vector<uint8_t> stream;
+    std::vector<uint8_t> decoded;
+    for (size_t stride : strides) {
+        std::vector<uint8_t> vertices(count * stride);
+        for (size_t i = 0; i < vertices.size(); ++i) {
+            vertices[i] = static_cast<uint8_t>((i / stride) * 7 + (i % stride) * 13);
+        }
+        stream.clear();
+        GeometryCodec::encodeVertices(vertices.data(), count, stride, stream);
+        decoded.assign(vertices.size(), 0);
+        if (!GeometryCodec::decodeVertices(decoded.data(), count, stride, stream.data(), stream.size()) ||
+            decoded != vertices) {
+            state.skip("round trip mismatch at stride " + std::to_string(stride));
+            return;
+        }
+    }
+
+    // The last stream left over from the checks is the widest stride
+    while (state.keepRunning()) {
+        Bench::doNotOptimize(GeometryCodec::decodeVertices(decoded.data(), count, 256, stream.data(), stream.size()));
+    }
+    state.setBytesPerIteration(decoded.size());
+}
+ENGINE_BENCHMARK("asset/decode_vertices_wide_stride", benchDecodeVerticesWideStride);
+
+void benchDecodeIndicesGrid(Bench::State& state) {
+    const MeshAsset asset = MeshAsset::cook(makeGridData(), 0, MeshAsset::CookOptions());
+    std::vector<uint8_t> stream;
+    GeometryCodec::encodeIndices(asset.indices.data(), asset.indices.size(), stream);
+
+    std::vector<uint32_t> indices(asset.indices.size());
+    while (state.keepRunning()) {
+        Bench::doNotOptimize(GeometryCodec::decodeIndices(indices.data(), indices.size(), stream.data(), stream.size()));
+    }
+    state.setBytesPerIteration(indices.size() * sizeof(uint32_t));
+}
+ENGINE_BENCHMARK("asset/decode_indices_grid", benchDecodeIndicesGrid);
+
+// --- Transforms ---------------------------------------------------------------
+
+void benchCharacterTransform(Bench::State& state) {
+    MainCharacter character;
+    float angle = 0.0f;
+    while (state.keepRunning()) {
+        angle += 0.01f;
+        character.setTransform(glm::vec3(1.0f, 0.0f, -2.0f), glm::vec3(0.1f, angle, 0.0f), 1.5f);
+        Bench::doNotOptimize(character.getTransformMatrix());
+    }
+    state.setItemsPerIteration(1);
+}
+ENGINE_BENCHMARK("transform/character_set_transform", benchCharacterTransform);
+
+void benchUpdateScene(Bench::State& state) {
+    // updateScene only touches CPU-side matrices, so an uninitialized engine will do
+    VulkanEngine engine;
+    while (state.keepRunning()) {
+        engine.updateScene(1.0f / 60.0f);
+    }
+    state.setItemsPerIteration(1);
+}
+ENGINE_BENCHMARK("transform/engine_update_scene", benchUpdateScene);
+
+// --- Animation ----------------------------------------------------------------
+
+// Characters in the crowd benchmarks, each blending two clips
+constexpr uint32_t CROWD_SIZE = 2000;
+
+/**
+ * Builds a 52-joint humanoid: root, spine, neck and head, two arms with
+ * five three-joint fingers each, and two legs
+ */
+Skeleton makeHumanoidSkeleton() {
+    Skeleton skeleton;
+    auto bone = [](float x, float y, float z) {
+        JointTransform transform;
+        transform.translation = glm::vec3(x, y, z);
+        return transform;
+    };
+    uint16_t parent = skeleton.addJoint("root", Skeleton::NO_PARENT, bone(0.0f, 1.0f, 0.0f));
+    for (int i = 0; i < 3; ++i) {
+        parent = skeleton.addJoint("spine" + std::to_string(i), parent, bone(0.0f, 0.15f, 0.0f));
+    }
+    const uint16_t chest = parent;
+    skeleton.addJoint("head", skeleton.addJoint("neck", chest, bone(0.0f, 0.15f, 0.0f)), bone(0.0f, 0.1f, 0.0f));
+    for (float side : {-1.0f, 1.0f}) {
+        uint16_t arm = skeleton.addJoint("shoulder", chest, bone(side * 0.15f, 0.1f, 0.0f));
+        arm = skeleton.addJoint("upperArm", arm, bone(side * 0.1f, 0.0f, 0.0f));
+        arm = skeleton.addJoint("lowerArm", arm, bone(side * 0.28f, 0.0f, 0.0f));
+        const uint16_t hand = skeleton.addJoint("hand", arm, bone(side * 0.25f, 0.0f, 0.0f));
+        for (int finger = 0; finger < 5; ++finger) {
+            uint16_t joint = hand;
+            for (int segment = 0; segment < 3; ++segment) {
+                joint = skeleton.addJoint("finger", joint, bone(side * 0.03f, 0.0f, 0.02f * (finger - 2) * (segment == 0)));
+            }
+        }
+    }
+    for (float side : {-1.0f, 1.0f}) {
+        uint16_t leg = skeleton.addJoint("upperLeg", 0, bone(side * 0.1f, -0.05f, 0.0f));
+        leg = skeleton.addJoint("lowerLeg", leg, bone(0.0f, -0.45f, 0.0f));
+        leg = skeleton.addJoint("foot", leg, bone(0.0f, -0.45f, 0.0f));
+        skeleton.addJoint("toe", leg, bone(0.0f, -0.05f, 0.12f));
+    }
+    skeleton.computeInverseBindMatrices();
+    return skeleton;
+}
+
+/**
+ * Two seconds of a looping gait at 30 fps: every joint swings about its own
+ * axis at the gait frequency, the root bobs and sways, fingers only curl
+ */
+RawAnimation makeGaitAnimation(const Skeleton& skeleton, float phase) {
+    RawAnimation raw;
+    raw.name = "gait";
+    raw.jointCount = skeleton.getJointCount();
+    raw.frameCount = 61;
+    raw.frames.resize(static_cast<size_t>(raw.frameCount) * raw.jointCount);
+    for (uint32_t frame = 0; frame < raw.frameCount; ++frame) {
+        const float cycle = 6.2831853f * static_cast<float>(frame) / static_cast<float>(raw.frameCount - 1) + phase;
+        for (uint32_t joint = 0; joint < raw.jointCount; ++joint) {
+            JointTransform transform = skeleton.bindPose[joint];
+            const bool finger = skeleton.jointNames[joint] == "finger";
+            const float amplitude = finger ? 0.2f : 0.4f;
+            const glm::vec3 axis = glm::normalize(glm::vec3(1.0f, 0.3f * static_cast<float>(joint % 3), 0.2f));
+            transform.rotation = glm::angleAxis(amplitude * std::sin(cycle + 0.3f * static_cast<float>(joint)), axis);
+            if (joint == 0) {
+                transform.translation += glm::vec3(0.05f * std::sin(cycle), 0.03f * std::cos(2.0f * cycle), 0.0f);
+            }
+            raw.at(frame, joint) = transform;
+        }
+    }
+    return raw;
+}
+
+void benchCompressClip(Bench::State& state) {
+    const Skeleton skeleton = makeHumanoidSkeleton();
+    const RawAnimation raw = makeGaitAnimation(skeleton, 0.0f);
+    while (state.keepRunning()) {
+        Bench::doNotOptimize(AnimationClip::compress(raw, AnimationClip::CompressOptions()).getKeyCount());
+    }
+    state.setItemsPerIteration(static_cast<uint64_t>(raw.frameCount) * raw.jointCount);
+}
+ENGINE_BENCHMARK("animation/compress_clip", benchCompressClip);
+
+void benchSampleClip(Bench::State& state) {
+    const Skeleton skeleton = makeHumanoidSkeleton();
+    const AnimationClip clip = AnimationClip::compress(makeGaitAnimation(skeleton, 0.0f), AnimationClip::CompressOptions());
+    AnimationSampler sampler;
+    sampler.setClip(&clip);
+    AnimationPose pose;
+    pose.resize(skeleton.getJointCount());
+    float time = 0.0f;
+    while (state.keepRunning()) {
+        time += 1.0f / 60.0f;
+        if (time > clip.getDuration()) {
+            time -= clip.getDuration();
+        }
+        sampler.sample(time, pose);
+        Bench::doNotOptimize(pose.getSoaTransforms());
+    }
+    state.setItemsPerIteration(skeleton.getJointCount());
+}
+ENGINE_BENCHMARK("animation/sample_clip", benchSampleClip);
+
+void benchBlendPoses(Bench::State& state) {
+    const Skeleton skeleton = makeHumanoidSkeleton();
+    const AnimationClip clip = AnimationClip::compress(makeGaitAnimation(skeleton, 0.0f), AnimationClip::CompressOptions());
+    AnimationPose bindPose;
+    bindPose.setBindPose(skeleton);
+    AnimationPose poses[2];
+    poses[0].resize(skeleton.getJointCount());
+    poses[1].resize(skeleton.getJointCount());
+    AnimationSampler sampler;
+    sampler.setClip(&clip);
+    sampler.sample(0.3f, poses[0]);
+    sampler.sample(1.1f, poses[1]);
+    AnimationPose blended;
+    blended.resize(skeleton.getJointCount());
+    const BlendLayer layers[] = {{&poses[0], 0.6f}, {&poses[1], 0.4f}};
+    while (state.keepRunning()) {
+        AnimationPose::blend(layers, 2, bindPose, blended);
+        Bench::doNotOptimize(blended.getSoaTransforms());
+    }
+    state.setItemsPerIteration(skeleton.getJointCount());
+}
+ENGINE_BENCHMARK("animation/blend_2_poses", benchBlendPoses);
+
+void benchLocalToModel(Bench::State& state) {
+    const Skeleton skeleton = makeHumanoidSkeleton();
+    AnimationPose pose;
+    pose.setBindPose(skeleton);
+    std::vector<glm::mat4> models(skeleton.getJointCount());
+    std::vector<glm::mat4> skinning(skeleton.getJointCount());
+    while (state.keepRunning()) {
+        pose.localToModel(skeleton, models.data());
+        AnimationPose::computeSkinningMatrices(skeleton, models.data(), skinning.data());
+        Bench::doNotOptimize(skinning.data());
+    }
+    state.setItemsPerIteration(skeleton.getJointCount());
+}
+ENGINE_BENCHMARK("animation/local_to_model_and_skinning", benchLocalToModel);
+
+/**
+ * A crowd where every character crossfades between two gaits, each at its own phase
+ */
+struct Crowd {
+    AnimationSystem animation;
+
+    Crowd() : animation(makeHumanoidSkeleton()) {
+        const Skeleton& skeleton = animation.getSkeleton();
+        const uint32_t walk = animation.addClip(AnimationClip::compress(makeGaitAnimation(skeleton, 0.0f),
+                                                                        AnimationClip::CompressOptions()));
+        const uint32_t run = animation.addClip(AnimationClip::compress(makeGaitAnimation(skeleton, 1.5f),
+                                                                       AnimationClip::CompressOptions()));
+        for (uint32_t i = 0; i < CROWD_SIZE; ++i) {
+            const uint32_t character = animation.addCharacter();
+            const float blend = static_cast<float>(i % 8) / 7.0f;
+            animation.setLayer(character, 0, walk, 1.0f - blend, 1.0f, 0.013f * static_cast<float>(i));
+            animation.setLayer(character, 1, run, blend, 1.4f, 0.029f * static_cast<float>(i));
+        }
+        animation.update(0.0f);
+    }
+};
+
+void benchCrowdUpdate(Bench::State& state) {
+    Crowd crowd;
+    while (state.keepRunning()) {
+        crowd.animation.update(1.0f / 60.0f);
+    }
+    state.setItemsPerIteration(CROWD_SIZE);
+}
+ENGINE_BENCHMARK("animation/update_2000_characters", benchCrowdUpdate);
+
+void benchCrowdUpdateSingleThread(Bench::State& state) {
+    // The same crowd on one worker, for the per-core cost
+    Crowd crowd;
+    ThreadPool pool(1);
+    while (state.keepRunning()) {
+        crowd.animation.update(1.0f / 60.0f, pool, CROWD_SIZE);
+    }
+    state.setItemsPerIteration(CROWD_SIZE);
+}
+ENGINE_BENCHMARK("animation/update_2000_characters_1_thread", benchCrowdUpdateSingleThread);
+
+// --- Logging ------------------------------------------------------------------
+
+void benchLogFiltered(Bench::State& state) {
+    Logger::getInstance().setLogLevel(Logger::Level::WARN);
+    uint32_t value = 0;
+    while (state.keepRunning()) {
+        LOG_DEBUG("Filtered message {} {}", "Bench", value, 1.5f);
+        ++value;
+    }
+    state.setItemsPerIteration(1);
+}
+ENGINE_BENCHMARK("logger/filtered_debug", benchLogFiltered);
+
+void benchLogAsync(Bench::State& state) {
+    Logger& logger = Logger::getInstance();
+    Logger::AsyncConfig config;
+    config.consoleOutput = false;
+    config.filePath = "engine_bench.log";
+    config.overflowPolicy = Logger::OverflowPolicy::BLOCK;
+    if (!logger.enableAsync(config)) {
+        state.skip("cannot open engine_bench.log");
+    }
+    logger.setLogLevel(Logger::Level::INFO);
+
+    uint32_t value = 0;
+    while (state.keepRunning()) {
+        LOG_INFO("Frame {} took {:.2f}ms", "Bench", value, 16.6f);
+        ++value;
+    }
+    logger.flush();
+    logger.disableAsync();
+    logger.setLogLevel(Logger::Level::WARN);
+    state.setItemsPerIteration(1);
+}
+ENGINE_BENCHMARK("logger/async_info_to_file", benchLogAsync);
+
+void benchLogBinary(Bench::State& state) {
+    Logger& logger = Logger::getInstance();
+    BinaryLogSink::Config config;
+    config.basePath = "engine_bench";
+    config.maxFiles = 1;
+    if (!logger.enableBinaryBackend(config, Logger::Level::FATAL)) {
+        state.skip("cannot create engine_bench binary log");
+    }
+    logger.setLogLevel(Logger::Level::INFO);
+
+    uint32_t value = 0;
+    while (state.keepRunning()) {
+        LOG_INFO("Frame {} took {:.2f}ms", "Bench", value, 16.6f);
+        ++value;
+    }
+    logger.disableBinaryBackend();
+    logger.setLogLevel(Logger::Level::WARN);
+    state.setItemsPerIteration(1);
+}
+ENGINE_BENCHMARK("logger/binary_info", benchLogBinary);
+
+// --- Per-frame bookkeeping ----------------------------------------------------
+
+void benchHistogramRecord(Bench::State& state) {
+    MetricHistogram& histogram = MetricsRegistry::getInstance().histogram("bench.histogram", "ms", 1e6);
+    uint64_t value = 1000;
+    while (state.keepRunning()) {
+        histogram.record(value);
+        value = (value * 7 + 13) % 50000000;
+    }
+    state.setItemsPerIteration(1);
+}
+ENGINE_BENCHMARK("frame/histogram_record", benchHistogramRecord);
+
+void benchMetricsUpdate(Bench::State& state) {
+    MetricsRegistry& metrics = MetricsRegistry::getInstance();
+    while (state.keepRunning()) {
+        metrics.update();
+    }
+    state.setItemsPerIteration(1);
+}
+ENGINE_BENCHMARK("frame/metrics_update", benchMetricsUpdate);
+
+void benchProfileZone(Bench::State& state) {
+    Profiler::getInstance().setEnabled(true);
+    while (state.keepRunning()) {
+        PROFILE_ZONE("BenchZone");
+    }
+    state.setItemsPerIteration(1);
+}
+ENGINE_BENCHMARK("frame/profile_zone", benchProfileZone);
+
+void benchEndOfFrame(Bench::State& state) {
+    // Everything the main loop does between two frames besides rendering
+    MetricHistogram& frameTime = MetricsRegistry::getInstance().histogram("frame.total", "ms", 1e6);
+    while (state.keepRunning()) {
+        PROFILE_FRAME_MARK();
+        AllocationTracker::endFrame();
+        VulkanCallStats::endFrame();
+        frameTime.record(16600000);
+        HitchDetector::getInstance().endFrame(Profiler::getInstance().getFrameIndex() - 1, 16600000);
+        MetricsRegistry::getInstance().update();
+    }
+    state.setItemsPerIteration(1);
+}
+ENGINE_BENCHMARK("frame/end_of_frame_bookkeeping", benchEndOfFrame);
+
+void benchCommandListRecord(Bench::State& state) {
+    // The same commands VulkanEngine::recordCommands emits each frame
+    CommandList commands;
+    commands.reserve(64, 1);
+    ObjectConstants constants;
+    constants.model = glm::mat4(1.0f);
+    constants.tint = glm::vec4(1.0f);
+    while (state.keepRunning()) {
+        commands.reset();
+        commands.beginZone("MainPass");
+        commands.beginPass(0.0f, 0.0f, 0.0f, 1.0f);
+        commands.bindPipeline(1);
+        commands.setFullViewport();
+        commands.bindUniforms(3);
+        commands.beginZone("MainCharacter");
+        commands.bindVertexBuffer(1);
+        commands.bindIndexBuffer(2);
+        commands.pushObjectConstants(constants);
+        commands.drawIndexed(36);
+        commands.endZone();
+        commands.endPass();
+        commands.endZone();
+        Bench::doNotOptimize(commands.size());
+    }
+    state.setItemsPerIteration(1);
+}
+ENGINE_BENCHMARK("frame/command_list_record", benchCommandListRecord);
+
+/**
+ * Generates a 10,000-object scene on a null backend (meshes are never uploaded anywhere)
+ */
+struct GeneratedScene {
+    NullRenderBackend backend;
+    Scene scene;
+
+    explicit GeneratedScene(float dynamicFraction) {
+        backend.initialize(BackendConfig());
+        SceneGenerator::Config config;
+        config.instances = 10000;
+        config.dynamicFraction = dynamicFraction;
+        SceneGenerator::generate(config, scene, backend);
+        scene.update(0.0f);
+    }
+
+    ~GeneratedScene() {
+        scene.clear(backend);
+        backend.cleanup();
+    }
+};
+
+void benchSceneUpdate(Bench::State& state) {
+    GeneratedScene generated(0.25f);
+    while (state.keepRunning()) {
+        generated.scene.update(1.0f / 60.0f);
+    }
+    state.setItemsPerIteration(generated.scene.getStats().dynamicObjects);
+}
+ENGINE_BENCHMARK("scene/update_10k_25pct_dynamic", benchSceneUpdate);
+
+void benchSceneRecord(Bench::State& state) {
+    GeneratedScene generated(0.0f);
+    CommandList commands;
+    commands.reserve(generated.scene.getCommandCount(), generated.scene.getStats().objects);
+    while (state.keepRunning()) {
+        commands.reset();
+        generated.scene.record(commands);
+        Bench::doNotOptimize(commands.size());
+    }
+    state.setItemsPerIteration(generated.scene.getStats().drawsPerFrame);
+}
+ENGINE_BENCHMARK("scene/record_10k", benchSceneRecord);
+
+// --- Dynamic meshes -----------------------------------------------------------
+
+// Vertices of the large dynamic mesh (12 MB, well past the caches)
+constexpr uint32_t DYNAMIC_VERTEX_COUNT = 1 << 18;
+
+/**
+ * Null backend that copies dynamic vertex updates into host memory, standing
+ * in for the Vulkan backend's memcpy into the mapped copy of the frame
+ */
+class MappedNullBackend : public NullRenderBackend {
+public:
+    BufferHandle createBuffer(BufferType type, const void* data, size_t size) override {
+        const BufferHandle handle = NullRenderBackend::createBuffer(type, data, size);
+        if (type == BufferType::DYNAMIC_VERTEX) {
+            m_mapped.resize(std::max<size_t>(m_mapped.size(), handle));
+            m_mapped[handle - 1].assign(static_cast<const uint8_t*>(data), static_cast<const uint8_t*>(data) + size);
+        }
+        return handle;
+    }
+
+    void updateBufferRange(BufferHandle buffer, size_t offset, const void* data, size_t size) override {
+        NullRenderBackend::updateBufferRange(buffer, offset, data, size);
+        std::memcpy(m_mapped[buffer - 1].data() + offset, data, size);
+    }
+
+private:
+    std::vector<std::vector<uint8_t>> m_mapped;     // Indexed by handle - 1 (empty for other buffer types)
+};
+
+struct LargeDynamicMesh {
+    MappedNullBackend backend;
+    DynamicMesh mesh;
+
+    LargeDynamicMesh() {
+        backend.initialize(BackendConfig());
+        std::vector<Vertex> vertices(DYNAMIC_VERTEX_COUNT);
+        for (uint32_t i = 0; i < DYNAMIC_VERTEX_COUNT; ++i) {
+            vertices[i].position = glm::vec3(static_cast<float>(i % 512), 0.0f, static_cast<float>(i / 512));
+            vertices[i].normal = glm::vec3(0.0f, 1.0f, 0.0f);
+        }
+        mesh.create(backend, vertices, {0, 1, 2});
+    }
+
+    ~LargeDynamicMesh() {
+        mesh.destroy();
+        backend.cleanup();
+    }
+};
+
+void benchDynamicFlushAll(Bench::State& state) {
+    // Every vertex rewritten every frame: one memcpy of the whole mesh per flush
+    LargeDynamicMesh dynamic;
+    uint32_t frameSlot = 0;
+    while (state.keepRunning()) {
+        dynamic.mesh.markAllDirty();
+        Bench::doNotOptimize(dynamic.mesh.flush(frameSlot));
+        frameSlot = (frameSlot + 1) % MAX_FRAMES_IN_FLIGHT;
+    }
+    state.setBytesPerIteration(static_cast<uint64_t>(DYNAMIC_VERTEX_COUNT) * sizeof(Vertex));
+}
+ENGINE_BENCHMARK("dynamic/mark_dirty_flush_256k_all", benchDynamicFlushAll);
+
+void benchDynamicFlushPartial(Bench::State& state) {
+    // The same sixteenth of the mesh changes every frame (an animated part of a larger surface)
+    LargeDynamicMesh dynamic;
+    const uint32_t window = DYNAMIC_VERTEX_COUNT / 16;
+    const uint32_t first = DYNAMIC_VERTEX_COUNT / 2;
+    uint32_t frameSlot = 0;
+    while (state.keepRunning()) {
+        dynamic.mesh.markDirty(first, window);
+        Bench::doNotOptimize(dynamic.mesh.flush(frameSlot));
+        frameSlot = (frameSlot + 1) % MAX_FRAMES_IN_FLIGHT;
+    }
+    state.setBytesPerIteration(static_cast<uint64_t>(window) * sizeof(Vertex));
+}
+ENGINE_BENCHMARK("dynamic/mark_dirty_flush_256k_sixteenth", benchDynamicFlushPartial);
+
+void benchDeformingScene(Bench::State& state) {
+    // The scene's CPU ripple on four 33k-vertex spheres, then the partial uploads
+    MappedNullBackend backend;
+    backend.initialize(BackendConfig());
+    Scene scene;
+    SceneGenerator::Config config;
+    config.instances = 16;
+    config.detail = 128;
+    config.deformingMeshes = config.uniqueMeshes;
+    SceneGenerator::generate(config, scene, backend);
+
+    uint32_t frameSlot = 0;
+    while (state.keepRunning()) {
+        scene.update(1.0f / 60.0f);
+        Bench::doNotOptimize(scene.flush(frameSlot));
+        frameSlot = (frameSlot + 1) % MAX_FRAMES_IN_FLIGHT;
+    }
+    state.setItemsPerIteration(scene.getStats().deformingMeshes);
+
+    scene.clear(backend);
+    backend.cleanup();
+}
+ENGINE_BENCHMARK("dynamic/deforming_scene_4_spheres", benchDeformingScene);
+
+void benchEngineRenderNull(Bench::State& state) {
+    // The complete render() path (scene update, uniform packing, command recording) without a GPU
+    VulkanEngine engine;
+    engine.initializeHeadless(DEFAULT_WINDOW_WIDTH, DEFAULT_WINDOW_HEIGHT, BackendType::NULL_BACKEND);
+    engine.setFixedTimeStep(1.0f / 60.0f);
+    while (state.keepRunning()) {
+        engine.render();
+    }
+    engine.cleanup();
+    state.setItemsPerIteration(1);
+}
+ENGINE_BENCHMARK("frame/engine_render_null_backend", benchEngineRenderNull);
+
+} // anonymous namespace
+
+int main(int argc, char* argv[]) {
+    Bench::Options options;
+    if (!Bench::parseOptions(argc, argv, options)) {
+        return 1;
+    }
+
+    // Keep engine log output out of the result table
+    Logger::getInstance().setLogLevel(Logger::Level::WARN);
+    Profiler::getInstance().setThreadName("Bench");
+
+    return Bench::runBenchmarks(options);
+}
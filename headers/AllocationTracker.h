@@ -0,0 +1,166 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace VulkanGameEngine {
+
+/**
+ * AllocationTracker counts heap allocations made through global operator new.
+ *
+ * The hooks are only compiled in when the build defines
+ * ENGINE_TRACK_ALLOCATIONS (CMake option ENABLE_ALLOCATION_TRACKING).
+ * Without it every query returns zero and the scopes compile to nothing,
+ * so the tracker can stay wired into the frame loop permanently.
+ *
+ * With tracking enabled:
+ * - every thread keeps its own counters (no contention on the hot path),
+ *   plus process-wide atomic totals;
+ * - ALLOC_SCOPE("Tag") attributes allocations in the scope to a call-site tag;
+ * - ASSERT_NO_ALLOCATIONS() marks a scope that must not allocate. A violation
+ *   is counted (and optionally aborts the process, for CI runs);
+ * - endFrame() publishes per-frame numbers to the MetricsRegistry
+ *   ("alloc.count", "alloc.bytes", "frame.allocations").
+ */
+class AllocationTracker {
+public:
+    /**
+     * Allocation totals
+     */
+    struct Stats {
+        uint64_t allocations = 0;
+        uint64_t bytes = 0;
+        uint64_t frees = 0;
+    };
+
+    /**
+     * Allocations attributed to one ALLOC_SCOPE tag
+     */
+    struct TagStats {
+        const char* tag;
+        uint64_t allocations;
+        uint64_t bytes;
+    };
+
+    /**
+     * Checks if the operator new/delete hooks are compiled in
+     */
+    static bool isCompiledIn();
+
+    /**
+     * Gets the totals of the calling thread
+     */
+    static Stats getThreadStats();
+
+    /**
+     * Gets the totals of all threads
+     */
+    static Stats getGlobalStats();
+
+    /**
+     * Copies the per-tag totals (allocates; do not call from a no-allocation scope)
+     */
+    static void getTagStats(std::vector<TagStats>& tags);
+
+    /**
+     * Sets the tag for allocations on the calling thread
+     *
+     * @param tag Tag with static storage, or nullptr for none
+     * @return The previous tag, to restore later
+     */
+    static const char* exchangeTag(const char* tag);
+
+    /**
+     * Enters or leaves a region of the calling thread that must not allocate (regions nest)
+     */
+    static void beginNoAllocationRegion();
+    static void endNoAllocationRegion();
+
+    /**
+     * Lifts all no-allocation regions of the calling thread, e.g. for a swapchain
+     * recreation inside an otherwise allocation-free frame
+     *
+     * @return The region depth to hand back to resumeNoAllocationRegions
+     */
+    static uint32_t suspendNoAllocationRegions();
+    static void resumeNoAllocationRegions(uint32_t depth);
+
+    /**
+     * Aborts the process on the first allocation inside a no-allocation region.
+     * Meant for automated runs that should fail loudly on a regression.
+     */
+    static void setAbortOnViolation(bool abortOnViolation);
+
+    /**
+     * Gets the number of allocations made inside no-allocation regions (all threads)
+     */
+    static uint64_t getViolationCount();
+
+    /**
+     * Publishes the calling thread's allocations since the last call to the
+     * metrics registry and reports new violations. Call once per frame from the main thread.
+     */
+    static void endFrame();
+
+    /**
+     * Gets the calling thread's allocation count of the previous frame (as measured by endFrame)
+     */
+    static uint64_t getLastFrameAllocations();
+};
+
+/**
+ * RAII helper that tags allocations made in the enclosing scope
+ */
+class AllocationScope {
+public:
+    explicit AllocationScope(const char* tag) : m_previous(AllocationTracker::exchangeTag(tag)) {}
+    ~AllocationScope() { AllocationTracker::exchangeTag(m_previous); }
+
+    AllocationScope(const AllocationScope&) = delete;
+    AllocationScope& operator=(const AllocationScope&) = delete;
+
+private:
+    const char* m_previous;
+};
+
+/**
+ * RAII helper that flags any allocation in the enclosing scope as a violation
+ */
+class NoAllocationScope {
+public:
+    NoAllocationScope() { AllocationTracker::beginNoAllocationRegion(); }
+    ~NoAllocationScope() { AllocationTracker::endNoAllocationRegion(); }
+
+    NoAllocationScope(const NoAllocationScope&) = delete;
+    NoAllocationScope& operator=(const NoAllocationScope&) = delete;
+};
+
+/**
+ * RAII helper that permits allocations in the enclosing scope even inside a no-allocation region
+ */
+class AllowAllocationScope {
+public:
+    AllowAllocationScope() : m_depth(AllocationTracker::suspendNoAllocationRegions()) {}
+    ~AllowAllocationScope() { AllocationTracker::resumeNoAllocationRegions(m_depth); }
+
+    AllowAllocationScope(const AllowAllocationScope&) = delete;
+    AllowAllocationScope& operator=(const AllowAllocationScope&) = delete;
+
+private:
+    uint32_t m_depth;
+};
+
+} // namespace VulkanGameEngine
+
+// Allocation tracking macros (no-ops unless ENGINE_TRACK_ALLOCATIONS is defined)
+#ifdef ENGINE_TRACK_ALLOCATIONS
+#define ALLOC_CONCAT_INNER(a, b) a##b
+#define ALLOC_CONCAT(a, b) ALLOC_CONCAT_INNER(a, b)
+#define ALLOC_SCOPE(tag) VulkanGameEngine::AllocationScope ALLOC_CONCAT(_allocScope, __LINE__)(tag)
+#define ASSERT_NO_ALLOCATIONS() VulkanGameEngine::NoAllocationScope ALLOC_CONCAT(_noAllocScope, __LINE__)
+#define ALLOW_ALLOCATIONS() VulkanGameEngine::AllowAllocationScope ALLOC_CONCAT(_allowAllocScope, __LINE__)
+#else
+#define ALLOC_SCOPE(tag) ((void)0)
+#define ASSERT_NO_ALLOCATIONS() ((void)0)
+#define ALLOW_ALLOCATIONS() ((void)0)
+#endif
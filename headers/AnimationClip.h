@@ -0,0 +1,167 @@
+#pragma once
+
+#include "Common.h"
+#include "Skeleton.h"
+#include <string>
+#include <vector>
+
+namespace VulkanGameEngine {
+
+/**
+ * Uncompressed animation as authored: every joint's local transform at every
+ * frame, sampled at a fixed rate. Only the compressor reads these.
+ */
+struct RawAnimation {
+    std::string name;
+    float sampleRate = 30.0f;               ///< Frames per second
+    uint32_t jointCount = 0;
+    uint32_t frameCount = 0;
+    std::vector<JointTransform> frames;     ///< frameCount * jointCount, frame by frame
+
+    JointTransform& at(uint32_t frame, uint32_t joint) { return frames[static_cast<size_t>(frame) * jointCount + joint]; }
+    const JointTransform& at(uint32_t frame, uint32_t joint) const { return frames[static_cast<size_t>(frame) * jointCount + joint]; }
+
+    /**
+     * Gets the length in seconds (time of the last frame)
+     */
+    float getDuration() const { return frameCount > 1 ? static_cast<float>(frameCount - 1) / sampleRate : 0.0f; }
+};
+
+/**
+ * AnimationClip is a compressed animation, sampled at runtime by
+ * AnimationSampler (see AnimationPose.h).
+ *
+ * Each joint has three tracks (rotation, translation, scale), compressed in
+ * two steps:
+ * - Curve fitting: a key is kept only where linear interpolation between the
+ *   kept neighbours would stray from the raw curve by more than the
+ *   tolerance, so constant tracks shrink to one key and smooth motion to a
+ *   handful.
+ * - Quantization: every key is three uint16 values. Rotations use the
+ *   "smallest three" encoding (the largest component is dropped and rebuilt
+ *   from the unit length, its index is packed into the top bits); translations
+ *   and scales are quantized within the range of their track.
+ * Tolerances are checked against the quantized keys, so both errors are
+ * covered. The tolerances are local to each joint; measureError reports the
+ * resulting model-space error over the whole hierarchy.
+ *
+ * File layout (*.vgeanim, little-endian):
+ *
+ *   char[8] magic "VGEANIM1", uint32 version, float sampleRate,
+ *   uint32 jointCount, frameCount, uint16 nameLength, char[nameLength] name
+ *   per channel (rotation, translation, scale):
+ *     uint32 keyCount
+ *     Track[jointCount]                 32 bytes each
+ *     uint16[keyCount]                  key frames, track by track
+ *     uint16[3][keyCount]               quantized key values
+ */
+struct AnimationClip {
+    static constexpr char MAGIC[8] = {'V', 'G', 'E', 'A', 'N', 'I', 'M', '1'};
+    static constexpr uint32_t VERSION = 1;
+    static constexpr const char* EXTENSION = ".vgeanim";
+    static constexpr uint32_t MAX_FRAMES = 65536;   // Key frames are stored as uint16
+
+    // Smallest-three rotation components lie in [-1/sqrt(2), 1/sqrt(2)] and are stored in 15 bits
+    static constexpr float ROTATION_COMPONENT_MAX = 0.70710678f;
+    static constexpr float ROTATION_STEP = 2.0f * ROTATION_COMPONENT_MAX / 32767.0f;
+
+    enum Channel {
+        ROTATION,
+        TRANSLATION,
+        SCALE,
+        CHANNEL_COUNT
+    };
+
+    /**
+     * The keys of one joint in one channel, and how to dequantize them
+     */
+    struct Track {
+        uint32_t firstKey;
+        uint32_t keyCount;                  ///< 1 for a constant track, else keys span frame 0 to the last frame
+        glm::vec3 rangeMin;                 ///< Translation and scale: value of quantized 0
+        glm::vec3 rangeStep;                ///< Translation and scale: value of one quantization step
+    };
+
+    /**
+     * One channel's tracks and their keys
+     */
+    struct ChannelData {
+        std::vector<Track> tracks;          ///< One per joint
+        std::vector<uint16_t> keyFrames;
+        std::vector<uint16_t> keyValues;    ///< Three per key
+    };
+
+    /**
+     * Compression tolerances
+     */
+    struct CompressOptions {
+        float rotationTolerance = 0.001f;   ///< Radians
+        float translationTolerance = 0.0005f;
+        float scaleTolerance = 0.0005f;
+    };
+
+    std::string name;
+    float sampleRate = 30.0f;
+    uint32_t jointCount = 0;
+    uint32_t frameCount = 0;
+    ChannelData channels[CHANNEL_COUNT];
+
+    /**
+     * Compresses a raw animation
+     *
+     * @param raw Source frames (at least one, at most MAX_FRAMES)
+     * @param options Per-channel tolerances
+     */
+    static AnimationClip compress(const RawAnimation& raw, const CompressOptions& options);
+
+    /**
+     * Samples every frame of the clip and of the raw animation, and returns
+     * the largest distance between the two model-space positions of any joint
+     */
+    static float measureError(const RawAnimation& raw, const AnimationClip& clip, const Skeleton& skeleton);
+
+    /**
+     * Gets the length in seconds (time of the last frame)
+     */
+    float getDuration() const { return frameCount > 1 ? static_cast<float>(frameCount - 1) / sampleRate : 0.0f; }
+
+    /**
+     * Gets the number of keys over all tracks
+     */
+    size_t getKeyCount() const;
+
+    /**
+     * Gets the size of the file image in bytes
+     */
+    size_t getCompressedSize() const;
+
+    /**
+     * Appends the file image of the clip to data
+     */
+    void serialize(std::vector<char>& data) const;
+
+    /**
+     * Reads a file image written by serialize(), checking every track range and key
+     *
+     * @param error Set to the reason on failure
+     */
+    static bool deserialize(const std::vector<char>& data, AnimationClip& clip, std::string& error);
+
+    /**
+     * Writes the clip to a file
+     *
+     * @return false (after logging) if the file cannot be written
+     */
+    bool save(const std::string& path) const;
+
+    /**
+     * Reads a clip through AssetFileSystem (mounted archives, then loose files)
+     *
+     * @param error Set to the reason on failure
+     */
+    static bool load(const std::string& path, AnimationClip& clip, std::string& error);
+};
+
+static_assert(sizeof(AnimationClip::Track) == 32, "AnimationClip::Track is part of the file format");
+
+} // namespace VulkanGameEngine
@@ -0,0 +1,158 @@
+#pragma once
+
+#include "Common.h"
+#include "Skeleton.h"
+#include <vector>
+
+namespace VulkanGameEngine {
+
+struct AnimationClip;
+
+/**
+ * Local transforms of four consecutive joints, component by component, so
+ * that one SIMD register holds the same component of all four joints
+ */
+struct alignas(16) SoaTransform {
+    float rotationX[4];
+    float rotationY[4];
+    float rotationZ[4];
+    float rotationW[4];
+    float translationX[4];
+    float translationY[4];
+    float translationZ[4];
+    float scaleX[4];
+    float scaleY[4];
+    float scaleZ[4];
+};
+
+class AnimationPose;
+
+/**
+ * One input of AnimationPose::blend
+ */
+struct BlendLayer {
+    const AnimationPose* pose;
+    float weight;
+};
+
+/**
+ * AnimationPose holds the local transform of every joint of a skeleton in
+ * SoA blocks of four joints (see SoaTransform). Sampling, blending and the
+ * local-to-model conversion all work on whole blocks with SSE2 or NEON
+ * (scalar fallback elsewhere), and lanes past the last joint hold the
+ * identity so they can be processed like any other.
+ *
+ * Usage:
+ *   sampler.sample(time, walk);
+ *   sampler2.sample(time2, run);
+ *   BlendLayer layers[] = {{&walk, 0.3f}, {&run, 0.7f}};
+ *   AnimationPose::blend(layers, 2, bindPose, pose);
+ *   pose.localToModel(skeleton, models.data());
+ *   AnimationPose::computeSkinningMatrices(skeleton, models.data(), skinning.data());
+ */
+class AnimationPose {
+public:
+    AnimationPose() : m_jointCount(0) {}
+
+    /**
+     * Sizes the pose for a skeleton and sets it to the bind pose
+     */
+    void setBindPose(const Skeleton& skeleton);
+
+    /**
+     * Sizes the pose for jointCount joints, all at the identity
+     */
+    void resize(uint32_t jointCount);
+
+    uint32_t getJointCount() const { return m_jointCount; }
+    uint32_t getSoaCount() const { return static_cast<uint32_t>(m_joints.size()); }
+    SoaTransform* getSoaTransforms() { return m_joints.data(); }
+    const SoaTransform* getSoaTransforms() const { return m_joints.data(); }
+
+    /**
+     * Reads or writes one joint (slow path for tools and tests; the hot paths work on blocks)
+     */
+    JointTransform getJoint(uint32_t joint) const;
+    void setJoint(uint32_t joint, const JointTransform& transform);
+
+    /**
+     * Concatenates the local transforms down the hierarchy into model-space matrices
+     *
+     * @param skeleton Skeleton the pose belongs to
+     * @param models One matrix per joint
+     */
+    void localToModel(const Skeleton& skeleton, glm::mat4* models) const;
+
+    /**
+     * Weighted blend of poses: rotations are summed with their signs aligned
+     * to the first layer and renormalized (normalized lerp), translations and
+     * scales are summed. Weights adding up to less than 1 are topped up with
+     * the rest pose; weights adding up to more than 1 are normalized.
+     *
+     * @param layers Input poses, all with the output's joint count
+     * @param layerCount Number of layers
+     * @param restPose Pose that fills in missing weight (usually the bind pose)
+     * @param output Blended pose (may not be one of the inputs)
+     */
+    static void blend(const BlendLayer* layers, size_t layerCount, const AnimationPose& restPose, AnimationPose& output);
+
+    /**
+     * Multiplies each model matrix by the joint's inverse bind matrix, giving
+     * the matrices that take bind-pose vertices to their animated positions
+     */
+    static void computeSkinningMatrices(const Skeleton& skeleton, const glm::mat4* models, glm::mat4* skinning);
+
+private:
+    std::vector<SoaTransform> m_joints;
+    uint32_t m_jointCount;
+};
+
+/**
+ * AnimationSampler decodes an AnimationClip at a point in time into a pose.
+ *
+ * It keeps the two keys around the current frame of every track decoded,
+ * in the same SoA blocks as the pose, with each track's frame range. A
+ * sample is then a SIMD range check and interpolation per block; keys are
+ * looked up and dequantized (four joints at a time) only for blocks where
+ * some track crossed into another segment: the next few keys when playing
+ * forward, a binary search after a seek. A sampler serves one playback of
+ * one clip; use one per character and layer.
+ */
+class AnimationSampler {
+public:
+    AnimationSampler() : m_clip(nullptr) {}
+
+    /**
+     * Binds a clip (nullptr to unbind) and empties the key cache
+     */
+    void setClip(const AnimationClip* clip);
+
+    const AnimationClip* getClip() const { return m_clip; }
+
+    /**
+     * Samples the bound clip
+     *
+     * @param time Seconds from the start, clamped to the clip
+     * @param output Pose sized for the clip's joint count
+     */
+    void sample(float time, AnimationPose& output);
+
+    /**
+     * Decoded keys around the current frame of four joints (the sampling kernels' cache)
+     */
+    struct alignas(16) KeyCache {
+        float startFrame[3][4];             ///< Per channel: frame of the left keys
+        float endFrame[3][4];               ///< Per channel: frames from here on need other keys
+        float inverseLength[3][4];          ///< Per channel: 1 / frames between the keys (0 for constant tracks)
+        float rotation[2][4][4];            ///< Left, right key: x, y, z, w (right on the left's hemisphere)
+        float translation[2][3][4];
+        float scale[2][3][4];
+    };
+
+private:
+    const AnimationClip* m_clip;
+    std::vector<KeyCache> m_cache;          // One per SoA block
+    std::vector<uint32_t> m_cursors;        // Per channel and joint: left key of the cached segment, relative to the track
+};
+
+} // namespace VulkanGameEngine
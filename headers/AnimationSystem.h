@@ -0,0 +1,120 @@
+#pragma once
+
+#include "AnimationClip.h"
+#include "AnimationPose.h"
+#include "Skeleton.h"
+#include <memory>
+#include <vector>
+
+namespace VulkanGameEngine {
+
+class ThreadPool;
+
+/**
+ * AnimationSystem plays and blends clips on many characters that share one
+ * skeleton, and produces each character's skinning matrices.
+ *
+ * Every character has up to MAX_LAYERS layers, each playing one clip at its
+ * own time, speed and weight. update() advances the layers, samples them,
+ * blends the results over the bind pose (AnimationPose::blend), converts the
+ * pose to model space and multiplies in the inverse bind matrices.
+ * Characters are independent, so they are spread over a ThreadPool in
+ * chunks; the per-character work runs on SoA poses, four joints per SIMD
+ * operation. Everything is CPU-side: the matrices are ready for a skinning
+ * shader or a DynamicMesh but nothing here touches the GPU.
+ *
+ * Scratch poses live in thread-local storage and are sized on first use, so
+ * steady-state updates do not allocate.
+ *
+ * Usage:
+ *   AnimationSystem animation(skeleton);
+ *   const uint32_t walk = animation.addClip(std::move(walkClip));
+ *   const uint32_t character = animation.addCharacter();
+ *   animation.setLayer(character, 0, walk, 1.0f);
+ *   animation.update(deltaTime);
+ *   upload(animation.getSkinningMatrices(character), skeleton.getJointCount());
+ */
+class AnimationSystem {
+public:
+    static constexpr uint32_t MAX_LAYERS = 4;
+    static constexpr uint32_t NO_CLIP = 0xFFFFFFFF;
+
+    /**
+     * One clip playing on a character
+     */
+    struct Layer {
+        uint32_t clip = NO_CLIP;            ///< Index returned by addClip
+        float time = 0.0f;                  ///< Seconds into the clip
+        float speed = 1.0f;                 ///< Playback rate (negative plays backwards)
+        float weight = 0.0f;                ///< Blend weight (layers of weight 0 are not sampled)
+        bool loop = true;                   ///< Wrap at the ends instead of holding the end pose
+    };
+
+    /**
+     * Creates an empty system for a skeleton (copied)
+     */
+    explicit AnimationSystem(const Skeleton& skeleton);
+
+    /**
+     * Takes ownership of a clip
+     *
+     * @return Index to use in setLayer
+     * @throws std::runtime_error if the clip's joint count does not match the skeleton
+     */
+    uint32_t addClip(AnimationClip clip);
+
+    /**
+     * Adds a character in the bind pose with no layers playing
+     *
+     * @return Index of the character
+     */
+    uint32_t addCharacter();
+
+    /**
+     * Starts a clip on one layer of a character, replacing what it played
+     */
+    void setLayer(uint32_t character, uint32_t layer, uint32_t clip, float weight, float speed = 1.0f,
+                  float time = 0.0f, bool loop = true);
+
+    /**
+     * Changes the weight of a playing layer (crossfades set this every frame)
+     */
+    void setLayerWeight(uint32_t character, uint32_t layer, float weight);
+
+    const Layer& getLayer(uint32_t character, uint32_t layer) const { return m_characters[character].layers[layer]; }
+
+    /**
+     * Advances every character by deltaTime and recomputes its skinning matrices
+     *
+     * @param pool Pool to spread the characters over
+     * @param grainSize Characters per parallel chunk
+     */
+    void update(float deltaTime, ThreadPool& pool, size_t grainSize = 16);
+    void update(float deltaTime);
+
+    /**
+     * Gets a character's skinning matrices (one per joint) as of the last update
+     */
+    const glm::mat4* getSkinningMatrices(uint32_t character) const {
+        return m_skinningMatrices.data() + static_cast<size_t>(character) * m_skeleton.getJointCount();
+    }
+
+    uint32_t getCharacterCount() const { return static_cast<uint32_t>(m_characters.size()); }
+    const Skeleton& getSkeleton() const { return m_skeleton; }
+
+private:
+    struct Character {
+        Layer layers[MAX_LAYERS];
+        AnimationSampler samplers[MAX_LAYERS];
+    };
+
+    Skeleton m_skeleton;
+    AnimationPose m_bindPose;
+    std::vector<std::unique_ptr<AnimationClip>> m_clips;   // Heap-allocated so samplers can point at them
+    std::vector<Character> m_characters;
+    std::vector<glm::mat4> m_skinningMatrices;              // Character by character
+
+    void updateCharacter(uint32_t index, float deltaTime);
+};
+
+} // namespace VulkanGameEngine
@@ -0,0 +1,251 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+
+namespace VulkanGameEngine {
+
+class ThreadPool;
+
+/**
+ * AssetArchive reads a pak file: many assets packed into one file, so a
+ * load costs one open and one memory map instead of an open per asset.
+ *
+ * File layout (little-endian):
+ *   Header      magic "VGEPAK01", uint32 version, entry/chunk counts, chunk
+ *               size and the offsets of the three tables below
+ *   chunk data  every asset split into chunks of chunkSize bytes (the last
+ *               one shorter), each LZ4-compressed or stored as is
+ *   Chunk[]     offset, stored size and flags of every chunk
+ *   Entry[]     one per asset, sorted by path hash: hash, path, size, chunks
+ *   paths       the asset paths, not terminated
+ *
+ * The whole file is memory-mapped when opened and nothing is copied until
+ * an asset is read; find() is a binary search over the hashes. Reading an
+ * asset decompresses its chunks in parallel on a ThreadPool.
+ *
+ * Paths are relative with forward slashes, as the engine uses them
+ * ("assets/FinalBaseMesh.obj", "shaders/vertex.vert.spv").
+ */
+class AssetArchive {
+public:
+    static constexpr char MAGIC[8] = {'V', 'G', 'E', 'P', 'A', 'K', '0', '1'};
+    static constexpr uint32_t VERSION = 1;
+    static constexpr uint32_t DEFAULT_CHUNK_SIZE = 64 * 1024;
+
+    struct Header {
+        char magic[8];
+        uint32_t version;
+        uint32_t entryCount;
+        uint32_t chunkCount;
+        uint32_t chunkSize;             // Uncompressed bytes per chunk
+        uint64_t chunkTableOffset;
+        uint64_t entryTableOffset;
+        uint64_t pathsOffset;
+        uint64_t pathsSize;
+    };
+
+    struct Chunk {
+        static constexpr uint32_t COMPRESSED = 1;
+
+        uint64_t offset;                // From the start of the file
+        uint32_t storedSize;            // Bytes in the file
+        uint32_t flags;                 // COMPRESSED, or 0 if stored as is
+    };
+
+    struct Entry {
+        uint64_t pathHash;              // hashPath(path)
+        uint32_t pathOffset;            // Into the paths block
+        uint32_t pathLength;
+        uint64_t size;                  // Uncompressed size
+        uint32_t firstChunk;
+        uint32_t chunkCount;
+    };
+
+    AssetArchive();
+    ~AssetArchive();
+
+    // Non-copyable (owns the mapping)
+    AssetArchive(const AssetArchive&) = delete;
+    AssetArchive& operator=(const AssetArchive&) = delete;
+
+    /**
+     * Maps an archive and validates its tables. Throws std::runtime_error if
+     * the file cannot be mapped or is not a valid archive.
+     */
+    void open(const std::string& path);
+
+    /**
+     * Unmaps the archive
+     */
+    void close();
+
+    bool isOpen() const { return m_data != nullptr; }
+    const std::string& getPath() const { return m_path; }
+    const Header& getHeader() const { return *reinterpret_cast<const Header*>(m_data); }
+
+    /**
+     * Gets every entry, sorted by path hash
+     */
+    const Entry* getEntries() const { return m_entries; }
+    uint32_t getEntryCount() const { return isOpen() ? getHeader().entryCount : 0; }
+    std::string getEntryPath(const Entry& entry) const;
+
+    /**
+     * Finds an asset by path, nullptr if the archive does not contain it
+     */
+    const Entry* find(const std::string& path) const;
+
+    /**
+     * Decompresses an asset. Throws std::runtime_error if a chunk is corrupt.
+     *
+     * @param entry Entry of this archive
+     * @param data Output, resized to the asset size
+     * @param pool Pool to decompress the chunks on
+     */
+    void read(const Entry& entry, std::vector<char>& data, ThreadPool& pool) const;
+
+    /**
+     * Gets the stored size of an asset (its compressed chunks)
+     */
+    uint64_t getStoredSize(const Entry& entry) const;
+
+    /**
+     * Normalizes a path (forward slashes, no leading "./") the way paths are stored
+     */
+    static std::string normalizePath(const std::string& path);
+
+    /**
+     * Hashes a path after normalizing it (64-bit FNV-1a)
+     */
+    static uint64_t hashPath(const std::string& path);
+
+    /**
+     * 64-bit FNV-1a of a byte range. Pass a previous result as the seed to
+     * hash several ranges as one.
+     */
+    static uint64_t hashBytes(const void* data, size_t size, uint64_t seed = 14695981039346656037ull);
+
+private:
+    std::string m_path;
+    const uint8_t* m_data;
+    size_t m_size;
+    const Chunk* m_chunks;
+    const Entry* m_entries;
+    const char* m_paths;
+#ifdef _WIN32
+    void* m_file;
+    void* m_mapping;
+#endif
+
+    void validate() const;
+};
+
+/**
+ * AssetArchiveWriter builds a pak file (see AssetArchive for the layout).
+ *
+ * Usage:
+ *   AssetArchiveWriter writer;
+ *   writer.add("assets/FinalBaseMesh.obj", bytes);
+ *   writer.write("data.pak", ThreadPool::getInstance());
+ */
+class AssetArchiveWriter {
+public:
+    /**
+     * Totals of the last write()
+     */
+    struct Stats {
+        uint32_t entries = 0;
+        uint32_t chunks = 0;
+        uint32_t compressedChunks = 0;
+        uint64_t inputBytes = 0;
+        uint64_t archiveBytes = 0;
+    };
+
+    /**
+     * Adds an asset. Throws std::runtime_error if the path was already added.
+     *
+     * @param path Path the engine will request (normalized with AssetArchive::normalizePath)
+     * @param data Contents
+     */
+    void add(const std::string& path, std::vector<char> data);
+
+    /**
+     * Compresses every asset (chunks in parallel) and writes the archive.
+     * Chunks that do not shrink are stored as is. Throws std::runtime_error
+     * if the file cannot be written.
+     */
+    void write(const std::string& path, ThreadPool& pool, uint32_t chunkSize = AssetArchive::DEFAULT_CHUNK_SIZE);
+
+    size_t getEntryCount() const { return m_assets.size(); }
+    const Stats& getStats() const { return m_stats; }
+
+private:
+    struct Asset {
+        std::string path;
+        std::vector<char> data;
+    };
+
+    std::vector<Asset> m_assets;
+    Stats m_stats;
+};
+
+/**
+ * AssetFileSystem is the engine's file access: it looks paths up in the
+ * mounted archives first (the last mounted wins) and falls back to loose
+ * files, so the same asset paths work with or without a pak file.
+ *
+ * Archives are normally mounted once at startup, before the loading
+ * phases start; lookups may then run on any thread.
+ */
+class AssetFileSystem {
+public:
+    /**
+     * Archive mounted at startup when present and none is given on the command line
+     */
+    static constexpr const char* DEFAULT_ARCHIVE = "data.pak";
+
+    static AssetFileSystem& getInstance();
+
+    /**
+     * Maps an archive and adds it to the search list. Throws std::runtime_error
+     * if the archive cannot be opened (see AssetArchive::open).
+     */
+    void mount(const std::string& archivePath);
+
+    /**
+     * Unmounts every archive (only when no reads are in flight)
+     */
+    void unmountAll();
+
+    /**
+     * Reads an asset from the mounted archives only
+     *
+     * @return true if an archive contained the path
+     */
+    bool readArchived(const std::string& path, std::vector<char>& data) const;
+
+    /**
+     * Reads an asset from the mounted archives, or else from a loose file
+     *
+     * @return false if neither has it
+     */
+    bool readFile(const std::string& path, std::vector<char>& data) const;
+
+    /**
+     * Checks whether any mounted archive contains the path
+     */
+    bool isArchived(const std::string& path) const;
+
+private:
+    AssetFileSystem() = default;
+
+    mutable std::shared_mutex m_mutex;
+    std::vector<std::unique_ptr<AssetArchive>> m_archives;     // Searched from the back
+};
+
+} // namespace VulkanGameEngine
@@ -0,0 +1,175 @@
+#pragma once
+
+#include "Common.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace VulkanGameEngine {
+
+/**
+ * BenchmarkScript describes a deterministic benchmark run: how long to warm
+ * up, how many frames to measure, the simulated time step, and the camera
+ * path and input stream replayed instead of live input.
+ *
+ * Scripts are plain text, one directive per line ('#' starts a comment).
+ * Frame numbers count from the first warmup frame:
+ *
+ *   name orbit                  label copied into the report
+ *   timestep 0.0166667          simulated seconds per frame
+ *   warmup 120                  frames rendered before measuring
+ *   frames 600                  measured frames
+ *   size 1280 720               render size (optional)
+ *   camera <frame> <px> <py> <pz> <tx> <ty> <tz>
+ *                               camera key (position, target); from the first
+ *                               to the last key the camera is interpolated
+ *                               linearly, outside that range it is left alone
+ *   input <first> <last> <forward> <right>
+ *                               replays WASD movement for frames first..last
+ *
+ * `game --record-benchmark path` writes the camera path of an interactive
+ * session in this format.
+ */
+struct BenchmarkScript {
+    /**
+     * Camera position and target at a given frame
+     */
+    struct CameraKey {
+        uint64_t frame = 0;
+        glm::vec3 position = glm::vec3(0.0f);
+        glm::vec3 target = glm::vec3(0.0f);
+    };
+
+    /**
+     * Movement input held for a range of frames (inclusive)
+     */
+    struct InputSpan {
+        uint64_t firstFrame = 0;
+        uint64_t lastFrame = 0;
+        float forward = 0.0f;
+        float right = 0.0f;
+    };
+
+    std::string name = "benchmark";
+    float timeStep = 1.0f / 60.0f;
+    uint64_t warmupFrames = 120;
+    uint64_t measuredFrames = 600;
+    uint32_t width = 0;                     // 0 = keep the default render size
+    uint32_t height = 0;
+    std::vector<CameraKey> cameraPath;      // Sorted by frame
+    std::vector<InputSpan> inputs;
+
+    /**
+     * Parses a script file.
+     *
+     * @param error Set to a message naming the offending line on failure
+     * @return true if the file was read and every line is valid
+     */
+    static bool load(const std::string& path, BenchmarkScript& script, std::string& error);
+
+    /**
+     * Writes the script in the format load() reads
+     */
+    bool save(const std::string& path) const;
+
+    /**
+     * Appends a camera key. A key that repeats the previous two is merged into
+     * the last one, so long stationary stretches stay a single pair of keys.
+     */
+    void addCameraKey(uint64_t frame, const glm::vec3& position, const glm::vec3& target);
+
+    /**
+     * Gets the scripted camera for a frame
+     *
+     * @return false if the frame lies outside the camera path
+     */
+    bool sampleCamera(uint64_t frame, glm::vec3& position, glm::vec3& target) const;
+
+    /**
+     * Sums the movement input active on a frame
+     */
+    void sampleInput(uint64_t frame, float& forward, float& right) const;
+
+    uint64_t getTotalFrames() const { return warmupFrames + measuredFrames; }
+};
+
+/**
+ * Measurements of one benchmark frame
+ */
+struct BenchmarkFrame {
+    double frameMs = 0.0;                   // Whole main-loop iteration
+    double cpuMs = 0.0;                     // render() call
+    double fenceWaitMs = 0.0;
+    bool gpuTimeValid = false;
+    double gpuMs = 0.0;
+    uint64_t allocations = 0;
+    uint32_t vulkanCalls = 0;
+    uint32_t drawCalls = 0;
+    uint32_t recordedDraws = 0;             // Draws the engine recorded (also counted on the null backend)
+    uint64_t triangles = 0;
+};
+
+/**
+ * Where and how a benchmark ran, copied into the report
+ */
+struct BenchmarkRunInfo {
+    std::string scriptPath;
+    std::string backend;
+    bool headless = false;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    std::string scene;                      // SceneGenerator spec (empty = default content)
+    uint32_t sceneObjects = 0;
+    uint32_t sceneDynamicObjects = 0;
+    uint32_t sceneMeshes = 0;
+    uint32_t sceneMaterials = 0;
+};
+
+/**
+ * BenchmarkReport collects the measured frames of a run and writes them as a
+ * JSON summary (exact percentiles over the whole run, not the rolling
+ * MetricsRegistry window), so runs of different builds can be diffed.
+ *
+ * begin() reserves storage for every measured frame up front; recordFrame()
+ * does not allocate.
+ */
+class BenchmarkReport {
+public:
+    /**
+     * Clears previous samples and snapshots the counters deltas are taken from
+     */
+    void begin(uint64_t measuredFrames);
+
+    /**
+     * Adds one measured frame
+     */
+    void recordFrame(const BenchmarkFrame& frame);
+
+    /**
+     * Writes the report.
+     *
+     * @return true if the file was written
+     */
+    bool write(const std::string& path, const BenchmarkScript& script, const BenchmarkRunInfo& info) const;
+
+    size_t getFrameCount() const { return m_frames.size(); }
+
+    /**
+     * Gets the median of the measured frame times (0 without frames)
+     */
+    double getMedianFrameMs() const;
+
+    /**
+     * Gets the peak resident set size of the process so far (0 if unsupported)
+     */
+    static uint64_t getPeakResidentBytes();
+
+private:
+    std::vector<BenchmarkFrame> m_frames;
+    uint64_t m_startUploadBytes = 0;
+    uint64_t m_startHeapAllocations = 0;
+    uint64_t m_startHeapBytes = 0;
+    double m_peakBufferMemory = 0.0;
+};
+
+} // namespace VulkanGameEngine
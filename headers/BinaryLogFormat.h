@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+namespace VulkanGameEngine {
+
+/**
+ * On-disk layout of binary log files (*.blog).
+ *
+ * This header is shared between the runtime sink (BinaryLogSink) and the
+ * offline decoder tool (tools/logdecode.cpp), so it only depends on the
+ * standard library.
+ *
+ * A file is a FileHeader followed by a stream of 8-byte aligned records.
+ * Every record starts with a RecordHeader whose size field is written last,
+ * so a size of zero marks the end of valid data (e.g. after a crash).
+ *
+ * Record types:
+ * - FORMAT_DEFINITION: maps a numeric format ID to its format string.
+ *   Every file repeats the definitions it needs, so each file decodes on its own.
+ * - MESSAGE: a format ID, level, timestamp, thread ID and the raw encoded arguments.
+ *   No text formatting happens at runtime; the decoder substitutes the arguments.
+ */
+namespace BinaryLogFormat {
+
+    constexpr char MAGIC[8] = {'V', 'G', 'E', 'B', 'L', 'O', 'G', '1'};
+    constexpr uint32_t VERSION = 1;
+    constexpr uint32_t RECORD_ALIGNMENT = 8;
+
+    /**
+     * Format ID reserved for plain text messages logged through Logger::log.
+     * Arguments are the category and the already formatted message.
+     */
+    constexpr uint32_t TEXT_MESSAGE_FORMAT_ID = 0;
+
+    enum RecordType : uint16_t {
+        RECORD_FORMAT_DEFINITION = 1,
+        RECORD_MESSAGE = 2
+    };
+
+    /**
+     * Type tags preceding every encoded argument
+     */
+    enum ArgumentType : uint8_t {
+        ARG_INT64 = 1,      // 8 bytes
+        ARG_UINT64 = 2,     // 8 bytes
+        ARG_DOUBLE = 3,     // 8 bytes
+        ARG_BOOL = 4,       // 1 byte
+        ARG_CHAR = 5,       // 1 byte
+        ARG_STRING = 6,     // uint32 length + bytes
+        ARG_POINTER = 7     // 8 bytes
+    };
+
+    struct FileHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t headerSize;
+        uint64_t sequence;              // Rotation sequence number of this file
+        int64_t systemTimeAtStartNs;    // system_clock time matching steadyTimeAtStartNs
+        int64_t steadyTimeAtStartNs;    // Record timestamps are steady_clock values
+    };
+
+    struct RecordHeader {
+        uint32_t size;                  // Total record size including this header (0 = end of data)
+        uint16_t type;                  // RecordType
+        uint16_t reserved;
+    };
+
+    /**
+     * Followed by formatLength bytes of format string (not null-terminated)
+     */
+    struct FormatDefinitionRecord {
+        RecordHeader header;
+        uint32_t formatId;
+        uint32_t formatLength;
+    };
+
+    /**
+     * Followed by argumentBytes of encoded arguments; the first argument is always the category
+     */
+    struct MessageRecord {
+        RecordHeader header;
+        uint32_t formatId;
+        uint32_t threadId;
+        int64_t timestampNs;
+        uint16_t argumentBytes;
+        uint8_t level;
+        uint8_t argumentCount;
+        uint32_t reserved;
+    };
+
+    inline uint32_t alignRecordSize(size_t size) {
+        return static_cast<uint32_t>((size + RECORD_ALIGNMENT - 1) & ~static_cast<size_t>(RECORD_ALIGNMENT - 1));
+    }
+
+    inline bool isValidHeader(const FileHeader& header) {
+        return std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) == 0 && header.version == VERSION;
+    }
+
+} // namespace BinaryLogFormat
+
+} // namespace VulkanGameEngine
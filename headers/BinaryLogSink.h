@@ -0,0 +1,297 @@
+#pragma once
+
+#include "BinaryLogFormat.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace VulkanGameEngine {
+
+/**
+ * Encoding of log arguments into the raw byte stream stored in MESSAGE records.
+ * Each argument is a one byte type tag followed by its value; see BinaryLogFormat.
+ */
+namespace BinaryLogEncoding {
+
+    /**
+     * Fixed-size stack buffer that arguments are encoded into before being copied to the file
+     */
+    struct ArgumentBuffer {
+        static constexpr size_t CAPACITY = 1024;
+
+        uint8_t data[CAPACITY];
+        size_t size = 0;
+        uint8_t count = 0;
+
+        void put(const void* bytes, size_t length) {
+            length = (size + length <= CAPACITY) ? length : CAPACITY - size;
+            std::memcpy(data + size, bytes, length);
+            size += length;
+        }
+
+        bool hasRoom(size_t length) const { return size + length <= CAPACITY; }
+    };
+
+    template <typename T>
+    inline void encodeScalar(ArgumentBuffer& buffer, BinaryLogFormat::ArgumentType type, T value) {
+        if (!buffer.hasRoom(1 + sizeof(T))) {
+            return;
+        }
+        uint8_t tag = type;
+        buffer.put(&tag, 1);
+        buffer.put(&value, sizeof(T));
+        buffer.count++;
+    }
+
+    inline void encodeString(ArgumentBuffer& buffer, const char* text, size_t length) {
+        if (!buffer.hasRoom(1 + sizeof(uint32_t))) {
+            return;
+        }
+        // Long strings are cut to whatever still fits in the record
+        size_t available = ArgumentBuffer::CAPACITY - buffer.size - 1 - sizeof(uint32_t);
+        uint32_t storedLength = static_cast<uint32_t>(length < available ? length : available);
+        uint8_t tag = BinaryLogFormat::ARG_STRING;
+        buffer.put(&tag, 1);
+        buffer.put(&storedLength, sizeof(storedLength));
+        buffer.put(text, storedLength);
+        buffer.count++;
+    }
+
+    inline void encode(ArgumentBuffer& buffer, const std::string& value) { encodeString(buffer, value.data(), value.size()); }
+    inline void encode(ArgumentBuffer& buffer, const char* value) { encodeString(buffer, value ? value : "(null)", value ? std::strlen(value) : 6); }
+    inline void encode(ArgumentBuffer& buffer, char* value) { encode(buffer, static_cast<const char*>(value)); }
+    inline void encode(ArgumentBuffer& buffer, bool value) { encodeScalar<uint8_t>(buffer, BinaryLogFormat::ARG_BOOL, value ? 1 : 0); }
+    inline void encode(ArgumentBuffer& buffer, char value) { encodeScalar<char>(buffer, BinaryLogFormat::ARG_CHAR, value); }
+    inline void encode(ArgumentBuffer& buffer, double value) { encodeScalar<double>(buffer, BinaryLogFormat::ARG_DOUBLE, value); }
+    inline void encode(ArgumentBuffer& buffer, float value) { encodeScalar<double>(buffer, BinaryLogFormat::ARG_DOUBLE, value); }
+
+    template <typename T>
+    typename std::enable_if<std::is_integral<T>::value>::type
+    encode(ArgumentBuffer& buffer, T value) {
+        if (std::is_signed<T>::value) {
+            encodeScalar<int64_t>(buffer, BinaryLogFormat::ARG_INT64, static_cast<int64_t>(value));
+        } else {
+            encodeScalar<uint64_t>(buffer, BinaryLogFormat::ARG_UINT64, static_cast<uint64_t>(value));
+        }
+    }
+
+    template <typename T>
+    typename std::enable_if<std::is_enum<T>::value>::type
+    encode(ArgumentBuffer& buffer, T value) {
+        encode(buffer, static_cast<typename std::underlying_type<T>::type>(value));
+    }
+
+    template <typename T>
+    void encode(ArgumentBuffer& buffer, const T* value) {
+        encodeScalar<uint64_t>(buffer, BinaryLogFormat::ARG_POINTER, reinterpret_cast<uint64_t>(value));
+    }
+
+    inline void encodeAll(ArgumentBuffer&) {}
+
+    template <typename First, typename... Rest>
+    void encodeAll(ArgumentBuffer& buffer, const First& first, const Rest&... rest) {
+        encode(buffer, first);
+        encodeAll(buffer, rest...);
+    }
+
+} // namespace BinaryLogEncoding
+
+/**
+ * BinaryLogSink writes log messages as compact binary records into a
+ * memory-mapped file, without formatting any text at runtime.
+ *
+ * Each message stores a format-string ID, the level, a steady_clock timestamp,
+ * a small per-thread ID and the raw argument bytes. Writers reserve space with
+ * a single atomic add on the mapped file and copy their record in directly, so
+ * any number of threads can log concurrently without taking a lock.
+ *
+ * When a file fills up the sink rotates to a new one (<basePath>.<sequence>.blog)
+ * and deletes files older than maxFiles. Files are decoded offline with the
+ * logdecode tool (text or JSON output).
+ *
+ * Format IDs are keyed by the address of the format string, so format strings
+ * passed to write() must be string literals (or otherwise have static storage).
+ */
+class BinaryLogSink {
+public:
+    /**
+     * Sink configuration
+     */
+    struct Config {
+        std::string basePath = "trace";            // Files are named <basePath>.<sequence>.blog
+        size_t fileCapacity = 64 * 1024 * 1024;     // Bytes mapped per file before rotating
+        uint32_t maxFiles = 4;                      // Older files are deleted on rotation (0 = keep all)
+    };
+
+    BinaryLogSink();
+    ~BinaryLogSink();
+
+    // Non-copyable
+    BinaryLogSink(const BinaryLogSink&) = delete;
+    BinaryLogSink& operator=(const BinaryLogSink&) = delete;
+
+    /**
+     * Creates and maps the first log file. Reopening with the same basePath
+     * continues the file sequence after the last file written, and the new
+     * file starts with the definitions of every format already in use.
+     *
+     * @param config File naming, size and rotation settings
+     * @return true if the file was created and mapped
+     */
+    bool open(const Config& config);
+
+    /**
+     * Unmaps the current file and trims it to the bytes actually written
+     */
+    void close();
+
+    /**
+     * Checks if the sink has an open file
+     */
+    bool isOpen() const { return m_current.load(std::memory_order_acquire) != nullptr; }
+
+    /**
+     * Writes a message with typed arguments. Nothing is formatted here; the
+     * arguments are stored as raw bytes next to the format's ID.
+     *
+     * @param level Numeric log level (Logger::Level value)
+     * @param format Format string with "{}" placeholders (must have static storage)
+     * @param category Category shown next to the level when decoded
+     * @param args Values for the placeholders
+     */
+    template <typename... Args>
+    void write(uint8_t level, const char* format, const std::string& category, const Args&... args) {
+        BinaryLogEncoding::ArgumentBuffer buffer;
+        BinaryLogEncoding::encode(buffer, category);
+        BinaryLogEncoding::encodeAll(buffer, args...);
+        writeMessage(level, getFormatId(format), buffer);
+    }
+
+    /**
+     * Writes an already formatted text message (used for plain Logger::log calls)
+     */
+    void writeText(uint8_t level, const std::string& message, const std::string& category);
+
+    /**
+     * Gets the number of messages lost because a record could not be reserved
+     */
+    uint64_t getDroppedMessageCount() const { return m_droppedMessages.load(std::memory_order_relaxed); }
+
+    /**
+     * Gets the path of the file currently being written
+     */
+    std::string getCurrentFilePath() const;
+
+private:
+    /**
+     * One memory-mapped log file. Mapping objects are kept alive until the
+     * sink is destroyed so writers that raced with a rotation never touch freed memory.
+     */
+    struct Mapping {
+        uint8_t* data = nullptr;
+        size_t capacity = 0;
+        uint64_t sequence = 0;
+        std::string path;
+        std::atomic<size_t> writeOffset{0};
+        std::atomic<uint32_t> activeWriters{0};
+#ifdef _WIN32
+        void* fileHandle = nullptr;
+        void* mappingHandle = nullptr;
+#else
+        int fileDescriptor = -1;
+#endif
+    };
+
+    static constexpr size_t FORMAT_TABLE_SIZE = 4096;  // Open-addressing table, power of two
+
+    struct FormatSlot {
+        std::atomic<const char*> format{nullptr};
+        std::atomic<uint32_t> id{0};
+    };
+
+    Config m_config;
+    std::atomic<Mapping*> m_current{nullptr};
+    std::deque<Mapping> m_mappings;                    // All mappings ever created (see Mapping)
+    std::mutex m_rotationMutex;
+    std::atomic<uint64_t> m_droppedMessages{0};
+
+    FormatSlot m_formatTable[FORMAT_TABLE_SIZE];
+    std::mutex m_formatMutex;                          // Taken only when a new format string is first seen
+    std::mutex m_definitionsMutex;                     // Guards m_formatDefinitions
+    std::vector<const char*> m_formatDefinitions;      // Index = format ID - 1
+
+    /**
+     * Returns the ID for a format string, registering it on first use
+     */
+    uint32_t getFormatId(const char* format);
+
+    /**
+     * Copies an encoded message into the current file
+     */
+    void writeMessage(uint8_t level, uint32_t formatId, const BinaryLogEncoding::ArgumentBuffer& arguments);
+
+    /**
+     * Writes a format definition record into the current file
+     */
+    void writeFormatDefinition(uint32_t formatId, const char* format);
+
+    /**
+     * Reserves size bytes in the current file and returns a pointer to them.
+     * The caller must release the returned mapping when done writing.
+     *
+     * @return Pointer into the mapping, or nullptr if the sink is closed
+     */
+    uint8_t* reserve(uint32_t size, Mapping*& mapping);
+
+    /**
+     * Finishes a record started with reserve(): publishes its size and releases the mapping
+     */
+    void commit(Mapping* mapping, uint8_t* record, uint32_t size);
+
+    /**
+     * Switches to a new file once the given mapping is full
+     */
+    void rotate(Mapping* full);
+
+    /**
+     * Writes a definition record for every format registered so far at the
+     * start of a file that is not yet published to writers
+     */
+    void writeKnownFormatDefinitions(Mapping& mapping);
+
+    /**
+     * Deletes the file that falls out of the maxFiles window once newestSequence exists
+     */
+    void removeExpiredFile(uint64_t newestSequence);
+
+    /**
+     * Creates, sizes and maps a new log file
+     */
+    bool mapFile(Mapping& mapping);
+
+    /**
+     * Unmaps a file and truncates it to the written size
+     */
+    void unmapFile(Mapping& mapping);
+
+    /**
+     * Returns a small, stable ID for the calling thread
+     */
+    static uint32_t getThreadId();
+
+    /**
+     * Gets the current steady_clock time in nanoseconds
+     */
+    static int64_t getTimestampNs() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+};
+
+} // namespace VulkanGameEngine
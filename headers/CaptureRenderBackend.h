@@ -0,0 +1,91 @@
+#pragma once
+
+#include "RenderBackend.h"
+#include <string>
+#include <unordered_map>
+
+namespace VulkanGameEngine {
+
+/**
+ * CaptureRenderBackend wraps another backend and can save any frame it
+ * records as a FrameCapture.
+ *
+ * Every call is forwarded unchanged. On the side it keeps a copy of each
+ * buffer's contents (uniform and dynamic vertex updates are copied into the
+ * existing storage, so steady-state frames still do not allocate) and of each
+ * pipeline's SPIR-V, which is what makes a capture replayable without the
+ * game's assets.
+ *
+ * Nothing is written until captureNextFrame() arms it; the next recordFrame()
+ * then saves the command list together with just the pipelines and buffers it
+ * references.
+ */
+class CaptureRenderBackend : public RenderBackend {
+public:
+    explicit CaptureRenderBackend(std::unique_ptr<RenderBackend> inner);
+    ~CaptureRenderBackend() override;
+
+    const char* getName() const override { return m_inner->getName(); }
+
+    void initialize(const BackendConfig& config) override { m_inner->initialize(config); }
+    void cleanup() override;
+    void waitIdle() override { m_inner->waitIdle(); }
+    void resize(uint32_t width, uint32_t height) override { m_inner->resize(width, height); }
+    void getRenderExtent(uint32_t& width, uint32_t& height) const override { m_inner->getRenderExtent(width, height); }
+
+    BufferHandle createBuffer(BufferType type, const void* data, size_t size) override;
+    void updateBuffer(BufferHandle buffer, const void* data, size_t size) override;
+    void updateBufferRange(BufferHandle buffer, size_t offset, const void* data, size_t size) override;
+    void destroyBuffer(BufferHandle buffer) override;
+    PipelineHandle createPipeline(const PipelineDesc& desc) override;
+    void destroyPipeline(PipelineHandle pipeline) override;
+    void replacePipeline(PipelineHandle pipeline, const PipelineDesc& desc) override;
+
+    FrameStatus beginFrame(uint32_t frameSlot) override { return m_inner->beginFrame(frameSlot); }
+    void recordFrame(const CommandList& commands) override;
+    void submitFrame() override { m_inner->submitFrame(); }
+    FrameStatus presentFrame() override { return m_inner->presentFrame(); }
+
+    const BackendTimings& getTimings() const override { return m_inner->getTimings(); }
+    const GpuProfiler::FrameResults& getGpuResults() const override { return m_inner->getGpuResults(); }
+
+    void readbackFrame(std::vector<uint8_t>& pixels, uint32_t& width, uint32_t& height) override {
+        m_inner->readbackFrame(pixels, width, height);
+    }
+    bool requestReadback(uint64_t tag) override { return m_inner->requestReadback(tag); }
+    bool pollReadback(ReadbackFrame& frame) override { return m_inner->pollReadback(frame); }
+    void releaseReadback(uint32_t id) override { m_inner->releaseReadback(id); }
+
+    /**
+     * Saves the next recorded frame to a file
+     *
+     * @param frameIndex Engine frame number stored in the capture
+     */
+    void captureNextFrame(const std::string& path, uint64_t frameIndex);
+
+    /**
+     * Checks if a capture is armed but not yet written
+     */
+    bool isCapturePending() const { return !m_pendingPath.empty(); }
+
+private:
+    struct BufferShadow {
+        BufferType type;
+        std::vector<uint8_t> contents;
+    };
+
+    std::unique_ptr<RenderBackend> m_inner;
+    std::unordered_map<BufferHandle, BufferShadow> m_buffers;
+    std::unordered_map<PipelineHandle, PipelineDesc> m_pipelines;  // Descs with the SPIR-V loaded
+    std::string m_pendingPath;
+    uint64_t m_pendingFrameIndex;
+
+    /**
+     * Stores a pipeline's description with its SPIR-V for later captures
+     */
+    void shadowPipeline(PipelineHandle pipeline, const PipelineDesc& desc);
+
+    void writeCapture(const CommandList& commands);
+};
+
+} // namespace VulkanGameEngine
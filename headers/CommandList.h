@@ -0,0 +1,104 @@
+#pragma once
+
+#include "Common.h"
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+namespace VulkanGameEngine {
+
+/**
+ * Opaque handles to resources owned by a RenderBackend (0 = none)
+ */
+using BufferHandle = uint32_t;
+using PipelineHandle = uint32_t;
+constexpr uint32_t INVALID_HANDLE = 0;
+
+/**
+ * Kinds of commands a CommandList can hold
+ */
+enum class CommandType : uint8_t {
+    BEGIN_PASS,             // Begin the main render pass, clearing color and depth
+    END_PASS,
+    BIND_PIPELINE,
+    SET_FULL_VIEWPORT,      // Viewport and scissor covering the whole render target
+    BIND_VERTEX_BUFFER,
+    BIND_INDEX_BUFFER,
+    BIND_UNIFORMS,          // Uniform buffer at set 0, binding 0
+    PUSH_OBJECT_CONSTANTS,  // Per-draw ObjectConstants (index into the list's constant storage)
+    DRAW_INDEXED,
+    BEGIN_ZONE,             // GPU timing zone (see GpuProfiler)
+    END_ZONE
+};
+
+/**
+ * One recorded command. Plain data so lists can be reused without allocating.
+ */
+struct Command {
+    CommandType type;
+    uint32_t handle = INVALID_HANDLE;   // Buffer or pipeline
+    uint32_t indexCount = 0;
+    uint32_t firstIndex = 0;
+    int32_t vertexOffset = 0;
+    float clearColor[4] = {};
+    const char* name = nullptr;         // Zone label (static storage)
+};
+
+/**
+ * CommandList is the backend-neutral record of one frame's rendering work.
+ *
+ * The engine fills a CommandList every frame with the same calls it would
+ * make on a Vulkan command buffer, and the active RenderBackend translates it
+ * (VulkanRenderBackend) or ignores it (NullRenderBackend). Keeping the list
+ * separate from the backend means the engine's scene walk and recording cost
+ * can be measured with no driver underneath.
+ *
+ * reset() keeps the capacity, so after the first few frames recording never
+ * touches the heap. Per-draw push constants are kept in a separate array so
+ * Command stays small.
+ */
+class CommandList {
+public:
+    /**
+     * Clears all commands but keeps the storage
+     */
+    void reset() {
+        m_commands.clear();
+        m_objectConstants.clear();
+    }
+
+    /**
+     * Pre-sizes the list for the given number of commands and per-draw constants
+     */
+    void reserve(size_t count, size_t objectConstantCount = 0) {
+        m_commands.reserve(count);
+        m_objectConstants.reserve(objectConstantCount);
+    }
+
+    // Recording
+    void beginPass(float r, float g, float b, float a);
+    void endPass();
+    void bindPipeline(PipelineHandle pipeline);
+    void setFullViewport();
+    void bindVertexBuffer(BufferHandle buffer);
+    void bindIndexBuffer(BufferHandle buffer);
+    void bindUniforms(BufferHandle buffer);
+    void pushObjectConstants(const ObjectConstants& constants);
+    void drawIndexed(uint32_t indexCount, uint32_t firstIndex = 0, int32_t vertexOffset = 0);
+    void beginZone(const char* name);
+    void endZone();
+
+    // Access
+    const std::vector<Command>& getCommands() const { return m_commands; }
+    const ObjectConstants& getObjectConstants(uint32_t index) const { return m_objectConstants[index]; }
+    size_t size() const { return m_commands.size(); }
+    bool empty() const { return m_commands.empty(); }
+
+private:
+    std::vector<Command> m_commands;
+    std::vector<ObjectConstants> m_objectConstants;     // Referenced by PUSH_OBJECT_CONSTANTS commands
+
+    Command& push(CommandType type);
+};
+
+} // namespace VulkanGameEngine
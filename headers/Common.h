@@ -74,16 +74,22 @@ namespace VulkanGameEngine {
      * This structure defines the layout of vertex data that will be passed
      * to the vertex shader. Each vertex contains:
      * - Position: 3D coordinates in model space
-     * - Color: RGB color values for per-vertex coloring
      * - TexCoord: 2D texture coordinates for texture mapping
+     * - Normal: unit surface normal in model space (for lighting)
+     * - Tangent: unit tangent along +U, w = bitangent sign (MikkTSpace convention)
+     * 
+     * Normals and tangents come from the mesh file or from MeshProcessing.
+     * Colors are not stored: the vertex shader generates them from the
+     * ColorMode in ObjectConstants.
      * 
      * The structure provides static methods to describe its layout to Vulkan,
      * which is essential for the graphics pipeline configuration.
      */
     struct Vertex {
         glm::vec3 position;   ///< 3D position (x, y, z)
-        glm::vec3 color;      ///< RGB color (r, g, b)
         glm::vec2 texCoord;   ///< Texture coordinates (u, v)
+        glm::vec3 normal;     ///< Unit normal (x, y, z)
+        glm::vec4 tangent;    ///< Unit tangent (x, y, z) and bitangent sign (w)
         
         /**
          * @brief Get vertex binding description for Vulkan pipeline
@@ -114,10 +120,10 @@ namespace VulkanGameEngine {
          * - Format: Data type and component count
          * - Offset: Byte offset within the vertex structure
          * 
-         * @return Array of attribute descriptions for position, color, and texCoord
+         * @return Array of attribute descriptions for position, texCoord, normal and tangent
          */
-        static std::array<VkVertexInputAttributeDescription, 3> getAttributeDescriptions() {
-            std::array<VkVertexInputAttributeDescription, 3> attributeDescriptions{};
+        static std::array<VkVertexInputAttributeDescription, 4> getAttributeDescriptions() {
+            std::array<VkVertexInputAttributeDescription, 4> attributeDescriptions{};
             
             // Position attribute (location = 0 in vertex shader)
             attributeDescriptions[0].binding = 0;
@@ -125,22 +131,45 @@ namespace VulkanGameEngine {
             attributeDescriptions[0].format = VK_FORMAT_R32G32B32_SFLOAT;  // vec3 (3x float32)
             attributeDescriptions[0].offset = offsetof(Vertex, position);
             
-            // Color attribute (location = 1 in vertex shader)
+            // Texture coordinate attribute (location = 1 in vertex shader)
             attributeDescriptions[1].binding = 0;
             attributeDescriptions[1].location = 1;
-            attributeDescriptions[1].format = VK_FORMAT_R32G32B32_SFLOAT;  // vec3 (3x float32)
-            attributeDescriptions[1].offset = offsetof(Vertex, color);
+            attributeDescriptions[1].format = VK_FORMAT_R32G32_SFLOAT;     // vec2 (2x float32)
+            attributeDescriptions[1].offset = offsetof(Vertex, texCoord);
             
-            // Texture coordinate attribute (location = 2 in vertex shader)
+            // Normal attribute (location = 2 in vertex shader)
             attributeDescriptions[2].binding = 0;
             attributeDescriptions[2].location = 2;
-            attributeDescriptions[2].format = VK_FORMAT_R32G32_SFLOAT;     // vec2 (2x float32)
-            attributeDescriptions[2].offset = offsetof(Vertex, texCoord);
+            attributeDescriptions[2].format = VK_FORMAT_R32G32B32_SFLOAT;  // vec3 (3x float32)
+            attributeDescriptions[2].offset = offsetof(Vertex, normal);
+            
+            // Tangent attribute (location = 3 in vertex shader)
+            attributeDescriptions[3].binding = 0;
+            attributeDescriptions[3].location = 3;
+            attributeDescriptions[3].format = VK_FORMAT_R32G32B32A32_SFLOAT; // vec4 (4x float32)
+            attributeDescriptions[3].offset = offsetof(Vertex, tangent);
             
             return attributeDescriptions;
         }
     };
     
+    /**
+     * @brief Vertex color schemes generated by the vertex shader
+     * 
+     * OBJ files carry no vertex colors, so the shader derives one from the
+     * vertex index and model-space position. The values are shared with
+     * shaders/vertex.vert; changing the mode of a mesh only changes the
+     * ObjectConstants of its draws.
+     */
+    enum class ColorMode : uint32_t {
+        RAINBOW,        ///< Golden ratio hues per vertex
+        GRADIENT,       ///< Smooth gradient based on height
+        ANATOMICAL,     ///< Different colors per body part (height bands)
+        METALLIC,       ///< Metallic/shiny appearance
+        PASTEL,         ///< Soft pastel colors
+        FACES           ///< One solid color per 4-vertex face (the fallback cube)
+    };
+    
     /**
      * @brief Uniform Buffer Object for MVP matrices
      * 
@@ -149,10 +178,23 @@ namespace VulkanGameEngine {
      * alignment for Vulkan uniform buffer requirements.
      */
     struct UniformBufferObject {
-        alignas(16) glm::mat4 model;       ///< Model transformation matrix
+        alignas(16) glm::mat4 model;       ///< Model matrix (unused by the engine shaders, see ObjectConstants)
         alignas(16) glm::mat4 view;        ///< View (camera) transformation matrix
         alignas(16) glm::mat4 projection;  ///< Projection transformation matrix
     };
+    
+    /**
+     * @brief Per-object data passed to the vertex shader as push constants
+     * 
+     * The uniform buffer holds what is shared by every draw in a frame (camera);
+     * each draw pushes its own model matrix, material tint and color mode.
+     * 96 bytes, inside the 128 bytes every Vulkan implementation guarantees.
+     */
+    struct ObjectConstants {
+        alignas(16) glm::mat4 model;       ///< Model transformation matrix
+        alignas(16) glm::vec4 tint;        ///< Multiplied with the vertex color (material)
+        ColorMode colorMode = ColorMode::RAINBOW; ///< How the vertex shader colors the mesh
+    };
 }
 
 // Forward declarations for main engine classes
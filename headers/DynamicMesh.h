@@ -0,0 +1,104 @@
+#pragma once
+
+#include "Common.h"
+#include "RenderBackend.h"
+#include <vector>
+
+namespace VulkanGameEngine {
+
+/**
+ * DynamicMesh is indexed geometry whose vertices change while it is drawn:
+ * procedural surfaces, CPU skinning, cloth.
+ *
+ * The vertices stay authoritative on the CPU and live on the GPU in a
+ * DYNAMIC_VERTEX buffer, which keeps one copy per frame in flight. Changing
+ * vertices extends a dirty range of every copy; flush() then writes just the
+ * range the current frame's copy is missing straight into mapped memory. A
+ * mesh rewritten every frame costs one memcpy of the changed vertices per
+ * frame and never waits for the GPU; a mesh left alone costs nothing. The
+ * indices never change and are uploaded once.
+ *
+ * Each copy tracks a single range, so changes to far-apart vertices in the
+ * same frame upload everything between them.
+ *
+ * Usage:
+ *   mesh.create(backend, vertices, indices);
+ *   ...every frame, after beginFrame(slot):
+ *   mesh.getVertices()[i].position = ...;
+ *   mesh.markDirty(first, count);
+ *   mesh.flush(slot);
+ *   commands.bindVertexBuffer(mesh.getVertexBuffer());
+ */
+class DynamicMesh {
+public:
+    DynamicMesh();
+    ~DynamicMesh();
+
+    // Non-copyable (owns backend buffers)
+    DynamicMesh(const DynamicMesh&) = delete;
+    DynamicMesh& operator=(const DynamicMesh&) = delete;
+
+    /**
+     * Creates the vertex and index buffers, replacing any previous ones.
+     * Throws std::runtime_error on empty data or out-of-range indices.
+     *
+     * @param backend Backend that owns the buffers (must outlive the mesh)
+     */
+    void create(RenderBackend& backend, const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices);
+
+    /**
+     * Destroys the buffers. Safe to call multiple times.
+     */
+    void destroy();
+
+    /**
+     * Copies count vertices over the vertices starting at first and marks them dirty
+     */
+    void update(uint32_t first, const Vertex* vertices, uint32_t count);
+
+    /**
+     * Marks vertices changed through getVertices() for upload
+     */
+    void markDirty(uint32_t first, uint32_t count);
+
+    /**
+     * Marks every vertex for upload
+     */
+    void markAllDirty() { markDirty(0, getVertexCount()); }
+
+    /**
+     * Uploads the vertices the frame's copy is missing. Call once per frame
+     * between the backend's beginFrame and submitFrame.
+     *
+     * @param frameSlot Slot passed to beginFrame
+     * @return Bytes uploaded (0 if the copy was up to date)
+     */
+    size_t flush(uint32_t frameSlot);
+
+    // Getters
+    std::vector<Vertex>& getVertices() { return m_vertices; }
+    const std::vector<Vertex>& getVertices() const { return m_vertices; }
+    BufferHandle getVertexBuffer() const { return m_vertexBuffer; }
+    BufferHandle getIndexBuffer() const { return m_indexBuffer; }
+    uint32_t getVertexCount() const { return static_cast<uint32_t>(m_vertices.size()); }
+    uint32_t getIndexCount() const { return m_indexCount; }
+    bool isCreated() const { return m_backend != nullptr; }
+
+private:
+    /**
+     * Vertices [begin, end) that a frame's copy is missing (empty when begin == end)
+     */
+    struct DirtyRange {
+        uint32_t begin = 0;
+        uint32_t end = 0;
+    };
+
+    RenderBackend* m_backend;           // Backend owning the buffers (not owned)
+    BufferHandle m_vertexBuffer;
+    BufferHandle m_indexBuffer;
+    uint32_t m_indexCount;
+    std::vector<Vertex> m_vertices;
+    DirtyRange m_dirty[MAX_FRAMES_IN_FLIGHT];
+};
+
+} // namespace VulkanGameEngine
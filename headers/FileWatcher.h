@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace VulkanGameEngine {
+
+/**
+ * FileWatcher reports files that changed in a set of watched directories.
+ *
+ * On Linux the kernel queues the changes (inotify), so polling costs one
+ * non-blocking read when nothing happened. Other platforms compare write
+ * times, rescanning the directories a few times per second.
+ *
+ * Editors and compilers rarely write a file in one go: a save can be a
+ * truncate, several writes and a rename, and glslc rewrites the output
+ * while it runs. Changes are therefore debounced: a path is reported once
+ * no further change to it has been seen for the debounce time, and then
+ * only once.
+ *
+ * Usage:
+ *   FileWatcher watcher;
+ *   watcher.watch("shaders", ".spv");
+ *   ...once per frame:
+ *   watcher.poll(changed);    // "shaders/vertex.vert.spv" after the write settles
+ */
+class FileWatcher {
+public:
+    static constexpr uint32_t DEFAULT_DEBOUNCE_MS = 150;
+
+    /**
+     * @param debounceMs Quiet time before a changed file is reported
+     */
+    explicit FileWatcher(uint32_t debounceMs = DEFAULT_DEBOUNCE_MS);
+    ~FileWatcher();
+
+    // Non-copyable
+    FileWatcher(const FileWatcher&) = delete;
+    FileWatcher& operator=(const FileWatcher&) = delete;
+
+    /**
+     * Starts watching the files of a directory (not its subdirectories)
+     *
+     * @param directory Directory to watch; reported paths start with it
+     * @param extension Only files whose names end with it are reported
+     * @return false (after logging) if the directory cannot be watched
+     */
+    bool watch(const std::string& directory, const std::string& extension);
+
+    /**
+     * Collects new changes and appends the paths that have settled to changed
+     * (sorted, each once). Never blocks.
+     */
+    void poll(std::vector<std::string>& changed);
+
+    /**
+     * Checks if the platform notifies changes (false = write times are polled)
+     */
+    static bool isNative();
+
+private:
+    struct Watch {
+        std::string directory;
+        std::string extension;
+        int descriptor = -1;                                            // inotify watch
+        std::unordered_map<std::string, std::filesystem::file_time_type> writeTimes;   // Polling fallback
+    };
+
+    std::vector<Watch> m_watches;
+    std::unordered_map<std::string, int64_t> m_pending;    // Changed path -> time of its latest change
+    int64_t m_debounceNs;
+    int m_inotify;                                          // inotify descriptor (-1 = not available)
+    int64_t m_lastScan;                                     // Polling fallback: time of the last rescan
+
+    /**
+     * Reads the queued inotify events into m_pending
+     */
+    void readEvents(int64_t now);
+
+    /**
+     * Polling fallback: compares the write times of a watch's files with the last scan
+     *
+     * @param report Add changed files to m_pending (false on the first scan)
+     */
+    void scan(Watch& watch, int64_t now, bool report);
+
+    static bool hasExtension(const std::string& name, const std::string& extension);
+};
+
+} // namespace VulkanGameEngine
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "RenderBackend.h"
+#include <deque>
+#include <string>
+#include <vector>
+
+namespace VulkanGameEngine {
+
+/**
+ * FrameCapture is one frame's engine-level workload, self-contained enough to
+ * re-execute without the game: the frame's CommandList, every pipeline and
+ * buffer it references (SPIR-V and buffer contents included, uniform buffers
+ * as they were when the frame was recorded) and the render size.
+ *
+ * Captures are written by CaptureRenderBackend (`game --capture`) and
+ * replayed by tools/framereplay.cpp.
+ *
+ * File layout (*.vgecap, little-endian; strings are uint32 length + bytes,
+ * blobs are uint64 length + bytes):
+ *
+ *   char[8] magic "VGECAP01", uint32 version
+ *   uint32 width, uint32 height, uint64 frameIndex, string backend
+ *   uint32 pipelineCount, then per pipeline:
+ *     uint32 handle, string vertexPath, string fragmentPath, blob vertexSpirv, blob fragmentSpirv
+ *   uint32 bufferCount, then per buffer:
+ *     uint32 handle, uint8 BufferType, blob contents
+ *   uint32 objectConstantCount, then ObjectConstants (96 bytes each)
+ *   uint32 commandCount, then per command a uint8 CommandType and its operands:
+ *     BEGIN_PASS float[4] | BIND_* uint32 handle | PUSH_OBJECT_CONSTANTS uint32 index |
+ *     DRAW_INDEXED uint32 indexCount, uint32 firstIndex, int32 vertexOffset |
+ *     BEGIN_ZONE string | others nothing
+ *
+ * Handles are those of the capturing process; a replay creates its own
+ * resources and maps them.
+ */
+struct FrameCapture {
+    static constexpr char MAGIC[8] = {'V', 'G', 'E', 'C', 'A', 'P', '0', '1'};
+    static constexpr uint32_t VERSION = 3;   // 2: vertex colors moved into ObjectConstants, 3: normals and tangents
+
+    struct Pipeline {
+        PipelineHandle handle = INVALID_HANDLE;
+        PipelineDesc desc;                  // Paths plus the SPIR-V they held at capture time
+    };
+
+    struct Buffer {
+        BufferHandle handle = INVALID_HANDLE;
+        BufferType type = BufferType::VERTEX;
+        std::vector<uint8_t> contents;
+    };
+
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint64_t frameIndex = 0;
+    std::string backend;                    // Backend the frame was captured on
+    std::vector<Pipeline> pipelines;
+    std::vector<Buffer> buffers;
+    CommandList commands;
+
+    FrameCapture() = default;
+    FrameCapture(const FrameCapture&) = delete;             // commands point into zoneNames
+    FrameCapture& operator=(const FrameCapture&) = delete;
+
+    /**
+     * Writes the capture.
+     *
+     * @return false (after logging) if the file cannot be written
+     */
+    bool save(const std::string& path) const;
+
+    /**
+     * Reads a capture written by save()
+     *
+     * @param error Set to the reason on failure
+     */
+    static bool load(const std::string& path, FrameCapture& capture, std::string& error);
+
+    /**
+     * Replaces the commands with a copy of a recorded list (zone names are copied too)
+     */
+    void setCommands(const CommandList& source);
+
+    const Pipeline* findPipeline(PipelineHandle handle) const;
+    const Buffer* findBuffer(BufferHandle handle) const;
+
+    /**
+     * Adds a zone name that lives as long as the capture (CommandList keeps only the pointer)
+     */
+    const char* storeZoneName(const std::string& name);
+
+private:
+    std::deque<std::string> m_zoneNames;    // Stable storage for loaded BEGIN_ZONE names
+};
+
+} // namespace VulkanGameEngine
@@ -0,0 +1,140 @@
+#pragma once
+
+#include "RenderBackend.h"
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace VulkanGameEngine {
+
+/**
+ * FrameRecorder writes rendered frames to disk without stalling the frame
+ * loop or the GPU queue.
+ *
+ * Each selected frame is copied by the backend into a host-visible readback
+ * buffer as part of the frame's own command buffer (RenderBackend::
+ * requestReadback). Once the frame's fence has signalled - which the engine
+ * waits for anyway before reusing the frame slot - the buffer is handed,
+ * still mapped, to a writer thread, which converts and writes it and then
+ * returns the buffer to the backend's ring. The render thread only moves
+ * small descriptors around.
+ *
+ * If the writer falls so far behind that every readback buffer is taken,
+ * frames are skipped rather than waited for; getStats() reports how many.
+ */
+class FrameRecorder {
+public:
+    /**
+     * Output formats
+     */
+    enum class Format {
+        PPM_SEQUENCE,   // One numbered binary PPM per frame in a directory (frame_000042.ppm)
+        Y4M             // One raw YUV4MPEG2 (4:4:4) video stream, playable by ffmpeg/ffplay/mpv
+    };
+
+    /**
+     * Recording settings
+     */
+    struct Config {
+        std::string path;                       // Directory (PPM_SEQUENCE) or file (Y4M)
+        Format format = Format::PPM_SEQUENCE;
+        uint32_t every = 1;                     // Record every Nth frame
+        uint32_t fps = 60;                      // Frame rate written to the Y4M header
+    };
+
+    /**
+     * Frame counts of the current (or last) recording
+     */
+    struct Stats {
+        uint64_t written = 0;                   // Frames written to disk
+        uint64_t skipped = 0;                   // Selected frames not recorded (no free readback buffer)
+        uint64_t failed = 0;                    // Frames the writer could not write
+    };
+
+    FrameRecorder();
+    ~FrameRecorder();
+
+    // Non-copyable
+    FrameRecorder(const FrameRecorder&) = delete;
+    FrameRecorder& operator=(const FrameRecorder&) = delete;
+
+    /**
+     * Picks the format from a path: *.y4m records video, anything else a PPM sequence
+     */
+    static Format getFormatForPath(const std::string& path);
+
+    /**
+     * Opens the output and starts the writer thread.
+     * Throws std::runtime_error if the output cannot be created.
+     *
+     * @param backend Backend to read frames back from; stop() must be called before it is cleaned up
+     */
+    void start(const Config& config, RenderBackend& backend);
+
+    /**
+     * Writes the frames still in flight, then stops the writer thread.
+     * Waits for the GPU, so call it outside the frame loop.
+     */
+    void stop();
+
+    /**
+     * Checks if a recording is running
+     */
+    bool isActive() const { return m_active; }
+
+    /**
+     * Per-frame hook, called after RenderBackend::beginFrame and before
+     * recordFrame: passes finished readbacks to the writer and requests a
+     * readback of this frame if it is selected. Never blocks.
+     *
+     * @param frame Engine frame number (used for selection and file names)
+     */
+    void onFrame(uint64_t frame);
+
+    /**
+     * Gets the frame counts
+     */
+    Stats getStats() const;
+
+private:
+    // Finished readbacks waiting for the writer; never more than the backend's ring holds
+    static constexpr size_t QUEUE_CAPACITY = 16;
+
+    Config m_config;
+    bool m_active;
+    RenderBackend* m_backend;                   // Backend the readbacks come from (set before the writer starts)
+
+    std::thread m_writerThread;
+    std::mutex m_mutex;
+    std::condition_variable m_wakeup;           // Writer: work or stop; producer: space
+    std::array<ReadbackFrame, QUEUE_CAPACITY> m_queue;
+    size_t m_queueHead;                         // Next frame the writer takes
+    size_t m_queueCount;
+    bool m_stopping;
+
+    std::atomic<uint64_t> m_written;
+    std::atomic<uint64_t> m_skipped;
+    std::atomic<uint64_t> m_failed;
+
+    // Writer thread state
+    std::FILE* m_video;                         // Y4M output
+    uint32_t m_videoWidth;                      // Size in the Y4M header (0 = header not written yet)
+    uint32_t m_videoHeight;
+    std::vector<uint8_t> m_scratch;             // Conversion buffer, sized on the first frame
+
+    /**
+     * Queues a finished readback for the writer, waiting for space if needed
+     */
+    void push(const ReadbackFrame& frame);
+
+    void writerThreadMain();
+    bool writePPM(const ReadbackFrame& frame);
+    bool writeY4M(const ReadbackFrame& frame);
+};
+
+} // namespace VulkanGameEngine
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace VulkanGameEngine {
+
+/**
+ * GeometryCodec compresses vertex and index buffers losslessly for cooked
+ * meshes (MeshAsset), with decoders built to run at memory speed.
+ *
+ * Indices: each triangle is rotated (keeping its winding) to the corner
+ * order that continues closest to the previous triangle, as in a fan, and
+ * every index is stored as the zigzag-encoded delta from the one before.
+ * The deltas go in blocks of 16, each block stored at the smallest byte
+ * width (1, 2 or 4) that holds all of them. After the vertex cache
+ * ordering of the cooker almost every block fits one byte.
+ *
+ * Vertices: the buffer is transposed so byte k of every vertex forms one
+ * stream, each byte is replaced by its difference to the same byte of the
+ * previous vertex, and the result is LZ4-compressed. Neighbouring vertices
+ * share exponents and high mantissa bits, so most of the streams become
+ * zeros.
+ *
+ * The decoders undo the deltas and the transposition 16 values at a time
+ * with SSE2 or NEON, writing straight into the caller's buffer; other
+ * targets use the equivalent scalar code.
+ */
+namespace GeometryCodec {
+
+    /**
+     * Appends an encoded vertex stream to out.
+     *
+     * @param vertices count vertices of stride bytes each
+     * @param count Number of vertices
+     * @param stride Bytes per vertex (at most 256)
+     * @param out Output, appended to
+     */
+    void encodeVertices(const void* vertices, size_t count, size_t stride, std::vector<uint8_t>& out);
+
+    /**
+     * Decodes a stream written by encodeVertices.
+     *
+     * @param vertices Output for count vertices of stride bytes each
+     * @param count Number of vertices, as encoded
+     * @param stride Bytes per vertex, as encoded
+     * @param data Encoded stream
+     * @param size Bytes in the encoded stream
+     * @return false if the stream is corrupt or does not match count and stride
+     */
+    bool decodeVertices(void* vertices, size_t count, size_t stride, const uint8_t* data, size_t size);
+
+    /**
+     * Appends an encoded index stream to out. Complete triangles may be
+     * rotated (same winding, same triangles) to shorten the deltas.
+     */
+    void encodeIndices(const uint32_t* indices, size_t count, std::vector<uint8_t>& out);
+
+    /**
+     * Decodes a stream written by encodeIndices.
+     *
+     * @return false if the stream is corrupt or does not hold exactly count indices
+     */
+    bool decodeIndices(uint32_t* indices, size_t count, const uint8_t* data, size_t size);
+
+} // namespace GeometryCodec
+} // namespace VulkanGameEngine
@@ -0,0 +1,205 @@
+#pragma once
+
+#include "Common.h"
+#include "VulkanDevice.h"
+
+namespace VulkanGameEngine {
+
+/**
+ * GpuProfiler measures GPU execution time with Vulkan timestamp queries.
+ *
+ * Timestamps are written around each render pass and each labeled draw group
+ * while a frame's command buffer is recorded. There is one query pool per frame
+ * in flight, so results are read back only after that frame's fence has
+ * signalled - the read never waits on the GPU.
+ *
+ * When the device supports it, a pipeline statistics query around the main pass
+ * also reports vertex/fragment shader invocations and clipping counts.
+ *
+ * Per frame usage (frameSlot = current frame in flight):
+ *   waitForFrame(frameSlot);                  // fence signalled
+ *   gpuProfiler.collectResults(frameSlot);    // read the previous use of this slot
+ *   gpuProfiler.beginFrame(cmd, frameSlot);   // reset queries (outside any render pass)
+ *   uint32_t zone = gpuProfiler.beginZone(cmd, "MainPass");
+ *   ...
+ *   gpuProfiler.endZone(cmd, zone);
+ *   gpuProfiler.endFrame(frameSlot);          // just before submit
+ *
+ * Completed GPU zones are also forwarded to the CPU Profiler so they appear on a
+ * "GPU" track in exported traces. They are anchored at the frame's submit time,
+ * since GPU timestamps have no common clock with the CPU.
+ */
+class GpuProfiler {
+public:
+    /**
+     * Maximum number of zones (begin/end pairs) per frame
+     */
+    static constexpr uint32_t MAX_ZONES_PER_FRAME = 32;
+
+    /**
+     * Timing of one GPU zone in a completed frame
+     */
+    struct ZoneResult {
+        const char* name;       // Label passed to beginZone (static storage)
+        double startMs;         // Offset from the first timestamp of the frame
+        double durationMs;
+        uint32_t depth;         // Nesting depth (0 = pass level)
+    };
+
+    /**
+     * Pipeline statistics gathered around the main pass
+     */
+    struct PipelineStatistics {
+        uint64_t inputAssemblyVertices = 0;
+        uint64_t inputAssemblyPrimitives = 0;
+        uint64_t vertexShaderInvocations = 0;
+        uint64_t clippingInvocations = 0;
+        uint64_t clippingPrimitives = 0;
+        uint64_t fragmentShaderInvocations = 0;
+    };
+
+    /**
+     * Results of the most recently completed frame
+     */
+    struct FrameResults {
+        bool valid = false;
+        uint64_t frame = 0;                     // Profiler frame index the results belong to
+        double gpuTimeMs = 0.0;                 // First to last timestamp of the frame
+        std::vector<ZoneResult> zones;
+        bool hasStatistics = false;
+        PipelineStatistics statistics;
+    };
+
+    GpuProfiler();
+    ~GpuProfiler();
+
+    // Non-copyable
+    GpuProfiler(const GpuProfiler&) = delete;
+    GpuProfiler& operator=(const GpuProfiler&) = delete;
+
+    /**
+     * Creates the query pools.
+     *
+     * If the graphics queue has no timestamp support the profiler stays
+     * disabled and every other call becomes a no-op.
+     *
+     * @param device Device to create the query pools on
+     * @param framesInFlight Number of query pools to create
+     * @param enablePipelineStatistics Also collect pipeline statistics if the device supports them
+     */
+    void create(const VulkanDevice& device, uint32_t framesInFlight, bool enablePipelineStatistics = true);
+
+    /**
+     * Destroys the query pools
+     */
+    void cleanup();
+
+    /**
+     * Checks if GPU timestamps are available on this device
+     */
+    bool isSupported() const { return m_supported; }
+
+    /**
+     * Checks if pipeline statistics are being collected
+     */
+    bool hasPipelineStatistics() const { return m_statisticsEnabled; }
+
+    /**
+     * Reads back the queries of a frame slot. Call after the slot's fence has
+     * signalled; if results are somehow not ready they are skipped, never waited for.
+     *
+     * @param frameSlot Index of the frame in flight
+     */
+    void collectResults(uint32_t frameSlot);
+
+    /**
+     * Resets the slot's queries and starts a new frame. Must be recorded outside a render pass.
+     *
+     * @param commandBuffer Command buffer of this frame
+     * @param frameSlot Index of the frame in flight
+     */
+    void beginFrame(VkCommandBuffer commandBuffer, uint32_t frameSlot);
+
+    /**
+     * Marks the frame as submitted; zone results will be anchored at this CPU time
+     */
+    void endFrame(uint32_t frameSlot);
+
+    /**
+     * Writes a start timestamp for a labeled zone
+     *
+     * @param commandBuffer Command buffer being recorded
+     * @param name Label of the pass or draw group (must have static storage)
+     * @return Zone handle for endZone, or UINT32_MAX if no more zones fit this frame
+     */
+    uint32_t beginZone(VkCommandBuffer commandBuffer, const char* name);
+
+    /**
+     * Writes the end timestamp for a zone returned by beginZone
+     */
+    void endZone(VkCommandBuffer commandBuffer, uint32_t zone);
+
+    /**
+     * Starts the pipeline statistics query (inside or outside a render pass, but ended in the same scope)
+     */
+    void beginStatistics(VkCommandBuffer commandBuffer);
+
+    /**
+     * Ends the pipeline statistics query
+     */
+    void endStatistics(VkCommandBuffer commandBuffer);
+
+    /**
+     * Gets the results of the most recently completed frame
+     */
+    const FrameResults& getLastResults() const { return m_lastResults; }
+
+private:
+    /**
+     * Query state of one frame in flight
+     */
+    struct FrameQueries {
+        VkQueryPool timestampPool = VK_NULL_HANDLE;
+        VkQueryPool statisticsPool = VK_NULL_HANDLE;
+        const char* zoneNames[MAX_ZONES_PER_FRAME];
+        uint32_t zoneDepths[MAX_ZONES_PER_FRAME];
+        uint32_t zoneCount = 0;
+        uint32_t openDepth = 0;
+        bool statisticsWritten = false;
+        bool pending = false;                   // Recorded and submitted but not yet read back
+        uint64_t frame = 0;
+        int64_t submitTimeNs = 0;
+    };
+
+    VkDevice m_device;
+    bool m_supported;
+    bool m_statisticsEnabled;
+    double m_timestampPeriodNs;                 // Nanoseconds per timestamp tick
+    uint64_t m_timestampMask;                   // Valid bits of a timestamp
+    uint32_t m_currentSlot;
+
+    std::vector<FrameQueries> m_frames;
+    std::vector<uint64_t> m_timestampScratch;   // Readback buffer, sized once at creation
+    FrameResults m_lastResults;
+};
+
+/**
+ * RAII helper that wraps a block of recorded commands in a GPU zone
+ */
+class GpuZone {
+public:
+    GpuZone(GpuProfiler& profiler, VkCommandBuffer commandBuffer, const char* name)
+        : m_profiler(profiler), m_commandBuffer(commandBuffer), m_zone(profiler.beginZone(commandBuffer, name)) {}
+
+    ~GpuZone() { m_profiler.endZone(m_commandBuffer, m_zone); }
+
+    GpuZone(const GpuZone&) = delete;
+    GpuZone& operator=(const GpuZone&) = delete;
+
+private:
+    GpuProfiler& m_profiler;
+    VkCommandBuffer m_commandBuffer;
+    uint32_t m_zone;
+};
+
+} // namespace VulkanGameEngine
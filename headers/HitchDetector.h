@@ -0,0 +1,148 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace VulkanGameEngine {
+
+class MetricCounter;
+
+/**
+ * HitchDetector watches frame times and automatically captures evidence when
+ * a frame blows its budget.
+ *
+ * It keeps a ring of the last N frames (duration plus the per-frame change of
+ * any watched MetricsRegistry counters, e.g. allocations or Vulkan calls).
+ * Zone timings are not copied: the Profiler's per-thread rings already hold
+ * them, tagged with frame indices.
+ *
+ * A frame is a hitch when it takes longer than budgetMultiplier x the median
+ * of recent frames (and at least minBudgetMs). A few frames later, so the
+ * aftermath is included too, the surrounding frames are written to
+ *   <dumpDirectory>/hitch_<frame>.json        - frame times, counters, longest zones
+ *   <dumpDirectory>/hitch_<frame>_trace.json  - Chrome trace of the same frames
+ * and a single line is logged pointing at the dump.
+ *
+ * Usage (main loop, once per frame):
+ *   HitchDetector::getInstance().endFrame(frameIndex, durationNs);
+ */
+class HitchDetector {
+public:
+    /**
+     * Detection and dump settings
+     */
+    struct Config {
+        uint32_t historyFrames = 240;       // Frames kept in the ring
+        double budgetMultiplier = 2.0;      // Hitch threshold relative to the median frame time
+        double minBudgetMs = 4.0;           // Never flag frames faster than this
+        uint32_t warmupFrames = 60;         // Frames to observe before detecting anything
+        uint32_t framesBefore = 30;         // Frames before the hitch included in the dump
+        uint32_t framesAfter = 10;          // Frames after the hitch included in the dump
+        double cooldownSeconds = 5.0;       // Minimum time between dumps
+        uint32_t maxDumps = 20;             // Dumps per session, to bound disk use
+        std::string dumpDirectory = ".";
+    };
+
+    /**
+     * Most counters that can be watched
+     */
+    static constexpr uint32_t MAX_WATCHED_COUNTERS = 8;
+
+    /**
+     * Gets the singleton hitch detector
+     */
+    static HitchDetector& getInstance();
+
+    /**
+     * Applies new settings and clears the frame history
+     */
+    void configure(const Config& config);
+
+    /**
+     * Enables or disables detection
+     */
+    void setEnabled(bool enabled) { m_enabled = enabled; }
+    bool isEnabled() const { return m_enabled; }
+
+    /**
+     * Records the per-frame change of a MetricsRegistry counter alongside every frame.
+     * Unknown names create the counter. Ignored once MAX_WATCHED_COUNTERS are watched.
+     *
+     * @param name Counter name, e.g. "gpu.upload_bytes"
+     */
+    void watchCounter(const std::string& name);
+
+    /**
+     * Records a completed frame and checks it against the budget.
+     * Also writes a pending dump once enough frames have followed the hitch.
+     *
+     * @param frameIndex Profiler frame index of the completed frame
+     * @param durationNs Full duration of the frame
+     */
+    void endFrame(uint64_t frameIndex, int64_t durationNs);
+
+    /**
+     * Gets the number of hitches detected so far
+     */
+    uint64_t getHitchCount() const { return m_hitchCount; }
+
+private:
+    HitchDetector();
+    ~HitchDetector() = default;
+    HitchDetector(const HitchDetector&) = delete;
+    HitchDetector& operator=(const HitchDetector&) = delete;
+
+    /**
+     * One frame in the history ring
+     */
+    struct FrameRecord {
+        uint64_t frame = 0;
+        int64_t durationNs = 0;
+        uint64_t counterDeltas[MAX_WATCHED_COUNTERS] = {};
+    };
+
+    /**
+     * A counter sampled at every frame end
+     */
+    struct WatchedCounter {
+        std::string name;
+        MetricCounter* counter = nullptr;
+        uint64_t lastTotal = 0;
+    };
+
+    /**
+     * Hitch waiting for its trailing frames before being written
+     */
+    struct PendingDump {
+        bool active = false;
+        uint64_t hitchFrame = 0;
+        int64_t hitchDurationNs = 0;
+        int64_t budgetNs = 0;
+        int64_t medianNs = 0;
+        uint64_t lastFrame = 0;
+    };
+
+    void updateMedian();
+    void writeDump();
+    const FrameRecord* findFrame(uint64_t frame) const;
+
+    std::mutex m_mutex;                         // Guards configuration against concurrent endFrame
+    Config m_config;
+    bool m_enabled = true;
+
+    std::vector<FrameRecord> m_history;
+    uint64_t m_recordedFrames = 0;
+    std::vector<int64_t> m_medianScratch;       // Sized once; avoids allocating per frame
+    int64_t m_medianNs = 0;
+
+    std::vector<WatchedCounter> m_counters;
+
+    PendingDump m_pending;
+    int64_t m_lastDumpNs = 0;
+    uint32_t m_dumpCount = 0;
+    uint64_t m_hitchCount = 0;
+};
+
+} // namespace VulkanGameEngine
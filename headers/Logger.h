@@ -1,13 +1,156 @@
 #pragma once
 
+#include "BinaryLogSink.h"
 #include <iostream>
 #include <string>
 #include <sstream>
 #include <chrono>
 #include <iomanip>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <type_traits>
+
+/**
+ * Compile-time minimum log level (0 = TRACE ... 5 = FATAL, 6 = everything off).
+ * Logging macros below this level compile to nothing, so their arguments are
+ * never evaluated. Override it from the build, e.g. -DLOG_COMPILE_MIN_LEVEL=2
+ * to strip TRACE and DEBUG from release builds.
+ */
+#ifndef LOG_COMPILE_MIN_LEVEL
+#define LOG_COMPILE_MIN_LEVEL 0
+#endif
 
 namespace VulkanGameEngine {
 
+/**
+ * Minimal fmt-style formatting used by the logger's deferred formatting overloads.
+ * 
+ * Supports "{}" placeholders, "{{" / "}}" escapes and a precision spec for
+ * floating point values ("{:.2f}"). Arguments are only converted to text when
+ * the message actually passes the level filter.
+ */
+namespace LogFormat {
+
+    inline void appendArgument(std::string& out, const std::string& value, const char*) { out += value; }
+    inline void appendArgument(std::string& out, const char* value, const char*) { out += value ? value : "(null)"; }
+    inline void appendArgument(std::string& out, char* value, const char* spec) { appendArgument(out, static_cast<const char*>(value), spec); }
+    inline void appendArgument(std::string& out, char value, const char*) { out += value; }
+    inline void appendArgument(std::string& out, bool value, const char*) { out += value ? "true" : "false"; }
+
+    inline void appendArgument(std::string& out, double value, const char* spec) {
+        char buffer[64];
+        // "{:.Nf}" selects fixed precision, otherwise use the shortest general form
+        if (spec && spec[0] == '.') {
+            int precision = std::atoi(spec + 1);
+            std::snprintf(buffer, sizeof(buffer), "%.*f", precision, value);
+        } else {
+            std::snprintf(buffer, sizeof(buffer), "%g", value);
+        }
+        out += buffer;
+    }
+
+    inline void appendArgument(std::string& out, float value, const char* spec) {
+        appendArgument(out, static_cast<double>(value), spec);
+    }
+
+    template <typename T>
+    typename std::enable_if<std::is_integral<T>::value>::type
+    appendArgument(std::string& out, T value, const char*) {
+        char buffer[32];
+        if (std::is_signed<T>::value) {
+            std::snprintf(buffer, sizeof(buffer), "%lld", static_cast<long long>(value));
+        } else {
+            std::snprintf(buffer, sizeof(buffer), "%llu", static_cast<unsigned long long>(value));
+        }
+        out += buffer;
+    }
+
+    template <typename T>
+    typename std::enable_if<std::is_enum<T>::value>::type
+    appendArgument(std::string& out, T value, const char* spec) {
+        appendArgument(out, static_cast<typename std::underlying_type<T>::type>(value), spec);
+    }
+
+    template <typename T>
+    void appendArgument(std::string& out, const T* value, const char*) {
+        char buffer[32];
+        std::snprintf(buffer, sizeof(buffer), "%p", static_cast<const void*>(value));
+        out += buffer;
+    }
+
+    /**
+     * Copies literal text up to the next placeholder and returns a pointer to
+     * the placeholder (or to the terminating null). The placeholder's format
+     * spec, if any, is copied into spec.
+     */
+    inline const char* copyUntilPlaceholder(std::string& out, const char* format, char (&spec)[16]) {
+        spec[0] = '\0';
+        while (*format) {
+            if (format[0] == '{' && format[1] == '{') {
+                out += '{';
+                format += 2;
+            } else if (format[0] == '}' && format[1] == '}') {
+                out += '}';
+                format += 2;
+            } else if (format[0] == '{') {
+                const char* close = std::strchr(format, '}');
+                if (!close) {
+                    break;
+                }
+                // Spec follows the ':' inside the braces, e.g. {:.3f}
+                if (format[1] == ':') {
+                    size_t length = std::min<size_t>(static_cast<size_t>(close - format - 2), sizeof(spec) - 1);
+                    std::memcpy(spec, format + 2, length);
+                    spec[length] = '\0';
+                }
+                return close + 1;
+            } else {
+                out += *format++;
+            }
+        }
+        out += format;
+        return nullptr;
+    }
+
+    inline void formatInto(std::string& out, const char* format) {
+        char spec[16];
+        while (format) {
+            // Placeholders without arguments are left empty
+            format = copyUntilPlaceholder(out, format, spec);
+        }
+    }
+
+    template <typename First, typename... Rest>
+    void formatInto(std::string& out, const char* format, const First& first, const Rest&... rest) {
+        char spec[16];
+        format = copyUntilPlaceholder(out, format, spec);
+        if (!format) {
+            return; // More arguments than placeholders
+        }
+        appendArgument(out, first, spec);
+        formatInto(out, format, rest...);
+    }
+
+    template <typename... Args>
+    std::string format(const char* format, const Args&... args) {
+        std::string out;
+        out.reserve(std::strlen(format) + 16 * sizeof...(Args));
+        formatInto(out, format, args...);
+        return out;
+    }
+
+} // namespace LogFormat
+
 /**
  * Logger provides a comprehensive logging system with colored output and different log levels.
  * 
@@ -18,6 +161,16 @@ namespace VulkanGameEngine {
  * - Thread-safe logging
  * - Configurable log level filtering
  * - Easy-to-use macros for different log levels
+ * - Optional asynchronous mode with a background sink thread
+ *
+ * In asynchronous mode each producer thread writes fixed-size records into its
+ * own single-producer/single-consumer ring buffer. No lock is taken on the
+ * logging path; a background thread drains all rings, formats the records in
+ * batches and writes them to the console and/or a log file.
+ *
+ * The binary backend bypasses text formatting entirely: messages are stored
+ * as a format-string ID plus raw argument bytes in a memory-mapped file (see
+ * BinaryLogSink) and turned back into text offline with the logdecode tool.
  */
 class Logger {
 public:
@@ -33,6 +186,33 @@ public:
         FATAL = 5   // Fatal error messages
     };
 
+    /**
+     * What a producer does when its ring buffer is full in asynchronous mode
+     */
+    enum class OverflowPolicy {
+        DROP,   // Discard the message and count it (never stalls the caller)
+        BLOCK   // Wait until the sink thread has made room
+    };
+
+    /**
+     * Where log messages are written
+     */
+    enum class Backend {
+        TEXT,   // Formatted text on the console (synchronous or asynchronous)
+        BINARY  // Binary records in a memory-mapped file, decoded offline
+    };
+
+    /**
+     * Configuration for asynchronous logging
+     */
+    struct AsyncConfig {
+        bool consoleOutput = true;                      // Write records to stdout/stderr
+        std::string filePath;                           // Also append to this file (empty = no file)
+        OverflowPolicy overflowPolicy = OverflowPolicy::DROP;
+        size_t ringCapacity = 1024;                     // Records per producer thread (rounded up to a power of two)
+        std::chrono::milliseconds flushInterval{10};    // How often the sink thread wakes up on its own
+    };
+
     /**
      * ANSI color codes for console output
      */
@@ -59,7 +239,13 @@ public:
     /**
      * Gets the current log level
      */
-    Level getLogLevel() const { return m_logLevel; }
+    Level getLogLevel() const { return m_logLevel.load(std::memory_order_relaxed); }
+
+    /**
+     * Checks if a message at the given level would be written.
+     * The logging macros call this before evaluating any of their arguments.
+     */
+    bool isLevelEnabled(Level level) const { return level >= m_logLevel.load(std::memory_order_relaxed); }
 
     /**
      * Enables or disables colored output
@@ -81,6 +267,62 @@ public:
      */
     bool isTimestampEnabled() const { return m_timestampEnabled; }
 
+    /**
+     * Switches the logger to asynchronous mode and starts the sink thread.
+     * Calling this while already asynchronous restarts the sink with the new configuration.
+     * 
+     * @param config Sink and overflow configuration
+     * @return true if the sink was started (false if the log file could not be opened)
+     */
+    bool enableAsync(const AsyncConfig& config);
+
+    /**
+     * Switches the logger to asynchronous mode with the default configuration
+     */
+    bool enableAsync();
+
+    /**
+     * Drains all pending records, stops the sink thread and returns to synchronous output
+     */
+    void disableAsync();
+
+    /**
+     * Checks if asynchronous mode is active
+     */
+    bool isAsyncEnabled() const { return m_asyncEnabled.load(std::memory_order_acquire); }
+
+    /**
+     * Blocks until every record queued before this call has been written
+     */
+    void flush();
+
+    /**
+     * Gets the number of messages discarded by the DROP overflow policy
+     */
+    uint64_t getDroppedMessageCount() const { return m_droppedMessages.load(std::memory_order_relaxed); }
+
+    /**
+     * Switches to the binary backend. Messages at or above consoleEchoLevel are
+     * also written through the text backend so problems stay visible.
+     * 
+     * @param config Binary file naming, size and rotation settings
+     * @param consoleEchoLevel Minimum level that is still printed as text
+     * @return true if the binary log file was created
+     */
+    bool enableBinaryBackend(const BinaryLogSink::Config& config, Level consoleEchoLevel = Level::WARN);
+
+    /**
+     * Closes the binary log file and returns to the text backend
+     */
+    void disableBinaryBackend();
+
+    /**
+     * Gets the active backend
+     */
+    Backend getBackend() const {
+        return m_binaryEnabled.load(std::memory_order_acquire) ? Backend::BINARY : Backend::TEXT;
+    }
+
     /**
      * Logs a message at the specified level
      */
@@ -116,21 +358,142 @@ public:
      */
     void fatal(const std::string& message, const std::string& category = "");
 
+    /**
+     * Formats a message with "{}" placeholders and logs it at the specified level.
+     * Formatting only happens if the level passes the filter.
+     * 
+     * @param level Log level of the message
+     * @param format Format string with "{}" placeholders
+     * @param category Category shown next to the level
+     * @param args Values substituted into the placeholders in order
+     */
+    template <typename... Args>
+    void logFormatted(Level level, const char* format, const std::string& category, const Args&... args) {
+        if (!isLevelEnabled(level)) {
+            return;
+        }
+        
+        if (m_binaryEnabled.load(std::memory_order_acquire)) {
+            // Store the raw arguments; formatting happens in the decoder
+            m_binarySink.write(static_cast<uint8_t>(level), format, category, args...);
+            if (level < m_consoleEchoLevel.load(std::memory_order_relaxed)) {
+                return;
+            }
+        }
+        
+        writeText(level, LogFormat::format(format, args...), category);
+    }
+
+    /**
+     * Deferred formatting overloads used by the LOG_* macros when extra
+     * arguments follow the category, e.g.
+     * LOG_DEBUG("Position: ({}, {}, {})", "Camera", pos.x, pos.y, pos.z);
+     */
+    template <typename Arg, typename... Args>
+    void trace(const char* format, const std::string& category, const Arg& arg, const Args&... args) {
+        logFormatted(Level::TRACE, format, category, arg, args...);
+    }
+
+    template <typename Arg, typename... Args>
+    void debug(const char* format, const std::string& category, const Arg& arg, const Args&... args) {
+        logFormatted(Level::DEBUG, format, category, arg, args...);
+    }
+
+    template <typename Arg, typename... Args>
+    void info(const char* format, const std::string& category, const Arg& arg, const Args&... args) {
+        logFormatted(Level::INFO, format, category, arg, args...);
+    }
+
+    template <typename Arg, typename... Args>
+    void warn(const char* format, const std::string& category, const Arg& arg, const Args&... args) {
+        logFormatted(Level::WARN, format, category, arg, args...);
+    }
+
+    template <typename Arg, typename... Args>
+    void error(const char* format, const std::string& category, const Arg& arg, const Args&... args) {
+        logFormatted(Level::ERROR, format, category, arg, args...);
+    }
+
+    template <typename Arg, typename... Args>
+    void fatal(const char* format, const std::string& category, const Arg& arg, const Args&... args) {
+        logFormatted(Level::FATAL, format, category, arg, args...);
+    }
+
 private:
     Logger();
-    ~Logger() = default;
+    ~Logger();
     Logger(const Logger&) = delete;
     Logger& operator=(const Logger&) = delete;
 
-    Level m_logLevel;
+    /**
+     * Fixed-size record stored in the per-thread ring buffers.
+     * Messages longer than MESSAGE_CAPACITY are split across consecutive
+     * records that carry the CONTINUED flag, so nothing is truncated.
+     */
+    struct LogRecord {
+        static constexpr size_t MESSAGE_CAPACITY = 200;
+        static constexpr size_t CATEGORY_CAPACITY = 31;
+        static constexpr uint8_t FLAG_CONTINUED = 0x1;    // More text follows in the next record
+
+        int64_t timestampNs;                              // system_clock time since epoch
+        Level level;
+        uint8_t flags;
+        uint8_t categoryLength;
+        uint16_t messageLength;
+        char category[CATEGORY_CAPACITY + 1];
+        char message[MESSAGE_CAPACITY];
+    };
+
+    /**
+     * Single-producer/single-consumer ring owned by one logging thread.
+     * The producer only writes m_head, the sink thread only writes m_tail.
+     */
+    struct RecordRing {
+        explicit RecordRing(size_t capacity);
+
+        std::vector<LogRecord> records;
+        size_t mask;
+        alignas(64) std::atomic<uint64_t> head{0};
+        alignas(64) std::atomic<uint64_t> tail{0};
+        std::atomic<bool> orphaned{false};                // Owning thread has exited
+    };
+
+    std::atomic<Level> m_logLevel;
     bool m_colorEnabled;
     bool m_timestampEnabled;
 
+    // Binary backend state
+    BinaryLogSink m_binarySink;
+    std::atomic<bool> m_binaryEnabled{false};
+    std::atomic<Level> m_consoleEchoLevel{Level::WARN};
+
+    // Asynchronous mode state
+    AsyncConfig m_asyncConfig;
+    std::atomic<bool> m_asyncEnabled{false};
+    std::atomic<bool> m_sinkRunning{false};
+    std::atomic<uint64_t> m_droppedMessages{0};
+    std::thread m_sinkThread;
+    std::ofstream m_logFile;
+
+    std::mutex m_ringsMutex;                              // Guards m_rings (taken once per thread, never per message)
+    std::vector<std::shared_ptr<RecordRing>> m_rings;
+
+    std::mutex m_sinkMutex;
+    std::condition_variable m_sinkWakeup;
+    std::condition_variable m_flushDone;
+    uint64_t m_flushRequested = 0;
+    uint64_t m_flushCompleted = 0;
+
     /**
      * Gets the color code for a log level
      */
     std::string getLevelColor(Level level) const;
 
+    /**
+     * Gets the raw color escape sequence for a log level (empty when colors are off)
+     */
+    const char* getLevelColorCode(Level level) const;
+
     /**
      * Gets the string representation of a log level
      */
@@ -146,6 +509,40 @@ private:
      */
     void output(Level level, const std::string& message, const std::string& category) const;
 
+    /**
+     * Appends one fully formatted log line (including the newline) to a buffer
+     */
+    void formatLine(std::string& out, Level level, bool useColor, const char* timestamp,
+                    const char* category, size_t categoryLength,
+                    const char* message, size_t messageLength) const;
+
+    /**
+     * Sends a formatted message to the text backend (async ring or direct output)
+     */
+    void writeText(Level level, const std::string& message, const std::string& category);
+
+    /**
+     * Copies a message into the calling thread's ring buffer
+     */
+    void enqueue(Level level, const std::string& message, const std::string& category);
+
+    /**
+     * Returns the calling thread's ring, registering a new one on first use
+     */
+    RecordRing& getThreadRing();
+
+    /**
+     * Background thread body: waits for work and drains the rings
+     */
+    void sinkThreadMain();
+
+    /**
+     * Moves every available record out of the rings and writes them in one batch
+     * 
+     * @return Number of records written
+     */
+    size_t drainRings(std::vector<LogRecord>& batch, std::string& stdoutBuffer, std::string& stderrBuffer);
+
     /**
      * Enables ANSI color codes on Windows console
      */
@@ -157,12 +554,26 @@ private:
 } // namespace VulkanGameEngine
 
 // Convenient logging macros
-#define LOG_TRACE(message, ...) VulkanGameEngine::Logger::getInstance().trace(message, ##__VA_ARGS__)
-#define LOG_DEBUG(message, ...) VulkanGameEngine::Logger::getInstance().debug(message, ##__VA_ARGS__)
-#define LOG_INFO(message, ...)  VulkanGameEngine::Logger::getInstance().info(message, ##__VA_ARGS__)
-#define LOG_WARN(message, ...)  VulkanGameEngine::Logger::getInstance().warn(message, ##__VA_ARGS__)
-#define LOG_ERROR(message, ...) VulkanGameEngine::Logger::getInstance().error(message, ##__VA_ARGS__)
-#define LOG_FATAL(message, ...) VulkanGameEngine::Logger::getInstance().fatal(message, ##__VA_ARGS__)
+//
+// Each macro checks the compile-time and runtime levels before any argument is
+// evaluated, so string concatenation or formatting in a filtered-out call costs
+// nothing. Extra arguments after the category are substituted into "{}"
+// placeholders in the message:
+//     LOG_DEBUG("Loaded {} vertices in {:.2f}ms", "Mesh", count, ms);
+#define LOG_AT_LEVEL(level, levelValue, method, message, ...) \
+    do { \
+        if ((levelValue) >= LOG_COMPILE_MIN_LEVEL && \
+            VulkanGameEngine::Logger::getInstance().isLevelEnabled(VulkanGameEngine::Logger::Level::level)) { \
+            VulkanGameEngine::Logger::getInstance().method(message, ##__VA_ARGS__); \
+        } \
+    } while (0)
+
+#define LOG_TRACE(message, ...) LOG_AT_LEVEL(TRACE, 0, trace, message, ##__VA_ARGS__)
+#define LOG_DEBUG(message, ...) LOG_AT_LEVEL(DEBUG, 1, debug, message, ##__VA_ARGS__)
+#define LOG_INFO(message, ...)  LOG_AT_LEVEL(INFO,  2, info,  message, ##__VA_ARGS__)
+#define LOG_WARN(message, ...)  LOG_AT_LEVEL(WARN,  3, warn,  message, ##__VA_ARGS__)
+#define LOG_ERROR(message, ...) LOG_AT_LEVEL(ERROR, 4, error, message, ##__VA_ARGS__)
+#define LOG_FATAL(message, ...) LOG_AT_LEVEL(FATAL, 5, fatal, message, ##__VA_ARGS__)
 
 // Shorter aliases (avoid ERROR macro conflict with Windows)
 #define LOG(message, ...)   LOG_INFO(message, ##__VA_ARGS__)
@@ -186,5 +597,5 @@ private:
 #define LOG_PERF_END(operation) do { \
     auto _perf_end = std::chrono::high_resolution_clock::now(); \
     auto _perf_duration = std::chrono::duration<float, std::milli>(_perf_end - _perf_start_##operation); \
-    LOG_DEBUG(#operation " took " + std::to_string(_perf_duration.count()) + "ms", "Performance"); \
-} while(0)
\ No newline at end of file
+    LOG_DEBUG(#operation " took {:.3f}ms", "Performance", _perf_duration.count()); \
+} while(0)
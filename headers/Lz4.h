@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace VulkanGameEngine {
+
+/**
+ * Lz4 compresses and decompresses single blocks in the LZ4 block format
+ * (sequences of a token, literals, a 16-bit match offset and extra length
+ * bytes), so data written here can also be read by the reference library.
+ *
+ * The compressor is a simple greedy one with a 4K-entry hash table: fast,
+ * allocation-free and good enough for offline packing. The decompressor
+ * checks every read and write against the buffer bounds, so corrupt input
+ * fails instead of overrunning memory.
+ */
+namespace Lz4 {
+
+    /**
+     * Largest compressed size of sourceSize bytes (incompressible input)
+     */
+    size_t compressBound(size_t sourceSize);
+
+    /**
+     * Compresses one block.
+     *
+     * @param source Input bytes
+     * @param sourceSize Number of input bytes
+     * @param destination Output buffer
+     * @param capacity Output capacity (compressBound(sourceSize) always suffices)
+     * @return Compressed size, or 0 if the output did not fit
+     */
+    size_t compress(const uint8_t* source, size_t sourceSize, uint8_t* destination, size_t capacity);
+
+    /**
+     * Decompresses one block whose decompressed size is known.
+     *
+     * @param source Compressed bytes
+     * @param sourceSize Number of compressed bytes
+     * @param destination Output buffer of exactly destinationSize bytes
+     * @param destinationSize Decompressed size
+     * @return true if the block was valid and filled the output exactly
+     */
+    bool decompress(const uint8_t* source, size_t sourceSize, uint8_t* destination, size_t destinationSize);
+
+} // namespace Lz4
+} // namespace VulkanGameEngine
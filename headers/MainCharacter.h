@@ -1,10 +1,10 @@
 #pragma once
 
 #include "Common.h"
-#include "VulkanBuffer.h"
+#include "RenderBackend.h"
+#include "ObjLoader.h"
 #include <string>
 #include <vector>
-#include <unordered_map>
 
 namespace VulkanGameEngine {
 
@@ -13,11 +13,11 @@ namespace VulkanGameEngine {
  * 
  * This class provides functionality to:
  * - Load OBJ files with vertex positions, normals, and texture coordinates
- * - Create Vulkan buffers for the loaded geometry
+ * - Create GPU buffers for the loaded geometry through the render backend
  * - Manage transformation matrices for positioning and animation
  * - Integrate with the existing Vulkan rendering pipeline
  * 
- * The class uses a simple OBJ parser that supports:
+ * The class uses the simple OBJ parser in ObjLoader, which supports:
  * - Vertex positions (v)
  * - Vertex normals (vn) 
  * - Texture coordinates (vt)
@@ -40,20 +40,61 @@ public:
      * 
      * This function parses an OBJ file and extracts vertex data including
      * positions, normals, and texture coordinates. The data is then used
-     * to create Vulkan buffers for rendering.
+     * to create vertex and index buffers on the render backend.
      * 
      * @param filePath Path to the OBJ file to load
-     * @param device Vulkan logical device for buffer creation
-     * @param physicalDevice Vulkan physical device for memory allocation
-     * @param commandPool Command pool for buffer operations
-     * @param graphicsQueue Graphics queue for command submission
+     * @param backend Backend that owns the buffers (must outlive the character)
      * @return true if loading succeeded, false otherwise
      */
-    bool loadFromOBJ(const std::string& filePath,
-                     VkDevice device, 
-                     VkPhysicalDevice physicalDevice,
-                     VkCommandPool commandPool, 
-                     VkQueue graphicsQueue);
+    bool loadFromOBJ(const std::string& filePath, RenderBackend& backend);
+
+    /**
+     * First half of loadFromOBJ: parses and validates the OBJ file into
+     * CPU-side geometry. Touches no backend, so it can run on a worker thread
+     * while the device is still being created.
+     * 
+     * The cooked mesh for the path (MeshAsset::getCookedPath) is loaded
+     * instead when there is one; outside shipping builds only if it was
+     * cooked from the current source. Shipping builds (ENGINE_SHIPPING)
+     * never parse OBJ text and fail without a cooked mesh.
+     * 
+     * @param filePath Path to the OBJ file to load
+     * @return true if the geometry is ready to upload
+     */
+    bool loadGeometry(const std::string& filePath);
+
+    /**
+     * Loads geometry the way loadGeometry does, into the given vectors
+     * instead of the character. Touches no character or backend state, so
+     * reloads can run on a worker while the character keeps rendering.
+     * 
+     * @param filePath Path to the OBJ file to load
+     * @param vertices Output vertices
+     * @param indices Output indices
+     * @return true if the geometry is valid
+     */
+    static bool readGeometry(const std::string& filePath, std::vector<Vertex>& vertices,
+                             std::vector<uint32_t>& indices);
+
+    /**
+     * Second half of loadFromOBJ: creates the GPU buffers for geometry parsed
+     * by loadGeometry.
+     * 
+     * @param backend Backend that owns the buffers (must outlive the character)
+     * @return true if the character is ready to render
+     */
+    bool upload(RenderBackend& backend);
+
+    /**
+     * Swaps in new geometry (from readGeometry) while frames may be in
+     * flight: new buffers are created, then the old ones are destroyed,
+     * which the backend defers until the frames drawing them have finished.
+     * Also loads a character that is not loaded yet.
+     * 
+     * @param backend Backend that owns the buffers (must outlive the character)
+     * @return false if the new buffers could not be created (the old mesh stays)
+     */
+    bool replaceGeometry(RenderBackend& backend, std::vector<Vertex>&& vertices, std::vector<uint32_t>&& indices);
 
     /**
      * Updates the character's transformation matrix.
@@ -76,16 +117,16 @@ public:
     /**
      * Gets the vertex buffer for rendering.
      * 
-     * @return Reference to the vertex buffer
+     * @return Backend handle of the vertex buffer
      */
-    const VulkanBuffer& getVertexBuffer() const { return m_vertexBuffer; }
+    BufferHandle getVertexBuffer() const { return m_vertexBuffer; }
 
     /**
      * Gets the index buffer for rendering.
      * 
-     * @return Reference to the index buffer
+     * @return Backend handle of the index buffer
      */
-    const VulkanBuffer& getIndexBuffer() const { return m_indexBuffer; }
+    BufferHandle getIndexBuffer() const { return m_indexBuffer; }
 
     /**
      * Gets the number of indices for drawing.
@@ -111,7 +152,7 @@ public:
     /**
      * Cleans up all resources.
      * 
-     * This function releases all Vulkan buffers and resets the character
+     * This function releases the backend buffers and resets the character
      * to an unloaded state.
      */
     void cleanup();
@@ -125,30 +166,26 @@ public:
     void getModelStats(uint32_t& vertexCount, uint32_t& triangleCount) const;
 
     /**
-     * Color generation modes for visual variety
+     * Sets how the vertex shader colors the character. Takes effect on the
+     * next frame; the vertex data does not change.
+     * @param mode The color mode to use
      */
-    enum class ColorMode {
-        RAINBOW,        // Current golden ratio HSV method
-        GRADIENT,       // Smooth gradients based on position
-        ANATOMICAL,     // Different colors per body part
-        METALLIC,       // Metallic/shiny appearance
-        PASTEL          // Soft pastel colors
-    };
+    void setColorMode(ColorMode mode) { m_colorMode = mode; }
 
     /**
-     * Sets the color generation mode for vertices
-     * @param mode The color mode to use
+     * Gets the color mode to push with the character's draws
      */
-    void setColorMode(ColorMode mode) { m_colorMode = mode; }
+    ColorMode getColorMode() const { return m_colorMode; }
 
 private:
     // Model data
-    std::vector<Vertex> m_vertices;     ///< Vertex data (positions, colors, tex coords)
+    std::vector<Vertex> m_vertices;     ///< Vertex data (positions, tex coords)
     std::vector<uint32_t> m_indices;    ///< Index data for triangles
     
-    // Vulkan resources
-    VulkanBuffer m_vertexBuffer;        ///< Vertex buffer for GPU
-    VulkanBuffer m_indexBuffer;         ///< Index buffer for GPU
+    // GPU resources
+    RenderBackend* m_backend;           ///< Backend owning the buffers (not owned)
+    BufferHandle m_vertexBuffer;        ///< Vertex buffer for GPU
+    BufferHandle m_indexBuffer;         ///< Index buffer for GPU
     
     // Model state
     bool m_isLoaded;                    ///< Whether model is loaded
@@ -160,67 +197,27 @@ private:
     glm::vec3 m_position;               ///< World position
     glm::vec3 m_rotation;               ///< Rotation angles (pitch, yaw, roll)
     float m_scale;                      ///< Uniform scale factor
-    ColorMode m_colorMode;              ///< Current color generation mode
+    ColorMode m_colorMode;              ///< Current vertex color mode
 
     /**
-     * OBJ file parsing structure to hold temporary data during loading.
-     */
-    struct OBJData {
-        std::vector<glm::vec3> positions;    ///< Vertex positions from OBJ
-        std::vector<glm::vec3> normals;      ///< Vertex normals from OBJ  
-        std::vector<glm::vec2> texCoords;    ///< Texture coordinates from OBJ
-        std::vector<uint32_t> indices;       ///< Face indices from OBJ
-        
-        void clear() {
-            positions.clear();
-            normals.clear();
-            texCoords.clear();
-            indices.clear();
-        }
-    };
-
-    /**
-     * Parses an OBJ file and extracts vertex data.
+     * Creates GPU buffers from vertex data.
      * 
-     * This function reads an OBJ file line by line and extracts:
-     * - Vertex positions (v x y z)
-     * - Vertex normals (vn x y z)
-     * - Texture coordinates (vt u v)
-     * - Face definitions (f v1/vt1/vn1 v2/vt2/vn2 v3/vt3/vn3)
-     * 
-     * @param filePath Path to the OBJ file
-     * @param objData Output structure to store parsed data
-     * @return true if parsing succeeded, false otherwise
-     */
-    bool parseOBJFile(const std::string& filePath, OBJData& objData);
-
-    /**
-     * Converts OBJ data to Vulkan vertex format.
-     * 
-     * This function takes the raw OBJ data and converts it to the Vertex
-     * structure format expected by the Vulkan pipeline. It handles index
-     * mapping and creates a unified vertex buffer.
+     * This function creates the vertex and index buffers on the backend
+     * and uploads the mesh data for rendering.
      * 
-     * @param objData Raw OBJ data from file parsing
+     * @param backend Backend to create the buffers on
+     * @return true if buffer creation succeeded, false otherwise
      */
-    void convertOBJToVertices(const OBJData& objData);
+    bool createBuffers(RenderBackend& backend);
 
     /**
-     * Creates Vulkan buffers from vertex data.
-     * 
-     * This function creates the vertex and index buffers on the GPU
-     * and uploads the mesh data for rendering.
+     * Loads the cooked mesh for a source path (LOD 0).
      * 
-     * @param device Vulkan logical device
-     * @param physicalDevice Vulkan physical device
-     * @param commandPool Command pool for buffer operations
-     * @param graphicsQueue Graphics queue for command submission
-     * @return true if buffer creation succeeded, false otherwise
+     * @param sourcePath Path of the OBJ source
+     * @return false if there is no usable cooked mesh
      */
-    bool createBuffers(VkDevice device, 
-                       VkPhysicalDevice physicalDevice,
-                       VkCommandPool commandPool, 
-                       VkQueue graphicsQueue);
+    static bool loadCooked(const std::string& sourcePath, std::vector<Vertex>& vertices,
+                           std::vector<uint32_t>& indices);
 
     /**
      * Updates the transformation matrix based on position, rotation, and scale.
@@ -228,37 +225,11 @@ private:
     void updateTransformMatrix();
 
     /**
-     * Enhanced color generation with multiple modes
-     */
-    glm::vec3 generateDefaultColor(uint32_t vertexIndex, const glm::vec3& position) const;
-
-    glm::vec3 generateRainbowColor(uint32_t vertexIndex) const;
-    glm::vec3 generateGradientColor(const glm::vec3& position) const;
-    glm::vec3 generateAnatomicalColor(const glm::vec3& position) const;
-    glm::vec3 generateMetallicColor(uint32_t vertexIndex) const;
-    glm::vec3 generatePastelColor(uint32_t vertexIndex) const;
-
-    /**
-     * Parses a face line from OBJ file.
-     * 
-     * Handles different face formats:
-     * - f v1 v2 v3 (positions only)
-     * - f v1/vt1 v2/vt2 v3/vt3 (positions and tex coords)
-     * - f v1//vn1 v2//vn2 v3//vn3 (positions and normals)
-     * - f v1/vt1/vn1 v2/vt2/vn2 v3/vt3/vn3 (all attributes)
-     * 
-     * @param line Face definition line from OBJ file
-     * @param objData Output structure to store face indices
-     * @return true if parsing succeeded, false otherwise
-     */
-    bool parseFaceLine(const std::string& line, OBJData& objData);
-
-    /**
-     * Validates that the loaded model data is consistent.
+     * Validates that loaded model data is consistent.
      * 
      * @return true if data is valid, false otherwise
      */
-    bool validateModelData() const;
+    static bool validateModelData(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices);
 };
 
 } // namespace VulkanGameEngine} // namespace VulkanGameEngine
\ No newline at end of file
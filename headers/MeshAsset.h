@@ -0,0 +1,125 @@
+#pragma once
+
+#include "Common.h"
+#include "MeshProcessing.h"
+#include "ObjLoader.h"
+#include <string>
+#include <vector>
+
+namespace VulkanGameEngine {
+
+/**
+ * MeshAsset is a runtime-ready mesh as written by the asset cooker
+ * (tools/assetcook.cpp): final vertices with normals and tangents, indices
+ * optimized for the vertex cache, a chain of levels of detail and meshlets.
+ * Loading one is a bounds-checked decode of the compressed vertex and index
+ * streams, with no text parsing or geometry processing on the player's
+ * machine.
+ *
+ * Cooked meshes live next to their source with the extension replaced
+ * (assets/FinalBaseMesh.obj -> assets/FinalBaseMesh.vgemesh, see
+ * getCookedPath), loose or in a mounted archive.
+ *
+ * File layout (*.vgemesh, little-endian):
+ *
+ *   char[8] magic "VGEMESH1", uint32 version, uint64 sourceHash
+ *   uint32 vertexCount, indexCount, lodCount, meshletCount,
+ *          meshletVertexCount, meshletTriangleByteCount,
+ *          vertexStreamSize, indexStreamSize
+ *   float[3] boundsMin, float[3] boundsMax
+ *   uint8[vertexStreamSize]             the vertices (48 bytes each, the GPU
+ *                                       layout), GeometryCodec-encoded
+ *   uint8[indexStreamSize]              every LOD's triangles, LOD 0 first,
+ *                                       GeometryCodec-encoded
+ *   Lod[lodCount]                       16 bytes each
+ *   Meshlet[meshletCount]               32 bytes each, built on LOD 0
+ *   uint32[meshletVertexCount]          meshlet vertex lists
+ *   uint8[meshletTriangleByteCount]     meshlet triangles, 3 bytes each
+ */
+struct MeshAsset {
+    static constexpr char MAGIC[8] = {'V', 'G', 'E', 'M', 'E', 'S', 'H', '1'};
+    static constexpr uint32_t VERSION = 2;   // 2: vertices and indices compressed with GeometryCodec
+    static constexpr const char* EXTENSION = ".vgemesh";
+
+    /**
+     * One level of detail: a range of the index list
+     */
+    struct Lod {
+        uint32_t firstIndex;
+        uint32_t indexCount;
+        float error;                        ///< Simplification grid cell relative to the mesh size (0 for LOD 0)
+        uint32_t reserved;
+    };
+
+    /**
+     * Cooking parameters
+     */
+    struct CookOptions {
+        uint32_t maxLods = 4;               ///< Including LOD 0
+        float lodReduction = 0.5f;          ///< Triangle count of each LOD relative to the previous one
+        uint32_t minLodTriangles = 64;      ///< No LOD is built below this many triangles
+        uint32_t maxMeshletVertices = MeshProcessing::MAX_MESHLET_VERTICES;
+        uint32_t maxMeshletTriangles = MeshProcessing::MAX_MESHLET_TRIANGLES;
+    };
+
+    uint64_t sourceHash = 0;                ///< AssetArchive::hashBytes of the source file
+    glm::vec3 boundsMin = glm::vec3(0.0f);
+    glm::vec3 boundsMax = glm::vec3(0.0f);
+    std::vector<Vertex> vertices;
+    std::vector<uint32_t> indices;
+    std::vector<Lod> lods;
+    MeshProcessing::MeshletData meshlets;
+
+    /**
+     * Runs the whole cooking pipeline on parsed OBJ data: vertex dedup,
+     * normals and tangents (ObjLoader::convertOBJToVertices), vertex cache
+     * and fetch ordering, LOD simplification and meshlet building.
+     *
+     * @param objData Parsed source
+     * @param sourceHash Hash of the source file, stored to detect stale cooked files
+     * @param options LOD and meshlet parameters
+     */
+    static MeshAsset cook(const ObjLoader::OBJData& objData, uint64_t sourceHash, const CookOptions& options);
+
+    /**
+     * Appends the file image of the asset to data
+     */
+    void serialize(std::vector<char>& data) const;
+
+    /**
+     * Reads a file image written by serialize(), checking every count and index
+     *
+     * @param error Set to the reason on failure
+     */
+    static bool deserialize(const std::vector<char>& data, MeshAsset& asset, std::string& error);
+
+    /**
+     * Writes the asset to a file
+     *
+     * @return false (after logging) if the file cannot be written
+     */
+    bool save(const std::string& path) const;
+
+    /**
+     * Reads a cooked mesh through AssetFileSystem (mounted archives, then loose files)
+     *
+     * @param error Set to the reason on failure
+     */
+    static bool load(const std::string& path, MeshAsset& asset, std::string& error);
+
+    /**
+     * Gets the indices of one LOD (LOD 0 is the full mesh)
+     */
+    const uint32_t* getLodIndices(size_t lod) const { return indices.data() + lods[lod].firstIndex; }
+
+    /**
+     * Gets the path of the cooked mesh for a source path (extension replaced by EXTENSION)
+     */
+    static std::string getCookedPath(const std::string& sourcePath);
+};
+
+static_assert(sizeof(Vertex) == 48, "MeshAsset stores Vertex as is");
+static_assert(sizeof(MeshAsset::Lod) == 16, "MeshAsset::Lod is part of the file format");
+static_assert(sizeof(MeshProcessing::Meshlet) == 32, "Meshlet is part of the MeshAsset file format");
+
+} // namespace VulkanGameEngine
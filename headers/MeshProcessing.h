@@ -0,0 +1,150 @@
+#pragma once
+
+#include "Common.h"
+#include <vector>
+
+namespace VulkanGameEngine {
+
+class ThreadPool;
+
+/**
+ * MeshProcessing derives per-vertex normals and tangents for indexed triangle
+ * meshes, for the meshes that do not bring their own (OBJ files without vn
+ * data, the generated scene shapes), and holds the offline passes the asset
+ * cooker runs on top (vertex cache and fetch ordering, LOD simplification,
+ * meshlet building; see MeshAsset).
+ *
+ * Both passes are data-parallel on a ThreadPool: triangles are processed in
+ * ranges, and their contributions are gathered per vertex through a
+ * vertex-to-corner table built with atomic counters, so no pass takes a
+ * lock. Every vertex sums its corners in a fixed order, which keeps the
+ * results identical from run to run regardless of the thread count.
+ *
+ * Usage:
+ *   MeshProcessing::generateNormals(vertices, indices);
+ *   MeshProcessing::generateTangents(vertices, indices);
+ */
+namespace MeshProcessing {
+
+    /**
+     * Normal generation parameters
+     */
+    struct NormalOptions {
+        float creaseAngleDegrees = 60.0f;   ///< Faces meeting at a sharper angle do not share normals
+        size_t grainSize = 4096;            ///< Triangles (or vertices) per parallel chunk
+    };
+
+    /**
+     * Computes smooth vertex normals. Each face contributes its normal weighted
+     * by its area and by the angle of the corner at the vertex; only faces
+     * within the crease angle of each other are smoothed together. Vertices
+     * whose faces fall into several smoothing groups are split, which appends
+     * vertices and rewrites the affected indices.
+     *
+     * @param vertices Mesh vertices; normals are overwritten, splits are appended
+     * @param indices Triangle list indexing vertices
+     * @param options Crease angle and chunk size
+     * @param pool Pool to run on
+     */
+    void generateNormals(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices,
+                         const NormalOptions& options, ThreadPool& pool);
+    void generateNormals(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices);
+
+    /**
+     * Computes tangents from the texture coordinates, in the MikkTSpace
+     * convention: xyz is the tangent, orthogonalized against the vertex
+     * normal, and w (+1 or -1) gives the bitangent as w * cross(normal, tangent).
+     * Corners are weighted by their angle. Vertices without usable texture
+     * coordinates get an arbitrary tangent perpendicular to the normal.
+     * Unlike full MikkTSpace, vertices are not split where the texture
+     * mapping is mirrored; such vertices take the majority handedness.
+     *
+     * @param vertices Mesh vertices with normals; tangents are overwritten
+     * @param indices Triangle list indexing vertices
+     * @param pool Pool to run on
+     * @param grainSize Triangles (or vertices) per parallel chunk
+     */
+    void generateTangents(std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices,
+                          ThreadPool& pool, size_t grainSize = 4096);
+    void generateTangents(std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices);
+
+    /**
+     * Meshlet limits; 64 vertices and 124 triangles fit the output limits
+     * of mesh shaders on every current vendor
+     */
+    constexpr uint32_t MAX_MESHLET_VERTICES = 64;
+    constexpr uint32_t MAX_MESHLET_TRIANGLES = 124;
+
+    /**
+     * A small cluster of triangles with its own local vertex list, and a
+     * bounding sphere for culling
+     */
+    struct Meshlet {
+        uint32_t vertexOffset;              ///< First entry in MeshletData::vertices
+        uint32_t triangleOffset;            ///< First byte in MeshletData::triangles
+        uint32_t vertexCount;
+        uint32_t triangleCount;
+        glm::vec3 center;
+        float radius;
+    };
+
+    /**
+     * Meshlets of a mesh: each meshlet's vertices index the mesh's vertex
+     * buffer, and its triangles are 3 bytes each indexing its vertices
+     */
+    struct MeshletData {
+        std::vector<Meshlet> meshlets;
+        std::vector<uint32_t> vertices;
+        std::vector<uint8_t> triangles;
+    };
+
+    /**
+     * Reorders triangles for the post-transform vertex cache (Forsyth's
+     * linear-speed algorithm, 32-entry LRU cache model), so consecutive
+     * triangles reuse recently shaded vertices.
+     *
+     * @param indices Triangle list; reordered in place
+     * @param vertexCount Number of vertices the indices refer to
+     */
+    void optimizeVertexCache(std::vector<uint32_t>& indices, size_t vertexCount);
+
+    /**
+     * Reorders vertices into the order the triangles first use them, so
+     * vertex fetches walk memory forward. Unreferenced vertices are dropped.
+     *
+     * @param vertices Mesh vertices; reordered in place
+     * @param indices Triangle list; remapped in place
+     */
+    void optimizeVertexFetch(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices);
+
+    /**
+     * Builds a lower level of detail by vertex clustering: vertices are
+     * snapped to a uniform grid over the mesh bounds, each cell keeps one of
+     * its vertices, and triangles that collapse are removed. The finest grid
+     * that reaches the target is used. Simplified triangles index the
+     * original vertices, so every level shares one vertex buffer.
+     *
+     * @param vertices Mesh vertices
+     * @param indices Triangle list to simplify
+     * @param targetTriangleCount Most triangles the result may have
+     * @param error Set to the grid cell diagonal relative to the bounds diagonal
+     * @return The simplified triangle list (empty if the target cannot be reached)
+     */
+    std::vector<uint32_t> simplifyClusters(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices,
+                                           size_t targetTriangleCount, float& error);
+
+    /**
+     * Splits a triangle list into meshlets in index order (run it after
+     * optimizeVertexCache, whose order keeps meshlets compact).
+     *
+     * @param vertices Mesh vertices, for the bounding spheres
+     * @param indices Triangle list
+     * @param maxVertices Vertex limit per meshlet (at most 256)
+     * @param maxTriangles Triangle limit per meshlet
+     */
+    MeshletData buildMeshlets(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices,
+                              uint32_t maxVertices = MAX_MESHLET_VERTICES,
+                              uint32_t maxTriangles = MAX_MESHLET_TRIANGLES);
+
+} // namespace MeshProcessing
+} // namespace VulkanGameEngine
@@ -0,0 +1,266 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace VulkanGameEngine {
+
+/**
+ * Monotonically increasing count (events, bytes, ...). Safe to add from any thread.
+ */
+class MetricCounter {
+public:
+    void add(uint64_t amount = 1) { m_total.fetch_add(amount, std::memory_order_relaxed); }
+    uint64_t getTotal() const { return m_total.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<uint64_t> m_total{0};
+};
+
+/**
+ * Last-written value of something that goes up and down (memory in use, queue depth, ...)
+ */
+class MetricGauge {
+public:
+    void set(double value) { m_value.store(value, std::memory_order_relaxed); }
+    double get() const { return m_value.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<double> m_value{0.0};
+};
+
+/**
+ * Percentile summary of a histogram window, in the histogram's display unit
+ */
+struct HistogramSummary {
+    uint64_t count = 0;
+    double mean = 0.0;
+    double p50 = 0.0;
+    double p95 = 0.0;
+    double p99 = 0.0;
+    double max = 0.0;
+};
+
+/**
+ * HDR-style histogram of non-negative integer samples.
+ *
+ * Buckets are log-linear: every power of two is split into 16 linear
+ * sub-buckets, so any recorded value is reported with at most ~6% relative
+ * error while covering 0 to 2^40 in a few hundred counters. Recording is a
+ * single relaxed atomic increment and may happen from any thread.
+ *
+ * Samples accumulate into the current interval. MetricsRegistry::update()
+ * rotates intervals into a small ring, and percentiles are computed over the
+ * last N intervals - a rolling window, so old stutters age out.
+ */
+class MetricHistogram {
+public:
+    static constexpr uint32_t SUB_BUCKET_BITS = 5;
+    static constexpr uint32_t SUB_BUCKET_COUNT = 1u << SUB_BUCKET_BITS;   // Values below this are exact
+    static constexpr uint32_t SUB_BUCKET_HALF = SUB_BUCKET_COUNT / 2;
+    static constexpr uint32_t MAX_VALUE_BITS = 40;                         // Larger values clamp to the last bucket
+    static constexpr uint32_t BUCKET_COUNT = SUB_BUCKET_COUNT + (MAX_VALUE_BITS - SUB_BUCKET_BITS) * SUB_BUCKET_HALF;
+
+    /**
+     * @param unit Unit shown in reports (e.g. "ms")
+     * @param displayScale Recorded values are divided by this for reports (e.g. 1e6 for ns -> ms)
+     * @param windowIntervals Number of intervals kept for the rolling window
+     */
+    MetricHistogram(const std::string& unit, double displayScale, uint32_t windowIntervals);
+
+    MetricHistogram(const MetricHistogram&) = delete;
+    MetricHistogram& operator=(const MetricHistogram&) = delete;
+
+    /**
+     * Records one sample
+     */
+    void record(uint64_t value);
+
+    /**
+     * Moves the current interval into the window ring. Called by MetricsRegistry::update().
+     */
+    void rotate();
+
+    /**
+     * Summarises the last intervalCount completed intervals (clamped to the window size)
+     */
+    HistogramSummary summarize(uint32_t intervalCount) const;
+
+    const std::string& getUnit() const { return m_unit; }
+    double getDisplayScale() const { return m_displayScale; }
+    uint32_t getWindowIntervals() const { return static_cast<uint32_t>(m_intervals.size()); }
+
+    /**
+     * Maps a value to its bucket index
+     */
+    static uint32_t bucketIndex(uint64_t value);
+
+    /**
+     * Gets the highest value that maps to a bucket (used when reporting percentiles)
+     */
+    static uint64_t bucketUpperBound(uint32_t index);
+
+private:
+    /**
+     * One completed interval
+     */
+    struct Interval {
+        std::array<uint32_t, BUCKET_COUNT> buckets{};
+        uint64_t count = 0;
+        uint64_t sum = 0;
+        uint64_t max = 0;
+    };
+
+    std::string m_unit;
+    double m_displayScale;
+
+    // Current interval (written by any thread)
+    std::array<std::atomic<uint32_t>, BUCKET_COUNT> m_current;
+    std::atomic<uint64_t> m_currentSum{0};
+    std::atomic<uint64_t> m_currentMax{0};
+
+    // Completed intervals (guarded by the registry's mutex)
+    std::vector<Interval> m_intervals;
+    uint32_t m_nextInterval = 0;
+    uint32_t m_filledIntervals = 0;
+};
+
+/**
+ * MetricsRegistry owns all named counters, gauges and histograms and
+ * periodically writes them to a CSV or JSON file.
+ *
+ * Metrics are created on first lookup and live for the whole program, so
+ * callers should look them up once and keep the reference:
+ *
+ *   static MetricHistogram& frameTime = MetricsRegistry::getInstance().histogram("frame.total", "ms", 1e6);
+ *   frameTime.record(durationNs);
+ *
+ * The main loop calls update() once per frame; it rotates histogram
+ * intervals (default: every second, ten-second window) and triggers exports.
+ */
+class MetricsRegistry {
+public:
+    /**
+     * Export file format
+     */
+    enum class ExportFormat {
+        CSV,    // One row per metric per export, appended
+        JSON    // Whole file rewritten with the latest snapshot
+    };
+
+    /**
+     * Rolling window and export settings
+     */
+    struct Config {
+        double intervalSeconds = 1.0;       // Length of one histogram interval
+        uint32_t windowIntervals = 10;      // Intervals in the rolling window
+        double exportIntervalSeconds = 10.0;
+        std::string exportPath;             // Empty disables export
+        ExportFormat exportFormat = ExportFormat::CSV;
+    };
+
+    /**
+     * Gets the singleton registry
+     */
+    static MetricsRegistry& getInstance();
+
+    /**
+     * Applies new settings. Call before any histogram is created, since
+     * existing histograms keep their window size.
+     */
+    void configure(const Config& config);
+
+    /**
+     * Gets or creates a counter
+     */
+    MetricCounter& counter(const std::string& name);
+
+    /**
+     * Gets or creates a gauge
+     */
+    MetricGauge& gauge(const std::string& name);
+
+    /**
+     * Gets or creates a histogram
+     *
+     * @param name Metric name, e.g. "frame.total"
+     * @param unit Unit shown in reports
+     * @param displayScale Divisor applied to recorded values in reports
+     */
+    MetricHistogram& histogram(const std::string& name, const std::string& unit = "", double displayScale = 1.0);
+
+    /**
+     * Rotates intervals and writes exports when due. Call once per frame from the main thread.
+     */
+    void update();
+
+    /**
+     * Summarises a histogram over its whole rolling window
+     *
+     * @return false if no histogram with that name exists
+     */
+    bool getSummary(const std::string& name, HistogramSummary& summary) const;
+
+    /**
+     * Writes all metrics to the configured export file immediately
+     *
+     * @return true if the file was written
+     */
+    bool exportNow();
+
+    /**
+     * Gets the current steady_clock time in nanoseconds
+     */
+    static int64_t now();
+
+private:
+    MetricsRegistry();
+    ~MetricsRegistry() = default;
+    MetricsRegistry(const MetricsRegistry&) = delete;
+    MetricsRegistry& operator=(const MetricsRegistry&) = delete;
+
+    bool writeCsv(double timestampSeconds);
+    bool writeJson(double timestampSeconds);
+
+    mutable std::mutex m_mutex;                // Guards the maps and interval rotation
+    Config m_config;
+
+    std::map<std::string, std::unique_ptr<MetricCounter>> m_counters;
+    std::map<std::string, std::unique_ptr<MetricGauge>> m_gauges;
+    std::map<std::string, std::unique_ptr<MetricHistogram>> m_histograms;
+    std::map<std::string, uint64_t> m_counterWindowStart;  // Counter totals at the last export
+
+    int64_t m_startNs;
+    int64_t m_lastRotateNs;
+    int64_t m_lastExportNs;
+    bool m_csvHeaderWritten = false;
+};
+
+/**
+ * RAII helper that records the duration of a scope (in nanoseconds) into a histogram
+ */
+class ScopedMetricTimer {
+public:
+    explicit ScopedMetricTimer(MetricHistogram& histogram)
+        : m_histogram(histogram), m_start(MetricsRegistry::now()) {}
+
+    ~ScopedMetricTimer() {
+        const int64_t elapsed = MetricsRegistry::now() - m_start;
+        m_histogram.record(elapsed > 0 ? static_cast<uint64_t>(elapsed) : 0);
+    }
+
+    ScopedMetricTimer(const ScopedMetricTimer&) = delete;
+    ScopedMetricTimer& operator=(const ScopedMetricTimer&) = delete;
+
+private:
+    MetricHistogram& m_histogram;
+    int64_t m_start;
+};
+
+} // namespace VulkanGameEngine
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "RenderBackend.h"
+
+namespace VulkanGameEngine {
+
+/**
+ * NullRenderBackend accepts every resource and command call and does nothing
+ * with it.
+ *
+ * It never touches Vulkan, so the engine runs its complete frame - scene
+ * update, uniform packing, command list recording and submission bookkeeping -
+ * on machines without a GPU driver. Profiling a run on this backend shows the
+ * engine's own CPU cost; the difference to a VulkanRenderBackend run is what
+ * the driver adds.
+ *
+ * Handles are still allocated and validated, and recordFrame walks the list
+ * checking every bound handle and the pass and zone nesting, so engine bugs
+ * (using a destroyed buffer, unbalanced passes) surface here too.
+ */
+class NullRenderBackend : public RenderBackend {
+public:
+    NullRenderBackend();
+    ~NullRenderBackend() override;
+
+    const char* getName() const override { return "null"; }
+
+    void initialize(const BackendConfig& config) override;
+    void cleanup() override;
+    void waitIdle() override {}
+    void resize(uint32_t width, uint32_t height) override;
+    void getRenderExtent(uint32_t& width, uint32_t& height) const override;
+
+    BufferHandle createBuffer(BufferType type, const void* data, size_t size) override;
+    void updateBuffer(BufferHandle buffer, const void* data, size_t size) override;
+    void updateBufferRange(BufferHandle buffer, size_t offset, const void* data, size_t size) override;
+    void destroyBuffer(BufferHandle buffer) override;
+    PipelineHandle createPipeline(const PipelineDesc& desc) override;
+    void destroyPipeline(PipelineHandle pipeline) override;
+    void replacePipeline(PipelineHandle pipeline, const PipelineDesc& desc) override;
+
+    FrameStatus beginFrame(uint32_t frameSlot) override;
+    void recordFrame(const CommandList& commands) override;
+    void submitFrame() override {}
+    FrameStatus presentFrame() override { return FrameStatus::READY; }
+
+    const BackendTimings& getTimings() const override { return m_timings; }
+    const GpuProfiler::FrameResults& getGpuResults() const override { return m_gpuResults; }
+
+    void readbackFrame(std::vector<uint8_t>& pixels, uint32_t& width, uint32_t& height) override;
+
+    // Nothing is rendered, so there is never anything to read back
+    bool requestReadback(uint64_t /*tag*/) override { return false; }
+    bool pollReadback(ReadbackFrame& /*frame*/) override { return false; }
+    void releaseReadback(uint32_t /*id*/) override {}
+
+    /**
+     * Gets the number of commands in the last recorded frame
+     */
+    size_t getLastCommandCount() const { return m_lastCommandCount; }
+
+private:
+    bool m_initialized;
+    uint32_t m_width;
+    uint32_t m_height;
+    std::vector<bool> m_liveBuffers;        // Indexed by handle - 1
+    std::vector<bool> m_livePipelines;      // Indexed by handle - 1
+    size_t m_lastCommandCount;
+    BackendTimings m_timings;               // Always zero: nothing ever blocks
+    GpuProfiler::FrameResults m_gpuResults; // Always invalid: there is no GPU
+
+    void checkBuffer(BufferHandle buffer) const;
+    void checkPipeline(PipelineHandle pipeline) const;
+};
+
+} // namespace VulkanGameEngine
@@ -0,0 +1,117 @@
+#pragma once
+
+#include "Common.h"
+#include <istream>
+#include <string>
+#include <vector>
+
+namespace VulkanGameEngine {
+
+/**
+ * ObjLoader turns Wavefront OBJ text into the engine's vertex and index data.
+ *
+ * It is CPU-only and independent of any render backend, so the loader can be
+ * measured and tested without a GPU (see bench/engine_bench.cpp).
+ *
+ * Supported OBJ elements:
+ * - Vertex positions (v)
+ * - Vertex normals (vn)
+ * - Texture coordinates (vt)
+ * - Face indices (f), polygons are triangulated as fans
+ */
+namespace ObjLoader {
+
+    /**
+     * Marks a face corner without a texture coordinate or normal
+     */
+    constexpr uint32_t NO_INDEX = UINT32_MAX;
+
+    /**
+     * Raw data read from an OBJ file
+     */
+    struct OBJData {
+        std::vector<glm::vec3> positions;    ///< Vertex positions from OBJ
+        std::vector<glm::vec3> normals;      ///< Vertex normals from OBJ
+        std::vector<glm::vec2> texCoords;    ///< Texture coordinates from OBJ
+        std::vector<uint32_t> indices;       ///< Position index of each triangle corner
+        std::vector<uint32_t> texCoordIndices; ///< Texture coordinate index per corner (or NO_INDEX)
+        std::vector<uint32_t> normalIndices; ///< Normal index per corner (or NO_INDEX)
+
+        void clear() {
+            positions.clear();
+            normals.clear();
+            texCoords.clear();
+            indices.clear();
+            texCoordIndices.clear();
+            normalIndices.clear();
+        }
+    };
+
+    /**
+     * Parses an OBJ file and extracts vertex data. The file is read through
+     * AssetFileSystem, so it may come from a mounted archive.
+     *
+     * @param filePath Path to the OBJ file
+     * @param objData Output structure to store parsed data
+     * @return true if parsing succeeded, false otherwise
+     */
+    bool parseOBJFile(const std::string& filePath, OBJData& objData);
+
+    /**
+     * Parses OBJ text already in memory (see parseOBJStream)
+     *
+     * @param bytes Contents of an OBJ file
+     * @param objData Output structure to store parsed data
+     * @return true if at least one position and one face were read
+     */
+    bool parseOBJBuffer(const std::vector<char>& bytes, OBJData& objData);
+
+    /**
+     * Parses OBJ text from a stream line by line and extracts:
+     * - Vertex positions (v x y z)
+     * - Vertex normals (vn x y z)
+     * - Texture coordinates (vt u v)
+     * - Face definitions (f v1/vt1/vn1 v2/vt2/vn2 v3/vt3/vn3)
+     *
+     * @param stream OBJ text
+     * @param objData Output structure to store parsed data
+     * @return true if at least one position and one face were read
+     */
+    bool parseOBJStream(std::istream& stream, OBJData& objData);
+
+    /**
+     * Parses a face line from OBJ file.
+     *
+     * Handles different face formats:
+     * - f v1 v2 v3 (positions only)
+     * - f v1/vt1 v2/vt2 v3/vt3 (positions and tex coords)
+     * - f v1//vn1 v2//vn2 v3//vn3 (positions and normals)
+     * - f v1/vt1/vn1 v2/vt2/vn2 v3/vt3/vn3 (all attributes)
+     *
+     * @param line Face definition line from OBJ file
+     * Texture coordinate and normal indices that are missing or out of range
+     * are stored as NO_INDEX.
+     *
+     * @param objData Output structure to store face indices
+     * @return true if parsing succeeded, false otherwise
+     */
+    bool parseFaceLine(const std::string& line, OBJData& objData);
+
+    /**
+     * Converts OBJ data to Vulkan vertex format.
+     *
+     * Each distinct position/texture coordinate/normal combination becomes
+     * one vertex, shared by every face using it. Imported normals are used
+     * when every corner has one; otherwise smooth normals are generated
+     * (MeshProcessing::generateNormals, which may split vertices along
+     * creases). Tangents are always generated. Colors are generated by the
+     * vertex shader (see ColorMode).
+     *
+     * @param objData Raw OBJ data from file parsing
+     * @param vertices Output vertices (replaced)
+     * @param indices Output triangle indices (replaced)
+     */
+    void convertOBJToVertices(const OBJData& objData, std::vector<Vertex>& vertices, std::vector<uint32_t>& indices);
+
+} // namespace ObjLoader
+} // namespace VulkanGameEngine
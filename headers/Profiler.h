@@ -0,0 +1,226 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace VulkanGameEngine {
+
+/**
+ * Profiler records hierarchical CPU timing zones from any thread and exports
+ * them as Chrome trace JSON (viewable in chrome://tracing or ui.perfetto.dev).
+ *
+ * Each thread writes completed zones into its own fixed-size ring buffer, so
+ * recording a zone never takes a lock or allocates. Timestamps are steady_clock
+ * nanoseconds. Every zone remembers its nesting depth and the frame it started
+ * in, which lets the exporter pick out an exact range of frames.
+ *
+ * Usage:
+ *   PROFILE_FRAME_MARK();                 // once per frame, at the top of the main loop
+ *   { PROFILE_ZONE("UpdateScene"); ... }  // time a scope
+ *   Profiler::getInstance().captureFrames(120, "trace.json");
+ */
+class Profiler {
+public:
+    /**
+     * One completed zone
+     */
+    struct Event {
+        const char* name;       // Must have static storage (string literal or __func__)
+        int64_t startNs;
+        int64_t endNs;
+        uint64_t frame;         // Frame index when the zone started
+        uint32_t depth;         // Nesting depth on its thread (0 = outermost)
+        uint32_t threadId;
+    };
+
+    /**
+     * Events per thread kept in the ring buffer before the oldest are overwritten
+     */
+    static constexpr size_t EVENTS_PER_THREAD = 1 << 16;
+
+    /**
+     * Gets the singleton profiler instance
+     */
+    static Profiler& getInstance();
+
+    /**
+     * Enables or disables zone recording (zones are nearly free when disabled)
+     */
+    void setEnabled(bool enabled) { m_enabled.store(enabled, std::memory_order_relaxed); }
+
+    /**
+     * Checks if zone recording is enabled
+     */
+    bool isEnabled() const { return m_enabled.load(std::memory_order_relaxed); }
+
+    /**
+     * Marks the start of a new frame. Call once per frame from the main loop.
+     * Also writes a pending capture once its last frame has completed.
+     */
+    void markFrame();
+
+    /**
+     * Gets the index of the current frame
+     */
+    uint64_t getFrameIndex() const { return m_frameIndex.load(std::memory_order_relaxed); }
+
+    /**
+     * Names the calling thread in exported traces
+     */
+    void setThreadName(const std::string& name);
+
+    /**
+     * Schedules a trace export covering the next frameCount frames.
+     * The file is written automatically after the last of those frames ends.
+     *
+     * @param frameCount Number of frames to capture
+     * @param outputPath Path of the JSON file to write
+     */
+    void captureFrames(uint32_t frameCount, const std::string& outputPath);
+
+    /**
+     * Writes all recorded zones whose frame lies in [firstFrame, lastFrame] as Chrome trace JSON.
+     *
+     * @param outputPath Path of the JSON file to write
+     * @param firstFrame First frame to include
+     * @param lastFrame Last frame to include
+     * @return true if the file was written
+     */
+    bool exportChromeTrace(const std::string& outputPath, uint64_t firstFrame, uint64_t lastFrame);
+
+    /**
+     * Copies every recorded zone that started in the given frame range, from all threads
+     */
+    void collectEvents(uint64_t firstFrame, uint64_t lastFrame, std::vector<Event>& events);
+
+    /**
+     * Records a zone measured on the GPU. GPU zones are shown on their own
+     * "GPU" track in exported traces. Must only be called from the render thread.
+     *
+     * @param name Zone label (static storage)
+     * @param startNs Start time mapped onto the steady_clock timeline
+     * @param endNs End time mapped onto the steady_clock timeline
+     * @param frame Frame the GPU work belongs to
+     * @param depth Nesting depth of the zone
+     */
+    void recordGpuZone(const char* name, int64_t startNs, int64_t endNs, uint64_t frame, uint32_t depth);
+
+    /**
+     * Gets the current steady_clock time in nanoseconds
+     */
+    static int64_t now() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    /**
+     * Opens a zone on the calling thread (use PROFILE_ZONE instead of calling directly)
+     */
+    void beginZone(const char* name);
+
+    /**
+     * Closes the innermost open zone on the calling thread
+     */
+    void endZone();
+
+private:
+    Profiler();
+    ~Profiler() = default;
+    Profiler(const Profiler&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+
+    static constexpr uint32_t MAX_ZONE_DEPTH = 64;
+
+    /**
+     * Per-thread event ring. Only the owning thread writes events and
+     * writeCount; readers copy a range and then re-check writeCount to discard
+     * anything that was overwritten while they were copying.
+     * Buffers of exited threads are handed to new threads instead of being freed.
+     */
+    struct ThreadBuffer {
+        std::vector<Event> events;
+        std::atomic<uint64_t> writeCount{0};
+        std::atomic<bool> inUse{true};
+        uint32_t threadId = 0;
+
+        // Open zones (only touched by the owning thread)
+        const char* openNames[MAX_ZONE_DEPTH];
+        int64_t openStarts[MAX_ZONE_DEPTH];
+        uint64_t openFrames[MAX_ZONE_DEPTH];
+        uint32_t depth = 0;
+    };
+
+    /**
+     * Start time of a frame, used to draw frame boundaries in the trace
+     */
+    struct FrameMarker {
+        uint64_t frame;
+        int64_t startNs;
+    };
+
+    static constexpr size_t FRAME_MARKER_CAPACITY = 4096;
+
+    std::atomic<bool> m_enabled{true};
+    std::atomic<uint64_t> m_frameIndex{0};
+    std::atomic<uint32_t> m_nextThreadId{1};
+
+    std::mutex m_threadsMutex;                           // Guards m_threads and m_threadNames (taken once per thread)
+    std::vector<std::shared_ptr<ThreadBuffer>> m_threads;
+    std::unordered_map<uint32_t, std::string> m_threadNames;
+    std::shared_ptr<ThreadBuffer> m_gpuTrack;            // Pseudo-thread holding GPU zones
+
+    std::vector<FrameMarker> m_frameMarkers;             // Ring written only by markFrame()
+    std::mutex m_frameMarkersMutex;
+
+    // Pending capture request
+    std::mutex m_captureMutex;
+    std::string m_capturePath;
+    uint64_t m_captureFirstFrame = 0;
+    uint64_t m_captureLastFrame = 0;
+    std::atomic<bool> m_capturePending{false};
+
+    /**
+     * Returns the calling thread's buffer, registering it on first use
+     */
+    ThreadBuffer& getThreadBuffer();
+};
+
+/**
+ * RAII helper that times the enclosing scope as a profiler zone
+ */
+class ProfileZone {
+public:
+    explicit ProfileZone(const char* name)
+        : m_active(Profiler::getInstance().isEnabled()) {
+        if (m_active) {
+            Profiler::getInstance().beginZone(name);
+        }
+    }
+
+    ~ProfileZone() {
+        if (m_active) {
+            Profiler::getInstance().endZone();
+        }
+    }
+
+    ProfileZone(const ProfileZone&) = delete;
+    ProfileZone& operator=(const ProfileZone&) = delete;
+
+private:
+    bool m_active;
+};
+
+} // namespace VulkanGameEngine
+
+// Profiling macros
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_ZONE(name) VulkanGameEngine::ProfileZone PROFILE_CONCAT(_profileZone, __LINE__)(name)
+#define PROFILE_FUNCTION() PROFILE_ZONE(__func__)
+#define PROFILE_FRAME_MARK() VulkanGameEngine::Profiler::getInstance().markFrame()
@@ -0,0 +1,217 @@
+#pragma once
+
+#include "Common.h"
+#include "CommandList.h"
+#include "GpuProfiler.h"
+#include <memory>
+
+namespace VulkanGameEngine {
+
+/**
+ * Available rendering backends
+ */
+enum class BackendType {
+    VULKAN,         // Renders through Vulkan (windowed or headless)
+    NULL_BACKEND    // Accepts every call and does nothing; no GPU or driver needed
+};
+
+/**
+ * What a backend buffer is used for
+ */
+enum class BufferType {
+    VERTEX,         // Device-local, filled once at creation
+    INDEX,          // Device-local, filled once at creation
+    UNIFORM,        // Host-visible, rewritten every frame with updateBuffer
+    DYNAMIC_VERTEX  // Host-visible with one copy per frame in flight, rewritten (in part) during frames
+};
+
+/**
+ * Settings passed to RenderBackend::initialize
+ */
+struct BackendConfig {
+    SDL_Window* window = nullptr;   // Window to present to (null = render offscreen)
+    uint32_t width = 0;
+    uint32_t height = 0;
+};
+
+/**
+ * Description of a graphics pipeline (shaders use the engine's Vertex layout
+ * and UniformBufferObject at set 0, binding 0)
+ */
+struct PipelineDesc {
+    std::string vertexShaderPath;
+    std::string fragmentShaderPath;
+    std::vector<char> vertexShaderCode;     // SPIR-V used instead of reading the path (empty = read the file)
+    std::vector<char> fragmentShaderCode;
+};
+
+/**
+ * Outcome of beginFrame/presentFrame
+ */
+enum class FrameStatus {
+    READY,          // Continue with the frame
+    SKIPPED         // Render target was recreated (or could not be waited on); drop this frame
+};
+
+/**
+ * Time a backend spent blocked during the last frame
+ */
+struct BackendTimings {
+    int64_t fenceWaitNs = 0;        // Waiting for the frame slot to be free
+    int64_t acquireNs = 0;          // Acquiring the image to render into
+    int64_t presentNs = 0;          // Queueing the image for presentation
+};
+
+/**
+ * A frame copied back to host memory by requestReadback()
+ */
+struct ReadbackFrame {
+    uint32_t id = 0;                    // Pass to releaseReadback() when done with the pixels
+    uint64_t tag = 0;                   // Value given to requestReadback (usually the frame number)
+    uint32_t width = 0;
+    uint32_t height = 0;
+    bool bgra = false;                  // Channel order is BGRA (common for swapchains) instead of RGBA
+    const uint8_t* pixels = nullptr;    // width * height * 4 bytes, top row first
+};
+
+/**
+ * RenderBackend is the layer beneath VulkanEngine that owns every GPU object.
+ *
+ * The engine runs the scene update and records each frame into a
+ * CommandList using opaque buffer and pipeline handles; the backend turns
+ * those into real work. A frame is:
+ *
+ *   beginFrame(slot)       // wait for the slot, acquire a target image
+ *   updateBuffer(...)      // per-frame uniform and dynamic vertex data
+ *   recordFrame(list)      // translate the command list
+ *   submitFrame()
+ *   presentFrame()
+ *
+ * VulkanRenderBackend does this with Vulkan. NullRenderBackend accepts every
+ * call and does nothing, so the CPU cost of the engine itself can be
+ * benchmarked and profiled on machines without any Vulkan driver.
+ */
+class RenderBackend {
+public:
+    virtual ~RenderBackend() = default;
+
+    /**
+     * Gets the backend name used in logs and on the command line
+     */
+    virtual const char* getName() const = 0;
+
+    /**
+     * Creates the device and render target. Throws std::runtime_error on failure.
+     */
+    virtual void initialize(const BackendConfig& config) = 0;
+
+    /**
+     * Destroys everything the backend created. Safe to call multiple times.
+     */
+    virtual void cleanup() = 0;
+
+    /**
+     * Waits until the GPU has finished all submitted work
+     */
+    virtual void waitIdle() = 0;
+
+    /**
+     * Recreates the render target at a new size (also used to recover from errors)
+     */
+    virtual void resize(uint32_t width, uint32_t height) = 0;
+
+    /**
+     * Gets the size of the current render target
+     */
+    virtual void getRenderExtent(uint32_t& width, uint32_t& height) const = 0;
+
+    // Resources. Buffers and pipelines may be destroyed while frames that use
+    // them are in flight; the backend frees them once those frames finish.
+    virtual BufferHandle createBuffer(BufferType type, const void* data, size_t size) = 0;
+    virtual void updateBuffer(BufferHandle buffer, const void* data, size_t size) = 0;
+    virtual void destroyBuffer(BufferHandle buffer) = 0;
+
+    /**
+     * Rewrites size bytes of a uniform or dynamic vertex buffer starting at
+     * offset. A DYNAMIC_VERTEX buffer keeps one copy per frame in flight:
+     * this writes the copy of the frame slot passed to beginFrame (so it must
+     * be called between beginFrame and submitFrame), leaving the copies the
+     * GPU may still be reading untouched. Never waits for the GPU.
+     */
+    virtual void updateBufferRange(BufferHandle buffer, size_t offset, const void* data, size_t size) = 0;
+
+    virtual PipelineHandle createPipeline(const PipelineDesc& desc) = 0;
+    virtual void destroyPipeline(PipelineHandle pipeline) = 0;
+
+    /**
+     * Rebuilds a pipeline from a new description, keeping its handle. Frames
+     * already submitted finish with the old pipeline. Throws (leaving the
+     * old pipeline in place) if the new one cannot be built.
+     */
+    virtual void replacePipeline(PipelineHandle pipeline, const PipelineDesc& desc) = 0;
+
+    // Frame
+    virtual FrameStatus beginFrame(uint32_t frameSlot) = 0;
+    virtual void recordFrame(const CommandList& commands) = 0;
+    virtual void submitFrame() = 0;
+    virtual FrameStatus presentFrame() = 0;
+
+    /**
+     * Gets the blocking times of the most recent frame
+     */
+    virtual const BackendTimings& getTimings() const = 0;
+
+    /**
+     * Gets GPU timings of the latest completed frame (valid = false if none)
+     */
+    virtual const GpuProfiler::FrameResults& getGpuResults() const = 0;
+
+    /**
+     * Copies the most recently rendered frame to host memory.
+     * Throws if the backend cannot (windowed Vulkan, null backend).
+     *
+     * @param pixels Output: width * height RGBA8 pixels, top row first
+     */
+    virtual void readbackFrame(std::vector<uint8_t>& pixels, uint32_t& width, uint32_t& height) = 0;
+
+    /**
+     * Copies the frame about to be recorded into a host-visible readback
+     * buffer, without waiting for it. Call between beginFrame and recordFrame;
+     * the copy becomes available from pollReadback once the GPU has finished
+     * the frame.
+     *
+     * @param tag Returned with the frame
+     * @return false if every readback buffer is still in use (the frame is not copied)
+     */
+    virtual bool requestReadback(uint64_t tag) = 0;
+
+    /**
+     * Gets the oldest finished readback, if any. Never waits for the GPU.
+     * The pixels stay valid until releaseReadback(frame.id).
+     */
+    virtual bool pollReadback(ReadbackFrame& frame) = 0;
+
+    /**
+     * Returns a readback buffer to the ring. Safe to call from any thread.
+     */
+    virtual void releaseReadback(uint32_t id) = 0;
+};
+
+/**
+ * Creates a backend of the given type
+ */
+std::unique_ptr<RenderBackend> createRenderBackend(BackendType type);
+
+/**
+ * Gets the command line name of a backend type ("vulkan", "null")
+ */
+const char* getBackendName(BackendType type);
+
+/**
+ * Parses a backend name as accepted on the command line
+ *
+ * @return false if the name is not a known backend
+ */
+bool parseBackendType(const std::string& name, BackendType& type);
+
+} // namespace VulkanGameEngine
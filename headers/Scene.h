@@ -0,0 +1,185 @@
+#pragma once
+
+#include "Common.h"
+#include "CommandList.h"
+#include "DynamicMesh.h"
+#include <memory>
+#include <vector>
+
+namespace VulkanGameEngine {
+
+class RenderBackend;
+
+/**
+ * Mesh uploaded to the backend, shared by any number of scene objects
+ */
+struct SceneMesh {
+    BufferHandle vertexBuffer = INVALID_HANDLE;
+    BufferHandle indexBuffer = INVALID_HANDLE;
+    uint32_t vertexCount = 0;
+    uint32_t indexCount = 0;
+    ColorMode colorMode = ColorMode::RAINBOW; // Pushed with every draw of the mesh
+    bool deforming = false;                 // Buffers belong to a DynamicMesh (see Scene::addDeformingMesh)
+};
+
+/**
+ * One instance of a mesh in the scene
+ */
+struct SceneObject {
+    uint32_t mesh = 0;                      // Index returned by Scene::addMesh
+    uint32_t material = 0;                  // Index returned by Scene::addMaterial
+    glm::vec3 position = glm::vec3(0.0f);
+    glm::vec3 rotation = glm::vec3(0.0f);   // Euler angles in radians (applied X, Y, Z)
+    float scale = 1.0f;
+    bool dynamic = false;                   // Transform is recomputed every frame
+    glm::vec3 angularVelocity = glm::vec3(0.0f); // Radians per second (dynamic objects)
+};
+
+/**
+ * Scene is a flat list of mesh instances drawn by VulkanEngine.
+ *
+ * Meshes are uploaded once and shared; materials are tints applied through
+ * the per-draw ObjectConstants, together with the mesh's color mode. Static objects compute their model matrix
+ * when added, dynamic objects every update(). Drawing walks the objects in
+ * mesh-then-material order, so vertex and index buffers are only rebound
+ * when the mesh changes, and costs one push-constant update and one draw per
+ * object.
+ *
+ * Deforming meshes are DynamicMeshes whose vertices the scene moves on the
+ * CPU: a bulge travels along the vertex order (pole to pole on generated
+ * spheres), so each update() rewrites and marks dirty only the vertices
+ * around the bulge, and flush() uploads just those.
+ *
+ * Once update() has run after the last addObject(), record() does not
+ * allocate (the engine reserves command list space from getCommandCount()).
+ */
+class Scene {
+public:
+    /**
+     * Totals over the whole scene (every object is drawn every frame)
+     */
+    struct Stats {
+        uint32_t objects = 0;
+        uint32_t dynamicObjects = 0;
+        uint32_t meshes = 0;
+        uint32_t deformingMeshes = 0;
+        uint32_t materials = 0;
+        uint32_t drawsPerFrame = 0;
+        uint64_t trianglesPerFrame = 0;
+    };
+
+    Scene() = default;
+    Scene(const Scene&) = delete;
+    Scene& operator=(const Scene&) = delete;
+
+    /**
+     * Uploads a mesh. Throws std::runtime_error on empty data.
+     *
+     * @param colorMode How the vertex shader colors the mesh
+     * @return Mesh index for SceneObject::mesh
+     */
+    uint32_t addMesh(RenderBackend& backend, const std::vector<Vertex>& vertices,
+                     const std::vector<uint32_t>& indices, ColorMode colorMode = ColorMode::RAINBOW);
+
+    /**
+     * Uploads a mesh whose vertices ripple every update(). Throws
+     * std::runtime_error on empty data or out-of-range indices.
+     *
+     * @param colorMode How the vertex shader colors the mesh
+     * @return Mesh index for SceneObject::mesh
+     */
+    uint32_t addDeformingMesh(RenderBackend& backend, const std::vector<Vertex>& vertices,
+                              const std::vector<uint32_t>& indices, ColorMode colorMode = ColorMode::RAINBOW);
+
+    /**
+     * Adds a material
+     *
+     * @param tint Multiplied with the vertex colors of objects using it
+     * @return Material index for SceneObject::material
+     */
+    uint32_t addMaterial(const glm::vec4& tint);
+
+    /**
+     * Adds an object. Throws std::runtime_error if its mesh or material does not exist.
+     *
+     * @return Object index
+     */
+    uint32_t addObject(const SceneObject& object);
+
+    /**
+     * Advances dynamic objects and deforming meshes by deltaTime and
+     * refreshes the draw order after additions
+     */
+    void update(float deltaTime);
+
+    /**
+     * Uploads the vertices of deforming meshes that changed since the frame
+     * slot was last flushed. Call between the backend's beginFrame and submitFrame.
+     *
+     * @return Bytes uploaded
+     */
+    size_t flush(uint32_t frameSlot);
+
+    /**
+     * Records every object. The caller has begun the pass and bound the
+     * pipeline and uniforms.
+     */
+    void record(CommandList& commandList) const;
+
+    /**
+     * Upper bound of the commands record() emits
+     */
+    size_t getCommandCount() const { return m_objects.size() * 2 + m_meshes.size() * 2; }
+
+    /**
+     * Destroys the mesh buffers and removes everything
+     */
+    void clear(RenderBackend& backend);
+
+    bool empty() const { return m_objects.empty(); }
+    const Stats& getStats() const { return m_stats; }
+    const std::vector<SceneObject>& getObjects() const { return m_objects; }
+    const SceneMesh& getMesh(uint32_t index) const { return m_meshes[index]; }
+
+    /**
+     * Gets the radius around the origin containing every object position
+     */
+    float getRadius() const { return m_radius; }
+
+    /**
+     * Composes translation * rotation (Z * Y * X) * scale, as MainCharacter does
+     */
+    static glm::mat4 composeTransform(const glm::vec3& position, const glm::vec3& rotation, float scale);
+
+private:
+    /**
+     * CPU state of a deforming mesh
+     */
+    struct DeformingMesh {
+        std::unique_ptr<DynamicMesh> mesh;
+        std::vector<glm::vec3> restPositions;
+        float phase = 0.0f;                 // Position of the bulge along the vertices, in [0, 1)
+        uint32_t bandBegin = 0;             // Vertices displaced by the last update
+        uint32_t bandEnd = 0;
+    };
+
+    std::vector<SceneMesh> m_meshes;
+    std::vector<DeformingMesh> m_deformingMeshes;
+    std::vector<glm::vec4> m_materials;
+    std::vector<SceneObject> m_objects;
+    std::vector<glm::mat4> m_transforms;    // Per object, parallel to m_objects
+    std::vector<uint32_t> m_dynamicObjects; // Indices of dynamic objects
+    std::vector<uint32_t> m_drawOrder;      // Object indices sorted by mesh, then material
+    bool m_drawOrderDirty = false;
+    float m_radius = 0.0f;
+    Stats m_stats;
+
+    void sortDrawOrder();
+
+    /**
+     * Moves a deforming mesh's bulge on and rewrites the vertices it left and entered
+     */
+    static void deform(DeformingMesh& deforming, float deltaTime);
+};
+
+} // namespace VulkanGameEngine
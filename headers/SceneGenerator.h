@@ -0,0 +1,104 @@
+#pragma once
+
+#include "Common.h"
+#include <string>
+
+namespace VulkanGameEngine {
+
+class Scene;
+class RenderBackend;
+struct BenchmarkScript;
+
+/**
+ * SceneGenerator builds synthetic scenes of configurable size for scalability
+ * measurements (frame time against object, draw and triangle counts).
+ *
+ * Scenes are described by a comma-separated spec, as accepted by
+ * `game --scene`:
+ *
+ *   instances=1000     objects in the scene
+ *   layout=grid        grid | random (random also varies yaw and scale)
+ *   mesh=sphere        sphere | cube | character (assets/FinalBaseMesh.obj)
+ *   detail=16          sphere rings (segments are twice this)
+ *   meshes=4           unique meshes, each a separately uploaded variant of the shape
+ *   deforming=0        how many of those meshes ripple on the CPU every frame (DynamicMesh partial updates)
+ *   materials=8        material tints
+ *   dynamic=0.1        fraction of objects that spin (transform updated every frame)
+ *   spacing=3          distance between neighbouring objects
+ *   seed=1             random seed (same seed, same scene, on every platform)
+ *   camera=orbit       orbit | flythrough | static | script (keep the benchmark script's path)
+ *
+ * e.g. `instances=10000,layout=random,meshes=8,dynamic=0.25`. Everything is
+ * added through the normal Scene API, so the engine draws the result like any
+ * other scene.
+ */
+namespace SceneGenerator {
+
+    enum class Layout {
+        GRID,
+        RANDOM
+    };
+
+    enum class MeshShape {
+        SPHERE,
+        CUBE,
+        CHARACTER
+    };
+
+    enum class CameraPath {
+        ORBIT,          // Circles the scene once over the run, looking at the center
+        FLYTHROUGH,     // Crosses the scene diagonally at low height
+        STATIC,         // Fixed view of the whole scene
+        SCRIPT          // Leaves the benchmark script's camera path alone
+    };
+
+    /**
+     * Generator parameters (defaults match an empty spec)
+     */
+    struct Config {
+        uint32_t instances = 1000;
+        Layout layout = Layout::GRID;
+        MeshShape shape = MeshShape::SPHERE;
+        uint32_t detail = 16;
+        uint32_t uniqueMeshes = 4;
+        uint32_t deformingMeshes = 0;       // The first ones of the unique meshes (at most all of them)
+        uint32_t materials = 8;
+        float dynamicFraction = 0.1f;
+        float spacing = 3.0f;
+        uint32_t seed = 1;
+        CameraPath camera = CameraPath::ORBIT;
+    };
+
+    /**
+     * Parses a scene spec on top of the defaults.
+     *
+     * @param error Set to a message naming the offending entry on failure
+     * @return true if every entry is valid
+     */
+    bool parseSpec(const std::string& spec, Config& config, std::string& error);
+
+    /**
+     * Formats a configuration as a complete spec (for logs and reports)
+     */
+    std::string describe(const Config& config);
+
+    /**
+     * Uploads the meshes and adds the materials and objects to a scene.
+     * Throws std::runtime_error if the mesh cannot be built (missing asset).
+     */
+    void generate(const Config& config, Scene& scene, RenderBackend& backend);
+
+    /**
+     * Replaces the camera path (and scripted movement) of a benchmark script
+     * with the configured path around the generated scene. Does nothing for
+     * CameraPath::SCRIPT.
+     */
+    void generateCameraPath(const Config& config, const Scene& scene, BenchmarkScript& script);
+
+    /**
+     * Gets a far plane distance that keeps the whole scene visible from the camera path
+     */
+    float getViewDistance(const Scene& scene);
+
+} // namespace SceneGenerator
+} // namespace VulkanGameEngine
@@ -0,0 +1,112 @@
+#pragma once
+
+#include "Common.h"
+#include <glm/gtc/quaternion.hpp>
+#include <string>
+#include <vector>
+
+namespace VulkanGameEngine {
+
+/**
+ * Transform of a joint relative to its parent
+ */
+struct JointTransform {
+    glm::quat rotation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+    glm::vec3 translation = glm::vec3(0.0f);
+    glm::vec3 scale = glm::vec3(1.0f);
+
+    /**
+     * Gets the matrix applying scale, then rotation, then translation
+     */
+    glm::mat4 toMatrix() const;
+};
+
+/**
+ * Skeleton is the joint hierarchy that animation clips drive and skinned
+ * meshes are bound to.
+ *
+ * Joints are stored parents first: every joint's parent has a lower index,
+ * so a single pass in index order sees each parent before its children
+ * (AnimationPose::localToModel relies on this). The bind pose is the pose
+ * the mesh was modelled in, as local transforms; the inverse bind matrices
+ * take model-space positions into each joint's space in that pose.
+ *
+ * File layout (*.vgeskel, little-endian):
+ *
+ *   char[8] magic "VGESKEL1", uint32 version, uint32 jointCount
+ *   uint16[jointCount]                  parents (NO_PARENT for roots)
+ *   float[jointCount][10]               bind pose: rotation x, y, z, w,
+ *                                       translation, scale
+ *   float[jointCount][16]               inverse bind matrices, column-major
+ *   per joint: uint16 length, char[length] name
+ */
+struct Skeleton {
+    static constexpr char MAGIC[8] = {'V', 'G', 'E', 'S', 'K', 'E', 'L', '1'};
+    static constexpr uint32_t VERSION = 1;
+    static constexpr const char* EXTENSION = ".vgeskel";
+    static constexpr uint16_t NO_PARENT = 0xFFFF;
+    static constexpr uint32_t MAX_JOINTS = 1024;
+
+    std::vector<std::string> jointNames;
+    std::vector<uint16_t> parents;
+    std::vector<JointTransform> bindPose;
+    std::vector<glm::mat4> inverseBindMatrices;
+
+    /**
+     * Appends a joint (its parent must already exist) and returns its index.
+     * Call computeInverseBindMatrices() once every joint is added.
+     */
+    uint16_t addJoint(const std::string& name, uint16_t parent, const JointTransform& bindTransform);
+
+    /**
+     * Derives the inverse bind matrices from the bind pose
+     */
+    void computeInverseBindMatrices();
+
+    /**
+     * Checks the hierarchy and array sizes
+     *
+     * @param error Set to the reason on failure
+     */
+    bool validate(std::string& error) const;
+
+    /**
+     * Finds a joint by name (-1 if there is none)
+     */
+    int32_t findJoint(const std::string& name) const;
+
+    uint32_t getJointCount() const { return static_cast<uint32_t>(parents.size()); }
+
+    /**
+     * Gets the number of 4-joint blocks a SoA pose of this skeleton has
+     */
+    uint32_t getSoaCount() const { return (getJointCount() + 3) / 4; }
+
+    /**
+     * Appends the file image of the skeleton to data
+     */
+    void serialize(std::vector<char>& data) const;
+
+    /**
+     * Reads a file image written by serialize(), validating the hierarchy
+     *
+     * @param error Set to the reason on failure
+     */
+    static bool deserialize(const std::vector<char>& data, Skeleton& skeleton, std::string& error);
+
+    /**
+     * Writes the skeleton to a file
+     *
+     * @return false (after logging) if the file cannot be written
+     */
+    bool save(const std::string& path) const;
+
+    /**
+     * Reads a skeleton through AssetFileSystem (mounted archives, then loose files)
+     *
+     * @param error Set to the reason on failure
+     */
+    static bool load(const std::string& path, Skeleton& skeleton, std::string& error);
+};
+
+} // namespace VulkanGameEngine
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <thread>
+#include <vector>
+
+namespace VulkanGameEngine {
+
+class ThreadPool;
+
+/**
+ * StartupGraph runs initialization as a dependency graph so that independent
+ * phases overlap: file reads and parsing run on worker threads while the
+ * main thread creates the window and the Vulkan device.
+ *
+ * Each phase declares the phases it needs. Phases that touch SDL or create
+ * GPU objects are pinned to the main thread (the thread calling run());
+ * the others go to a ThreadPool as soon as their dependencies finish. Every
+ * phase is timed and recorded as a profiler zone on the thread that ran it,
+ * so startup happens in profiler frame 0 and exporting that frame
+ * (Profiler::exportChromeTrace(path, 0, 0)) gives the startup timeline.
+ *
+ * Usage:
+ *   StartupGraph graph;
+ *   auto shaders = graph.add("ReadShaders", [&] { ... });
+ *   auto device = graph.add("CreateDevice", [&] { ... }, {}, StartupGraph::Affinity::MAIN_THREAD);
+ *   graph.add("CreatePipeline", [&] { ... }, {shaders, device}, StartupGraph::Affinity::MAIN_THREAD);
+ *   graph.run(ThreadPool::getInstance());
+ */
+class StartupGraph {
+public:
+    using PhaseId = uint32_t;
+
+    /**
+     * Where a phase may run
+     */
+    enum class Affinity {
+        ANY_THREAD,     // CPU-only work, runs on a pool worker
+        MAIN_THREAD     // SDL and GPU object creation
+    };
+
+    /**
+     * Timing of one phase
+     */
+    struct Phase {
+        const char* name;                   // Static storage (used as the profiler zone name)
+        std::function<void()> work;
+        std::vector<PhaseId> dependencies;
+        Affinity affinity;
+        bool ran = false;                   // False if skipped because a dependency failed
+        int64_t startNs = 0;
+        int64_t endNs = 0;
+        std::thread::id thread;
+    };
+
+    /**
+     * Adds a phase. Dependencies must have been added before it.
+     *
+     * @param name Phase name with static storage (string literal)
+     * @param work Work to run; throwing fails the startup
+     * @param dependencies Phases that must finish first
+     * @param affinity Thread the phase must run on
+     * @return Id to use as a dependency of later phases
+     */
+    PhaseId add(const char* name, std::function<void()> work, std::vector<PhaseId> dependencies = {},
+                Affinity affinity = Affinity::ANY_THREAD);
+
+    /**
+     * Runs every phase and returns when all have finished. If a phase throws,
+     * phases depending on it are skipped, the phases already running are
+     * waited for, and the first exception is rethrown.
+     *
+     * @param pool Pool that runs ANY_THREAD phases
+     */
+    void run(ThreadPool& pool);
+
+    /**
+     * Gets the phases in the order they were added, with their timings after run()
+     */
+    const std::vector<Phase>& getPhases() const { return m_phases; }
+
+    /**
+     * Gets the time from the start of run() to the end of the last phase
+     */
+    int64_t getWallTimeNs() const { return m_endNs - m_startNs; }
+
+    /**
+     * Gets the summed duration of the longest dependency chain: the startup
+     * time no amount of extra threads can remove
+     */
+    int64_t getCriticalPathNs() const;
+
+    /**
+     * Logs one line per phase (start, duration, thread) plus the wall time,
+     * the summed phase time and the critical path
+     */
+    void logSummary() const;
+
+private:
+    std::vector<Phase> m_phases;
+    std::thread::id m_mainThread;           // Thread that called run()
+    int64_t m_startNs = 0;
+    int64_t m_endNs = 0;
+
+    /**
+     * Maps each thread that ran a phase to a small index (0 = main thread)
+     */
+    std::vector<std::thread::id> getThreads() const;
+};
+
+} // namespace VulkanGameEngine
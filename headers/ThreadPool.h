@@ -0,0 +1,85 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace VulkanGameEngine {
+
+/**
+ * ThreadPool runs CPU work on a fixed set of worker threads.
+ *
+ * Tasks are plain callables taken from one FIFO queue. parallelFor splits an
+ * index range into chunks that the workers and the calling thread take in
+ * turn; because the caller works through the chunks itself, nested
+ * parallelFor calls from inside a task cannot deadlock.
+ *
+ * Workers are named "Worker N" in profiler traces. The shared instance
+ * (getInstance) starts its threads on first use.
+ *
+ * Usage:
+ *   ThreadPool::getInstance().submit([] { parseFile(); });
+ *   ThreadPool::getInstance().parallelFor(triangleCount, 4096, [&](size_t begin, size_t end) { ... });
+ */
+class ThreadPool {
+public:
+    /**
+     * Gets the shared pool (one worker per hardware thread, minus the main thread; at least one)
+     */
+    static ThreadPool& getInstance();
+
+    /**
+     * Starts a pool with its own worker threads
+     *
+     * @param threadCount Number of workers (0 is raised to 1)
+     */
+    explicit ThreadPool(uint32_t threadCount);
+
+    /**
+     * Finishes the queued tasks, then joins the workers
+     */
+    ~ThreadPool();
+
+    // Non-copyable
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * Gets the number of worker threads
+     */
+    uint32_t getThreadCount() const { return static_cast<uint32_t>(m_workers.size()); }
+
+    /**
+     * Queues a task for the workers. Exceptions thrown by the task are logged
+     * and dropped, so tasks that can fail should report through their own state.
+     */
+    void submit(std::function<void()> task);
+
+    /**
+     * Calls body(begin, end) for consecutive chunks of [0, count) on the
+     * workers and the calling thread, and returns once every chunk is done.
+     * The first exception thrown by body is rethrown here (remaining chunks
+     * are skipped).
+     *
+     * @param count Number of items
+     * @param grainSize Items per chunk (0 = split evenly across all threads)
+     * @param body Called once per chunk, possibly concurrently
+     */
+    void parallelFor(size_t count, size_t grainSize, const std::function<void(size_t begin, size_t end)>& body);
+
+private:
+    std::vector<std::thread> m_workers;
+    std::mutex m_mutex;
+    std::condition_variable m_wakeup;
+    std::deque<std::function<void()>> m_tasks;
+    bool m_stopping;
+
+    void workerMain(uint32_t index);
+};
+
+} // namespace VulkanGameEngine
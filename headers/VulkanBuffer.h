@@ -35,6 +35,7 @@ public:
         INDEX_BUFFER,       // Stores index data for indexed drawing
         UNIFORM_BUFFER,     // Stores uniform data (matrices, parameters)
         STAGING_BUFFER,     // Temporary buffer for data transfer
+        READBACK_BUFFER,    // Destination for GPU-to-CPU copies
         STORAGE_BUFFER      // General storage for compute shaders
     };
 
@@ -349,6 +350,23 @@ namespace BufferUtils {
                                   VkCommandPool commandPool, VkQueue graphicsQueue,
                                   const std::vector<uint32_t>& indices);
 
+    /**
+     * Creates a device-local buffer and uploads raw bytes to it through a
+     * staging buffer (the untyped form of createVertexBuffer/createIndexBuffer).
+     * 
+     * @param device Logical device
+     * @param physicalDevice Physical device
+     * @param commandPool Command pool for data transfer
+     * @param graphicsQueue Queue for command submission
+     * @param data Bytes to upload
+     * @param size Number of bytes
+     * @param usage Buffer usage (vertex, index, storage)
+     * @return Device-local VulkanBuffer holding the data
+     */
+    VulkanBuffer createDeviceLocalBuffer(VkDevice device, VkPhysicalDevice physicalDevice,
+                                        VkCommandPool commandPool, VkQueue graphicsQueue,
+                                        const void* data, VkDeviceSize size, VulkanBuffer::Usage usage);
+
     /**
      * Creates a uniform buffer for transformation matrices.
      * 
@@ -394,6 +412,9 @@ namespace VertexBufferManager {
 
     /**
      * Updates vertex buffer data efficiently based on buffer type.
+     * Device-local buffers wait for the queue to go idle, so this is for
+     * tools and loading; geometry that changes every frame belongs in a
+     * DynamicMesh.
      */
     void updateVertexBuffer(VulkanBuffer& vertexBuffer,
                            VkDevice device, VkPhysicalDevice physicalDevice,
@@ -0,0 +1,193 @@
+#pragma once
+
+#include <cstdint>
+
+namespace VulkanGameEngine {
+
+/**
+ * Vulkan entry points counted by VulkanCallStats
+ */
+enum class VulkanCall : uint32_t {
+    // Recording
+    CmdBeginRenderPass,
+    CmdEndRenderPass,
+    CmdBindPipeline,
+    CmdBindVertexBuffers,
+    CmdBindIndexBuffer,
+    CmdBindDescriptorSets,
+    CmdPushConstants,
+    CmdSetViewport,
+    CmdSetScissor,
+    CmdDraw,
+    CmdDrawIndexed,
+    CmdPipelineBarrier,
+    CmdCopyBuffer,
+    CmdCopyImageToBuffer,
+    CmdWriteTimestamp,
+    CmdResetQueryPool,
+    CmdBeginQuery,
+    CmdEndQuery,
+    BeginCommandBuffer,
+    EndCommandBuffer,
+    ResetCommandBuffer,
+
+    // Queue and synchronization
+    QueueSubmit,
+    QueuePresent,
+    AcquireNextImage,
+    WaitForFences,
+    ResetFences,
+    GetQueryPoolResults,
+    QueueWaitIdle,
+    DeviceWaitIdle,
+
+    // Memory
+    MapMemory,
+    UnmapMemory,
+    FlushMappedMemoryRanges,
+    InvalidateMappedMemoryRanges,
+    UpdateDescriptorSets,
+
+    // Object lifetime
+    AllocateMemory,
+    FreeMemory,
+    CreateBuffer,
+    DestroyBuffer,
+    AllocateCommandBuffers,
+    FreeCommandBuffers,
+
+    COUNT
+};
+
+/**
+ * VulkanCallStats counts how often each Vulkan entry point is called per
+ * frame and how much CPU time those calls take.
+ *
+ * The engine's Vulkan helpers (VulkanCommandPool, VulkanSynchronization,
+ * VulkanBuffer, GpuProfiler) route their calls through VK_TRACKED, so every
+ * frame's draws, binds, barriers, submits, maps and allocations are visible
+ * without a validation layer.
+ *
+ * Some entry points never belong in the frame loop: queue/device wait-idle
+ * stall the CPU until the GPU drains, and memory/buffer/command buffer
+ * allocation is slow and unbounded. When one of these runs inside a
+ * VK_FRAME_SCOPE it is counted as a hazard and reported at the end of the
+ * frame (or aborts the process when setAbortOnHazard is on). Code that
+ * legitimately does this, like swapchain recreation, opts out with
+ * VK_ALLOW_HAZARDS.
+ */
+class VulkanCallStats {
+public:
+    /**
+     * Per-entry-point numbers of one frame
+     */
+    struct FrameCounts {
+        uint32_t calls[static_cast<uint32_t>(VulkanCall::COUNT)] = {};
+        uint64_t timeNs[static_cast<uint32_t>(VulkanCall::COUNT)] = {};
+        uint32_t totalCalls = 0;
+        uint64_t totalTimeNs = 0;
+        uint32_t drawCalls = 0;
+        uint32_t hazards = 0;              // Stalling or allocating calls made inside the frame scope
+    };
+
+    /**
+     * Gets the vkXxx name of an entry point
+     */
+    static const char* getName(VulkanCall call);
+
+    /**
+     * Checks if a call stalls or allocates and therefore must not run in the frame loop
+     */
+    static bool isFrameHazard(VulkanCall call);
+
+    /**
+     * Records one call (use VK_TRACKED instead of calling directly)
+     */
+    static void record(VulkanCall call, int64_t durationNs);
+
+    /**
+     * Enters or leaves the steady-state frame loop on the calling thread
+     */
+    static void beginFrameScope();
+    static void endFrameScope();
+
+    /**
+     * Temporarily leaves the frame scope (see VK_ALLOW_HAZARDS)
+     *
+     * @return Depth to hand back to resumeFrameScope
+     */
+    static uint32_t suspendFrameScope();
+    static void resumeFrameScope(uint32_t depth);
+
+    /**
+     * Aborts the process on the first hazard inside the frame scope (for automated runs)
+     */
+    static void setAbortOnHazard(bool abortOnHazard);
+
+    /**
+     * Closes the current frame: stores its counts, publishes them to the
+     * metrics registry ("vk.calls", "vk.cpu_us", "vk.hazards", "vk.<name>")
+     * and warns the first time each hazard shows up. Call once per frame from the main thread.
+     */
+    static void endFrame();
+
+    /**
+     * Gets the counts of the last completed frame
+     */
+    static const FrameCounts& getLastFrame();
+};
+
+/**
+ * RAII helper that times one Vulkan call
+ */
+class VulkanCallScope {
+public:
+    explicit VulkanCallScope(VulkanCall call);
+    ~VulkanCallScope();
+
+    VulkanCallScope(const VulkanCallScope&) = delete;
+    VulkanCallScope& operator=(const VulkanCallScope&) = delete;
+
+private:
+    VulkanCall m_call;
+    int64_t m_start;
+};
+
+/**
+ * RAII helper marking the enclosing scope as the steady-state frame loop
+ */
+class VulkanFrameScope {
+public:
+    VulkanFrameScope() { VulkanCallStats::beginFrameScope(); }
+    ~VulkanFrameScope() { VulkanCallStats::endFrameScope(); }
+
+    VulkanFrameScope(const VulkanFrameScope&) = delete;
+    VulkanFrameScope& operator=(const VulkanFrameScope&) = delete;
+};
+
+/**
+ * RAII helper that allows hazard calls in the enclosing scope
+ */
+class VulkanAllowHazardsScope {
+public:
+    VulkanAllowHazardsScope() : m_depth(VulkanCallStats::suspendFrameScope()) {}
+    ~VulkanAllowHazardsScope() { VulkanCallStats::resumeFrameScope(m_depth); }
+
+    VulkanAllowHazardsScope(const VulkanAllowHazardsScope&) = delete;
+    VulkanAllowHazardsScope& operator=(const VulkanAllowHazardsScope&) = delete;
+
+private:
+    uint32_t m_depth;
+};
+
+} // namespace VulkanGameEngine
+
+// Counts and times a Vulkan call; evaluates to the call's result.
+// The temporary scope lives until the end of the full expression.
+#define VK_TRACKED(name, call) \
+    (VulkanGameEngine::VulkanCallScope(VulkanGameEngine::VulkanCall::name), (call))
+
+#define VK_CALLSTATS_CONCAT_INNER(a, b) a##b
+#define VK_CALLSTATS_CONCAT(a, b) VK_CALLSTATS_CONCAT_INNER(a, b)
+#define VK_FRAME_SCOPE() VulkanGameEngine::VulkanFrameScope VK_CALLSTATS_CONCAT(_vkFrameScope, __LINE__)
+#define VK_ALLOW_HAZARDS() VulkanGameEngine::VulkanAllowHazardsScope VK_CALLSTATS_CONCAT(_vkAllowHazards, __LINE__)
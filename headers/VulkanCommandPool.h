@@ -186,6 +186,20 @@ public:
                         VkFramebuffer framebuffer, VkRect2D renderArea,
                         const std::vector<VkClearValue>& clearValues);
 
+    /**
+     * Records a render pass begin from a plain array of clear values (no heap allocation).
+     * 
+     * @param commandBuffer Command buffer to record into
+     * @param renderPass Render pass to begin
+     * @param framebuffer Framebuffer to render into
+     * @param renderArea Area of the framebuffer to render to
+     * @param clearValues Clear values for attachments
+     * @param clearValueCount Number of clear values
+     */
+    void beginRenderPass(VkCommandBuffer commandBuffer, VkRenderPass renderPass,
+                        VkFramebuffer framebuffer, VkRect2D renderArea,
+                        const VkClearValue* clearValues, uint32_t clearValueCount);
+
     /**
      * Records the end of a render pass.
      * 
@@ -215,6 +229,18 @@ public:
                           const std::vector<VkBuffer>& buffers,
                           const std::vector<VkDeviceSize>& offsets);
 
+    /**
+     * Records vertex buffer binding commands from plain arrays (no heap allocation).
+     * 
+     * @param commandBuffer Command buffer to record into
+     * @param firstBinding First vertex input binding
+     * @param bindingCount Number of buffers and offsets
+     * @param buffers Vertex buffers to bind
+     * @param offsets Byte offsets into each buffer
+     */
+    void bindVertexBuffers(VkCommandBuffer commandBuffer, uint32_t firstBinding, uint32_t bindingCount,
+                          const VkBuffer* buffers, const VkDeviceSize* offsets);
+
     /**
      * Records an index buffer binding command.
      * 
@@ -239,6 +265,19 @@ public:
                            uint32_t firstSet, const std::vector<VkDescriptorSet>& descriptorSets,
                            const std::vector<uint32_t>& dynamicOffsets = {});
 
+    /**
+     * Records descriptor set binding commands from a plain array (no heap allocation).
+     * 
+     * @param commandBuffer Command buffer to record into
+     * @param pipelineLayout Pipeline layout that defines the descriptor sets
+     * @param firstSet Index of the first descriptor set
+     * @param descriptorSetCount Number of descriptor sets
+     * @param descriptorSets Descriptor sets to bind
+     */
+    void bindDescriptorSets(VkCommandBuffer commandBuffer, VkPipelineLayout pipelineLayout,
+                           uint32_t firstSet, uint32_t descriptorSetCount,
+                           const VkDescriptorSet* descriptorSets);
+
     /**
      * Records a draw command for non-indexed geometry.
      * 
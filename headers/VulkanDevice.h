@@ -103,8 +103,13 @@ public:
      * 4. Creates a logical device with required features and extensions
      * 5. Retrieves queue handles for graphics and presentation
      * 
+     * Passing VK_NULL_HANDLE as the surface selects a headless device: presentation
+     * support and the swapchain extension are not required, and the present queue
+     * aliases the graphics queue. This lets CPU implementations such as lavapipe
+     * qualify when rendering offscreen.
+     * 
      * @param instance The Vulkan instance to enumerate devices from
-     * @param surface The window surface we need to present to
+     * @param surface The window surface we need to present to, or VK_NULL_HANDLE for headless
      */
     void create(VkInstance instance, VkSurfaceKHR surface);
 
@@ -127,9 +132,13 @@ public:
     // Queue family information
     const QueueFamilyIndices& getQueueFamilyIndices() const { return m_queueFamilyIndices; }
     
+    // True if the device was created without a surface (no presentation)
+    bool isHeadless() const { return m_headless; }
+    
     // Device properties and features
     const VkPhysicalDeviceProperties& getDeviceProperties() const { return m_deviceProperties; }
     const VkPhysicalDeviceFeatures& getDeviceFeatures() const { return m_deviceFeatures; }
+    const VkPhysicalDeviceFeatures& getEnabledFeatures() const { return m_enabledFeatures; }
     const VkPhysicalDeviceMemoryProperties& getMemoryProperties() const { return m_memoryProperties; }
     
     // Swapchain support information
@@ -152,12 +161,14 @@ private:
     // Device properties and capabilities
     VkPhysicalDeviceProperties m_deviceProperties;      // Basic device info (name, type, limits)
     VkPhysicalDeviceFeatures m_deviceFeatures;          // Optional features (geometry shaders, etc.)
+    VkPhysicalDeviceFeatures m_enabledFeatures{};       // Features actually enabled on the logical device
     VkPhysicalDeviceMemoryProperties m_memoryProperties; // Memory types and heaps available
     
-    // Required device extensions
-    const std::vector<const char*> m_deviceExtensions = {
+    // Required device extensions (set by create(); empty when headless)
+    std::vector<const char*> m_deviceExtensions = {
         VK_KHR_SWAPCHAIN_EXTENSION_NAME  // Required for presenting images to screen
     };
+    bool m_headless = false;            // Created without a surface
 
     /**
      * Enumerates and selects the best physical device.
@@ -209,6 +220,8 @@ private:
      * - Has adequate swapchain support
      * - Supports required features
      * 
+     * Without a surface only the graphics queue family is required.
+     * 
      * @param device Physical device to check
      * @param surface Surface to check presentation support against
      * @return true if device is suitable, false otherwise
@@ -1,18 +1,19 @@
 #pragma once
 
 #include "Common.h"
-#include "VulkanInstance.h"
-#include "VulkanDevice.h"
-#include "VulkanSwapchain.h"
-#include "VulkanRenderPass.h"
-#include "VulkanPipeline.h"
-#include "VulkanBuffer.h"
-#include "VulkanCommandPool.h"
-#include "VulkanSynchronization.h"
+#include "RenderBackend.h"
+#include "Metrics.h"
 #include "MainCharacter.h"
+#include "Scene.h"
+#include "FrameRecorder.h"
+#include "StartupGraph.h"
+#include <functional>
+#include <memory>
 
 namespace VulkanGameEngine {
 
+class CaptureRenderBackend;
+
 /**
  * VulkanEngine is the main orchestrator class that manages the entire Vulkan rendering pipeline.
  * 
@@ -29,28 +30,14 @@ namespace VulkanGameEngine {
  * 
  * The engine follows a modular design where each major Vulkan concept is encapsulated
  * in its own class, making the codebase maintainable and educational.
+ * 
+ * All GPU objects live in a RenderBackend beneath the engine. The engine keeps
+ * the scene and records each frame into a CommandList; VulkanRenderBackend
+ * executes it, NullRenderBackend discards it so the engine's CPU cost can be
+ * measured without a Vulkan driver.
  */
 class VulkanEngine {
 public:
-    /**
-     * Engine initialization state for error handling and debugging
-     */
-    enum class InitializationState {
-        NOT_INITIALIZED,
-        INSTANCE_CREATED,
-        SURFACE_CREATED,
-        DEVICE_CREATED,
-        SWAPCHAIN_CREATED,
-        RENDER_PASS_CREATED,
-        PIPELINE_CREATED,
-        DESCRIPTORS_CREATED,  // Added descriptor set state
-        BUFFERS_CREATED,
-        COMMAND_POOL_CREATED,
-        SYNCHRONIZATION_CREATED,
-        CHARACTER_LOADED,
-        FULLY_INITIALIZED
-    };
-
     /**
      * Constructor - initializes engine to safe defaults
      */
@@ -64,17 +51,13 @@ public:
     /**
      * Initializes the entire Vulkan rendering system.
      * 
-     * This function performs the complete Vulkan initialization sequence:
-     * 1. Create Vulkan instance with validation layers
-     * 2. Create window surface for rendering
-     * 3. Select and create logical device
-     * 4. Create swapchain for presentation
-     * 5. Create render pass for rendering operations
-     * 6. Create graphics pipeline
-     * 7. Create vertex and uniform buffers
-     * 8. Create command pool and allocate command buffers
-     * 9. Create synchronization objects
-     * 10. Load main character model
+     * This function performs the complete initialization sequence:
+     * 1. Initialize the Vulkan backend (instance, surface, device, swapchain,
+     *    render pass, command buffers and synchronization; see VulkanRenderBackend)
+     * 2. Create graphics pipeline
+     * 3. Create vertex and uniform buffers
+     * 4. Load main character model
+     * 5. Set up the scene
      * 
      * Each step is carefully ordered to respect Vulkan's dependency requirements.
      * 
@@ -84,16 +67,62 @@ public:
      */
     void initialize(SDL_Window* window, uint32_t windowWidth, uint32_t windowHeight);
 
+    /**
+     * Initializes the engine for offscreen rendering without a window.
+     * 
+     * Same sequence as initialize(), except that no surface or swapchain is
+     * created: frames are rendered into VulkanOffscreenTarget images, nothing is
+     * presented, and device selection does not require presentation support.
+     * Works with software implementations such as lavapipe, for benchmarks and
+     * golden-image checks on machines without a GPU or display.
+     * 
+     * With BackendType::NULL_BACKEND no Vulkan call is made at all: the full
+     * frame (scene update, uniform packing, command recording, submission
+     * bookkeeping) runs against a backend that discards it, which isolates the
+     * engine's own CPU cost and works on machines without a Vulkan driver.
+     * 
+     * @param width Width of the offscreen images
+     * @param height Height of the offscreen images
+     * @param backend Backend to render with
+     */
+    void initializeHeadless(uint32_t width, uint32_t height, BackendType backend = BackendType::VULKAN);
+
+    /**
+     * Adds the initialization sequence to a startup graph instead of running
+     * it, so the application can overlap it with its own startup work.
+     * Reading the SPIR-V and parsing the character OBJ start immediately on
+     * worker threads; the backend waits for windowPhases, and the phases that
+     * create GPU objects follow it on the main thread. Run the graph with
+     * runStartup().
+     * 
+     * @param graph Graph to add the phases to
+     * @param window Window to render to, read when the backend phase runs (null = headless)
+     * @param windowPhases Phases that must finish before the backend is created
+     * @param width Width of the window or offscreen images
+     * @param height Height of the window or offscreen images
+     * @param backend Backend to render with
+     * @return Phase after which the engine is ready to render
+     */
+    StartupGraph::PhaseId addStartupPhases(StartupGraph& graph, SDL_Window* const& window,
+                                           std::vector<StartupGraph::PhaseId> windowPhases,
+                                           uint32_t width, uint32_t height, BackendType backend);
+
+    /**
+     * Runs a startup graph holding the engine's phases on the shared
+     * ThreadPool and logs its timeline. If any phase fails, whatever the
+     * engine created is released and the exception is rethrown.
+     */
+    void runStartup(StartupGraph& graph);
+
     /**
      * Renders a single frame.
      * 
      * This function implements the standard Vulkan rendering loop:
-     * 1. Wait for previous frame to complete
-     * 2. Acquire next swapchain image
-     * 3. Record command buffer with rendering commands
-     * 4. Update uniform buffers with current transformation matrices
-     * 5. Submit command buffer to graphics queue
-     * 6. Present rendered image to screen
+     * 1. Wait for previous frame to complete and acquire the next image (backend)
+     * 2. Update the scene and upload uniform buffers with current transformation matrices
+     * 3. Record the frame's command list and let the backend translate it
+     * 4. Submit the frame to the graphics queue
+     * 5. Present rendered image to screen
      * 
      * The function handles synchronization between CPU and GPU to ensure
      * smooth rendering without artifacts or crashes.
@@ -133,6 +162,112 @@ public:
      */
     void getFrameStats(float& fps, float& frameTime) const;
 
+    /**
+     * Detailed timing of the most recent frame, combining CPU and GPU measurements
+     */
+    struct FrameStats {
+        float fps = 0.0f;
+        float cpuFrameTimeMs = 0.0f;        // Whole render() call
+        uint32_t commandCount = 0;          // Commands in the frame's command list
+        uint32_t recordedDraws = 0;         // Draws in the frame's command list (any backend)
+        uint64_t recordedTriangles = 0;     // Triangles those draws cover
+        float fenceWaitMs = 0.0f;           // Time spent blocked on the frame fence
+        bool gpuTimeValid = false;          // False until GPU timestamps have been read back
+        float gpuTimeMs = 0.0f;             // First to last GPU timestamp of the latest completed frame
+        bool gpuBound = false;              // CPU mostly waited on the GPU this frame
+        bool hasPipelineStatistics = false;
+        GpuProfiler::PipelineStatistics pipelineStatistics;
+        uint32_t vulkanCalls = 0;           // Vulkan calls made by the engine's helpers last frame
+        uint32_t drawCalls = 0;
+        float vulkanCpuMs = 0.0f;           // CPU time spent inside those calls
+        uint32_t vulkanHazards = 0;         // Stalling/allocating calls made inside the frame loop
+    };
+
+    /**
+     * Gets detailed frame statistics including GPU time.
+     *
+     * A frame is reported as GPU-bound when the CPU spent more than half of
+     * its frame time waiting for the previous use of its fence.
+     *
+     * @param stats Output structure to fill
+     */
+    void getFrameStats(FrameStats& stats) const;
+
+    /**
+     * Reads back the most recently rendered frame (headless Vulkan only).
+     * 
+     * Waits for the device to go idle, so call it outside the frame loop.
+     * 
+     * @param pixels Output: width * height RGBA8 pixels, top row first
+     * @param width Output: image width
+     * @param height Output: image height
+     */
+    void readbackFrame(std::vector<uint8_t>& pixels, uint32_t& width, uint32_t& height);
+
+    /**
+     * Writes the most recently rendered frame to a PPM file (headless Vulkan only)
+     * 
+     * @param path Output file path
+     */
+    void saveFrame(const std::string& path);
+
+    /**
+     * Wraps the backend in a CaptureRenderBackend so frames can be captured
+     * for framereplay. Call before initialize(); costs a copy of every buffer
+     * update while enabled.
+     */
+    void enableFrameCapture() { m_frameCaptureEnabled = true; }
+
+    /**
+     * Saves the next rendered frame's workload as a FrameCapture.
+     * Throws if enableFrameCapture() was not called before initialization.
+     * 
+     * @param path Output file path (*.vgecap)
+     */
+    void captureNextFrame(const std::string& path);
+
+    /**
+     * Starts writing rendered frames to disk (see FrameRecorder). Readbacks
+     * run asynchronously, so recording does not stall the frame loop.
+     * Throws if the output cannot be created.
+     */
+    void startRecording(const FrameRecorder::Config& config);
+
+    /**
+     * Writes the frames still in flight and stops recording (waits for the GPU)
+     */
+    void stopRecording() { m_recorder.stop(); }
+
+    /**
+     * Starts hot reload: when an OBJ file in assets/ (or the cooked mesh
+     * next to it) or a SPIR-V file in shaders/ changes on disk, only the
+     * changed mesh or pipeline is loaded again, on a worker thread, and
+     * swapped in between two frames. The replaced buffers and pipelines are
+     * freed once the frames still using them have finished; nothing waits
+     * for the device to go idle. Call after initialization.
+     * 
+     * @return false if neither directory can be watched
+     */
+    bool enableHotReload();
+
+    /**
+     * Gets the frame counts of the current or last recording
+     */
+    FrameRecorder::Stats getRecordingStats() const { return m_recorder.getStats(); }
+
+    /**
+     * Advances the scene by a fixed amount per frame instead of the measured
+     * frame time, so headless runs are reproducible (0 restores real time).
+     * 
+     * @param seconds Simulated time per frame
+     */
+    void setFixedTimeStep(float seconds) { m_fixedTimeStep = seconds; }
+
+    /**
+     * Gets per-pass GPU timings of the last completed frame (invalid on the null backend)
+     */
+    const GpuProfiler::FrameResults& getGpuResults() const { return m_backend->getGpuResults(); }
+
     /**
      * Updates the 3D scene for the current frame.
      * 
@@ -152,6 +287,23 @@ public:
      */
     void moveCamera(float forward, float right, float deltaTime);
 
+    /**
+     * Places the camera directly (scripted camera paths, benchmark replay).
+     * 
+     * @param position Camera position in world space
+     * @param target Point the camera looks at
+     */
+    void setCamera(const glm::vec3& position, const glm::vec3& target);
+    const glm::vec3& getCameraPosition() const { return m_cameraPosition; }
+    const glm::vec3& getCameraTarget() const { return m_cameraTarget; }
+
+    /**
+     * Sets the far clipping plane, for scenes larger than the default 50 units
+     * 
+     * @param distance Far plane distance from the camera
+     */
+    void setViewDistance(float distance);
+
     /**
      * Waits for all GPU operations to complete.
      * 
@@ -176,18 +328,21 @@ public:
     MainCharacter& getMainCharacter() { return m_mainCharacter; }
     const MainCharacter& getMainCharacter() const { return m_mainCharacter; }
 
+    /**
+     * Gets the scene. While it holds objects they are drawn instead of the
+     * main character; meshes are uploaded with getBackend().
+     */
+    Scene& getScene() { return m_scene; }
+    const Scene& getScene() const { return m_scene; }
+
     // Getters for engine state and components
-    InitializationState getInitializationState() const { return m_initState; }
-    bool isInitialized() const { return m_initState == InitializationState::FULLY_INITIALIZED; }
+    bool isInitialized() const { return m_initialized; }
+    bool isHeadless() const { return m_headless; }
+    BackendType getBackendType() const { return m_backendType; }
     
-    // Component access (for advanced usage)
-    const VulkanInstance& getInstance() const { return m_instance; }
-    const VulkanDevice& getDevice() const { return m_device; }
-    const VulkanSwapchain& getSwapchain() const { return m_swapchain; }
-    const VulkanRenderPass& getRenderPass() const { return m_renderPass; }
-    const VulkanPipeline& getPipeline() const { return m_pipeline; }
-    const VulkanCommandPool& getCommandPool() const { return m_commandPool; }
-    const VulkanSynchronization& getSynchronization() const { return m_synchronization; }
+    // Backend access (for advanced usage)
+    RenderBackend& getBackend() { return *m_backend; }
+    const RenderBackend& getBackend() const { return *m_backend; }
 
     // Frame statistics
     uint64_t getFrameCount() const { return m_frameCount; }
@@ -195,42 +350,34 @@ public:
     float getLastFrameTime() const { return m_lastFrameTime; }
 
 private:
-    // Vulkan components (in initialization order)
-    VulkanInstance m_instance;              // Vulkan instance and validation layers
-    VulkanDevice m_device;                  // Physical and logical device management
-    VulkanSwapchain m_swapchain;            // Swapchain for presentation
-    VulkanRenderPass m_renderPass;          // Render pass configuration
-    VulkanPipeline m_pipeline;              // Graphics pipeline
-    VulkanCommandPool m_commandPool;        // Command buffer management
-    VulkanSynchronization m_synchronization; // Synchronization objects
-    
-    // Vulkan handles that need direct access
-    VkSurfaceKHR m_surface;                 // Window surface for rendering
+    // Rendering backend (owns every GPU object)
+    std::unique_ptr<RenderBackend> m_backend;
+    BackendType m_backendType;              // Backend selected at initialization
+    bool m_frameCaptureEnabled;             // Wrap the backend for frame capture at initialization
+    CaptureRenderBackend* m_captureBackend; // m_backend when capture is enabled, else null
+    FrameRecorder m_recorder;               // Writes frames to disk while recording
+    PipelineHandle m_pipeline;              // Graphics pipeline
+    PipelineDesc m_pipelineDesc;            // Its shaders, read ahead of the device during startup
     
     // Buffers for 3D rendering (fallback cube)
-    VulkanBuffer m_vertexBuffer;            // Vertex data buffer
-    VulkanBuffer m_indexBuffer;             // Index data buffer
-    std::vector<VulkanBuffer> m_uniformBuffers; // Uniform buffers (one per frame in flight)
-    
-    // Depth buffer for 3D rendering
-    VkImage m_depthImage;                   // Depth buffer image
-    VkDeviceMemory m_depthImageMemory;      // Depth buffer memory
-    VkImageView m_depthImageView;           // Depth buffer image view
-    
-    // Descriptor sets for uniform buffer binding
-    VkDescriptorPool m_descriptorPool;                // Pool for allocating descriptor sets
-    std::vector<VkDescriptorSet> m_descriptorSets;    // Descriptor sets (one per frame in flight)
+    BufferHandle m_vertexBuffer;            // Vertex data buffer
+    BufferHandle m_indexBuffer;             // Index data buffer
+    std::vector<BufferHandle> m_uniformBuffers; // Uniform buffers (one per frame in flight)
     
     // 3D Models
     MainCharacter m_mainCharacter;          // Main character model
     bool m_useMainCharacter;                // Whether to render main character or fallback cube
+    Scene m_scene;                          // Drawn instead of the character when not empty
     
-    // Command buffers for rendering
-    std::vector<VkCommandBuffer> m_commandBuffers; // Command buffers (one per frame in flight)
+    // Recorded once per frame and handed to the backend
+    CommandList m_commandList;
+    uint32_t m_recordedDraws;               // Draws in m_commandList
+    uint64_t m_recordedTriangles;           // Triangles those draws cover
     
     // Engine state
-    InitializationState m_initState;        // Current initialization state
+    bool m_initialized;                     // initialize()/initializeHeadless() completed
     SDL_Window* m_window;                   // SDL window handle
+    bool m_headless;                        // Rendering offscreen without a window
     uint32_t m_windowWidth;                 // Current window width
     uint32_t m_windowHeight;                // Current window height
     
@@ -238,97 +385,96 @@ private:
     uint32_t m_currentFrame;                // Current frame index (for frames in flight)
     uint64_t m_frameCount;                  // Total frames rendered
     float m_lastFrameTime;                  // Time taken for last frame (in seconds)
+    float m_lastFenceWaitTime;              // Time blocked on the frame fence (in seconds)
+    float m_fixedTimeStep;                  // Simulated seconds per frame (0 = use real frame time)
+    
+    /**
+     * Per-frame metrics, looked up once in initialize() so render() never touches the registry maps
+     */
+    struct FrameMetrics {
+        MetricHistogram* cpuUpdate = nullptr;       // updateScene + uniform upload
+        MetricHistogram* record = nullptr;          // Command list recording + backend translation
+        MetricHistogram* submit = nullptr;          // vkQueueSubmit
+        MetricHistogram* presentWait = nullptr;     // Fence wait + image acquire + present
+        MetricHistogram* gpuTime = nullptr;         // GPU timestamps of completed frames
+        MetricHistogram* uploadBytes = nullptr;     // Bytes uploaded to the GPU per frame
+        MetricCounter* uploadCounter = nullptr;     // Running total of uploaded bytes
+        uint64_t lastUploadTotal = 0;
+        uint64_t lastGpuFrame = 0;
+    };
+    FrameMetrics m_metrics;
     
     // Scene data
     float m_time;                           // Total elapsed time
     glm::mat4 m_modelMatrix;                // Model transformation matrix
     glm::mat4 m_viewMatrix;                 // View (camera) transformation matrix
     glm::mat4 m_projectionMatrix;           // Projection transformation matrix
+    float m_viewDistance;                   // Far clipping plane
     
     // Camera data
     glm::vec3 m_cameraPosition;             // Camera position in 3D space
     glm::vec3 m_cameraTarget;               // Point the camera is looking at
     float m_cameraSpeed;                    // Camera movement speed
+    
+    // Hot reload (defined in VulkanEngine.cpp)
+    struct HotReload;
+    std::unique_ptr<HotReload> m_hotReload; // Null unless enableHotReload() was called
 
     /**
-     * Creates the window surface for rendering.
-     * 
-     * The surface is the connection between Vulkan and the window system.
-     * SDL provides a cross-platform way to create Vulkan surfaces.
-     * 
-     * @param window SDL window to create surface for
-     */
-    void createSurface(SDL_Window* window);
-
-    /**
-     * Creates vertex and index buffers with test geometry.
-     * 
-     * This function creates buffers containing a simple 3D shape
-     * (like a triangle or cube) for testing the rendering pipeline.
+     * Creates and initializes the backend (a null window makes the Vulkan
+     * backend render offscreen)
      */
-    void createBuffers();
+    void createBackend(SDL_Window* window);
 
     /**
-     * Loads the main character model from OBJ file.
-     * 
-     * This function attempts to load the character model from
-     * assets/maincharacter.obj. If loading fails, falls back to cube.
+     * Reads the pipeline's SPIR-V into m_pipelineDesc (worker thread; leaves
+     * the code empty if the files cannot be read)
      */
-    void loadMainCharacter();
+    void readShaders();
 
     /**
-     * Creates uniform buffers for transformation matrices.
-     * 
-     * Uniform buffers store data that's constant for all vertices
-     * in a draw call, like transformation matrices.
+     * Logs the backend, size and content the engine was initialized with
      */
-    void createUniformBuffers();
+    void logInitializationSummary() const;
 
     /**
-     * Allocates command buffers for rendering.
+     * Creates vertex and index buffers with test geometry.
      * 
-     * Command buffers record the GPU commands that will be executed
-     * during rendering. We need one per frame in flight.
+     * This function creates buffers containing a simple 3D shape
+     * (like a triangle or cube) for testing the rendering pipeline.
      */
-    void createCommandBuffers();
+    void createBuffers();
 
     /**
-     * Creates depth buffer and depth image view.
-     * 
-     * This function creates the depth buffer image, allocates memory for it,
-     * and creates an image view for use in the render pass.
+     * Parses the main character model from assets/FinalBaseMesh.obj
+     * (CPU only, runs on a worker thread during startup).
      */
-    void createDepthBuffer();
+    void parseMainCharacter();
 
     /**
-     * Finds a suitable depth format supported by the device.
-     * 
-     * @return A depth format that supports depth buffering
+     * Uploads the parsed main character. If parsing or uploading failed,
+     * the engine falls back to the cube.
      */
-    VkFormat findDepthFormat();
+    void uploadMainCharacter();
 
     /**
-     * Finds a format from candidates that supports the given features.
+     * Creates uniform buffers for transformation matrices.
      * 
-     * @param candidates List of candidate formats to check
-     * @param tiling Image tiling mode required
-     * @param features Format features required
-     * @return A supported format, or throws if none found
+     * Uniform buffers store data that's constant for all vertices
+     * in a draw call, like transformation matrices.
      */
-    VkFormat findSupportedFormat(const std::vector<VkFormat>& candidates,
-                                VkImageTiling tiling, VkFormatFeatureFlags features);
+    void createUniformBuffers();
 
     /**
-     * Records rendering commands into a command buffer.
+     * Records the frame's rendering commands into a command list.
      * 
      * This function records the sequence of GPU commands needed
      * to render a frame, including setting up the render pass,
      * binding resources, and issuing draw calls.
      * 
-     * @param commandBuffer Command buffer to record into
-     * @param imageIndex Index of the swapchain image being rendered to
+     * @param commandList Command list to record into
      */
-    void recordCommandBuffer(VkCommandBuffer commandBuffer, uint32_t imageIndex);
+    void recordCommands(CommandList& commandList);
 
     /**
      * Updates uniform buffer data for the current frame.
@@ -341,44 +487,39 @@ private:
     void updateUniformBuffer(uint32_t currentImage);
 
     /**
-     * Recreates the swapchain and dependent resources.
-     * 
-     * This function is called when the swapchain becomes invalid
-     * (e.g., due to window resize) and needs to be recreated.
+     * Polls for changed files, starts their reloads and swaps in the reloads
+     * that have finished (main thread, at the start of a frame)
      */
-    void recreateSwapchain();
+    void updateHotReload();
 
     /**
-     * Sets up the initial 3D scene.
-     * 
-     * This function initializes the camera position, projection matrix,
-     * and other scene parameters.
+     * Runs load on a worker. The function it returns (if any) is called on
+     * the main thread at the next frame boundary to swap the result in.
      */
-    void setupScene();
+    void startHotReload(std::function<std::function<void()>()> load);
 
     /**
-     * Logs the current initialization state for debugging.
-     * 
-     * @param state The state to log
-     * @param operation Description of the operation
+     * Reloads the main character's mesh
      */
-    void logInitializationState(InitializationState state, const std::string& operation);
+    void reloadMainCharacter();
 
     /**
-     * Creates descriptor pool and allocates descriptor sets.
-     * 
-     * Descriptor pool manages memory for descriptor sets, and we allocate
-     * one descriptor set per frame in flight.
+     * Reads the pipeline's shaders again and rebuilds the pipeline
      */
-    void createDescriptorSets();
+    void reloadShaders();
 
     /**
-     * Updates descriptor sets to point to current uniform buffers.
+     * Waits for reloads still running on workers and stops watching
+     */
+    void stopHotReload();
+
+    /**
+     * Sets up the initial 3D scene.
      * 
-     * This function tells Vulkan which buffer resources each descriptor
-     * set should reference.
+     * This function initializes the camera position, projection matrix,
+     * and other scene parameters.
      */
-    void updateDescriptorSets();
+    void setupScene();
 };
 
-} // namespace VulkanGameEngine} // namespace VulkanGameEngine
\ No newline at end of file
+} // namespace VulkanGameEngine
@@ -0,0 +1,110 @@
+#pragma once
+
+#include "Common.h"
+#include "VulkanDevice.h"
+#include <vector>
+
+namespace VulkanGameEngine {
+
+class VulkanCommandPool;
+
+/**
+ * VulkanOffscreenTarget owns the color images the engine renders into when it
+ * runs without a window.
+ *
+ * It stands in for the swapchain in headless mode: one image per frame in
+ * flight, created with the same sRGB RGBA8 format the swapchain prefers so
+ * headless output matches what is shown on screen. The render pass leaves the
+ * images in TRANSFER_SRC_OPTIMAL, so a finished frame can be copied back to the
+ * CPU (for golden-image checks) without an extra layout transition.
+ *
+ * Only core Vulkan is used, which keeps headless mode working on devices
+ * without presentation support, including software ICDs such as lavapipe.
+ */
+class VulkanOffscreenTarget {
+public:
+    /**
+     * Format used for offscreen color images (color attachment support is mandatory for it)
+     */
+    static constexpr VkFormat DEFAULT_FORMAT = VK_FORMAT_R8G8B8A8_SRGB;
+
+    /**
+     * Constructor - initializes member variables to safe defaults
+     */
+    VulkanOffscreenTarget();
+
+    /**
+     * Destructor - ensures proper cleanup of image resources
+     */
+    ~VulkanOffscreenTarget();
+
+    // Disable copy constructor and assignment operator
+    VulkanOffscreenTarget(const VulkanOffscreenTarget&) = delete;
+    VulkanOffscreenTarget& operator=(const VulkanOffscreenTarget&) = delete;
+
+    /**
+     * Creates the color images, their memory and image views.
+     *
+     * @param device The Vulkan device to create images on
+     * @param width Image width in pixels
+     * @param height Image height in pixels
+     * @param imageCount Number of images (usually MAX_FRAMES_IN_FLIGHT)
+     * @param format Color format of the images
+     */
+    void create(const VulkanDevice& device, uint32_t width, uint32_t height, uint32_t imageCount,
+                VkFormat format = DEFAULT_FORMAT);
+
+    /**
+     * Cleans up all image resources. Safe to call multiple times.
+     */
+    void cleanup();
+
+    /**
+     * Copies a rendered image back to host memory.
+     *
+     * The image must have been rendered at least once (it is expected in
+     * TRANSFER_SRC_OPTIMAL). This submits a one-off copy and waits for the
+     * queue, so it belongs outside the frame loop.
+     *
+     * @param commandPool Command pool for the temporary command buffer
+     * @param queue Queue to submit the copy to
+     * @param imageIndex Image to read
+     * @param pixels Output: width * height tightly packed RGBA8 pixels, top row first
+     */
+    void readback(VulkanCommandPool& commandPool, VkQueue queue, uint32_t imageIndex,
+                  std::vector<uint8_t>& pixels) const;
+
+    /**
+     * Writes RGBA8 pixels to a binary PPM (P6) file, dropping alpha.
+     *
+     * @param path Output file path
+     * @param width Image width in pixels
+     * @param height Image height in pixels
+     * @param pixels width * height RGBA8 pixels
+     */
+    static void writePPM(const std::string& path, uint32_t width, uint32_t height,
+                         const std::vector<uint8_t>& pixels);
+
+    // Getters mirroring VulkanSwapchain, so the engine can use either as its color target
+    const std::vector<VkImage>& getImages() const { return m_images; }
+    const std::vector<VkImageView>& getImageViews() const { return m_imageViews; }
+    VkFormat getImageFormat() const { return m_imageFormat; }
+    VkExtent2D getExtent() const { return m_extent; }
+    uint32_t getImageCount() const { return static_cast<uint32_t>(m_images.size()); }
+
+private:
+    VkDevice m_device;                          // Logical device handle (not owned)
+    VkPhysicalDevice m_physicalDevice;          // Physical device handle (not owned)
+    std::vector<VkImage> m_images;              // Offscreen color images
+    std::vector<VkDeviceMemory> m_imageMemory;  // One allocation per image
+    std::vector<VkImageView> m_imageViews;      // Views used as framebuffer attachments
+    VkFormat m_imageFormat;                     // Format of the color images
+    VkExtent2D m_extent;                        // Dimensions of the color images
+
+    /**
+     * Finds a memory type matching the filter and property flags
+     */
+    uint32_t findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties) const;
+};
+
+} // namespace VulkanGameEngine
@@ -43,12 +43,16 @@ public:
      * @param vertexShaderPath Path to compiled vertex shader (.spv file)
      * @param fragmentShaderPath Path to compiled fragment shader (.spv file)
      * @param extent Swapchain extent for viewport configuration
+     * @param vertexShaderCode SPIR-V to use instead of reading vertexShaderPath (empty = read the file)
+     * @param fragmentShaderCode SPIR-V to use instead of reading fragmentShaderPath (empty = read the file)
      */
     void createGraphicsPipeline(VkDevice device, 
                                VkRenderPass renderPass,
                                const std::string& vertexShaderPath,
                                const std::string& fragmentShaderPath,
-                               VkExtent2D extent);
+                               VkExtent2D extent,
+                               const std::vector<char>& vertexShaderCode = {},
+                               const std::vector<char>& fragmentShaderCode = {});
 
     /**
      * @brief Get the graphics pipeline object
@@ -116,9 +120,10 @@ private:
      * Provides detailed error messages if shader loading fails.
      * 
      * @param shaderPath Path to the compiled SPIR-V shader file
+     * @param shaderCode Bytecode already in memory (e.g. from a frame capture); the file is only read if empty
      * @return VkShaderModule handle
      */
-    VkShaderModule loadShader(const std::string& shaderPath);
+    VkShaderModule loadShader(const std::string& shaderPath, const std::vector<char>& shaderCode);
 
     /**
      * @brief Create descriptor set layout for uniform buffers
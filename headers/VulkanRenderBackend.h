@@ -0,0 +1,381 @@
+#pragma once
+
+#include "RenderBackend.h"
+#include "VulkanInstance.h"
+#include "VulkanDevice.h"
+#include "VulkanSwapchain.h"
+#include "VulkanOffscreenTarget.h"
+#include "VulkanRenderPass.h"
+#include "VulkanPipeline.h"
+#include "VulkanBuffer.h"
+#include "VulkanCommandPool.h"
+#include "VulkanSynchronization.h"
+#include "GpuProfiler.h"
+#include <array>
+#include <atomic>
+
+namespace VulkanGameEngine {
+
+/**
+ * VulkanRenderBackend renders through Vulkan.
+ *
+ * It owns every Vulkan object the engine uses: instance, device, swapchain (or
+ * offscreen images when no window is given), render pass, depth buffer,
+ * pipelines, buffers, descriptor sets, command buffers and synchronization.
+ * Each frame it translates the engine's CommandList into the frame slot's
+ * command buffer, one vkCmd* call per command.
+ *
+ * Resources released while frames are in flight are retired rather than
+ * destroyed: each remembers the submissions that may use it and is freed
+ * once the frame fences show they have finished, so nothing waits for the
+ * device. Vertex and index buffers created after the first frame are copied
+ * from staging in the next frame's command buffer for the same reason.
+ *
+ * Dynamic vertex buffers hold one region per frame in flight in a single
+ * persistently mapped buffer. Updates are copied straight into the region of
+ * the frame being recorded (its fence has just been waited on, so the GPU is
+ * done with it) and the frame binds that region; no staging, no copies on
+ * the GPU and no waiting.
+ */
+class VulkanRenderBackend : public RenderBackend {
+public:
+    /**
+     * Initialization state for error handling and partial cleanup
+     */
+    enum class InitializationState {
+        NOT_INITIALIZED,
+        INSTANCE_CREATED,
+        SURFACE_CREATED,
+        DEVICE_CREATED,
+        SWAPCHAIN_CREATED,
+        RENDER_PASS_CREATED,
+        DESCRIPTORS_CREATED,
+        COMMAND_POOL_CREATED,
+        SYNCHRONIZATION_CREATED,
+        FULLY_INITIALIZED
+    };
+
+    /**
+     * Maximum number of uniform buffers (one descriptor set each)
+     */
+    static constexpr uint32_t MAX_UNIFORM_BUFFERS = 16;
+
+    /**
+     * Readback buffers in the ring: enough for every frame in flight plus a
+     * few finished frames the consumer has not released yet
+     */
+    static constexpr uint32_t READBACK_RING_SIZE = MAX_FRAMES_IN_FLIGHT + 3;
+
+    /**
+     * Alignment of the per-frame regions of dynamic vertex buffers (covers
+     * cache lines and every nonCoherentAtomSize in practice)
+     */
+    static constexpr VkDeviceSize DYNAMIC_REGION_ALIGNMENT = 256;
+
+    VulkanRenderBackend();
+    ~VulkanRenderBackend() override;
+
+    // Non-copyable
+    VulkanRenderBackend(const VulkanRenderBackend&) = delete;
+    VulkanRenderBackend& operator=(const VulkanRenderBackend&) = delete;
+
+    const char* getName() const override { return "vulkan"; }
+
+    /**
+     * Creates the Vulkan objects in dependency order:
+     * 1. Instance (with SDL's surface extensions unless headless)
+     * 2. Window surface (skipped when headless)
+     * 3. Physical and logical device
+     * 4. Swapchain, or offscreen color images when headless
+     * 5. Render pass, depth buffer and framebuffers
+     * 6. Descriptor pool
+     * 7. Command pool and per-frame command buffers
+     * 8. Synchronization objects and GPU profiler
+     */
+    void initialize(const BackendConfig& config) override;
+    void cleanup() override;
+    void waitIdle() override;
+    void resize(uint32_t width, uint32_t height) override;
+    void getRenderExtent(uint32_t& width, uint32_t& height) const override;
+
+    BufferHandle createBuffer(BufferType type, const void* data, size_t size) override;
+    void updateBuffer(BufferHandle buffer, const void* data, size_t size) override;
+    void destroyBuffer(BufferHandle buffer) override;
+    void updateBufferRange(BufferHandle buffer, size_t offset, const void* data, size_t size) override;
+    PipelineHandle createPipeline(const PipelineDesc& desc) override;
+    void destroyPipeline(PipelineHandle pipeline) override;
+    void replacePipeline(PipelineHandle pipeline, const PipelineDesc& desc) override;
+
+    FrameStatus beginFrame(uint32_t frameSlot) override;
+    void recordFrame(const CommandList& commands) override;
+    void submitFrame() override;
+    FrameStatus presentFrame() override;
+
+    const BackendTimings& getTimings() const override { return m_timings; }
+    const GpuProfiler::FrameResults& getGpuResults() const override { return m_gpuProfiler.getLastResults(); }
+
+    /**
+     * Reads back the most recently rendered frame (headless mode only).
+     * Waits for the device to go idle, so call it outside the frame loop.
+     */
+    void readbackFrame(std::vector<uint8_t>& pixels, uint32_t& width, uint32_t& height) override;
+
+    /**
+     * Records a copy of the frame's color image into the next free ring
+     * buffer at the end of recordFrame (windowed mode needs a swapchain with
+     * TRANSFER_SRC support)
+     */
+    bool requestReadback(uint64_t tag) override;
+    bool pollReadback(ReadbackFrame& frame) override;
+    void releaseReadback(uint32_t id) override;
+
+    // Getters for backend state and components
+    InitializationState getInitializationState() const { return m_initState; }
+    bool isHeadless() const { return m_headless; }
+    const VulkanInstance& getInstance() const { return m_instance; }
+    const VulkanDevice& getDevice() const { return m_device; }
+    const VulkanSwapchain& getSwapchain() const { return m_swapchain; }
+    const VulkanOffscreenTarget& getOffscreenTarget() const { return m_offscreenTarget; }
+    const VulkanRenderPass& getRenderPass() const { return m_renderPass; }
+    const VulkanCommandPool& getCommandPool() const { return m_commandPool; }
+    const VulkanSynchronization& getSynchronization() const { return m_synchronization; }
+    const GpuProfiler& getGpuProfiler() const { return m_gpuProfiler; }
+
+private:
+    /**
+     * A buffer slot; handles index this table (handle - 1)
+     */
+    struct BufferSlot {
+        VulkanBuffer buffer;
+        BufferType type = BufferType::VERTEX;
+        VkDescriptorSet descriptorSet = VK_NULL_HANDLE;     // Uniform buffers only
+        uint8_t* mapped = nullptr;                          // Dynamic vertex buffers: mapped for their lifetime
+        VkDeviceSize regionSize = 0;                        // Dynamic vertex buffers: bytes per frame slot
+        VkDeviceSize regionStride = 0;                      // Dynamic vertex buffers: offset between frame slots
+        bool live = false;
+    };
+
+    /**
+     * A pipeline slot; the description is kept to rebuild it on resize
+     */
+    struct PipelineSlot {
+        PipelineDesc desc;
+        std::unique_ptr<VulkanPipeline> pipeline;
+    };
+
+    /**
+     * A resource released while submitted frames may still use it. It is
+     * destroyed once every frame slot has finished the submission it had
+     * (or was recording) when the resource was retired.
+     */
+    struct RetiredResource {
+        uint64_t submissions[MAX_FRAMES_IN_FLIGHT] = {};    // Per slot: submission that must complete first
+        VulkanBuffer buffer;                                // Buffer to destroy (may be empty)
+        uint32_t bufferSlot = UINT32_MAX;                   // Buffer slot to free for reuse (UINT32_MAX = none)
+        std::unique_ptr<VulkanPipeline> pipeline;           // Pipeline to destroy (may be null)
+    };
+
+    /**
+     * A vertex or index buffer whose contents are copied from a staging
+     * buffer at the start of the next recorded frame
+     */
+    struct PendingUpload {
+        VulkanBuffer staging;
+        uint32_t bufferSlot;
+        VkDeviceSize size;
+    };
+
+    /**
+     * One buffer of the readback ring. Buffers stay mapped and are only
+     * (re)created when a larger frame is requested, so steady-state readback
+     * does not allocate.
+     */
+    struct ReadbackSlot {
+        enum State : uint8_t {
+            FREE,
+            PENDING,        // Copy recorded, GPU may not have finished it
+            IN_USE          // Handed out by pollReadback, waiting for releaseReadback
+        };
+
+        VulkanBuffer buffer;
+        const uint8_t* mapped = nullptr;
+        VkDeviceSize capacity = 0;
+        uint32_t width = 0;
+        uint32_t height = 0;
+        bool bgra = false;
+        uint64_t tag = 0;
+        uint32_t frameSlot = 0;             // Frame slot whose fence covers the copy
+        uint64_t submission = 0;            // Submission of that slot the copy is part of
+        std::atomic<uint8_t> state{FREE};   // Released from the consumer's thread
+    };
+
+    // Vulkan components (in initialization order)
+    VulkanInstance m_instance;              // Vulkan instance and validation layers
+    VulkanDevice m_device;                  // Physical and logical device management
+    VulkanSwapchain m_swapchain;            // Swapchain for presentation
+    VulkanOffscreenTarget m_offscreenTarget; // Color images used instead of the swapchain when headless
+    VulkanRenderPass m_renderPass;          // Render pass configuration
+    VulkanCommandPool m_commandPool;        // Command buffer management
+    VulkanSynchronization m_synchronization; // Synchronization objects
+    GpuProfiler m_gpuProfiler;              // GPU timestamp and pipeline statistics queries
+
+    // Vulkan handles that need direct access
+    VkSurfaceKHR m_surface;                 // Window surface for rendering
+
+    // Depth buffer for 3D rendering
+    VkImage m_depthImage;                   // Depth buffer image
+    VkDeviceMemory m_depthImageMemory;      // Depth buffer memory
+    VkImageView m_depthImageView;           // Depth buffer image view
+
+    // Descriptor sets for uniform buffer binding
+    VkDescriptorPool m_descriptorPool;      // Pool for the uniform buffers' descriptor sets
+    uint32_t m_descriptorSetCount;          // Sets allocated from the pool so far
+
+    // Resources handed out to the engine
+    std::vector<BufferSlot> m_buffers;
+    std::vector<uint32_t> m_freeBufferSlots;
+    std::vector<PipelineSlot> m_pipelines;
+    std::vector<RetiredResource> m_retired;         // Destroyed by the engine, waiting for their frames
+    std::vector<PendingUpload> m_pendingUploads;    // Recorded into the next frame
+
+    // Command buffers for rendering
+    std::vector<VkCommandBuffer> m_commandBuffers; // Command buffers (one per frame in flight)
+
+    // Backend state
+    InitializationState m_initState;        // Current initialization state
+    bool m_headless;                        // Rendering offscreen without a window
+    uint32_t m_width;                       // Requested render target width
+    uint32_t m_height;                      // Requested render target height
+
+    // Current frame
+    uint32_t m_frameSlot;                   // Frame in flight being recorded
+    uint32_t m_imageIndex;                  // Color image being rendered to
+    uint32_t m_lastRenderedImage;           // Color image written by the most recent submitted frame
+    bool m_hasRenderedFrame;                // A frame has been submitted since initialization
+    bool m_frameInProgress;                 // Between a successful beginFrame and its submitFrame
+    BackendTimings m_timings;
+
+    // Asynchronous readback
+    std::array<ReadbackSlot, READBACK_RING_SIZE> m_readbacks;
+    uint32_t m_requestedReadback;           // Ring index + 1 to copy the current frame into (0 = none)
+    uint64_t m_submissionCount;             // Frames submitted so far
+    uint64_t m_slotSubmission[MAX_FRAMES_IN_FLIGHT];    // Latest submission of each frame slot
+    uint64_t m_completedSubmission[MAX_FRAMES_IN_FLIGHT]; // Latest submission of each slot known to be finished
+
+    /**
+     * Queues a resource for destruction once the frames that may use it have finished
+     */
+    void retire(RetiredResource&& resource);
+
+    /**
+     * Destroys the retired resources whose frames have finished
+     *
+     * @param all Destroy all of them (the device is idle or being torn down)
+     */
+    void releaseRetired(bool all = false);
+
+    /**
+     * Records the copies of pending vertex and index uploads, made visible to
+     * the vertex input stage, and retires their staging buffers with the frame
+     */
+    void recordPendingUploads(VkCommandBuffer commandBuffer);
+
+    /**
+     * Creates the window surface (the connection between Vulkan and the window system)
+     */
+    void createSurface(SDL_Window* window);
+
+    /**
+     * Creates the color images frames are rendered to: the swapchain, or the
+     * offscreen target when headless
+     */
+    void createColorTarget();
+
+    /**
+     * Destroys the swapchain or offscreen target
+     */
+    void destroyColorTarget();
+
+    // Properties of the active color target (swapchain or offscreen images)
+    VkExtent2D getColorExtent() const;
+    VkFormat getColorFormat() const;
+    const std::vector<VkImageView>& getColorImageViews() const;
+
+    /**
+     * Creates the render pass, depth buffer and framebuffers for the current color target
+     */
+    void createRenderTargets();
+
+    /**
+     * Destroys the render pass, depth buffer and framebuffers
+     */
+    void destroyRenderTargets();
+
+    /**
+     * Creates depth buffer and depth image view matching the color target
+     */
+    void createDepthBuffer();
+
+    /**
+     * Finds a suitable depth format supported by the device.
+     */
+    VkFormat findDepthFormat();
+
+    /**
+     * Finds a format from candidates that supports the given features.
+     */
+    VkFormat findSupportedFormat(const std::vector<VkFormat>& candidates,
+                                VkImageTiling tiling, VkFormatFeatureFlags features);
+
+    /**
+     * Builds (or rebuilds) a pipeline slot for the current render pass and extent
+     */
+    void buildPipeline(PipelineSlot& slot);
+
+    /**
+     * Creates the descriptor pool the uniform buffers' descriptor sets come from
+     */
+    void createDescriptorPool();
+
+    /**
+     * Allocates a descriptor set pointing at a uniform buffer
+     */
+    VkDescriptorSet allocateUniformDescriptorSet(const VulkanBuffer& buffer, VkDeviceSize size);
+
+    /**
+     * Recreates the color target and everything that depends on its size or format
+     */
+    void recreateSwapchain();
+
+    /**
+     * Looks up a live buffer slot, throwing for invalid handles
+     */
+    BufferSlot& getBufferSlot(BufferHandle buffer);
+
+    /**
+     * Copies data into the current frame slot's region of a dynamic vertex buffer
+     */
+    void writeDynamicRegion(BufferSlot& slot, size_t offset, const void* data, size_t size);
+
+    /**
+     * Looks up a live pipeline, throwing for invalid handles
+     */
+    VulkanPipeline& getPipeline(PipelineHandle pipeline);
+
+    /**
+     * Records the copy of the current color image into a readback buffer (after the render pass)
+     */
+    void recordReadbackCopy(VkCommandBuffer commandBuffer, ReadbackSlot& slot);
+
+    /**
+     * Destroys the readback buffers (warns about any still handed out)
+     */
+    void destroyReadbacks();
+
+    /**
+     * Logs the current initialization step for debugging.
+     */
+    void logInitializationState(InitializationState state, const std::string& operation);
+};
+
+} // namespace VulkanGameEngine
@@ -32,9 +32,12 @@ public:
      * @param colorFormat The format of the color attachment (usually swapchain format)
      * @param depthFormat The format of the depth attachment (e.g., VK_FORMAT_D32_SFLOAT)
      * @param msaaSamples Number of MSAA samples (VK_SAMPLE_COUNT_1_BIT for no MSAA)
+     * @param colorFinalLayout Layout the color attachment is left in (PRESENT_SRC_KHR for a
+     *                         swapchain, TRANSFER_SRC_OPTIMAL for offscreen images that are read back)
      */
     void create(VkDevice device, VkFormat colorFormat, VkFormat depthFormat, 
-                VkSampleCountFlagBits msaaSamples = VK_SAMPLE_COUNT_1_BIT);
+                VkSampleCountFlagBits msaaSamples = VK_SAMPLE_COUNT_1_BIT,
+                VkImageLayout colorFinalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR);
 
     /**
      * Creates framebuffers for the render pass.
@@ -81,7 +84,7 @@ private:
      * - Subpass dependencies: Synchronization between rendering operations
      */
     void createRenderPass(VkFormat colorFormat, VkFormat depthFormat, 
-                         VkSampleCountFlagBits msaaSamples);
+                         VkSampleCountFlagBits msaaSamples, VkImageLayout colorFinalLayout);
 
     /**
      * Destroys all framebuffer objects.
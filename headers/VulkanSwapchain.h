@@ -102,6 +102,11 @@ public:
     VkExtent2D getExtent() const { return m_extent; }
     uint32_t getImageCount() const { return static_cast<uint32_t>(m_images.size()); }
 
+    /**
+     * Checks if the images can be copied from (TRANSFER_SRC usage), which frame readback needs
+     */
+    bool isTransferSource() const { return m_transferSource; }
+
     /**
      * Queries swapchain support details for a device and surface.
      * 
@@ -123,6 +128,7 @@ private:
     // Swapchain properties
     VkFormat m_imageFormat;                  // Format of swapchain images
     VkExtent2D m_extent;                     // Dimensions of swapchain images
+    bool m_transferSource;                   // Images were created with TRANSFER_SRC usage
     
     // Device references (not owned by this class)
     VkDevice m_device;                       // Logical device handle
@@ -162,6 +162,23 @@ public:
                              const std::vector<VkSemaphore>& signalSemaphores = {},
                              VkFence fence = VK_NULL_HANDLE);
 
+    /**
+     * Submits a single command buffer with one wait and one signal semaphore.
+     * 
+     * This is the per-frame path: unlike submitCommandBuffers it builds
+     * no temporary vectors, so it never touches the heap.
+     * 
+     * @param queue Queue to submit to
+     * @param commandBuffer Command buffer to submit
+     * @param waitSemaphore Semaphore to wait for before execution (VK_NULL_HANDLE for none)
+     * @param waitStage Pipeline stage to wait at
+     * @param signalSemaphore Semaphore to signal after execution (VK_NULL_HANDLE for none)
+     * @param fence Fence to signal when submission completes (optional)
+     */
+    void submitCommandBuffer(VkQueue queue, VkCommandBuffer commandBuffer,
+                             VkSemaphore waitSemaphore, VkPipelineStageFlags waitStage,
+                             VkSemaphore signalSemaphore, VkFence fence = VK_NULL_HANDLE);
+
     /**
      * Presents a swapchain image with synchronization.
      * 
@@ -177,6 +194,18 @@ public:
     VkResult presentImage(VkQueue presentQueue, VkSwapchainKHR swapchain,
                          uint32_t imageIndex, const std::vector<VkSemaphore>& waitSemaphores = {});
 
+    /**
+     * Presents a swapchain image after a single semaphore (no heap allocation).
+     * 
+     * @param presentQueue Queue to present on
+     * @param swapchain Swapchain to present to
+     * @param imageIndex Index of the image to present
+     * @param waitSemaphore Semaphore to wait for before presentation
+     * @return VkResult from the present operation
+     */
+    VkResult presentImage(VkQueue presentQueue, VkSwapchainKHR swapchain,
+                         uint32_t imageIndex, VkSemaphore waitSemaphore);
+
     /**
      * Acquires the next image from the swapchain with synchronization.
      * 
@@ -34,8 +34,9 @@ namespace VulkanUtils {
      * @brief Read binary file contents into a vector
      * 
      * Utility function for loading SPIR-V shader bytecode from compiled
-     * shader files. Handles file I/O errors gracefully with meaningful
-     * error messages.
+     * shader files. Looks in the mounted asset archives first (see
+     * AssetFileSystem), then on disk. Handles file I/O errors gracefully
+     * with meaningful error messages.
      * 
      * @param filename Path to the file to read
      * @return Vector containing the file contents as bytes
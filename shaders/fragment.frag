@@ -3,6 +3,8 @@
 // Input from vertex shader
 layout(location = 0) in vec3 fragColor;
 layout(location = 1) in vec2 fragTexCoord;
+layout(location = 2) in vec3 fragNormal;   // World space (not lit yet)
+layout(location = 3) in vec4 fragTangent;  // World space, w = bitangent sign
 
 // Output color to framebuffer
 layout(location = 0) out vec4 outColor;
@@ -2,26 +2,123 @@
 
 // Vertex input attributes
 layout(location = 0) in vec3 inPosition;
-layout(location = 1) in vec3 inColor;
-layout(location = 2) in vec2 inTexCoord;
+layout(location = 1) in vec2 inTexCoord;
+layout(location = 2) in vec3 inNormal;   // Unit normal in model space
+layout(location = 3) in vec4 inTangent;  // Unit tangent, w = bitangent sign
 
 // Uniform buffer object containing transformation matrices
 layout(binding = 0) uniform UniformBufferObject {
-    mat4 model;      // Model transformation matrix (object to world space)
+    mat4 model;      // Unused: per-object transforms come from push constants
     mat4 view;       // View transformation matrix (world to camera space)
     mat4 projection; // Projection transformation matrix (camera to clip space)
 } ubo;
 
+// Per-draw data (ObjectConstants in Common.h)
+layout(push_constant) uniform ObjectConstants {
+    mat4 model;      // Model transformation matrix (object to world space)
+    vec4 tint;       // Material tint, multiplied with the vertex color
+    uint colorMode;  // ColorMode in Common.h
+} object;
+
 // Output to fragment shader
 layout(location = 0) out vec3 fragColor;
 layout(location = 1) out vec2 fragTexCoord;
+layout(location = 2) out vec3 fragNormal;   // World space, for lighting
+layout(location = 3) out vec4 fragTangent;  // World space, w = bitangent sign
+
+// Color modes (ColorMode in Common.h)
+const uint COLOR_RAINBOW = 0u;
+const uint COLOR_GRADIENT = 1u;
+const uint COLOR_ANATOMICAL = 2u;
+const uint COLOR_METALLIC = 3u;
+const uint COLOR_PASTEL = 4u;
+const uint COLOR_FACES = 5u;
+
+// Golden ratio steps spread consecutive vertices over the hue circle
+float goldenHue(uint vertexIndex) {
+    return fract(float(vertexIndex) * 0.618033988749895);
+}
+
+vec3 rainbowColor(uint vertexIndex) {
+    float hue = goldenHue(vertexIndex);
+    vec3 color;
+    if (hue < 1.0 / 3.0) {
+        color = vec3(1.0 - 3.0 * hue, 3.0 * hue, 0.0);
+    } else if (hue < 2.0 / 3.0) {
+        color = vec3(0.0, 2.0 - 3.0 * hue, 3.0 * hue - 1.0);
+    } else {
+        color = vec3(3.0 * hue - 2.0, 0.0, 3.0 - 3.0 * hue);
+    }
+    // Add some brightness
+    return clamp(color * 0.7 + 0.3, 0.0, 1.0);
+}
+
+vec3 gradientColor(vec3 position) {
+    // Red increases, green and blue decrease with height
+    float normalizedY = (position.y + 1.0) * 0.5;
+    return vec3(0.2 + normalizedY * 0.6, 0.8 - normalizedY * 0.3, 0.9 - normalizedY * 0.4);
+}
+
+vec3 anatomicalColor(vec3 position) {
+    if (position.y > 1.4) {
+        return vec3(0.9, 0.7, 0.6);     // Head - skin tone
+    } else if (position.y > 0.6) {
+        return vec3(0.2, 0.6, 0.9);     // Torso - blue shirt
+    } else if (position.y > 0.0) {
+        return vec3(0.1, 0.5, 0.1);     // Legs - green pants
+    }
+    return vec3(0.3, 0.2, 0.1);         // Feet - brown shoes
+}
+
+vec3 metallicColor(uint vertexIndex) {
+    float metallic = 0.7 + 0.3 * sin(float(vertexIndex) * 0.1);
+    return metallic * vec3(0.8, 0.85, 0.9);
+}
+
+vec3 pastelColor(uint vertexIndex) {
+    // High lightness, low saturation
+    float hue = goldenHue(vertexIndex);
+    if (hue < 1.0 / 3.0) {
+        return vec3(0.9 - 0.2 * hue, 0.7 + 0.2 * hue, 0.8);
+    } else if (hue < 2.0 / 3.0) {
+        float t = (hue - 1.0 / 3.0) * 3.0;
+        return vec3(0.8, 0.9 - 0.2 * t, 0.7 + 0.2 * t);
+    }
+    float t = (hue - 2.0 / 3.0) * 3.0;
+    return vec3(0.7 + 0.2 * t, 0.8, 0.9 - 0.2 * t);
+}
+
+vec3 faceColor(uint vertexIndex) {
+    // Front, back, left, right, top, bottom
+    const vec3 palette[6] = vec3[6](
+        vec3(1.0, 0.0, 0.0), vec3(0.0, 1.0, 0.0), vec3(0.0, 0.0, 1.0),
+        vec3(1.0, 1.0, 0.0), vec3(1.0, 0.0, 1.0), vec3(0.0, 1.0, 1.0));
+    return palette[(vertexIndex / 4u) % 6u];
+}
+
+vec3 vertexColor(uint vertexIndex, vec3 position) {
+    switch (object.colorMode) {
+        case COLOR_GRADIENT:   return gradientColor(position);
+        case COLOR_ANATOMICAL: return anatomicalColor(position);
+        case COLOR_METALLIC:   return metallicColor(vertexIndex);
+        case COLOR_PASTEL:     return pastelColor(vertexIndex);
+        case COLOR_FACES:      return faceColor(vertexIndex);
+        default:               return rainbowColor(vertexIndex);
+    }
+}
 
 void main() {
     // Transform vertex position through the complete MVP pipeline
     // This transforms from object space -> world space -> camera space -> clip space
-    gl_Position = ubo.projection * ubo.view * ubo.model * vec4(inPosition, 1.0);
+    gl_Position = ubo.projection * ubo.view * object.model * vec4(inPosition, 1.0);
     
-    // Pass through color and texture coordinates to fragment shader
-    fragColor = inColor;
+    // Generated, tinted color and texture coordinates to fragment shader
+    // (gl_VertexIndex includes the draw's vertexOffset; the engine draws with 0)
+    fragColor = vertexColor(uint(gl_VertexIndex), inPosition) * object.tint.rgb;
     fragTexCoord = inTexCoord;
-}
\ No newline at end of file
+    
+    // Normal and tangent to world space (uniform scale only, as in Scene::composeTransform)
+    mat3 normalMatrix = mat3(object.model);
+    fragNormal = normalize(normalMatrix * inNormal);
+    fragTangent = vec4(normalize(normalMatrix * inTangent.xyz), inTangent.w);
+}
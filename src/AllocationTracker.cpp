@@ -0,0 +1,303 @@
+#include "../headers/AllocationTracker.h"
+#include "../headers/Metrics.h"
+#include "../headers/Logger.h"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+namespace VulkanGameEngine {
+
+namespace {
+
+/**
+ * Per-thread counters. Plain integers: only the owning thread touches them.
+ */
+struct ThreadCounters {
+    uint64_t allocations;
+    uint64_t bytes;
+    uint64_t frees;
+    uint64_t frameStartAllocations;     // Snapshot taken by endFrame()
+    uint64_t lastFrameAllocations;
+    const char* tag;
+    uint32_t noAllocationDepth;
+};
+
+thread_local ThreadCounters t_counters = {};
+
+std::atomic<uint64_t> g_allocations{0};
+std::atomic<uint64_t> g_bytes{0};
+std::atomic<uint64_t> g_frees{0};
+std::atomic<uint64_t> g_violations{0};
+std::atomic<const char*> g_lastViolationTag{nullptr};
+std::atomic<bool> g_abortOnViolation{false};
+
+/**
+ * Fixed open-addressing table of tags, keyed by pointer. It never allocates,
+ * so it is safe to update from inside operator new.
+ */
+constexpr uint32_t TAG_TABLE_SIZE = 256;
+
+struct TagSlot {
+    std::atomic<const char*> tag{nullptr};
+    std::atomic<uint64_t> allocations{0};
+    std::atomic<uint64_t> bytes{0};
+};
+
+TagSlot g_tags[TAG_TABLE_SIZE];
+
+#ifdef ENGINE_TRACK_ALLOCATIONS
+
+void recordTag(const char* tag, std::size_t size) {
+    uint32_t index = static_cast<uint32_t>((reinterpret_cast<uintptr_t>(tag) >> 3) % TAG_TABLE_SIZE);
+    for (uint32_t probe = 0; probe < TAG_TABLE_SIZE; ++probe) {
+        TagSlot& slot = g_tags[index];
+        const char* current = slot.tag.load(std::memory_order_acquire);
+        if (current == nullptr) {
+            const char* expected = nullptr;
+            if (slot.tag.compare_exchange_strong(expected, tag, std::memory_order_acq_rel)) {
+                current = tag;
+            } else {
+                current = expected;
+            }
+        }
+        if (current == tag) {
+            slot.allocations.fetch_add(1, std::memory_order_relaxed);
+            slot.bytes.fetch_add(size, std::memory_order_relaxed);
+            return;
+        }
+        index = (index + 1) % TAG_TABLE_SIZE;
+    }
+    // Table full: the allocation still shows up in the thread and global totals
+}
+
+/**
+ * Called by the operator new hooks for every allocation
+ */
+void recordAllocation(std::size_t size) {
+    ThreadCounters& counters = t_counters;
+    counters.allocations++;
+    counters.bytes += size;
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    g_bytes.fetch_add(size, std::memory_order_relaxed);
+
+    if (counters.tag) {
+        recordTag(counters.tag, size);
+    }
+
+    if (counters.noAllocationDepth > 0) {
+        g_violations.fetch_add(1, std::memory_order_relaxed);
+        g_lastViolationTag.store(counters.tag, std::memory_order_relaxed);
+
+        if (g_abortOnViolation.load(std::memory_order_relaxed)) {
+            // Logging would allocate again; write straight to stderr
+            std::fprintf(stderr, "Heap allocation of %zu bytes inside a no-allocation scope (tag: %s)\n",
+                         size, counters.tag ? counters.tag : "none");
+            std::abort();
+        }
+    }
+}
+
+/**
+ * Called by the operator delete hooks for every non-null free
+ */
+void recordFree() {
+    t_counters.frees++;
+    g_frees.fetch_add(1, std::memory_order_relaxed);
+}
+
+#endif // ENGINE_TRACK_ALLOCATIONS
+
+} // anonymous namespace
+
+bool AllocationTracker::isCompiledIn() {
+#ifdef ENGINE_TRACK_ALLOCATIONS
+    return true;
+#else
+    return false;
+#endif
+}
+
+AllocationTracker::Stats AllocationTracker::getThreadStats() {
+    Stats stats;
+    stats.allocations = t_counters.allocations;
+    stats.bytes = t_counters.bytes;
+    stats.frees = t_counters.frees;
+    return stats;
+}
+
+AllocationTracker::Stats AllocationTracker::getGlobalStats() {
+    Stats stats;
+    stats.allocations = g_allocations.load(std::memory_order_relaxed);
+    stats.bytes = g_bytes.load(std::memory_order_relaxed);
+    stats.frees = g_frees.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void AllocationTracker::getTagStats(std::vector<TagStats>& tags) {
+    tags.clear();
+    for (const TagSlot& slot : g_tags) {
+        const char* tag = slot.tag.load(std::memory_order_acquire);
+        if (tag) {
+            tags.push_back({tag, slot.allocations.load(std::memory_order_relaxed),
+                            slot.bytes.load(std::memory_order_relaxed)});
+        }
+    }
+}
+
+const char* AllocationTracker::exchangeTag(const char* tag) {
+    const char* previous = t_counters.tag;
+    t_counters.tag = tag;
+    return previous;
+}
+
+void AllocationTracker::beginNoAllocationRegion() {
+    t_counters.noAllocationDepth++;
+}
+
+void AllocationTracker::endNoAllocationRegion() {
+    if (t_counters.noAllocationDepth > 0) {
+        t_counters.noAllocationDepth--;
+    }
+}
+
+uint32_t AllocationTracker::suspendNoAllocationRegions() {
+    const uint32_t depth = t_counters.noAllocationDepth;
+    t_counters.noAllocationDepth = 0;
+    return depth;
+}
+
+void AllocationTracker::resumeNoAllocationRegions(uint32_t depth) {
+    t_counters.noAllocationDepth = depth;
+}
+
+void AllocationTracker::setAbortOnViolation(bool abortOnViolation) {
+    g_abortOnViolation.store(abortOnViolation, std::memory_order_relaxed);
+}
+
+uint64_t AllocationTracker::getViolationCount() {
+    return g_violations.load(std::memory_order_relaxed);
+}
+
+uint64_t AllocationTracker::getLastFrameAllocations() {
+    return t_counters.lastFrameAllocations;
+}
+
+void AllocationTracker::endFrame() {
+    if (!isCompiledIn()) {
+        return;
+    }
+
+    static MetricCounter& allocationCounter = MetricsRegistry::getInstance().counter("alloc.count");
+    static MetricCounter& byteCounter = MetricsRegistry::getInstance().counter("alloc.bytes");
+    static MetricHistogram& frameAllocations = MetricsRegistry::getInstance().histogram("frame.allocations", "allocs", 1.0);
+    static Stats lastGlobal = getGlobalStats();
+    static uint64_t reportedViolations = 0;
+
+    ThreadCounters& counters = t_counters;
+    counters.lastFrameAllocations = counters.allocations - counters.frameStartAllocations;
+    counters.frameStartAllocations = counters.allocations;
+    frameAllocations.record(counters.lastFrameAllocations);
+
+    const Stats global = getGlobalStats();
+    allocationCounter.add(global.allocations - lastGlobal.allocations);
+    byteCounter.add(global.bytes - lastGlobal.bytes);
+    lastGlobal = global;
+
+    const uint64_t violations = getViolationCount();
+    if (violations != reportedViolations) {
+        const char* tag = g_lastViolationTag.load(std::memory_order_relaxed);
+        LOG_ERROR("{} heap allocation(s) inside a no-allocation scope (last tag: {})", "Alloc",
+                  violations - reportedViolations, tag ? tag : "none");
+        reportedViolations = violations;
+    }
+}
+
+} // namespace VulkanGameEngine
+
+#ifdef ENGINE_TRACK_ALLOCATIONS
+
+// ============================================================================
+// Global operator new/delete hooks
+// ============================================================================
+
+namespace {
+
+void* trackedAllocate(std::size_t size) {
+    VulkanGameEngine::recordAllocation(size);
+    void* pointer = std::malloc(size ? size : 1);
+    if (!pointer) {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+
+void* trackedAllocateAligned(std::size_t size, std::align_val_t alignment) {
+    VulkanGameEngine::recordAllocation(size);
+    const std::size_t align = static_cast<std::size_t>(alignment);
+#ifdef _WIN32
+    void* pointer = _aligned_malloc(size ? size : 1, align);
+#else
+    // aligned_alloc requires the size to be a multiple of the alignment
+    const std::size_t rounded = ((size ? size : 1) + align - 1) / align * align;
+    void* pointer = std::aligned_alloc(align, rounded);
+#endif
+    if (!pointer) {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+
+void trackedFree(void* pointer) {
+    if (pointer) {
+        VulkanGameEngine::recordFree();
+        std::free(pointer);
+    }
+}
+
+void trackedFreeAligned(void* pointer) {
+    if (pointer) {
+        VulkanGameEngine::recordFree();
+#ifdef _WIN32
+        _aligned_free(pointer);
+#else
+        std::free(pointer);
+#endif
+    }
+}
+
+} // anonymous namespace
+
+void* operator new(std::size_t size) { return trackedAllocate(size); }
+void* operator new[](std::size_t size) { return trackedAllocate(size); }
+void* operator new(std::size_t size, std::align_val_t alignment) { return trackedAllocateAligned(size, alignment); }
+void* operator new[](std::size_t size, std::align_val_t alignment) { return trackedAllocateAligned(size, alignment); }
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    try { return trackedAllocate(size); } catch (...) { return nullptr; }
+}
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    try { return trackedAllocate(size); } catch (...) { return nullptr; }
+}
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    try { return trackedAllocateAligned(size, alignment); } catch (...) { return nullptr; }
+}
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    try { return trackedAllocateAligned(size, alignment); } catch (...) { return nullptr; }
+}
+
+void operator delete(void* pointer) noexcept { trackedFree(pointer); }
+void operator delete[](void* pointer) noexcept { trackedFree(pointer); }
+void operator delete(void* pointer, std::size_t) noexcept { trackedFree(pointer); }
+void operator delete[](void* pointer, std::size_t) noexcept { trackedFree(pointer); }
+void operator delete(void* pointer, const std::nothrow_t&) noexcept { trackedFree(pointer); }
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept { trackedFree(pointer); }
+
+void operator delete(void* pointer, std::align_val_t) noexcept { trackedFreeAligned(pointer); }
+void operator delete[](void* pointer, std::align_val_t) noexcept { trackedFreeAligned(pointer); }
+void operator delete(void* pointer, std::size_t, std::align_val_t) noexcept { trackedFreeAligned(pointer); }
+void operator delete[](void* pointer, std::size_t, std::align_val_t) noexcept { trackedFreeAligned(pointer); }
+void operator delete(void* pointer, std::align_val_t, const std::nothrow_t&) noexcept { trackedFreeAligned(pointer); }
+void operator delete[](void* pointer, std::align_val_t, const std::nothrow_t&) noexcept { trackedFreeAligned(pointer); }
+
+#endif // ENGINE_TRACK_ALLOCATIONS
@@ -0,0 +1,451 @@
+#include "../headers/AnimationClip.h"
+#include "../headers/AnimationPose.h"
+#include "../headers/AssetArchive.h"
+#include "../headers/Logger.h"
+#include "../headers/Profiler.h"
+#include <cmath>
+#include <cstring>
+#include <fstream>
+
+namespace VulkanGameEngine {
+
+constexpr char AnimationClip::MAGIC[8];
+
+namespace {
+
+template <typename T>
+void putValue(std::vector<char>& data, const T& value) {
+    const char* bytes = reinterpret_cast<const char*>(&value);
+    data.insert(data.end(), bytes, bytes + sizeof(T));
+}
+
+template <typename T>
+void putArray(std::vector<char>& data, const std::vector<T>& values) {
+    const char* bytes = reinterpret_cast<const char*>(values.data());
+    data.insert(data.end(), bytes, bytes + values.size() * sizeof(T));
+}
+
+/**
+ * Bounds-checked reads; the first failure sticks, so callers check once at the end
+ */
+class Reader {
+public:
+    explicit Reader(const std::vector<char>& data) : m_data(data), m_offset(0), m_failed(false) {}
+
+    template <typename T>
+    T get() {
+        T value{};
+        if (canRead(sizeof(T))) {
+            std::memcpy(&value, m_data.data() + m_offset, sizeof(T));
+            m_offset += sizeof(T);
+        }
+        return value;
+    }
+
+    template <typename T>
+    void getArray(std::vector<T>& values, uint64_t count) {
+        if (!canRead(count * sizeof(T))) {
+            values.clear();
+            return;
+        }
+        values.resize(static_cast<size_t>(count));
+        std::memcpy(values.data(), m_data.data() + m_offset, static_cast<size_t>(count) * sizeof(T));
+        m_offset += static_cast<size_t>(count) * sizeof(T);
+    }
+
+    std::string getString(uint32_t length) {
+        if (!canRead(length)) {
+            return std::string();
+        }
+        std::string value(m_data.data() + m_offset, length);
+        m_offset += length;
+        return value;
+    }
+
+    bool failed() const { return m_failed; }
+    bool atEnd() const { return m_offset == m_data.size(); }
+
+private:
+    const std::vector<char>& m_data;
+    size_t m_offset;
+    bool m_failed;
+
+    bool canRead(uint64_t size) {
+        if (m_failed || size > m_data.size() - m_offset) {
+            m_failed = true;
+            return false;
+        }
+        return true;
+    }
+};
+
+// --- Quantization (the sampler's SIMD decoder in AnimationPose.cpp mirrors the decoders) ---
+
+struct QuantizedKey {
+    uint16_t values[3];
+};
+
+QuantizedKey encodeRotation(glm::quat rotation) {
+    rotation = glm::normalize(rotation);
+    float components[4] = {rotation.x, rotation.y, rotation.z, rotation.w};
+    uint32_t largest = 0;
+    for (uint32_t i = 1; i < 4; ++i) {
+        if (std::fabs(components[i]) > std::fabs(components[largest])) {
+            largest = i;
+        }
+    }
+    // q and -q are the same rotation; keeping the dropped component positive lets the decoder rebuild it
+    const float sign = components[largest] < 0.0f ? -1.0f : 1.0f;
+
+    QuantizedKey key;
+    uint32_t slot = 0;
+    for (uint32_t i = 0; i < 4; ++i) {
+        if (i == largest) {
+            continue;
+        }
+        const float normalized = (sign * components[i] + AnimationClip::ROTATION_COMPONENT_MAX) / AnimationClip::ROTATION_STEP;
+        key.values[slot++] = static_cast<uint16_t>(glm::clamp(std::lround(normalized), 0L, 32767L));
+    }
+    key.values[0] |= static_cast<uint16_t>((largest & 1) << 15);
+    key.values[1] |= static_cast<uint16_t>((largest >> 1) << 15);
+    return key;
+}
+
+glm::quat decodeRotation(const uint16_t* values) {
+    const uint32_t largest = (values[0] >> 15) | ((values[1] >> 15) << 1);
+    float smallest[3];
+    float sumSquares = 0.0f;
+    for (uint32_t i = 0; i < 3; ++i) {
+        smallest[i] = static_cast<float>(values[i] & 0x7FFF) * AnimationClip::ROTATION_STEP - AnimationClip::ROTATION_COMPONENT_MAX;
+        sumSquares += smallest[i] * smallest[i];
+    }
+    float components[4];
+    uint32_t slot = 0;
+    for (uint32_t i = 0; i < 4; ++i) {
+        components[i] = i == largest ? std::sqrt(std::max(0.0f, 1.0f - sumSquares)) : smallest[slot++];
+    }
+    return glm::quat(components[3], components[0], components[1], components[2]);
+}
+
+QuantizedKey encodeVector(const glm::vec3& value, const AnimationClip::Track& track) {
+    QuantizedKey key;
+    for (int i = 0; i < 3; ++i) {
+        const float steps = track.rangeStep[i] > 0.0f ? (value[i] - track.rangeMin[i]) / track.rangeStep[i] : 0.0f;
+        key.values[i] = static_cast<uint16_t>(glm::clamp(std::lround(steps), 0L, 65535L));
+    }
+    return key;
+}
+
+glm::vec3 decodeVector(const uint16_t* values, const AnimationClip::Track& track) {
+    return track.rangeMin + glm::vec3(values[0], values[1], values[2]) * track.rangeStep;
+}
+
+/**
+ * Normalized lerp taking the shorter way round, exactly as the sampler interpolates
+ */
+glm::quat nlerp(const glm::quat& a, glm::quat b, float t) {
+    if (glm::dot(a, b) < 0.0f) {
+        b = -b;
+    }
+    return glm::normalize(glm::quat(a.w + (b.w - a.w) * t, a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t,
+                                    a.z + (b.z - a.z) * t));
+}
+
+/**
+ * Angle in radians between two unit rotations. Taken from the vector part of
+ * the difference rotation: acos of the dot product is flat near 1 and cannot
+ * resolve errors below about 7e-4 radians in float.
+ */
+float rotationError(const glm::quat& a, const glm::quat& b) {
+    const glm::quat difference = a * glm::conjugate(b);
+    const float sinHalfAngle = glm::length(glm::vec3(difference.x, difference.y, difference.z));
+    return 2.0f * std::asin(std::min(1.0f, sinHalfAngle));
+}
+
+/**
+ * Curve fitting of one track: the frames to keep so that linear
+ * interpolation between them stays within the tolerance of every raw frame.
+ * Segments are grown greedily from the previous kept key.
+ *
+ * @param frameCount Frames in the track
+ * @param error Error of raw frame f when interpolating decoded keys a and b
+ */
+template <typename ErrorFn>
+std::vector<uint32_t> fitKeys(uint32_t frameCount, float tolerance, ErrorFn error) {
+    std::vector<uint32_t> keys;
+    const uint32_t last = frameCount - 1;
+
+    bool constant = true;
+    for (uint32_t frame = 1; frame <= last && constant; ++frame) {
+        constant = error(0, 0, frame) <= tolerance;
+    }
+    if (constant) {
+        keys.push_back(0);
+        return keys;
+    }
+
+    auto segmentFits = [&](uint32_t a, uint32_t b) {
+        for (uint32_t frame = a + 1; frame < b; ++frame) {
+            if (error(a, b, frame) > tolerance) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    uint32_t start = 0;
+    keys.push_back(start);
+    while (start < last) {
+        uint32_t end = start + 1;
+        while (end < last && segmentFits(start, end + 1)) {
+            ++end;
+        }
+        keys.push_back(end);
+        start = end;
+    }
+    return keys;
+}
+
+void appendKeys(AnimationClip::ChannelData& channel, AnimationClip::Track track, const std::vector<uint32_t>& frames,
+                const std::vector<QuantizedKey>& quantized) {
+    track.firstKey = static_cast<uint32_t>(channel.keyFrames.size());
+    track.keyCount = static_cast<uint32_t>(frames.size());
+    channel.tracks.push_back(track);
+    for (uint32_t frame : frames) {
+        channel.keyFrames.push_back(static_cast<uint16_t>(frame));
+        channel.keyValues.insert(channel.keyValues.end(), quantized[frame].values, quantized[frame].values + 3);
+    }
+}
+
+void compressRotations(const RawAnimation& raw, uint32_t joint, float tolerance, AnimationClip::ChannelData& channel) {
+    std::vector<QuantizedKey> quantized(raw.frameCount);
+    std::vector<glm::quat> decoded(raw.frameCount);
+    for (uint32_t frame = 0; frame < raw.frameCount; ++frame) {
+        quantized[frame] = encodeRotation(raw.at(frame, joint).rotation);
+        decoded[frame] = decodeRotation(quantized[frame].values);
+    }
+
+    const std::vector<uint32_t> frames = fitKeys(raw.frameCount, tolerance, [&](uint32_t a, uint32_t b, uint32_t frame) {
+        const float t = b > a ? static_cast<float>(frame - a) / static_cast<float>(b - a) : 0.0f;
+        return rotationError(nlerp(decoded[a], decoded[b], t), glm::normalize(raw.at(frame, joint).rotation));
+    });
+
+    AnimationClip::Track track = {};
+    appendKeys(channel, track, frames, quantized);
+}
+
+/**
+ * Translations (error is the distance) and scales (error is the largest component difference)
+ */
+void compressVectors(const RawAnimation& raw, uint32_t joint, float tolerance, bool isScale,
+                     AnimationClip::ChannelData& channel) {
+    auto valueAt = [&](uint32_t frame) {
+        const JointTransform& transform = raw.at(frame, joint);
+        return isScale ? transform.scale : transform.translation;
+    };
+
+    AnimationClip::Track track = {};
+    glm::vec3 rangeMax = valueAt(0);
+    track.rangeMin = rangeMax;
+    for (uint32_t frame = 1; frame < raw.frameCount; ++frame) {
+        track.rangeMin = glm::min(track.rangeMin, valueAt(frame));
+        rangeMax = glm::max(rangeMax, valueAt(frame));
+    }
+    track.rangeStep = (rangeMax - track.rangeMin) / 65535.0f;
+
+    std::vector<QuantizedKey> quantized(raw.frameCount);
+    std::vector<glm::vec3> decoded(raw.frameCount);
+    for (uint32_t frame = 0; frame < raw.frameCount; ++frame) {
+        quantized[frame] = encodeVector(valueAt(frame), track);
+        decoded[frame] = decodeVector(quantized[frame].values, track);
+    }
+
+    const std::vector<uint32_t> frames = fitKeys(raw.frameCount, tolerance, [&](uint32_t a, uint32_t b, uint32_t frame) {
+        const float t = b > a ? static_cast<float>(frame - a) / static_cast<float>(b - a) : 0.0f;
+        const glm::vec3 difference = glm::mix(decoded[a], decoded[b], t) - valueAt(frame);
+        if (isScale) {
+            const glm::vec3 absolute = glm::abs(difference);
+            return std::max(absolute.x, std::max(absolute.y, absolute.z));
+        }
+        return glm::length(difference);
+    });
+    appendKeys(channel, track, frames, quantized);
+}
+
+bool validateChannel(const AnimationClip::ChannelData& channel, uint32_t frameCount, std::string& error) {
+    const size_t keyCount = channel.keyFrames.size();
+    for (const AnimationClip::Track& track : channel.tracks) {
+        if (track.keyCount == 0 || track.firstKey > keyCount || track.keyCount > keyCount - track.firstKey) {
+            error = "track range out of bounds";
+            return false;
+        }
+        const uint16_t* frames = channel.keyFrames.data() + track.firstKey;
+        if (track.keyCount > 1 && (frames[0] != 0 || frames[track.keyCount - 1] != frameCount - 1)) {
+            error = "track does not span the clip";
+            return false;
+        }
+        for (uint32_t key = 1; key < track.keyCount; ++key) {
+            if (frames[key] <= frames[key - 1]) {
+                error = "key frames out of order";
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+} // anonymous namespace
+
+AnimationClip AnimationClip::compress(const RawAnimation& raw, const CompressOptions& options) {
+    PROFILE_ZONE("AnimationClip::compress");
+    if (raw.frameCount == 0 || raw.frameCount > MAX_FRAMES || raw.jointCount > Skeleton::MAX_JOINTS ||
+        raw.frames.size() != static_cast<size_t>(raw.frameCount) * raw.jointCount) {
+        throw std::runtime_error("Animation " + raw.name + " has no frames, too many frames or joints, or missing frames");
+    }
+
+    AnimationClip clip;
+    clip.name = raw.name;
+    clip.sampleRate = raw.sampleRate;
+    clip.jointCount = raw.jointCount;
+    clip.frameCount = raw.frameCount;
+    for (uint32_t joint = 0; joint < raw.jointCount; ++joint) {
+        compressRotations(raw, joint, options.rotationTolerance, clip.channels[ROTATION]);
+        compressVectors(raw, joint, options.translationTolerance, false, clip.channels[TRANSLATION]);
+        compressVectors(raw, joint, options.scaleTolerance, true, clip.channels[SCALE]);
+    }
+    return clip;
+}
+
+float AnimationClip::measureError(const RawAnimation& raw, const AnimationClip& clip, const Skeleton& skeleton) {
+    if (raw.jointCount != skeleton.getJointCount() || clip.jointCount != skeleton.getJointCount() ||
+        raw.frameCount != clip.frameCount) {
+        throw std::runtime_error("Animation " + raw.name + " does not match the clip or the skeleton");
+    }
+
+    AnimationPose rawPose;
+    AnimationPose clipPose;
+    rawPose.resize(raw.jointCount);
+    clipPose.resize(raw.jointCount);
+    std::vector<glm::mat4> rawModels(raw.jointCount);
+    std::vector<glm::mat4> clipModels(raw.jointCount);
+    AnimationSampler sampler;
+    sampler.setClip(&clip);
+
+    float maxError = 0.0f;
+    for (uint32_t frame = 0; frame < raw.frameCount; ++frame) {
+        for (uint32_t joint = 0; joint < raw.jointCount; ++joint) {
+            rawPose.setJoint(joint, raw.at(frame, joint));
+        }
+        sampler.sample(static_cast<float>(frame) / clip.sampleRate, clipPose);
+        rawPose.localToModel(skeleton, rawModels.data());
+        clipPose.localToModel(skeleton, clipModels.data());
+        for (uint32_t joint = 0; joint < raw.jointCount; ++joint) {
+            maxError = std::max(maxError, glm::length(glm::vec3(rawModels[joint][3] - clipModels[joint][3])));
+        }
+    }
+    return maxError;
+}
+
+size_t AnimationClip::getKeyCount() const {
+    size_t keys = 0;
+    for (const ChannelData& channel : channels) {
+        keys += channel.keyFrames.size();
+    }
+    return keys;
+}
+
+size_t AnimationClip::getCompressedSize() const {
+    size_t size = sizeof(MAGIC) + sizeof(VERSION) + sizeof(sampleRate) + sizeof(jointCount) + sizeof(frameCount) +
+                  sizeof(uint16_t) + name.size();
+    for (const ChannelData& channel : channels) {
+        size += sizeof(uint32_t) + channel.tracks.size() * sizeof(Track) +
+                (channel.keyFrames.size() + channel.keyValues.size()) * sizeof(uint16_t);
+    }
+    return size;
+}
+
+void AnimationClip::serialize(std::vector<char>& data) const {
+    data.insert(data.end(), MAGIC, MAGIC + sizeof(MAGIC));
+    putValue(data, VERSION);
+    putValue(data, sampleRate);
+    putValue(data, jointCount);
+    putValue(data, frameCount);
+    putValue(data, static_cast<uint16_t>(name.size()));
+    data.insert(data.end(), name.begin(), name.end());
+    for (const ChannelData& channel : channels) {
+        putValue(data, static_cast<uint32_t>(channel.keyFrames.size()));
+        putArray(data, channel.tracks);
+        putArray(data, channel.keyFrames);
+        putArray(data, channel.keyValues);
+    }
+}
+
+bool AnimationClip::deserialize(const std::vector<char>& data, AnimationClip& clip, std::string& error) {
+    Reader reader(data);
+    for (char expected : MAGIC) {
+        if (reader.get<char>() != expected) {
+            error = "not an animation clip";
+            return false;
+        }
+    }
+    const uint32_t version = reader.get<uint32_t>();
+    if (version != VERSION) {
+        error = "unsupported animation clip version " + std::to_string(version);
+        return false;
+    }
+
+    clip = AnimationClip();
+    clip.sampleRate = reader.get<float>();
+    clip.jointCount = reader.get<uint32_t>();
+    clip.frameCount = reader.get<uint32_t>();
+    clip.name = reader.getString(reader.get<uint16_t>());
+    if (clip.jointCount > Skeleton::MAX_JOINTS || clip.frameCount == 0 || clip.frameCount > MAX_FRAMES ||
+        !(clip.sampleRate > 0.0f)) {
+        error = "bad joint count, frame count or sample rate";
+        return false;
+    }
+    for (ChannelData& channel : clip.channels) {
+        const uint32_t keyCount = reader.get<uint32_t>();
+        reader.getArray(channel.tracks, clip.jointCount);
+        reader.getArray(channel.keyFrames, keyCount);
+        reader.getArray(channel.keyValues, static_cast<uint64_t>(keyCount) * 3);
+    }
+    if (reader.failed() || !reader.atEnd()) {
+        error = "truncated or oversized animation clip";
+        return false;
+    }
+    for (const ChannelData& channel : clip.channels) {
+        if (!validateChannel(channel, clip.frameCount, error)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool AnimationClip::save(const std::string& path) const {
+    std::vector<char> data;
+    serialize(data);
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(data.data(), static_cast<std::streamsize>(data.size()));
+    if (!file) {
+        LOG_ERROR("Cannot write animation clip " + path, "AnimationClip");
+        return false;
+    }
+    return true;
+}
+
+bool AnimationClip::load(const std::string& path, AnimationClip& clip, std::string& error) {
+    PROFILE_ZONE("AnimationClip::load");
+    std::vector<char> data;
+    if (!AssetFileSystem::getInstance().readFile(path, data)) {
+        error = "Cannot open animation clip " + path;
+        return false;
+    }
+    if (!deserialize(data, clip, error)) {
+        error = path + ": " + error;
+        return false;
+    }
+    return true;
+}
+
+} // namespace VulkanGameEngine
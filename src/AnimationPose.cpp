@@ -0,0 +1,641 @@
+#include "../headers/AnimationPose.h"
+#include "../headers/AnimationClip.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ANIMATION_SSE2
+#include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define ANIMATION_NEON
+#include <arm_neon.h>
+#endif
+
+namespace VulkanGameEngine {
+
+namespace {
+
+// --- Four-lane float operations -----------------------------------------------
+
+#if defined(ANIMATION_SSE2)
+
+using Float4 = __m128;
+using Mask4 = __m128;
+
+Float4 load4(const float* source) { return _mm_load_ps(source); }
+Float4 loadUnaligned4(const float* source) { return _mm_loadu_ps(source); }
+void store4(float* destination, Float4 x) { _mm_store_ps(destination, x); }
+void storeUnaligned4(float* destination, Float4 x) { _mm_storeu_ps(destination, x); }
+Float4 loadInts4(const int32_t* source) { return _mm_cvtepi32_ps(_mm_load_si128(reinterpret_cast<const __m128i*>(source))); }
+Float4 splat4(float value) { return _mm_set1_ps(value); }
+Float4 add4(Float4 a, Float4 b) { return _mm_add_ps(a, b); }
+Float4 sub4(Float4 a, Float4 b) { return _mm_sub_ps(a, b); }
+Float4 mul4(Float4 a, Float4 b) { return _mm_mul_ps(a, b); }
+Float4 max4(Float4 a, Float4 b) { return _mm_max_ps(a, b); }
+Float4 sqrt4(Float4 x) { return _mm_sqrt_ps(x); }
+Mask4 less4(Float4 a, Float4 b) { return _mm_cmplt_ps(a, b); }
+Mask4 lessEqual4(Float4 a, Float4 b) { return _mm_cmple_ps(a, b); }
+Mask4 equal4(Float4 a, Float4 b) { return _mm_cmpeq_ps(a, b); }
+Mask4 or4(Mask4 a, Mask4 b) { return _mm_or_ps(a, b); }
+bool any4(Mask4 mask) { return _mm_movemask_ps(mask) != 0; }
+Float4 select4(Mask4 mask, Float4 a, Float4 b) { return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); }
+Float4 negateWhere4(Mask4 mask, Float4 x) { return _mm_xor_ps(x, _mm_and_ps(mask, _mm_set1_ps(-0.0f))); }
+
+/**
+ * 1/sqrt(x): the hardware estimate refined by one Newton-Raphson step (about 22 bits)
+ */
+Float4 rsqrt4(Float4 x) {
+    const Float4 estimate = _mm_rsqrt_ps(x);
+    const Float4 halfXEstimateSquared = _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(0.5f), x), _mm_mul_ps(estimate, estimate));
+    return _mm_mul_ps(estimate, _mm_sub_ps(_mm_set1_ps(1.5f), halfXEstimateSquared));
+}
+
+template <int Lane>
+Float4 splatLane4(Float4 x) {
+    return _mm_shuffle_ps(x, x, _MM_SHUFFLE(Lane, Lane, Lane, Lane));
+}
+
+void transpose4(Float4& a, Float4& b, Float4& c, Float4& d) {
+    _MM_TRANSPOSE4_PS(a, b, c, d);
+}
+
+#elif defined(ANIMATION_NEON)
+
+using Float4 = float32x4_t;
+using Mask4 = uint32x4_t;
+
+Float4 load4(const float* source) { return vld1q_f32(source); }
+Float4 loadUnaligned4(const float* source) { return vld1q_f32(source); }
+void store4(float* destination, Float4 x) { vst1q_f32(destination, x); }
+void storeUnaligned4(float* destination, Float4 x) { vst1q_f32(destination, x); }
+Float4 loadInts4(const int32_t* source) { return vcvtq_f32_s32(vld1q_s32(source)); }
+Float4 splat4(float value) { return vdupq_n_f32(value); }
+Float4 add4(Float4 a, Float4 b) { return vaddq_f32(a, b); }
+Float4 sub4(Float4 a, Float4 b) { return vsubq_f32(a, b); }
+Float4 mul4(Float4 a, Float4 b) { return vmulq_f32(a, b); }
+Float4 max4(Float4 a, Float4 b) { return vmaxq_f32(a, b); }
+Float4 sqrt4(Float4 x) { return vsqrtq_f32(x); }
+Mask4 less4(Float4 a, Float4 b) { return vcltq_f32(a, b); }
+Mask4 lessEqual4(Float4 a, Float4 b) { return vcleq_f32(a, b); }
+Mask4 equal4(Float4 a, Float4 b) { return vceqq_f32(a, b); }
+Mask4 or4(Mask4 a, Mask4 b) { return vorrq_u32(a, b); }
+bool any4(Mask4 mask) { return vmaxvq_u32(mask) != 0; }
+Float4 select4(Mask4 mask, Float4 a, Float4 b) { return vbslq_f32(mask, a, b); }
+Float4 negateWhere4(Mask4 mask, Float4 x) {
+    return vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(x), vandq_u32(mask, vdupq_n_u32(0x80000000u))));
+}
+
+Float4 rsqrt4(Float4 x) {
+    const Float4 estimate = vrsqrteq_f32(x);
+    return vmulq_f32(estimate, vrsqrtsq_f32(vmulq_f32(x, estimate), estimate));
+}
+
+template <int Lane>
+Float4 splatLane4(Float4 x) {
+    return vdupq_laneq_f32(x, Lane);
+}
+
+void transpose4(Float4& a, Float4& b, Float4& c, Float4& d) {
+    const float32x4x2_t ab = vtrnq_f32(a, b);   // a0 b0 a2 b2, a1 b1 a3 b3
+    const float32x4x2_t cd = vtrnq_f32(c, d);
+    a = vcombine_f32(vget_low_f32(ab.val[0]), vget_low_f32(cd.val[0]));
+    b = vcombine_f32(vget_low_f32(ab.val[1]), vget_low_f32(cd.val[1]));
+    c = vcombine_f32(vget_high_f32(ab.val[0]), vget_high_f32(cd.val[0]));
+    d = vcombine_f32(vget_high_f32(ab.val[1]), vget_high_f32(cd.val[1]));
+}
+
+#else
+
+struct Float4 {
+    float lanes[4];
+};
+struct Mask4 {
+    bool lanes[4];
+};
+
+#define ANIMATION_LANEWISE(result, expression) \
+    for (int i = 0; i < 4; ++i) {                \
+        result.lanes[i] = (expression);          \
+    }
+
+Float4 load4(const float* source) { Float4 r; ANIMATION_LANEWISE(r, source[i]) return r; }
+Float4 loadUnaligned4(const float* source) { return load4(source); }
+void store4(float* destination, Float4 x) { std::copy(x.lanes, x.lanes + 4, destination); }
+void storeUnaligned4(float* destination, Float4 x) { store4(destination, x); }
+Float4 loadInts4(const int32_t* source) { Float4 r; ANIMATION_LANEWISE(r, static_cast<float>(source[i])) return r; }
+Float4 splat4(float value) { Float4 r; ANIMATION_LANEWISE(r, value) return r; }
+Float4 add4(Float4 a, Float4 b) { Float4 r; ANIMATION_LANEWISE(r, a.lanes[i] + b.lanes[i]) return r; }
+Float4 sub4(Float4 a, Float4 b) { Float4 r; ANIMATION_LANEWISE(r, a.lanes[i] - b.lanes[i]) return r; }
+Float4 mul4(Float4 a, Float4 b) { Float4 r; ANIMATION_LANEWISE(r, a.lanes[i] * b.lanes[i]) return r; }
+Float4 max4(Float4 a, Float4 b) { Float4 r; ANIMATION_LANEWISE(r, std::max(a.lanes[i], b.lanes[i])) return r; }
+Float4 sqrt4(Float4 x) { Float4 r; ANIMATION_LANEWISE(r, std::sqrt(x.lanes[i])) return r; }
+Float4 rsqrt4(Float4 x) { Float4 r; ANIMATION_LANEWISE(r, 1.0f / std::sqrt(x.lanes[i])) return r; }
+Mask4 less4(Float4 a, Float4 b) { Mask4 r; ANIMATION_LANEWISE(r, a.lanes[i] < b.lanes[i]) return r; }
+Mask4 lessEqual4(Float4 a, Float4 b) { Mask4 r; ANIMATION_LANEWISE(r, a.lanes[i] <= b.lanes[i]) return r; }
+Mask4 equal4(Float4 a, Float4 b) { Mask4 r; ANIMATION_LANEWISE(r, a.lanes[i] == b.lanes[i]) return r; }
+Mask4 or4(Mask4 a, Mask4 b) { Mask4 r; ANIMATION_LANEWISE(r, a.lanes[i] || b.lanes[i]) return r; }
+bool any4(Mask4 mask) { return mask.lanes[0] || mask.lanes[1] || mask.lanes[2] || mask.lanes[3]; }
+Float4 select4(Mask4 mask, Float4 a, Float4 b) { Float4 r; ANIMATION_LANEWISE(r, mask.lanes[i] ? a.lanes[i] : b.lanes[i]) return r; }
+Float4 negateWhere4(Mask4 mask, Float4 x) { Float4 r; ANIMATION_LANEWISE(r, mask.lanes[i] ? -x.lanes[i] : x.lanes[i]) return r; }
+
+#undef ANIMATION_LANEWISE
+
+template <int Lane>
+Float4 splatLane4(Float4 x) {
+    return splat4(x.lanes[Lane]);
+}
+
+void transpose4(Float4& a, Float4& b, Float4& c, Float4& d) {
+    Float4* rows[4] = {&a, &b, &c, &d};
+    for (int i = 0; i < 4; ++i) {
+        for (int j = i + 1; j < 4; ++j) {
+            std::swap(rows[i]->lanes[j], rows[j]->lanes[i]);
+        }
+    }
+}
+
+#endif
+
+Float4 madd4(Float4 a, Float4 b, Float4 c) {
+    return add4(mul4(a, b), c);
+}
+
+struct Quat4 {
+    Float4 x, y, z, w;
+};
+
+struct Vec4x3 {
+    Float4 x, y, z;
+};
+
+Float4 dot4(const Quat4& a, const Quat4& b) {
+    return madd4(a.x, b.x, madd4(a.y, b.y, madd4(a.z, b.z, mul4(a.w, b.w))));
+}
+
+Quat4 normalize4(const Quat4& q) {
+    const Float4 scale = rsqrt4(dot4(q, q));
+    return {mul4(q.x, scale), mul4(q.y, scale), mul4(q.z, scale), mul4(q.w, scale)};
+}
+
+Quat4 loadRotation(const SoaTransform& transform) {
+    return {load4(transform.rotationX), load4(transform.rotationY), load4(transform.rotationZ), load4(transform.rotationW)};
+}
+
+Vec4x3 loadTranslation(const SoaTransform& transform) {
+    return {load4(transform.translationX), load4(transform.translationY), load4(transform.translationZ)};
+}
+
+Vec4x3 loadScale(const SoaTransform& transform) {
+    return {load4(transform.scaleX), load4(transform.scaleY), load4(transform.scaleZ)};
+}
+
+void storeRotation(SoaTransform& transform, const Quat4& q) {
+    store4(transform.rotationX, q.x);
+    store4(transform.rotationY, q.y);
+    store4(transform.rotationZ, q.z);
+    store4(transform.rotationW, q.w);
+}
+
+void storeTranslation(SoaTransform& transform, const Vec4x3& v) {
+    store4(transform.translationX, v.x);
+    store4(transform.translationY, v.y);
+    store4(transform.translationZ, v.z);
+}
+
+void storeScale(SoaTransform& transform, const Vec4x3& v) {
+    store4(transform.scaleX, v.x);
+    store4(transform.scaleY, v.y);
+    store4(transform.scaleZ, v.z);
+}
+
+/**
+ * out = a * b for column-major 4x4 matrices (out may not alias b)
+ */
+void multiplyMatrices(const float* a, const float* b, float* out) {
+    const Float4 a0 = loadUnaligned4(a);
+    const Float4 a1 = loadUnaligned4(a + 4);
+    const Float4 a2 = loadUnaligned4(a + 8);
+    const Float4 a3 = loadUnaligned4(a + 12);
+    for (int column = 0; column < 4; ++column) {
+        const Float4 b4 = loadUnaligned4(b + 4 * column);
+        const Float4 result = madd4(a0, splatLane4<0>(b4), madd4(a1, splatLane4<1>(b4),
+                                    madd4(a2, splatLane4<2>(b4), mul4(a3, splatLane4<3>(b4)))));
+        storeUnaligned4(out + 4 * column, result);
+    }
+}
+
+SoaTransform makeIdentitySoa() {
+    SoaTransform transform = {};
+    std::fill(transform.rotationW, transform.rotationW + 4, 1.0f);
+    std::fill(transform.scaleX, transform.scaleX + 4, 1.0f);
+    std::fill(transform.scaleY, transform.scaleY + 4, 1.0f);
+    std::fill(transform.scaleZ, transform.scaleZ + 4, 1.0f);
+    return transform;
+}
+
+/**
+ * Puts the lanes past the last joint back to the identity
+ */
+void resetPadding(SoaTransform* joints, uint32_t jointCount) {
+    if (jointCount % 4 == 0) {
+        return;
+    }
+    SoaTransform& last = joints[jointCount / 4];
+    for (uint32_t lane = jointCount % 4; lane < 4; ++lane) {
+        last.rotationX[lane] = last.rotationY[lane] = last.rotationZ[lane] = 0.0f;
+        last.rotationW[lane] = 1.0f;
+        last.translationX[lane] = last.translationY[lane] = last.translationZ[lane] = 0.0f;
+        last.scaleX[lane] = last.scaleY[lane] = last.scaleZ[lane] = 1.0f;
+    }
+}
+
+// --- Sampling -------------------------------------------------------------------
+
+using KeyCache = AnimationSampler::KeyCache;
+
+/**
+ * Quantized keys of four joints of one channel, gathered lane by lane for the SIMD decoders
+ */
+struct alignas(16) KeyLanes {
+    int32_t values[2][3][4];                // Left, right key (rotations: without the index bits)
+    float largest[2][4];                    // Rotations: index of the dropped component
+    float rangeMin[3][4];                   // Translations and scales
+    float rangeStep[3][4];
+};
+
+/**
+ * Rebuilds four smallest-three rotations: the dropped component from the
+ * unit length, then every component moved to its slot by the dropped index
+ */
+Quat4 decodeRotations(const int32_t (&values)[3][4], const float* largestIndex) {
+    const Float4 step = splat4(AnimationClip::ROTATION_STEP);
+    const Float4 offset = splat4(AnimationClip::ROTATION_COMPONENT_MAX);
+    const Float4 a = sub4(mul4(loadInts4(values[0]), step), offset);
+    const Float4 b = sub4(mul4(loadInts4(values[1]), step), offset);
+    const Float4 c = sub4(mul4(loadInts4(values[2]), step), offset);
+    const Float4 sumSquares = madd4(a, a, madd4(b, b, mul4(c, c)));
+    const Float4 d = sqrt4(max4(splat4(0.0f), sub4(splat4(1.0f), sumSquares)));
+
+    const Float4 largest = load4(largestIndex);
+    const Mask4 is0 = equal4(largest, splat4(0.0f));
+    const Mask4 is1 = equal4(largest, splat4(1.0f));
+    const Mask4 is2 = equal4(largest, splat4(2.0f));
+    const Mask4 is3 = equal4(largest, splat4(3.0f));
+    Quat4 q;
+    q.x = select4(is0, d, a);
+    q.y = select4(is0, a, select4(is1, d, b));
+    q.z = select4(or4(is0, is1), b, select4(is2, d, c));
+    q.w = select4(is3, d, c);
+    return q;
+}
+
+/**
+ * Finds the key segment containing frame: the returned left key satisfies
+ * frames[left] <= frame < frames[left + 1], or left + 1 is the last key.
+ * The search starts from the cached segment: playing forward usually moves
+ * it by one key, anything else falls back to a binary search.
+ */
+uint32_t findSegment(const uint16_t* frames, uint32_t keyCount, float frame, uint32_t cursor) {
+    const uint32_t lastKey = keyCount - 1;
+    uint32_t left = std::min(cursor, lastKey - 1);
+    if (static_cast<float>(frames[left]) <= frame) {
+        for (int step = 0; step < 4 && left + 1 < lastKey && static_cast<float>(frames[left + 1]) <= frame; ++step) {
+            ++left;
+        }
+    }
+    if (static_cast<float>(frames[left]) > frame || (left + 1 < lastKey && static_cast<float>(frames[left + 1]) <= frame)) {
+        const uint16_t* next = std::upper_bound(frames + 1, frames + lastKey, frame,
+                                                [](float value, uint16_t key) { return value < static_cast<float>(key); });
+        left = static_cast<uint32_t>(next - frames - 1);
+    }
+    return left;
+}
+
+/**
+ * Moves the tracks of one channel and block whose segment no longer holds
+ * frame onto the right keys, then decodes the block's keys into the cache
+ */
+void refreshKeys(const AnimationClip& clip, AnimationClip::Channel channelIndex, uint32_t block, float frame,
+                 uint32_t* cursors, KeyCache& cache) {
+    const AnimationClip::ChannelData& channel = clip.channels[channelIndex];
+    const bool rotation = channelIndex == AnimationClip::ROTATION;
+    KeyLanes lanes;
+    for (uint32_t lane = 0; lane < 4; ++lane) {
+        const uint32_t joint = block * 4 + lane;
+        if (joint >= clip.jointCount) {
+            // Padding lanes decode to anything finite; resetPadding overwrites them
+            for (int component = 0; component < 3; ++component) {
+                lanes.values[0][component][lane] = lanes.values[1][component][lane] = 0;
+                lanes.rangeMin[component][lane] = lanes.rangeStep[component][lane] = 0.0f;
+            }
+            lanes.largest[0][lane] = lanes.largest[1][lane] = 3.0f;
+            continue;
+        }
+
+        const AnimationClip::Track& track = channel.tracks[joint];
+        const uint16_t* frames = channel.keyFrames.data() + track.firstKey;
+        uint32_t& left = cursors[joint];
+        if (track.keyCount == 1) {
+            left = 0;
+            cache.startFrame[channelIndex][lane] = -FLT_MAX;
+            cache.endFrame[channelIndex][lane] = FLT_MAX;
+            cache.inverseLength[channelIndex][lane] = 0.0f;
+        } else if (!(frame >= cache.startFrame[channelIndex][lane] && frame < cache.endFrame[channelIndex][lane])) {
+            left = findSegment(frames, track.keyCount, frame, left);
+            const float start = static_cast<float>(frames[left]);
+            const float end = static_cast<float>(frames[left + 1]);
+            cache.startFrame[channelIndex][lane] = start;
+            cache.endFrame[channelIndex][lane] = left + 2 < track.keyCount ? end : FLT_MAX;
+            cache.inverseLength[channelIndex][lane] = 1.0f / (end - start);
+        }
+
+        const uint32_t right = std::min(left + 1, track.keyCount - 1);
+        const uint16_t* keys[2] = {channel.keyValues.data() + 3 * (static_cast<size_t>(track.firstKey) + left),
+                                   channel.keyValues.data() + 3 * (static_cast<size_t>(track.firstKey) + right)};
+        for (int side = 0; side < 2; ++side) {
+            for (int component = 0; component < 3; ++component) {
+                lanes.values[side][component][lane] = rotation ? keys[side][component] & 0x7FFF : keys[side][component];
+            }
+            lanes.largest[side][lane] = static_cast<float>((keys[side][0] >> 15) | ((keys[side][1] >> 15) << 1));
+        }
+        for (int component = 0; component < 3; ++component) {
+            lanes.rangeMin[component][lane] = track.rangeMin[component];
+            lanes.rangeStep[component][lane] = track.rangeStep[component];
+        }
+    }
+
+    if (rotation) {
+        const Quat4 left = decodeRotations(lanes.values[0], lanes.largest[0]);
+        Quat4 right = decodeRotations(lanes.values[1], lanes.largest[1]);
+        // Interpolating towards -right instead takes the shorter way round
+        const Mask4 opposite = less4(dot4(left, right), splat4(0.0f));
+        right = {negateWhere4(opposite, right.x), negateWhere4(opposite, right.y), negateWhere4(opposite, right.z),
+                 negateWhere4(opposite, right.w)};
+        const Quat4 keys[2] = {left, right};
+        for (int side = 0; side < 2; ++side) {
+            store4(cache.rotation[side][0], keys[side].x);
+            store4(cache.rotation[side][1], keys[side].y);
+            store4(cache.rotation[side][2], keys[side].z);
+            store4(cache.rotation[side][3], keys[side].w);
+        }
+        return;
+    }
+
+    float (&values)[2][3][4] = channelIndex == AnimationClip::TRANSLATION ? cache.translation : cache.scale;
+    for (int component = 0; component < 3; ++component) {
+        const Float4 rangeMin = load4(lanes.rangeMin[component]);
+        const Float4 rangeStep = load4(lanes.rangeStep[component]);
+        for (int side = 0; side < 2; ++side) {
+            store4(values[side][component], madd4(loadInts4(lanes.values[side][component]), rangeStep, rangeMin));
+        }
+    }
+}
+
+/**
+ * Interpolation ratios of one channel's four tracks at frame
+ */
+Float4 segmentRatio(const KeyCache& cache, int channel, Float4 frame) {
+    return mul4(sub4(frame, load4(cache.startFrame[channel])), load4(cache.inverseLength[channel]));
+}
+
+bool segmentsHold(const KeyCache& cache, int channel, Float4 frame) {
+    return !any4(or4(less4(frame, load4(cache.startFrame[channel])), lessEqual4(load4(cache.endFrame[channel]), frame)));
+}
+
+Vec4x3 interpolateVectors(const float (&values)[2][3][4], Float4 t) {
+    Float4 result[3];
+    for (int component = 0; component < 3; ++component) {
+        const Float4 left = load4(values[0][component]);
+        result[component] = madd4(sub4(load4(values[1][component]), left), t, left);
+    }
+    return {result[0], result[1], result[2]};
+}
+
+} // anonymous namespace
+
+// --- AnimationPose ----------------------------------------------------------------
+
+void AnimationPose::resize(uint32_t jointCount) {
+    m_jointCount = jointCount;
+    m_joints.assign((jointCount + 3) / 4, makeIdentitySoa());
+}
+
+void AnimationPose::setBindPose(const Skeleton& skeleton) {
+    resize(skeleton.getJointCount());
+    for (uint32_t joint = 0; joint < skeleton.getJointCount(); ++joint) {
+        setJoint(joint, skeleton.bindPose[joint]);
+    }
+}
+
+JointTransform AnimationPose::getJoint(uint32_t joint) const {
+    const SoaTransform& block = m_joints[joint / 4];
+    const uint32_t lane = joint % 4;
+    JointTransform transform;
+    transform.rotation = glm::quat(block.rotationW[lane], block.rotationX[lane], block.rotationY[lane], block.rotationZ[lane]);
+    transform.translation = glm::vec3(block.translationX[lane], block.translationY[lane], block.translationZ[lane]);
+    transform.scale = glm::vec3(block.scaleX[lane], block.scaleY[lane], block.scaleZ[lane]);
+    return transform;
+}
+
+void AnimationPose::setJoint(uint32_t joint, const JointTransform& transform) {
+    SoaTransform& block = m_joints[joint / 4];
+    const uint32_t lane = joint % 4;
+    block.rotationX[lane] = transform.rotation.x;
+    block.rotationY[lane] = transform.rotation.y;
+    block.rotationZ[lane] = transform.rotation.z;
+    block.rotationW[lane] = transform.rotation.w;
+    block.translationX[lane] = transform.translation.x;
+    block.translationY[lane] = transform.translation.y;
+    block.translationZ[lane] = transform.translation.z;
+    block.scaleX[lane] = transform.scale.x;
+    block.scaleY[lane] = transform.scale.y;
+    block.scaleZ[lane] = transform.scale.z;
+}
+
+void AnimationPose::localToModel(const Skeleton& skeleton, glm::mat4* models) const {
+    const uint16_t* parents = skeleton.parents.data();
+    alignas(16) float locals[4][16];        // The block's four local matrices, column-major
+
+    for (uint32_t block = 0; block < m_joints.size(); ++block) {
+        const SoaTransform& transform = m_joints[block];
+        const Quat4 q = loadRotation(transform);
+        const Vec4x3 t = loadTranslation(transform);
+        const Vec4x3 s = loadScale(transform);
+
+        // Rotation matrix terms of all four joints at once
+        const Float4 two = splat4(2.0f);
+        const Float4 one = splat4(1.0f);
+        const Float4 x2 = mul4(q.x, two);
+        const Float4 y2 = mul4(q.y, two);
+        const Float4 z2 = mul4(q.z, two);
+        const Float4 xx = mul4(q.x, x2);
+        const Float4 yy = mul4(q.y, y2);
+        const Float4 zz = mul4(q.z, z2);
+        const Float4 xy = mul4(q.x, y2);
+        const Float4 xz = mul4(q.x, z2);
+        const Float4 yz = mul4(q.y, z2);
+        const Float4 wx = mul4(q.w, x2);
+        const Float4 wy = mul4(q.w, y2);
+        const Float4 wz = mul4(q.w, z2);
+
+        Float4 c0x = mul4(sub4(one, add4(yy, zz)), s.x);
+        Float4 c0y = mul4(add4(xy, wz), s.x);
+        Float4 c0z = mul4(sub4(xz, wy), s.x);
+        Float4 c1x = mul4(sub4(xy, wz), s.y);
+        Float4 c1y = mul4(sub4(one, add4(xx, zz)), s.y);
+        Float4 c1z = mul4(add4(yz, wx), s.y);
+        Float4 c2x = mul4(add4(xz, wy), s.z);
+        Float4 c2y = mul4(sub4(yz, wx), s.z);
+        Float4 c2z = mul4(sub4(one, add4(xx, yy)), s.z);
+        Float4 c3x = t.x;
+        Float4 c3y = t.y;
+        Float4 c3z = t.z;
+        Float4 zero0 = splat4(0.0f);
+        Float4 zero1 = zero0;
+        Float4 zero2 = zero0;
+        Float4 w3 = one;
+
+        // SoA to one matrix per joint: after each transpose, register k holds joint k's column
+        transpose4(c0x, c0y, c0z, zero0);
+        transpose4(c1x, c1y, c1z, zero1);
+        transpose4(c2x, c2y, c2z, zero2);
+        transpose4(c3x, c3y, c3z, w3);
+        const Float4 columns[4][4] = {{c0x, c1x, c2x, c3x}, {c0y, c1y, c2y, c3y}, {c0z, c1z, c2z, c3z},
+                                      {zero0, zero1, zero2, w3}};
+
+        for (uint32_t lane = 0; lane < 4; ++lane) {
+            const uint32_t joint = block * 4 + lane;
+            if (joint >= m_jointCount) {
+                break;
+            }
+            float* model = &models[joint][0][0];
+            if (parents[joint] == Skeleton::NO_PARENT) {
+                for (int column = 0; column < 4; ++column) {
+                    storeUnaligned4(model + 4 * column, columns[lane][column]);
+                }
+            } else {
+                for (int column = 0; column < 4; ++column) {
+                    store4(locals[lane] + 4 * column, columns[lane][column]);
+                }
+                multiplyMatrices(&models[parents[joint]][0][0], locals[lane], model);
+            }
+        }
+    }
+}
+
+void AnimationPose::blend(const BlendLayer* layers, size_t layerCount, const AnimationPose& restPose,
+                          AnimationPose& output) {
+    float totalWeight = 0.0f;
+    for (size_t layer = 0; layer < layerCount; ++layer) {
+        totalWeight += std::max(0.0f, layers[layer].weight);
+    }
+    const float restWeight = std::max(0.0f, 1.0f - totalWeight);
+    const Float4 inverseTotal = splat4(1.0f / std::max(1.0f, totalWeight));
+    const AnimationPose& reference = layerCount > 0 ? *layers[0].pose : restPose;
+
+    for (uint32_t block = 0; block < output.m_joints.size(); ++block) {
+        const Quat4 referenceRotation = loadRotation(reference.m_joints[block]);
+        Quat4 rotation = {splat4(0.0f), splat4(0.0f), splat4(0.0f), splat4(0.0f)};
+        Vec4x3 translation = {splat4(0.0f), splat4(0.0f), splat4(0.0f)};
+        Vec4x3 scale = translation;
+
+        auto accumulate = [&](const SoaTransform& input, float weight) {
+            const Float4 w = splat4(weight);
+            const Quat4 q = loadRotation(input);
+            // Quaternions on the far side of the reference are flipped so the sum takes the short way
+            const Float4 signedW = negateWhere4(less4(dot4(q, referenceRotation), splat4(0.0f)), w);
+            rotation = {madd4(q.x, signedW, rotation.x), madd4(q.y, signedW, rotation.y),
+                        madd4(q.z, signedW, rotation.z), madd4(q.w, signedW, rotation.w)};
+            const Vec4x3 t = loadTranslation(input);
+            translation = {madd4(t.x, w, translation.x), madd4(t.y, w, translation.y), madd4(t.z, w, translation.z)};
+            const Vec4x3 s = loadScale(input);
+            scale = {madd4(s.x, w, scale.x), madd4(s.y, w, scale.y), madd4(s.z, w, scale.z)};
+        };
+        for (size_t layer = 0; layer < layerCount; ++layer) {
+            if (layers[layer].weight > 0.0f) {
+                accumulate(layers[layer].pose->m_joints[block], layers[layer].weight);
+            }
+        }
+        if (restWeight > 0.0f) {
+            accumulate(restPose.m_joints[block], restWeight);
+        }
+
+        SoaTransform& result = output.m_joints[block];
+        storeRotation(result, normalize4(rotation));
+        storeTranslation(result, {mul4(translation.x, inverseTotal), mul4(translation.y, inverseTotal),
+                                  mul4(translation.z, inverseTotal)});
+        storeScale(result, {mul4(scale.x, inverseTotal), mul4(scale.y, inverseTotal), mul4(scale.z, inverseTotal)});
+    }
+}
+
+void AnimationPose::computeSkinningMatrices(const Skeleton& skeleton, const glm::mat4* models, glm::mat4* skinning) {
+    for (uint32_t joint = 0; joint < skeleton.getJointCount(); ++joint) {
+        multiplyMatrices(&models[joint][0][0], &skeleton.inverseBindMatrices[joint][0][0], &skinning[joint][0][0]);
+    }
+}
+
+// --- AnimationSampler -------------------------------------------------------------
+
+void AnimationSampler::setClip(const AnimationClip* clip) {
+    m_clip = clip;
+    if (!clip) {
+        m_cache.clear();
+        m_cursors.clear();
+        return;
+    }
+    m_cursors.assign(static_cast<size_t>(clip->jointCount) * AnimationClip::CHANNEL_COUNT, 0);
+
+    // Empty ranges make the first sample look every track up; padding lanes never need keys
+    KeyCache empty = {};
+    for (int channel = 0; channel < AnimationClip::CHANNEL_COUNT; ++channel) {
+        std::fill(empty.startFrame[channel], empty.startFrame[channel] + 4, 1.0f);
+        std::fill(empty.endFrame[channel], empty.endFrame[channel] + 4, 0.0f);
+    }
+    m_cache.assign((clip->jointCount + 3) / 4, empty);
+    if (clip->jointCount % 4 != 0) {
+        KeyCache& last = m_cache.back();
+        for (int channel = 0; channel < AnimationClip::CHANNEL_COUNT; ++channel) {
+            for (uint32_t lane = clip->jointCount % 4; lane < 4; ++lane) {
+                last.startFrame[channel][lane] = -FLT_MAX;
+                last.endFrame[channel][lane] = FLT_MAX;
+            }
+        }
+    }
+}
+
+void AnimationSampler::sample(float time, AnimationPose& output) {
+    const AnimationClip& clip = *m_clip;
+    const float lastFrame = static_cast<float>(clip.frameCount - 1);
+    const float frame = std::min(std::max(time * clip.sampleRate, 0.0f), lastFrame);
+    const Float4 frame4 = splat4(frame);
+    uint32_t* cursors[AnimationClip::CHANNEL_COUNT];
+    for (int channel = 0; channel < AnimationClip::CHANNEL_COUNT; ++channel) {
+        cursors[channel] = m_cursors.data() + static_cast<size_t>(channel) * clip.jointCount;
+    }
+
+    SoaTransform* joints = output.getSoaTransforms();
+    for (uint32_t block = 0; block < m_cache.size(); ++block) {
+        KeyCache& cache = m_cache[block];
+        for (int channel = 0; channel < AnimationClip::CHANNEL_COUNT; ++channel) {
+            if (!segmentsHold(cache, channel, frame4)) {
+                refreshKeys(clip, static_cast<AnimationClip::Channel>(channel), block, frame, cursors[channel], cache);
+            }
+        }
+
+        const Float4 t = segmentRatio(cache, AnimationClip::ROTATION, frame4);
+        Quat4 rotation;
+        Float4* components[4] = {&rotation.x, &rotation.y, &rotation.z, &rotation.w};
+        for (int component = 0; component < 4; ++component) {
+            const Float4 left = load4(cache.rotation[0][component]);
+            *components[component] = madd4(sub4(load4(cache.rotation[1][component]), left), t, left);
+        }
+        storeRotation(joints[block], normalize4(rotation));
+        storeTranslation(joints[block],
+                         interpolateVectors(cache.translation, segmentRatio(cache, AnimationClip::TRANSLATION, frame4)));
+        storeScale(joints[block], interpolateVectors(cache.scale, segmentRatio(cache, AnimationClip::SCALE, frame4)));
+    }
+    resetPadding(joints, clip.jointCount);
+}
+
+} // namespace VulkanGameEngine
@@ -0,0 +1,130 @@
+#include "../headers/AnimationSystem.h"
+#include "../headers/ThreadPool.h"
+#include "../headers/Profiler.h"
+#include <cmath>
+
+namespace VulkanGameEngine {
+
+namespace {
+
+/**
+ * Per-thread working poses, resized when a skeleton with another joint count comes along
+ */
+struct Scratch {
+    AnimationPose layers[AnimationSystem::MAX_LAYERS];
+    AnimationPose blended;
+    std::vector<glm::mat4> models;
+
+    void prepare(uint32_t jointCount) {
+        if (blended.getJointCount() == jointCount) {
+            return;
+        }
+        for (AnimationPose& pose : layers) {
+            pose.resize(jointCount);
+        }
+        blended.resize(jointCount);
+        models.resize(jointCount);
+    }
+};
+
+thread_local Scratch t_scratch;
+
+/**
+ * Moves a layer's time on, wrapping or clamping at the ends of the clip
+ */
+float advanceTime(float time, float step, float duration, bool loop) {
+    time += step;
+    if (duration <= 0.0f) {
+        return 0.0f;
+    }
+    if (loop) {
+        time = std::fmod(time, duration);
+        return time < 0.0f ? time + duration : time;
+    }
+    return std::min(std::max(time, 0.0f), duration);
+}
+
+} // anonymous namespace
+
+AnimationSystem::AnimationSystem(const Skeleton& skeleton) : m_skeleton(skeleton) {
+    m_bindPose.setBindPose(m_skeleton);
+}
+
+uint32_t AnimationSystem::addClip(AnimationClip clip) {
+    if (clip.jointCount != m_skeleton.getJointCount()) {
+        throw std::runtime_error("Animation clip " + clip.name + " has " + std::to_string(clip.jointCount) +
+                                 " joints, the skeleton has " + std::to_string(m_skeleton.getJointCount()));
+    }
+    m_clips.push_back(std::unique_ptr<AnimationClip>(new AnimationClip(std::move(clip))));
+    return static_cast<uint32_t>(m_clips.size() - 1);
+}
+
+uint32_t AnimationSystem::addCharacter() {
+    m_characters.emplace_back();
+    const uint32_t jointCount = m_skeleton.getJointCount();
+    std::vector<glm::mat4> models(jointCount);
+    m_bindPose.localToModel(m_skeleton, models.data());
+    m_skinningMatrices.resize(m_skinningMatrices.size() + jointCount);
+    AnimationPose::computeSkinningMatrices(m_skeleton, models.data(),
+                                           m_skinningMatrices.data() + m_skinningMatrices.size() - jointCount);
+    return static_cast<uint32_t>(m_characters.size() - 1);
+}
+
+void AnimationSystem::setLayer(uint32_t character, uint32_t layer, uint32_t clip, float weight, float speed, float time,
+                               bool loop) {
+    Character& target = m_characters[character];
+    target.layers[layer].clip = clip;
+    target.layers[layer].weight = weight;
+    target.layers[layer].speed = speed;
+    target.layers[layer].time = time;
+    target.layers[layer].loop = loop;
+    target.samplers[layer].setClip(clip == NO_CLIP ? nullptr : m_clips[clip].get());
+}
+
+void AnimationSystem::setLayerWeight(uint32_t character, uint32_t layer, float weight) {
+    m_characters[character].layers[layer].weight = weight;
+}
+
+void AnimationSystem::update(float deltaTime, ThreadPool& pool, size_t grainSize) {
+    PROFILE_ZONE("AnimationSystem::update");
+    pool.parallelFor(m_characters.size(), grainSize, [this, deltaTime](size_t begin, size_t end) {
+        for (size_t character = begin; character < end; ++character) {
+            updateCharacter(static_cast<uint32_t>(character), deltaTime);
+        }
+    });
+}
+
+void AnimationSystem::update(float deltaTime) {
+    update(deltaTime, ThreadPool::getInstance());
+}
+
+void AnimationSystem::updateCharacter(uint32_t index, float deltaTime) {
+    Character& character = m_characters[index];
+    Scratch& scratch = t_scratch;
+    scratch.prepare(m_skeleton.getJointCount());
+
+    BlendLayer blendLayers[MAX_LAYERS];
+    size_t blendCount = 0;
+    for (uint32_t layer = 0; layer < MAX_LAYERS; ++layer) {
+        Layer& state = character.layers[layer];
+        if (state.clip == NO_CLIP) {
+            continue;
+        }
+        const AnimationClip& clip = *m_clips[state.clip];
+        state.time = advanceTime(state.time, deltaTime * state.speed, clip.getDuration(), state.loop);
+        if (state.weight <= 0.0f) {
+            continue;
+        }
+        character.samplers[layer].sample(state.time, scratch.layers[blendCount]);
+        blendLayers[blendCount] = {&scratch.layers[blendCount], state.weight};
+        ++blendCount;
+    }
+
+    AnimationPose::blend(blendLayers, blendCount, m_bindPose, scratch.blended);
+    scratch.blended.localToModel(m_skeleton, scratch.models.data());
+    AnimationPose::computeSkinningMatrices(
+        m_skeleton, scratch.models.data(),
+        m_skinningMatrices.data() + static_cast<size_t>(index) * m_skeleton.getJointCount());
+}
+
+} // namespace VulkanGameEngine
@@ -0,0 +1,448 @@
+#include "../headers/AssetArchive.h"
+#include "../headers/Lz4.h"
+#include "../headers/ThreadPool.h"
+#include "../headers/Logger.h"
+#include "../headers/Profiler.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#define NOGDI   // wingdi.h defines ERROR, which collides with Logger::Level::ERROR
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace VulkanGameEngine {
+
+static_assert(sizeof(AssetArchive::Header) == 56, "Header layout is part of the file format");
+static_assert(sizeof(AssetArchive::Chunk) == 16, "Chunk layout is part of the file format");
+static_assert(sizeof(AssetArchive::Entry) == 32, "Entry layout is part of the file format");
+
+namespace {
+
+/**
+ * Rounds up to the alignment of the tables (8 bytes)
+ */
+uint64_t alignTable(uint64_t offset) {
+    return (offset + 7) & ~uint64_t(7);
+}
+
+bool compareEntries(const AssetArchive::Entry& a, const AssetArchive::Entry& b) {
+    return a.pathHash < b.pathHash;
+}
+
+} // anonymous namespace
+
+// --- AssetArchive -------------------------------------------------------------
+
+AssetArchive::AssetArchive()
+    : m_data(nullptr)
+    , m_size(0)
+    , m_chunks(nullptr)
+    , m_entries(nullptr)
+    , m_paths(nullptr)
+#ifdef _WIN32
+    , m_file(nullptr)
+    , m_mapping(nullptr)
+#endif
+{
+}
+
+AssetArchive::~AssetArchive() {
+    close();
+}
+
+void AssetArchive::open(const std::string& path) {
+    PROFILE_ZONE("AssetArchive::open");
+    close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        throw std::runtime_error("Failed to open archive " + path);
+    }
+    LARGE_INTEGER size;
+    HANDLE mapping = GetFileSizeEx(file, &size) && size.QuadPart > 0
+                         ? CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr) : nullptr;
+    const void* data = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!data) {
+        if (mapping) {
+            CloseHandle(mapping);
+        }
+        CloseHandle(file);
+        throw std::runtime_error("Failed to map archive " + path);
+    }
+    m_file = file;
+    m_mapping = mapping;
+    m_size = static_cast<size_t>(size.QuadPart);
+#else
+    const int file = ::open(path.c_str(), O_RDONLY);
+    if (file < 0) {
+        throw std::runtime_error("Failed to open archive " + path);
+    }
+    struct stat info;
+    void* data = fstat(file, &info) == 0 && info.st_size > 0
+                     ? mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_SHARED, file, 0) : MAP_FAILED;
+    ::close(file);      // The mapping keeps the file alive
+    if (data == MAP_FAILED) {
+        throw std::runtime_error("Failed to map archive " + path);
+    }
+    m_size = static_cast<size_t>(info.st_size);
+#endif
+    m_data = static_cast<const uint8_t*>(data);
+    m_path = path;
+
+    try {
+        validate();
+    } catch (...) {
+        close();
+        throw;
+    }
+
+    const Header& header = getHeader();
+    m_chunks = reinterpret_cast<const Chunk*>(m_data + header.chunkTableOffset);
+    m_entries = reinterpret_cast<const Entry*>(m_data + header.entryTableOffset);
+    m_paths = reinterpret_cast<const char*>(m_data + header.pathsOffset);
+    LOG_INFO("Mounted archive {} ({} assets, {:.2f} MB)", "Assets", path, header.entryCount, m_size / (1024.0 * 1024.0));
+}
+
+void AssetArchive::close() {
+    if (!m_data) {
+        return;
+    }
+#ifdef _WIN32
+    UnmapViewOfFile(m_data);
+    CloseHandle(static_cast<HANDLE>(m_mapping));
+    CloseHandle(static_cast<HANDLE>(m_file));
+    m_file = nullptr;
+    m_mapping = nullptr;
+#else
+    munmap(const_cast<uint8_t*>(m_data), m_size);
+#endif
+    m_data = nullptr;
+    m_size = 0;
+    m_chunks = nullptr;
+    m_entries = nullptr;
+    m_paths = nullptr;
+    m_path.clear();
+}
+
+void AssetArchive::validate() const {
+    // Everything read later is checked here once, so lookups and reads need no bounds checks
+    const std::string context = "Invalid archive " + m_path + ": ";
+    if (m_size < sizeof(Header)) {
+        throw std::runtime_error(context + "too small");
+    }
+    const Header& header = getHeader();
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) {
+        throw std::runtime_error(context + "not a pak file");
+    }
+    if (header.version != VERSION) {
+        throw std::runtime_error(context + "version " + std::to_string(header.version) +
+                                 ", expected " + std::to_string(VERSION));
+    }
+    if (header.chunkSize == 0) {
+        throw std::runtime_error(context + "zero chunk size");
+    }
+
+    auto checkRange = [&](uint64_t offset, uint64_t size, const char* what) {
+        if (offset > m_size || size > m_size - offset) {
+            throw std::runtime_error(context + what + " out of bounds");
+        }
+    };
+    if (header.chunkTableOffset % 8 != 0 || header.entryTableOffset % 8 != 0) {
+        throw std::runtime_error(context + "misaligned tables");
+    }
+    checkRange(header.chunkTableOffset, uint64_t(header.chunkCount) * sizeof(Chunk), "chunk table");
+    checkRange(header.entryTableOffset, uint64_t(header.entryCount) * sizeof(Entry), "entry table");
+    checkRange(header.pathsOffset, header.pathsSize, "path table");
+
+    const Chunk* chunks = reinterpret_cast<const Chunk*>(m_data + header.chunkTableOffset);
+    for (uint32_t i = 0; i < header.chunkCount; ++i) {
+        checkRange(chunks[i].offset, chunks[i].storedSize, "chunk");
+    }
+
+    const Entry* entries = reinterpret_cast<const Entry*>(m_data + header.entryTableOffset);
+    for (uint32_t i = 0; i < header.entryCount; ++i) {
+        const Entry& entry = entries[i];
+        if (i > 0 && entries[i - 1].pathHash > entry.pathHash) {
+            throw std::runtime_error(context + "entries not sorted");
+        }
+        if (uint64_t(entry.pathOffset) + entry.pathLength > header.pathsSize) {
+            throw std::runtime_error(context + "path out of bounds");
+        }
+        const uint64_t expectedChunks = (entry.size + header.chunkSize - 1) / header.chunkSize;
+        if (entry.chunkCount != expectedChunks || uint64_t(entry.firstChunk) + entry.chunkCount > header.chunkCount) {
+            throw std::runtime_error(context + "bad chunk range");
+        }
+        for (uint32_t c = 0; c < entry.chunkCount; ++c) {
+            const Chunk& chunk = chunks[entry.firstChunk + c];
+            const uint64_t chunkBytes = std::min<uint64_t>(header.chunkSize, entry.size - uint64_t(c) * header.chunkSize);
+            if (!(chunk.flags & Chunk::COMPRESSED) && chunk.storedSize != chunkBytes) {
+                throw std::runtime_error(context + "bad stored chunk size");
+            }
+        }
+    }
+}
+
+std::string AssetArchive::getEntryPath(const Entry& entry) const {
+    return std::string(m_paths + entry.pathOffset, entry.pathLength);
+}
+
+const AssetArchive::Entry* AssetArchive::find(const std::string& path) const {
+    if (!isOpen()) {
+        return nullptr;
+    }
+    const std::string normalized = normalizePath(path);
+    Entry key{};
+    key.pathHash = hashPath(normalized);
+
+    const Entry* end = m_entries + getHeader().entryCount;
+    for (const Entry* entry = std::lower_bound(m_entries, end, key, compareEntries);
+         entry != end && entry->pathHash == key.pathHash; ++entry) {
+        // Hashes can collide; the path decides
+        if (entry->pathLength == normalized.size() &&
+            std::memcmp(m_paths + entry->pathOffset, normalized.data(), normalized.size()) == 0) {
+            return entry;
+        }
+    }
+    return nullptr;
+}
+
+void AssetArchive::read(const Entry& entry, std::vector<char>& data, ThreadPool& pool) const {
+    PROFILE_ZONE("AssetArchive::read");
+    const uint32_t chunkSize = getHeader().chunkSize;
+    data.resize(static_cast<size_t>(entry.size));
+
+    auto readChunks = [&](size_t begin, size_t end) {
+        for (size_t c = begin; c < end; ++c) {
+            const Chunk& chunk = m_chunks[entry.firstChunk + c];
+            const uint64_t start = uint64_t(c) * chunkSize;
+            const size_t bytes = static_cast<size_t>(std::min<uint64_t>(chunkSize, entry.size - start));
+            uint8_t* destination = reinterpret_cast<uint8_t*>(data.data()) + start;
+            if (!(chunk.flags & Chunk::COMPRESSED)) {
+                std::memcpy(destination, m_data + chunk.offset, bytes);
+            } else if (!Lz4::decompress(m_data + chunk.offset, chunk.storedSize, destination, bytes)) {
+                throw std::runtime_error("Corrupt chunk " + std::to_string(c) + " of " + getEntryPath(entry) +
+                                         " in " + m_path);
+            }
+        }
+    };
+
+    if (entry.chunkCount > 1) {
+        pool.parallelFor(entry.chunkCount, 1, readChunks);
+    } else {
+        readChunks(0, entry.chunkCount);
+    }
+}
+
+uint64_t AssetArchive::getStoredSize(const Entry& entry) const {
+    uint64_t size = 0;
+    for (uint32_t c = 0; c < entry.chunkCount; ++c) {
+        size += m_chunks[entry.firstChunk + c].storedSize;
+    }
+    return size;
+}
+
+std::string AssetArchive::normalizePath(const std::string& path) {
+    std::string normalized = path;
+    std::replace(normalized.begin(), normalized.end(), '\\', '/');
+    while (normalized.compare(0, 2, "./") == 0) {
+        normalized.erase(0, 2);
+    }
+    return normalized;
+}
+
+uint64_t AssetArchive::hashPath(const std::string& path) {
+    const std::string normalized = normalizePath(path);
+    return hashBytes(normalized.data(), normalized.size());
+}
+
+uint64_t AssetArchive::hashBytes(const void* data, size_t size, uint64_t seed) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    uint64_t hash = seed;
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+// --- AssetArchiveWriter -------------------------------------------------------
+
+void AssetArchiveWriter::add(const std::string& path, std::vector<char> data) {
+    const std::string normalized = AssetArchive::normalizePath(path);
+    for (const Asset& asset : m_assets) {
+        if (asset.path == normalized) {
+            throw std::runtime_error("Asset " + normalized + " added to the archive twice");
+        }
+    }
+    m_assets.push_back({normalized, std::move(data)});
+}
+
+void AssetArchiveWriter::write(const std::string& path, ThreadPool& pool, uint32_t chunkSize) {
+    PROFILE_ZONE("AssetArchiveWriter::write");
+    if (chunkSize == 0) {
+        throw std::runtime_error("Archive chunk size must be at least 1");
+    }
+
+    // Every chunk of every asset, compressed independently
+    struct PendingChunk {
+        const char* source;
+        size_t size;
+        std::vector<uint8_t> compressed;    // Empty if stored as is
+    };
+    std::vector<AssetArchive::Entry> entries(m_assets.size());
+    std::vector<PendingChunk> chunks;
+    std::string paths;
+    for (size_t i = 0; i < m_assets.size(); ++i) {
+        const Asset& asset = m_assets[i];
+        AssetArchive::Entry& entry = entries[i];
+        entry.pathHash = AssetArchive::hashPath(asset.path);
+        entry.pathOffset = static_cast<uint32_t>(paths.size());
+        entry.pathLength = static_cast<uint32_t>(asset.path.size());
+        entry.size = asset.data.size();
+        entry.firstChunk = static_cast<uint32_t>(chunks.size());
+        entry.chunkCount = static_cast<uint32_t>((asset.data.size() + chunkSize - 1) / chunkSize);
+        paths += asset.path;
+        for (size_t offset = 0; offset < asset.data.size(); offset += chunkSize) {
+            chunks.push_back({asset.data.data() + offset, std::min<size_t>(chunkSize, asset.data.size() - offset), {}});
+        }
+    }
+
+    pool.parallelFor(chunks.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            PendingChunk& chunk = chunks[i];
+            chunk.compressed.resize(Lz4::compressBound(chunk.size));
+            const size_t size = Lz4::compress(reinterpret_cast<const uint8_t*>(chunk.source), chunk.size,
+                                              chunk.compressed.data(), chunk.compressed.size());
+            if (size == 0 || size >= chunk.size) {
+                chunk.compressed.clear();
+                chunk.compressed.shrink_to_fit();
+            } else {
+                chunk.compressed.resize(size);
+            }
+        }
+    });
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to open " + path + " for writing");
+    }
+
+    // Chunk data right after the header, then the tables
+    m_stats = Stats();
+    std::vector<AssetArchive::Chunk> chunkTable(chunks.size());
+    uint64_t offset = sizeof(AssetArchive::Header);
+    file.seekp(static_cast<std::streamoff>(offset));
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        const PendingChunk& chunk = chunks[i];
+        const bool compressed = !chunk.compressed.empty();
+        chunkTable[i].offset = offset;
+        chunkTable[i].storedSize = static_cast<uint32_t>(compressed ? chunk.compressed.size() : chunk.size);
+        chunkTable[i].flags = compressed ? AssetArchive::Chunk::COMPRESSED : 0;
+        file.write(compressed ? reinterpret_cast<const char*>(chunk.compressed.data()) : chunk.source,
+                   chunkTable[i].storedSize);
+        offset += chunkTable[i].storedSize;
+        m_stats.compressedChunks += compressed ? 1 : 0;
+        m_stats.inputBytes += chunk.size;
+    }
+
+    std::stable_sort(entries.begin(), entries.end(), compareEntries);
+
+    AssetArchive::Header header{};
+    std::memcpy(header.magic, AssetArchive::MAGIC, sizeof(header.magic));
+    header.version = AssetArchive::VERSION;
+    header.entryCount = static_cast<uint32_t>(entries.size());
+    header.chunkCount = static_cast<uint32_t>(chunkTable.size());
+    header.chunkSize = chunkSize;
+    header.chunkTableOffset = alignTable(offset);
+    header.entryTableOffset = header.chunkTableOffset + chunkTable.size() * sizeof(AssetArchive::Chunk);
+    header.pathsOffset = header.entryTableOffset + entries.size() * sizeof(AssetArchive::Entry);
+    header.pathsSize = paths.size();
+
+    const char padding[8] = {};
+    file.write(padding, static_cast<std::streamsize>(header.chunkTableOffset - offset));
+    file.write(reinterpret_cast<const char*>(chunkTable.data()),
+               static_cast<std::streamsize>(chunkTable.size() * sizeof(AssetArchive::Chunk)));
+    file.write(reinterpret_cast<const char*>(entries.data()),
+               static_cast<std::streamsize>(entries.size() * sizeof(AssetArchive::Entry)));
+    file.write(paths.data(), static_cast<std::streamsize>(paths.size()));
+    file.seekp(0);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.close();
+    if (!file) {
+        throw std::runtime_error("Failed to write " + path);
+    }
+
+    m_stats.entries = header.entryCount;
+    m_stats.chunks = header.chunkCount;
+    m_stats.archiveBytes = header.pathsOffset + header.pathsSize;
+}
+
+// --- AssetFileSystem ----------------------------------------------------------
+
+AssetFileSystem& AssetFileSystem::getInstance() {
+    static AssetFileSystem instance;
+    return instance;
+}
+
+void AssetFileSystem::mount(const std::string& archivePath) {
+    auto archive = std::make_unique<AssetArchive>();
+    archive->open(archivePath);
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    m_archives.push_back(std::move(archive));
+}
+
+void AssetFileSystem::unmountAll() {
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    m_archives.clear();
+}
+
+bool AssetFileSystem::readArchived(const std::string& path, std::vector<char>& data) const {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    for (auto archive = m_archives.rbegin(); archive != m_archives.rend(); ++archive) {
+        if (const AssetArchive::Entry* entry = (*archive)->find(path)) {
+            (*archive)->read(*entry, data, ThreadPool::getInstance());
+            return true;
+        }
+    }
+    return false;
+}
+
+bool AssetFileSystem::readFile(const std::string& path, std::vector<char>& data) const {
+    if (readArchived(path, data)) {
+        return true;
+    }
+
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        return false;
+    }
+    data.resize(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    file.read(data.data(), static_cast<std::streamsize>(data.size()));
+    return static_cast<bool>(file);
+}
+
+bool AssetFileSystem::isArchived(const std::string& path) const {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    for (const auto& archive : m_archives) {
+        if (archive->find(path)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace VulkanGameEngine
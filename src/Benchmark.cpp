@@ -0,0 +1,366 @@
+#include "../headers/Benchmark.h"
+#include "../headers/Metrics.h"
+#include "../headers/AllocationTracker.h"
+#include "../headers/Logger.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+namespace VulkanGameEngine {
+
+namespace {
+
+void appendJsonString(std::string& out, const char* text) {
+    out += '"';
+    for (const char* c = text; *c; ++c) {
+        if (*c == '"' || *c == '\\') {
+            out += '\\';
+        }
+        out += *c;
+    }
+    out += '"';
+}
+
+/**
+ * Nearest-rank percentile of sorted values
+ */
+double percentile(const std::vector<double>& sorted, double fraction) {
+    if (sorted.empty()) {
+        return 0.0;
+    }
+    const size_t rank = static_cast<size_t>(fraction * static_cast<double>(sorted.size() - 1) + 0.5);
+    return sorted[std::min(rank, sorted.size() - 1)];
+}
+
+/**
+ * Appends "name": {count, mean, min, p50, p90, p95, p99, max}
+ */
+void appendSummary(std::string& out, const char* name, std::vector<double> values) {
+    std::sort(values.begin(), values.end());
+    double sum = 0.0;
+    for (double value : values) {
+        sum += value;
+    }
+    const double mean = values.empty() ? 0.0 : sum / static_cast<double>(values.size());
+
+    char buffer[320];
+    std::snprintf(buffer, sizeof(buffer),
+                  "  \"%s\": {\"count\": %zu, \"mean\": %.4f, \"min\": %.4f, \"p50\": %.4f, \"p90\": %.4f, "
+                  "\"p95\": %.4f, \"p99\": %.4f, \"max\": %.4f}",
+                  name, values.size(), mean, values.empty() ? 0.0 : values.front(),
+                  percentile(values, 0.50), percentile(values, 0.90), percentile(values, 0.95),
+                  percentile(values, 0.99), values.empty() ? 0.0 : values.back());
+    out += buffer;
+}
+
+bool sameCamera(const BenchmarkScript::CameraKey& key, const glm::vec3& position, const glm::vec3& target) {
+    return key.position == position && key.target == target;
+}
+
+} // anonymous namespace
+
+bool BenchmarkScript::load(const std::string& path, BenchmarkScript& script, std::string& error) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        error = "Cannot open benchmark script " + path;
+        return false;
+    }
+
+    script = BenchmarkScript();
+    std::string line;
+    uint32_t lineNumber = 0;
+    while (std::getline(file, line)) {
+        ++lineNumber;
+        const size_t comment = line.find('#');
+        if (comment != std::string::npos) {
+            line.resize(comment);
+        }
+
+        std::istringstream stream(line);
+        std::string directive;
+        if (!(stream >> directive)) {
+            continue;
+        }
+
+        bool valid = true;
+        if (directive == "name") {
+            valid = static_cast<bool>(stream >> script.name);
+        } else if (directive == "timestep") {
+            valid = (stream >> script.timeStep) && script.timeStep > 0.0f;
+        } else if (directive == "warmup") {
+            valid = static_cast<bool>(stream >> script.warmupFrames);
+        } else if (directive == "frames") {
+            valid = (stream >> script.measuredFrames) && script.measuredFrames > 0;
+        } else if (directive == "size") {
+            valid = (stream >> script.width >> script.height) && script.width > 0 && script.height > 0;
+        } else if (directive == "camera") {
+            CameraKey key;
+            valid = static_cast<bool>(stream >> key.frame
+                                             >> key.position.x >> key.position.y >> key.position.z
+                                             >> key.target.x >> key.target.y >> key.target.z);
+            if (valid && !script.cameraPath.empty() && key.frame <= script.cameraPath.back().frame) {
+                error = path + ":" + std::to_string(lineNumber) + ": camera keys must have increasing frames";
+                return false;
+            }
+            script.cameraPath.push_back(key);
+        } else if (directive == "input") {
+            InputSpan span;
+            valid = (stream >> span.firstFrame >> span.lastFrame >> span.forward >> span.right) &&
+                    span.firstFrame <= span.lastFrame;
+            script.inputs.push_back(span);
+        } else {
+            error = path + ":" + std::to_string(lineNumber) + ": unknown directive '" + directive + "'";
+            return false;
+        }
+
+        if (!valid) {
+            error = path + ":" + std::to_string(lineNumber) + ": invalid '" + directive + "' line";
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool BenchmarkScript::save(const std::string& path) const {
+    std::ofstream file(path, std::ios::out | std::ios::trunc);
+    if (!file.is_open()) {
+        LOG_ERROR("Cannot write benchmark script " + path, "Benchmark");
+        return false;
+    }
+
+    char buffer[256];
+    file << "# Benchmark script (see headers/Benchmark.h for the format)\n";
+    file << "name " << name << "\n";
+    std::snprintf(buffer, sizeof(buffer), "timestep %.7f\n", timeStep);
+    file << buffer;
+    file << "warmup " << warmupFrames << "\n";
+    file << "frames " << measuredFrames << "\n";
+    if (width > 0 && height > 0) {
+        file << "size " << width << " " << height << "\n";
+    }
+
+    for (const CameraKey& key : cameraPath) {
+        std::snprintf(buffer, sizeof(buffer), "camera %llu %.6f %.6f %.6f %.6f %.6f %.6f\n",
+                      static_cast<unsigned long long>(key.frame),
+                      key.position.x, key.position.y, key.position.z,
+                      key.target.x, key.target.y, key.target.z);
+        file << buffer;
+    }
+    for (const InputSpan& span : inputs) {
+        std::snprintf(buffer, sizeof(buffer), "input %llu %llu %.3f %.3f\n",
+                      static_cast<unsigned long long>(span.firstFrame),
+                      static_cast<unsigned long long>(span.lastFrame), span.forward, span.right);
+        file << buffer;
+    }
+
+    return file.good();
+}
+
+void BenchmarkScript::addCameraKey(uint64_t frame, const glm::vec3& position, const glm::vec3& target) {
+    const size_t count = cameraPath.size();
+    if (count >= 2 && sameCamera(cameraPath[count - 1], position, target) &&
+        sameCamera(cameraPath[count - 2], position, target)) {
+        cameraPath.back().frame = frame;
+        return;
+    }
+
+    CameraKey key;
+    key.frame = frame;
+    key.position = position;
+    key.target = target;
+    cameraPath.push_back(key);
+}
+
+bool BenchmarkScript::sampleCamera(uint64_t frame, glm::vec3& position, glm::vec3& target) const {
+    if (cameraPath.empty() || frame < cameraPath.front().frame || frame > cameraPath.back().frame) {
+        return false;
+    }
+
+    // First key after the frame; the camera sits between it and its predecessor
+    auto next = std::upper_bound(cameraPath.begin(), cameraPath.end(), frame,
+                                 [](uint64_t value, const CameraKey& key) { return value < key.frame; });
+    if (next == cameraPath.end()) {
+        position = cameraPath.back().position;
+        target = cameraPath.back().target;
+    } else {
+        const CameraKey& previous = *(next - 1);
+        const float t = static_cast<float>(frame - previous.frame) / static_cast<float>(next->frame - previous.frame);
+        position = glm::mix(previous.position, next->position, t);
+        target = glm::mix(previous.target, next->target, t);
+    }
+    return true;
+}
+
+void BenchmarkScript::sampleInput(uint64_t frame, float& forward, float& right) const {
+    forward = 0.0f;
+    right = 0.0f;
+    for (const InputSpan& span : inputs) {
+        if (frame >= span.firstFrame && frame <= span.lastFrame) {
+            forward += span.forward;
+            right += span.right;
+        }
+    }
+}
+
+void BenchmarkReport::begin(uint64_t measuredFrames) {
+    m_frames.clear();
+    m_frames.reserve(static_cast<size_t>(measuredFrames));
+
+    MetricsRegistry& metrics = MetricsRegistry::getInstance();
+    m_startUploadBytes = metrics.counter("gpu.upload_bytes").getTotal();
+    const AllocationTracker::Stats heap = AllocationTracker::getGlobalStats();
+    m_startHeapAllocations = heap.allocations;
+    m_startHeapBytes = heap.bytes;
+    m_peakBufferMemory = metrics.gauge("gpu.buffer_bytes").get();
+}
+
+void BenchmarkReport::recordFrame(const BenchmarkFrame& frame) {
+    if (m_frames.size() < m_frames.capacity()) {
+        m_frames.push_back(frame);
+    }
+    static MetricGauge& bufferMemory = MetricsRegistry::getInstance().gauge("gpu.buffer_bytes");
+    m_peakBufferMemory = std::max(m_peakBufferMemory, bufferMemory.get());
+}
+
+double BenchmarkReport::getMedianFrameMs() const {
+    std::vector<double> frameTimes;
+    frameTimes.reserve(m_frames.size());
+    for (const BenchmarkFrame& frame : m_frames) {
+        frameTimes.push_back(frame.frameMs);
+    }
+    std::sort(frameTimes.begin(), frameTimes.end());
+    return percentile(frameTimes, 0.5);
+}
+
+uint64_t BenchmarkReport::getPeakResidentBytes() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters{};
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return static_cast<uint64_t>(counters.PeakWorkingSetSize);
+    }
+    return 0;
+#else
+    struct rusage usage{};
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+#ifdef __APPLE__
+    return static_cast<uint64_t>(usage.ru_maxrss);          // Bytes on macOS
+#else
+    return static_cast<uint64_t>(usage.ru_maxrss) * 1024;   // Kilobytes on Linux
+#endif
+#endif
+}
+
+bool BenchmarkReport::write(const std::string& path, const BenchmarkScript& script, const BenchmarkRunInfo& info) const {
+    std::vector<double> frameMs, cpuMs, fenceWaitMs, gpuMs, allocations, vulkanCalls, drawCalls, recordedDraws, triangles;
+    frameMs.reserve(m_frames.size());
+    cpuMs.reserve(m_frames.size());
+    fenceWaitMs.reserve(m_frames.size());
+    gpuMs.reserve(m_frames.size());
+    allocations.reserve(m_frames.size());
+    vulkanCalls.reserve(m_frames.size());
+    drawCalls.reserve(m_frames.size());
+    recordedDraws.reserve(m_frames.size());
+    triangles.reserve(m_frames.size());
+
+    uint64_t framesWithAllocations = 0;
+    for (const BenchmarkFrame& frame : m_frames) {
+        frameMs.push_back(frame.frameMs);
+        cpuMs.push_back(frame.cpuMs);
+        fenceWaitMs.push_back(frame.fenceWaitMs);
+        if (frame.gpuTimeValid) {
+            gpuMs.push_back(frame.gpuMs);
+        }
+        allocations.push_back(static_cast<double>(frame.allocations));
+        framesWithAllocations += frame.allocations > 0 ? 1 : 0;
+        vulkanCalls.push_back(frame.vulkanCalls);
+        drawCalls.push_back(frame.drawCalls);
+        recordedDraws.push_back(frame.recordedDraws);
+        triangles.push_back(static_cast<double>(frame.triangles));
+    }
+
+    MetricsRegistry& metrics = MetricsRegistry::getInstance();
+    const AllocationTracker::Stats heap = AllocationTracker::getGlobalStats();
+
+    std::string out;
+    out.reserve(4096);
+    char buffer[512];
+
+    out += "{\n  \"name\": ";
+    appendJsonString(out, script.name.c_str());
+    out += ",\n  \"script\": ";
+    appendJsonString(out, info.scriptPath.c_str());
+    out += ",\n  \"backend\": ";
+    appendJsonString(out, info.backend.c_str());
+    std::snprintf(buffer, sizeof(buffer),
+                  ",\n  \"headless\": %s,\n  \"width\": %u,\n  \"height\": %u,\n  \"timeStep\": %.7f,\n"
+                  "  \"warmupFrames\": %llu,\n  \"measuredFrames\": %zu,\n",
+                  info.headless ? "true" : "false", info.width, info.height, script.timeStep,
+                  static_cast<unsigned long long>(script.warmupFrames), m_frames.size());
+    out += buffer;
+
+    out += "  \"scene\": {\"spec\": ";
+    appendJsonString(out, info.scene.c_str());
+    std::snprintf(buffer, sizeof(buffer),
+                  ", \"objects\": %u, \"dynamicObjects\": %u, \"meshes\": %u, \"materials\": %u},\n",
+                  info.sceneObjects, info.sceneDynamicObjects, info.sceneMeshes, info.sceneMaterials);
+    out += buffer;
+
+    appendSummary(out, "frameTimeMs", std::move(frameMs));
+    out += ",\n";
+    appendSummary(out, "cpuRenderMs", std::move(cpuMs));
+    out += ",\n";
+    appendSummary(out, "fenceWaitMs", std::move(fenceWaitMs));
+    out += ",\n";
+    appendSummary(out, "gpuTimeMs", std::move(gpuMs));
+    out += ",\n";
+    appendSummary(out, "vulkanCalls", std::move(vulkanCalls));
+    out += ",\n";
+    appendSummary(out, "drawCalls", std::move(drawCalls));
+    out += ",\n";
+    appendSummary(out, "recordedDraws", std::move(recordedDraws));
+    out += ",\n";
+    appendSummary(out, "trianglesPerFrame", std::move(triangles));
+    out += ",\n";
+    appendSummary(out, "allocationsPerFrame", std::move(allocations));
+
+    std::snprintf(buffer, sizeof(buffer),
+                  ",\n  \"allocations\": {\"tracked\": %s, \"framesWithAllocations\": %llu, "
+                  "\"count\": %llu, \"bytes\": %llu},\n",
+                  AllocationTracker::isCompiledIn() ? "true" : "false",
+                  static_cast<unsigned long long>(framesWithAllocations),
+                  static_cast<unsigned long long>(heap.allocations - m_startHeapAllocations),
+                  static_cast<unsigned long long>(heap.bytes - m_startHeapBytes));
+    out += buffer;
+
+    std::snprintf(buffer, sizeof(buffer),
+                  "  \"memory\": {\"peakResidentBytes\": %llu, \"gpuBufferBytes\": %.0f, "
+                  "\"peakGpuBufferBytes\": %.0f, \"uploadBytes\": %llu}\n}\n",
+                  static_cast<unsigned long long>(getPeakResidentBytes()),
+                  metrics.gauge("gpu.buffer_bytes").get(), m_peakBufferMemory,
+                  static_cast<unsigned long long>(metrics.counter("gpu.upload_bytes").getTotal() - m_startUploadBytes));
+    out += buffer;
+
+    std::ofstream file(path, std::ios::out | std::ios::trunc);
+    if (!file.is_open()) {
+        LOG_ERROR("Cannot write benchmark report " + path, "Benchmark");
+        return false;
+    }
+    file.write(out.data(), static_cast<std::streamsize>(out.size()));
+    return file.good();
+}
+
+} // namespace VulkanGameEngine
@@ -0,0 +1,369 @@
+#include "../headers/BinaryLogSink.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <iostream>
+#include <thread>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#define NOGDI   // wingdi.h defines ERROR, which collides with Logger::Level::ERROR
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace VulkanGameEngine {
+
+BinaryLogSink::BinaryLogSink() = default;
+
+BinaryLogSink::~BinaryLogSink() {
+    close();
+}
+
+bool BinaryLogSink::open(const Config& config) {
+    close();
+
+    std::lock_guard<std::mutex> lock(m_rotationMutex);
+
+    // A reopen continues the numbering so the files written before are not truncated
+    const bool samePath = !m_mappings.empty() && config.basePath == m_config.basePath;
+    const uint64_t sequence = samePath ? m_mappings.back().sequence + 1 : 0;
+    m_config = config;
+
+    Mapping& first = m_mappings.emplace_back();
+    first.sequence = sequence;
+    if (!mapFile(first)) {
+        return false;
+    }
+
+    // Formats seen before the reopen stay cached, so the new file needs their definitions too
+    writeKnownFormatDefinitions(first);
+    m_current.store(&first, std::memory_order_release);
+    removeExpiredFile(first.sequence);
+    return true;
+}
+
+void BinaryLogSink::close() {
+    std::lock_guard<std::mutex> lock(m_rotationMutex);
+
+    Mapping* current = m_current.exchange(nullptr, std::memory_order_acq_rel);
+    if (!current) {
+        return;
+    }
+
+    // Let writers that already reserved space finish their copy
+    while (current->activeWriters.load() != 0) {
+        std::this_thread::yield();
+    }
+    unmapFile(*current);
+}
+
+std::string BinaryLogSink::getCurrentFilePath() const {
+    Mapping* current = m_current.load(std::memory_order_acquire);
+    return current ? current->path : std::string();
+}
+
+uint32_t BinaryLogSink::getFormatId(const char* format) {
+    const size_t mask = FORMAT_TABLE_SIZE - 1;
+    const size_t hash = static_cast<size_t>((reinterpret_cast<uintptr_t>(format) >> 3) * 0x9E3779B97F4A7C15ull);
+
+    // Fast path: lock-free probe for a format we have seen before
+    for (size_t probe = 0; probe < FORMAT_TABLE_SIZE; ++probe) {
+        FormatSlot& slot = m_formatTable[(hash + probe) & mask];
+        const char* key = slot.format.load(std::memory_order_acquire);
+        if (key == format) {
+            return slot.id.load(std::memory_order_acquire);
+        }
+        if (key == nullptr) {
+            break;
+        }
+    }
+
+    // Slow path: first use of this format string
+    std::lock_guard<std::mutex> lock(m_formatMutex);
+
+    uint32_t formatId;
+    {
+        std::lock_guard<std::mutex> definitionsLock(m_definitionsMutex);
+        for (size_t i = 0; i < m_formatDefinitions.size(); ++i) {
+            if (m_formatDefinitions[i] == format) {
+                return static_cast<uint32_t>(i + 1); // Registered, but the table was full
+            }
+        }
+        m_formatDefinitions.push_back(format);
+        formatId = static_cast<uint32_t>(m_formatDefinitions.size());
+    }
+
+    for (size_t probe = 0; probe < FORMAT_TABLE_SIZE; ++probe) {
+        FormatSlot& slot = m_formatTable[(hash + probe) & mask];
+        if (slot.format.load(std::memory_order_relaxed) == nullptr) {
+            // Publish the ID before the key so lock-free readers never see a key without its ID
+            slot.id.store(formatId, std::memory_order_relaxed);
+            slot.format.store(format, std::memory_order_release);
+            break;
+        }
+    }
+
+    writeFormatDefinition(formatId, format);
+    return formatId;
+}
+
+void BinaryLogSink::writeText(uint8_t level, const std::string& message, const std::string& category) {
+    BinaryLogEncoding::ArgumentBuffer buffer;
+    BinaryLogEncoding::encode(buffer, category);
+    BinaryLogEncoding::encode(buffer, message);
+    writeMessage(level, BinaryLogFormat::TEXT_MESSAGE_FORMAT_ID, buffer);
+}
+
+void BinaryLogSink::writeMessage(uint8_t level, uint32_t formatId, const BinaryLogEncoding::ArgumentBuffer& arguments) {
+    const uint32_t size = BinaryLogFormat::alignRecordSize(sizeof(BinaryLogFormat::MessageRecord) + arguments.size);
+
+    Mapping* mapping = nullptr;
+    uint8_t* destination = reserve(size, mapping);
+    if (!destination) {
+        m_droppedMessages.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    BinaryLogFormat::MessageRecord record{};
+    record.header.type = BinaryLogFormat::RECORD_MESSAGE;
+    record.formatId = formatId;
+    record.threadId = getThreadId();
+    record.timestampNs = getTimestampNs();
+    record.argumentBytes = static_cast<uint16_t>(arguments.size);
+    record.level = level;
+    record.argumentCount = arguments.count;
+
+    std::memcpy(destination, &record, sizeof(record));
+    std::memcpy(destination + sizeof(record), arguments.data, arguments.size);
+    commit(mapping, destination, size);
+}
+
+void BinaryLogSink::writeFormatDefinition(uint32_t formatId, const char* format) {
+    const uint32_t formatLength = static_cast<uint32_t>(std::strlen(format));
+    const uint32_t size = BinaryLogFormat::alignRecordSize(sizeof(BinaryLogFormat::FormatDefinitionRecord) + formatLength);
+
+    Mapping* mapping = nullptr;
+    uint8_t* destination = reserve(size, mapping);
+    if (!destination) {
+        return;
+    }
+
+    BinaryLogFormat::FormatDefinitionRecord record{};
+    record.header.type = BinaryLogFormat::RECORD_FORMAT_DEFINITION;
+    record.formatId = formatId;
+    record.formatLength = formatLength;
+
+    std::memcpy(destination, &record, sizeof(record));
+    std::memcpy(destination + sizeof(record), format, formatLength);
+    commit(mapping, destination, size);
+}
+
+uint8_t* BinaryLogSink::reserve(uint32_t size, Mapping*& mapping) {
+    while (true) {
+        Mapping* current = m_current.load(std::memory_order_acquire);
+        if (!current || size > current->capacity - sizeof(BinaryLogFormat::FileHeader)) {
+            return nullptr;
+        }
+
+        // Announce ourselves before re-checking, so a rotation either sees us or we see it
+        current->activeWriters.fetch_add(1);
+        if (current != m_current.load()) {
+            current->activeWriters.fetch_sub(1);
+            continue;
+        }
+
+        size_t offset = current->writeOffset.fetch_add(size);
+        if (offset + size <= current->capacity) {
+            mapping = current;
+            return current->data + offset;
+        }
+
+        current->activeWriters.fetch_sub(1);
+        rotate(current);
+    }
+}
+
+void BinaryLogSink::commit(Mapping* mapping, uint8_t* record, uint32_t size) {
+    // The size field is written last: a zero size marks the end of valid data
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(record + offsetof(BinaryLogFormat::RecordHeader, size), &size, sizeof(size));
+    mapping->activeWriters.fetch_sub(1, std::memory_order_release);
+}
+
+void BinaryLogSink::rotate(Mapping* full) {
+    std::lock_guard<std::mutex> lock(m_rotationMutex);
+    if (m_current.load() != full) {
+        return; // Another thread already rotated
+    }
+
+    Mapping& next = m_mappings.emplace_back();
+    next.sequence = full->sequence + 1;
+    if (!mapFile(next)) {
+        // Stop logging rather than overwrite; writers see a closed sink and drop
+        m_current.store(nullptr);
+        while (full->activeWriters.load() != 0) {
+            std::this_thread::yield();
+        }
+        unmapFile(*full);
+        return;
+    }
+
+    // Repeat every known format definition so the new file decodes on its own
+    writeKnownFormatDefinitions(next);
+
+    m_current.store(&next);
+
+    while (full->activeWriters.load() != 0) {
+        std::this_thread::yield();
+    }
+    unmapFile(*full);
+
+    removeExpiredFile(next.sequence);
+}
+
+void BinaryLogSink::writeKnownFormatDefinitions(Mapping& mapping) {
+    // The file is not published yet, so this writes without reserving
+    std::lock_guard<std::mutex> definitionsLock(m_definitionsMutex);
+    size_t offset = mapping.writeOffset.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < m_formatDefinitions.size(); ++i) {
+        const char* format = m_formatDefinitions[i];
+        const uint32_t formatLength = static_cast<uint32_t>(std::strlen(format));
+        const uint32_t size = BinaryLogFormat::alignRecordSize(sizeof(BinaryLogFormat::FormatDefinitionRecord) + formatLength);
+        if (offset + size > mapping.capacity) {
+            break;
+        }
+
+        BinaryLogFormat::FormatDefinitionRecord record{};
+        record.header.size = size;
+        record.header.type = BinaryLogFormat::RECORD_FORMAT_DEFINITION;
+        record.formatId = static_cast<uint32_t>(i + 1);
+        record.formatLength = formatLength;
+        std::memcpy(mapping.data + offset, &record, sizeof(record));
+        std::memcpy(mapping.data + offset + sizeof(record), format, formatLength);
+        offset += size;
+    }
+    mapping.writeOffset.store(offset, std::memory_order_relaxed);
+}
+
+void BinaryLogSink::removeExpiredFile(uint64_t newestSequence) {
+    // Keep at most maxFiles files on disk
+    if (m_config.maxFiles > 0 && newestSequence >= m_config.maxFiles) {
+        std::string expired = m_config.basePath + "." + std::to_string(newestSequence - m_config.maxFiles) + ".blog";
+        std::remove(expired.c_str());
+    }
+}
+
+bool BinaryLogSink::mapFile(Mapping& mapping) {
+    mapping.path = m_config.basePath + "." + std::to_string(mapping.sequence) + ".blog";
+    mapping.capacity = m_config.fileCapacity;
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(mapping.path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ,
+                              nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        std::cerr << "BinaryLogSink: failed to create " << mapping.path << std::endl;
+        return false;
+    }
+
+    const uint64_t capacity = mapping.capacity;
+    HANDLE fileMapping = CreateFileMappingA(file, nullptr, PAGE_READWRITE,
+                                            static_cast<DWORD>(capacity >> 32),
+                                            static_cast<DWORD>(capacity & 0xFFFFFFFFu), nullptr);
+    void* data = fileMapping ? MapViewOfFile(fileMapping, FILE_MAP_WRITE, 0, 0, mapping.capacity) : nullptr;
+    if (!data) {
+        if (fileMapping) {
+            CloseHandle(fileMapping);
+        }
+        CloseHandle(file);
+        std::cerr << "BinaryLogSink: failed to map " << mapping.path << std::endl;
+        return false;
+    }
+
+    mapping.fileHandle = file;
+    mapping.mappingHandle = fileMapping;
+    mapping.data = static_cast<uint8_t*>(data);
+#else
+    int fd = ::open(mapping.path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        std::cerr << "BinaryLogSink: failed to create " << mapping.path << std::endl;
+        return false;
+    }
+
+    // A freshly extended file reads as zeros, which the decoder treats as end of data
+    if (ftruncate(fd, static_cast<off_t>(mapping.capacity)) != 0) {
+        ::close(fd);
+        std::cerr << "BinaryLogSink: failed to size " << mapping.path << std::endl;
+        return false;
+    }
+
+    int flags = MAP_SHARED;
+#ifdef MAP_POPULATE
+    flags |= MAP_POPULATE; // Fault pages in up front instead of on the logging path
+#endif
+    void* data = mmap(nullptr, mapping.capacity, PROT_READ | PROT_WRITE, flags, fd, 0);
+    if (data == MAP_FAILED) {
+        ::close(fd);
+        std::cerr << "BinaryLogSink: failed to map " << mapping.path << std::endl;
+        return false;
+    }
+
+    mapping.fileDescriptor = fd;
+    mapping.data = static_cast<uint8_t*>(data);
+#endif
+
+    BinaryLogFormat::FileHeader header{};
+    std::memcpy(header.magic, BinaryLogFormat::MAGIC, sizeof(header.magic));
+    header.version = BinaryLogFormat::VERSION;
+    header.headerSize = BinaryLogFormat::alignRecordSize(sizeof(header));
+    header.sequence = mapping.sequence;
+    header.systemTimeAtStartNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    header.steadyTimeAtStartNs = getTimestampNs();
+    std::memcpy(mapping.data, &header, sizeof(header));
+
+    mapping.writeOffset.store(header.headerSize, std::memory_order_relaxed);
+    return true;
+}
+
+void BinaryLogSink::unmapFile(Mapping& mapping) {
+    if (!mapping.data) {
+        return;
+    }
+
+    const size_t used = std::min(mapping.writeOffset.load(), mapping.capacity);
+
+#ifdef _WIN32
+    UnmapViewOfFile(mapping.data);
+    CloseHandle(static_cast<HANDLE>(mapping.mappingHandle));
+
+    LARGE_INTEGER end;
+    end.QuadPart = static_cast<LONGLONG>(used);
+    SetFilePointerEx(static_cast<HANDLE>(mapping.fileHandle), end, nullptr, FILE_BEGIN);
+    SetEndOfFile(static_cast<HANDLE>(mapping.fileHandle));
+    CloseHandle(static_cast<HANDLE>(mapping.fileHandle));
+    mapping.fileHandle = nullptr;
+    mapping.mappingHandle = nullptr;
+#else
+    munmap(mapping.data, mapping.capacity);
+    if (ftruncate(mapping.fileDescriptor, static_cast<off_t>(used)) != 0) {
+        std::cerr << "BinaryLogSink: failed to trim " << mapping.path << std::endl;
+    }
+    ::close(mapping.fileDescriptor);
+    mapping.fileDescriptor = -1;
+#endif
+
+    mapping.data = nullptr;
+}
+
+uint32_t BinaryLogSink::getThreadId() {
+    static std::atomic<uint32_t> nextThreadId{1};
+    thread_local uint32_t threadId = nextThreadId.fetch_add(1, std::memory_order_relaxed);
+    return threadId;
+}
+
+} // namespace VulkanGameEngine
@@ -0,0 +1,157 @@
+#include "../headers/CaptureRenderBackend.h"
+#include "../headers/FrameCapture.h"
+#include "../headers/AllocationTracker.h"
+#include "../headers/VulkanUtils.h"
+#include "../headers/Logger.h"
+#include <algorithm>
+#include <cstring>
+
+namespace VulkanGameEngine {
+
+CaptureRenderBackend::CaptureRenderBackend(std::unique_ptr<RenderBackend> inner)
+    : m_inner(std::move(inner))
+    , m_pendingFrameIndex(0) {
+    if (!m_inner) {
+        throw std::runtime_error("CaptureRenderBackend needs a backend to wrap");
+    }
+}
+
+CaptureRenderBackend::~CaptureRenderBackend() {
+    cleanup();
+}
+
+void CaptureRenderBackend::cleanup() {
+    if (isCapturePending()) {
+        LOG_WARN("Frame capture " + m_pendingPath + " was never written (no frame recorded)", "Capture");
+        m_pendingPath.clear();
+    }
+    m_buffers.clear();
+    m_pipelines.clear();
+    m_inner->cleanup();
+}
+
+BufferHandle CaptureRenderBackend::createBuffer(BufferType type, const void* data, size_t size) {
+    const BufferHandle handle = m_inner->createBuffer(type, data, size);
+    BufferShadow& shadow = m_buffers[handle];
+    shadow.type = type;
+    shadow.contents.resize(size);
+    if (data) {
+        std::memcpy(shadow.contents.data(), data, size);
+    }
+    return handle;
+}
+
+void CaptureRenderBackend::updateBuffer(BufferHandle buffer, const void* data, size_t size) {
+    m_inner->updateBuffer(buffer, data, size);
+    auto it = m_buffers.find(buffer);
+    if (it != m_buffers.end()) {
+        std::vector<uint8_t>& contents = it->second.contents;
+        std::memcpy(contents.data(), data, std::min(size, contents.size()));
+    }
+}
+
+void CaptureRenderBackend::updateBufferRange(BufferHandle buffer, size_t offset, const void* data, size_t size) {
+    m_inner->updateBufferRange(buffer, offset, data, size);
+    auto it = m_buffers.find(buffer);
+    if (it != m_buffers.end() && offset < it->second.contents.size()) {
+        std::vector<uint8_t>& contents = it->second.contents;
+        std::memcpy(contents.data() + offset, data, std::min(size, contents.size() - offset));
+    }
+}
+
+void CaptureRenderBackend::destroyBuffer(BufferHandle buffer) {
+    m_inner->destroyBuffer(buffer);
+    m_buffers.erase(buffer);
+}
+
+PipelineHandle CaptureRenderBackend::createPipeline(const PipelineDesc& desc) {
+    const PipelineHandle handle = m_inner->createPipeline(desc);
+    shadowPipeline(handle, desc);
+    return handle;
+}
+
+void CaptureRenderBackend::destroyPipeline(PipelineHandle pipeline) {
+    m_inner->destroyPipeline(pipeline);
+    m_pipelines.erase(pipeline);
+}
+
+void CaptureRenderBackend::replacePipeline(PipelineHandle pipeline, const PipelineDesc& desc) {
+    m_inner->replacePipeline(pipeline, desc);
+    shadowPipeline(pipeline, desc);
+}
+
+void CaptureRenderBackend::shadowPipeline(PipelineHandle pipeline, const PipelineDesc& desc) {
+    PipelineDesc& shadow = m_pipelines[pipeline];
+    shadow = desc;
+    // Keep the SPIR-V itself; the files may change (or be missing) by the time a capture is replayed
+    try {
+        if (shadow.vertexShaderCode.empty()) {
+            shadow.vertexShaderCode = VulkanUtils::readFile(desc.vertexShaderPath);
+        }
+        if (shadow.fragmentShaderCode.empty()) {
+            shadow.fragmentShaderCode = VulkanUtils::readFile(desc.fragmentShaderPath);
+        }
+    } catch (const std::exception& e) {
+        LOG_WARN("Pipeline shaders not captured ({}); replays will read them from disk", "Capture", e.what());
+    }
+}
+
+void CaptureRenderBackend::recordFrame(const CommandList& commands) {
+    if (isCapturePending()) {
+        writeCapture(commands);
+    }
+    m_inner->recordFrame(commands);
+}
+
+void CaptureRenderBackend::captureNextFrame(const std::string& path, uint64_t frameIndex) {
+    m_pendingPath = path;
+    m_pendingFrameIndex = frameIndex;
+}
+
+void CaptureRenderBackend::writeCapture(const CommandList& commands) {
+    ALLOW_ALLOCATIONS();
+
+    // Disarm first, so a failed capture is not retried every frame
+    const std::string path = m_pendingPath;
+    m_pendingPath.clear();
+
+    FrameCapture capture;
+    m_inner->getRenderExtent(capture.width, capture.height);
+    capture.frameIndex = m_pendingFrameIndex;
+    capture.backend = m_inner->getName();
+
+    for (const Command& command : commands.getCommands()) {
+        switch (command.type) {
+            case CommandType::BIND_PIPELINE:
+                if (!capture.findPipeline(command.handle)) {
+                    auto it = m_pipelines.find(command.handle);
+                    if (it == m_pipelines.end()) {
+                        throw std::runtime_error("Captured frame binds unknown pipeline " + std::to_string(command.handle));
+                    }
+                    capture.pipelines.push_back({command.handle, it->second});
+                }
+                break;
+            case CommandType::BIND_VERTEX_BUFFER:
+            case CommandType::BIND_INDEX_BUFFER:
+            case CommandType::BIND_UNIFORMS:
+                if (!capture.findBuffer(command.handle)) {
+                    auto it = m_buffers.find(command.handle);
+                    if (it == m_buffers.end()) {
+                        throw std::runtime_error("Captured frame binds unknown buffer " + std::to_string(command.handle));
+                    }
+                    capture.buffers.push_back({command.handle, it->second.type, it->second.contents});
+                }
+                break;
+            default:
+                break;
+        }
+    }
+
+    capture.setCommands(commands);
+    if (capture.save(path)) {
+        LOG_INFO("Captured frame {} to {} ({} commands, {} pipelines, {} buffers)", "Capture",
+                 capture.frameIndex, path, capture.commands.size(), capture.pipelines.size(), capture.buffers.size());
+    }
+}
+
+} // namespace VulkanGameEngine
@@ -0,0 +1,64 @@
+#include "../headers/CommandList.h"
+
+namespace VulkanGameEngine {
+
+Command& CommandList::push(CommandType type) {
+    m_commands.emplace_back();
+    Command& command = m_commands.back();
+    command.type = type;
+    return command;
+}
+
+void CommandList::beginPass(float r, float g, float b, float a) {
+    Command& command = push(CommandType::BEGIN_PASS);
+    command.clearColor[0] = r;
+    command.clearColor[1] = g;
+    command.clearColor[2] = b;
+    command.clearColor[3] = a;
+}
+
+void CommandList::endPass() {
+    push(CommandType::END_PASS);
+}
+
+void CommandList::bindPipeline(PipelineHandle pipeline) {
+    push(CommandType::BIND_PIPELINE).handle = pipeline;
+}
+
+void CommandList::setFullViewport() {
+    push(CommandType::SET_FULL_VIEWPORT);
+}
+
+void CommandList::bindVertexBuffer(BufferHandle buffer) {
+    push(CommandType::BIND_VERTEX_BUFFER).handle = buffer;
+}
+
+void CommandList::bindIndexBuffer(BufferHandle buffer) {
+    push(CommandType::BIND_INDEX_BUFFER).handle = buffer;
+}
+
+void CommandList::bindUniforms(BufferHandle buffer) {
+    push(CommandType::BIND_UNIFORMS).handle = buffer;
+}
+
+void CommandList::pushObjectConstants(const ObjectConstants& constants) {
+    push(CommandType::PUSH_OBJECT_CONSTANTS).handle = static_cast<uint32_t>(m_objectConstants.size());
+    m_objectConstants.push_back(constants);
+}
+
+void CommandList::drawIndexed(uint32_t indexCount, uint32_t firstIndex, int32_t vertexOffset) {
+    Command& command = push(CommandType::DRAW_INDEXED);
+    command.indexCount = indexCount;
+    command.firstIndex = firstIndex;
+    command.vertexOffset = vertexOffset;
+}
+
+void CommandList::beginZone(const char* name) {
+    push(CommandType::BEGIN_ZONE).name = name;
+}
+
+void CommandList::endZone() {
+    push(CommandType::END_ZONE);
+}
+
+} // namespace VulkanGameEngine
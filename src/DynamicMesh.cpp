@@ -0,0 +1,102 @@
+#include "../headers/DynamicMesh.h"
+#include "../headers/Logger.h"
+#include "../headers/Profiler.h"
+#include <algorithm>
+
+namespace VulkanGameEngine {
+
+DynamicMesh::DynamicMesh()
+    : m_backend(nullptr)
+    , m_vertexBuffer(INVALID_HANDLE)
+    , m_indexBuffer(INVALID_HANDLE)
+    , m_indexCount(0) {
+}
+
+DynamicMesh::~DynamicMesh() {
+    destroy();
+}
+
+void DynamicMesh::create(RenderBackend& backend, const std::vector<Vertex>& vertices,
+                         const std::vector<uint32_t>& indices) {
+    if (vertices.empty() || indices.empty()) {
+        throw std::runtime_error("Dynamic meshes need vertices and indices");
+    }
+    for (uint32_t index : indices) {
+        if (index >= vertices.size()) {
+            throw std::runtime_error("Dynamic mesh index out of range");
+        }
+    }
+    destroy();
+
+    // Every frame's copy starts out with the initial vertices, so nothing is dirty
+    const BufferHandle vertexBuffer =
+        backend.createBuffer(BufferType::DYNAMIC_VERTEX, vertices.data(), vertices.size() * sizeof(Vertex));
+    try {
+        m_indexBuffer = backend.createBuffer(BufferType::INDEX, indices.data(), indices.size() * sizeof(uint32_t));
+    } catch (...) {
+        backend.destroyBuffer(vertexBuffer);
+        throw;
+    }
+
+    m_backend = &backend;
+    m_vertexBuffer = vertexBuffer;
+    m_indexCount = static_cast<uint32_t>(indices.size());
+    m_vertices = vertices;
+    std::fill(std::begin(m_dirty), std::end(m_dirty), DirtyRange{});
+
+    LOG_DEBUG("Created dynamic mesh: {} vertices, {} indices", "DynamicMesh", m_vertices.size(), m_indexCount);
+}
+
+void DynamicMesh::destroy() {
+    if (!m_backend) {
+        return;
+    }
+    // The backend keeps the buffers alive until frames in flight are done with them
+    m_backend->destroyBuffer(m_vertexBuffer);
+    m_backend->destroyBuffer(m_indexBuffer);
+    m_backend = nullptr;
+    m_vertexBuffer = INVALID_HANDLE;
+    m_indexBuffer = INVALID_HANDLE;
+    m_indexCount = 0;
+    m_vertices.clear();
+}
+
+void DynamicMesh::update(uint32_t first, const Vertex* vertices, uint32_t count) {
+    markDirty(first, count);
+    std::copy(vertices, vertices + count, m_vertices.begin() + first);
+}
+
+void DynamicMesh::markDirty(uint32_t first, uint32_t count) {
+    if (first > m_vertices.size() || count > m_vertices.size() - first) {
+        throw std::runtime_error("Dynamic mesh vertex range out of bounds");
+    }
+    if (count == 0) {
+        return;
+    }
+
+    const uint32_t end = first + count;
+    for (DirtyRange& dirty : m_dirty) {
+        if (dirty.begin == dirty.end) {
+            dirty.begin = first;
+            dirty.end = end;
+        } else {
+            dirty.begin = std::min(dirty.begin, first);
+            dirty.end = std::max(dirty.end, end);
+        }
+    }
+}
+
+size_t DynamicMesh::flush(uint32_t frameSlot) {
+    DirtyRange& dirty = m_dirty[frameSlot % MAX_FRAMES_IN_FLIGHT];
+    if (!m_backend || dirty.begin == dirty.end) {
+        return 0;
+    }
+
+    PROFILE_ZONE("DynamicMesh::flush");
+    const size_t size = static_cast<size_t>(dirty.end - dirty.begin) * sizeof(Vertex);
+    m_backend->updateBufferRange(m_vertexBuffer, dirty.begin * sizeof(Vertex), &m_vertices[dirty.begin], size);
+    dirty = DirtyRange{};
+    return size;
+}
+
+} // namespace VulkanGameEngine
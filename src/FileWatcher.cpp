@@ -0,0 +1,178 @@
+#include "../headers/FileWatcher.h"
+#include "../headers/Logger.h"
+#include "../headers/Metrics.h"
+#include <algorithm>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#endif
+
+namespace VulkanGameEngine {
+
+namespace {
+
+// Polling fallback: time between rescans of the watched directories
+constexpr int64_t SCAN_INTERVAL_NS = 250'000'000;
+
+} // anonymous namespace
+
+FileWatcher::FileWatcher(uint32_t debounceMs)
+    : m_debounceNs(static_cast<int64_t>(debounceMs) * 1'000'000)
+    , m_inotify(-1)
+    , m_lastScan(0) {
+#ifdef __linux__
+    m_inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (m_inotify < 0) {
+        LOG_WARN("inotify unavailable ({}), polling write times instead", "FileWatcher", std::strerror(errno));
+    }
+#endif
+    if (m_inotify < 0) {
+        // A write is only known to have stopped after a rescan has seen no further change
+        m_debounceNs += SCAN_INTERVAL_NS;
+    }
+}
+
+FileWatcher::~FileWatcher() {
+#ifdef __linux__
+    if (m_inotify >= 0) {
+        close(m_inotify);   // Removes the watches with it
+    }
+#endif
+}
+
+bool FileWatcher::isNative() {
+#ifdef __linux__
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool FileWatcher::watch(const std::string& directory, const std::string& extension) {
+    Watch watch;
+    watch.directory = directory;
+    while (watch.directory.size() > 1 && (watch.directory.back() == '/' || watch.directory.back() == '\\')) {
+        watch.directory.pop_back();
+    }
+    watch.extension = extension;
+
+    std::error_code error;
+    if (!std::filesystem::is_directory(watch.directory, error)) {
+        LOG_WARN("Cannot watch {}: not a directory", "FileWatcher", watch.directory);
+        return false;
+    }
+
+#ifdef __linux__
+    if (m_inotify >= 0) {
+        // Saves show up as a close after writing, or as a rename onto the file (editors writing a temporary
+        // file first); every modification restarts the debounce
+        watch.descriptor = inotify_add_watch(m_inotify, watch.directory.c_str(),
+                                             IN_CLOSE_WRITE | IN_MODIFY | IN_MOVED_TO | IN_CREATE);
+        if (watch.descriptor < 0) {
+            LOG_WARN("Cannot watch {}: {}", "FileWatcher", watch.directory, std::strerror(errno));
+            return false;
+        }
+    }
+#endif
+    if (watch.descriptor < 0) {
+        scan(watch, MetricsRegistry::now(), false);
+    }
+
+    LOG_DEBUG("Watching {}/*{}", "FileWatcher", watch.directory, watch.extension);
+    m_watches.push_back(std::move(watch));
+    return true;
+}
+
+void FileWatcher::poll(std::vector<std::string>& changed) {
+    const int64_t now = MetricsRegistry::now();
+    if (m_inotify >= 0) {
+        readEvents(now);
+    } else if (now - m_lastScan >= SCAN_INTERVAL_NS) {
+        m_lastScan = now;
+        for (Watch& watch : m_watches) {
+            scan(watch, now, true);
+        }
+    }
+
+    if (m_pending.empty()) {
+        return;
+    }
+    const size_t first = changed.size();
+    for (auto it = m_pending.begin(); it != m_pending.end();) {
+        if (now - it->second >= m_debounceNs) {
+            changed.push_back(it->first);
+            it = m_pending.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    std::sort(changed.begin() + static_cast<std::ptrdiff_t>(first), changed.end());
+}
+
+void FileWatcher::readEvents(int64_t now) {
+#ifdef __linux__
+    alignas(inotify_event) char buffer[4096];
+    for (;;) {
+        const ssize_t size = read(m_inotify, buffer, sizeof(buffer));
+        if (size <= 0) {
+            // EAGAIN: the queue is empty
+            if (size < 0 && errno != EAGAIN && errno != EINTR) {
+                LOG_WARN("Reading file changes failed: {}", "FileWatcher", std::strerror(errno));
+            }
+            return;
+        }
+
+        for (ssize_t offset = 0; offset < size;) {
+            const inotify_event* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+            offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+
+            if (event->mask & IN_Q_OVERFLOW) {
+                LOG_WARN("Too many file changes at once; some were missed", "FileWatcher");
+                continue;
+            }
+            if (event->len == 0 || (event->mask & IN_ISDIR)) {
+                continue;
+            }
+            for (const Watch& watch : m_watches) {
+                if (watch.descriptor == event->wd && hasExtension(event->name, watch.extension)) {
+                    m_pending[watch.directory + "/" + event->name] = now;
+                }
+            }
+        }
+    }
+#else
+    (void)now;
+#endif
+}
+
+void FileWatcher::scan(Watch& watch, int64_t now, bool report) {
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator(watch.directory, error)) {
+        const std::string name = entry.path().filename().string();
+        if (!hasExtension(name, watch.extension) || !entry.is_regular_file(error)) {
+            continue;
+        }
+        const std::filesystem::file_time_type writeTime = entry.last_write_time(error);
+        if (error) {
+            continue;   // Deleted or replaced while scanning; the next scan sees the new file
+        }
+
+        auto it = watch.writeTimes.find(name);
+        if (it == watch.writeTimes.end() || it->second != writeTime) {
+            watch.writeTimes[name] = writeTime;
+            if (report) {
+                m_pending[watch.directory + "/" + name] = now;
+            }
+        }
+    }
+}
+
+bool FileWatcher::hasExtension(const std::string& name, const std::string& extension) {
+    return name.size() >= extension.size() &&
+           name.compare(name.size() - extension.size(), extension.size(), extension) == 0;
+}
+
+} // namespace VulkanGameEngine
@@ -0,0 +1,397 @@
+#include "../headers/FrameCapture.h"
+#include "../headers/Logger.h"
+#include <cstring>
+#include <fstream>
+
+namespace VulkanGameEngine {
+
+constexpr char FrameCapture::MAGIC[8];
+
+namespace {
+
+class Writer {
+public:
+    template <typename T>
+    void put(const T& value) {
+        const char* bytes = reinterpret_cast<const char*>(&value);
+        m_data.insert(m_data.end(), bytes, bytes + sizeof(T));
+    }
+
+    void putString(const std::string& text) {
+        put(static_cast<uint32_t>(text.size()));
+        m_data.insert(m_data.end(), text.begin(), text.end());
+    }
+
+    void putBlob(const void* data, size_t size) {
+        put(static_cast<uint64_t>(size));
+        const char* bytes = static_cast<const char*>(data);
+        m_data.insert(m_data.end(), bytes, bytes + size);
+    }
+
+    const std::vector<char>& getData() const { return m_data; }
+
+private:
+    std::vector<char> m_data;
+};
+
+/**
+ * Bounds-checked reads; the first failure sticks, so callers check once at the end of a section
+ */
+class Reader {
+public:
+    explicit Reader(const std::vector<char>& data) : m_data(data), m_offset(0), m_failed(false) {}
+
+    template <typename T>
+    T get() {
+        T value{};
+        if (canRead(sizeof(T))) {
+            std::memcpy(&value, m_data.data() + m_offset, sizeof(T));
+            m_offset += sizeof(T);
+        }
+        return value;
+    }
+
+    std::string getString() {
+        const uint32_t length = get<uint32_t>();
+        if (!canRead(length)) {
+            return std::string();
+        }
+        std::string text(m_data.data() + m_offset, length);
+        m_offset += length;
+        return text;
+    }
+
+    template <typename Byte>
+    void getBlob(std::vector<Byte>& out) {
+        const uint64_t size = get<uint64_t>();
+        if (!canRead(size)) {
+            out.clear();
+            return;
+        }
+        out.assign(m_data.begin() + static_cast<std::ptrdiff_t>(m_offset),
+                   m_data.begin() + static_cast<std::ptrdiff_t>(m_offset + size));
+        m_offset += static_cast<size_t>(size);
+    }
+
+    /**
+     * Reads an element count, failing if the rest of the file cannot hold
+     * that many records of at least minRecordSize bytes (so a corrupt count
+     * never turns into a huge allocation)
+     */
+    uint32_t getCount(size_t minRecordSize) {
+        const uint32_t count = get<uint32_t>();
+        if (m_failed || count > (m_data.size() - m_offset) / minRecordSize) {
+            m_failed = true;
+            return 0;
+        }
+        return count;
+    }
+
+    bool failed() const { return m_failed; }
+    bool atEnd() const { return m_offset == m_data.size(); }
+
+private:
+    const std::vector<char>& m_data;
+    size_t m_offset;
+    bool m_failed;
+
+    bool canRead(uint64_t size) {
+        if (m_failed || size > m_data.size() - m_offset) {
+            m_failed = true;
+            return false;
+        }
+        return true;
+    }
+};
+
+// Smallest encodings of the records that follow each count in the file
+constexpr size_t MIN_PIPELINE_RECORD = sizeof(uint32_t) + 2 * sizeof(uint32_t) + 2 * sizeof(uint64_t);
+constexpr size_t MIN_BUFFER_RECORD = sizeof(uint32_t) + sizeof(uint8_t) + sizeof(uint64_t);
+constexpr size_t MIN_COMMAND_RECORD = sizeof(uint8_t);
+
+} // anonymous namespace
+
+bool FrameCapture::save(const std::string& path) const {
+    Writer writer;
+    for (char c : MAGIC) {
+        writer.put(c);
+    }
+    writer.put(VERSION);
+    writer.put(width);
+    writer.put(height);
+    writer.put(frameIndex);
+    writer.putString(backend);
+
+    writer.put(static_cast<uint32_t>(pipelines.size()));
+    for (const Pipeline& pipeline : pipelines) {
+        writer.put(pipeline.handle);
+        writer.putString(pipeline.desc.vertexShaderPath);
+        writer.putString(pipeline.desc.fragmentShaderPath);
+        writer.putBlob(pipeline.desc.vertexShaderCode.data(), pipeline.desc.vertexShaderCode.size());
+        writer.putBlob(pipeline.desc.fragmentShaderCode.data(), pipeline.desc.fragmentShaderCode.size());
+    }
+
+    writer.put(static_cast<uint32_t>(buffers.size()));
+    for (const Buffer& buffer : buffers) {
+        writer.put(buffer.handle);
+        writer.put(static_cast<uint8_t>(buffer.type));
+        writer.putBlob(buffer.contents.data(), buffer.contents.size());
+    }
+
+    // Constants in push order, so a reader re-recording the commands gets the same indices
+    uint32_t constantCount = 0;
+    for (const Command& command : commands.getCommands()) {
+        constantCount += command.type == CommandType::PUSH_OBJECT_CONSTANTS ? 1 : 0;
+    }
+    writer.put(constantCount);
+    for (const Command& command : commands.getCommands()) {
+        if (command.type == CommandType::PUSH_OBJECT_CONSTANTS) {
+            writer.put(commands.getObjectConstants(command.handle));
+        }
+    }
+
+    writer.put(static_cast<uint32_t>(commands.size()));
+    uint32_t constantIndex = 0;
+    for (const Command& command : commands.getCommands()) {
+        writer.put(static_cast<uint8_t>(command.type));
+        switch (command.type) {
+            case CommandType::BEGIN_PASS:
+                for (float channel : command.clearColor) {
+                    writer.put(channel);
+                }
+                break;
+            case CommandType::BIND_PIPELINE:
+            case CommandType::BIND_VERTEX_BUFFER:
+            case CommandType::BIND_INDEX_BUFFER:
+            case CommandType::BIND_UNIFORMS:
+                writer.put(command.handle);
+                break;
+            case CommandType::PUSH_OBJECT_CONSTANTS:
+                writer.put(constantIndex++);
+                break;
+            case CommandType::DRAW_INDEXED:
+                writer.put(command.indexCount);
+                writer.put(command.firstIndex);
+                writer.put(command.vertexOffset);
+                break;
+            case CommandType::BEGIN_ZONE:
+                writer.putString(command.name ? command.name : "");
+                break;
+            case CommandType::END_PASS:
+            case CommandType::SET_FULL_VIEWPORT:
+            case CommandType::END_ZONE:
+                break;
+        }
+    }
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        LOG_ERROR("Cannot write frame capture " + path, "Capture");
+        return false;
+    }
+    file.write(writer.getData().data(), static_cast<std::streamsize>(writer.getData().size()));
+    if (!file.good()) {
+        LOG_ERROR("Failed writing frame capture " + path, "Capture");
+        return false;
+    }
+    return true;
+}
+
+bool FrameCapture::load(const std::string& path, FrameCapture& capture, std::string& error) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        error = "Cannot open frame capture " + path;
+        return false;
+    }
+    std::vector<char> data(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    file.read(data.data(), static_cast<std::streamsize>(data.size()));
+    if (!file) {
+        error = "Cannot read frame capture " + path;
+        return false;
+    }
+
+    Reader reader(data);
+    for (char expected : MAGIC) {
+        if (reader.get<char>() != expected) {
+            error = path + " is not a frame capture";
+            return false;
+        }
+    }
+    const uint32_t version = reader.get<uint32_t>();
+    if (version != VERSION) {
+        error = path + ": unsupported capture version " + std::to_string(version);
+        return false;
+    }
+
+    capture.width = reader.get<uint32_t>();
+    capture.height = reader.get<uint32_t>();
+    capture.frameIndex = reader.get<uint64_t>();
+    capture.backend = reader.getString();
+
+    capture.pipelines.resize(reader.getCount(MIN_PIPELINE_RECORD));
+    for (Pipeline& pipeline : capture.pipelines) {
+        pipeline.handle = reader.get<uint32_t>();
+        pipeline.desc.vertexShaderPath = reader.getString();
+        pipeline.desc.fragmentShaderPath = reader.getString();
+        reader.getBlob(pipeline.desc.vertexShaderCode);
+        reader.getBlob(pipeline.desc.fragmentShaderCode);
+        if (reader.failed()) {
+            break;
+        }
+    }
+
+    capture.buffers.resize(reader.getCount(MIN_BUFFER_RECORD));
+    for (Buffer& buffer : capture.buffers) {
+        buffer.handle = reader.get<uint32_t>();
+        const uint8_t type = reader.get<uint8_t>();
+        if (type > static_cast<uint8_t>(BufferType::DYNAMIC_VERTEX)) {
+            error = path + ": unknown buffer type " + std::to_string(type);
+            return false;
+        }
+        buffer.type = static_cast<BufferType>(type);
+        reader.getBlob(buffer.contents);
+        if (reader.failed()) {
+            break;
+        }
+    }
+
+    std::vector<ObjectConstants> constants(reader.getCount(sizeof(ObjectConstants)));
+    for (ObjectConstants& value : constants) {
+        value = reader.get<ObjectConstants>();
+    }
+
+    const uint32_t commandCount = reader.getCount(MIN_COMMAND_RECORD);
+    capture.commands.reset();
+    capture.commands.reserve(commandCount, constants.size());
+    for (uint32_t i = 0; i < commandCount && !reader.failed(); ++i) {
+        const auto type = static_cast<CommandType>(reader.get<uint8_t>());
+        switch (type) {
+            case CommandType::BEGIN_PASS: {
+                float color[4];
+                for (float& channel : color) {
+                    channel = reader.get<float>();
+                }
+                capture.commands.beginPass(color[0], color[1], color[2], color[3]);
+                break;
+            }
+            case CommandType::END_PASS:
+                capture.commands.endPass();
+                break;
+            case CommandType::BIND_PIPELINE:
+                capture.commands.bindPipeline(reader.get<uint32_t>());
+                break;
+            case CommandType::SET_FULL_VIEWPORT:
+                capture.commands.setFullViewport();
+                break;
+            case CommandType::BIND_VERTEX_BUFFER:
+                capture.commands.bindVertexBuffer(reader.get<uint32_t>());
+                break;
+            case CommandType::BIND_INDEX_BUFFER:
+                capture.commands.bindIndexBuffer(reader.get<uint32_t>());
+                break;
+            case CommandType::BIND_UNIFORMS:
+                capture.commands.bindUniforms(reader.get<uint32_t>());
+                break;
+            case CommandType::PUSH_OBJECT_CONSTANTS: {
+                const uint32_t index = reader.get<uint32_t>();
+                if (index >= constants.size()) {
+                    error = path + ": object constant index out of range";
+                    return false;
+                }
+                capture.commands.pushObjectConstants(constants[index]);
+                break;
+            }
+            case CommandType::DRAW_INDEXED: {
+                const uint32_t indexCount = reader.get<uint32_t>();
+                const uint32_t firstIndex = reader.get<uint32_t>();
+                const int32_t vertexOffset = reader.get<int32_t>();
+                capture.commands.drawIndexed(indexCount, firstIndex, vertexOffset);
+                break;
+            }
+            case CommandType::BEGIN_ZONE:
+                capture.commands.beginZone(capture.storeZoneName(reader.getString()));
+                break;
+            case CommandType::END_ZONE:
+                capture.commands.endZone();
+                break;
+            default:
+                error = path + ": unknown command type " + std::to_string(static_cast<int>(type));
+                return false;
+        }
+    }
+
+    if (reader.failed() || !reader.atEnd()) {
+        error = path + " is truncated or corrupt";
+        return false;
+    }
+    return true;
+}
+
+void FrameCapture::setCommands(const CommandList& source) {
+    commands.reset();
+    commands.reserve(source.size(), source.size());
+    for (const Command& command : source.getCommands()) {
+        switch (command.type) {
+            case CommandType::BEGIN_PASS:
+                commands.beginPass(command.clearColor[0], command.clearColor[1],
+                                   command.clearColor[2], command.clearColor[3]);
+                break;
+            case CommandType::END_PASS:
+                commands.endPass();
+                break;
+            case CommandType::BIND_PIPELINE:
+                commands.bindPipeline(command.handle);
+                break;
+            case CommandType::SET_FULL_VIEWPORT:
+                commands.setFullViewport();
+                break;
+            case CommandType::BIND_VERTEX_BUFFER:
+                commands.bindVertexBuffer(command.handle);
+                break;
+            case CommandType::BIND_INDEX_BUFFER:
+                commands.bindIndexBuffer(command.handle);
+                break;
+            case CommandType::BIND_UNIFORMS:
+                commands.bindUniforms(command.handle);
+                break;
+            case CommandType::PUSH_OBJECT_CONSTANTS:
+                commands.pushObjectConstants(source.getObjectConstants(command.handle));
+                break;
+            case CommandType::DRAW_INDEXED:
+                commands.drawIndexed(command.indexCount, command.firstIndex, command.vertexOffset);
+                break;
+            case CommandType::BEGIN_ZONE:
+                commands.beginZone(storeZoneName(command.name ? command.name : ""));
+                break;
+            case CommandType::END_ZONE:
+                commands.endZone();
+                break;
+        }
+    }
+}
+
+const FrameCapture::Pipeline* FrameCapture::findPipeline(PipelineHandle handle) const {
+    for (const Pipeline& pipeline : pipelines) {
+        if (pipeline.handle == handle) {
+            return &pipeline;
+        }
+    }
+    return nullptr;
+}
+
+const FrameCapture::Buffer* FrameCapture::findBuffer(BufferHandle handle) const {
+    for (const Buffer& buffer : buffers) {
+        if (buffer.handle == handle) {
+            return &buffer;
+        }
+    }
+    return nullptr;
+}
+
+const char* FrameCapture::storeZoneName(const std::string& name) {
+    m_zoneNames.push_back(name);
+    return m_zoneNames.back().c_str();
+}
+
+} // namespace VulkanGameEngine
@@ -0,0 +1,240 @@
+#include "../headers/FrameRecorder.h"
+#include "../headers/Logger.h"
+#include "../headers/Profiler.h"
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+
+namespace VulkanGameEngine {
+
+FrameRecorder::FrameRecorder()
+    : m_active(false)
+    , m_backend(nullptr)
+    , m_queueHead(0)
+    , m_queueCount(0)
+    , m_stopping(false)
+    , m_written(0)
+    , m_skipped(0)
+    , m_failed(0)
+    , m_video(nullptr)
+    , m_videoWidth(0)
+    , m_videoHeight(0) {
+}
+
+FrameRecorder::~FrameRecorder() {
+    stop();
+}
+
+FrameRecorder::Format FrameRecorder::getFormatForPath(const std::string& path) {
+    const std::string extension = ".y4m";
+    if (path.size() >= extension.size()) {
+        std::string tail = path.substr(path.size() - extension.size());
+        std::transform(tail.begin(), tail.end(), tail.begin(), [](unsigned char c) {
+            return static_cast<char>(std::tolower(c));
+        });
+        if (tail == extension) {
+            return Format::Y4M;
+        }
+    }
+    return Format::PPM_SEQUENCE;
+}
+
+void FrameRecorder::start(const Config& config, RenderBackend& backend) {
+    if (m_active) {
+        throw std::runtime_error("Frame recording is already running");
+    }
+    if (config.path.empty() || config.every == 0 || config.fps == 0) {
+        throw std::runtime_error("Frame recording needs a path, a frame interval and a frame rate");
+    }
+
+    m_config = config;
+    if (m_config.format == Format::Y4M) {
+        m_video = std::fopen(m_config.path.c_str(), "wb");
+        if (!m_video) {
+            throw std::runtime_error("Failed to open " + m_config.path + " for writing");
+        }
+    } else {
+        std::error_code error;
+        std::filesystem::create_directories(m_config.path, error);
+        if (error) {
+            throw std::runtime_error("Failed to create " + m_config.path + ": " + error.message());
+        }
+    }
+
+    m_videoWidth = 0;
+    m_videoHeight = 0;
+    m_queueHead = 0;
+    m_queueCount = 0;
+    m_stopping = false;
+    m_written = 0;
+    m_skipped = 0;
+    m_failed = 0;
+    m_backend = &backend;
+    m_active = true;
+    m_writerThread = std::thread(&FrameRecorder::writerThreadMain, this);
+
+    LOG_INFO("Recording every {} frame(s) to {} ({})", "Recorder", m_config.every, m_config.path,
+             m_config.format == Format::Y4M ? "Y4M video" : "PPM sequence");
+}
+
+void FrameRecorder::stop() {
+    if (!m_active) {
+        return;
+    }
+
+    // Frames still on the GPU finish here; collect them before the writer is told to stop
+    m_backend->waitIdle();
+    ReadbackFrame frame;
+    while (m_backend->pollReadback(frame)) {
+        push(frame);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wakeup.notify_all();
+    m_writerThread.join();
+
+    if (m_video) {
+        std::fclose(m_video);
+        m_video = nullptr;
+    }
+    m_active = false;
+    m_backend = nullptr;
+
+    const Stats stats = getStats();
+    LOG_INFO("Recording stopped: {} frames written to {}, {} skipped, {} failed", "Recorder",
+             stats.written, m_config.path, stats.skipped, stats.failed);
+}
+
+void FrameRecorder::onFrame(uint64_t frame) {
+    if (!m_active) {
+        return;
+    }
+    PROFILE_ZONE("FrameRecorder::onFrame");
+
+    ReadbackFrame finished;
+    while (m_backend->pollReadback(finished)) {
+        push(finished);
+    }
+
+    if (frame % m_config.every == 0 && !m_backend->requestReadback(frame)) {
+        m_skipped.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+FrameRecorder::Stats FrameRecorder::getStats() const {
+    Stats stats;
+    stats.written = m_written.load(std::memory_order_relaxed);
+    stats.skipped = m_skipped.load(std::memory_order_relaxed);
+    stats.failed = m_failed.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void FrameRecorder::push(const ReadbackFrame& frame) {
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        // Only waits if the backend's ring is larger than the queue, which the queue size rules out in practice
+        m_wakeup.wait(lock, [this] { return m_queueCount < QUEUE_CAPACITY; });
+        m_queue[(m_queueHead + m_queueCount) % QUEUE_CAPACITY] = frame;
+        m_queueCount++;
+    }
+    m_wakeup.notify_all();
+}
+
+void FrameRecorder::writerThreadMain() {
+    for (;;) {
+        ReadbackFrame frame;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wakeup.wait(lock, [this] { return m_queueCount > 0 || m_stopping; });
+            if (m_queueCount == 0) {
+                return;     // Stopping and drained
+            }
+            frame = m_queue[m_queueHead];
+            m_queueHead = (m_queueHead + 1) % QUEUE_CAPACITY;
+            m_queueCount--;
+        }
+        m_wakeup.notify_all();
+
+        const bool written = m_config.format == Format::Y4M ? writeY4M(frame) : writePPM(frame);
+        (written ? m_written : m_failed).fetch_add(1, std::memory_order_relaxed);
+
+        // The pixels point into the backend's readback buffer; it can be reused now
+        m_backend->releaseReadback(frame.id);
+    }
+}
+
+bool FrameRecorder::writePPM(const ReadbackFrame& frame) {
+    char name[32];
+    std::snprintf(name, sizeof(name), "frame_%06llu.ppm", static_cast<unsigned long long>(frame.tag));
+    const std::string path = (std::filesystem::path(m_config.path) / name).string();
+
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        LOG_ERROR("Failed to open " + path + " for writing", "Recorder");
+        return false;
+    }
+    std::fprintf(file, "P6\n%u %u\n255\n", frame.width, frame.height);
+
+    // RGBA/BGRA to RGB, one row at a time
+    const size_t red = frame.bgra ? 2 : 0;
+    const size_t blue = frame.bgra ? 0 : 2;
+    m_scratch.resize(static_cast<size_t>(frame.width) * 3);
+    for (uint32_t y = 0; y < frame.height; ++y) {
+        const uint8_t* source = frame.pixels + static_cast<size_t>(y) * frame.width * 4;
+        for (uint32_t x = 0; x < frame.width; ++x) {
+            m_scratch[x * 3 + 0] = source[x * 4 + red];
+            m_scratch[x * 3 + 1] = source[x * 4 + 1];
+            m_scratch[x * 3 + 2] = source[x * 4 + blue];
+        }
+        std::fwrite(m_scratch.data(), 1, m_scratch.size(), file);
+    }
+
+    const bool failed = std::ferror(file) != 0;
+    std::fclose(file);
+    if (failed) {
+        LOG_ERROR("Failed to write " + path, "Recorder");
+    }
+    return !failed;
+}
+
+bool FrameRecorder::writeY4M(const ReadbackFrame& frame) {
+    if (m_videoWidth == 0) {
+        // Full-resolution chroma (C444) keeps the conversion exact enough for image comparisons
+        std::fprintf(m_video, "YUV4MPEG2 W%u H%u F%u:1 Ip A1:1 C444\n", frame.width, frame.height, m_config.fps);
+        m_videoWidth = frame.width;
+        m_videoHeight = frame.height;
+    } else if (frame.width != m_videoWidth || frame.height != m_videoHeight) {
+        // A Y4M stream has one size; frames after a resize cannot go into it
+        return false;
+    }
+
+    // BT.601 limited range, planar Y then U then V
+    const size_t pixelCount = static_cast<size_t>(frame.width) * frame.height;
+    const size_t red = frame.bgra ? 2 : 0;
+    const size_t blue = frame.bgra ? 0 : 2;
+    m_scratch.resize(pixelCount * 3);
+    uint8_t* planeY = m_scratch.data();
+    uint8_t* planeU = planeY + pixelCount;
+    uint8_t* planeV = planeU + pixelCount;
+    for (size_t i = 0; i < pixelCount; ++i) {
+        const int r = frame.pixels[i * 4 + red];
+        const int g = frame.pixels[i * 4 + 1];
+        const int b = frame.pixels[i * 4 + blue];
+        planeY[i] = static_cast<uint8_t>(((66 * r + 129 * g + 25 * b + 128) >> 8) + 16);
+        planeU[i] = static_cast<uint8_t>(((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128);
+        planeV[i] = static_cast<uint8_t>(((112 * r - 94 * g - 18 * b + 128) >> 8) + 128);
+    }
+
+    std::fputs("FRAME\n", m_video);
+    std::fwrite(m_scratch.data(), 1, m_scratch.size(), m_video);
+    if (std::ferror(m_video) != 0) {
+        LOG_ERROR("Failed to write frame to " + m_config.path, "Recorder");
+        return false;
+    }
+    return true;
+}
+
+} // namespace VulkanGameEngine
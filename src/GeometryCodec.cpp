@@ -0,0 +1,419 @@
+#include "../headers/GeometryCodec.h"
+#include "../headers/Lz4.h"
+#include <cstring>
+#include <stdexcept>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define GEOMETRY_CODEC_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#define GEOMETRY_CODEC_NEON
+#include <arm_neon.h>
+#endif
+
+namespace VulkanGameEngine {
+namespace GeometryCodec {
+
+namespace {
+
+constexpr size_t INDEX_BLOCK = 16;
+constexpr size_t MAX_VERTEX_STRIDE = 256;
+constexpr uint8_t VERTEX_STORED = 0;        // Transposed deltas as is
+constexpr uint8_t VERTEX_LZ4 = 1;           // Transposed deltas, LZ4-compressed
+
+uint32_t zigzag(uint32_t delta) {
+    return (delta << 1) ^ static_cast<uint32_t>(-static_cast<int32_t>(delta >> 31));
+}
+
+#if defined(GEOMETRY_CODEC_SSE2) || defined(GEOMETRY_CODEC_NEON)
+
+void store32(uint8_t* destination, uint32_t value) {
+    std::memcpy(destination, &value, sizeof(value));
+}
+
+#endif
+
+#if defined(GEOMETRY_CODEC_SSE2)
+
+using ByteCarry = __m128i;                  // The previous sum in every byte
+
+ByteCarry zeroCarry() {
+    return _mm_setzero_si128();
+}
+
+uint8_t carryValue(ByteCarry carry) {
+    return static_cast<uint8_t>(_mm_cvtsi128_si32(carry));
+}
+
+/**
+ * Running sum of 16 bytes (mod 256) continuing from carry, which is updated
+ */
+__m128i prefixSumBytes(__m128i x, ByteCarry& carry) {
+    x = _mm_add_epi8(x, _mm_slli_si128(x, 1));
+    x = _mm_add_epi8(x, _mm_slli_si128(x, 2));
+    x = _mm_add_epi8(x, _mm_slli_si128(x, 4));
+    x = _mm_add_epi8(x, _mm_slli_si128(x, 8));
+    x = _mm_add_epi8(x, carry);
+    // Broadcast byte 15 without leaving the vector unit
+    const __m128i high = _mm_unpackhi_epi8(x, x);
+    carry = _mm_shuffle_epi32(_mm_unpackhi_epi16(high, high), 0xFF);
+    return x;
+}
+
+/**
+ * Writes the four 32-bit lanes of x to four consecutive vertices
+ */
+void storeLanes(uint8_t* destination, size_t stride, __m128i x) {
+    for (int lane = 0; lane < 4; ++lane) {
+        store32(destination + lane * stride, static_cast<uint32_t>(_mm_cvtsi128_si32(x)));
+        x = _mm_srli_si128(x, 4);
+    }
+}
+
+/**
+ * Decodes 16 vertices of four byte streams: running sums, then the bytes
+ * interleaved back into 4-byte groups (vertex i gets byte i of each stream)
+ */
+void decodeVertexBlock(const uint8_t* const streams[4], size_t i, ByteCarry carries[4], uint8_t* destination,
+                       size_t stride) {
+    const __m128i x0 = prefixSumBytes(_mm_loadu_si128(reinterpret_cast<const __m128i*>(streams[0] + i)), carries[0]);
+    const __m128i x1 = prefixSumBytes(_mm_loadu_si128(reinterpret_cast<const __m128i*>(streams[1] + i)), carries[1]);
+    const __m128i x2 = prefixSumBytes(_mm_loadu_si128(reinterpret_cast<const __m128i*>(streams[2] + i)), carries[2]);
+    const __m128i x3 = prefixSumBytes(_mm_loadu_si128(reinterpret_cast<const __m128i*>(streams[3] + i)), carries[3]);
+
+    const __m128i low01 = _mm_unpacklo_epi8(x0, x1);
+    const __m128i high01 = _mm_unpackhi_epi8(x0, x1);
+    const __m128i low23 = _mm_unpacklo_epi8(x2, x3);
+    const __m128i high23 = _mm_unpackhi_epi8(x2, x3);
+    storeLanes(destination, stride, _mm_unpacklo_epi16(low01, low23));
+    storeLanes(destination + 4 * stride, stride, _mm_unpackhi_epi16(low01, low23));
+    storeLanes(destination + 8 * stride, stride, _mm_unpacklo_epi16(high01, high23));
+    storeLanes(destination + 12 * stride, stride, _mm_unpackhi_epi16(high01, high23));
+}
+
+/**
+ * Zigzag-decodes 4 deltas and adds them up from carry (the previous index in every lane)
+ */
+__m128i decodeIndexLanes(__m128i values, __m128i& carry) {
+    const __m128i sign = _mm_sub_epi32(_mm_setzero_si128(), _mm_and_si128(values, _mm_set1_epi32(1)));
+    __m128i x = _mm_xor_si128(_mm_srli_epi32(values, 1), sign);
+    x = _mm_add_epi32(x, _mm_slli_si128(x, 4));
+    x = _mm_add_epi32(x, _mm_slli_si128(x, 8));
+    x = _mm_add_epi32(x, carry);
+    carry = _mm_shuffle_epi32(x, 0xFF);
+    return x;
+}
+
+void decodeIndexBlock(const uint8_t* data, uint8_t width, uint32_t* destination, __m128i& carry) {
+    const __m128i zero = _mm_setzero_si128();
+    __m128i values[4];
+    if (width == 1) {
+        const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+        const __m128i low = _mm_unpacklo_epi8(bytes, zero);
+        const __m128i high = _mm_unpackhi_epi8(bytes, zero);
+        values[0] = _mm_unpacklo_epi16(low, zero);
+        values[1] = _mm_unpackhi_epi16(low, zero);
+        values[2] = _mm_unpacklo_epi16(high, zero);
+        values[3] = _mm_unpackhi_epi16(high, zero);
+    } else if (width == 2) {
+        const __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+        const __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16));
+        values[0] = _mm_unpacklo_epi16(low, zero);
+        values[1] = _mm_unpackhi_epi16(low, zero);
+        values[2] = _mm_unpacklo_epi16(high, zero);
+        values[3] = _mm_unpackhi_epi16(high, zero);
+    } else {
+        for (int k = 0; k < 4; ++k) {
+            values[k] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16 * k));
+        }
+    }
+    for (int k = 0; k < 4; ++k) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + 4 * k), decodeIndexLanes(values[k], carry));
+    }
+}
+
+#elif defined(GEOMETRY_CODEC_NEON)
+
+using ByteCarry = uint8x16_t;
+
+ByteCarry zeroCarry() {
+    return vdupq_n_u8(0);
+}
+
+uint8_t carryValue(ByteCarry carry) {
+    return vgetq_lane_u8(carry, 0);
+}
+
+uint8x16_t prefixSumBytes(uint8x16_t x, ByteCarry& carry) {
+    const uint8x16_t zero = vdupq_n_u8(0);
+    x = vaddq_u8(x, vextq_u8(zero, x, 15));
+    x = vaddq_u8(x, vextq_u8(zero, x, 14));
+    x = vaddq_u8(x, vextq_u8(zero, x, 12));
+    x = vaddq_u8(x, vextq_u8(zero, x, 8));
+    x = vaddq_u8(x, carry);
+    carry = vdupq_laneq_u8(x, 15);
+    return x;
+}
+
+void storeLanes(uint8_t* destination, size_t stride, uint16x8_t x) {
+    const uint32x4_t lanes = vreinterpretq_u32_u16(x);
+    store32(destination, vgetq_lane_u32(lanes, 0));
+    store32(destination + stride, vgetq_lane_u32(lanes, 1));
+    store32(destination + 2 * stride, vgetq_lane_u32(lanes, 2));
+    store32(destination + 3 * stride, vgetq_lane_u32(lanes, 3));
+}
+
+void decodeVertexBlock(const uint8_t* const streams[4], size_t i, ByteCarry carries[4], uint8_t* destination,
+                       size_t stride) {
+    const uint8x16_t x0 = prefixSumBytes(vld1q_u8(streams[0] + i), carries[0]);
+    const uint8x16_t x1 = prefixSumBytes(vld1q_u8(streams[1] + i), carries[1]);
+    const uint8x16_t x2 = prefixSumBytes(vld1q_u8(streams[2] + i), carries[2]);
+    const uint8x16_t x3 = prefixSumBytes(vld1q_u8(streams[3] + i), carries[3]);
+
+    const uint8x16x2_t pairs01 = vzipq_u8(x0, x1);
+    const uint8x16x2_t pairs23 = vzipq_u8(x2, x3);
+    const uint16x8x2_t low = vzipq_u16(vreinterpretq_u16_u8(pairs01.val[0]), vreinterpretq_u16_u8(pairs23.val[0]));
+    const uint16x8x2_t high = vzipq_u16(vreinterpretq_u16_u8(pairs01.val[1]), vreinterpretq_u16_u8(pairs23.val[1]));
+    storeLanes(destination, stride, low.val[0]);
+    storeLanes(destination + 4 * stride, stride, low.val[1]);
+    storeLanes(destination + 8 * stride, stride, high.val[0]);
+    storeLanes(destination + 12 * stride, stride, high.val[1]);
+}
+
+uint32x4_t decodeIndexLanes(uint32x4_t values, uint32x4_t& carry) {
+    const uint32x4_t zero = vdupq_n_u32(0);
+    const uint32x4_t sign = vsubq_u32(zero, vandq_u32(values, vdupq_n_u32(1)));
+    uint32x4_t x = veorq_u32(vshrq_n_u32(values, 1), sign);
+    x = vaddq_u32(x, vextq_u32(zero, x, 3));
+    x = vaddq_u32(x, vextq_u32(zero, x, 2));
+    x = vaddq_u32(x, carry);
+    carry = vdupq_n_u32(vgetq_lane_u32(x, 3));
+    return x;
+}
+
+void decodeIndexBlock(const uint8_t* data, uint8_t width, uint32_t* destination, uint32x4_t& carry) {
+    uint32x4_t values[4];
+    if (width == 1) {
+        const uint8x16_t bytes = vld1q_u8(data);
+        const uint16x8_t low = vmovl_u8(vget_low_u8(bytes));
+        const uint16x8_t high = vmovl_u8(vget_high_u8(bytes));
+        values[0] = vmovl_u16(vget_low_u16(low));
+        values[1] = vmovl_u16(vget_high_u16(low));
+        values[2] = vmovl_u16(vget_low_u16(high));
+        values[3] = vmovl_u16(vget_high_u16(high));
+    } else if (width == 2) {
+        const uint16x8_t low = vreinterpretq_u16_u8(vld1q_u8(data));
+        const uint16x8_t high = vreinterpretq_u16_u8(vld1q_u8(data + 16));
+        values[0] = vmovl_u16(vget_low_u16(low));
+        values[1] = vmovl_u16(vget_high_u16(low));
+        values[2] = vmovl_u16(vget_low_u16(high));
+        values[3] = vmovl_u16(vget_high_u16(high));
+    } else {
+        for (int k = 0; k < 4; ++k) {
+            values[k] = vreinterpretq_u32_u8(vld1q_u8(data + 16 * k));
+        }
+    }
+    for (int k = 0; k < 4; ++k) {
+        vst1q_u32(destination + 4 * k, decodeIndexLanes(values[k], carry));
+    }
+}
+
+#else
+
+uint32_t unzigzag(uint32_t value) {
+    return (value >> 1) ^ static_cast<uint32_t>(-static_cast<int32_t>(value & 1));
+}
+
+#endif
+
+/**
+ * Rebuilds vertices from their transposed byte deltas
+ */
+void untransposeVertices(const uint8_t* transposed, size_t count, size_t stride, uint8_t* vertices) {
+    size_t byte = 0;
+#if defined(GEOMETRY_CODEC_SSE2) || defined(GEOMETRY_CODEC_NEON)
+    // 16 whole vertices per step (so each output line is written once), four
+    // streams at a time; a stride that is not a multiple of 4 leaves its last
+    // bytes to the scalar loop below
+    const size_t groups = stride / 4;
+    ByteCarry carries[MAX_VERTEX_STRIDE];
+    for (size_t k = 0; k < groups * 4; ++k) {
+        carries[k] = zeroCarry();
+    }
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        for (size_t group = 0; group < groups; ++group) {
+            const size_t first = group * 4;
+            const uint8_t* const streams[4] = {transposed + first * count, transposed + (first + 1) * count,
+                                               transposed + (first + 2) * count, transposed + (first + 3) * count};
+            decodeVertexBlock(streams, i, &carries[first], vertices + i * stride + first, stride);
+        }
+    }
+    for (byte = 0; byte < groups * 4; ++byte) {
+        uint8_t value = carryValue(carries[byte]);
+        for (size_t tail = i; tail < count; ++tail) {
+            value = static_cast<uint8_t>(value + transposed[byte * count + tail]);
+            vertices[tail * stride + byte] = value;
+        }
+    }
+#endif
+    for (; byte < stride; ++byte) {
+        const uint8_t* stream = transposed + byte * count;
+        uint8_t value = 0;
+        for (size_t vertex = 0; vertex < count; ++vertex) {
+            value = static_cast<uint8_t>(value + stream[vertex]);
+            vertices[vertex * stride + byte] = value;
+        }
+    }
+}
+
+} // anonymous namespace
+
+void encodeVertices(const void* vertices, size_t count, size_t stride, std::vector<uint8_t>& out) {
+    if (stride == 0 || stride > MAX_VERTEX_STRIDE) {
+        throw std::runtime_error("Unsupported vertex stride " + std::to_string(stride));
+    }
+    const uint8_t* bytes = static_cast<const uint8_t*>(vertices);
+    const size_t size = count * stride;
+    std::vector<uint8_t> transposed(size);
+    for (size_t byte = 0; byte < stride; ++byte) {
+        uint8_t previous = 0;
+        for (size_t i = 0; i < count; ++i) {
+            const uint8_t value = bytes[i * stride + byte];
+            transposed[byte * count + i] = static_cast<uint8_t>(value - previous);
+            previous = value;
+        }
+    }
+
+    std::vector<uint8_t> compressed(Lz4::compressBound(size));
+    const size_t compressedSize = size > 0 ? Lz4::compress(transposed.data(), size, compressed.data(), compressed.size()) : 0;
+    if (compressedSize > 0 && compressedSize < size) {
+        out.push_back(VERTEX_LZ4);
+        out.insert(out.end(), compressed.begin(), compressed.begin() + static_cast<std::ptrdiff_t>(compressedSize));
+    } else {
+        out.push_back(VERTEX_STORED);
+        out.insert(out.end(), transposed.begin(), transposed.end());
+    }
+}
+
+bool decodeVertices(void* vertices, size_t count, size_t stride, const uint8_t* data, size_t size) {
+    if (size < 1 || stride == 0 || stride > MAX_VERTEX_STRIDE || count > SIZE_MAX / stride) {
+        return false;
+    }
+    const size_t decodedSize = count * stride;
+    const uint8_t* transposed = data + 1;
+    std::vector<uint8_t> scratch;
+    if (data[0] == VERTEX_STORED) {
+        if (size - 1 != decodedSize) {
+            return false;
+        }
+    } else if (data[0] == VERTEX_LZ4) {
+        scratch.resize(decodedSize);
+        if (!Lz4::decompress(data + 1, size - 1, scratch.data(), decodedSize)) {
+            return false;
+        }
+        transposed = scratch.data();
+    } else {
+        return false;
+    }
+
+    untransposeVertices(transposed, count, stride, static_cast<uint8_t*>(vertices));
+    return true;
+}
+
+void encodeIndices(const uint32_t* indices, size_t count, std::vector<uint8_t>& out) {
+    // Zigzag deltas, padded with zeros to whole blocks
+    std::vector<uint32_t> values((count + INDEX_BLOCK - 1) / INDEX_BLOCK * INDEX_BLOCK, 0);
+    uint32_t previous = 0;
+    size_t i = 0;
+    for (; i + 3 <= count; i += 3) {
+        // The rotation whose deltas are smallest, like continuing a fan
+        const uint32_t* triangle = indices + i;
+        int bestRotation = 0;
+        uint64_t bestCost = UINT64_MAX;
+        for (int rotation = 0; rotation < 3; ++rotation) {
+            uint64_t cost = 0;
+            uint32_t last = previous;
+            for (int k = 0; k < 3; ++k) {
+                const uint32_t index = triangle[(rotation + k) % 3];
+                cost += zigzag(index - last);
+                last = index;
+            }
+            if (cost < bestCost) {
+                bestCost = cost;
+                bestRotation = rotation;
+            }
+        }
+        for (int k = 0; k < 3; ++k) {
+            const uint32_t index = triangle[(bestRotation + k) % 3];
+            values[i + k] = zigzag(index - previous);
+            previous = index;
+        }
+    }
+    for (; i < count; ++i) {
+        values[i] = zigzag(indices[i] - previous);
+        previous = indices[i];
+    }
+
+    for (size_t block = 0; block < values.size(); block += INDEX_BLOCK) {
+        uint32_t largest = 0;
+        for (size_t k = 0; k < INDEX_BLOCK; ++k) {
+            largest |= values[block + k];
+        }
+        const uint8_t width = largest <= 0xFF ? 1 : largest <= 0xFFFF ? 2 : 4;
+        out.push_back(width);
+        for (size_t k = 0; k < INDEX_BLOCK; ++k) {
+            for (uint8_t b = 0; b < width; ++b) {
+                out.push_back(static_cast<uint8_t>(values[block + k] >> (8 * b)));
+            }
+        }
+    }
+}
+
+bool decodeIndices(uint32_t* indices, size_t count, const uint8_t* data, size_t size) {
+    const uint8_t* const end = data + size;
+    const size_t blocks = (count + INDEX_BLOCK - 1) / INDEX_BLOCK;
+#if defined(GEOMETRY_CODEC_SSE2)
+    __m128i carry = _mm_setzero_si128();
+#elif defined(GEOMETRY_CODEC_NEON)
+    uint32x4_t carry = vdupq_n_u32(0);
+#else
+    uint32_t carry = 0;
+#endif
+
+    for (size_t block = 0; block < blocks; ++block) {
+        if (data >= end) {
+            return false;
+        }
+        const uint8_t width = *data++;
+        if ((width != 1 && width != 2 && width != 4) || static_cast<size_t>(end - data) < INDEX_BLOCK * width) {
+            return false;
+        }
+
+        // The last block decodes into a scratch block (its padding is not output)
+        uint32_t scratch[INDEX_BLOCK];
+        const size_t first = block * INDEX_BLOCK;
+        const bool partial = count - first < INDEX_BLOCK;
+        uint32_t* destination = partial ? scratch : indices + first;
+#if defined(GEOMETRY_CODEC_SSE2) || defined(GEOMETRY_CODEC_NEON)
+        decodeIndexBlock(data, width, destination, carry);
+#else
+        for (size_t k = 0; k < INDEX_BLOCK; ++k) {
+            uint32_t value = 0;
+            for (uint8_t b = 0; b < width; ++b) {
+                value |= static_cast<uint32_t>(data[k * width + b]) << (8 * b);
+            }
+            carry += unzigzag(value);
+            destination[k] = carry;
+        }
+#endif
+        if (partial) {
+            std::memcpy(indices + first, scratch, (count - first) * sizeof(uint32_t));
+        }
+        data += INDEX_BLOCK * width;
+    }
+    return data == end;
+}
+
+} // namespace GeometryCodec
+} // namespace VulkanGameEngine
@@ -0,0 +1,259 @@
+#include "../headers/GpuProfiler.h"
+#include "../headers/VulkanUtils.h"
+#include "../headers/VulkanCallStats.h"
+#include "../headers/Logger.h"
+#include "../headers/Profiler.h"
+#include <algorithm>
+
+namespace VulkanGameEngine {
+
+namespace {
+
+// Counters selected for the statistics query, in the order Vulkan returns them (ascending bit order)
+constexpr VkQueryPipelineStatisticFlags STATISTICS_FLAGS =
+    VK_QUERY_PIPELINE_STATISTIC_INPUT_ASSEMBLY_VERTICES_BIT |
+    VK_QUERY_PIPELINE_STATISTIC_INPUT_ASSEMBLY_PRIMITIVES_BIT |
+    VK_QUERY_PIPELINE_STATISTIC_VERTEX_SHADER_INVOCATIONS_BIT |
+    VK_QUERY_PIPELINE_STATISTIC_CLIPPING_INVOCATIONS_BIT |
+    VK_QUERY_PIPELINE_STATISTIC_CLIPPING_PRIMITIVES_BIT |
+    VK_QUERY_PIPELINE_STATISTIC_FRAGMENT_SHADER_INVOCATIONS_BIT;
+
+constexpr uint32_t STATISTICS_VALUE_COUNT = 6;
+
+} // anonymous namespace
+
+GpuProfiler::GpuProfiler()
+    : m_device(VK_NULL_HANDLE)
+    , m_supported(false)
+    , m_statisticsEnabled(false)
+    , m_timestampPeriodNs(1.0)
+    , m_timestampMask(~0ull)
+    , m_currentSlot(0) {
+}
+
+GpuProfiler::~GpuProfiler() {
+    cleanup();
+}
+
+void GpuProfiler::create(const VulkanDevice& device, uint32_t framesInFlight, bool enablePipelineStatistics) {
+    m_device = device.getLogicalDevice();
+
+    // Timestamps are only meaningful if the graphics queue family reports valid bits
+    uint32_t familyCount = 0;
+    vkGetPhysicalDeviceQueueFamilyProperties(device.getPhysicalDevice(), &familyCount, nullptr);
+    std::vector<VkQueueFamilyProperties> families(familyCount);
+    vkGetPhysicalDeviceQueueFamilyProperties(device.getPhysicalDevice(), &familyCount, families.data());
+
+    const uint32_t graphicsFamily = device.getQueueFamilyIndices().graphicsFamily.value();
+    const uint32_t validBits = graphicsFamily < familyCount ? families[graphicsFamily].timestampValidBits : 0;
+    const VkPhysicalDeviceLimits& limits = device.getDeviceProperties().limits;
+
+    if (validBits == 0 || limits.timestampPeriod <= 0.0f) {
+        LOG_WARN("GPU timestamps not supported on this queue; GPU profiling disabled", "GpuProfiler");
+        m_supported = false;
+        return;
+    }
+
+    m_supported = true;
+    m_timestampPeriodNs = limits.timestampPeriod;
+    m_timestampMask = (validBits >= 64) ? ~0ull : ((1ull << validBits) - 1);
+    m_statisticsEnabled = enablePipelineStatistics && device.getEnabledFeatures().pipelineStatisticsQuery;
+
+    m_frames.resize(framesInFlight);
+    for (FrameQueries& frame : m_frames) {
+        VkQueryPoolCreateInfo timestampInfo{};
+        timestampInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+        timestampInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+        timestampInfo.queryCount = MAX_ZONES_PER_FRAME * 2;
+        VK_CHECK(vkCreateQueryPool(m_device, &timestampInfo, nullptr, &frame.timestampPool),
+                 "Failed to create timestamp query pool");
+
+        if (m_statisticsEnabled) {
+            VkQueryPoolCreateInfo statisticsInfo{};
+            statisticsInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+            statisticsInfo.queryType = VK_QUERY_TYPE_PIPELINE_STATISTICS;
+            statisticsInfo.queryCount = 1;
+            statisticsInfo.pipelineStatistics = STATISTICS_FLAGS;
+            VK_CHECK(vkCreateQueryPool(m_device, &statisticsInfo, nullptr, &frame.statisticsPool),
+                     "Failed to create pipeline statistics query pool");
+        }
+    }
+
+    // Pre-size everything touched per frame so readback never allocates
+    m_timestampScratch.resize(MAX_ZONES_PER_FRAME * 2);
+    m_lastResults.zones.reserve(MAX_ZONES_PER_FRAME);
+
+    VulkanUtils::logObjectCreation("GpuProfiler",
+        std::to_string(framesInFlight) + " query pools, timestamp period " +
+        std::to_string(m_timestampPeriodNs) + "ns" +
+        (m_statisticsEnabled ? ", pipeline statistics enabled" : ""));
+}
+
+void GpuProfiler::cleanup() {
+    if (m_device == VK_NULL_HANDLE) {
+        return;
+    }
+
+    for (FrameQueries& frame : m_frames) {
+        if (frame.timestampPool != VK_NULL_HANDLE) {
+            vkDestroyQueryPool(m_device, frame.timestampPool, nullptr);
+        }
+        if (frame.statisticsPool != VK_NULL_HANDLE) {
+            vkDestroyQueryPool(m_device, frame.statisticsPool, nullptr);
+        }
+    }
+    m_frames.clear();
+
+    if (m_supported) {
+        VulkanUtils::logObjectDestruction("GpuProfiler");
+    }
+
+    m_supported = false;
+    m_statisticsEnabled = false;
+    m_device = VK_NULL_HANDLE;
+}
+
+void GpuProfiler::collectResults(uint32_t frameSlot) {
+    if (!m_supported || frameSlot >= m_frames.size()) {
+        return;
+    }
+
+    FrameQueries& frame = m_frames[frameSlot];
+    if (!frame.pending || frame.zoneCount == 0) {
+        frame.pending = false;
+        return;
+    }
+    frame.pending = false;
+
+    // No WAIT flag: the frame fence has already signalled, and if it somehow
+    // has not, skipping one frame of data is better than stalling
+    const uint32_t queryCount = frame.zoneCount * 2;
+    VkResult result = VK_TRACKED(GetQueryPoolResults, vkGetQueryPoolResults(m_device, frame.timestampPool, 0, queryCount,
+                                                                            queryCount * sizeof(uint64_t), m_timestampScratch.data(),
+                                                                            sizeof(uint64_t), VK_QUERY_RESULT_64_BIT));
+    if (result != VK_SUCCESS) {
+        return;
+    }
+
+    uint64_t frameStart = UINT64_MAX;
+    uint64_t frameEnd = 0;
+    for (uint32_t i = 0; i < queryCount; ++i) {
+        const uint64_t timestamp = m_timestampScratch[i] & m_timestampMask;
+        m_timestampScratch[i] = timestamp;
+        frameStart = std::min(frameStart, timestamp);
+        frameEnd = std::max(frameEnd, timestamp);
+    }
+
+    m_lastResults.valid = true;
+    m_lastResults.frame = frame.frame;
+    m_lastResults.gpuTimeMs = (frameEnd - frameStart) * m_timestampPeriodNs / 1.0e6;
+    m_lastResults.zones.clear();
+
+    Profiler& profiler = Profiler::getInstance();
+    for (uint32_t zone = 0; zone < frame.zoneCount; ++zone) {
+        const uint64_t begin = m_timestampScratch[zone * 2];
+        const uint64_t end = std::max(m_timestampScratch[zone * 2 + 1], begin);
+
+        ZoneResult zoneResult;
+        zoneResult.name = frame.zoneNames[zone];
+        zoneResult.startMs = (begin - frameStart) * m_timestampPeriodNs / 1.0e6;
+        zoneResult.durationMs = (end - begin) * m_timestampPeriodNs / 1.0e6;
+        zoneResult.depth = frame.zoneDepths[zone];
+        m_lastResults.zones.push_back(zoneResult);
+
+        const int64_t startNs = frame.submitTimeNs + static_cast<int64_t>((begin - frameStart) * m_timestampPeriodNs);
+        const int64_t endNs = frame.submitTimeNs + static_cast<int64_t>((end - frameStart) * m_timestampPeriodNs);
+        profiler.recordGpuZone(zoneResult.name, startNs, endNs, frame.frame, zoneResult.depth);
+    }
+
+    m_lastResults.hasStatistics = false;
+    if (frame.statisticsWritten) {
+        uint64_t values[STATISTICS_VALUE_COUNT] = {};
+        result = VK_TRACKED(GetQueryPoolResults, vkGetQueryPoolResults(m_device, frame.statisticsPool, 0, 1, sizeof(values), values,
+                                                                       sizeof(values), VK_QUERY_RESULT_64_BIT));
+        if (result == VK_SUCCESS) {
+            m_lastResults.hasStatistics = true;
+            m_lastResults.statistics.inputAssemblyVertices = values[0];
+            m_lastResults.statistics.inputAssemblyPrimitives = values[1];
+            m_lastResults.statistics.vertexShaderInvocations = values[2];
+            m_lastResults.statistics.clippingInvocations = values[3];
+            m_lastResults.statistics.clippingPrimitives = values[4];
+            m_lastResults.statistics.fragmentShaderInvocations = values[5];
+        }
+    }
+}
+
+void GpuProfiler::beginFrame(VkCommandBuffer commandBuffer, uint32_t frameSlot) {
+    if (!m_supported || frameSlot >= m_frames.size()) {
+        return;
+    }
+
+    m_currentSlot = frameSlot;
+    FrameQueries& frame = m_frames[frameSlot];
+    frame.zoneCount = 0;
+    frame.openDepth = 0;
+    frame.statisticsWritten = false;
+    frame.pending = false;
+    frame.frame = Profiler::getInstance().getFrameIndex();
+
+    VK_TRACKED(CmdResetQueryPool, vkCmdResetQueryPool(commandBuffer, frame.timestampPool, 0, MAX_ZONES_PER_FRAME * 2));
+    if (frame.statisticsPool != VK_NULL_HANDLE) {
+        VK_TRACKED(CmdResetQueryPool, vkCmdResetQueryPool(commandBuffer, frame.statisticsPool, 0, 1));
+    }
+}
+
+void GpuProfiler::endFrame(uint32_t frameSlot) {
+    if (!m_supported || frameSlot >= m_frames.size()) {
+        return;
+    }
+
+    FrameQueries& frame = m_frames[frameSlot];
+    frame.submitTimeNs = Profiler::now();
+    frame.pending = true;
+}
+
+uint32_t GpuProfiler::beginZone(VkCommandBuffer commandBuffer, const char* name) {
+    if (!m_supported) {
+        return UINT32_MAX;
+    }
+
+    FrameQueries& frame = m_frames[m_currentSlot];
+    if (frame.zoneCount >= MAX_ZONES_PER_FRAME) {
+        return UINT32_MAX;
+    }
+
+    const uint32_t zone = frame.zoneCount++;
+    frame.zoneNames[zone] = name;
+    frame.zoneDepths[zone] = frame.openDepth++;
+    VK_TRACKED(CmdWriteTimestamp, vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, frame.timestampPool, zone * 2));
+    return zone;
+}
+
+void GpuProfiler::endZone(VkCommandBuffer commandBuffer, uint32_t zone) {
+    if (!m_supported || zone == UINT32_MAX) {
+        return;
+    }
+
+    FrameQueries& frame = m_frames[m_currentSlot];
+    if (frame.openDepth > 0) {
+        frame.openDepth--;
+    }
+    VK_TRACKED(CmdWriteTimestamp, vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, frame.timestampPool, zone * 2 + 1));
+}
+
+void GpuProfiler::beginStatistics(VkCommandBuffer commandBuffer) {
+    if (!m_statisticsEnabled) {
+        return;
+    }
+    VK_TRACKED(CmdBeginQuery, vkCmdBeginQuery(commandBuffer, m_frames[m_currentSlot].statisticsPool, 0, 0));
+}
+
+void GpuProfiler::endStatistics(VkCommandBuffer commandBuffer) {
+    if (!m_statisticsEnabled) {
+        return;
+    }
+    VK_TRACKED(CmdEndQuery, vkCmdEndQuery(commandBuffer, m_frames[m_currentSlot].statisticsPool, 0));
+    m_frames[m_currentSlot].statisticsWritten = true;
+}
+
+} // namespace VulkanGameEngine
@@ -0,0 +1,234 @@
+#include "../headers/HitchDetector.h"
+#include "../headers/Metrics.h"
+#include "../headers/Profiler.h"
+#include "../headers/Logger.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+
+namespace VulkanGameEngine {
+
+namespace {
+
+void appendJsonString(std::string& out, const char* text) {
+    out += '"';
+    for (const char* c = text; *c; ++c) {
+        if (*c == '"' || *c == '\\') {
+            out += '\\';
+        }
+        out += *c;
+    }
+    out += '"';
+}
+
+// Recompute the median every few frames; it drifts slowly and nth_element is not free
+constexpr uint64_t MEDIAN_UPDATE_INTERVAL = 16;
+
+// Longest zones of the hitch frame listed in the summary
+constexpr size_t SUMMARY_ZONE_COUNT = 10;
+
+} // anonymous namespace
+
+HitchDetector& HitchDetector::getInstance() {
+    static HitchDetector instance;
+    return instance;
+}
+
+HitchDetector::HitchDetector() {
+    configure(Config());
+}
+
+void HitchDetector::configure(const Config& config) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_config = config;
+    m_config.historyFrames = std::max(m_config.historyFrames,
+                                      m_config.framesBefore + m_config.framesAfter + 1);
+
+    m_history.assign(m_config.historyFrames, FrameRecord());
+    m_medianScratch.resize(m_config.historyFrames);
+    m_recordedFrames = 0;
+    m_medianNs = 0;
+    m_pending = PendingDump();
+}
+
+void HitchDetector::watchCounter(const std::string& name) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_counters.size() >= MAX_WATCHED_COUNTERS) {
+        LOG_WARN("Cannot watch counter {}: limit of {} reached", "Hitch", name, MAX_WATCHED_COUNTERS);
+        return;
+    }
+    for (const WatchedCounter& watched : m_counters) {
+        if (watched.name == name) {
+            return;
+        }
+    }
+
+    WatchedCounter watched;
+    watched.name = name;
+    watched.counter = &MetricsRegistry::getInstance().counter(name);
+    watched.lastTotal = watched.counter->getTotal();
+    m_counters.push_back(watched);
+}
+
+void HitchDetector::endFrame(uint64_t frameIndex, int64_t durationNs) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    FrameRecord& record = m_history[m_recordedFrames % m_history.size()];
+    record.frame = frameIndex;
+    record.durationNs = durationNs;
+    for (size_t i = 0; i < m_counters.size(); ++i) {
+        const uint64_t total = m_counters[i].counter->getTotal();
+        record.counterDeltas[i] = total - m_counters[i].lastTotal;
+        m_counters[i].lastTotal = total;
+    }
+    m_recordedFrames++;
+
+    if (m_pending.active && frameIndex >= m_pending.lastFrame) {
+        writeDump();
+        m_pending.active = false;
+        // The frame that wrote the dump is slow by our own doing; don't flag it
+        return;
+    }
+
+    if (m_recordedFrames % MEDIAN_UPDATE_INTERVAL == 0) {
+        updateMedian();
+    }
+
+    if (!m_enabled || m_pending.active || m_recordedFrames < m_config.warmupFrames || m_medianNs == 0) {
+        return;
+    }
+
+    const int64_t budgetNs = std::max(static_cast<int64_t>(m_medianNs * m_config.budgetMultiplier),
+                                      static_cast<int64_t>(m_config.minBudgetMs * 1e6));
+    if (durationNs <= budgetNs) {
+        return;
+    }
+
+    m_hitchCount++;
+
+    const int64_t timestamp = Profiler::now();
+    const bool coolingDown = m_dumpCount > 0 &&
+                             timestamp - m_lastDumpNs < static_cast<int64_t>(m_config.cooldownSeconds * 1e9);
+    if (coolingDown || m_dumpCount >= m_config.maxDumps) {
+        LOG_WARN("Hitch: frame {} took {:.2f}ms (budget {:.2f}ms); dump skipped", "Hitch",
+                 frameIndex, durationNs / 1e6, budgetNs / 1e6);
+        return;
+    }
+
+    m_pending.active = true;
+    m_pending.hitchFrame = frameIndex;
+    m_pending.hitchDurationNs = durationNs;
+    m_pending.budgetNs = budgetNs;
+    m_pending.medianNs = m_medianNs;
+    m_pending.lastFrame = frameIndex + m_config.framesAfter;
+    m_lastDumpNs = timestamp;
+    m_dumpCount++;
+
+    if (m_config.framesAfter == 0) {
+        writeDump();
+        m_pending.active = false;
+    }
+}
+
+void HitchDetector::updateMedian() {
+    const size_t count = static_cast<size_t>(std::min<uint64_t>(m_recordedFrames, m_history.size()));
+    if (count == 0) {
+        return;
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        m_medianScratch[i] = m_history[i].durationNs;
+    }
+    auto middle = m_medianScratch.begin() + count / 2;
+    std::nth_element(m_medianScratch.begin(), middle, m_medianScratch.begin() + count);
+    m_medianNs = *middle;
+}
+
+const HitchDetector::FrameRecord* HitchDetector::findFrame(uint64_t frame) const {
+    for (const FrameRecord& record : m_history) {
+        if (record.frame == frame && record.durationNs != 0) {
+            return &record;
+        }
+    }
+    return nullptr;
+}
+
+void HitchDetector::writeDump() {
+    const uint64_t hitchFrame = m_pending.hitchFrame;
+    const uint64_t firstFrame = hitchFrame > m_config.framesBefore ? hitchFrame - m_config.framesBefore : 1;
+    const uint64_t lastFrame = m_pending.lastFrame;
+
+    const std::string basePath = m_config.dumpDirectory + "/hitch_" + std::to_string(hitchFrame);
+    const std::string summaryPath = basePath + ".json";
+    const std::string tracePath = basePath + "_trace.json";
+
+    // Longest zones of the hitch frame point at the culprit
+    std::vector<Profiler::Event> zones;
+    Profiler::getInstance().collectEvents(hitchFrame, hitchFrame, zones);
+    std::sort(zones.begin(), zones.end(), [](const Profiler::Event& a, const Profiler::Event& b) {
+        return (a.endNs - a.startNs) > (b.endNs - b.startNs);
+    });
+    if (zones.size() > SUMMARY_ZONE_COUNT) {
+        zones.resize(SUMMARY_ZONE_COUNT);
+    }
+
+    std::string out;
+    out.reserve(4096 + (lastFrame - firstFrame + 1) * 128);
+    char buffer[256];
+
+    std::snprintf(buffer, sizeof(buffer),
+                  "{\n  \"hitchFrame\": %llu,\n  \"durationMs\": %.3f,\n  \"budgetMs\": %.3f,\n  \"medianMs\": %.3f,\n",
+                  static_cast<unsigned long long>(hitchFrame), m_pending.hitchDurationNs / 1e6,
+                  m_pending.budgetNs / 1e6, m_pending.medianNs / 1e6);
+    out += buffer;
+    out += "  \"trace\": ";
+    appendJsonString(out, tracePath.c_str());
+    out += ",\n  \"longestZones\": [";
+
+    for (size_t i = 0; i < zones.size(); ++i) {
+        out += i == 0 ? "\n    {\"name\": " : ",\n    {\"name\": ";
+        appendJsonString(out, zones[i].name);
+        std::snprintf(buffer, sizeof(buffer), ", \"durationMs\": %.3f, \"depth\": %u, \"thread\": %u}",
+                      (zones[i].endNs - zones[i].startNs) / 1e6, zones[i].depth, zones[i].threadId);
+        out += buffer;
+    }
+
+    out += "\n  ],\n  \"frames\": [";
+    bool first = true;
+    for (uint64_t frame = firstFrame; frame <= lastFrame; ++frame) {
+        const FrameRecord* record = findFrame(frame);
+        if (!record) {
+            continue;
+        }
+
+        out += first ? "\n    {" : ",\n    {";
+        first = false;
+        std::snprintf(buffer, sizeof(buffer), "\"frame\": %llu, \"durationMs\": %.3f",
+                      static_cast<unsigned long long>(frame), record->durationNs / 1e6);
+        out += buffer;
+        for (size_t i = 0; i < m_counters.size(); ++i) {
+            out += ", ";
+            appendJsonString(out, m_counters[i].name.c_str());
+            std::snprintf(buffer, sizeof(buffer), ": %llu",
+                          static_cast<unsigned long long>(record->counterDeltas[i]));
+            out += buffer;
+        }
+        out += "}";
+    }
+    out += "\n  ]\n}\n";
+
+    std::ofstream file(summaryPath, std::ios::out | std::ios::trunc);
+    if (!file.is_open()) {
+        LOG_ERROR("Hitch: failed to write dump " + summaryPath, "Hitch");
+        return;
+    }
+    file.write(out.data(), static_cast<std::streamsize>(out.size()));
+    file.close();
+
+    Profiler::getInstance().exportChromeTrace(tracePath, firstFrame, lastFrame);
+
+    LOG_WARN("Hitch: frame {} took {:.2f}ms (budget {:.2f}ms); dump written to {}", "Hitch",
+             hitchFrame, m_pending.hitchDurationNs / 1e6, m_pending.budgetNs / 1e6, summaryPath);
+}
+
+} // namespace VulkanGameEngine
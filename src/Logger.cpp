@@ -1,6 +1,10 @@
 #include "../headers/Logger.h"
 #include <mutex>
 #include <iostream>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
 
 // Include platform-specific headers after our definitions
 #ifdef _WIN32
@@ -33,6 +37,59 @@ const std::string Logger::COLOR_BLUE = "\033[34m";
 const std::string Logger::COLOR_CYAN = "\033[36m";
 const std::string Logger::COLOR_WHITE = "\033[37m";
 
+namespace {
+
+/**
+ * Per-thread handle to the ring buffer registered with the logger.
+ * When the thread exits the ring is marked orphaned so the sink thread can
+ * drain whatever is left and then release it.
+ */
+struct ThreadRingSlot {
+    std::shared_ptr<void> ring;
+    std::atomic<bool>* orphaned = nullptr;
+
+    ~ThreadRingSlot() {
+        if (orphaned) {
+            orphaned->store(true, std::memory_order_release);
+        }
+    }
+};
+
+thread_local ThreadRingSlot t_ringSlot;
+
+size_t roundUpToPowerOfTwo(size_t value) {
+    size_t result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+/**
+ * Formats a system_clock timestamp as HH:MM:SS.mmm without iostreams.
+ * localtime is only called when the second changes.
+ */
+void formatTimestamp(int64_t timestampNs, char (&out)[16], int64_t& cachedSecond, char (&cachedPrefix)[10]) {
+    int64_t seconds = timestampNs / 1000000000;
+    int milliseconds = static_cast<int>((timestampNs / 1000000) % 1000);
+
+    if (seconds != cachedSecond) {
+        std::time_t time = static_cast<std::time_t>(seconds);
+        std::tm localTime{};
+#ifdef _WIN32
+        localtime_s(&localTime, &time);
+#else
+        localtime_r(&time, &localTime);
+#endif
+        std::strftime(cachedPrefix, sizeof(cachedPrefix), "%H:%M:%S", &localTime);
+        cachedSecond = seconds;
+    }
+
+    std::snprintf(out, sizeof(out), "%s.%03d", cachedPrefix, milliseconds);
+}
+
+} // anonymous namespace
+
 Logger& Logger::getInstance() {
     static Logger instance;
     return instance;
@@ -58,18 +115,311 @@ Logger::Logger()
 #endif
 }
 
+Logger::~Logger() {
+    disableBinaryBackend();
+    disableAsync();
+}
+
 void Logger::setLogLevel(Level level) {
-    m_logLevel = level;
+    m_logLevel.store(level, std::memory_order_relaxed);
 }
 
 void Logger::log(Level level, const std::string& message, const std::string& category) {
-    if (level < m_logLevel) {
+    if (!isLevelEnabled(level)) {
         return; // Skip messages below the current log level
     }
     
+    if (m_binaryEnabled.load(std::memory_order_acquire)) {
+        m_binarySink.writeText(static_cast<uint8_t>(level), message, category);
+        if (level < m_consoleEchoLevel.load(std::memory_order_relaxed)) {
+            return;
+        }
+    }
+    
+    writeText(level, message, category);
+}
+
+void Logger::writeText(Level level, const std::string& message, const std::string& category) {
+    if (m_asyncEnabled.load(std::memory_order_acquire)) {
+        enqueue(level, message, category);
+        
+        // A fatal message is usually followed by termination, so make sure it reaches the sink
+        if (level == Level::FATAL) {
+            flush();
+        }
+        return;
+    }
+    
     output(level, message, category);
 }
 
+bool Logger::enableBinaryBackend(const BinaryLogSink::Config& config, Level consoleEchoLevel) {
+    disableBinaryBackend();
+    
+    if (!m_binarySink.open(config)) {
+        output(Level::ERROR, "Failed to open binary log: " + config.basePath, "Logger");
+        return false;
+    }
+    
+    m_consoleEchoLevel.store(consoleEchoLevel, std::memory_order_relaxed);
+    m_binaryEnabled.store(true, std::memory_order_release);
+    return true;
+}
+
+void Logger::disableBinaryBackend() {
+    if (m_binaryEnabled.exchange(false, std::memory_order_acq_rel)) {
+        m_binarySink.close();
+    }
+}
+
+Logger::RecordRing::RecordRing(size_t capacity)
+    : records(roundUpToPowerOfTwo(std::max<size_t>(capacity, 2)))
+    , mask(records.size() - 1) {
+}
+
+bool Logger::enableAsync(const AsyncConfig& config) {
+    disableAsync();
+    
+    m_asyncConfig = config;
+    if (!m_asyncConfig.filePath.empty()) {
+        m_logFile.open(m_asyncConfig.filePath, std::ios::out | std::ios::app | std::ios::binary);
+        if (!m_logFile.is_open()) {
+            output(Level::ERROR, "Failed to open log file: " + m_asyncConfig.filePath, "Logger");
+            return false;
+        }
+    }
+    
+    m_sinkRunning.store(true, std::memory_order_release);
+    m_sinkThread = std::thread(&Logger::sinkThreadMain, this);
+    m_asyncEnabled.store(true, std::memory_order_release);
+    return true;
+}
+
+bool Logger::enableAsync() {
+    return enableAsync(AsyncConfig());
+}
+
+void Logger::disableAsync() {
+    if (!m_asyncEnabled.exchange(false, std::memory_order_acq_rel)) {
+        return;
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(m_sinkMutex);
+        m_sinkRunning.store(false, std::memory_order_release);
+    }
+    m_sinkWakeup.notify_all();
+    
+    if (m_sinkThread.joinable()) {
+        m_sinkThread.join();
+    }
+    
+    if (m_logFile.is_open()) {
+        m_logFile.close();
+    }
+}
+
+void Logger::flush() {
+    if (!m_asyncEnabled.load(std::memory_order_acquire)) {
+        std::cout.flush();
+        return;
+    }
+    
+    std::unique_lock<std::mutex> lock(m_sinkMutex);
+    uint64_t target = ++m_flushRequested;
+    m_sinkWakeup.notify_all();
+    m_flushDone.wait(lock, [this, target] {
+        return m_flushCompleted >= target || !m_sinkRunning.load(std::memory_order_acquire);
+    });
+}
+
+Logger::RecordRing& Logger::getThreadRing() {
+    if (!t_ringSlot.ring) {
+        auto ring = std::make_shared<RecordRing>(m_asyncConfig.ringCapacity);
+        {
+            std::lock_guard<std::mutex> lock(m_ringsMutex);
+            m_rings.push_back(ring);
+        }
+        t_ringSlot.orphaned = &ring->orphaned;
+        t_ringSlot.ring = ring;
+    }
+    return *static_cast<RecordRing*>(t_ringSlot.ring.get());
+}
+
+void Logger::enqueue(Level level, const std::string& message, const std::string& category) {
+    RecordRing& ring = getThreadRing();
+    
+    const size_t recordCount = std::max<size_t>(1,
+        (message.size() + LogRecord::MESSAGE_CAPACITY - 1) / LogRecord::MESSAGE_CAPACITY);
+    const uint64_t head = ring.head.load(std::memory_order_relaxed);
+    
+    // Wait for (or give up on) enough free slots to hold the whole message
+    while (head + recordCount - ring.tail.load(std::memory_order_acquire) > ring.records.size()) {
+        if (m_asyncConfig.overflowPolicy == OverflowPolicy::DROP || recordCount > ring.records.size() ||
+            !m_sinkRunning.load(std::memory_order_acquire)) {
+            m_droppedMessages.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        m_sinkWakeup.notify_one();
+        std::this_thread::yield();
+    }
+    
+    const int64_t timestampNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    const size_t categoryLength = std::min(category.size(), LogRecord::CATEGORY_CAPACITY);
+    
+    size_t offset = 0;
+    for (size_t i = 0; i < recordCount; ++i) {
+        LogRecord& record = ring.records[(head + i) & ring.mask];
+        const size_t chunk = std::min(message.size() - offset, LogRecord::MESSAGE_CAPACITY);
+        
+        record.timestampNs = timestampNs;
+        record.level = level;
+        record.flags = (i + 1 < recordCount) ? LogRecord::FLAG_CONTINUED : 0;
+        record.categoryLength = static_cast<uint8_t>(categoryLength);
+        record.messageLength = static_cast<uint16_t>(chunk);
+        std::memcpy(record.category, category.data(), categoryLength);
+        std::memcpy(record.message, message.data() + offset, chunk);
+        offset += chunk;
+    }
+    
+    // Publish all pieces at once so the sink never sees half a message
+    ring.head.store(head + recordCount, std::memory_order_release);
+    
+    // Errors should appear promptly; everything else waits for the next flush interval
+    if (level >= Level::ERROR) {
+        m_sinkWakeup.notify_one();
+    }
+}
+
+void Logger::sinkThreadMain() {
+    std::vector<LogRecord> batch;
+    std::string stdoutBuffer;
+    std::string stderrBuffer;
+    
+    while (true) {
+        uint64_t flushTarget;
+        bool running;
+        {
+            std::unique_lock<std::mutex> lock(m_sinkMutex);
+            m_sinkWakeup.wait_for(lock, m_asyncConfig.flushInterval, [this] {
+                return m_flushRequested != m_flushCompleted || !m_sinkRunning.load(std::memory_order_acquire);
+            });
+            flushTarget = m_flushRequested;
+            running = m_sinkRunning.load(std::memory_order_acquire);
+        }
+        
+        // Keep draining until empty so a flush covers records that arrived mid-batch
+        while (drainRings(batch, stdoutBuffer, stderrBuffer) > 0) {
+        }
+        
+        {
+            std::lock_guard<std::mutex> lock(m_sinkMutex);
+            m_flushCompleted = flushTarget;
+        }
+        m_flushDone.notify_all();
+        
+        if (!running) {
+            break;
+        }
+    }
+}
+
+size_t Logger::drainRings(std::vector<LogRecord>& batch, std::string& stdoutBuffer, std::string& stderrBuffer) {
+    batch.clear();
+    
+    {
+        std::lock_guard<std::mutex> lock(m_ringsMutex);
+        for (auto it = m_rings.begin(); it != m_rings.end();) {
+            RecordRing& ring = **it;
+            // Read orphaned before head so a ring is only released once it is truly empty
+            const bool orphaned = ring.orphaned.load(std::memory_order_acquire);
+            const uint64_t head = ring.head.load(std::memory_order_acquire);
+            uint64_t tail = ring.tail.load(std::memory_order_relaxed);
+            
+            for (; tail != head; ++tail) {
+                batch.push_back(ring.records[tail & ring.mask]);
+            }
+            ring.tail.store(tail, std::memory_order_release);
+            
+            if (orphaned) {
+                it = m_rings.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+    
+    if (batch.empty()) {
+        return 0;
+    }
+    
+    // Interleave messages from different threads by time, keeping split messages together
+    std::vector<size_t> messageStarts;
+    for (size_t i = 0; i < batch.size(); ++i) {
+        if (i == 0 || !(batch[i - 1].flags & LogRecord::FLAG_CONTINUED)) {
+            messageStarts.push_back(i);
+        }
+    }
+    std::stable_sort(messageStarts.begin(), messageStarts.end(), [&batch](size_t a, size_t b) {
+        return batch[a].timestampNs < batch[b].timestampNs;
+    });
+    
+    stdoutBuffer.clear();
+    stderrBuffer.clear();
+    std::string fileBuffer;
+    std::string message;
+    
+    int64_t cachedSecond = -1;
+    char cachedPrefix[10] = {};
+    char timestamp[16] = {};
+    
+    for (size_t start : messageStarts) {
+        const LogRecord& first = batch[start];
+        
+        message.clear();
+        for (size_t i = start; i < batch.size(); ++i) {
+            message.append(batch[i].message, batch[i].messageLength);
+            if (!(batch[i].flags & LogRecord::FLAG_CONTINUED)) {
+                break;
+            }
+        }
+        
+        const char* timestampText = nullptr;
+        if (m_timestampEnabled) {
+            formatTimestamp(first.timestampNs, timestamp, cachedSecond, cachedPrefix);
+            timestampText = timestamp;
+        }
+        
+        if (m_asyncConfig.consoleOutput) {
+            std::string& target = (first.level >= Level::ERROR) ? stderrBuffer : stdoutBuffer;
+            formatLine(target, first.level, m_colorEnabled, timestampText,
+                       first.category, first.categoryLength, message.data(), message.size());
+        }
+        
+        if (m_logFile.is_open()) {
+            // Never write escape codes into the log file
+            formatLine(fileBuffer, first.level, false, timestampText,
+                       first.category, first.categoryLength, message.data(), message.size());
+        }
+    }
+    
+    if (!stdoutBuffer.empty()) {
+        std::fwrite(stdoutBuffer.data(), 1, stdoutBuffer.size(), stdout);
+        std::fflush(stdout);
+    }
+    if (!stderrBuffer.empty()) {
+        std::fwrite(stderrBuffer.data(), 1, stderrBuffer.size(), stderr);
+        std::fflush(stderr);
+    }
+    if (!fileBuffer.empty()) {
+        m_logFile.write(fileBuffer.data(), static_cast<std::streamsize>(fileBuffer.size()));
+        m_logFile.flush();
+    }
+    
+    return batch.size();
+}
+
 void Logger::trace(const std::string& message, const std::string& category) {
     log(Level::TRACE, message, category);
 }
@@ -142,51 +492,88 @@ std::string Logger::getCurrentTimestamp() const {
     return ss.str();
 }
 
-void Logger::output(Level level, const std::string& message, const std::string& category) const {
-    static std::mutex logMutex; // Thread-safe logging
-    std::lock_guard<std::mutex> lock(logMutex);
-    
-    std::ostream& stream = (level >= Level::ERROR) ? std::cerr : std::cout;
-    
-    std::string levelColor = getLevelColor(level);
+const char* Logger::getLevelColorCode(Level level) const {
+    switch (level) {
+        case Level::TRACE: return "\033[2m";
+        case Level::DEBUG: return "\033[36m";
+        case Level::INFO:  return "\033[32m";
+        case Level::WARN:  return "\033[33m";
+        case Level::ERROR: return "\033[31m";
+        case Level::FATAL: return "\033[1m\033[31m";
+        default:           return "\033[0m";
+    }
+}
+
+void Logger::formatLine(std::string& out, Level level, bool useColor, const char* timestamp,
+                        const char* category, size_t categoryLength,
+                        const char* message, size_t messageLength) const {
+    const char* levelColor = useColor ? getLevelColorCode(level) : "";
     
     // Start with color if enabled
-    if (m_colorEnabled) {
-        stream << levelColor;
-    }
+    out += levelColor;
     
     // Add timestamp if enabled
-    if (m_timestampEnabled) {
-        if (m_colorEnabled) {
-            stream << COLOR_DIM << "[" << getCurrentTimestamp() << "] " << COLOR_RESET;
-            stream << levelColor; // Restore level color after timestamp
+    if (timestamp) {
+        if (useColor) {
+            out += COLOR_DIM;
+            out += '[';
+            out += timestamp;
+            out += "] ";
+            out += COLOR_RESET;
+            out += levelColor; // Restore level color after timestamp
         } else {
-            stream << "[" << getCurrentTimestamp() << "] ";
+            out += '[';
+            out += timestamp;
+            out += "] ";
         }
     }
     
     // Add log level
-    stream << "[" << getLevelString(level) << "]";
+    out += '[';
+    out += getLevelString(level);
+    out += ']';
     
     // Add category if provided
-    if (!category.empty()) {
-        if (m_colorEnabled) {
-            stream << COLOR_RESET << COLOR_DIM << "[" << category << "]" << COLOR_RESET;
-            stream << levelColor; // Restore level color after category
-        } else {
-            stream << "[" << category << "]";
+    if (categoryLength > 0) {
+        if (useColor) {
+            out += COLOR_RESET;
+            out += COLOR_DIM;
+        }
+        out += '[';
+        out.append(category, categoryLength);
+        out += ']';
+        if (useColor) {
+            out += COLOR_RESET;
+            out += levelColor; // Restore level color after category
         }
     }
     
     // Add the message
-    stream << " " << message;
+    out += ' ';
+    out.append(message, messageLength);
     
     // Reset color if enabled
-    if (m_colorEnabled) {
-        stream << COLOR_RESET;
+    if (useColor) {
+        out += COLOR_RESET;
     }
     
-    stream << std::endl;
+    out += '\n';
+}
+
+void Logger::output(Level level, const std::string& message, const std::string& category) const {
+    static std::mutex logMutex; // Thread-safe logging
+    
+    // Format outside the lock; only the write itself is serialized
+    thread_local std::string line;
+    line.clear();
+    std::string timestamp = m_timestampEnabled ? getCurrentTimestamp() : std::string();
+    formatLine(line, level, m_colorEnabled, m_timestampEnabled ? timestamp.c_str() : nullptr,
+               category.data(), category.size(), message.data(), message.size());
+    
+    std::lock_guard<std::mutex> lock(logMutex);
+    
+    std::ostream& stream = (level >= Level::ERROR) ? std::cerr : std::cout;
+    stream.write(line.data(), static_cast<std::streamsize>(line.size()));
     
     // Flush immediately for error and fatal messages
     if (level >= Level::ERROR) {
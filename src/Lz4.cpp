@@ -0,0 +1,210 @@
+#include "../headers/Lz4.h"
+#include <algorithm>
+#include <cstring>
+
+namespace VulkanGameEngine {
+namespace Lz4 {
+
+namespace {
+
+constexpr size_t MIN_MATCH = 4;
+constexpr size_t LAST_LITERALS = 5;     // The last 5 bytes are always literals
+constexpr size_t MATCH_FIND_LIMIT = 12; // No match may start in the last 12 bytes
+constexpr size_t MAX_OFFSET = 65535;
+constexpr uint32_t HASH_BITS = 12;
+
+uint32_t read32(const uint8_t* p) {
+    uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+uint32_t hashSequence(uint32_t sequence) {
+    return (sequence * 2654435761u) >> (32 - HASH_BITS);
+}
+
+/**
+ * Writes the 255-byte continuation of a length field that reached 15
+ */
+bool writeLength(uint8_t*& op, const uint8_t* end, size_t length) {
+    while (length >= 255) {
+        if (op >= end) {
+            return false;
+        }
+        *op++ = 255;
+        length -= 255;
+    }
+    if (op >= end) {
+        return false;
+    }
+    *op++ = static_cast<uint8_t>(length);
+    return true;
+}
+
+/**
+ * Reads the continuation of a length field that reached 15
+ */
+bool readLength(const uint8_t*& ip, const uint8_t* end, size_t& length) {
+    uint8_t byte;
+    do {
+        if (ip >= end) {
+            return false;
+        }
+        byte = *ip++;
+        length += byte;
+    } while (byte == 255);
+    return true;
+}
+
+/**
+ * Writes one sequence: literals [anchor, anchor + literals), then (unless
+ * this is the last sequence) a match of matchLength bytes at offset
+ */
+bool writeSequence(uint8_t*& op, const uint8_t* end, const uint8_t* anchor, size_t literals,
+                   size_t offset, size_t matchLength, bool last) {
+    if (op >= end) {
+        return false;
+    }
+    uint8_t* token = op++;
+    const size_t matchCode = last ? 0 : matchLength - MIN_MATCH;
+    *token = static_cast<uint8_t>((literals >= 15 ? 15 : literals) << 4 | (matchCode >= 15 ? 15 : matchCode));
+
+    if (literals >= 15 && !writeLength(op, end, literals - 15)) {
+        return false;
+    }
+    if (static_cast<size_t>(end - op) < literals) {
+        return false;
+    }
+    std::memcpy(op, anchor, literals);
+    op += literals;
+    if (last) {
+        return true;
+    }
+
+    if (end - op < 2) {
+        return false;
+    }
+    *op++ = static_cast<uint8_t>(offset & 0xFF);
+    *op++ = static_cast<uint8_t>(offset >> 8);
+    return matchCode < 15 || writeLength(op, end, matchCode - 15);
+}
+
+} // anonymous namespace
+
+size_t compressBound(size_t sourceSize) {
+    return sourceSize + sourceSize / 255 + 16;
+}
+
+size_t compress(const uint8_t* source, size_t sourceSize, uint8_t* destination, size_t capacity) {
+    uint8_t* op = destination;
+    const uint8_t* const outEnd = destination + capacity;
+    const uint8_t* anchor = source;
+
+    if (sourceSize > MATCH_FIND_LIMIT) {
+        // Positions (relative to source) of the last sequence with each hash; UINT32_MAX = none
+        uint32_t table[1u << HASH_BITS];
+        std::memset(table, 0xFF, sizeof(table));
+
+        const uint8_t* ip = source;
+        const uint8_t* const matchLimit = source + sourceSize - MATCH_FIND_LIMIT;
+        const uint8_t* const extendLimit = source + sourceSize - LAST_LITERALS;
+        uint32_t misses = 0;
+        while (ip < matchLimit) {
+            const uint32_t sequence = read32(ip);
+            const uint32_t hash = hashSequence(sequence);
+            const uint32_t candidate = table[hash];
+            table[hash] = static_cast<uint32_t>(ip - source);
+
+            if (candidate == UINT32_MAX || static_cast<size_t>(ip - source) - candidate > MAX_OFFSET ||
+                read32(source + candidate) != sequence) {
+                // Step further the longer nothing matches, so incompressible data stays fast
+                ip += 1 + (misses++ >> 6);
+                continue;
+            }
+            misses = 0;
+
+            const uint8_t* match = source + candidate;
+            size_t length = MIN_MATCH;
+            while (ip + length < extendLimit && match[length] == ip[length]) {
+                length++;
+            }
+            if (!writeSequence(op, outEnd, anchor, static_cast<size_t>(ip - anchor),
+                               static_cast<size_t>(ip - match), length, false)) {
+                return 0;
+            }
+            ip += length;
+            anchor = ip;
+        }
+    }
+
+    const size_t literals = static_cast<size_t>(source + sourceSize - anchor);
+    if (!writeSequence(op, outEnd, anchor, literals, 0, 0, true)) {
+        return 0;
+    }
+    return static_cast<size_t>(op - destination);
+}
+
+bool decompress(const uint8_t* source, size_t sourceSize, uint8_t* destination, size_t destinationSize) {
+    const uint8_t* ip = source;
+    const uint8_t* const inEnd = source + sourceSize;
+    uint8_t* op = destination;
+    uint8_t* const outEnd = destination + destinationSize;
+
+    for (;;) {
+        if (ip >= inEnd) {
+            return false;
+        }
+        const uint8_t token = *ip++;
+
+        size_t literals = token >> 4;
+        if (literals == 15 && !readLength(ip, inEnd, literals)) {
+            return false;
+        }
+        if (static_cast<size_t>(inEnd - ip) < literals || static_cast<size_t>(outEnd - op) < literals) {
+            return false;
+        }
+        std::memcpy(op, ip, literals);
+        ip += literals;
+        op += literals;
+
+        if (ip == inEnd) {
+            return op == outEnd;    // The last sequence has no match
+        }
+
+        if (inEnd - ip < 2) {
+            return false;
+        }
+        const size_t offset = static_cast<size_t>(ip[0]) | static_cast<size_t>(ip[1]) << 8;
+        ip += 2;
+        if (offset == 0 || offset > static_cast<size_t>(op - destination)) {
+            return false;
+        }
+
+        size_t length = token & 15;
+        if (length == 15 && !readLength(ip, inEnd, length)) {
+            return false;
+        }
+        length += MIN_MATCH;
+        if (static_cast<size_t>(outEnd - op) < length) {
+            return false;
+        }
+
+        const uint8_t* match = op - offset;
+        if (offset >= length) {
+            std::memcpy(op, match, length);
+            op += length;
+        } else {
+            // Overlapping match (a repeating pattern, e.g. a run of zeros):
+            // [match, op) is whole periods, so copy it forward doubling each time
+            while (length > 0) {
+                const size_t chunk = std::min(static_cast<size_t>(op - match), length);
+                std::memcpy(op, match, chunk);
+                op += chunk;
+                length -= chunk;
+            }
+        }
+    }
+}
+
+} // namespace Lz4
+} // namespace VulkanGameEngine
@@ -0,0 +1,276 @@
+#include "../headers/MeshAsset.h"
+#include "../headers/AssetArchive.h"
+#include "../headers/GeometryCodec.h"
+#include "../headers/Logger.h"
+#include "../headers/Profiler.h"
+#include <cstring>
+#include <fstream>
+
+namespace VulkanGameEngine {
+
+constexpr char MeshAsset::MAGIC[8];
+
+namespace {
+
+template <typename T>
+void putValue(std::vector<char>& data, const T& value) {
+    const char* bytes = reinterpret_cast<const char*>(&value);
+    data.insert(data.end(), bytes, bytes + sizeof(T));
+}
+
+template <typename T>
+void putArray(std::vector<char>& data, const std::vector<T>& values) {
+    const char* bytes = reinterpret_cast<const char*>(values.data());
+    data.insert(data.end(), bytes, bytes + values.size() * sizeof(T));
+}
+
+/**
+ * Bounds-checked reads; the first failure sticks, so callers check once at the end
+ */
+class Reader {
+public:
+    explicit Reader(const std::vector<char>& data) : m_data(data), m_offset(0), m_failed(false) {}
+
+    template <typename T>
+    T get() {
+        T value{};
+        if (canRead(sizeof(T))) {
+            std::memcpy(&value, m_data.data() + m_offset, sizeof(T));
+            m_offset += sizeof(T);
+        }
+        return value;
+    }
+
+    template <typename T>
+    void getArray(std::vector<T>& values, uint32_t count) {
+        if (!canRead(static_cast<uint64_t>(count) * sizeof(T))) {
+            values.clear();
+            return;
+        }
+        values.resize(count);
+        std::memcpy(values.data(), m_data.data() + m_offset, count * sizeof(T));
+        m_offset += count * sizeof(T);
+    }
+
+    /**
+     * Returns size bytes in place (nullptr on failure)
+     */
+    const uint8_t* getBytes(uint32_t size) {
+        if (!canRead(size)) {
+            return nullptr;
+        }
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(m_data.data()) + m_offset;
+        m_offset += size;
+        return bytes;
+    }
+
+    bool failed() const { return m_failed; }
+    bool atEnd() const { return m_offset == m_data.size(); }
+
+private:
+    const std::vector<char>& m_data;
+    size_t m_offset;
+    bool m_failed;
+
+    bool canRead(uint64_t size) {
+        if (m_failed || size > m_data.size() - m_offset) {
+            m_failed = true;
+            return false;
+        }
+        return true;
+    }
+};
+
+} // anonymous namespace
+
+MeshAsset MeshAsset::cook(const ObjLoader::OBJData& objData, uint64_t sourceHash, const CookOptions& options) {
+    PROFILE_ZONE("MeshAsset::cook");
+    MeshAsset asset;
+    asset.sourceHash = sourceHash;
+
+    std::vector<uint32_t> baseIndices;
+    ObjLoader::convertOBJToVertices(objData, asset.vertices, baseIndices);
+    MeshProcessing::optimizeVertexCache(baseIndices, asset.vertices.size());
+    MeshProcessing::optimizeVertexFetch(asset.vertices, baseIndices);
+
+    asset.lods.push_back({0, static_cast<uint32_t>(baseIndices.size()), 0.0f, 0});
+    asset.indices = baseIndices;
+
+    // Each LOD simplifies LOD 0 (not the previous LOD) so errors do not accumulate
+    size_t previousTriangles = baseIndices.size() / 3;
+    while (asset.lods.size() < options.maxLods) {
+        const size_t target = static_cast<size_t>(static_cast<float>(previousTriangles) * options.lodReduction);
+        if (target < options.minLodTriangles) {
+            break;
+        }
+        float error = 0.0f;
+        std::vector<uint32_t> lodIndices = MeshProcessing::simplifyClusters(asset.vertices, baseIndices, target, error);
+        const size_t triangles = lodIndices.size() / 3;
+        if (triangles < options.minLodTriangles || triangles >= previousTriangles) {
+            break;
+        }
+        MeshProcessing::optimizeVertexCache(lodIndices, asset.vertices.size());
+        asset.lods.push_back({static_cast<uint32_t>(asset.indices.size()), static_cast<uint32_t>(lodIndices.size()),
+                              error, 0});
+        asset.indices.insert(asset.indices.end(), lodIndices.begin(), lodIndices.end());
+        previousTriangles = triangles;
+    }
+
+    asset.meshlets = MeshProcessing::buildMeshlets(asset.vertices, baseIndices, options.maxMeshletVertices,
+                                                   options.maxMeshletTriangles);
+
+    if (!asset.vertices.empty()) {
+        asset.boundsMin = asset.boundsMax = asset.vertices[0].position;
+        for (const Vertex& vertex : asset.vertices) {
+            asset.boundsMin = glm::min(asset.boundsMin, vertex.position);
+            asset.boundsMax = glm::max(asset.boundsMax, vertex.position);
+        }
+    }
+    return asset;
+}
+
+void MeshAsset::serialize(std::vector<char>& data) const {
+    std::vector<uint8_t> vertexStream;
+    std::vector<uint8_t> indexStream;
+    GeometryCodec::encodeVertices(vertices.data(), vertices.size(), sizeof(Vertex), vertexStream);
+    GeometryCodec::encodeIndices(indices.data(), indices.size(), indexStream);
+
+    data.insert(data.end(), MAGIC, MAGIC + sizeof(MAGIC));
+    putValue(data, VERSION);
+    putValue(data, sourceHash);
+    putValue(data, static_cast<uint32_t>(vertices.size()));
+    putValue(data, static_cast<uint32_t>(indices.size()));
+    putValue(data, static_cast<uint32_t>(lods.size()));
+    putValue(data, static_cast<uint32_t>(meshlets.meshlets.size()));
+    putValue(data, static_cast<uint32_t>(meshlets.vertices.size()));
+    putValue(data, static_cast<uint32_t>(meshlets.triangles.size()));
+    putValue(data, static_cast<uint32_t>(vertexStream.size()));
+    putValue(data, static_cast<uint32_t>(indexStream.size()));
+    putValue(data, boundsMin);
+    putValue(data, boundsMax);
+    putArray(data, vertexStream);
+    putArray(data, indexStream);
+    putArray(data, lods);
+    putArray(data, meshlets.meshlets);
+    putArray(data, meshlets.vertices);
+    putArray(data, meshlets.triangles);
+}
+
+bool MeshAsset::deserialize(const std::vector<char>& data, MeshAsset& asset, std::string& error) {
+    Reader reader(data);
+    for (char expected : MAGIC) {
+        if (reader.get<char>() != expected) {
+            error = "not a cooked mesh";
+            return false;
+        }
+    }
+    const uint32_t version = reader.get<uint32_t>();
+    if (version != VERSION) {
+        error = "unsupported cooked mesh version " + std::to_string(version);
+        return false;
+    }
+
+    asset.sourceHash = reader.get<uint64_t>();
+    const uint32_t vertexCount = reader.get<uint32_t>();
+    const uint32_t indexCount = reader.get<uint32_t>();
+    const uint32_t lodCount = reader.get<uint32_t>();
+    const uint32_t meshletCount = reader.get<uint32_t>();
+    const uint32_t meshletVertexCount = reader.get<uint32_t>();
+    const uint32_t meshletTriangleBytes = reader.get<uint32_t>();
+    const uint32_t vertexStreamSize = reader.get<uint32_t>();
+    const uint32_t indexStreamSize = reader.get<uint32_t>();
+    asset.boundsMin = reader.get<glm::vec3>();
+    asset.boundsMax = reader.get<glm::vec3>();
+    const uint8_t* vertexStream = reader.getBytes(vertexStreamSize);
+    const uint8_t* indexStream = reader.getBytes(indexStreamSize);
+    reader.getArray(asset.lods, lodCount);
+    reader.getArray(asset.meshlets.meshlets, meshletCount);
+    reader.getArray(asset.meshlets.vertices, meshletVertexCount);
+    reader.getArray(asset.meshlets.triangles, meshletTriangleBytes);
+    if (reader.failed() || !reader.atEnd()) {
+        error = "truncated or oversized cooked mesh";
+        return false;
+    }
+
+    asset.vertices.resize(vertexCount);
+    asset.indices.resize(indexCount);
+    if (!GeometryCodec::decodeVertices(asset.vertices.data(), vertexCount, sizeof(Vertex), vertexStream, vertexStreamSize) ||
+        !GeometryCodec::decodeIndices(asset.indices.data(), indexCount, indexStream, indexStreamSize)) {
+        error = "corrupt vertex or index stream";
+        return false;
+    }
+
+    // Everything the renderer indexes with must stay in range
+    for (uint32_t index : asset.indices) {
+        if (index >= vertexCount) {
+            error = "index out of range";
+            return false;
+        }
+    }
+    if (asset.lods.empty()) {
+        error = "no levels of detail";
+        return false;
+    }
+    for (const Lod& lod : asset.lods) {
+        if (lod.indexCount % 3 != 0 || lod.firstIndex > indexCount || lod.indexCount > indexCount - lod.firstIndex) {
+            error = "LOD range out of bounds";
+            return false;
+        }
+    }
+    for (uint32_t vertex : asset.meshlets.vertices) {
+        if (vertex >= vertexCount) {
+            error = "meshlet vertex out of range";
+            return false;
+        }
+    }
+    for (const MeshProcessing::Meshlet& meshlet : asset.meshlets.meshlets) {
+        if (meshlet.vertexOffset > meshletVertexCount || meshlet.vertexCount > meshletVertexCount - meshlet.vertexOffset ||
+            meshlet.triangleOffset > meshletTriangleBytes ||
+            static_cast<uint64_t>(meshlet.triangleCount) * 3 > meshletTriangleBytes - meshlet.triangleOffset) {
+            error = "meshlet range out of bounds";
+            return false;
+        }
+        for (uint32_t i = 0; i < meshlet.triangleCount * 3; ++i) {
+            if (asset.meshlets.triangles[meshlet.triangleOffset + i] >= meshlet.vertexCount) {
+                error = "meshlet triangle out of range";
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool MeshAsset::save(const std::string& path) const {
+    std::vector<char> data;
+    serialize(data);
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(data.data(), static_cast<std::streamsize>(data.size()));
+    if (!file) {
+        LOG_ERROR("Cannot write cooked mesh " + path, "MeshAsset");
+        return false;
+    }
+    return true;
+}
+
+bool MeshAsset::load(const std::string& path, MeshAsset& asset, std::string& error) {
+    PROFILE_ZONE("MeshAsset::load");
+    std::vector<char> data;
+    if (!AssetFileSystem::getInstance().readFile(path, data)) {
+        error = "Cannot open cooked mesh " + path;
+        return false;
+    }
+    if (!deserialize(data, asset, error)) {
+        error = path + ": " + error;
+        return false;
+    }
+    return true;
+}
+
+std::string MeshAsset::getCookedPath(const std::string& sourcePath) {
+    const size_t slash = sourcePath.find_last_of("/\\");
+    const size_t dot = sourcePath.find_last_of('.');
+    const bool hasExtension = dot != std::string::npos && (slash == std::string::npos || dot > slash);
+    return (hasExtension ? sourcePath.substr(0, dot) : sourcePath) + EXTENSION;
+}
+
+} // namespace VulkanGameEngine
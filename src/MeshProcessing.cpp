@@ -0,0 +1,572 @@
+#include "../headers/MeshProcessing.h"
+#include "../headers/ThreadPool.h"
+#include "../headers/Logger.h"
+#include "../headers/Profiler.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <unordered_map>
+
+namespace VulkanGameEngine {
+namespace MeshProcessing {
+
+namespace {
+
+/**
+ * The corners (positions in the index list) using each vertex, in ascending
+ * order: corners[offsets[v]] up to corners[offsets[v + 1]]
+ */
+struct VertexCorners {
+    std::vector<uint32_t> offsets;
+    std::vector<uint32_t> corners;
+};
+
+VertexCorners buildVertexCorners(size_t vertexCount, const std::vector<uint32_t>& indices,
+                                 ThreadPool& pool, size_t grainSize) {
+    std::vector<std::atomic<uint32_t>> counts(vertexCount);    // Value-initialized to zero
+    pool.parallelFor(indices.size(), grainSize * 3, [&](size_t begin, size_t end) {
+        for (size_t corner = begin; corner < end; ++corner) {
+            if (indices[corner] >= vertexCount) {
+                throw std::runtime_error("Mesh index " + std::to_string(indices[corner]) + " is out of range");
+            }
+            counts[indices[corner]].fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+
+    // Prefix sum; the counters become each vertex's write cursor
+    VertexCorners table;
+    table.offsets.resize(vertexCount + 1);
+    uint32_t total = 0;
+    for (size_t vertex = 0; vertex < vertexCount; ++vertex) {
+        table.offsets[vertex] = total;
+        total += counts[vertex].load(std::memory_order_relaxed);
+        counts[vertex].store(table.offsets[vertex], std::memory_order_relaxed);
+    }
+    table.offsets[vertexCount] = total;
+
+    table.corners.resize(total);
+    pool.parallelFor(indices.size(), grainSize * 3, [&](size_t begin, size_t end) {
+        for (size_t corner = begin; corner < end; ++corner) {
+            const uint32_t slot = counts[indices[corner]].fetch_add(1, std::memory_order_relaxed);
+            table.corners[slot] = static_cast<uint32_t>(corner);
+        }
+    });
+
+    // The scatter order depends on scheduling; sorting fixes the order sums run in
+    pool.parallelFor(vertexCount, grainSize, [&](size_t begin, size_t end) {
+        for (size_t vertex = begin; vertex < end; ++vertex) {
+            std::sort(table.corners.begin() + table.offsets[vertex], table.corners.begin() + table.offsets[vertex + 1]);
+        }
+    });
+    return table;
+}
+
+/**
+ * Interior angle of a triangle at corner 0 (edges to corners 1 and 2), 0 if degenerate
+ */
+float cornerAngle(const glm::vec3& corner, const glm::vec3& next, const glm::vec3& previous) {
+    const glm::vec3 a = next - corner;
+    const glm::vec3 b = previous - corner;
+    const float lengths = glm::length(a) * glm::length(b);
+    if (lengths <= 0.0f) {
+        return 0.0f;
+    }
+    return std::acos(glm::clamp(glm::dot(a, b) / lengths, -1.0f, 1.0f));
+}
+
+/**
+ * Any unit vector perpendicular to n (the X axis if n is zero)
+ */
+glm::vec3 anyPerpendicular(const glm::vec3& n) {
+    const glm::vec3 axis = std::fabs(n.x) < 0.9f ? glm::vec3(1.0f, 0.0f, 0.0f) : glm::vec3(0.0f, 1.0f, 0.0f);
+    const glm::vec3 perpendicular = glm::cross(n, axis);
+    const float length = glm::length(perpendicular);
+    return length > 0.0f ? perpendicular / length : glm::vec3(1.0f, 0.0f, 0.0f);
+}
+
+constexpr size_t VERTEX_CACHE_SIZE = 32;
+
+/**
+ * Forsyth's vertex score: high for vertices just used (the last triangle's
+ * three equally), decaying with the cache position, plus a bonus for
+ * vertices with few triangles left so they get finished off
+ */
+float vertexCacheScore(int cachePosition, uint32_t remainingTriangles) {
+    if (remainingTriangles == 0) {
+        return -1.0f;
+    }
+    float score = 0.0f;
+    if (cachePosition >= 0) {
+        score = cachePosition < 3 ? 0.75f
+                                  : std::pow(1.0f - static_cast<float>(cachePosition - 3) /
+                                                        static_cast<float>(VERTEX_CACHE_SIZE - 3), 1.5f);
+    }
+    return score + 2.0f / std::sqrt(static_cast<float>(remainingTriangles));
+}
+
+/**
+ * Snaps every vertex to a grid of resolution^3 cells over the bounds, keeps
+ * the lowest-numbered vertex of each cell and collects the triangles that
+ * still have three distinct corners, each once
+ */
+void clusterTriangles(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices,
+                      const glm::vec3& boundsMin, const glm::vec3& extent, uint32_t resolution,
+                      std::vector<uint32_t>& output) {
+    std::unordered_map<uint32_t, uint32_t> representatives;
+    std::vector<uint32_t> cellVertex(vertices.size());
+    for (size_t vertex = 0; vertex < vertices.size(); ++vertex) {
+        uint32_t cell = 0;
+        for (int axis = 0; axis < 3; ++axis) {
+            const float t = extent[axis] > 0.0f ? (vertices[vertex].position[axis] - boundsMin[axis]) / extent[axis] : 0.0f;
+            const uint32_t coordinate = std::min(static_cast<uint32_t>(std::max(t, 0.0f) * static_cast<float>(resolution)),
+                                                 resolution - 1);
+            cell = cell * resolution + coordinate;
+        }
+        cellVertex[vertex] = representatives.emplace(cell, static_cast<uint32_t>(vertex)).first->second;
+    }
+
+    // Rotated to start at the smallest index (keeps the winding) so duplicates sort together
+    std::vector<std::array<uint32_t, 3>> triangles;
+    triangles.reserve(indices.size() / 3);
+    for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+        std::array<uint32_t, 3> triangle = {cellVertex[indices[i]], cellVertex[indices[i + 1]], cellVertex[indices[i + 2]]};
+        if (triangle[0] == triangle[1] || triangle[1] == triangle[2] || triangle[0] == triangle[2]) {
+            continue;
+        }
+        std::rotate(triangle.begin(), std::min_element(triangle.begin(), triangle.end()), triangle.end());
+        triangles.push_back(triangle);
+    }
+    std::sort(triangles.begin(), triangles.end());
+    triangles.erase(std::unique(triangles.begin(), triangles.end()), triangles.end());
+
+    output.clear();
+    output.reserve(triangles.size() * 3);
+    for (const auto& triangle : triangles) {
+        output.insert(output.end(), triangle.begin(), triangle.end());
+    }
+}
+
+} // anonymous namespace
+
+void generateNormals(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices,
+                     const NormalOptions& options, ThreadPool& pool) {
+    PROFILE_ZONE("MeshProcessing::generateNormals");
+    const size_t vertexCount = vertices.size();
+    const size_t triangleCount = indices.size() / 3;
+    const size_t grainSize = std::max<size_t>(options.grainSize, 1);
+
+    // Face normals, and the weight each corner gives its face: the cross
+    // product's length (twice the area) times the corner angle
+    std::vector<glm::vec3> faceNormals(triangleCount);
+    std::vector<float> cornerWeights(triangleCount * 3);
+    pool.parallelFor(triangleCount, grainSize, [&](size_t begin, size_t end) {
+        for (size_t triangle = begin; triangle < end; ++triangle) {
+            const uint32_t* corner = &indices[triangle * 3];
+            if (corner[0] >= vertexCount || corner[1] >= vertexCount || corner[2] >= vertexCount) {
+                throw std::runtime_error("Mesh triangle " + std::to_string(triangle) + " has an index out of range");
+            }
+            const glm::vec3& p0 = vertices[corner[0]].position;
+            const glm::vec3& p1 = vertices[corner[1]].position;
+            const glm::vec3& p2 = vertices[corner[2]].position;
+            const glm::vec3 cross = glm::cross(p1 - p0, p2 - p0);
+            const float area = glm::length(cross);
+            faceNormals[triangle] = area > 0.0f ? cross / area : glm::vec3(0.0f);
+            cornerWeights[triangle * 3 + 0] = area * cornerAngle(p0, p1, p2);
+            cornerWeights[triangle * 3 + 1] = area * cornerAngle(p1, p2, p0);
+            cornerWeights[triangle * 3 + 2] = area * cornerAngle(p2, p0, p1);
+        }
+    });
+
+    const VertexCorners table = buildVertexCorners(vertexCount, indices, pool, grainSize);
+
+    // Per corner: the weighted sum over the vertex's faces within the crease
+    // angle of the corner's face. Corners that end up with the same normal
+    // form one smoothing group and share a vertex.
+    const float creaseCosine = std::cos(glm::radians(options.creaseAngleDegrees));
+    std::vector<glm::vec3> cornerNormals(triangleCount * 3);
+    std::vector<uint32_t> cornerGroups(triangleCount * 3);
+    std::vector<uint32_t> groupCounts(vertexCount);
+    pool.parallelFor(vertexCount, grainSize, [&](size_t begin, size_t end) {
+        for (size_t vertex = begin; vertex < end; ++vertex) {
+            const uint32_t first = table.offsets[vertex];
+            const uint32_t last = table.offsets[vertex + 1];
+            uint32_t groups = 0;
+            for (uint32_t i = first; i < last; ++i) {
+                const uint32_t corner = table.corners[i];
+                const glm::vec3& faceNormal = faceNormals[corner / 3];
+                const bool degenerate = faceNormal == glm::vec3(0.0f);  // Smoothed with every face
+
+                glm::vec3 sum(0.0f);
+                for (uint32_t j = first; j < last; ++j) {
+                    const uint32_t other = table.corners[j];
+                    if (degenerate || glm::dot(faceNormal, faceNormals[other / 3]) >= creaseCosine) {
+                        sum += faceNormals[other / 3] * cornerWeights[other];
+                    }
+                }
+                const float length = glm::length(sum);
+                cornerNormals[corner] = length > 0.0f ? sum / length : glm::vec3(0.0f, 1.0f, 0.0f);
+
+                uint32_t group = groups;
+                for (uint32_t j = first; j < i; ++j) {
+                    if (cornerNormals[table.corners[j]] == cornerNormals[corner]) {
+                        group = cornerGroups[table.corners[j]];
+                        break;
+                    }
+                }
+                if (group == groups) {
+                    groups++;
+                }
+                cornerGroups[corner] = group;
+            }
+            groupCounts[vertex] = groups;
+        }
+    });
+
+    // Group 0 keeps the vertex; every further group gets an appended copy
+    std::vector<uint32_t> splitOffsets(vertexCount);
+    uint32_t splits = 0;
+    for (size_t vertex = 0; vertex < vertexCount; ++vertex) {
+        splitOffsets[vertex] = static_cast<uint32_t>(vertexCount) + splits;
+        splits += groupCounts[vertex] > 1 ? groupCounts[vertex] - 1 : 0;
+    }
+    vertices.resize(vertexCount + splits);
+
+    pool.parallelFor(vertexCount, grainSize, [&](size_t begin, size_t end) {
+        for (size_t vertex = begin; vertex < end; ++vertex) {
+            const Vertex source = vertices[vertex];
+            for (uint32_t i = table.offsets[vertex]; i < table.offsets[vertex + 1]; ++i) {
+                const uint32_t corner = table.corners[i];
+                const uint32_t group = cornerGroups[corner];
+                const uint32_t target = group == 0 ? static_cast<uint32_t>(vertex) : splitOffsets[vertex] + group - 1;
+                if (group != 0) {
+                    vertices[target] = source;
+                }
+                vertices[target].normal = cornerNormals[corner];
+                indices[corner] = target;
+            }
+        }
+    });
+
+    LOG_DEBUG("Generated normals for {} vertices ({} added along creases)", "MeshProcessing",
+              vertices.size(), splits);
+}
+
+void generateNormals(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices) {
+    generateNormals(vertices, indices, NormalOptions(), ThreadPool::getInstance());
+}
+
+void generateTangents(std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices,
+                      ThreadPool& pool, size_t grainSize) {
+    PROFILE_ZONE("MeshProcessing::generateTangents");
+    const size_t vertexCount = vertices.size();
+    const size_t triangleCount = indices.size() / 3;
+    grainSize = std::max<size_t>(grainSize, 1);
+
+    const VertexCorners table = buildVertexCorners(vertexCount, indices, pool, grainSize);
+
+    // Per corner: the face's tangent projected into the plane of the vertex
+    // normal and its bitangent, both weighted by the corner angle
+    std::vector<glm::vec3> cornerTangents(triangleCount * 3);
+    std::vector<glm::vec3> cornerBitangents(triangleCount * 3);
+    pool.parallelFor(triangleCount, grainSize, [&](size_t begin, size_t end) {
+        for (size_t triangle = begin; triangle < end; ++triangle) {
+            const Vertex* corner[3] = {&vertices[indices[triangle * 3]], &vertices[indices[triangle * 3 + 1]],
+                                       &vertices[indices[triangle * 3 + 2]]};
+            const glm::vec3 edge1 = corner[1]->position - corner[0]->position;
+            const glm::vec3 edge2 = corner[2]->position - corner[0]->position;
+            const glm::vec2 uv1 = corner[1]->texCoord - corner[0]->texCoord;
+            const glm::vec2 uv2 = corner[2]->texCoord - corner[0]->texCoord;
+            const float determinant = uv1.x * uv2.y - uv2.x * uv1.y;
+
+            glm::vec3 tangent(0.0f);
+            glm::vec3 bitangent(0.0f);
+            if (std::fabs(determinant) > 1e-12f) {
+                tangent = (edge1 * uv2.y - edge2 * uv1.y) / determinant;
+                bitangent = (edge2 * uv1.x - edge1 * uv2.x) / determinant;
+            }
+
+            for (uint32_t k = 0; k < 3; ++k) {
+                const size_t index = triangle * 3 + k;
+                const glm::vec3& normal = corner[k]->normal;
+                const float angle = cornerAngle(corner[k]->position, corner[(k + 1) % 3]->position,
+                                                corner[(k + 2) % 3]->position);
+                const glm::vec3 projected = tangent - normal * glm::dot(normal, tangent);
+                const float length = glm::length(projected);
+                cornerTangents[index] = length > 0.0f ? projected * (angle / length) : glm::vec3(0.0f);
+                cornerBitangents[index] = bitangent * angle;
+            }
+        }
+    });
+
+    pool.parallelFor(vertexCount, grainSize, [&](size_t begin, size_t end) {
+        for (size_t vertex = begin; vertex < end; ++vertex) {
+            glm::vec3 tangentSum(0.0f);
+            glm::vec3 bitangentSum(0.0f);
+            for (uint32_t i = table.offsets[vertex]; i < table.offsets[vertex + 1]; ++i) {
+                tangentSum += cornerTangents[table.corners[i]];
+                bitangentSum += cornerBitangents[table.corners[i]];
+            }
+
+            Vertex& target = vertices[vertex];
+            const glm::vec3 tangent = tangentSum - target.normal * glm::dot(target.normal, tangentSum);
+            const float length = glm::length(tangent);
+            if (length > 1e-6f) {
+                const glm::vec3 unit = tangent / length;
+                const float handedness = glm::dot(glm::cross(target.normal, unit), bitangentSum) < 0.0f ? -1.0f : 1.0f;
+                target.tangent = glm::vec4(unit, handedness);
+            } else {
+                target.tangent = glm::vec4(anyPerpendicular(target.normal), 1.0f);
+            }
+        }
+    });
+}
+
+void generateTangents(std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices) {
+    generateTangents(vertices, indices, ThreadPool::getInstance());
+}
+
+void optimizeVertexCache(std::vector<uint32_t>& indices, size_t vertexCount) {
+    PROFILE_ZONE("MeshProcessing::optimizeVertexCache");
+    const size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0) {
+        return;
+    }
+
+    // Vertex -> triangle lists; each vertex's still unemitted triangles are
+    // kept at the front of its list, remaining[v] long
+    std::vector<uint32_t> remaining(vertexCount, 0);
+    for (uint32_t index : indices) {
+        if (index >= vertexCount) {
+            throw std::runtime_error("Mesh index " + std::to_string(index) + " is out of range");
+        }
+        remaining[index]++;
+    }
+    std::vector<uint32_t> offsets(vertexCount + 1);
+    uint32_t total = 0;
+    for (size_t vertex = 0; vertex < vertexCount; ++vertex) {
+        offsets[vertex] = total;
+        total += remaining[vertex];
+    }
+    offsets[vertexCount] = total;
+    std::vector<uint32_t> vertexTriangles(total);
+    std::vector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+    for (size_t corner = 0; corner < triangleCount * 3; ++corner) {
+        vertexTriangles[cursor[indices[corner]]++] = static_cast<uint32_t>(corner / 3);
+    }
+
+    std::vector<int> cachePositions(vertexCount, -1);
+    std::vector<float> scores(vertexCount);
+    for (size_t vertex = 0; vertex < vertexCount; ++vertex) {
+        scores[vertex] = vertexCacheScore(-1, remaining[vertex]);
+    }
+    auto triangleScore = [&](uint32_t triangle) {
+        return scores[indices[triangle * 3]] + scores[indices[triangle * 3 + 1]] + scores[indices[triangle * 3 + 2]];
+    };
+
+    // Start from the best triangle overall; later picks only look at the
+    // triangles of cached vertices, falling back to the next unemitted one
+    uint32_t best = 0;
+    float bestScore = -1.0f;
+    for (uint32_t triangle = 0; triangle < triangleCount; ++triangle) {
+        const float score = triangleScore(triangle);
+        if (score > bestScore) {
+            best = triangle;
+            bestScore = score;
+        }
+    }
+
+    std::vector<bool> emitted(triangleCount, false);
+    std::vector<uint32_t> output;
+    output.reserve(triangleCount * 3);
+    std::vector<uint32_t> cache;
+    std::vector<uint32_t> nextCache;
+    cache.reserve(VERTEX_CACHE_SIZE + 3);
+    nextCache.reserve(VERTEX_CACHE_SIZE + 3);
+    size_t fallback = 0;
+
+    for (size_t emittedCount = 0; emittedCount < triangleCount; ++emittedCount) {
+        if (bestScore < 0.0f) {
+            while (emitted[fallback]) {
+                fallback++;
+            }
+            best = static_cast<uint32_t>(fallback);
+        }
+
+        emitted[best] = true;
+        const uint32_t* corners = &indices[best * 3];
+        nextCache.clear();
+        for (int k = 0; k < 3; ++k) {
+            const uint32_t vertex = corners[k];
+            output.push_back(vertex);
+            if (std::find(nextCache.begin(), nextCache.end(), vertex) == nextCache.end()) {
+                nextCache.push_back(vertex);
+            }
+
+            // Drop one entry of the triangle from the vertex's unemitted list (one per corner)
+            uint32_t* list = &vertexTriangles[offsets[vertex]];
+            for (uint32_t i = 0; i < remaining[vertex]; ++i) {
+                if (list[i] == best) {
+                    std::swap(list[i], list[remaining[vertex] - 1]);
+                    remaining[vertex]--;
+                    break;
+                }
+            }
+        }
+
+        // The triangle's vertices move to the front of the LRU cache
+        for (uint32_t vertex : cache) {
+            if (vertex != corners[0] && vertex != corners[1] && vertex != corners[2]) {
+                nextCache.push_back(vertex);
+            }
+        }
+        for (size_t i = 0; i < nextCache.size(); ++i) {
+            const uint32_t vertex = nextCache[i];
+            cachePositions[vertex] = i < VERTEX_CACHE_SIZE ? static_cast<int>(i) : -1;
+            scores[vertex] = vertexCacheScore(cachePositions[vertex], remaining[vertex]);
+        }
+        if (nextCache.size() > VERTEX_CACHE_SIZE) {
+            nextCache.resize(VERTEX_CACHE_SIZE);
+        }
+        cache.swap(nextCache);
+
+        bestScore = -1.0f;
+        for (uint32_t vertex : cache) {
+            const uint32_t* list = &vertexTriangles[offsets[vertex]];
+            for (uint32_t i = 0; i < remaining[vertex]; ++i) {
+                const float score = triangleScore(list[i]);
+                if (score > bestScore) {
+                    best = list[i];
+                    bestScore = score;
+                }
+            }
+        }
+    }
+
+    indices.swap(output);
+}
+
+void optimizeVertexFetch(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices) {
+    PROFILE_ZONE("MeshProcessing::optimizeVertexFetch");
+    std::vector<uint32_t> remap(vertices.size(), UINT32_MAX);
+    uint32_t next = 0;
+    for (uint32_t& index : indices) {
+        if (index >= vertices.size()) {
+            throw std::runtime_error("Mesh index " + std::to_string(index) + " is out of range");
+        }
+        if (remap[index] == UINT32_MAX) {
+            remap[index] = next++;
+        }
+        index = remap[index];
+    }
+
+    std::vector<Vertex> reordered(next);
+    for (size_t vertex = 0; vertex < vertices.size(); ++vertex) {
+        if (remap[vertex] != UINT32_MAX) {
+            reordered[remap[vertex]] = vertices[vertex];
+        }
+    }
+    vertices.swap(reordered);
+}
+
+std::vector<uint32_t> simplifyClusters(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices,
+                                       size_t targetTriangleCount, float& error) {
+    PROFILE_ZONE("MeshProcessing::simplifyClusters");
+    std::vector<uint32_t> result;
+    error = 0.0f;
+    if (vertices.empty()) {
+        return result;
+    }
+
+    glm::vec3 boundsMin = vertices[0].position;
+    glm::vec3 boundsMax = vertices[0].position;
+    for (const Vertex& vertex : vertices) {
+        boundsMin = glm::min(boundsMin, vertex.position);
+        boundsMax = glm::max(boundsMax, vertex.position);
+    }
+    const glm::vec3 extent = boundsMax - boundsMin;
+
+    // The triangle count grows with the resolution; find the finest grid within the target
+    constexpr uint32_t MAX_RESOLUTION = 1024;
+    uint32_t low = 1;
+    uint32_t high = MAX_RESOLUTION;
+    while (low < high) {
+        const uint32_t middle = (low + high + 1) / 2;
+        clusterTriangles(vertices, indices, boundsMin, extent, middle, result);
+        if (result.size() / 3 <= targetTriangleCount) {
+            low = middle;
+        } else {
+            high = middle - 1;
+        }
+    }
+
+    clusterTriangles(vertices, indices, boundsMin, extent, low, result);
+    error = 1.0f / static_cast<float>(low);
+    return result;
+}
+
+MeshletData buildMeshlets(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices,
+                          uint32_t maxVertices, uint32_t maxTriangles) {
+    PROFILE_ZONE("MeshProcessing::buildMeshlets");
+    if (maxVertices < 3 || maxVertices > 256 || maxTriangles == 0) {
+        throw std::runtime_error("Invalid meshlet limits");
+    }
+
+    MeshletData data;
+    std::vector<int> localIndices(vertices.size(), -1);
+    Meshlet current = {};
+
+    auto finish = [&]() {
+        if (current.triangleCount == 0) {
+            return;
+        }
+        const uint32_t* meshletVertices = &data.vertices[current.vertexOffset];
+        glm::vec3 boundsMin = vertices[meshletVertices[0]].position;
+        glm::vec3 boundsMax = boundsMin;
+        for (uint32_t i = 0; i < current.vertexCount; ++i) {
+            boundsMin = glm::min(boundsMin, vertices[meshletVertices[i]].position);
+            boundsMax = glm::max(boundsMax, vertices[meshletVertices[i]].position);
+        }
+        current.center = (boundsMin + boundsMax) * 0.5f;
+        current.radius = 0.0f;
+        for (uint32_t i = 0; i < current.vertexCount; ++i) {
+            current.radius = std::max(current.radius, glm::length(vertices[meshletVertices[i]].position - current.center));
+            localIndices[meshletVertices[i]] = -1;
+        }
+        data.meshlets.push_back(current);
+
+        current = {};
+        current.vertexOffset = static_cast<uint32_t>(data.vertices.size());
+        current.triangleOffset = static_cast<uint32_t>(data.triangles.size());
+    };
+
+    for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+        const uint32_t a = indices[i];
+        const uint32_t b = indices[i + 1];
+        const uint32_t c = indices[i + 2];
+        if (a >= vertices.size() || b >= vertices.size() || c >= vertices.size()) {
+            throw std::runtime_error("Mesh triangle " + std::to_string(i / 3) + " has an index out of range");
+        }
+        const uint32_t added = (localIndices[a] < 0) + (localIndices[b] < 0 && b != a) +
+                               (localIndices[c] < 0 && c != a && c != b);
+        if (current.vertexCount + added > maxVertices || current.triangleCount == maxTriangles) {
+            finish();
+        }
+
+        for (uint32_t vertex : {a, b, c}) {
+            if (localIndices[vertex] < 0) {
+                localIndices[vertex] = static_cast<int>(current.vertexCount++);
+                data.vertices.push_back(vertex);
+            }
+            data.triangles.push_back(static_cast<uint8_t>(localIndices[vertex]));
+        }
+        current.triangleCount++;
+    }
+    finish();
+
+    LOG_DEBUG("Built {} meshlets for {} triangles", "MeshProcessing", data.meshlets.size(), indices.size() / 3);
+    return data;
+}
+
+} // namespace MeshProcessing
+} // namespace VulkanGameEngine
@@ -0,0 +1,329 @@
+#include "../headers/Metrics.h"
+#include "../headers/Logger.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+
+namespace VulkanGameEngine {
+
+// ============================================================================
+// MetricHistogram
+// ============================================================================
+
+MetricHistogram::MetricHistogram(const std::string& unit, double displayScale, uint32_t windowIntervals)
+    : m_unit(unit)
+    , m_displayScale(displayScale > 0.0 ? displayScale : 1.0)
+    , m_intervals(std::max(windowIntervals, 1u)) {
+    for (auto& bucket : m_current) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+}
+
+uint32_t MetricHistogram::bucketIndex(uint64_t value) {
+    if (value < SUB_BUCKET_COUNT) {
+        return static_cast<uint32_t>(value);
+    }
+    if (value >> MAX_VALUE_BITS) {
+        return BUCKET_COUNT - 1;
+    }
+
+    uint32_t msb = 63;
+    while (!(value >> msb)) {
+        msb--;
+    }
+
+    // Keep the top SUB_BUCKET_BITS bits: subBucket lands in [HALF, COUNT)
+    const uint32_t shift = msb - (SUB_BUCKET_BITS - 1);
+    const uint32_t subBucket = static_cast<uint32_t>(value >> shift);
+    return SUB_BUCKET_COUNT + (shift - 1) * SUB_BUCKET_HALF + (subBucket - SUB_BUCKET_HALF);
+}
+
+uint64_t MetricHistogram::bucketUpperBound(uint32_t index) {
+    if (index < SUB_BUCKET_COUNT) {
+        return index;
+    }
+
+    const uint32_t offset = index - SUB_BUCKET_COUNT;
+    const uint32_t shift = offset / SUB_BUCKET_HALF + 1;
+    const uint64_t subBucket = offset % SUB_BUCKET_HALF + SUB_BUCKET_HALF;
+    return ((subBucket + 1) << shift) - 1;
+}
+
+void MetricHistogram::record(uint64_t value) {
+    m_current[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+    m_currentSum.fetch_add(value, std::memory_order_relaxed);
+
+    uint64_t previousMax = m_currentMax.load(std::memory_order_relaxed);
+    while (value > previousMax &&
+           !m_currentMax.compare_exchange_weak(previousMax, value, std::memory_order_relaxed)) {
+    }
+}
+
+void MetricHistogram::rotate() {
+    Interval& interval = m_intervals[m_nextInterval];
+    interval.count = 0;
+    for (uint32_t i = 0; i < BUCKET_COUNT; ++i) {
+        const uint32_t count = m_current[i].exchange(0, std::memory_order_relaxed);
+        interval.buckets[i] = count;
+        interval.count += count;
+    }
+    interval.sum = m_currentSum.exchange(0, std::memory_order_relaxed);
+    interval.max = m_currentMax.exchange(0, std::memory_order_relaxed);
+
+    m_nextInterval = (m_nextInterval + 1) % static_cast<uint32_t>(m_intervals.size());
+    m_filledIntervals = std::min(m_filledIntervals + 1, static_cast<uint32_t>(m_intervals.size()));
+}
+
+HistogramSummary MetricHistogram::summarize(uint32_t intervalCount) const {
+    HistogramSummary summary;
+    const uint32_t capacity = static_cast<uint32_t>(m_intervals.size());
+    intervalCount = std::min(intervalCount, m_filledIntervals);
+
+    std::array<uint64_t, BUCKET_COUNT> merged{};
+    uint64_t sum = 0;
+    uint64_t max = 0;
+    for (uint32_t i = 0; i < intervalCount; ++i) {
+        const Interval& interval = m_intervals[(m_nextInterval + capacity - 1 - i) % capacity];
+        if (interval.count == 0) {
+            continue;
+        }
+        for (uint32_t b = 0; b < BUCKET_COUNT; ++b) {
+            merged[b] += interval.buckets[b];
+        }
+        summary.count += interval.count;
+        sum += interval.sum;
+        max = std::max(max, interval.max);
+    }
+
+    if (summary.count == 0) {
+        return summary;
+    }
+
+    // Walk the buckets once, filling each percentile as its rank is reached
+    const double percentiles[3] = {0.50, 0.95, 0.99};
+    double* outputs[3] = {&summary.p50, &summary.p95, &summary.p99};
+    uint32_t next = 0;
+    uint64_t seen = 0;
+    for (uint32_t b = 0; b < BUCKET_COUNT && next < 3; ++b) {
+        seen += merged[b];
+        while (next < 3 && seen >= static_cast<uint64_t>(percentiles[next] * summary.count + 0.5) && seen > 0) {
+            // Never report more than the exact maximum
+            *outputs[next] = std::min(bucketUpperBound(b), max) / m_displayScale;
+            next++;
+        }
+    }
+
+    summary.mean = (static_cast<double>(sum) / summary.count) / m_displayScale;
+    summary.max = max / m_displayScale;
+    return summary;
+}
+
+// ============================================================================
+// MetricsRegistry
+// ============================================================================
+
+MetricsRegistry& MetricsRegistry::getInstance() {
+    static MetricsRegistry instance;
+    return instance;
+}
+
+MetricsRegistry::MetricsRegistry()
+    : m_startNs(now())
+    , m_lastRotateNs(m_startNs)
+    , m_lastExportNs(m_startNs) {
+}
+
+int64_t MetricsRegistry::now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void MetricsRegistry::configure(const Config& config) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (config.exportPath != m_config.exportPath) {
+        m_csvHeaderWritten = false;
+    }
+    m_config = config;
+    m_config.windowIntervals = std::max(m_config.windowIntervals, 1u);
+}
+
+MetricCounter& MetricsRegistry::counter(const std::string& name) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto& entry = m_counters[name];
+    if (!entry) {
+        entry = std::make_unique<MetricCounter>();
+        m_counterWindowStart[name] = 0;
+    }
+    return *entry;
+}
+
+MetricGauge& MetricsRegistry::gauge(const std::string& name) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto& entry = m_gauges[name];
+    if (!entry) {
+        entry = std::make_unique<MetricGauge>();
+    }
+    return *entry;
+}
+
+MetricHistogram& MetricsRegistry::histogram(const std::string& name, const std::string& unit, double displayScale) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto& entry = m_histograms[name];
+    if (!entry) {
+        entry = std::make_unique<MetricHistogram>(unit, displayScale, m_config.windowIntervals);
+    }
+    return *entry;
+}
+
+void MetricsRegistry::update() {
+    const int64_t timestamp = now();
+    bool exportDue = false;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const int64_t intervalNs = static_cast<int64_t>(m_config.intervalSeconds * 1e9);
+        if (timestamp - m_lastRotateNs < intervalNs) {
+            return;
+        }
+
+        m_lastRotateNs = timestamp;
+        for (auto& entry : m_histograms) {
+            entry.second->rotate();
+        }
+
+        const int64_t exportIntervalNs = static_cast<int64_t>(m_config.exportIntervalSeconds * 1e9);
+        exportDue = !m_config.exportPath.empty() && timestamp - m_lastExportNs >= exportIntervalNs;
+    }
+
+    if (exportDue) {
+        exportNow();
+    }
+}
+
+bool MetricsRegistry::getSummary(const std::string& name, HistogramSummary& summary) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_histograms.find(name);
+    if (it == m_histograms.end()) {
+        return false;
+    }
+    summary = it->second->summarize(it->second->getWindowIntervals());
+    return true;
+}
+
+bool MetricsRegistry::exportNow() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_config.exportPath.empty()) {
+        return false;
+    }
+
+    const int64_t timestamp = now();
+    const double seconds = (timestamp - m_startNs) / 1e9;
+    const bool written = (m_config.exportFormat == ExportFormat::CSV) ? writeCsv(seconds) : writeJson(seconds);
+
+    m_lastExportNs = timestamp;
+    for (auto& entry : m_counters) {
+        m_counterWindowStart[entry.first] = entry.second->getTotal();
+    }
+
+    if (!written) {
+        LOG_ERROR("Failed to write metrics to " + m_config.exportPath, "Metrics");
+    }
+    return written;
+}
+
+bool MetricsRegistry::writeCsv(double timestampSeconds) {
+    std::ofstream file(m_config.exportPath, m_csvHeaderWritten ? std::ios::app : std::ios::trunc);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    if (!m_csvHeaderWritten) {
+        file << "time_s,metric,type,unit,count,mean,p50,p95,p99,max,value\n";
+        m_csvHeaderWritten = true;
+    }
+
+    const double exportWindowSeconds = std::max((now() - m_lastExportNs) / 1e9, 1e-9);
+    char line[512];
+
+    for (const auto& entry : m_histograms) {
+        const MetricHistogram& histogram = *entry.second;
+        const HistogramSummary summary = histogram.summarize(histogram.getWindowIntervals());
+        std::snprintf(line, sizeof(line), "%.3f,%s,histogram,%s,%llu,%.4f,%.4f,%.4f,%.4f,%.4f,\n",
+                      timestampSeconds, entry.first.c_str(), histogram.getUnit().c_str(),
+                      static_cast<unsigned long long>(summary.count),
+                      summary.mean, summary.p50, summary.p95, summary.p99, summary.max);
+        file << line;
+    }
+
+    for (const auto& entry : m_counters) {
+        const uint64_t total = entry.second->getTotal();
+        const uint64_t delta = total - m_counterWindowStart[entry.first];
+        // value column holds the rate since the previous export
+        std::snprintf(line, sizeof(line), "%.3f,%s,counter,,%llu,,,,,,%.4f\n",
+                      timestampSeconds, entry.first.c_str(),
+                      static_cast<unsigned long long>(total), delta / exportWindowSeconds);
+        file << line;
+    }
+
+    for (const auto& entry : m_gauges) {
+        std::snprintf(line, sizeof(line), "%.3f,%s,gauge,,,,,,,,%.4f\n",
+                      timestampSeconds, entry.first.c_str(), entry.second->get());
+        file << line;
+    }
+
+    return static_cast<bool>(file);
+}
+
+bool MetricsRegistry::writeJson(double timestampSeconds) {
+    std::ofstream file(m_config.exportPath, std::ios::out | std::ios::trunc);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    const double exportWindowSeconds = std::max((now() - m_lastExportNs) / 1e9, 1e-9);
+    char line[512];
+
+    std::snprintf(line, sizeof(line), "{\n  \"time_s\": %.3f,\n  \"window_s\": %.3f,\n  \"histograms\": {",
+                  timestampSeconds, m_config.intervalSeconds * m_config.windowIntervals);
+    file << line;
+
+    bool first = true;
+    for (const auto& entry : m_histograms) {
+        const MetricHistogram& histogram = *entry.second;
+        const HistogramSummary summary = histogram.summarize(histogram.getWindowIntervals());
+        std::snprintf(line, sizeof(line),
+                      "%s\n    \"%s\": {\"unit\": \"%s\", \"count\": %llu, \"mean\": %.4f, "
+                      "\"p50\": %.4f, \"p95\": %.4f, \"p99\": %.4f, \"max\": %.4f}",
+                      first ? "" : ",", entry.first.c_str(), histogram.getUnit().c_str(),
+                      static_cast<unsigned long long>(summary.count),
+                      summary.mean, summary.p50, summary.p95, summary.p99, summary.max);
+        file << line;
+        first = false;
+    }
+
+    file << "\n  },\n  \"counters\": {";
+    first = true;
+    for (const auto& entry : m_counters) {
+        const uint64_t total = entry.second->getTotal();
+        const uint64_t delta = total - m_counterWindowStart[entry.first];
+        std::snprintf(line, sizeof(line), "%s\n    \"%s\": {\"total\": %llu, \"per_second\": %.4f}",
+                      first ? "" : ",", entry.first.c_str(),
+                      static_cast<unsigned long long>(total), delta / exportWindowSeconds);
+        file << line;
+        first = false;
+    }
+
+    file << "\n  },\n  \"gauges\": {";
+    first = true;
+    for (const auto& entry : m_gauges) {
+        std::snprintf(line, sizeof(line), "%s\n    \"%s\": %.4f",
+                      first ? "" : ",", entry.first.c_str(), entry.second->get());
+        file << line;
+        first = false;
+    }
+
+    file << "\n  }\n}\n";
+    return static_cast<bool>(file);
+}
+
+} // namespace VulkanGameEngine
@@ -0,0 +1,173 @@
+#include "../headers/NullRenderBackend.h"
+#include "../headers/VulkanUtils.h"
+#include "../headers/Logger.h"
+
+namespace VulkanGameEngine {
+
+NullRenderBackend::NullRenderBackend()
+    : m_initialized(false)
+    , m_width(0)
+    , m_height(0)
+    , m_lastCommandCount(0) {
+}
+
+NullRenderBackend::~NullRenderBackend() {
+    cleanup();
+}
+
+void NullRenderBackend::initialize(const BackendConfig& config) {
+    m_width = config.width;
+    m_height = config.height;
+    m_initialized = true;
+    VulkanUtils::logObjectCreation("NullRenderBackend",
+        std::to_string(m_width) + "x" + std::to_string(m_height) + ", no GPU work will be done");
+}
+
+void NullRenderBackend::cleanup() {
+    if (!m_initialized) {
+        return;
+    }
+
+    size_t leaked = 0;
+    for (bool live : m_liveBuffers) {
+        leaked += live ? 1 : 0;
+    }
+    if (leaked > 0) {
+        LOG_WARN("{} buffers were not destroyed before backend cleanup", "NullBackend", leaked);
+    }
+
+    m_liveBuffers.clear();
+    m_livePipelines.clear();
+    m_initialized = false;
+    VulkanUtils::logObjectDestruction("NullRenderBackend");
+}
+
+void NullRenderBackend::resize(uint32_t width, uint32_t height) {
+    m_width = width;
+    m_height = height;
+}
+
+void NullRenderBackend::getRenderExtent(uint32_t& width, uint32_t& height) const {
+    width = m_width;
+    height = m_height;
+}
+
+BufferHandle NullRenderBackend::createBuffer(BufferType /*type*/, const void* /*data*/, size_t size) {
+    if (size == 0) {
+        throw std::runtime_error("Cannot create an empty buffer");
+    }
+    m_liveBuffers.push_back(true);
+    return static_cast<BufferHandle>(m_liveBuffers.size());
+}
+
+void NullRenderBackend::updateBuffer(BufferHandle buffer, const void* /*data*/, size_t /*size*/) {
+    checkBuffer(buffer);
+}
+
+void NullRenderBackend::updateBufferRange(BufferHandle buffer, size_t /*offset*/, const void* /*data*/, size_t /*size*/) {
+    checkBuffer(buffer);
+}
+
+void NullRenderBackend::destroyBuffer(BufferHandle buffer) {
+    if (buffer == INVALID_HANDLE) {
+        return;
+    }
+    checkBuffer(buffer);
+    m_liveBuffers[buffer - 1] = false;
+}
+
+PipelineHandle NullRenderBackend::createPipeline(const PipelineDesc& /*desc*/) {
+    m_livePipelines.push_back(true);
+    return static_cast<PipelineHandle>(m_livePipelines.size());
+}
+
+void NullRenderBackend::destroyPipeline(PipelineHandle pipeline) {
+    if (pipeline != INVALID_HANDLE && pipeline <= m_livePipelines.size()) {
+        m_livePipelines[pipeline - 1] = false;
+    }
+}
+
+void NullRenderBackend::replacePipeline(PipelineHandle pipeline, const PipelineDesc& /*desc*/) {
+    checkPipeline(pipeline);
+}
+
+FrameStatus NullRenderBackend::beginFrame(uint32_t /*frameSlot*/) {
+    if (!m_initialized) {
+        throw std::runtime_error("NullRenderBackend used before initialize");
+    }
+    return FrameStatus::READY;
+}
+
+void NullRenderBackend::recordFrame(const CommandList& commands) {
+    bool inPass = false;
+    uint32_t zoneDepth = 0;
+
+    for (const Command& command : commands.getCommands()) {
+        switch (command.type) {
+            case CommandType::BEGIN_PASS:
+                if (inPass) {
+                    throw std::runtime_error("Render pass begun inside another pass");
+                }
+                inPass = true;
+                break;
+
+            case CommandType::END_PASS:
+                if (!inPass) {
+                    throw std::runtime_error("Render pass ended without being begun");
+                }
+                inPass = false;
+                break;
+
+            case CommandType::BIND_PIPELINE:
+                checkPipeline(command.handle);
+                break;
+
+            case CommandType::BIND_VERTEX_BUFFER:
+            case CommandType::BIND_INDEX_BUFFER:
+            case CommandType::BIND_UNIFORMS:
+                checkBuffer(command.handle);
+                break;
+
+            case CommandType::BEGIN_ZONE:
+                zoneDepth++;
+                break;
+
+            case CommandType::END_ZONE:
+                if (zoneDepth == 0) {
+                    throw std::runtime_error("GPU zone ended without being begun");
+                }
+                zoneDepth--;
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    if (inPass) {
+        throw std::runtime_error("Render pass was not ended");
+    }
+    if (zoneDepth > 0) {
+        throw std::runtime_error(std::to_string(zoneDepth) + " GPU zones were not ended");
+    }
+
+    m_lastCommandCount = commands.size();
+}
+
+void NullRenderBackend::readbackFrame(std::vector<uint8_t>& /*pixels*/, uint32_t& /*width*/, uint32_t& /*height*/) {
+    throw std::runtime_error("The null backend does not produce images");
+}
+
+void NullRenderBackend::checkBuffer(BufferHandle buffer) const {
+    if (buffer == INVALID_HANDLE || buffer > m_liveBuffers.size() || !m_liveBuffers[buffer - 1]) {
+        throw std::runtime_error("Invalid buffer handle " + std::to_string(buffer));
+    }
+}
+
+void NullRenderBackend::checkPipeline(PipelineHandle pipeline) const {
+    if (pipeline == INVALID_HANDLE || pipeline > m_livePipelines.size() || !m_livePipelines[pipeline - 1]) {
+        throw std::runtime_error("Invalid pipeline handle " + std::to_string(pipeline));
+    }
+}
+
+} // namespace VulkanGameEngine
@@ -0,0 +1,273 @@
+#include "../headers/ObjLoader.h"
+#include "../headers/AssetArchive.h"
+#include "../headers/Logger.h"
+#include "../headers/MeshProcessing.h"
+#include "../headers/Profiler.h"
+#include <sstream>
+#include <unordered_map>
+
+namespace VulkanGameEngine {
+namespace ObjLoader {
+
+namespace {
+
+/**
+ * The OBJ indices of one face corner; equal keys become one vertex
+ */
+struct CornerKey {
+    uint32_t position;
+    uint32_t texCoord;
+    uint32_t normal;
+
+    bool operator==(const CornerKey& other) const {
+        return position == other.position && texCoord == other.texCoord && normal == other.normal;
+    }
+};
+
+struct CornerKeyHash {
+    size_t operator()(const CornerKey& key) const {
+        uint64_t hash = key.position;
+        hash = hash * 0x9E3779B97F4A7C15ull + key.texCoord;
+        hash = hash * 0x9E3779B97F4A7C15ull + key.normal;
+        return static_cast<size_t>(hash ^ (hash >> 32));
+    }
+};
+
+/**
+ * Read-only stream buffer over bytes already in memory (no copy)
+ */
+class MemoryStreamBuffer : public std::streambuf {
+public:
+    explicit MemoryStreamBuffer(const std::vector<char>& bytes) {
+        // The get area is only read from
+        char* begin = const_cast<char*>(bytes.data());
+        setg(begin, begin, begin + bytes.size());
+    }
+};
+
+} // anonymous namespace
+
+bool parseOBJFile(const std::string& filePath, OBJData& objData) {
+    // Mounted archives first, then loose files
+    std::vector<char> bytes;
+    if (!AssetFileSystem::getInstance().readFile(filePath, bytes)) {
+        LOG_ERROR("Cannot open OBJ file: " + filePath, "ObjLoader");
+        return false;
+    }
+
+    return parseOBJBuffer(bytes, objData);
+}
+
+bool parseOBJBuffer(const std::vector<char>& bytes, OBJData& objData) {
+    MemoryStreamBuffer buffer(bytes);
+    std::istream stream(&buffer);
+    return parseOBJStream(stream, objData);
+}
+
+bool parseOBJStream(std::istream& stream, OBJData& objData) {
+    objData.clear();
+    std::string line;
+    uint32_t lineNumber = 0;
+
+    while (std::getline(stream, line)) {
+        lineNumber++;
+
+        // Skip empty lines and comments
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+
+        std::istringstream iss(line);
+        std::string prefix;
+        iss >> prefix;
+
+        try {
+            if (prefix == "v") {
+                // Vertex position
+                float x, y, z;
+                if (iss >> x >> y >> z) {
+                    objData.positions.emplace_back(x, y, z);
+                } else {
+                    LOG_WARN("Invalid vertex position at line " + std::to_string(lineNumber), "ObjLoader");
+                }
+            }
+            else if (prefix == "vn") {
+                // Vertex normal
+                float x, y, z;
+                if (iss >> x >> y >> z) {
+                    objData.normals.emplace_back(x, y, z);
+                } else {
+                    LOG_WARN("Invalid vertex normal at line " + std::to_string(lineNumber), "ObjLoader");
+                }
+            }
+            else if (prefix == "vt") {
+                // Texture coordinate
+                float u, v;
+                if (iss >> u >> v) {
+                    objData.texCoords.emplace_back(u, v);
+                } else {
+                    LOG_WARN("Invalid texture coordinate at line " + std::to_string(lineNumber), "ObjLoader");
+                }
+            }
+            else if (prefix == "f") {
+                // Face definition
+                if (!parseFaceLine(line, objData)) {
+                    LOG_WARN("Invalid face definition at line " + std::to_string(lineNumber), "ObjLoader");
+                }
+            }
+            // Ignore other OBJ elements (materials, groups, etc.)
+
+        } catch (const std::exception& e) {
+            LOG_WARN("Error parsing line " + std::to_string(lineNumber) + ": " + e.what(), "ObjLoader");
+        }
+    }
+
+    // Validate parsed data
+    if (objData.positions.empty()) {
+        LOG_ERROR("No vertex positions found in OBJ file", "ObjLoader");
+        return false;
+    }
+
+    if (objData.indices.empty()) {
+        LOG_ERROR("No faces found in OBJ file", "ObjLoader");
+        return false;
+    }
+
+    LOG_DEBUG("OBJ file parsed successfully", "ObjLoader");
+    return true;
+}
+
+bool parseFaceLine(const std::string& line, OBJData& objData) {
+    std::istringstream iss(line);
+    std::string prefix;
+    iss >> prefix; // Skip "f"
+
+    // Parse every corner first so a bad corner leaves objData untouched
+    std::vector<uint32_t> positions;
+    std::vector<uint32_t> texCoords;
+    std::vector<uint32_t> normals;
+    std::string vertexStr;
+    while (iss >> vertexStr) {
+        // Parse vertex string (format: v/vt/vn or v//vn or v/vt or v)
+        int indices[3] = {-1, -1, -1}; // [position, texcoord, normal]
+
+        size_t pos = 0;
+        int component = 0;
+
+        while (pos < vertexStr.length() && component < 3) {
+            size_t nextSlash = vertexStr.find('/', pos);
+            std::string indexStr;
+
+            if (nextSlash == std::string::npos) {
+                indexStr = vertexStr.substr(pos);
+                pos = vertexStr.length();
+            } else {
+                indexStr = vertexStr.substr(pos, nextSlash - pos);
+                pos = nextSlash + 1;
+            }
+
+            if (!indexStr.empty()) {
+                try {
+                    indices[component] = std::stoi(indexStr) - 1; // OBJ indices are 1-based
+                } catch (const std::exception&) {
+                    return false;
+                }
+            }
+
+            component++;
+        }
+
+        // Validate position index (required)
+        if (indices[0] < 0 || indices[0] >= static_cast<int>(objData.positions.size())) {
+            return false;
+        }
+
+        positions.push_back(static_cast<uint32_t>(indices[0]));
+        texCoords.push_back(indices[1] >= 0 && indices[1] < static_cast<int>(objData.texCoords.size())
+                            ? static_cast<uint32_t>(indices[1]) : NO_INDEX);
+        normals.push_back(indices[2] >= 0 && indices[2] < static_cast<int>(objData.normals.size())
+                          ? static_cast<uint32_t>(indices[2]) : NO_INDEX);
+    }
+
+    // We need at least 3 vertices for a triangle
+    if (positions.size() < 3) {
+        return false;
+    }
+
+    // Faces with more than 3 vertices are triangulated as a fan: vertex 0, vertex i, vertex i+1
+    for (size_t i = 1; i < positions.size() - 1; ++i) {
+        for (size_t corner : {size_t(0), i, i + 1}) {
+            objData.indices.push_back(positions[corner]);
+            objData.texCoordIndices.push_back(texCoords[corner]);
+            objData.normalIndices.push_back(normals[corner]);
+        }
+    }
+
+    return true;
+}
+
+void convertOBJToVertices(const OBJData& objData, std::vector<Vertex>& vertices, std::vector<uint32_t>& indices) {
+    PROFILE_ZONE("ObjLoader::convertOBJToVertices");
+    vertices.clear();
+    indices.clear();
+    indices.reserve(objData.indices.size());
+
+    // Corners from parseFaceLine always carry all three indices; hand-built data may only have positions
+    const bool hasCornerAttributes = objData.texCoordIndices.size() == objData.indices.size() &&
+                                     objData.normalIndices.size() == objData.indices.size();
+    bool allNormals = hasCornerAttributes && !objData.normals.empty();
+
+    // Create a map to avoid duplicate vertices (one per position/texcoord/normal combination)
+    std::unordered_map<CornerKey, uint32_t, CornerKeyHash> vertexMap;
+    vertexMap.reserve(objData.positions.size());
+
+    for (size_t i = 0; i < objData.indices.size(); ++i) {
+        const CornerKey key = {objData.indices[i],
+                               hasCornerAttributes ? objData.texCoordIndices[i] : NO_INDEX,
+                               hasCornerAttributes ? objData.normalIndices[i] : NO_INDEX};
+        allNormals = allNormals && key.normal != NO_INDEX;
+
+        // Reuse the vertex if we've already processed this combination
+        const auto inserted = vertexMap.try_emplace(key, static_cast<uint32_t>(vertices.size()));
+        indices.push_back(inserted.first->second);
+        if (!inserted.second) {
+            continue;
+        }
+
+        // Create new vertex
+        Vertex vertex{};
+
+        // Position (required)
+        if (key.position < objData.positions.size()) {
+            vertex.position = objData.positions[key.position];
+        } else {
+            LOG_WARN("Invalid position index: " + std::to_string(key.position), "ObjLoader");
+            vertex.position = glm::vec3(0.0f);
+        }
+
+        // Texture coordinates and normal (zero if not available)
+        if (key.texCoord != NO_INDEX) {
+            vertex.texCoord = objData.texCoords[key.texCoord];
+        }
+        if (key.normal != NO_INDEX) {
+            const float length = glm::length(objData.normals[key.normal]);
+            vertex.normal = length > 0.0f ? objData.normals[key.normal] / length : glm::vec3(0.0f, 1.0f, 0.0f);
+        }
+
+        vertices.push_back(vertex);
+    }
+
+    if (!allNormals && !indices.empty()) {
+        LOG_DEBUG("OBJ data has no normals for every corner, generating them", "ObjLoader");
+        MeshProcessing::generateNormals(vertices, indices);
+    }
+    if (!indices.empty()) {
+        MeshProcessing::generateTangents(vertices, indices);
+    }
+
+    LOG_DEBUG("Converted OBJ to " + std::to_string(vertices.size()) + " vertices and " + 
+             std::to_string(indices.size()) + " indices", "ObjLoader");
+}
+
+} // namespace ObjLoader
+} // namespace VulkanGameEngine
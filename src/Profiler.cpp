@@ -0,0 +1,328 @@
+#include "../headers/Profiler.h"
+#include "../headers/Logger.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+
+namespace VulkanGameEngine {
+
+namespace {
+
+/**
+ * Per-thread pointer to the profiler buffer. On thread exit the buffer is
+ * marked free so a later thread can reuse it. The slot shares ownership of
+ * the buffer, so threads that outlive the Profiler (pool workers joined
+ * after static destruction) still release into live memory.
+ */
+struct ThreadBufferSlot {
+    void* buffer = nullptr;
+    std::atomic<bool>* inUse = nullptr;
+    std::shared_ptr<void> owner;
+
+    ~ThreadBufferSlot() {
+        if (inUse) {
+            inUse->store(false, std::memory_order_release);
+        }
+    }
+};
+
+thread_local ThreadBufferSlot t_bufferSlot;
+
+void appendJsonString(std::string& out, const char* text) {
+    out += '"';
+    for (const char* c = text; *c; ++c) {
+        if (*c == '"' || *c == '\\') {
+            out += '\\';
+        }
+        out += *c;
+    }
+    out += '"';
+}
+
+} // anonymous namespace
+
+Profiler& Profiler::getInstance() {
+    static Profiler instance;
+    return instance;
+}
+
+Profiler::Profiler() {
+    m_frameMarkers.reserve(FRAME_MARKER_CAPACITY);
+
+    // The GPU track is a buffer that is never handed to a real thread
+    m_gpuTrack = std::make_shared<ThreadBuffer>();
+    m_gpuTrack->events.resize(EVENTS_PER_THREAD);
+    m_gpuTrack->threadId = m_nextThreadId.fetch_add(1, std::memory_order_relaxed);
+    m_threads.push_back(m_gpuTrack);
+    m_threadNames[m_gpuTrack->threadId] = "GPU";
+}
+
+Profiler::ThreadBuffer& Profiler::getThreadBuffer() {
+    if (t_bufferSlot.buffer) {
+        return *static_cast<ThreadBuffer*>(t_bufferSlot.buffer);
+    }
+
+    std::lock_guard<std::mutex> lock(m_threadsMutex);
+
+    std::shared_ptr<ThreadBuffer> buffer;
+    for (auto& candidate : m_threads) {
+        bool expected = false;
+        if (candidate->inUse.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+            buffer = candidate;
+            break;
+        }
+    }
+
+    if (!buffer) {
+        buffer = std::make_shared<ThreadBuffer>();
+        buffer->events.resize(EVENTS_PER_THREAD);
+        m_threads.push_back(buffer);
+    }
+
+    buffer->threadId = m_nextThreadId.fetch_add(1, std::memory_order_relaxed);
+    buffer->depth = 0;
+
+    t_bufferSlot.buffer = buffer.get();
+    t_bufferSlot.inUse = &buffer->inUse;
+    t_bufferSlot.owner = buffer;
+    return *buffer;
+}
+
+void Profiler::setThreadName(const std::string& name) {
+    ThreadBuffer& buffer = getThreadBuffer();
+    std::lock_guard<std::mutex> lock(m_threadsMutex);
+    m_threadNames[buffer.threadId] = name;
+}
+
+void Profiler::beginZone(const char* name) {
+    ThreadBuffer& buffer = getThreadBuffer();
+    if (buffer.depth >= MAX_ZONE_DEPTH) {
+        buffer.depth++; // Still track depth so endZone stays balanced
+        return;
+    }
+
+    buffer.openNames[buffer.depth] = name;
+    buffer.openFrames[buffer.depth] = m_frameIndex.load(std::memory_order_relaxed);
+    buffer.openStarts[buffer.depth] = now();
+    buffer.depth++;
+}
+
+void Profiler::endZone() {
+    const int64_t endNs = now();
+    ThreadBuffer& buffer = getThreadBuffer();
+    if (buffer.depth == 0) {
+        return;
+    }
+
+    buffer.depth--;
+    if (buffer.depth >= MAX_ZONE_DEPTH) {
+        return;
+    }
+
+    const uint64_t index = buffer.writeCount.load(std::memory_order_relaxed);
+    Event& event = buffer.events[index & (EVENTS_PER_THREAD - 1)];
+    event.name = buffer.openNames[buffer.depth];
+    event.startNs = buffer.openStarts[buffer.depth];
+    event.endNs = endNs;
+    event.frame = buffer.openFrames[buffer.depth];
+    event.depth = buffer.depth;
+    event.threadId = buffer.threadId;
+    buffer.writeCount.store(index + 1, std::memory_order_release);
+}
+
+void Profiler::recordGpuZone(const char* name, int64_t startNs, int64_t endNs, uint64_t frame, uint32_t depth) {
+    if (!isEnabled()) {
+        return;
+    }
+
+    ThreadBuffer& track = *m_gpuTrack;
+    const uint64_t index = track.writeCount.load(std::memory_order_relaxed);
+    Event& event = track.events[index & (EVENTS_PER_THREAD - 1)];
+    event.name = name;
+    event.startNs = startNs;
+    event.endNs = endNs;
+    event.frame = frame;
+    event.depth = depth;
+    event.threadId = track.threadId;
+    track.writeCount.store(index + 1, std::memory_order_release);
+}
+
+void Profiler::markFrame() {
+    const int64_t timestamp = now();
+    const uint64_t frame = m_frameIndex.fetch_add(1, std::memory_order_relaxed) + 1;
+
+    {
+        std::lock_guard<std::mutex> lock(m_frameMarkersMutex);
+        if (m_frameMarkers.size() < FRAME_MARKER_CAPACITY) {
+            m_frameMarkers.push_back({frame, timestamp});
+        } else {
+            m_frameMarkers[(frame - 1) % FRAME_MARKER_CAPACITY] = {frame, timestamp};
+        }
+    }
+
+    if (!m_capturePending.load(std::memory_order_acquire)) {
+        return;
+    }
+
+    std::string path;
+    uint64_t firstFrame;
+    uint64_t lastFrame;
+    {
+        std::lock_guard<std::mutex> lock(m_captureMutex);
+        if (frame <= m_captureLastFrame) {
+            return;
+        }
+        path = m_capturePath;
+        firstFrame = m_captureFirstFrame;
+        lastFrame = m_captureLastFrame;
+        m_capturePending.store(false, std::memory_order_release);
+    }
+
+    if (exportChromeTrace(path, firstFrame, lastFrame)) {
+        LOG_INFO("Wrote trace for frames {}-{} to {}", "Profiler", firstFrame, lastFrame, path);
+    }
+}
+
+void Profiler::captureFrames(uint32_t frameCount, const std::string& outputPath) {
+    if (frameCount == 0) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_captureMutex);
+    m_capturePath = outputPath;
+    m_captureFirstFrame = getFrameIndex() + 1;
+    m_captureLastFrame = m_captureFirstFrame + frameCount - 1;
+    m_capturePending.store(true, std::memory_order_release);
+
+    LOG_INFO("Capturing frames {}-{}", "Profiler", m_captureFirstFrame, m_captureLastFrame);
+}
+
+void Profiler::collectEvents(uint64_t firstFrame, uint64_t lastFrame, std::vector<Event>& events) {
+    std::vector<std::shared_ptr<ThreadBuffer>> threads;
+    {
+        std::lock_guard<std::mutex> lock(m_threadsMutex);
+        threads = m_threads;
+    }
+
+    std::vector<std::pair<uint64_t, Event>> copied;
+    for (const auto& buffer : threads) {
+        const uint64_t end = buffer->writeCount.load(std::memory_order_acquire);
+        const uint64_t begin = end > EVENTS_PER_THREAD ? end - EVENTS_PER_THREAD : 0;
+
+        copied.clear();
+        for (uint64_t i = begin; i < end; ++i) {
+            const Event& event = buffer->events[i & (EVENTS_PER_THREAD - 1)];
+            if (event.frame >= firstFrame && event.frame <= lastFrame) {
+                copied.emplace_back(i, event);
+            }
+        }
+
+        // Slots below safeBegin may have been overwritten by the owning thread while we copied
+        const uint64_t endAfterCopy = buffer->writeCount.load(std::memory_order_acquire);
+        const uint64_t safeBegin = endAfterCopy > EVENTS_PER_THREAD ? endAfterCopy - EVENTS_PER_THREAD : 0;
+        for (const auto& entry : copied) {
+            if (entry.first >= safeBegin) {
+                events.push_back(entry.second);
+            }
+        }
+    }
+}
+
+bool Profiler::exportChromeTrace(const std::string& outputPath, uint64_t firstFrame, uint64_t lastFrame) {
+    std::vector<Event> events;
+    collectEvents(firstFrame, lastFrame, events);
+
+    std::vector<FrameMarker> frames;
+    {
+        std::lock_guard<std::mutex> lock(m_frameMarkersMutex);
+        for (const FrameMarker& marker : m_frameMarkers) {
+            // Frame lastFrame + 1 is needed to know where lastFrame ended
+            if (marker.frame >= firstFrame && marker.frame <= lastFrame + 1) {
+                frames.push_back(marker);
+            }
+        }
+    }
+    std::sort(frames.begin(), frames.end(), [](const FrameMarker& a, const FrameMarker& b) {
+        return a.frame < b.frame;
+    });
+
+    std::unordered_map<uint32_t, std::string> threadNames;
+    {
+        std::lock_guard<std::mutex> lock(m_threadsMutex);
+        threadNames = m_threadNames;
+    }
+
+    std::ofstream file(outputPath, std::ios::out | std::ios::trunc);
+    if (!file.is_open()) {
+        LOG_ERROR("Failed to open trace file: " + outputPath, "Profiler");
+        return false;
+    }
+
+    // Chrome trace timestamps are microseconds; keep nanosecond precision with three decimals
+    int64_t origin = INT64_MAX;
+    for (const Event& event : events) {
+        origin = std::min(origin, event.startNs);
+    }
+    for (const FrameMarker& marker : frames) {
+        origin = std::min(origin, marker.startNs);
+    }
+    if (origin == INT64_MAX) {
+        origin = 0;
+    }
+
+    std::string out;
+    out.reserve(events.size() * 128 + 1024);
+    out += "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+
+    char buffer[160];
+    bool first = true;
+    auto separator = [&]() {
+        if (!first) {
+            out += ",\n";
+        }
+        first = false;
+    };
+
+    // Thread names
+    out += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"Frames\"}}";
+    first = false;
+    for (const auto& entry : threadNames) {
+        separator();
+        std::snprintf(buffer, sizeof(buffer), "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":", entry.first);
+        out += buffer;
+        appendJsonString(out, entry.second.c_str());
+        out += "}}";
+    }
+
+    // Frame boundaries on their own track
+    for (size_t i = 0; i + 1 < frames.size(); ++i) {
+        separator();
+        std::snprintf(buffer, sizeof(buffer),
+                      "{\"name\":\"Frame %llu\",\"ph\":\"X\",\"pid\":1,\"tid\":0,\"ts\":%.3f,\"dur\":%.3f}",
+                      static_cast<unsigned long long>(frames[i].frame),
+                      (frames[i].startNs - origin) / 1000.0,
+                      (frames[i + 1].startNs - frames[i].startNs) / 1000.0);
+        out += buffer;
+    }
+
+    // Zones as complete events
+    for (const Event& event : events) {
+        separator();
+        out += "{\"name\":";
+        appendJsonString(out, event.name);
+        std::snprintf(buffer, sizeof(buffer),
+                      ",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"frame\":%llu,\"depth\":%u}}",
+                      event.threadId,
+                      (event.startNs - origin) / 1000.0,
+                      (event.endNs - event.startNs) / 1000.0,
+                      static_cast<unsigned long long>(event.frame),
+                      event.depth);
+        out += buffer;
+    }
+
+    out += "\n]}\n";
+    file.write(out.data(), static_cast<std::streamsize>(out.size()));
+    return static_cast<bool>(file);
+}
+
+} // namespace VulkanGameEngine
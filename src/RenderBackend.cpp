@@ -0,0 +1,39 @@
+#include "../headers/RenderBackend.h"
+#include "../headers/VulkanRenderBackend.h"
+#include "../headers/NullRenderBackend.h"
+
+namespace VulkanGameEngine {
+
+std::unique_ptr<RenderBackend> createRenderBackend(BackendType type) {
+    switch (type) {
+        case BackendType::NULL_BACKEND:
+            return std::make_unique<NullRenderBackend>();
+        case BackendType::VULKAN:
+        default:
+            return std::make_unique<VulkanRenderBackend>();
+    }
+}
+
+const char* getBackendName(BackendType type) {
+    switch (type) {
+        case BackendType::NULL_BACKEND:
+            return "null";
+        case BackendType::VULKAN:
+        default:
+            return "vulkan";
+    }
+}
+
+bool parseBackendType(const std::string& name, BackendType& type) {
+    if (name == "vulkan") {
+        type = BackendType::VULKAN;
+        return true;
+    }
+    if (name == "null") {
+        type = BackendType::NULL_BACKEND;
+        return true;
+    }
+    return false;
+}
+
+} // namespace VulkanGameEngine
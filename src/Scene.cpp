@@ -0,0 +1,217 @@
+#include "../headers/Scene.h"
+#include "../headers/RenderBackend.h"
+#include "../headers/Logger.h"
+#include "../headers/Profiler.h"
+#include <algorithm>
+#include <cmath>
+
+namespace VulkanGameEngine {
+
+namespace {
+
+// Deforming meshes: a bulge of DEFORM_BAND_FRACTION of the vertices crosses the mesh every DEFORM_PERIOD seconds
+constexpr float DEFORM_PERIOD = 2.0f;
+constexpr float DEFORM_BAND_FRACTION = 0.125f;
+constexpr float DEFORM_AMPLITUDE = 0.15f;   // Along the normal, in mesh units
+constexpr float PI = 3.14159265358979f;
+
+} // anonymous namespace
+
+uint32_t Scene::addMesh(RenderBackend& backend, const std::vector<Vertex>& vertices,
+                        const std::vector<uint32_t>& indices, ColorMode colorMode) {
+    if (vertices.empty() || indices.empty()) {
+        throw std::runtime_error("Scene meshes need vertices and indices");
+    }
+
+    SceneMesh mesh;
+    mesh.vertexCount = static_cast<uint32_t>(vertices.size());
+    mesh.indexCount = static_cast<uint32_t>(indices.size());
+    mesh.colorMode = colorMode;
+    mesh.vertexBuffer = backend.createBuffer(BufferType::VERTEX, vertices.data(), vertices.size() * sizeof(Vertex));
+    try {
+        mesh.indexBuffer = backend.createBuffer(BufferType::INDEX, indices.data(), indices.size() * sizeof(uint32_t));
+    } catch (...) {
+        backend.destroyBuffer(mesh.vertexBuffer);
+        throw;
+    }
+
+    m_meshes.push_back(mesh);
+    m_stats.meshes = static_cast<uint32_t>(m_meshes.size());
+    return m_stats.meshes - 1;
+}
+
+uint32_t Scene::addDeformingMesh(RenderBackend& backend, const std::vector<Vertex>& vertices,
+                                 const std::vector<uint32_t>& indices, ColorMode colorMode) {
+    DeformingMesh deforming;
+    deforming.mesh.reset(new DynamicMesh());
+    deforming.mesh->create(backend, vertices, indices);
+    deforming.restPositions.reserve(vertices.size());
+    for (const Vertex& vertex : vertices) {
+        deforming.restPositions.push_back(vertex.position);
+    }
+
+    SceneMesh mesh;
+    mesh.vertexBuffer = deforming.mesh->getVertexBuffer();
+    mesh.indexBuffer = deforming.mesh->getIndexBuffer();
+    mesh.vertexCount = deforming.mesh->getVertexCount();
+    mesh.indexCount = deforming.mesh->getIndexCount();
+    mesh.colorMode = colorMode;
+    mesh.deforming = true;
+
+    m_deformingMeshes.push_back(std::move(deforming));
+    m_meshes.push_back(mesh);
+    m_stats.meshes = static_cast<uint32_t>(m_meshes.size());
+    m_stats.deformingMeshes = static_cast<uint32_t>(m_deformingMeshes.size());
+    return m_stats.meshes - 1;
+}
+
+uint32_t Scene::addMaterial(const glm::vec4& tint) {
+    m_materials.push_back(tint);
+    m_stats.materials = static_cast<uint32_t>(m_materials.size());
+    return m_stats.materials - 1;
+}
+
+uint32_t Scene::addObject(const SceneObject& object) {
+    if (object.mesh >= m_meshes.size()) {
+        throw std::runtime_error("Scene object uses unknown mesh " + std::to_string(object.mesh));
+    }
+    if (object.material >= m_materials.size()) {
+        throw std::runtime_error("Scene object uses unknown material " + std::to_string(object.material));
+    }
+
+    const uint32_t index = static_cast<uint32_t>(m_objects.size());
+    m_objects.push_back(object);
+    m_transforms.push_back(composeTransform(object.position, object.rotation, object.scale));
+    if (object.dynamic) {
+        m_dynamicObjects.push_back(index);
+    }
+    m_drawOrder.push_back(index);
+    m_drawOrderDirty = true;
+
+    m_radius = std::max(m_radius, glm::length(object.position) + object.scale);
+    m_stats.objects++;
+    m_stats.dynamicObjects = static_cast<uint32_t>(m_dynamicObjects.size());
+    m_stats.drawsPerFrame++;
+    m_stats.trianglesPerFrame += m_meshes[object.mesh].indexCount / 3;
+    return index;
+}
+
+void Scene::update(float deltaTime) {
+    PROFILE_ZONE("Scene::update");
+    if (m_drawOrderDirty) {
+        sortDrawOrder();
+    }
+
+    for (uint32_t index : m_dynamicObjects) {
+        SceneObject& object = m_objects[index];
+        object.rotation += object.angularVelocity * deltaTime;
+        m_transforms[index] = composeTransform(object.position, object.rotation, object.scale);
+    }
+
+    for (DeformingMesh& deforming : m_deformingMeshes) {
+        deform(deforming, deltaTime);
+    }
+}
+
+size_t Scene::flush(uint32_t frameSlot) {
+    size_t uploaded = 0;
+    for (DeformingMesh& deforming : m_deformingMeshes) {
+        uploaded += deforming.mesh->flush(frameSlot);
+    }
+    return uploaded;
+}
+
+void Scene::record(CommandList& commandList) const {
+    uint32_t boundMesh = UINT32_MAX;
+    ObjectConstants constants;
+    for (uint32_t index : m_drawOrder) {
+        const SceneObject& object = m_objects[index];
+        const SceneMesh& mesh = m_meshes[object.mesh];
+        if (object.mesh != boundMesh) {
+            commandList.bindVertexBuffer(mesh.vertexBuffer);
+            commandList.bindIndexBuffer(mesh.indexBuffer);
+            boundMesh = object.mesh;
+            constants.colorMode = mesh.colorMode;
+        }
+        constants.model = m_transforms[index];
+        constants.tint = m_materials[object.material];
+        commandList.pushObjectConstants(constants);
+        commandList.drawIndexed(mesh.indexCount);
+    }
+}
+
+void Scene::clear(RenderBackend& backend) {
+    for (const SceneMesh& mesh : m_meshes) {
+        if (!mesh.deforming) {
+            backend.destroyBuffer(mesh.vertexBuffer);
+            backend.destroyBuffer(mesh.indexBuffer);
+        }
+    }
+    m_deformingMeshes.clear();  // DynamicMesh destroys its own buffers
+    m_meshes.clear();
+    m_materials.clear();
+    m_objects.clear();
+    m_transforms.clear();
+    m_dynamicObjects.clear();
+    m_drawOrder.clear();
+    m_drawOrderDirty = false;
+    m_radius = 0.0f;
+    m_stats = Stats();
+}
+
+glm::mat4 Scene::composeTransform(const glm::vec3& position, const glm::vec3& rotation, float scale) {
+    glm::mat4 translation = glm::translate(glm::mat4(1.0f), position);
+    glm::mat4 rotationX = glm::rotate(glm::mat4(1.0f), rotation.x, glm::vec3(1.0f, 0.0f, 0.0f));
+    glm::mat4 rotationY = glm::rotate(glm::mat4(1.0f), rotation.y, glm::vec3(0.0f, 1.0f, 0.0f));
+    glm::mat4 rotationZ = glm::rotate(glm::mat4(1.0f), rotation.z, glm::vec3(0.0f, 0.0f, 1.0f));
+    return translation * (rotationZ * rotationY * rotationX) * glm::scale(glm::mat4(1.0f), glm::vec3(scale));
+}
+
+void Scene::sortDrawOrder() {
+    // Stable, so objects sharing mesh and material keep the order they were added in
+    std::stable_sort(m_drawOrder.begin(), m_drawOrder.end(), [this](uint32_t a, uint32_t b) {
+        const SceneObject& left = m_objects[a];
+        const SceneObject& right = m_objects[b];
+        if (left.mesh != right.mesh) {
+            return left.mesh < right.mesh;
+        }
+        return left.material < right.material;
+    });
+    m_drawOrderDirty = false;
+    LOG_DEBUG("Scene draw order sorted: {} objects, {} meshes, {} materials", "Scene",
+              m_stats.objects, m_stats.meshes, m_stats.materials);
+}
+
+void Scene::deform(DeformingMesh& deforming, float deltaTime) {
+    DynamicMesh& mesh = *deforming.mesh;
+    std::vector<Vertex>& vertices = mesh.getVertices();
+    const uint32_t count = mesh.getVertexCount();
+    const float width = std::max(1.0f, DEFORM_BAND_FRACTION * static_cast<float>(count));
+
+    // The bulge's leading edge runs from the first vertex to width past the last, then starts over
+    deforming.phase += deltaTime / DEFORM_PERIOD;
+    deforming.phase -= std::floor(deforming.phase);
+    const float head = deforming.phase * (static_cast<float>(count) + width);
+    const float end = static_cast<float>(count);
+    const uint32_t bandBegin = static_cast<uint32_t>(std::min(std::max(std::ceil(head - width), 0.0f), end));
+    const uint32_t bandEnd = static_cast<uint32_t>(std::min(std::ceil(head), end));
+
+    // Vertices the bulge left go back to rest (all of the old band when it wrapped around)
+    const uint32_t restEnd =
+        bandBegin >= deforming.bandBegin ? std::min(deforming.bandEnd, bandBegin) : deforming.bandEnd;
+    for (uint32_t i = deforming.bandBegin; i < restEnd; ++i) {
+        vertices[i].position = deforming.restPositions[i];
+    }
+    mesh.markDirty(deforming.bandBegin, std::max(restEnd, deforming.bandBegin) - deforming.bandBegin);
+
+    for (uint32_t i = bandBegin; i < bandEnd; ++i) {
+        const float along = (head - static_cast<float>(i)) / width;
+        const float offset = DEFORM_AMPLITUDE * std::sin(PI * along);
+        vertices[i].position = deforming.restPositions[i] + vertices[i].normal * offset;
+    }
+    mesh.markDirty(bandBegin, bandEnd - bandBegin);
+    deforming.bandBegin = bandBegin;
+    deforming.bandEnd = bandEnd;
+}
+
+} // namespace VulkanGameEngine
@@ -0,0 +1,367 @@
+#include "../headers/SceneGenerator.h"
+#include "../headers/Scene.h"
+#include "../headers/ObjLoader.h"
+#include "../headers/MeshProcessing.h"
+#include "../headers/Benchmark.h"
+#include "../headers/Logger.h"
+#include "../headers/Profiler.h"
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+namespace VulkanGameEngine {
+namespace SceneGenerator {
+
+namespace {
+
+constexpr const char* CHARACTER_ASSET = "assets/FinalBaseMesh.obj";
+constexpr float PI = 3.14159265358979f;
+
+// Frames between generated camera keys (the path is interpolated in between)
+constexpr uint64_t CAMERA_KEY_INTERVAL = 30;
+
+/**
+ * SplitMix64: tiny, and unlike <random> distributions it produces the same
+ * sequence with every standard library
+ */
+class Random {
+public:
+    explicit Random(uint64_t seed) : m_state(seed) {}
+
+    uint64_t next() {
+        uint64_t z = (m_state += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    // Uniform in [0, 1)
+    float uniform() { return static_cast<float>(next() >> 40) / static_cast<float>(1ull << 24); }
+    float range(float low, float high) { return low + (high - low) * uniform(); }
+    uint32_t below(uint32_t count) { return static_cast<uint32_t>(next() % count); }
+
+private:
+    uint64_t m_state;
+};
+
+glm::vec3 hsvToRgb(float hue, float saturation, float value) {
+    const float h = (hue - std::floor(hue)) * 6.0f;
+    const float c = value * saturation;
+    const float x = c * (1.0f - std::fabs(std::fmod(h, 2.0f) - 1.0f));
+    glm::vec3 rgb;
+    if (h < 1.0f)      rgb = glm::vec3(c, x, 0.0f);
+    else if (h < 2.0f) rgb = glm::vec3(x, c, 0.0f);
+    else if (h < 3.0f) rgb = glm::vec3(0.0f, c, x);
+    else if (h < 4.0f) rgb = glm::vec3(0.0f, x, c);
+    else if (h < 5.0f) rgb = glm::vec3(x, 0.0f, c);
+    else               rgb = glm::vec3(c, 0.0f, x);
+    return rgb + glm::vec3(value - c);
+}
+
+void buildSphere(uint32_t rings, std::vector<glm::vec3>& positions, std::vector<uint32_t>& indices) {
+    const uint32_t segments = rings * 2;
+    for (uint32_t ring = 0; ring <= rings; ++ring) {
+        const float phi = PI * static_cast<float>(ring) / static_cast<float>(rings);
+        for (uint32_t segment = 0; segment <= segments; ++segment) {
+            const float theta = 2.0f * PI * static_cast<float>(segment) / static_cast<float>(segments);
+            positions.emplace_back(std::sin(phi) * std::cos(theta), std::cos(phi), std::sin(phi) * std::sin(theta));
+        }
+    }
+    for (uint32_t ring = 0; ring < rings; ++ring) {
+        for (uint32_t segment = 0; segment < segments; ++segment) {
+            const uint32_t a = ring * (segments + 1) + segment;
+            const uint32_t b = a + segments + 1;
+            indices.insert(indices.end(), {a, b, a + 1, a + 1, b, b + 1});
+        }
+    }
+}
+
+void buildCube(std::vector<glm::vec3>& positions, std::vector<uint32_t>& indices) {
+    // Four vertices per face so ColorMode::FACES can give every face its own color
+    const glm::vec3 normals[6] = {{0, 0, 1}, {0, 0, -1}, {-1, 0, 0}, {1, 0, 0}, {0, 1, 0}, {0, -1, 0}};
+    for (const glm::vec3& normal : normals) {
+        const glm::vec3 up = std::fabs(normal.y) > 0.5f ? glm::vec3(0, 0, 1) : glm::vec3(0, 1, 0);
+        const glm::vec3 side = glm::cross(up, normal);
+        const uint32_t base = static_cast<uint32_t>(positions.size());
+        positions.push_back(0.5f * (normal - side - up));
+        positions.push_back(0.5f * (normal + side - up));
+        positions.push_back(0.5f * (normal + side + up));
+        positions.push_back(0.5f * (normal - side + up));
+        indices.insert(indices.end(), {base, base + 1, base + 2, base + 2, base + 3, base});
+    }
+}
+
+/**
+ * Centers positions on their bounding box and scales them into the unit sphere
+ */
+void normalizePositions(std::vector<glm::vec3>& positions) {
+    glm::vec3 low(positions.front());
+    glm::vec3 high(positions.front());
+    for (const glm::vec3& position : positions) {
+        low = glm::min(low, position);
+        high = glm::max(high, position);
+    }
+    const glm::vec3 center = 0.5f * (low + high);
+    float radius = 0.0f;
+    for (const glm::vec3& position : positions) {
+        radius = std::max(radius, glm::length(position - center));
+    }
+    const float inverseRadius = radius > 0.0f ? 1.0f / radius : 1.0f;
+    for (glm::vec3& position : positions) {
+        position = (position - center) * inverseRadius;
+    }
+}
+
+/**
+ * Builds the base shape: unit-sized positions and triangle indices
+ */
+void buildShape(const Config& config, std::vector<glm::vec3>& positions, std::vector<uint32_t>& indices) {
+    switch (config.shape) {
+        case MeshShape::SPHERE:
+            buildSphere(config.detail, positions, indices);
+            break;
+        case MeshShape::CUBE:
+            buildCube(positions, indices);
+            break;
+        case MeshShape::CHARACTER: {
+            ObjLoader::OBJData objData;
+            if (!ObjLoader::parseOBJFile(CHARACTER_ASSET, objData)) {
+                throw std::runtime_error(std::string("Scene generator cannot load ") + CHARACTER_ASSET);
+            }
+            positions = std::move(objData.positions);
+            indices = std::move(objData.indices);
+            break;
+        }
+    }
+    normalizePositions(positions);
+}
+
+/**
+ * Makes variant `variant` of the base shape: its own proportions, so every
+ * unique mesh is a separate buffer with different data. Normals depend on
+ * the proportions and are generated per variant (which may add vertices).
+ */
+void buildVariant(const std::vector<glm::vec3>& basePositions, const std::vector<uint32_t>& baseIndices,
+                  uint32_t variant, std::vector<Vertex>& vertices, std::vector<uint32_t>& indices) {
+    const float stretch = 1.0f + 0.2f * static_cast<float>(variant % 4);
+    const glm::vec3 proportions = glm::vec3(1.0f, stretch, 1.0f) / stretch;
+
+    vertices.clear();
+    vertices.reserve(basePositions.size());
+    for (size_t i = 0; i < basePositions.size(); ++i) {
+        Vertex vertex{};
+        vertex.position = basePositions[i] * proportions;
+        vertex.texCoord = glm::vec2(0.5f + 0.5f * vertex.position.x, 0.5f + 0.5f * vertex.position.y);
+        vertices.push_back(vertex);
+    }
+
+    indices = baseIndices;
+    MeshProcessing::generateNormals(vertices, indices);
+    MeshProcessing::generateTangents(vertices, indices);
+}
+
+template <typename Enum, size_t N>
+bool parseName(const std::string& value, const char* const (&names)[N], Enum& result) {
+    for (size_t i = 0; i < N; ++i) {
+        if (value == names[i]) {
+            result = static_cast<Enum>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+template <typename T>
+bool parseNumber(const std::string& value, T& result) {
+    std::istringstream stream(value);
+    T parsed;
+    if (!(stream >> parsed) || !stream.eof()) {
+        return false;
+    }
+    result = parsed;
+    return true;
+}
+
+const char* const LAYOUT_NAMES[] = {"grid", "random"};
+const char* const SHAPE_NAMES[] = {"sphere", "cube", "character"};
+const char* const CAMERA_NAMES[] = {"orbit", "flythrough", "static", "script"};
+
+} // anonymous namespace
+
+bool parseSpec(const std::string& spec, Config& config, std::string& error) {
+    std::istringstream stream(spec);
+    std::string entry;
+    while (std::getline(stream, entry, ',')) {
+        if (entry.empty()) {
+            continue;
+        }
+        const size_t equals = entry.find('=');
+        if (equals == std::string::npos) {
+            error = "Scene spec entry '" + entry + "' is not key=value";
+            return false;
+        }
+        const std::string key = entry.substr(0, equals);
+        const std::string value = entry.substr(equals + 1);
+
+        bool valid = false;
+        if (key == "instances") {
+            valid = parseNumber(value, config.instances) && config.instances > 0;
+        } else if (key == "layout") {
+            valid = parseName(value, LAYOUT_NAMES, config.layout);
+        } else if (key == "mesh") {
+            valid = parseName(value, SHAPE_NAMES, config.shape);
+        } else if (key == "detail") {
+            valid = parseNumber(value, config.detail) && config.detail >= 2;
+        } else if (key == "meshes") {
+            valid = parseNumber(value, config.uniqueMeshes) && config.uniqueMeshes > 0;
+        } else if (key == "deforming") {
+            valid = parseNumber(value, config.deformingMeshes);
+        } else if (key == "materials") {
+            valid = parseNumber(value, config.materials) && config.materials > 0;
+        } else if (key == "dynamic") {
+            valid = parseNumber(value, config.dynamicFraction) &&
+                    config.dynamicFraction >= 0.0f && config.dynamicFraction <= 1.0f;
+        } else if (key == "spacing") {
+            valid = parseNumber(value, config.spacing) && config.spacing > 0.0f;
+        } else if (key == "seed") {
+            valid = parseNumber(value, config.seed);
+        } else if (key == "camera") {
+            valid = parseName(value, CAMERA_NAMES, config.camera);
+        } else {
+            error = "Unknown scene spec key '" + key + "'";
+            return false;
+        }
+
+        if (!valid) {
+            error = "Invalid scene spec value '" + entry + "'";
+            return false;
+        }
+    }
+    return true;
+}
+
+std::string describe(const Config& config) {
+    std::ostringstream out;
+    out << "instances=" << config.instances
+        << ",layout=" << LAYOUT_NAMES[static_cast<int>(config.layout)]
+        << ",mesh=" << SHAPE_NAMES[static_cast<int>(config.shape)]
+        << ",detail=" << config.detail
+        << ",meshes=" << config.uniqueMeshes
+        << ",deforming=" << std::min(config.deformingMeshes, config.uniqueMeshes)
+        << ",materials=" << config.materials
+        << ",dynamic=" << config.dynamicFraction
+        << ",spacing=" << config.spacing
+        << ",seed=" << config.seed
+        << ",camera=" << CAMERA_NAMES[static_cast<int>(config.camera)];
+    return out.str();
+}
+
+void generate(const Config& config, Scene& scene, RenderBackend& backend) {
+    PROFILE_ZONE("SceneGenerator::generate");
+    Random random(config.seed);
+
+    // Meshes
+    std::vector<glm::vec3> basePositions;
+    std::vector<uint32_t> baseIndices;
+    buildShape(config, basePositions, baseIndices);
+    std::vector<Vertex> vertices;
+    std::vector<uint32_t> indices;
+    std::vector<uint32_t> meshes;
+    for (uint32_t variant = 0; variant < config.uniqueMeshes; ++variant) {
+        buildVariant(basePositions, baseIndices, variant, vertices, indices);
+        // Each variant also gets its own color scheme (FACES is left to the fallback cube)
+        const auto colorMode = static_cast<ColorMode>(variant % static_cast<uint32_t>(ColorMode::FACES));
+        meshes.push_back(variant < config.deformingMeshes
+                             ? scene.addDeformingMesh(backend, vertices, indices, colorMode)
+                             : scene.addMesh(backend, vertices, indices, colorMode));
+    }
+
+    // Materials: evenly spread hues (a single material leaves vertex colors untouched)
+    std::vector<uint32_t> materials;
+    for (uint32_t material = 0; material < config.materials; ++material) {
+        const glm::vec3 tint = config.materials == 1 ? glm::vec3(1.0f)
+                                                     : hsvToRgb(material * 0.618034f, 0.45f, 1.0f);
+        materials.push_back(scene.addMaterial(glm::vec4(tint, 1.0f)));
+    }
+
+    // Objects: the random layout covers the same area as the grid
+    const uint32_t side = static_cast<uint32_t>(std::ceil(std::sqrt(static_cast<double>(config.instances))));
+    const float halfExtent = 0.5f * config.spacing * static_cast<float>(side - 1);
+    for (uint32_t i = 0; i < config.instances; ++i) {
+        SceneObject object;
+        if (config.layout == Layout::GRID) {
+            object.position = glm::vec3(config.spacing * static_cast<float>(i % side) - halfExtent, 0.0f,
+                                        config.spacing * static_cast<float>(i / side) - halfExtent);
+            object.mesh = meshes[i % config.uniqueMeshes];
+            object.material = materials[(i / config.uniqueMeshes) % config.materials];
+        } else {
+            object.position = glm::vec3(random.range(-halfExtent, halfExtent), 0.0f,
+                                        random.range(-halfExtent, halfExtent));
+            object.rotation.y = random.range(0.0f, 2.0f * PI);
+            object.scale = random.range(0.75f, 1.25f);
+            object.mesh = meshes[random.below(config.uniqueMeshes)];
+            object.material = materials[random.below(config.materials)];
+        }
+
+        // Exactly round(instances * fraction) dynamic objects, spread evenly through the scene
+        const float fraction = config.dynamicFraction;
+        object.dynamic = std::floor((i + 1) * fraction) > std::floor(i * fraction);
+        if (object.dynamic) {
+            object.angularVelocity = glm::vec3(0.0f, random.range(0.5f, 2.0f), 0.0f);
+        }
+        scene.addObject(object);
+    }
+
+    const Scene::Stats& stats = scene.getStats();
+    LOG_INFO("Generated scene: {} objects ({} dynamic), {} meshes ({} deforming), {} materials, {} triangles per frame",
+             "Scene", stats.objects, stats.dynamicObjects, stats.meshes, stats.deformingMeshes, stats.materials,
+             stats.trianglesPerFrame);
+}
+
+void generateCameraPath(const Config& config, const Scene& scene, BenchmarkScript& script) {
+    if (config.camera == CameraPath::SCRIPT) {
+        return;
+    }
+
+    script.cameraPath.clear();
+    script.inputs.clear();
+
+    const float radius = std::max(scene.getRadius(), 5.0f);
+    const uint64_t lastFrame = std::max<uint64_t>(script.getTotalFrames(), 1);
+    for (uint64_t frame = 0;; frame = std::min(frame + CAMERA_KEY_INTERVAL, lastFrame)) {
+        const float t = static_cast<float>(frame) / static_cast<float>(lastFrame);
+        glm::vec3 position;
+        glm::vec3 target;
+        switch (config.camera) {
+            case CameraPath::ORBIT: {
+                const float angle = 2.0f * PI * t;
+                position = glm::vec3(std::cos(angle), 0.5f, std::sin(angle)) * (radius * 1.2f);
+                target = glm::vec3(0.0f);
+                break;
+            }
+            case CameraPath::FLYTHROUGH: {
+                const glm::vec3 start(-radius * 0.7f, 2.0f, -radius * 0.7f);
+                const glm::vec3 end(radius * 0.7f, 2.0f, radius * 0.7f);
+                position = glm::mix(start, end, t);
+                target = position + glm::normalize(end - start) * 10.0f - glm::vec3(0.0f, 1.0f, 0.0f);
+                break;
+            }
+            default:
+                position = glm::vec3(radius, radius * 0.6f, radius);
+                target = glm::vec3(0.0f);
+                break;
+        }
+        script.addCameraKey(frame, position, target);
+        if (frame == lastFrame) {
+            break;
+        }
+    }
+}
+
+float getViewDistance(const Scene& scene) {
+    // The farthest camera (orbit at 1.2 radius, raised) sees the far edge at roughly 2.5 radii
+    return std::max(50.0f, scene.getRadius() * 3.0f);
+}
+
+} // namespace SceneGenerator
+} // namespace VulkanGameEngine
@@ -0,0 +1,222 @@
+#include "../headers/Skeleton.h"
+#include "../headers/AssetArchive.h"
+#include "../headers/Logger.h"
+#include <cstring>
+#include <fstream>
+
+namespace VulkanGameEngine {
+
+constexpr char Skeleton::MAGIC[8];
+
+namespace {
+
+template <typename T>
+void putValue(std::vector<char>& data, const T& value) {
+    const char* bytes = reinterpret_cast<const char*>(&value);
+    data.insert(data.end(), bytes, bytes + sizeof(T));
+}
+
+/**
+ * Bounds-checked reads; the first failure sticks, so callers check once at the end
+ */
+class Reader {
+public:
+    explicit Reader(const std::vector<char>& data) : m_data(data), m_offset(0), m_failed(false) {}
+
+    template <typename T>
+    T get() {
+        T value{};
+        if (canRead(sizeof(T))) {
+            std::memcpy(&value, m_data.data() + m_offset, sizeof(T));
+            m_offset += sizeof(T);
+        }
+        return value;
+    }
+
+    std::string getString(uint32_t length) {
+        if (!canRead(length)) {
+            return std::string();
+        }
+        std::string value(m_data.data() + m_offset, length);
+        m_offset += length;
+        return value;
+    }
+
+    bool failed() const { return m_failed; }
+    bool atEnd() const { return m_offset == m_data.size(); }
+
+private:
+    const std::vector<char>& m_data;
+    size_t m_offset;
+    bool m_failed;
+
+    bool canRead(uint64_t size) {
+        if (m_failed || size > m_data.size() - m_offset) {
+            m_failed = true;
+            return false;
+        }
+        return true;
+    }
+};
+
+} // anonymous namespace
+
+glm::mat4 JointTransform::toMatrix() const {
+    glm::mat4 matrix = glm::mat4_cast(rotation);
+    matrix[0] *= scale.x;
+    matrix[1] *= scale.y;
+    matrix[2] *= scale.z;
+    matrix[3] = glm::vec4(translation, 1.0f);
+    return matrix;
+}
+
+uint16_t Skeleton::addJoint(const std::string& name, uint16_t parent, const JointTransform& bindTransform) {
+    if (getJointCount() >= MAX_JOINTS) {
+        throw std::runtime_error("Skeleton has more than " + std::to_string(MAX_JOINTS) + " joints");
+    }
+    if (parent != NO_PARENT && parent >= getJointCount()) {
+        throw std::runtime_error("Parent of joint " + name + " does not exist yet");
+    }
+    jointNames.push_back(name);
+    parents.push_back(parent);
+    bindPose.push_back(bindTransform);
+    return static_cast<uint16_t>(parents.size() - 1);
+}
+
+void Skeleton::computeInverseBindMatrices() {
+    std::vector<glm::mat4> models(getJointCount());
+    inverseBindMatrices.resize(getJointCount());
+    for (uint32_t joint = 0; joint < getJointCount(); ++joint) {
+        const glm::mat4 local = bindPose[joint].toMatrix();
+        models[joint] = parents[joint] == NO_PARENT ? local : models[parents[joint]] * local;
+        inverseBindMatrices[joint] = glm::inverse(models[joint]);
+    }
+}
+
+bool Skeleton::validate(std::string& error) const {
+    const size_t count = parents.size();
+    if (count > MAX_JOINTS) {
+        error = "more than " + std::to_string(MAX_JOINTS) + " joints";
+        return false;
+    }
+    if (jointNames.size() != count || bindPose.size() != count || inverseBindMatrices.size() != count) {
+        error = "joint arrays differ in size";
+        return false;
+    }
+    for (size_t joint = 0; joint < count; ++joint) {
+        if (parents[joint] != NO_PARENT && parents[joint] >= joint) {
+            error = "joint " + jointNames[joint] + " comes before its parent";
+            return false;
+        }
+    }
+    return true;
+}
+
+int32_t Skeleton::findJoint(const std::string& name) const {
+    for (size_t joint = 0; joint < jointNames.size(); ++joint) {
+        if (jointNames[joint] == name) {
+            return static_cast<int32_t>(joint);
+        }
+    }
+    return -1;
+}
+
+void Skeleton::serialize(std::vector<char>& data) const {
+    data.insert(data.end(), MAGIC, MAGIC + sizeof(MAGIC));
+    putValue(data, VERSION);
+    putValue(data, getJointCount());
+    for (uint16_t parent : parents) {
+        putValue(data, parent);
+    }
+    for (const JointTransform& transform : bindPose) {
+        // Written component by component: glm's quaternion member order depends on its configuration
+        putValue(data, transform.rotation.x);
+        putValue(data, transform.rotation.y);
+        putValue(data, transform.rotation.z);
+        putValue(data, transform.rotation.w);
+        putValue(data, transform.translation);
+        putValue(data, transform.scale);
+    }
+    for (const glm::mat4& matrix : inverseBindMatrices) {
+        putValue(data, matrix);
+    }
+    for (const std::string& name : jointNames) {
+        putValue(data, static_cast<uint16_t>(name.size()));
+        data.insert(data.end(), name.begin(), name.end());
+    }
+}
+
+bool Skeleton::deserialize(const std::vector<char>& data, Skeleton& skeleton, std::string& error) {
+    Reader reader(data);
+    for (char expected : MAGIC) {
+        if (reader.get<char>() != expected) {
+            error = "not a skeleton";
+            return false;
+        }
+    }
+    const uint32_t version = reader.get<uint32_t>();
+    if (version != VERSION) {
+        error = "unsupported skeleton version " + std::to_string(version);
+        return false;
+    }
+    const uint32_t jointCount = reader.get<uint32_t>();
+    if (jointCount > MAX_JOINTS) {
+        error = "more than " + std::to_string(MAX_JOINTS) + " joints";
+        return false;
+    }
+
+    skeleton = Skeleton();
+    skeleton.parents.resize(jointCount);
+    skeleton.bindPose.resize(jointCount);
+    skeleton.inverseBindMatrices.resize(jointCount);
+    skeleton.jointNames.resize(jointCount);
+    for (uint16_t& parent : skeleton.parents) {
+        parent = reader.get<uint16_t>();
+    }
+    for (JointTransform& transform : skeleton.bindPose) {
+        transform.rotation.x = reader.get<float>();
+        transform.rotation.y = reader.get<float>();
+        transform.rotation.z = reader.get<float>();
+        transform.rotation.w = reader.get<float>();
+        transform.translation = reader.get<glm::vec3>();
+        transform.scale = reader.get<glm::vec3>();
+    }
+    for (glm::mat4& matrix : skeleton.inverseBindMatrices) {
+        matrix = reader.get<glm::mat4>();
+    }
+    for (std::string& name : skeleton.jointNames) {
+        name = reader.getString(reader.get<uint16_t>());
+    }
+    if (reader.failed() || !reader.atEnd()) {
+        error = "truncated or oversized skeleton";
+        return false;
+    }
+    return skeleton.validate(error);
+}
+
+bool Skeleton::save(const std::string& path) const {
+    std::vector<char> data;
+    serialize(data);
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(data.data(), static_cast<std::streamsize>(data.size()));
+    if (!file) {
+        LOG_ERROR("Cannot write skeleton " + path, "Skeleton");
+        return false;
+    }
+    return true;
+}
+
+bool Skeleton::load(const std::string& path, Skeleton& skeleton, std::string& error) {
+    std::vector<char> data;
+    if (!AssetFileSystem::getInstance().readFile(path, data)) {
+        error = "Cannot open skeleton " + path;
+        return false;
+    }
+    if (!deserialize(data, skeleton, error)) {
+        error = path + ": " + error;
+        return false;
+    }
+    return true;
+}
+
+} // namespace VulkanGameEngine
@@ -0,0 +1,182 @@
+#include "../headers/StartupGraph.h"
+#include "../headers/ThreadPool.h"
+#include "../headers/Logger.h"
+#include "../headers/Profiler.h"
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+
+namespace VulkanGameEngine {
+
+StartupGraph::PhaseId StartupGraph::add(const char* name, std::function<void()> work,
+                                        std::vector<PhaseId> dependencies, Affinity affinity) {
+    const PhaseId id = static_cast<PhaseId>(m_phases.size());
+    for (PhaseId dependency : dependencies) {
+        if (dependency >= id) {
+            throw std::runtime_error(std::string("Startup phase ") + name + " depends on a phase added after it");
+        }
+    }
+
+    Phase phase;
+    phase.name = name;
+    phase.work = std::move(work);
+    phase.dependencies = std::move(dependencies);
+    phase.affinity = affinity;
+    m_phases.push_back(std::move(phase));
+    return id;
+}
+
+void StartupGraph::run(ThreadPool& pool) {
+    PROFILE_ZONE("Startup");
+
+    const size_t count = m_phases.size();
+    std::vector<size_t> waitingOn(count);
+    std::vector<std::vector<PhaseId>> dependents(count);
+    for (PhaseId id = 0; id < count; ++id) {
+        waitingOn[id] = m_phases[id].dependencies.size();
+        for (PhaseId dependency : m_phases[id].dependencies) {
+            dependents[dependency].push_back(id);
+        }
+    }
+
+    // Shared with the pool; everything below outlives the phases because run() waits for them
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::deque<PhaseId> mainThreadReady;
+    size_t inFlight = 0;
+    std::exception_ptr error;
+
+    auto execute = [this](PhaseId id) {
+        Phase& phase = m_phases[id];
+        phase.thread = std::this_thread::get_id();
+        phase.startNs = Profiler::now();
+        std::exception_ptr phaseError;
+        try {
+            ProfileZone zone(phase.name);
+            phase.work();
+        } catch (...) {
+            phaseError = std::current_exception();
+        }
+        phase.endNs = Profiler::now();
+        phase.ran = true;
+        return phaseError;
+    };
+
+    // Both called with the mutex held
+    std::function<void(PhaseId)> schedule;
+    auto finish = [&](PhaseId id, std::exception_ptr phaseError) {
+        if (phaseError) {
+            LOG_ERROR("Startup phase {} failed", "Startup", m_phases[id].name);
+            if (!error) {
+                error = phaseError;
+            }
+            mainThreadReady.clear();
+        } else if (!error) {
+            for (PhaseId dependent : dependents[id]) {
+                if (--waitingOn[dependent] == 0) {
+                    schedule(dependent);
+                }
+            }
+        }
+    };
+    schedule = [&](PhaseId id) {
+        if (m_phases[id].affinity == Affinity::MAIN_THREAD) {
+            mainThreadReady.push_back(id);
+            changed.notify_all();
+            return;
+        }
+        inFlight++;
+        pool.submit([&, id] {
+            std::exception_ptr phaseError = execute(id);
+            std::lock_guard<std::mutex> lock(mutex);
+            inFlight--;
+            finish(id, phaseError);
+            changed.notify_all();
+        });
+    };
+
+    m_mainThread = std::this_thread::get_id();
+    m_startNs = Profiler::now();
+    std::unique_lock<std::mutex> lock(mutex);
+    for (PhaseId id = 0; id < count; ++id) {
+        if (waitingOn[id] == 0) {
+            schedule(id);
+        }
+    }
+
+    for (;;) {
+        changed.wait(lock, [&] { return !mainThreadReady.empty() || inFlight == 0; });
+        if (mainThreadReady.empty()) {
+            break;      // Nothing running and nothing left to start
+        }
+
+        const PhaseId id = mainThreadReady.front();
+        mainThreadReady.pop_front();
+        lock.unlock();
+        std::exception_ptr phaseError = execute(id);
+        lock.lock();
+        finish(id, phaseError);
+    }
+    m_endNs = Profiler::now();
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+int64_t StartupGraph::getCriticalPathNs() const {
+    // Dependencies always come first, so one pass in order finds each phase's longest chain
+    std::vector<int64_t> chainEnd(m_phases.size(), 0);
+    int64_t longest = 0;
+    for (size_t i = 0; i < m_phases.size(); ++i) {
+        const Phase& phase = m_phases[i];
+        int64_t start = 0;
+        for (PhaseId dependency : phase.dependencies) {
+            start = std::max(start, chainEnd[dependency]);
+        }
+        chainEnd[i] = start + (phase.ran ? phase.endNs - phase.startNs : 0);
+        longest = std::max(longest, chainEnd[i]);
+    }
+    return longest;
+}
+
+std::vector<std::thread::id> StartupGraph::getThreads() const {
+    std::vector<std::thread::id> threads;
+    threads.push_back(m_mainThread);
+    for (const Phase& phase : m_phases) {
+        if (phase.ran && std::find(threads.begin(), threads.end(), phase.thread) == threads.end()) {
+            threads.push_back(phase.thread);
+        }
+    }
+    return threads;
+}
+
+void StartupGraph::logSummary() const {
+    std::vector<const Phase*> byStart;
+    int64_t phaseTotal = 0;
+    for (const Phase& phase : m_phases) {
+        if (phase.ran) {
+            byStart.push_back(&phase);
+            phaseTotal += phase.endNs - phase.startNs;
+        }
+    }
+    std::sort(byStart.begin(), byStart.end(), [](const Phase* a, const Phase* b) {
+        return a->startNs < b->startNs;
+    });
+
+    const std::vector<std::thread::id> threads = getThreads();
+    LOG_INFO("Startup timeline:", "Startup");
+    for (const Phase* phase : byStart) {
+        const size_t thread = static_cast<size_t>(std::find(threads.begin(), threads.end(), phase->thread) - threads.begin());
+        LOG_INFO("  {} at {:.2f}ms for {:.2f}ms on {}", "Startup", phase->name,
+                 (phase->startNs - m_startNs) / 1e6, (phase->endNs - phase->startNs) / 1e6,
+                 thread == 0 ? std::string("main") : "worker " + std::to_string(thread));
+    }
+    LOG_INFO("Startup took {:.2f}ms ({:.2f}ms of phases, critical path {:.2f}ms)", "Startup",
+             getWallTimeNs() / 1e6, phaseTotal / 1e6, getCriticalPathNs() / 1e6);
+}
+
+} // namespace VulkanGameEngine
@@ -0,0 +1,152 @@
+#include "../headers/ThreadPool.h"
+#include "../headers/Logger.h"
+#include "../headers/Profiler.h"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+
+namespace VulkanGameEngine {
+
+namespace {
+
+/**
+ * State of one parallelFor call, shared with the helper tasks (which may
+ * start after the call has already returned)
+ */
+struct ParallelForState {
+    std::function<void(size_t, size_t)> body;
+    size_t count = 0;
+    size_t grainSize = 1;
+    size_t chunkCount = 0;
+    std::atomic<size_t> nextChunk{0};
+    std::atomic<bool> failed{false};
+
+    std::mutex mutex;
+    std::condition_variable done;
+    size_t completedChunks = 0;             // Guarded by mutex
+    std::exception_ptr error;               // First failure, guarded by mutex
+
+    /**
+     * Takes chunks until none are left; returns when this thread has no more work
+     */
+    void work() {
+        for (;;) {
+            const size_t chunk = nextChunk.fetch_add(1, std::memory_order_relaxed);
+            if (chunk >= chunkCount) {
+                return;
+            }
+
+            std::exception_ptr chunkError;
+            if (!failed.load(std::memory_order_relaxed)) {
+                const size_t begin = chunk * grainSize;
+                try {
+                    body(begin, std::min(begin + grainSize, count));
+                } catch (...) {
+                    chunkError = std::current_exception();
+                    failed.store(true, std::memory_order_relaxed);
+                }
+            }
+
+            std::lock_guard<std::mutex> lock(mutex);
+            if (chunkError && !error) {
+                error = chunkError;
+            }
+            if (++completedChunks == chunkCount) {
+                done.notify_all();
+            }
+        }
+    }
+};
+
+} // anonymous namespace
+
+ThreadPool& ThreadPool::getInstance() {
+    static ThreadPool instance(std::max(1u, std::thread::hardware_concurrency()) - 1);
+    return instance;
+}
+
+ThreadPool::ThreadPool(uint32_t threadCount)
+    : m_stopping(false) {
+    threadCount = std::max(threadCount, 1u);
+    m_workers.reserve(threadCount);
+    for (uint32_t i = 0; i < threadCount; ++i) {
+        m_workers.emplace_back(&ThreadPool::workerMain, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wakeup.notify_all();
+    for (std::thread& worker : m_workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::submit(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_tasks.push_back(std::move(task));
+    }
+    m_wakeup.notify_one();
+}
+
+void ThreadPool::parallelFor(size_t count, size_t grainSize,
+                             const std::function<void(size_t begin, size_t end)>& body) {
+    if (count == 0) {
+        return;
+    }
+    const size_t threads = m_workers.size() + 1;
+    if (grainSize == 0) {
+        grainSize = (count + threads - 1) / threads;
+    }
+
+    auto state = std::make_shared<ParallelForState>();
+    state->body = body;
+    state->count = count;
+    state->grainSize = grainSize;
+    state->chunkCount = (count + grainSize - 1) / grainSize;
+
+    // One helper per extra chunk at most; each keeps taking chunks until they run out
+    const size_t helpers = std::min(m_workers.size(), state->chunkCount - 1);
+    for (size_t i = 0; i < helpers; ++i) {
+        submit([state] { state->work(); });
+    }
+    state->work();
+
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->done.wait(lock, [&state] { return state->completedChunks == state->chunkCount; });
+    if (state->error) {
+        std::rethrow_exception(state->error);
+    }
+}
+
+void ThreadPool::workerMain(uint32_t index) {
+    Profiler::getInstance().setThreadName("Worker " + std::to_string(index));
+
+    for (;;) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wakeup.wait(lock, [this] { return m_stopping || !m_tasks.empty(); });
+            if (m_tasks.empty()) {
+                return;     // Stopping and drained
+            }
+            task = std::move(m_tasks.front());
+            m_tasks.pop_front();
+        }
+
+        try {
+            task();
+        } catch (const std::exception& e) {
+            LOG_ERROR("Unhandled exception in worker task: " + std::string(e.what()), "ThreadPool");
+        } catch (...) {
+            LOG_ERROR("Unhandled unknown exception in worker task", "ThreadPool");
+        }
+    }
+}
+
+} // namespace VulkanGameEngine
@@ -1,9 +1,25 @@
 #include "../headers/VulkanBuffer.h"
 #include "../headers/VulkanUtils.h"
+#include "../headers/Metrics.h"
+#include "../headers/VulkanCallStats.h"
+#include <atomic>
 #include <cstring>
 
 namespace VulkanGameEngine {
 
+namespace {
+
+// Bytes held by live buffers, published as the "gpu.buffer_bytes" gauge
+std::atomic<uint64_t> g_bufferBytes{0};
+
+void trackBufferBytes(VkDeviceSize size, bool allocated) {
+    static MetricGauge& bufferBytes = MetricsRegistry::getInstance().gauge("gpu.buffer_bytes");
+    const uint64_t total = allocated ? g_bufferBytes.fetch_add(size) + size : g_bufferBytes.fetch_sub(size) - size;
+    bufferBytes.set(static_cast<double>(total));
+}
+
+} // anonymous namespace
+
 VulkanBuffer::VulkanBuffer() 
     : m_device(VK_NULL_HANDLE)
     , m_buffer(VK_NULL_HANDLE)
@@ -92,7 +108,7 @@ void VulkanBuffer::create(VkDevice device, VkPhysicalDevice physicalDevice, VkDe
     // CONCURRENT: Buffer can be accessed by multiple queue families simultaneously
     bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
     
-    VK_CHECK(vkCreateBuffer(device, &bufferInfo, nullptr, &m_buffer),
+    VK_CHECK(VK_TRACKED(CreateBuffer, vkCreateBuffer(device, &bufferInfo, nullptr, &m_buffer)),
              "Failed to create buffer");
     
     // Step 2: Query memory requirements for the buffer
@@ -120,13 +136,14 @@ void VulkanBuffer::create(VkDevice device, VkPhysicalDevice physicalDevice, VkDe
     allocInfo.allocationSize = memRequirements.size;
     allocInfo.memoryTypeIndex = memoryTypeIndex;
     
-    VK_CHECK(vkAllocateMemory(device, &allocInfo, nullptr, &m_memory),
+    VK_CHECK(VK_TRACKED(AllocateMemory, vkAllocateMemory(device, &allocInfo, nullptr, &m_memory)),
              "Failed to allocate buffer memory");
     
     // Step 5: Bind the allocated memory to the buffer
     // The offset must be divisible by memRequirements.alignment
     VK_CHECK(vkBindBufferMemory(device, m_buffer, m_memory, 0),
              "Failed to bind buffer memory");
+    trackBufferBytes(m_size, true);
     
     std::cout << "Successfully created buffer with " 
               << (m_isCoherent ? "coherent" : "non-coherent") << " memory\n";
@@ -156,7 +173,7 @@ void* VulkanBuffer::map(VkDeviceSize offset, VkDeviceSize size) {
         throw std::runtime_error("Cannot map non-host-visible memory");
     }
     
-    VK_CHECK(vkMapMemory(m_device, m_memory, offset, size, 0, &m_mappedMemory),
+    VK_CHECK(VK_TRACKED(MapMemory, vkMapMemory(m_device, m_memory, offset, size, 0, &m_mappedMemory)),
              "Failed to map buffer memory");
     
     return m_mappedMemory;
@@ -164,7 +181,7 @@ void* VulkanBuffer::map(VkDeviceSize offset, VkDeviceSize size) {
 
 void VulkanBuffer::unmap() {
     if (m_mappedMemory != nullptr) {
-        vkUnmapMemory(m_device, m_memory);
+        VK_TRACKED(UnmapMemory, vkUnmapMemory(m_device, m_memory));
         m_mappedMemory = nullptr;
     }
 }
@@ -178,6 +195,9 @@ void VulkanBuffer::uploadData(const void* data, VkDeviceSize size, VkDeviceSize
     void* mappedData = map(offset, size);
     std::memcpy(mappedData, data, static_cast<size_t>(size));
     
+    static MetricCounter& uploadBytes = MetricsRegistry::getInstance().counter("gpu.upload_bytes");
+    uploadBytes.add(size);
+    
     // For non-coherent memory, we need to flush to make CPU writes visible to GPU
     if (!m_isCoherent) {
         flush(offset, size);
@@ -199,7 +219,7 @@ void VulkanBuffer::copyTo(VkDevice device, VkCommandPool commandPool, VkQueue gr
     copyRegion.dstOffset = dstOffset;
     copyRegion.size = size;
     
-    vkCmdCopyBuffer(commandBuffer, m_buffer, dstBuffer.getBuffer(), 1, &copyRegion);
+    VK_TRACKED(CmdCopyBuffer, vkCmdCopyBuffer(commandBuffer, m_buffer, dstBuffer.getBuffer(), 1, &copyRegion));
     
     // Submit and wait for completion
     endSingleTimeCommands(device, commandPool, commandBuffer, graphicsQueue);
@@ -216,7 +236,7 @@ void VulkanBuffer::flush(VkDeviceSize offset, VkDeviceSize size) {
     mappedRange.offset = offset;
     mappedRange.size = size;
     
-    VK_CHECK(vkFlushMappedMemoryRanges(m_device, 1, &mappedRange),
+    VK_CHECK(VK_TRACKED(FlushMappedMemoryRanges, vkFlushMappedMemoryRanges(m_device, 1, &mappedRange)),
              "Failed to flush mapped memory range");
 }
 
@@ -231,7 +251,7 @@ void VulkanBuffer::invalidate(VkDeviceSize offset, VkDeviceSize size) {
     mappedRange.offset = offset;
     mappedRange.size = size;
     
-    VK_CHECK(vkInvalidateMappedMemoryRanges(m_device, 1, &mappedRange),
+    VK_CHECK(VK_TRACKED(InvalidateMappedMemoryRanges, vkInvalidateMappedMemoryRanges(m_device, 1, &mappedRange)),
              "Failed to invalidate mapped memory range");
 }
 
@@ -242,14 +262,15 @@ void VulkanBuffer::cleanup() {
         
         // Destroy buffer and free memory
         if (m_buffer != VK_NULL_HANDLE) {
-            vkDestroyBuffer(m_device, m_buffer, nullptr);
+            VK_TRACKED(DestroyBuffer, vkDestroyBuffer(m_device, m_buffer, nullptr));
             m_buffer = VK_NULL_HANDLE;
             VulkanUtils::logObjectDestruction("VkBuffer");
         }
         
         if (m_memory != VK_NULL_HANDLE) {
-            vkFreeMemory(m_device, m_memory, nullptr);
+            VK_TRACKED(FreeMemory, vkFreeMemory(m_device, m_memory, nullptr));
             m_memory = VK_NULL_HANDLE;
+            trackBufferBytes(m_size, false);
             VulkanUtils::logObjectDestruction("VkDeviceMemory");
         }
         
@@ -266,13 +287,13 @@ VkMemoryRequirements VulkanBuffer::getMemoryRequirements(VkDevice device, VkDevi
     bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
     
     VkBuffer tempBuffer;
-    VK_CHECK(vkCreateBuffer(device, &bufferInfo, nullptr, &tempBuffer),
+    VK_CHECK(VK_TRACKED(CreateBuffer, vkCreateBuffer(device, &bufferInfo, nullptr, &tempBuffer)),
              "Failed to create temporary buffer for memory requirements query");
     
     VkMemoryRequirements memRequirements;
     vkGetBufferMemoryRequirements(device, tempBuffer, &memRequirements);
     
-    vkDestroyBuffer(device, tempBuffer, nullptr);
+    VK_TRACKED(DestroyBuffer, vkDestroyBuffer(device, tempBuffer, nullptr));
     
     return memRequirements;
 }
@@ -291,6 +312,9 @@ VkBufferUsageFlags VulkanBuffer::getVulkanUsageFlags(Usage usage) const {
         case Usage::STAGING_BUFFER:
             return VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
         
+        case Usage::READBACK_BUFFER:
+            return VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+        
         case Usage::STORAGE_BUFFER:
             return VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
         
@@ -358,7 +382,7 @@ VkCommandBuffer VulkanBuffer::beginSingleTimeCommands(VkDevice device, VkCommand
     allocInfo.commandBufferCount = 1;
     
     VkCommandBuffer commandBuffer;
-    VK_CHECK(vkAllocateCommandBuffers(device, &allocInfo, &commandBuffer),
+    VK_CHECK(VK_TRACKED(AllocateCommandBuffers, vkAllocateCommandBuffers(device, &allocInfo, &commandBuffer)),
              "Failed to allocate single-time command buffer");
     
     // Begin recording
@@ -366,7 +390,7 @@ VkCommandBuffer VulkanBuffer::beginSingleTimeCommands(VkDevice device, VkCommand
     beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
     beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT; // This command buffer will be submitted once
     
-    VK_CHECK(vkBeginCommandBuffer(commandBuffer, &beginInfo),
+    VK_CHECK(VK_TRACKED(BeginCommandBuffer, vkBeginCommandBuffer(commandBuffer, &beginInfo)),
              "Failed to begin recording single-time command buffer");
     
     return commandBuffer;
@@ -376,7 +400,7 @@ void VulkanBuffer::endSingleTimeCommands(VkDevice device, VkCommandPool commandP
                                         VkCommandBuffer commandBuffer, VkQueue queue) const {
     
     // End recording
-    VK_CHECK(vkEndCommandBuffer(commandBuffer),
+    VK_CHECK(VK_TRACKED(EndCommandBuffer, vkEndCommandBuffer(commandBuffer)),
              "Failed to end recording single-time command buffer");
     
     // Submit to queue
@@ -385,15 +409,15 @@ void VulkanBuffer::endSingleTimeCommands(VkDevice device, VkCommandPool commandP
     submitInfo.commandBufferCount = 1;
     submitInfo.pCommandBuffers = &commandBuffer;
     
-    VK_CHECK(vkQueueSubmit(queue, 1, &submitInfo, VK_NULL_HANDLE),
+    VK_CHECK(VK_TRACKED(QueueSubmit, vkQueueSubmit(queue, 1, &submitInfo, VK_NULL_HANDLE)),
              "Failed to submit single-time command buffer");
     
     // Wait for completion
-    VK_CHECK(vkQueueWaitIdle(queue),
+    VK_CHECK(VK_TRACKED(QueueWaitIdle, vkQueueWaitIdle(queue)),
              "Failed to wait for queue idle after single-time command");
     
     // Clean up the temporary command buffer
-    vkFreeCommandBuffers(device, commandPool, 1, &commandBuffer);
+    VK_TRACKED(FreeCommandBuffers, vkFreeCommandBuffers(device, commandPool, 1, &commandBuffer));
 }
 
 // Utility functions implementation
@@ -459,6 +483,29 @@ VulkanBuffer createIndexBuffer(VkDevice device, VkPhysicalDevice physicalDevice,
     return indexBuffer;
 }
 
+VulkanBuffer createDeviceLocalBuffer(VkDevice device, VkPhysicalDevice physicalDevice,
+                                    VkCommandPool commandPool, VkQueue graphicsQueue,
+                                    const void* data, VkDeviceSize size, VulkanBuffer::Usage usage) {
+    
+    // Create staging buffer
+    VulkanBuffer stagingBuffer;
+    stagingBuffer.createWithData(device, physicalDevice, data, size,
+                                VulkanBuffer::Usage::STAGING_BUFFER,
+                                VulkanBuffer::MemoryProperty::STAGING);
+    
+    // Create device-local destination buffer
+    VulkanBuffer buffer;
+    buffer.create(device, physicalDevice, size, usage, VulkanBuffer::MemoryProperty::DEVICE_LOCAL);
+    
+    // Copy data from staging buffer to the destination
+    stagingBuffer.copyTo(device, commandPool, graphicsQueue, buffer, size);
+    
+    // Clean up staging buffer
+    stagingBuffer.cleanup();
+    
+    return buffer;
+}
+
 VulkanBuffer createUniformBuffer(VkDevice device, VkPhysicalDevice physicalDevice) {
     VulkanBuffer uniformBuffer;
     uniformBuffer.create(device, physicalDevice, sizeof(UniformBufferObject),
@@ -0,0 +1,209 @@
+#include "../headers/VulkanCallStats.h"
+#include "../headers/Metrics.h"
+#include "../headers/Logger.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+namespace VulkanGameEngine {
+
+namespace {
+
+constexpr uint32_t CALL_COUNT = static_cast<uint32_t>(VulkanCall::COUNT);
+
+const char* const CALL_NAMES[CALL_COUNT] = {
+    "vkCmdBeginRenderPass",
+    "vkCmdEndRenderPass",
+    "vkCmdBindPipeline",
+    "vkCmdBindVertexBuffers",
+    "vkCmdBindIndexBuffer",
+    "vkCmdBindDescriptorSets",
+    "vkCmdPushConstants",
+    "vkCmdSetViewport",
+    "vkCmdSetScissor",
+    "vkCmdDraw",
+    "vkCmdDrawIndexed",
+    "vkCmdPipelineBarrier",
+    "vkCmdCopyBuffer",
+    "vkCmdCopyImageToBuffer",
+    "vkCmdWriteTimestamp",
+    "vkCmdResetQueryPool",
+    "vkCmdBeginQuery",
+    "vkCmdEndQuery",
+    "vkBeginCommandBuffer",
+    "vkEndCommandBuffer",
+    "vkResetCommandBuffer",
+    "vkQueueSubmit",
+    "vkQueuePresentKHR",
+    "vkAcquireNextImageKHR",
+    "vkWaitForFences",
+    "vkResetFences",
+    "vkGetQueryPoolResults",
+    "vkQueueWaitIdle",
+    "vkDeviceWaitIdle",
+    "vkMapMemory",
+    "vkUnmapMemory",
+    "vkFlushMappedMemoryRanges",
+    "vkInvalidateMappedMemoryRanges",
+    "vkUpdateDescriptorSets",
+    "vkAllocateMemory",
+    "vkFreeMemory",
+    "vkCreateBuffer",
+    "vkDestroyBuffer",
+    "vkAllocateCommandBuffers",
+    "vkFreeCommandBuffers",
+};
+
+std::atomic<uint64_t> g_calls[CALL_COUNT];
+std::atomic<uint64_t> g_timeNs[CALL_COUNT];
+std::atomic<uint64_t> g_hazards[CALL_COUNT];
+std::atomic<bool> g_abortOnHazard{false};
+
+thread_local uint32_t t_frameDepth = 0;
+
+// Snapshot of the totals at the previous endFrame() (main thread only)
+uint64_t g_lastCalls[CALL_COUNT];
+uint64_t g_lastTimeNs[CALL_COUNT];
+uint64_t g_lastHazards[CALL_COUNT];
+bool g_hazardReported[CALL_COUNT];
+
+VulkanCallStats::FrameCounts g_lastFrame;
+
+int64_t nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+} // anonymous namespace
+
+const char* VulkanCallStats::getName(VulkanCall call) {
+    const uint32_t index = static_cast<uint32_t>(call);
+    return index < CALL_COUNT ? CALL_NAMES[index] : "unknown";
+}
+
+bool VulkanCallStats::isFrameHazard(VulkanCall call) {
+    switch (call) {
+        case VulkanCall::QueueWaitIdle:
+        case VulkanCall::DeviceWaitIdle:
+        case VulkanCall::AllocateMemory:
+        case VulkanCall::FreeMemory:
+        case VulkanCall::CreateBuffer:
+        case VulkanCall::DestroyBuffer:
+        case VulkanCall::AllocateCommandBuffers:
+        case VulkanCall::FreeCommandBuffers:
+            return true;
+        default:
+            return false;
+    }
+}
+
+void VulkanCallStats::record(VulkanCall call, int64_t durationNs) {
+    const uint32_t index = static_cast<uint32_t>(call);
+    g_calls[index].fetch_add(1, std::memory_order_relaxed);
+    g_timeNs[index].fetch_add(durationNs > 0 ? static_cast<uint64_t>(durationNs) : 0, std::memory_order_relaxed);
+
+    if (t_frameDepth > 0 && isFrameHazard(call)) {
+        g_hazards[index].fetch_add(1, std::memory_order_relaxed);
+        if (g_abortOnHazard.load(std::memory_order_relaxed)) {
+            std::fprintf(stderr, "%s called inside the frame loop\n", CALL_NAMES[index]);
+            std::abort();
+        }
+    }
+}
+
+void VulkanCallStats::beginFrameScope() {
+    t_frameDepth++;
+}
+
+void VulkanCallStats::endFrameScope() {
+    if (t_frameDepth > 0) {
+        t_frameDepth--;
+    }
+}
+
+uint32_t VulkanCallStats::suspendFrameScope() {
+    const uint32_t depth = t_frameDepth;
+    t_frameDepth = 0;
+    return depth;
+}
+
+void VulkanCallStats::resumeFrameScope(uint32_t depth) {
+    t_frameDepth = depth;
+}
+
+void VulkanCallStats::setAbortOnHazard(bool abortOnHazard) {
+    g_abortOnHazard.store(abortOnHazard, std::memory_order_relaxed);
+}
+
+void VulkanCallStats::endFrame() {
+    MetricsRegistry& metrics = MetricsRegistry::getInstance();
+    static MetricCounter& callCounter = metrics.counter("vk.calls");
+    static MetricCounter& timeCounter = metrics.counter("vk.cpu_us");
+    static MetricCounter& hazardCounter = metrics.counter("vk.hazards");
+    static MetricCounter* perCallCounters[CALL_COUNT] = {};
+    if (!perCallCounters[0]) {
+        for (uint32_t i = 0; i < CALL_COUNT; ++i) {
+            perCallCounters[i] = &metrics.counter(std::string("vk.") + CALL_NAMES[i]);
+        }
+    }
+
+    FrameCounts& frame = g_lastFrame;
+    frame.totalCalls = 0;
+    frame.totalTimeNs = 0;
+    frame.hazards = 0;
+
+    for (uint32_t i = 0; i < CALL_COUNT; ++i) {
+        const uint64_t calls = g_calls[i].load(std::memory_order_relaxed);
+        const uint64_t timeNs = g_timeNs[i].load(std::memory_order_relaxed);
+        const uint64_t hazards = g_hazards[i].load(std::memory_order_relaxed);
+
+        frame.calls[i] = static_cast<uint32_t>(calls - g_lastCalls[i]);
+        frame.timeNs[i] = timeNs - g_lastTimeNs[i];
+        const uint32_t frameHazards = static_cast<uint32_t>(hazards - g_lastHazards[i]);
+
+        g_lastCalls[i] = calls;
+        g_lastTimeNs[i] = timeNs;
+        g_lastHazards[i] = hazards;
+
+        frame.totalCalls += frame.calls[i];
+        frame.totalTimeNs += frame.timeNs[i];
+        frame.hazards += frameHazards;
+        if (frame.calls[i] > 0) {
+            perCallCounters[i]->add(frame.calls[i]);
+        }
+
+        // Warn once per entry point; the counters keep counting afterwards
+        if (frameHazards > 0 && !g_hazardReported[i]) {
+            g_hazardReported[i] = true;
+            LOG_WARN("{} called {}x inside the frame loop ({:.3f}ms); it stalls or allocates and belongs outside the hot path",
+                     "VulkanCalls", CALL_NAMES[i], frameHazards, frame.timeNs[i] / 1e6);
+        }
+    }
+
+    frame.drawCalls = frame.calls[static_cast<uint32_t>(VulkanCall::CmdDraw)] +
+                      frame.calls[static_cast<uint32_t>(VulkanCall::CmdDrawIndexed)];
+
+    static uint64_t pendingTimeNs = 0;   // Sub-microsecond remainder carried to the next frame
+    pendingTimeNs += frame.totalTimeNs;
+    callCounter.add(frame.totalCalls);
+    timeCounter.add(pendingTimeNs / 1000);
+    pendingTimeNs %= 1000;
+    hazardCounter.add(frame.hazards);
+}
+
+const VulkanCallStats::FrameCounts& VulkanCallStats::getLastFrame() {
+    return g_lastFrame;
+}
+
+VulkanCallScope::VulkanCallScope(VulkanCall call)
+    : m_call(call)
+    , m_start(nowNs()) {
+}
+
+VulkanCallScope::~VulkanCallScope() {
+    VulkanCallStats::record(m_call, nowNs() - m_start);
+}
+
+} // namespace VulkanGameEngine
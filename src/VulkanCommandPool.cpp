@@ -1,5 +1,6 @@
 #include "../headers/VulkanCommandPool.h"
 #include "../headers/VulkanUtils.h"
+#include "../headers/VulkanCallStats.h"
 
 namespace VulkanGameEngine {
 
@@ -75,7 +76,7 @@ std::vector<VkCommandBuffer> VulkanCommandPool::allocateCommandBuffers(uint32_t
     
     // Allocate the command buffers
     std::vector<VkCommandBuffer> commandBuffers(count);
-    VK_CHECK(vkAllocateCommandBuffers(m_device, &allocInfo, commandBuffers.data()),
+    VK_CHECK(VK_TRACKED(AllocateCommandBuffers, vkAllocateCommandBuffers(m_device, &allocInfo, commandBuffers.data())),
              "Failed to allocate command buffers");
     
     // Track allocated buffers for cleanup
@@ -102,9 +103,9 @@ void VulkanCommandPool::freeCommandBuffers(const std::vector<VkCommandBuffer>& c
         "Freeing " + std::to_string(commandBuffers.size()) + " command buffers");
     
     // Free the command buffers
-    vkFreeCommandBuffers(m_device, m_commandPool, 
-                        static_cast<uint32_t>(commandBuffers.size()), 
-                        commandBuffers.data());
+    VK_TRACKED(FreeCommandBuffers, vkFreeCommandBuffers(m_device, m_commandPool, 
+                                                       static_cast<uint32_t>(commandBuffers.size()), 
+                                                       commandBuffers.data()));
     
     // Remove from tracking list
     for (const auto& buffer : commandBuffers) {
@@ -147,12 +148,12 @@ void VulkanCommandPool::beginCommandBuffer(VkCommandBuffer commandBuffer, Usage
     beginInfo.flags = getVulkanUsageFlags(usage);
     beginInfo.pInheritanceInfo = inheritanceInfo; // Only used for secondary command buffers
     
-    VK_CHECK(vkBeginCommandBuffer(commandBuffer, &beginInfo),
+    VK_CHECK(VK_TRACKED(BeginCommandBuffer, vkBeginCommandBuffer(commandBuffer, &beginInfo)),
              "Failed to begin recording command buffer");
 }
 
 void VulkanCommandPool::endCommandBuffer(VkCommandBuffer commandBuffer) {
-    VK_CHECK(vkEndCommandBuffer(commandBuffer),
+    VK_CHECK(VK_TRACKED(EndCommandBuffer, vkEndCommandBuffer(commandBuffer)),
              "Failed to end recording command buffer");
 }
 
@@ -176,11 +177,11 @@ void VulkanCommandPool::endSingleTimeCommands(VkCommandBuffer commandBuffer, VkQ
     submitInfo.commandBufferCount = 1;
     submitInfo.pCommandBuffers = &commandBuffer;
     
-    VK_CHECK(vkQueueSubmit(queue, 1, &submitInfo, VK_NULL_HANDLE),
+    VK_CHECK(VK_TRACKED(QueueSubmit, vkQueueSubmit(queue, 1, &submitInfo, VK_NULL_HANDLE)),
              "Failed to submit single-time command buffer");
     
     // Wait for completion
-    VK_CHECK(vkQueueWaitIdle(queue),
+    VK_CHECK(VK_TRACKED(QueueWaitIdle, vkQueueWaitIdle(queue)),
              "Failed to wait for queue idle after single-time command");
     
     // Free the temporary command buffer
@@ -190,28 +191,35 @@ void VulkanCommandPool::endSingleTimeCommands(VkCommandBuffer commandBuffer, VkQ
 void VulkanCommandPool::beginRenderPass(VkCommandBuffer commandBuffer, VkRenderPass renderPass,
                                        VkFramebuffer framebuffer, VkRect2D renderArea,
                                        const std::vector<VkClearValue>& clearValues) {
+    beginRenderPass(commandBuffer, renderPass, framebuffer, renderArea,
+                    clearValues.data(), static_cast<uint32_t>(clearValues.size()));
+}
+
+void VulkanCommandPool::beginRenderPass(VkCommandBuffer commandBuffer, VkRenderPass renderPass,
+                                       VkFramebuffer framebuffer, VkRect2D renderArea,
+                                       const VkClearValue* clearValues, uint32_t clearValueCount) {
     
     VkRenderPassBeginInfo renderPassInfo{};
     renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
     renderPassInfo.renderPass = renderPass;
     renderPassInfo.framebuffer = framebuffer;
     renderPassInfo.renderArea = renderArea;
-    renderPassInfo.clearValueCount = static_cast<uint32_t>(clearValues.size());
-    renderPassInfo.pClearValues = clearValues.data();
+    renderPassInfo.clearValueCount = clearValueCount;
+    renderPassInfo.pClearValues = clearValues;
     
     // Begin the render pass
     // VK_SUBPASS_CONTENTS_INLINE means the render pass commands will be embedded
     // in the primary command buffer (as opposed to being in secondary command buffers)
-    vkCmdBeginRenderPass(commandBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
+    VK_TRACKED(CmdBeginRenderPass, vkCmdBeginRenderPass(commandBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE));
 }
 
 void VulkanCommandPool::endRenderPass(VkCommandBuffer commandBuffer) {
-    vkCmdEndRenderPass(commandBuffer);
+    VK_TRACKED(CmdEndRenderPass, vkCmdEndRenderPass(commandBuffer));
 }
 
 void VulkanCommandPool::bindPipeline(VkCommandBuffer commandBuffer, VkPipeline pipeline, 
                                      VkPipelineBindPoint bindPoint) {
-    vkCmdBindPipeline(commandBuffer, bindPoint, pipeline);
+    VK_TRACKED(CmdBindPipeline, vkCmdBindPipeline(commandBuffer, bindPoint, pipeline));
 }
 
 void VulkanCommandPool::bindVertexBuffers(VkCommandBuffer commandBuffer, uint32_t firstBinding,
@@ -222,34 +230,45 @@ void VulkanCommandPool::bindVertexBuffers(VkCommandBuffer commandBuffer, uint32_
         throw std::runtime_error("Number of vertex buffers must match number of offsets");
     }
     
-    vkCmdBindVertexBuffers(commandBuffer, firstBinding, 
-                          static_cast<uint32_t>(buffers.size()),
-                          buffers.data(), offsets.data());
+    bindVertexBuffers(commandBuffer, firstBinding, static_cast<uint32_t>(buffers.size()),
+                      buffers.data(), offsets.data());
+}
+
+void VulkanCommandPool::bindVertexBuffers(VkCommandBuffer commandBuffer, uint32_t firstBinding, uint32_t bindingCount,
+                                         const VkBuffer* buffers, const VkDeviceSize* offsets) {
+    VK_TRACKED(CmdBindVertexBuffers, vkCmdBindVertexBuffers(commandBuffer, firstBinding, bindingCount, buffers, offsets));
 }
 
 void VulkanCommandPool::bindIndexBuffer(VkCommandBuffer commandBuffer, VkBuffer buffer,
                                        VkDeviceSize offset, VkIndexType indexType) {
-    vkCmdBindIndexBuffer(commandBuffer, buffer, offset, indexType);
+    VK_TRACKED(CmdBindIndexBuffer, vkCmdBindIndexBuffer(commandBuffer, buffer, offset, indexType));
 }
 
 void VulkanCommandPool::bindDescriptorSets(VkCommandBuffer commandBuffer, VkPipelineLayout pipelineLayout,
                                           uint32_t firstSet, const std::vector<VkDescriptorSet>& descriptorSets,
                                           const std::vector<uint32_t>& dynamicOffsets) {
     
-    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout,
-                           firstSet, static_cast<uint32_t>(descriptorSets.size()),
-                           descriptorSets.data(), static_cast<uint32_t>(dynamicOffsets.size()),
-                           dynamicOffsets.empty() ? nullptr : dynamicOffsets.data());
+    VK_TRACKED(CmdBindDescriptorSets, vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout,
+                                                             firstSet, static_cast<uint32_t>(descriptorSets.size()),
+                                                             descriptorSets.data(), static_cast<uint32_t>(dynamicOffsets.size()),
+                                                             dynamicOffsets.empty() ? nullptr : dynamicOffsets.data()));
+}
+
+void VulkanCommandPool::bindDescriptorSets(VkCommandBuffer commandBuffer, VkPipelineLayout pipelineLayout,
+                                          uint32_t firstSet, uint32_t descriptorSetCount,
+                                          const VkDescriptorSet* descriptorSets) {
+    VK_TRACKED(CmdBindDescriptorSets, vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout,
+                                                             firstSet, descriptorSetCount, descriptorSets, 0, nullptr));
 }
 
 void VulkanCommandPool::draw(VkCommandBuffer commandBuffer, uint32_t vertexCount, uint32_t instanceCount,
                             uint32_t firstVertex, uint32_t firstInstance) {
-    vkCmdDraw(commandBuffer, vertexCount, instanceCount, firstVertex, firstInstance);
+    VK_TRACKED(CmdDraw, vkCmdDraw(commandBuffer, vertexCount, instanceCount, firstVertex, firstInstance));
 }
 
 void VulkanCommandPool::drawIndexed(VkCommandBuffer commandBuffer, uint32_t indexCount, uint32_t instanceCount,
                                    uint32_t firstIndex, int32_t vertexOffset, uint32_t firstInstance) {
-    vkCmdDrawIndexed(commandBuffer, indexCount, instanceCount, firstIndex, vertexOffset, firstInstance);
+    VK_TRACKED(CmdDrawIndexed, vkCmdDrawIndexed(commandBuffer, indexCount, instanceCount, firstIndex, vertexOffset, firstInstance));
 }
 
 void VulkanCommandPool::setViewport(VkCommandBuffer commandBuffer, float x, float y, float width, float height,
@@ -262,7 +281,7 @@ void VulkanCommandPool::setViewport(VkCommandBuffer commandBuffer, float x, floa
     viewport.minDepth = minDepth;
     viewport.maxDepth = maxDepth;
     
-    vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+    VK_TRACKED(CmdSetViewport, vkCmdSetViewport(commandBuffer, 0, 1, &viewport));
 }
 
 void VulkanCommandPool::setScissor(VkCommandBuffer commandBuffer, int32_t x, int32_t y, uint32_t width, uint32_t height) {
@@ -270,7 +289,7 @@ void VulkanCommandPool::setScissor(VkCommandBuffer commandBuffer, int32_t x, int
     scissor.offset = {x, y};
     scissor.extent = {width, height};
     
-    vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+    VK_TRACKED(CmdSetScissor, vkCmdSetScissor(commandBuffer, 0, 1, &scissor));
 }
 
 void VulkanCommandPool::copyBuffer(VkCommandBuffer commandBuffer, VkBuffer srcBuffer, VkBuffer dstBuffer,
@@ -280,7 +299,7 @@ void VulkanCommandPool::copyBuffer(VkCommandBuffer commandBuffer, VkBuffer srcBu
     copyRegion.dstOffset = dstOffset;
     copyRegion.size = size;
     
-    vkCmdCopyBuffer(commandBuffer, srcBuffer, dstBuffer, 1, &copyRegion);
+    VK_TRACKED(CmdCopyBuffer, vkCmdCopyBuffer(commandBuffer, srcBuffer, dstBuffer, 1, &copyRegion));
 }
 
 void VulkanCommandPool::pipelineBarrier(VkCommandBuffer commandBuffer,
@@ -290,18 +309,18 @@ void VulkanCommandPool::pipelineBarrier(VkCommandBuffer commandBuffer,
                                        const std::vector<VkBufferMemoryBarrier>& bufferBarriers,
                                        const std::vector<VkImageMemoryBarrier>& imageBarriers) {
     
-    vkCmdPipelineBarrier(commandBuffer, srcStageMask, dstStageMask, dependencyFlags,
-                        static_cast<uint32_t>(memoryBarriers.size()),
-                        memoryBarriers.empty() ? nullptr : memoryBarriers.data(),
-                        static_cast<uint32_t>(bufferBarriers.size()),
-                        bufferBarriers.empty() ? nullptr : bufferBarriers.data(),
-                        static_cast<uint32_t>(imageBarriers.size()),
-                        imageBarriers.empty() ? nullptr : imageBarriers.data());
+    VK_TRACKED(CmdPipelineBarrier, vkCmdPipelineBarrier(commandBuffer, srcStageMask, dstStageMask, dependencyFlags,
+                                                       static_cast<uint32_t>(memoryBarriers.size()),
+                                                       memoryBarriers.empty() ? nullptr : memoryBarriers.data(),
+                                                       static_cast<uint32_t>(bufferBarriers.size()),
+                                                       bufferBarriers.empty() ? nullptr : bufferBarriers.data(),
+                                                       static_cast<uint32_t>(imageBarriers.size()),
+                                                       imageBarriers.empty() ? nullptr : imageBarriers.data()));
 }
 
 void VulkanCommandPool::pushConstants(VkCommandBuffer commandBuffer, VkPipelineLayout pipelineLayout,
                                      VkShaderStageFlags stageFlags, uint32_t offset, uint32_t size, const void* data) {
-    vkCmdPushConstants(commandBuffer, pipelineLayout, stageFlags, offset, size, data);
+    VK_TRACKED(CmdPushConstants, vkCmdPushConstants(commandBuffer, pipelineLayout, stageFlags, offset, size, data));
 }
 
 void VulkanCommandPool::recordFrameCommands(VkCommandBuffer commandBuffer,
@@ -366,9 +385,9 @@ void VulkanCommandPool::cleanup() {
             VulkanUtils::logObjectDestruction("CommandBuffers", 
                 "Freeing " + std::to_string(m_allocatedBuffers.size()) + " remaining command buffers");
             
-            vkFreeCommandBuffers(m_device, m_commandPool, 
-                               static_cast<uint32_t>(m_allocatedBuffers.size()),
-                               m_allocatedBuffers.data());
+            VK_TRACKED(FreeCommandBuffers, vkFreeCommandBuffers(m_device, m_commandPool, 
+                                                              static_cast<uint32_t>(m_allocatedBuffers.size()),
+                                                              m_allocatedBuffers.data()));
             m_allocatedBuffers.clear();
         }
         
@@ -23,6 +23,15 @@ VulkanDevice::~VulkanDevice() {
 void VulkanDevice::create(VkInstance instance, VkSurfaceKHR surface) {
     std::cout << "\n=== VulkanDevice: Starting Device Selection and Creation ===\n";
     
+    // Without a surface nothing is presented, so the swapchain extension is not needed
+    m_headless = (surface == VK_NULL_HANDLE);
+    if (m_headless) {
+        m_deviceExtensions.clear();
+        std::cout << "VulkanDevice: Headless mode, presentation support not required\n";
+    } else {
+        m_deviceExtensions = { VK_KHR_SWAPCHAIN_EXTENSION_NAME };
+    }
+    
     // Step 1: Select the best physical device
     // Physical devices represent actual GPUs or graphics hardware in the system
     selectPhysicalDevice(instance, surface);
@@ -163,13 +172,16 @@ void VulkanDevice::createLogicalDevice(VkSurfaceKHR surface) {
     }
     
     // Specify device features we want to use
-    // For now, we'll use default features (all disabled)
-    // In the future, we might enable features like:
+    // Most features stay disabled. In the future, we might enable features like:
     // - samplerAnisotropy for better texture filtering
     // - geometryShader for advanced rendering techniques
     // - tessellationShader for detailed surface subdivision
     VkPhysicalDeviceFeatures deviceFeatures{};
     
+    // Pipeline statistics queries are used by the GPU profiler when available
+    deviceFeatures.pipelineStatisticsQuery = m_deviceFeatures.pipelineStatisticsQuery;
+    m_enabledFeatures = deviceFeatures;
+    
     // Create the logical device
     VkDeviceCreateInfo createInfo{};
     createInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
@@ -280,6 +292,11 @@ bool VulkanDevice::isDeviceSuitable(VkPhysicalDevice device, VkSurfaceKHR surfac
         return false;
     }
     
+    // Headless devices never create a swapchain
+    if (surface == VK_NULL_HANDLE) {
+        return true;
+    }
+    
     // Check if swapchain support is adequate
     SwapchainSupportDetails swapchainSupport = querySwapchainSupportDetails(device, surface);
     if (!swapchainSupport.isAdequate()) {
@@ -320,11 +337,17 @@ VulkanDevice::QueueFamilyIndices VulkanDevice::findQueueFamilies(VkPhysicalDevic
             indices.transferFamily = i;
         }
         
-        // Check for presentation support
-        VkBool32 presentSupport = false;
-        vkGetPhysicalDeviceSurfaceSupportKHR(device, i, surface, &presentSupport);
-        if (presentSupport) {
-            indices.presentFamily = i;
+        // Check for presentation support (headless: the graphics queue stands in, nothing is presented)
+        if (surface == VK_NULL_HANDLE) {
+            if (indices.graphicsFamily.has_value()) {
+                indices.presentFamily = indices.graphicsFamily;
+            }
+        } else {
+            VkBool32 presentSupport = false;
+            vkGetPhysicalDeviceSurfaceSupportKHR(device, i, surface, &presentSupport);
+            if (presentSupport) {
+                indices.presentFamily = i;
+            }
         }
         
         // Early exit if we found all required families
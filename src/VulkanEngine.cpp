@@ -1,29 +1,100 @@
 #include "../headers/VulkanEngine.h"
 #include "../headers/VulkanUtils.h"
-#include "../headers/VulkanBuffer.h"
+#include "../headers/VulkanOffscreenTarget.h"
+#include "../headers/CaptureRenderBackend.h"
 #include "../headers/Logger.h"
+#include "../headers/Profiler.h"
+#include "../headers/Metrics.h"
+#include "../headers/AllocationTracker.h"
+#include "../headers/VulkanCallStats.h"
+#include "../headers/MeshProcessing.h"
+#include "../headers/ThreadPool.h"
+#include "../headers/FileWatcher.h"
+#include "../headers/MeshAsset.h"
+#include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <fstream>
+#include <mutex>
+#include <thread>
 
 namespace VulkanGameEngine {
 
+namespace {
+
+// Commands recorded per frame; reserved up front so recording never allocates
+constexpr size_t COMMAND_LIST_CAPACITY = 64;
+
+constexpr const char* MAIN_CHARACTER_PATH = "assets/FinalBaseMesh.obj";
+
+/**
+ * Reads a SPIR-V file for hot reload. Reads the loose file (the one being
+ * edited) rather than going through mounted archives, and rejects files that
+ * are not SPIR-V, such as a shader caught halfway through being written.
+ */
+bool readSpirv(const std::string& path, std::vector<char>& code) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) {
+        LOG_WARN("Cannot open {}", "HotReload", path);
+        return false;
+    }
+    code.resize(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    file.read(code.data(), static_cast<std::streamsize>(code.size()));
+
+    constexpr uint32_t SPIRV_MAGIC = 0x07230203;
+    uint32_t magic = 0;
+    if (code.size() >= sizeof(magic)) {
+        std::memcpy(&magic, code.data(), sizeof(magic));
+    }
+    if (!file || code.size() % 4 != 0 || magic != SPIRV_MAGIC) {
+        LOG_WARN("{} is not valid SPIR-V", "HotReload", path);
+        return false;
+    }
+    return true;
+}
+
+} // anonymous namespace
+
+/**
+ * Hot reload state: the watcher, and the swaps of reloads that finished on
+ * workers, waiting for the next frame boundary
+ */
+struct VulkanEngine::HotReload {
+    FileWatcher watcher;
+    std::vector<std::string> changed;           // Reused by every poll
+    std::mutex mutex;
+    std::vector<std::function<void()>> ready;   // Swaps to run on the main thread (guarded by mutex)
+    std::atomic<uint32_t> running{0};           // Loads queued or running on workers
+    uint64_t meshGeneration = 0;                // Latest mesh load started; older ones are dropped
+    uint64_t shaderGeneration = 0;              // Latest shader load started
+};
+
 VulkanEngine::VulkanEngine()
-    : m_surface(VK_NULL_HANDLE)
-    , m_initState(InitializationState::NOT_INITIALIZED)
+    : m_backendType(BackendType::VULKAN)
+    , m_frameCaptureEnabled(false)
+    , m_captureBackend(nullptr)
+    , m_pipeline(INVALID_HANDLE)
+    , m_vertexBuffer(INVALID_HANDLE)
+    , m_indexBuffer(INVALID_HANDLE)
+    , m_useMainCharacter(false)
+    , m_recordedDraws(0)
+    , m_recordedTriangles(0)
+    , m_initialized(false)
     , m_window(nullptr)
+    , m_headless(false)
     , m_windowWidth(0)
     , m_windowHeight(0)
     , m_currentFrame(0)
     , m_frameCount(0)
     , m_lastFrameTime(0.0f)
+    , m_lastFenceWaitTime(0.0f)
+    , m_fixedTimeStep(0.0f)
     , m_time(0.0f)
     , m_modelMatrix(1.0f)
     , m_viewMatrix(1.0f)
     , m_projectionMatrix(1.0f)
-    , m_useMainCharacter(false)
-    , m_descriptorPool(VK_NULL_HANDLE)
-    , m_depthImage(VK_NULL_HANDLE)
-    , m_depthImageMemory(VK_NULL_HANDLE)
-    , m_depthImageView(VK_NULL_HANDLE)
+    , m_viewDistance(50.0f)
     , m_cameraPosition(10.0f, 5.0f, 10.0f)
     , m_cameraTarget(0.0f, 0.0f, 0.0f)
     , m_cameraSpeed(5.0f) {
@@ -36,118 +107,142 @@ VulkanEngine::~VulkanEngine() {
 }
 
 void VulkanEngine::initialize(SDL_Window* window, uint32_t windowWidth, uint32_t windowHeight) {
-    VulkanUtils::logObjectCreation("VulkanEngine", "Beginning initialization sequence");
-    
-    m_window = window;
-    m_windowWidth = windowWidth;
-    m_windowHeight = windowHeight;
-    
-    try {
-        // Step 1: Create Vulkan instance
-        logInitializationState(InitializationState::INSTANCE_CREATED, "Creating Vulkan instance");
-        
-        // Get required extensions from SDL
-        uint32_t extensionCount = 0;
-        const char* const* extensions = SDL_Vulkan_GetInstanceExtensions(&extensionCount);
-        if (!extensions) {
-            throw std::runtime_error("Failed to get Vulkan extensions from SDL: " + std::string(SDL_GetError()));
-        }
-        
-        std::vector<const char*> requiredExtensions(extensions, extensions + extensionCount);
-        m_instance.create(requiredExtensions);
-        m_initState = InitializationState::INSTANCE_CREATED;
-        
-        // Step 2: Create window surface
-        logInitializationState(InitializationState::SURFACE_CREATED, "Creating window surface");
-        createSurface(window);
-        m_initState = InitializationState::SURFACE_CREATED;
-        
-        // Step 3: Create device (physical and logical)
-        logInitializationState(InitializationState::DEVICE_CREATED, "Creating Vulkan device");
-        m_device.create(m_instance.getInstance(), m_surface);
-        m_initState = InitializationState::DEVICE_CREATED;
-        
-        // Step 4: Create swapchain
-        logInitializationState(InitializationState::SWAPCHAIN_CREATED, "Creating swapchain");
-        m_swapchain.create(m_device, m_surface, windowWidth, windowHeight);
-        m_initState = InitializationState::SWAPCHAIN_CREATED;
-        
-        // Step 5: Create render pass
-        logInitializationState(InitializationState::RENDER_PASS_CREATED, "Creating render pass");
-        // Use appropriate depth format - you may need to query this from device
-        VkFormat depthFormat = VK_FORMAT_D32_SFLOAT; // Common depth format
-        m_renderPass.create(m_device.getLogicalDevice(), m_swapchain.getImageFormat(), depthFormat);
-        m_initState = InitializationState::RENDER_PASS_CREATED;
-        
-        // Step 5.5: Create depth buffer and framebuffers
-        logInitializationState(InitializationState::RENDER_PASS_CREATED, "Creating depth buffer and framebuffers");
-        createDepthBuffer();
-        m_renderPass.createFramebuffers(m_swapchain.getImageViews(), m_depthImageView, m_swapchain.getExtent());
-        
-        // Step 6: Create graphics pipeline
-        logInitializationState(InitializationState::PIPELINE_CREATED, "Creating graphics pipeline");
-        m_pipeline.createGraphicsPipeline(m_device.getLogicalDevice(), m_renderPass.getRenderPass(), 
-                         "shaders/vertex.vert.spv", "shaders/fragment.frag.spv", m_swapchain.getExtent());
-        m_initState = InitializationState::PIPELINE_CREATED;
-        
-        // Step 6.5: Create descriptor sets using the pipeline's layout
-        logInitializationState(InitializationState::DESCRIPTORS_CREATED, "Creating descriptor sets");
-        createDescriptorSets();
-        m_initState = InitializationState::DESCRIPTORS_CREATED;
-        
-        // Step 7: Create command pool and command buffers (MOVED UP - needed for buffer creation)
-        logInitializationState(InitializationState::COMMAND_POOL_CREATED, "Creating command pool and buffers");
-        m_commandPool.create(m_device.getLogicalDevice(), 
-                            m_device.getQueueFamilyIndices().graphicsFamily.value());
-        createCommandBuffers();
-        m_initState = InitializationState::COMMAND_POOL_CREATED;
-        
-        // Step 8: Create buffers (MOVED DOWN - now command pool is available)
-        logInitializationState(InitializationState::BUFFERS_CREATED, "Creating vertex and uniform buffers");
+    if (!window) {
+        throw std::runtime_error("VulkanEngine::initialize requires a window; use initializeHeadless for offscreen rendering");
+    }
+    StartupGraph graph;
+    addStartupPhases(graph, window, {}, windowWidth, windowHeight, BackendType::VULKAN);
+    runStartup(graph);
+}
+
+void VulkanEngine::initializeHeadless(uint32_t width, uint32_t height, BackendType backend) {
+    StartupGraph graph;
+    addStartupPhases(graph, nullptr, {}, width, height, backend);
+    runStartup(graph);
+}
+
+StartupGraph::PhaseId VulkanEngine::addStartupPhases(StartupGraph& graph, SDL_Window* const& window,
+                                                     std::vector<StartupGraph::PhaseId> windowPhases,
+                                                     uint32_t width, uint32_t height, BackendType backend) {
+    using Affinity = StartupGraph::Affinity;
+    
+    m_windowWidth = width;
+    m_windowHeight = height;
+    m_backendType = backend;
+    
+    MetricsRegistry& metrics = MetricsRegistry::getInstance();
+    m_metrics.cpuUpdate = &metrics.histogram("frame.cpu_update", "ms", 1e6);
+    m_metrics.record = &metrics.histogram("frame.record", "ms", 1e6);
+    m_metrics.submit = &metrics.histogram("frame.submit", "ms", 1e6);
+    m_metrics.presentWait = &metrics.histogram("frame.present_wait", "ms", 1e6);
+    m_metrics.gpuTime = &metrics.histogram("frame.gpu", "ms", 1e6);
+    m_metrics.uploadBytes = &metrics.histogram("frame.upload_bytes", "bytes", 1.0);
+    m_metrics.uploadCounter = &metrics.counter("gpu.upload_bytes");
+    
+    // CPU-only work: needs neither the window nor the device, so it starts right away
+    const StartupGraph::PhaseId readShadersPhase = graph.add("ReadShaders", [this] { readShaders(); });
+    const StartupGraph::PhaseId parseCharacterPhase = graph.add("ParseCharacter", [this] { parseMainCharacter(); });
+    
+    // Step 1: Create the backend (device, render target, command buffers, synchronization)
+    const StartupGraph::PhaseId createBackendPhase = graph.add("CreateBackend", [this, &window] {
+        createBackend(window);
+    }, std::move(windowPhases), Affinity::MAIN_THREAD);
+    
+    // Step 2: Create graphics pipeline
+    const StartupGraph::PhaseId createPipelinePhase = graph.add("CreatePipeline", [this] {
+        LOG_DEBUG("[VulkanEngine] Creating graphics pipeline...", "Engine");
+        m_pipeline = m_backend->createPipeline(m_pipelineDesc);
+    }, {createBackendPhase, readShadersPhase}, Affinity::MAIN_THREAD);
+    
+    // Step 3: Create buffers (uniform buffers need the pipeline's descriptor layout)
+    const StartupGraph::PhaseId createBuffersPhase = graph.add("CreateBuffers", [this] {
+        LOG_DEBUG("[VulkanEngine] Creating vertex and uniform buffers...", "Engine");
         createBuffers();
         createUniformBuffers();
-        updateDescriptorSets(); // Update descriptor sets after uniform buffers are created
-        m_initState = InitializationState::BUFFERS_CREATED;
-        
-        // Step 9: Create synchronization objects
-        logInitializationState(InitializationState::SYNCHRONIZATION_CREATED, "Creating synchronization objects");
-        m_synchronization.create(m_device.getLogicalDevice(), MAX_FRAMES_IN_FLIGHT);
-        m_initState = InitializationState::SYNCHRONIZATION_CREATED;
-        
-        // Step 10: Load main character
-        logInitializationState(InitializationState::CHARACTER_LOADED, "Loading main character model");
-        loadMainCharacter();
-        m_initState = InitializationState::CHARACTER_LOADED;
-        
-        // Step 11: Setup initial scene
+    }, {createPipelinePhase}, Affinity::MAIN_THREAD);
+    
+    // Step 4: Upload the main character parsed on a worker
+    const StartupGraph::PhaseId uploadCharacterPhase = graph.add("UploadCharacter", [this] {
+        uploadMainCharacter();
+    }, {createBackendPhase, parseCharacterPhase}, Affinity::MAIN_THREAD);
+    
+    // Step 5: Setup initial scene
+    return graph.add("SetupScene", [this] {
         setupScene();
-        m_initState = InitializationState::FULLY_INITIALIZED;
-        
-        VulkanUtils::logObjectCreation("VulkanEngine", "Initialization completed successfully");
-        LOG_INFO("Vulkan engine ready for rendering!", "Engine");
-        LOG_INFO("  - Window size: " + std::to_string(windowWidth) + "x" + std::to_string(windowHeight), "Engine");
-        LOG_INFO("  - Max frames in flight: " + std::to_string(MAX_FRAMES_IN_FLIGHT), "Engine");
-        LOG_INFO("  - Swapchain images: " + std::to_string(m_swapchain.getImageViews().size()), "Engine");
-        
-        if (m_useMainCharacter) {
-            uint32_t vertexCount, triangleCount;
-            m_mainCharacter.getModelStats(vertexCount, triangleCount);
-            LOG_INFO("  - Main character loaded: " + std::to_string(vertexCount) + " vertices, " + 
-                    std::to_string(triangleCount) + " triangles", "Engine");
-        } else {
-            LOG_INFO("  - Using fallback cube geometry", "Engine");
-        }
-        
+        m_commandList.reserve(COMMAND_LIST_CAPACITY);
+        m_initialized = true;
+        logInitializationSummary();
+    }, {createBuffersPhase, uploadCharacterPhase}, Affinity::MAIN_THREAD);
+}
+
+void VulkanEngine::runStartup(StartupGraph& graph) {
+    try {
+        graph.run(ThreadPool::getInstance());
     } catch (const std::exception& e) {
-        LOG_ERROR("Vulkan engine initialization failed at state " + 
-                  std::to_string(static_cast<int>(m_initState)) + ": " + e.what(), "Engine");
+        LOG_ERROR("Vulkan engine initialization failed: " + std::string(e.what()), "Engine");
         cleanup();
         throw;
     }
+    graph.logSummary();
+}
+
+void VulkanEngine::createBackend(SDL_Window* window) {
+    if (!window && (m_windowWidth == 0 || m_windowHeight == 0)) {
+        throw std::runtime_error("Headless rendering needs a non-zero image size");
+    }
+    m_window = window;
+    m_headless = window == nullptr;
+    VulkanUtils::logObjectCreation("VulkanEngine", std::string("Beginning initialization sequence (") +
+                                   getBackendName(m_backendType) + " backend)");
+    
+    LOG_DEBUG("[VulkanEngine] Initializing {} backend...", "Engine", getBackendName(m_backendType));
+    m_backend = createRenderBackend(m_backendType);
+    if (m_frameCaptureEnabled) {
+        auto captureBackend = std::make_unique<CaptureRenderBackend>(std::move(m_backend));
+        m_captureBackend = captureBackend.get();
+        m_backend = std::move(captureBackend);
+    }
+    BackendConfig config;
+    config.window = window;
+    config.width = m_windowWidth;
+    config.height = m_windowHeight;
+    m_backend->initialize(config);
+}
+
+void VulkanEngine::readShaders() {
+    m_pipelineDesc.vertexShaderPath = "shaders/vertex.vert.spv";
+    m_pipelineDesc.fragmentShaderPath = "shaders/fragment.frag.spv";
+    try {
+        m_pipelineDesc.vertexShaderCode = VulkanUtils::readFile(m_pipelineDesc.vertexShaderPath);
+        m_pipelineDesc.fragmentShaderCode = VulkanUtils::readFile(m_pipelineDesc.fragmentShaderPath);
+    } catch (const std::exception& e) {
+        // The null backend never needs them; the Vulkan backend reports the missing file itself
+        m_pipelineDesc.vertexShaderCode.clear();
+        m_pipelineDesc.fragmentShaderCode.clear();
+        LOG_DEBUG("Shaders not preloaded: {}", "Engine", e.what());
+    }
+}
+
+void VulkanEngine::logInitializationSummary() const {
+    VulkanUtils::logObjectCreation("VulkanEngine", "Initialization completed successfully");
+    LOG_INFO("Vulkan engine ready for rendering!", "Engine");
+    LOG_INFO("  - Backend: {}", "Engine", m_backend->getName());
+    LOG_INFO(std::string(m_headless ? "  - Offscreen size: " : "  - Window size: ") +
+             std::to_string(m_windowWidth) + "x" + std::to_string(m_windowHeight), "Engine");
+    LOG_INFO("  - Max frames in flight: " + std::to_string(MAX_FRAMES_IN_FLIGHT), "Engine");
+    
+    if (m_useMainCharacter) {
+        uint32_t vertexCount, triangleCount;
+        m_mainCharacter.getModelStats(vertexCount, triangleCount);
+        LOG_INFO("  - Main character loaded: " + std::to_string(vertexCount) + " vertices, " + 
+                std::to_string(triangleCount) + " triangles", "Engine");
+    } else {
+        LOG_INFO("  - Using fallback cube geometry", "Engine");
+    }
 }
 
 void VulkanEngine::render() {
-    if (m_initState != InitializationState::FULLY_INITIALIZED) {
+    if (!m_initialized) {
         throw std::runtime_error("Cannot render: engine not fully initialized");
     }
     
@@ -156,79 +251,78 @@ void VulkanEngine::render() {
         return;
     }
     
+    PROFILE_ZONE("Render");
     auto frameStart = std::chrono::high_resolution_clock::now();
     
+    // Swap in reloaded assets between frames; frames in flight finish with what they were recorded with
+    if (m_hotReload) {
+        updateHotReload();
+    }
+    
     try {
-        // Wait for the previous frame to complete
-        if (!m_synchronization.waitForFrame(m_currentFrame, UINT64_MAX)) { // Infinite timeout
-            LOG_WARN("Failed to wait for frame " + std::to_string(m_currentFrame), "Engine");
+        // Wait for the previous use of this frame slot and acquire the next image
+        if (m_backend->beginFrame(m_currentFrame) == FrameStatus::SKIPPED) {
             return;
         }
+        m_lastFenceWaitTime = static_cast<float>(m_backend->getTimings().fenceWaitNs / 1e9);
         
-        // Acquire next image from swapchain
-        uint32_t imageIndex;
-        VkResult result = m_synchronization.acquireNextImage(
-            m_device.getLogicalDevice(),
-            m_swapchain.getSwapchain(),
-            UINT64_MAX,
-            m_synchronization.getImageAvailableSemaphore(m_currentFrame),
-            VK_NULL_HANDLE,
-            &imageIndex
-        );
+        // Hand finished readbacks to the writer and request this frame's, if recording
+        m_recorder.onFrame(m_frameCount);
         
-        // Handle swapchain recreation if needed
-        if (result == VK_ERROR_OUT_OF_DATE_KHR) {
-            recreateSwapchain();
-            return;
-        } else if (result != VK_SUCCESS && result != VK_SUBOPTIMAL_KHR) {
-            throw std::runtime_error("Failed to acquire swapchain image: " + 
-                                   VulkanUtils::vulkanResultToString(result));
+        const GpuProfiler::FrameResults& gpuResults = m_backend->getGpuResults();
+        if (gpuResults.valid && gpuResults.frame != m_metrics.lastGpuFrame) {
+            m_metrics.gpuTime->record(static_cast<uint64_t>(gpuResults.gpuTimeMs * 1e6));
+            m_metrics.lastGpuFrame = gpuResults.frame;
         }
         
-        // Reset fence for this frame
-        m_synchronization.resetFrameFence(m_currentFrame);
-        
         // Update scene data for this frame
-        updateScene(m_lastFrameTime);
-        
-        // Update uniform buffer for this frame
-        updateUniformBuffer(m_currentFrame);
+        {
+            PROFILE_ZONE("UpdateScene");
+            ALLOC_SCOPE("UpdateScene");
+            ScopedMetricTimer updateTimer(*m_metrics.cpuUpdate);
+            updateScene(m_fixedTimeStep > 0.0f ? m_fixedTimeStep : m_lastFrameTime);
+
+            // Deformed vertices go into this frame's copy of their buffers
+            m_scene.flush(m_currentFrame);
+
+            // Update uniform buffer for this frame
+            updateUniformBuffer(m_currentFrame);
+        }
         
-        // Record command buffer
-        VkCommandBuffer commandBuffer = m_commandBuffers[m_currentFrame];
-        VK_CHECK(vkResetCommandBuffer(commandBuffer, 0), "Failed to reset command buffer");
-        recordCommandBuffer(commandBuffer, imageIndex);
+        // Record the command list, then have the backend translate it
+        {
+            PROFILE_ZONE("RecordCommands");
+            ALLOC_SCOPE("RecordCommands");
+            ScopedMetricTimer recordTimer(*m_metrics.record);
+            m_commandList.reset();
+            recordCommands(m_commandList);
+            m_backend->recordFrame(m_commandList);
+        }
         
         // Submit command buffer
-        std::vector<VkSemaphore> waitSemaphores = {m_synchronization.getImageAvailableSemaphore(m_currentFrame)};
-        std::vector<VkPipelineStageFlags> waitStages = {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT};
-        std::vector<VkSemaphore> signalSemaphores = {m_synchronization.getRenderFinishedSemaphore(m_currentFrame)};
-        
-        m_synchronization.submitCommandBuffers(
-            m_device.getGraphicsQueue(),
-            {commandBuffer},
-            waitSemaphores,
-            waitStages,
-            signalSemaphores,
-            m_synchronization.getInFlightFence(m_currentFrame)
-        );
-        
-        // Present the image
-        result = m_synchronization.presentImage(
-            m_device.getPresentQueue(),
-            m_swapchain.getSwapchain(),
-            imageIndex,
-            signalSemaphores
-        );
+        {
+            PROFILE_ZONE("Submit");
+            ALLOC_SCOPE("Submit");
+            ScopedMetricTimer submitTimer(*m_metrics.submit);
+            m_backend->submitFrame();
+        }
         
-        // Handle swapchain recreation if needed
-        if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR) {
-            recreateSwapchain();
-        } else if (result != VK_SUCCESS) {
-            throw std::runtime_error("Failed to present swapchain image: " + 
-                                   VulkanUtils::vulkanResultToString(result));
+        // Present the image (the backend recreates the swapchain if it went out of date)
+        {
+            PROFILE_ZONE("Present");
+            ALLOC_SCOPE("Present");
+            m_backend->presentFrame();
+            
+            // Everything this frame spent blocked on the GPU or the presentation engine
+            const BackendTimings& timings = m_backend->getTimings();
+            const int64_t presentWaitNs = timings.fenceWaitNs + timings.acquireNs + timings.presentNs;
+            m_metrics.presentWait->record(static_cast<uint64_t>(std::max<int64_t>(presentWaitNs, 0)));
         }
         
+        const uint64_t uploadTotal = m_metrics.uploadCounter->getTotal();
+        m_metrics.uploadBytes->record(uploadTotal - m_metrics.lastUploadTotal);
+        m_metrics.lastUploadTotal = uploadTotal;
+        
         // Move to next frame
         m_currentFrame = (m_currentFrame + 1) % MAX_FRAMES_IN_FLIGHT;
         m_frameCount++;
@@ -242,7 +336,7 @@ void VulkanEngine::render() {
         LOG_ERROR("Error during rendering: " + std::string(e.what()), "Engine");
         // Try to recover by recreating the swapchain
         try {
-            recreateSwapchain();
+            m_backend->resize(m_windowWidth, m_windowHeight);
         } catch (const std::exception& recreateError) {
             LOG_ERROR("Failed to recover from render error: " + std::string(recreateError.what()), "Engine");
             throw; // Re-throw if we can't recover
@@ -261,11 +355,8 @@ void VulkanEngine::handleResize(uint32_t newWidth, uint32_t newHeight) {
     m_windowWidth = newWidth;
     m_windowHeight = newHeight;
     
-    // Wait for device to be idle before recreating resources
-    waitIdle();
-    
-    // Recreate swapchain and dependent resources
-    recreateSwapchain();
+    // Recreate swapchain and dependent resources (the backend waits for the device itself)
+    m_backend->resize(newWidth, newHeight);
     
     // Update projection matrix for new aspect ratio
     setupScene();
@@ -273,6 +364,7 @@ void VulkanEngine::handleResize(uint32_t newWidth, uint32_t newHeight) {
 
 void VulkanEngine::updateScene(float deltaTime) {
     m_time += deltaTime;
+    m_scene.update(deltaTime);
     
     if (m_useMainCharacter) {
         // Position the main character at the origin with optional slow rotation for visibility
@@ -300,34 +392,31 @@ void VulkanEngine::updateScene(float deltaTime) {
 }
 
 void VulkanEngine::moveCamera(float forward, float right, float deltaTime) {
-    // Log camera movement for debugging
+    // Without input there is nothing to move or log
     if (forward != 0.0f || right != 0.0f) {
-        std::cout << "[DEBUG][Camera] Movement input - Forward: " << forward 
-                  << ", Right: " << right << ", DeltaTime: " << deltaTime << std::endl;
-    }
-    
-    // Calculate camera forward and right vectors
-    glm::vec3 forward_vector = glm::normalize(m_cameraTarget - m_cameraPosition);
-    glm::vec3 right_vector = glm::normalize(glm::cross(forward_vector, glm::vec3(0.0f, 1.0f, 0.0f)));
-    
-    // Calculate movement based on input
-    glm::vec3 movement = glm::vec3(0.0f);
-    movement += forward_vector * forward * m_cameraSpeed * deltaTime;
-    movement += right_vector * right * m_cameraSpeed * deltaTime;
-    
-    // Store old position for logging
-    glm::vec3 oldPosition = m_cameraPosition;
-    
-    // Update camera position and target (move both to maintain look direction)
-    m_cameraPosition += movement;
-    m_cameraTarget += movement;
-    
-    // Log position change if moved
-    if (forward != 0.0f || right != 0.0f) {
-        std::cout << "[DEBUG][Camera] Position updated - From: (" 
-                  << oldPosition.x << ", " << oldPosition.y << ", " << oldPosition.z 
-                  << ") To: (" << m_cameraPosition.x << ", " << m_cameraPosition.y 
-                  << ", " << m_cameraPosition.z << ")" << std::endl;
+        // Log camera movement for debugging (arguments are only formatted when TRACE is enabled)
+        LOG_TRACE("Movement input - Forward: {}, Right: {}, DeltaTime: {}", "Camera", forward, right, deltaTime);
+
+        // Calculate camera forward and right vectors
+        glm::vec3 forward_vector = glm::normalize(m_cameraTarget - m_cameraPosition);
+        glm::vec3 right_vector = glm::normalize(glm::cross(forward_vector, glm::vec3(0.0f, 1.0f, 0.0f)));
+
+        // Calculate movement based on input
+        glm::vec3 movement = glm::vec3(0.0f);
+        movement += forward_vector * forward * m_cameraSpeed * deltaTime;
+        movement += right_vector * right * m_cameraSpeed * deltaTime;
+
+        // Store old position for logging
+        glm::vec3 oldPosition = m_cameraPosition;
+
+        // Update camera position and target (move both to maintain look direction)
+        m_cameraPosition += movement;
+        m_cameraTarget += movement;
+
+        // Log position change
+        LOG_TRACE("Position updated - From: ({}, {}, {}) To: ({}, {}, {})", "Camera",
+                  oldPosition.x, oldPosition.y, oldPosition.z,
+                  m_cameraPosition.x, m_cameraPosition.y, m_cameraPosition.z);
     }
     
     // Update the view matrix with new camera position
@@ -335,100 +424,58 @@ void VulkanEngine::moveCamera(float forward, float right, float deltaTime) {
     m_viewMatrix = glm::lookAt(m_cameraPosition, m_cameraTarget, upVector);
 }
 
+void VulkanEngine::setCamera(const glm::vec3& position, const glm::vec3& target) {
+    m_cameraPosition = position;
+    m_cameraTarget = target;
+    m_viewMatrix = glm::lookAt(m_cameraPosition, m_cameraTarget, glm::vec3(0.0f, 1.0f, 0.0f));
+}
+
+void VulkanEngine::setViewDistance(float distance) {
+    m_viewDistance = distance;
+    if (m_windowWidth > 0 && m_windowHeight > 0) {
+        setupScene();
+    }
+}
+
 void VulkanEngine::waitIdle() {
-    if (m_device.getLogicalDevice() != VK_NULL_HANDLE) {
-        VK_CHECK(vkDeviceWaitIdle(m_device.getLogicalDevice()), "Failed to wait for device idle");
+    if (m_backend) {
+        m_backend->waitIdle();
     }
 }
 
 void VulkanEngine::cleanup() {
     VulkanUtils::logObjectDestruction("VulkanEngine", "Beginning cleanup sequence");
     
-    // Wait for all operations to complete
-    if (m_initState >= InitializationState::DEVICE_CREATED) {
-        waitIdle();
-    }
-    
-    // Clean up in reverse order of creation
-    if (m_initState >= InitializationState::SYNCHRONIZATION_CREATED) {
-        m_synchronization.cleanup();
-    }
+    // Workers may still be loading for a reload; nothing they produce is swapped in any more
+    stopHotReload();
     
-    if (m_initState >= InitializationState::CHARACTER_LOADED) {
-        m_mainCharacter.cleanup();
-    }
-    
-    if (m_initState >= InitializationState::BUFFERS_CREATED) {
-        m_vertexBuffer.cleanup();
-        m_indexBuffer.cleanup();
-        for (auto& uniformBuffer : m_uniformBuffers) {
-            uniformBuffer.cleanup();
-        }
-        m_uniformBuffers.clear();
-    }
-    
-    if (m_initState >= InitializationState::COMMAND_POOL_CREATED) {
-        m_commandPool.cleanup();
-        m_commandBuffers.clear();
-    }
-    
-    if (m_initState >= InitializationState::DESCRIPTORS_CREATED) {
-        // Clean up descriptor pool (descriptor sets are automatically freed with pool)
-        if (m_descriptorPool != VK_NULL_HANDLE) {
-            vkDestroyDescriptorPool(m_device.getLogicalDevice(), m_descriptorPool, nullptr);
-            m_descriptorPool = VK_NULL_HANDLE;
-            VulkanUtils::logObjectDestruction("VkDescriptorPool");
-        }
-        
-        m_descriptorSets.clear();
-    }
-    
-    if (m_initState >= InitializationState::PIPELINE_CREATED) {
-        m_pipeline.cleanup();
-    }
-    
-    if (m_initState >= InitializationState::RENDER_PASS_CREATED) {
-        // Clean up depth buffer
-        if (m_depthImageView != VK_NULL_HANDLE) {
-            vkDestroyImageView(m_device.getLogicalDevice(), m_depthImageView, nullptr);
-            m_depthImageView = VK_NULL_HANDLE;
-            VulkanUtils::logObjectDestruction("VkImageView (depth)");
-        }
+    if (m_backend) {
+        // Write out frames still being recorded, then wait for all operations to complete
+        m_recorder.stop();
+        m_backend->waitIdle();
         
-        if (m_depthImage != VK_NULL_HANDLE) {
-            vkDestroyImage(m_device.getLogicalDevice(), m_depthImage, nullptr);
-            m_depthImage = VK_NULL_HANDLE;
-            VulkanUtils::logObjectDestruction("VkImage (depth)");
-        }
+        // Release the engine's resources, then the backend itself
+        m_mainCharacter.cleanup();
+        m_scene.clear(*m_backend);
         
-        if (m_depthImageMemory != VK_NULL_HANDLE) {
-            vkFreeMemory(m_device.getLogicalDevice(), m_depthImageMemory, nullptr);
-            m_depthImageMemory = VK_NULL_HANDLE;
-            VulkanUtils::logObjectDestruction("VkDeviceMemory (depth)");
+        m_backend->destroyBuffer(m_vertexBuffer);
+        m_backend->destroyBuffer(m_indexBuffer);
+        for (BufferHandle uniformBuffer : m_uniformBuffers) {
+            m_backend->destroyBuffer(uniformBuffer);
         }
+        m_backend->destroyPipeline(m_pipeline);
         
-        m_renderPass.cleanup();
+        m_backend->cleanup();
+        m_backend.reset();
+        m_captureBackend = nullptr;
     }
     
-    if (m_initState >= InitializationState::SWAPCHAIN_CREATED) {
-        m_swapchain.cleanup();
-    }
+    m_vertexBuffer = INVALID_HANDLE;
+    m_indexBuffer = INVALID_HANDLE;
+    m_uniformBuffers.clear();
+    m_pipeline = INVALID_HANDLE;
     
-    if (m_initState >= InitializationState::SURFACE_CREATED && m_surface != VK_NULL_HANDLE) {
-        vkDestroySurfaceKHR(m_instance.getInstance(), m_surface, nullptr);
-        m_surface = VK_NULL_HANDLE;
-        VulkanUtils::logObjectDestruction("VkSurfaceKHR");
-    }
-    
-    if (m_initState >= InitializationState::DEVICE_CREATED) {
-        m_device.cleanup();
-    }
-    
-    if (m_initState >= InitializationState::INSTANCE_CREATED) {
-        m_instance.cleanup();
-    }
-    
-    m_initState = InitializationState::NOT_INITIALIZED;
+    m_initialized = false;
     m_window = nullptr;
     m_currentFrame = 0;
     m_frameCount = 0;
@@ -436,52 +483,80 @@ void VulkanEngine::cleanup() {
     VulkanUtils::logObjectDestruction("VulkanEngine", "Cleanup completed");
 }
 
-void VulkanEngine::createSurface(SDL_Window* window) {
-    if (!SDL_Vulkan_CreateSurface(window, m_instance.getInstance(), nullptr, &m_surface)) {
-        throw std::runtime_error("Failed to create Vulkan surface: " + std::string(SDL_GetError()));
+void VulkanEngine::readbackFrame(std::vector<uint8_t>& pixels, uint32_t& width, uint32_t& height) {
+    if (!m_headless) {
+        throw std::runtime_error("Frame readback is only available in headless mode");
+    }
+    if (m_frameCount == 0) {
+        throw std::runtime_error("Cannot read back a frame before one has been rendered");
     }
     
-    VulkanUtils::logObjectCreation("VkSurfaceKHR", "Created SDL Vulkan surface");
+    m_backend->readbackFrame(pixels, width, height);
+}
+
+void VulkanEngine::captureNextFrame(const std::string& path) {
+    if (!m_captureBackend) {
+        throw std::runtime_error("Frame capture was not enabled before the engine was initialized");
+    }
+    m_captureBackend->captureNextFrame(path, m_frameCount);
+}
+
+void VulkanEngine::startRecording(const FrameRecorder::Config& config) {
+    if (!m_backend) {
+        throw std::runtime_error("Cannot record before the engine is initialized");
+    }
+    m_recorder.start(config, *m_backend);
+}
+
+void VulkanEngine::saveFrame(const std::string& path) {
+    std::vector<uint8_t> pixels;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    readbackFrame(pixels, width, height);
+    VulkanOffscreenTarget::writePPM(path, width, height, pixels);
+    LOG_INFO("Saved frame {} ({}x{}) to {}", "Engine", m_frameCount, width, height, path);
 }
 
 void VulkanEngine::createBuffers() {
-    // Define a colorful 3D cube for fallback rendering
+    // Define a 3D cube for fallback rendering, four vertices per face so
+    // ColorMode::FACES gives each face its own color (listed per face) and
+    // every face has flat normals (tangents are generated below)
     std::vector<Vertex> vertices = {
         // Front face (red)
-        {{-0.5f, -0.5f,  0.5f}, {1.0f, 0.0f, 0.0f}, {0.0f, 0.0f}},  // Bottom left
-        {{ 0.5f, -0.5f,  0.5f}, {1.0f, 0.0f, 0.0f}, {1.0f, 0.0f}},  // Bottom right
-        {{ 0.5f,  0.5f,  0.5f}, {1.0f, 0.0f, 0.0f}, {1.0f, 1.0f}},  // Top right
-        {{-0.5f,  0.5f,  0.5f}, {1.0f, 0.0f, 0.0f}, {0.0f, 1.0f}},  // Top left
+        {{-0.5f, -0.5f,  0.5f}, {0.0f, 0.0f}, { 0.0f,  0.0f,  1.0f}, {}},  // Bottom left
+        {{ 0.5f, -0.5f,  0.5f}, {1.0f, 0.0f}, { 0.0f,  0.0f,  1.0f}, {}},  // Bottom right
+        {{ 0.5f,  0.5f,  0.5f}, {1.0f, 1.0f}, { 0.0f,  0.0f,  1.0f}, {}},  // Top right
+        {{-0.5f,  0.5f,  0.5f}, {0.0f, 1.0f}, { 0.0f,  0.0f,  1.0f}, {}},  // Top left
         
         // Back face (green)
-        {{ 0.5f, -0.5f, -0.5f}, {0.0f, 1.0f, 0.0f}, {0.0f, 0.0f}},  // Bottom left
-        {{-0.5f, -0.5f, -0.5f}, {0.0f, 1.0f, 0.0f}, {1.0f, 0.0f}},  // Bottom right
-        {{-0.5f,  0.5f, -0.5f}, {0.0f, 1.0f, 0.0f}, {1.0f, 1.0f}},  // Top right
-        {{ 0.5f,  0.5f, -0.5f}, {0.0f, 1.0f, 0.0f}, {0.0f, 1.0f}},  // Top left
+        {{ 0.5f, -0.5f, -0.5f}, {0.0f, 0.0f}, { 0.0f,  0.0f, -1.0f}, {}},  // Bottom left
+        {{-0.5f, -0.5f, -0.5f}, {1.0f, 0.0f}, { 0.0f,  0.0f, -1.0f}, {}},  // Bottom right
+        {{-0.5f,  0.5f, -0.5f}, {1.0f, 1.0f}, { 0.0f,  0.0f, -1.0f}, {}},  // Top right
+        {{ 0.5f,  0.5f, -0.5f}, {0.0f, 1.0f}, { 0.0f,  0.0f, -1.0f}, {}},  // Top left
         
         // Left face (blue)
-        {{-0.5f, -0.5f, -0.5f}, {0.0f, 0.0f, 1.0f}, {0.0f, 0.0f}},  // Bottom left
-        {{-0.5f, -0.5f,  0.5f}, {0.0f, 0.0f, 1.0f}, {1.0f, 0.0f}},  // Bottom right
-        {{-0.5f,  0.5f,  0.5f}, {0.0f, 0.0f, 1.0f}, {1.0f, 1.0f}},  // Top right
-        {{-0.5f,  0.5f, -0.5f}, {0.0f, 0.0f, 1.0f}, {0.0f, 1.0f}},  // Top left
+        {{-0.5f, -0.5f, -0.5f}, {0.0f, 0.0f}, {-1.0f,  0.0f,  0.0f}, {}},  // Bottom left
+        {{-0.5f, -0.5f,  0.5f}, {1.0f, 0.0f}, {-1.0f,  0.0f,  0.0f}, {}},  // Bottom right
+        {{-0.5f,  0.5f,  0.5f}, {1.0f, 1.0f}, {-1.0f,  0.0f,  0.0f}, {}},  // Top right
+        {{-0.5f,  0.5f, -0.5f}, {0.0f, 1.0f}, {-1.0f,  0.0f,  0.0f}, {}},  // Top left
         
         // Right face (yellow)
-        {{ 0.5f, -0.5f,  0.5f}, {1.0f, 1.0f, 0.0f}, {0.0f, 0.0f}},  // Bottom left
-        {{ 0.5f, -0.5f, -0.5f}, {1.0f, 1.0f, 0.0f}, {1.0f, 0.0f}},  // Bottom right
-        {{ 0.5f,  0.5f, -0.5f}, {1.0f, 1.0f, 0.0f}, {1.0f, 1.0f}},  // Top right
-        {{ 0.5f,  0.5f,  0.5f}, {1.0f, 1.0f, 0.0f}, {0.0f, 1.0f}},  // Top left
+        {{ 0.5f, -0.5f,  0.5f}, {0.0f, 0.0f}, { 1.0f,  0.0f,  0.0f}, {}},  // Bottom left
+        {{ 0.5f, -0.5f, -0.5f}, {1.0f, 0.0f}, { 1.0f,  0.0f,  0.0f}, {}},  // Bottom right
+        {{ 0.5f,  0.5f, -0.5f}, {1.0f, 1.0f}, { 1.0f,  0.0f,  0.0f}, {}},  // Top right
+        {{ 0.5f,  0.5f,  0.5f}, {0.0f, 1.0f}, { 1.0f,  0.0f,  0.0f}, {}},  // Top left
         
         // Top face (magenta)
-        {{-0.5f,  0.5f,  0.5f}, {1.0f, 0.0f, 1.0f}, {0.0f, 0.0f}},  // Bottom left
-        {{ 0.5f,  0.5f,  0.5f}, {1.0f, 0.0f, 1.0f}, {1.0f, 0.0f}},  // Bottom right
-        {{ 0.5f,  0.5f, -0.5f}, {1.0f, 0.0f, 1.0f}, {1.0f, 1.0f}},  // Top right
-        {{-0.5f,  0.5f, -0.5f}, {1.0f, 0.0f, 1.0f}, {0.0f, 1.0f}},  // Top left
+        {{-0.5f,  0.5f,  0.5f}, {0.0f, 0.0f}, { 0.0f,  1.0f,  0.0f}, {}},  // Bottom left
+        {{ 0.5f,  0.5f,  0.5f}, {1.0f, 0.0f}, { 0.0f,  1.0f,  0.0f}, {}},  // Bottom right
+        {{ 0.5f,  0.5f, -0.5f}, {1.0f, 1.0f}, { 0.0f,  1.0f,  0.0f}, {}},  // Top right
+        {{-0.5f,  0.5f, -0.5f}, {0.0f, 1.0f}, { 0.0f,  1.0f,  0.0f}, {}},  // Top left
         
         // Bottom face (cyan)
-        {{-0.5f, -0.5f, -0.5f}, {0.0f, 1.0f, 1.0f}, {0.0f, 0.0f}},  // Bottom left
-        {{ 0.5f, -0.5f, -0.5f}, {0.0f, 1.0f, 1.0f}, {1.0f, 0.0f}},  // Bottom right
-        {{ 0.5f, -0.5f,  0.5f}, {0.0f, 1.0f, 1.0f}, {1.0f, 1.0f}},  // Top right
-        {{-0.5f, -0.5f,  0.5f}, {0.0f, 1.0f, 1.0f}, {0.0f, 1.0f}}   // Top left
+        {{-0.5f, -0.5f, -0.5f}, {0.0f, 0.0f}, { 0.0f, -1.0f,  0.0f}, {}},  // Bottom left
+        {{ 0.5f, -0.5f, -0.5f}, {1.0f, 0.0f}, { 0.0f, -1.0f,  0.0f}, {}},  // Bottom right
+        {{ 0.5f, -0.5f,  0.5f}, {1.0f, 1.0f}, { 0.0f, -1.0f,  0.0f}, {}},  // Top right
+        {{-0.5f, -0.5f,  0.5f}, {0.0f, 1.0f}, { 0.0f, -1.0f,  0.0f}, {}}   // Top left
     };
     
     // Define indices for the cube (2 triangles per face, 6 faces)
@@ -500,128 +575,251 @@ void VulkanEngine::createBuffers() {
         20, 21, 22, 22, 23, 20
     };
     
+    // Tangents along the texture U axis of each face
+    MeshProcessing::generateTangents(vertices, indices);
+    
     // Create vertex buffer
-    m_vertexBuffer = BufferUtils::createVertexBuffer(
-        m_device.getLogicalDevice(),
-        m_device.getPhysicalDevice(),
-        m_commandPool.getCommandPool(),
-        m_device.getGraphicsQueue(),
-        vertices
-    );
+    m_vertexBuffer = m_backend->createBuffer(BufferType::VERTEX, vertices.data(),
+                                             vertices.size() * sizeof(Vertex));
     
     // Create index buffer
-    m_indexBuffer = BufferUtils::createIndexBuffer(
-        m_device.getLogicalDevice(),
-        m_device.getPhysicalDevice(),
-        m_commandPool.getCommandPool(),
-        m_device.getGraphicsQueue(),
-        indices
-    );
+    m_indexBuffer = m_backend->createBuffer(BufferType::INDEX, indices.data(),
+                                            indices.size() * sizeof(uint32_t));
     
     LOG_DEBUG("Fallback cube buffers created", "Engine");
 }
 
-void VulkanEngine::loadMainCharacter() {
-    LOG_INFO("Attempting to load main character from assets/FinalBaseMesh.obj", "Engine");
+void VulkanEngine::parseMainCharacter() {
+    LOG_INFO("Attempting to load main character from {}", "Engine", MAIN_CHARACTER_PATH);
+    
+    // loadGeometry reports its own failures; the upload step falls back to the cube
+    m_useMainCharacter = m_mainCharacter.loadGeometry(MAIN_CHARACTER_PATH);
+}
+
+void VulkanEngine::uploadMainCharacter() {
+    if (!m_useMainCharacter) {
+        LOG_WARN("Failed to load main character, falling back to cube", "Engine");
+        return;
+    }
     
     try {
-        bool loaded = m_mainCharacter.loadFromOBJ(
-            "assets/FinalBaseMesh.obj",
-            m_device.getLogicalDevice(),
-            m_device.getPhysicalDevice(),
-            m_commandPool.getCommandPool(),
-            m_device.getGraphicsQueue()
-        );
-        
-        if (loaded) {
-            m_useMainCharacter = true;
+        m_useMainCharacter = m_mainCharacter.upload(*m_backend);
+        if (m_useMainCharacter) {
             LOG_INFO("Main character loaded successfully", "Engine");
         } else {
-            m_useMainCharacter = false;
-            LOG_WARN("Failed to load main character, falling back to cube", "Engine");
+            LOG_WARN("Failed to upload main character, falling back to cube", "Engine");
         }
-        
     } catch (const std::exception& e) {
         m_useMainCharacter = false;
         LOG_WARN("Exception loading main character: " + std::string(e.what()) + ", falling back to cube", "Engine");
     }
 }
 
+bool VulkanEngine::enableHotReload() {
+    if (!m_initialized) {
+        throw std::runtime_error("Cannot enable hot reload before the engine is initialized");
+    }
+    if (m_hotReload) {
+        return true;
+    }
+    
+    auto hotReload = std::make_unique<HotReload>();
+    const bool watchingAssets = hotReload->watcher.watch("assets", ".obj") &&
+                                hotReload->watcher.watch("assets", MeshAsset::EXTENSION);
+    const bool watchingShaders = hotReload->watcher.watch("shaders", ".spv");
+    if (!watchingAssets && !watchingShaders) {
+        LOG_WARN("Hot reload disabled: neither assets/ nor shaders/ can be watched", "HotReload");
+        return false;
+    }
+    
+    LOG_INFO("Hot reload enabled ({}): {}, {}", "HotReload",
+             FileWatcher::isNative() ? "inotify" : "polling write times",
+             MAIN_CHARACTER_PATH, m_pipelineDesc.vertexShaderPath + ", " + m_pipelineDesc.fragmentShaderPath);
+    m_hotReload = std::move(hotReload);
+    return true;
+}
+
+void VulkanEngine::updateHotReload() {
+    PROFILE_ZONE("HotReload");
+    // Hot reload is a development feature: its polling, loads and swaps may allocate and create Vulkan objects
+    ALLOW_ALLOCATIONS();
+    VK_ALLOW_HAZARDS();
+    HotReload& hotReload = *m_hotReload;
+    
+    hotReload.changed.clear();
+    hotReload.watcher.poll(hotReload.changed);
+    if (!hotReload.changed.empty()) {
+        const std::string cookedPath = MeshAsset::getCookedPath(MAIN_CHARACTER_PATH);
+        bool meshChanged = false;
+        bool shadersChanged = false;
+        for (const std::string& path : hotReload.changed) {
+            LOG_DEBUG("Changed on disk: {}", "HotReload", path);
+            meshChanged = meshChanged || path == MAIN_CHARACTER_PATH || path == cookedPath;
+            shadersChanged = shadersChanged || path == m_pipelineDesc.vertexShaderPath ||
+                             path == m_pipelineDesc.fragmentShaderPath;
+        }
+        // Both shaders reload together; compilers usually rewrite them in one go
+        if (meshChanged) {
+            reloadMainCharacter();
+        }
+        if (shadersChanged) {
+            reloadShaders();
+        }
+    }
+    
+    std::vector<std::function<void()>> ready;
+    {
+        std::lock_guard<std::mutex> lock(hotReload.mutex);
+        ready.swap(hotReload.ready);
+    }
+    for (const std::function<void()>& swap : ready) {
+        swap();
+    }
+}
+
+void VulkanEngine::startHotReload(std::function<std::function<void()>()> load) {
+    HotReload& hotReload = *m_hotReload;
+    hotReload.running.fetch_add(1, std::memory_order_relaxed);
+    ThreadPool::getInstance().submit([&hotReload, load = std::move(load)] {
+        std::function<void()> swap;
+        try {
+            swap = load();
+        } catch (const std::exception& e) {
+            LOG_ERROR("Hot reload failed: {}", "HotReload", e.what());
+        }
+        if (swap) {
+            std::lock_guard<std::mutex> lock(hotReload.mutex);
+            hotReload.ready.push_back(std::move(swap));
+        }
+        hotReload.running.fetch_sub(1, std::memory_order_release);
+    });
+}
+
+void VulkanEngine::reloadMainCharacter() {
+    const uint64_t generation = ++m_hotReload->meshGeneration;
+    LOG_INFO("Reloading {}", "HotReload", MAIN_CHARACTER_PATH);
+    startHotReload([this, generation]() -> std::function<void()> {
+        auto vertices = std::make_shared<std::vector<Vertex>>();
+        auto indices = std::make_shared<std::vector<uint32_t>>();
+        if (!MainCharacter::readGeometry(MAIN_CHARACTER_PATH, *vertices, *indices)) {
+            LOG_WARN("Keeping the current character: {} did not load", "HotReload", MAIN_CHARACTER_PATH);
+            return nullptr;
+        }
+        return [this, generation, vertices, indices] {
+            if (generation != m_hotReload->meshGeneration) {
+                return;     // The file changed again; a newer load replaces this one
+            }
+            if (m_mainCharacter.replaceGeometry(*m_backend, std::move(*vertices), std::move(*indices))) {
+                m_useMainCharacter = true;
+            }
+        };
+    });
+}
+
+void VulkanEngine::reloadShaders() {
+    const uint64_t generation = ++m_hotReload->shaderGeneration;
+    auto desc = std::make_shared<PipelineDesc>();
+    desc->vertexShaderPath = m_pipelineDesc.vertexShaderPath;
+    desc->fragmentShaderPath = m_pipelineDesc.fragmentShaderPath;
+    LOG_INFO("Reloading {} and {}", "HotReload", desc->vertexShaderPath, desc->fragmentShaderPath);
+    startHotReload([this, generation, desc]() -> std::function<void()> {
+        if (!readSpirv(desc->vertexShaderPath, desc->vertexShaderCode) ||
+            !readSpirv(desc->fragmentShaderPath, desc->fragmentShaderCode)) {
+            LOG_WARN("Keeping the current pipeline: shaders did not load", "HotReload");
+            return nullptr;
+        }
+        return [this, generation, desc] {
+            if (generation != m_hotReload->shaderGeneration) {
+                return;
+            }
+            // Pipeline creation compiles the shaders, so it happens here, on the thread that owns the backend
+            try {
+                m_backend->replacePipeline(m_pipeline, *desc);
+                m_pipelineDesc = std::move(*desc);
+                LOG_INFO("Pipeline rebuilt from reloaded shaders", "HotReload");
+            } catch (const std::exception& e) {
+                LOG_ERROR("Keeping the current pipeline: {}", "HotReload", e.what());
+            }
+        };
+    });
+}
+
+void VulkanEngine::stopHotReload() {
+    if (!m_hotReload) {
+        return;
+    }
+    while (m_hotReload->running.load(std::memory_order_acquire) > 0) {
+        std::this_thread::yield();
+    }
+    m_hotReload.reset();
+}
+
 void VulkanEngine::createUniformBuffers() {
     // Create one uniform buffer per frame in flight
     m_uniformBuffers.resize(MAX_FRAMES_IN_FLIGHT);
     
+    UniformBufferObject ubo{};
     for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
-        m_uniformBuffers[i] = BufferUtils::createUniformBuffer(
-            m_device.getLogicalDevice(),
-            m_device.getPhysicalDevice()
-        );
+        m_uniformBuffers[i] = m_backend->createBuffer(BufferType::UNIFORM, &ubo, sizeof(ubo));
     }
 }
 
-void VulkanEngine::createCommandBuffers() {
-    m_commandBuffers = m_commandPool.allocateCommandBuffers(MAX_FRAMES_IN_FLIGHT);
-}
-
-void VulkanEngine::recordCommandBuffer(VkCommandBuffer commandBuffer, uint32_t imageIndex) {
-    // Begin recording
-    m_commandPool.beginCommandBuffer(commandBuffer, VulkanCommandPool::Usage::SINGLE_USE);
+void VulkanEngine::recordCommands(CommandList& commandList) {
+    // No-op once the list has grown to the scene's size, so steady-state frames do not allocate
+    commandList.reserve(COMMAND_LIST_CAPACITY + m_scene.getCommandCount(), m_scene.getStats().objects + 1);
     
-    // Set up render area
-    VkRect2D renderArea{};
-    renderArea.offset = {0, 0};
-    renderArea.extent = m_swapchain.getExtent();
+    commandList.beginZone("MainPass");
+    commandList.beginPass(0.0f, 0.0f, 0.0f, 1.0f);  // Clear color (black)
     
-    // Clear values
-    std::vector<VkClearValue> clearValues(2);
-    clearValues[0].color = {{0.0f, 0.0f, 0.0f, 1.0f}};  // Clear color (black)
-    clearValues[1].depthStencil = {1.0f, 0};             // Clear depth
+    commandList.bindPipeline(m_pipeline);
+    commandList.setFullViewport();
+    commandList.bindUniforms(m_uniformBuffers[m_currentFrame]);
     
-    // Get the framebuffer for this image index
-    const std::vector<VkFramebuffer>& framebuffers = m_renderPass.getFramebuffers();
-    if (imageIndex >= framebuffers.size()) {
-        throw std::runtime_error("Image index out of range for framebuffers");
-    }
-    
-    // Determine which buffers to use for rendering
-    VkBuffer vertexBuffer;
-    VkBuffer indexBuffer;
-    uint32_t indexCount;
-    
-    if (m_useMainCharacter && m_mainCharacter.isLoaded()) {
-        vertexBuffer = m_mainCharacter.getVertexBuffer().getBuffer();
-        indexBuffer = m_mainCharacter.getIndexBuffer().getBuffer();
-        indexCount = m_mainCharacter.getIndexCount();
+    if (!m_scene.empty()) {
+        commandList.beginZone("Scene");
+        m_scene.record(commandList);
+        commandList.endZone();
+        
+        m_recordedDraws = m_scene.getStats().drawsPerFrame;
+        m_recordedTriangles = m_scene.getStats().trianglesPerFrame;
     } else {
-        vertexBuffer = m_vertexBuffer.getBuffer();
-        indexBuffer = m_indexBuffer.getBuffer();
-        indexCount = 36; // 12 triangles * 3 indices for cube
-    }
-    
-    // Use descriptor sets for uniform buffer binding
-    std::vector<VkDescriptorSet> descriptorSets = {m_descriptorSets[m_currentFrame]};
-    
-    // Record frame commands
-    m_commandPool.recordFrameCommands(
-        commandBuffer,
-        m_renderPass.getRenderPass(),
-        framebuffers[imageIndex],       // Use correct framebuffer for this image
-        m_pipeline.getPipeline(),
-        m_pipeline.getPipelineLayout(),
-        renderArea,
-        clearValues,
-        {vertexBuffer},                // Vertex buffers
-        {0},                           // Vertex buffer offsets
-        indexBuffer,                   // Index buffer
-        0,                             // Index buffer offset
-        descriptorSets,                // Descriptor sets for uniform buffers
-        0,                             // Vertex count (using indexed drawing)
-        indexCount,                    // Index count
-        1                              // Instance count
-    );
+        // Determine which buffers to use for rendering
+        BufferHandle vertexBuffer;
+        BufferHandle indexBuffer;
+        uint32_t indexCount;
+        ColorMode colorMode;
+        
+        const bool drawCharacter = m_useMainCharacter && m_mainCharacter.isLoaded();
+        if (drawCharacter) {
+            vertexBuffer = m_mainCharacter.getVertexBuffer();
+            indexBuffer = m_mainCharacter.getIndexBuffer();
+            indexCount = m_mainCharacter.getIndexCount();
+            colorMode = m_mainCharacter.getColorMode();
+        } else {
+            vertexBuffer = m_vertexBuffer;
+            indexBuffer = m_indexBuffer;
+            indexCount = 36; // 12 triangles * 3 indices for cube
+            colorMode = ColorMode::FACES;
+        }
+        
+        ObjectConstants constants;
+        constants.model = m_modelMatrix;
+        constants.tint = glm::vec4(1.0f);
+        constants.colorMode = colorMode;
+        
+        commandList.beginZone(drawCharacter ? "MainCharacter" : "FallbackCube");
+        commandList.bindVertexBuffer(vertexBuffer);
+        commandList.bindIndexBuffer(indexBuffer);
+        commandList.pushObjectConstants(constants);
+        commandList.drawIndexed(indexCount);
+        commandList.endZone();
+        
+        m_recordedDraws = 1;
+        m_recordedTriangles = indexCount / 3;
+    }
     
-    // End recording
-    m_commandPool.endCommandBuffer(commandBuffer);
+    commandList.endPass();
+    commandList.endZone();
 }
 
 void VulkanEngine::updateUniformBuffer(uint32_t currentImage) {
@@ -630,51 +828,7 @@ void VulkanEngine::updateUniformBuffer(uint32_t currentImage) {
     ubo.view = m_viewMatrix;
     ubo.projection = m_projectionMatrix;
     
-    m_uniformBuffers[currentImage].uploadData(&ubo, sizeof(ubo));
-}
-
-void VulkanEngine::recreateSwapchain() {
-    VulkanUtils::logObjectCreation("VulkanEngine", "Recreating swapchain");
-    
-    // Wait for device to be idle
-    waitIdle();
-    
-    // Clean up old swapchain-dependent resources
-    m_renderPass.cleanup();
-    m_pipeline.cleanup();
-    
-    // Clean up old depth buffer
-    if (m_depthImageView != VK_NULL_HANDLE) {
-        vkDestroyImageView(m_device.getLogicalDevice(), m_depthImageView, nullptr);
-        m_depthImageView = VK_NULL_HANDLE;
-    }
-    if (m_depthImage != VK_NULL_HANDLE) {
-        vkDestroyImage(m_device.getLogicalDevice(), m_depthImage, nullptr);
-        m_depthImage = VK_NULL_HANDLE;
-    }
-    if (m_depthImageMemory != VK_NULL_HANDLE) {
-        vkFreeMemory(m_device.getLogicalDevice(), m_depthImageMemory, nullptr);
-        m_depthImageMemory = VK_NULL_HANDLE;
-    }
-    
-    m_swapchain.cleanup();
-    
-    // Recreate swapchain
-    m_swapchain.create(m_device, m_surface, m_windowWidth, m_windowHeight);
-    
-    // Recreate render pass
-    VkFormat depthFormat = VK_FORMAT_D32_SFLOAT; // Use same depth format as initialization
-    m_renderPass.create(m_device.getLogicalDevice(), m_swapchain.getImageFormat(), depthFormat);
-    
-    // Recreate depth buffer and framebuffers
-    createDepthBuffer();
-    m_renderPass.createFramebuffers(m_swapchain.getImageViews(), m_depthImageView, m_swapchain.getExtent());
-    
-    // Recreate pipeline
-    m_pipeline.createGraphicsPipeline(m_device.getLogicalDevice(), m_renderPass.getRenderPass(),
-                     "shaders/vertex.vert.spv", "shaders/fragment.frag.spv", m_swapchain.getExtent());
-    
-    LOG_INFO("Swapchain recreated successfully", "Engine");
+    m_backend->updateBuffer(m_uniformBuffers[currentImage], &ubo, sizeof(ubo));
 }
 
 void VulkanEngine::setupScene() {
@@ -687,10 +841,11 @@ void VulkanEngine::setupScene() {
      * - Field of View: 45 degrees (good balance between wide view and distortion)
      * - Aspect Ratio: width/height (maintains proper proportions)
      * - Near Plane: 0.1 units (closest visible distance)
-     * - Far Plane: 50.0 units (increased to accommodate 10-unit camera offset)
+     * - Far Plane: 50.0 units by default (accommodates the 10-unit camera offset),
+     *   raised with setViewDistance() for large scenes
      */
     float aspectRatio = static_cast<float>(m_windowWidth) / static_cast<float>(m_windowHeight);
-    m_projectionMatrix = glm::perspective(glm::radians(45.0f), aspectRatio, 0.1f, 50.0f);
+    m_projectionMatrix = glm::perspective(glm::radians(45.0f), aspectRatio, 0.1f, m_viewDistance);
     
     /**
      * Vulkan Coordinate System Adjustment:
@@ -722,20 +877,22 @@ void VulkanEngine::setupScene() {
     LOG_DEBUG("  - Field of view: 45 degrees", "Engine");
     LOG_DEBUG("  - Aspect ratio: " + std::to_string(aspectRatio), "Engine");
     LOG_DEBUG("  - Near plane: 0.1 units", "Engine");
-    LOG_DEBUG("  - Far plane: 50.0 units", "Engine");
+    LOG_DEBUG("  - Far plane: {} units", "Engine", m_viewDistance);
     LOG_DEBUG("  - Camera position: (10, 5, 10)", "Engine");
     LOG_DEBUG("  - Camera target: (0, 0, 0)", "Engine");
 }
 
 bool VulkanEngine::needsSwapchainRecreation() const {
     // Check if window is minimized (zero size)
-    if (m_windowWidth == 0 || m_windowHeight == 0) {
+    if (m_windowWidth == 0 || m_windowHeight == 0 || !m_backend) {
         return false; // Don't recreate for minimized windows
     }
     
     // Check if current swapchain extent matches window size
-    VkExtent2D currentExtent = m_swapchain.getExtent();
-    return (currentExtent.width != m_windowWidth || currentExtent.height != m_windowHeight);
+    uint32_t width = 0;
+    uint32_t height = 0;
+    m_backend->getRenderExtent(width, height);
+    return (width != m_windowWidth || height != m_windowHeight);
 }
 
 void VulkanEngine::getFrameStats(float& fps, float& frameTime) const {
@@ -743,160 +900,27 @@ void VulkanEngine::getFrameStats(float& fps, float& frameTime) const {
     fps = (m_lastFrameTime > 0.0f) ? (1.0f / m_lastFrameTime) : 0.0f;
 }
 
-void VulkanEngine::logInitializationState(InitializationState state, const std::string& operation) {
-    LOG_DEBUG("[VulkanEngine] " + operation + "...", "Engine");
-}
-
-void VulkanEngine::createDescriptorSets() {
-    // Create descriptor pool
-    VkDescriptorPoolSize poolSize{};
-    poolSize.type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-    poolSize.descriptorCount = static_cast<uint32_t>(MAX_FRAMES_IN_FLIGHT);
-    
-    VkDescriptorPoolCreateInfo poolInfo{};
-    poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
-    poolInfo.poolSizeCount = 1;
-    poolInfo.pPoolSizes = &poolSize;
-    poolInfo.maxSets = static_cast<uint32_t>(MAX_FRAMES_IN_FLIGHT);
-    
-    VK_CHECK(vkCreateDescriptorPool(m_device.getLogicalDevice(), &poolInfo, nullptr, &m_descriptorPool),
-             "Failed to create descriptor pool");
-    
-    VulkanUtils::logObjectCreation("VkDescriptorPool", "Created for uniform buffers");
-    
-    // Allocate descriptor sets using the pipeline's descriptor set layout
-    VkDescriptorSetLayout pipelineLayout = m_pipeline.getDescriptorSetLayout();
-    std::vector<VkDescriptorSetLayout> layouts(MAX_FRAMES_IN_FLIGHT, pipelineLayout);
-    
-    VkDescriptorSetAllocateInfo allocInfo{};
-    allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-    allocInfo.descriptorPool = m_descriptorPool;
-    allocInfo.descriptorSetCount = static_cast<uint32_t>(MAX_FRAMES_IN_FLIGHT);
-    allocInfo.pSetLayouts = layouts.data();
-    
-    m_descriptorSets.resize(MAX_FRAMES_IN_FLIGHT);
-    VK_CHECK(vkAllocateDescriptorSets(m_device.getLogicalDevice(), &allocInfo, m_descriptorSets.data()),
-             "Failed to allocate descriptor sets");
-    
-    VulkanUtils::logObjectCreation("DescriptorSets", 
-        "Allocated " + std::to_string(MAX_FRAMES_IN_FLIGHT) + " descriptor sets");
-}
-
-void VulkanEngine::updateDescriptorSets() {
-    for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
-        VkDescriptorBufferInfo bufferInfo{};
-        bufferInfo.buffer = m_uniformBuffers[i].getBuffer();
-        bufferInfo.offset = 0;
-        bufferInfo.range = sizeof(UniformBufferObject);
-        
-        VkWriteDescriptorSet descriptorWrite{};
-        descriptorWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-        descriptorWrite.dstSet = m_descriptorSets[i];
-        descriptorWrite.dstBinding = 0;
-        descriptorWrite.dstArrayElement = 0;
-        descriptorWrite.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-        descriptorWrite.descriptorCount = 1;
-        descriptorWrite.pBufferInfo = &bufferInfo;
-        
-        vkUpdateDescriptorSets(m_device.getLogicalDevice(), 1, &descriptorWrite, 0, nullptr);
-    }
-    
-    VulkanUtils::logObjectCreation("DescriptorSets", "Updated with uniform buffer bindings");
-}
-
-void VulkanEngine::createDepthBuffer() {
-    VkFormat depthFormat = findDepthFormat();
-    
-    // Create depth image
-    VkImageCreateInfo imageInfo{};
-    imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
-    imageInfo.imageType = VK_IMAGE_TYPE_2D;
-    imageInfo.extent.width = m_swapchain.getExtent().width;
-    imageInfo.extent.height = m_swapchain.getExtent().height;
-    imageInfo.extent.depth = 1;
-    imageInfo.mipLevels = 1;
-    imageInfo.arrayLayers = 1;
-    imageInfo.format = depthFormat;
-    imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
-    imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-    imageInfo.usage = VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
-    imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
-    imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-
-    VK_CHECK(vkCreateImage(m_device.getLogicalDevice(), &imageInfo, nullptr, &m_depthImage),
-             "Failed to create depth image");
-
-    // Allocate memory for depth image
-    VkMemoryRequirements memRequirements;
-    vkGetImageMemoryRequirements(m_device.getLogicalDevice(), m_depthImage, &memRequirements);
-
-    // Find suitable memory type
-    VkPhysicalDeviceMemoryProperties memProperties;
-    vkGetPhysicalDeviceMemoryProperties(m_device.getPhysicalDevice(), &memProperties);
-    
-    uint32_t memoryTypeIndex = UINT32_MAX;
-    for (uint32_t i = 0; i < memProperties.memoryTypeCount; i++) {
-        if ((memRequirements.memoryTypeBits & (1 << i)) && 
-            (memProperties.memoryTypes[i].propertyFlags & VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT) == VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT) {
-            memoryTypeIndex = i;
-            break;
-        }
-    }
-    
-    if (memoryTypeIndex == UINT32_MAX) {
-        throw std::runtime_error("Failed to find suitable memory type for depth buffer");
-    }
-
-    VkMemoryAllocateInfo allocInfo{};
-    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-    allocInfo.allocationSize = memRequirements.size;
-    allocInfo.memoryTypeIndex = memoryTypeIndex;
-
-    VK_CHECK(vkAllocateMemory(m_device.getLogicalDevice(), &allocInfo, nullptr, &m_depthImageMemory),
-             "Failed to allocate depth image memory");
-
-    vkBindImageMemory(m_device.getLogicalDevice(), m_depthImage, m_depthImageMemory, 0);
-
-    // Create depth image view
-    VkImageViewCreateInfo viewInfo{};
-    viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
-    viewInfo.image = m_depthImage;
-    viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
-    viewInfo.format = depthFormat;
-    viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT;
-    viewInfo.subresourceRange.baseMipLevel = 0;
-    viewInfo.subresourceRange.levelCount = 1;
-    viewInfo.subresourceRange.baseArrayLayer = 0;
-    viewInfo.subresourceRange.layerCount = 1;
-
-    VK_CHECK(vkCreateImageView(m_device.getLogicalDevice(), &viewInfo, nullptr, &m_depthImageView),
-             "Failed to create depth image view");
-
-    LOG_DEBUG("Depth buffer created successfully", "Engine");
-}
-
-VkFormat VulkanEngine::findDepthFormat() {
-    return findSupportedFormat(
-        {VK_FORMAT_D32_SFLOAT, VK_FORMAT_D32_SFLOAT_S8_UINT, VK_FORMAT_D24_UNORM_S8_UINT},
-        VK_IMAGE_TILING_OPTIMAL,
-        VK_FORMAT_FEATURE_DEPTH_STENCIL_ATTACHMENT_BIT
-    );
-}
-
-VkFormat VulkanEngine::findSupportedFormat(const std::vector<VkFormat>& candidates,
-                                          VkImageTiling tiling, VkFormatFeatureFlags features) {
-    for (VkFormat format : candidates) {
-        VkFormatProperties props;
-        vkGetPhysicalDeviceFormatProperties(m_device.getPhysicalDevice(), format, &props);
-
-        if (tiling == VK_IMAGE_TILING_LINEAR && (props.linearTilingFeatures & features) == features) {
-            return format;
-        } else if (tiling == VK_IMAGE_TILING_OPTIMAL && (props.optimalTilingFeatures & features) == features) {
-            return format;
-        }
-    }
-
-    throw std::runtime_error("Failed to find supported format");
+void VulkanEngine::getFrameStats(FrameStats& stats) const {
+    getFrameStats(stats.fps, stats.cpuFrameTimeMs);
+    stats.commandCount = static_cast<uint32_t>(m_commandList.size());
+    stats.recordedDraws = m_recordedDraws;
+    stats.recordedTriangles = m_recordedTriangles;
+    stats.fenceWaitMs = m_lastFenceWaitTime * 1000.0f;
+    stats.gpuBound = m_lastFrameTime > 0.0f && m_lastFenceWaitTime > 0.5f * m_lastFrameTime;
+    
+    if (m_backend) {
+        const GpuProfiler::FrameResults& gpuResults = m_backend->getGpuResults();
+        stats.gpuTimeValid = gpuResults.valid;
+        stats.gpuTimeMs = static_cast<float>(gpuResults.gpuTimeMs);
+        stats.hasPipelineStatistics = gpuResults.hasStatistics;
+        stats.pipelineStatistics = gpuResults.statistics;
+    }
+    
+    const VulkanCallStats::FrameCounts& calls = VulkanCallStats::getLastFrame();
+    stats.vulkanCalls = calls.totalCalls;
+    stats.drawCalls = calls.drawCalls;
+    stats.vulkanCpuMs = static_cast<float>(calls.totalTimeNs / 1.0e6);
+    stats.vulkanHazards = calls.hazards;
 }
 
-} // namespace VulkanGameEngine
\ No newline at end of file
+} // namespace VulkanGameEngine
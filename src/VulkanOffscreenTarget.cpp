@@ -0,0 +1,230 @@
+#include "../headers/VulkanOffscreenTarget.h"
+#include "../headers/VulkanUtils.h"
+#include "../headers/VulkanBuffer.h"
+#include "../headers/VulkanCommandPool.h"
+#include "../headers/VulkanCallStats.h"
+#include <cstdio>
+
+namespace VulkanGameEngine {
+
+VulkanOffscreenTarget::VulkanOffscreenTarget()
+    : m_device(VK_NULL_HANDLE)
+    , m_physicalDevice(VK_NULL_HANDLE)
+    , m_imageFormat(VK_FORMAT_UNDEFINED)
+    , m_extent{0, 0} {
+}
+
+VulkanOffscreenTarget::~VulkanOffscreenTarget() {
+    cleanup();
+}
+
+void VulkanOffscreenTarget::create(const VulkanDevice& device, uint32_t width, uint32_t height,
+                                   uint32_t imageCount, VkFormat format) {
+    m_device = device.getLogicalDevice();
+    m_physicalDevice = device.getPhysicalDevice();
+    m_imageFormat = format;
+    m_extent = {width, height};
+
+    m_images.resize(imageCount, VK_NULL_HANDLE);
+    m_imageMemory.resize(imageCount, VK_NULL_HANDLE);
+    m_imageViews.resize(imageCount, VK_NULL_HANDLE);
+
+    for (uint32_t i = 0; i < imageCount; ++i) {
+        VkImageCreateInfo imageInfo{};
+        imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+        imageInfo.imageType = VK_IMAGE_TYPE_2D;
+        imageInfo.extent.width = width;
+        imageInfo.extent.height = height;
+        imageInfo.extent.depth = 1;
+        imageInfo.mipLevels = 1;
+        imageInfo.arrayLayers = 1;
+        imageInfo.format = format;
+        imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+        imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        // Rendered into by the render pass, then copied out for readback
+        imageInfo.usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+        imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+        imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+        VK_CHECK(vkCreateImage(m_device, &imageInfo, nullptr, &m_images[i]),
+                 "Failed to create offscreen color image");
+
+        VkMemoryRequirements memRequirements;
+        vkGetImageMemoryRequirements(m_device, m_images[i], &memRequirements);
+
+        VkMemoryAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+        allocInfo.allocationSize = memRequirements.size;
+        allocInfo.memoryTypeIndex = findMemoryType(memRequirements.memoryTypeBits,
+                                                   VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+        VK_CHECK(VK_TRACKED(AllocateMemory, vkAllocateMemory(m_device, &allocInfo, nullptr, &m_imageMemory[i])),
+                 "Failed to allocate offscreen color image memory");
+        VK_CHECK(vkBindImageMemory(m_device, m_images[i], m_imageMemory[i], 0),
+                 "Failed to bind offscreen color image memory");
+
+        VkImageViewCreateInfo viewInfo{};
+        viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+        viewInfo.image = m_images[i];
+        viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+        viewInfo.format = format;
+        viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        viewInfo.subresourceRange.baseMipLevel = 0;
+        viewInfo.subresourceRange.levelCount = 1;
+        viewInfo.subresourceRange.baseArrayLayer = 0;
+        viewInfo.subresourceRange.layerCount = 1;
+
+        VK_CHECK(vkCreateImageView(m_device, &viewInfo, nullptr, &m_imageViews[i]),
+                 "Failed to create offscreen color image view");
+    }
+
+    VulkanUtils::logObjectCreation("VulkanOffscreenTarget",
+        std::to_string(imageCount) + " color images, " +
+        std::to_string(width) + "x" + std::to_string(height));
+}
+
+void VulkanOffscreenTarget::cleanup() {
+    if (m_device == VK_NULL_HANDLE) {
+        return;
+    }
+
+    for (VkImageView imageView : m_imageViews) {
+        if (imageView != VK_NULL_HANDLE) {
+            vkDestroyImageView(m_device, imageView, nullptr);
+        }
+    }
+    for (VkImage image : m_images) {
+        if (image != VK_NULL_HANDLE) {
+            vkDestroyImage(m_device, image, nullptr);
+        }
+    }
+    for (VkDeviceMemory memory : m_imageMemory) {
+        if (memory != VK_NULL_HANDLE) {
+            VK_TRACKED(FreeMemory, vkFreeMemory(m_device, memory, nullptr));
+        }
+    }
+
+    m_imageViews.clear();
+    m_images.clear();
+    m_imageMemory.clear();
+    m_extent = {0, 0};
+    m_device = VK_NULL_HANDLE;
+    m_physicalDevice = VK_NULL_HANDLE;
+
+    VulkanUtils::logObjectDestruction("VulkanOffscreenTarget");
+}
+
+void VulkanOffscreenTarget::readback(VulkanCommandPool& commandPool, VkQueue queue, uint32_t imageIndex,
+                                     std::vector<uint8_t>& pixels) const {
+    if (imageIndex >= m_images.size()) {
+        throw std::runtime_error("Offscreen image index out of range");
+    }
+
+    const VkDeviceSize byteCount = static_cast<VkDeviceSize>(m_extent.width) * m_extent.height * 4;
+
+    VulkanBuffer readbackBuffer;
+    readbackBuffer.create(m_device, m_physicalDevice, byteCount,
+                          VulkanBuffer::Usage::READBACK_BUFFER, VulkanBuffer::MemoryProperty::STAGING);
+
+    VkCommandBuffer commandBuffer = commandPool.beginSingleTimeCommands();
+
+    // Make the render pass's color writes visible to the transfer (layout is already TRANSFER_SRC)
+    VkImageMemoryBarrier imageBarrier{};
+    imageBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    imageBarrier.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+    imageBarrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+    imageBarrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+    imageBarrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+    imageBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    imageBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    imageBarrier.image = m_images[imageIndex];
+    imageBarrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    imageBarrier.subresourceRange.levelCount = 1;
+    imageBarrier.subresourceRange.layerCount = 1;
+    commandPool.pipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                                VK_PIPELINE_STAGE_TRANSFER_BIT, 0, {}, {}, {imageBarrier});
+
+    VkBufferImageCopy region{};
+    region.bufferOffset = 0;
+    region.bufferRowLength = 0;     // Tightly packed
+    region.bufferImageHeight = 0;
+    region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    region.imageSubresource.mipLevel = 0;
+    region.imageSubresource.baseArrayLayer = 0;
+    region.imageSubresource.layerCount = 1;
+    region.imageOffset = {0, 0, 0};
+    region.imageExtent = {m_extent.width, m_extent.height, 1};
+    VK_TRACKED(CmdCopyImageToBuffer, vkCmdCopyImageToBuffer(commandBuffer, m_images[imageIndex],
+                                                            VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                                                            readbackBuffer.getBuffer(), 1, &region));
+
+    // Make the copy visible to host reads after the wait
+    VkBufferMemoryBarrier bufferBarrier{};
+    bufferBarrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+    bufferBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    bufferBarrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+    bufferBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    bufferBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    bufferBarrier.buffer = readbackBuffer.getBuffer();
+    bufferBarrier.offset = 0;
+    bufferBarrier.size = VK_WHOLE_SIZE;
+    commandPool.pipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                                VK_PIPELINE_STAGE_HOST_BIT, 0, {}, {bufferBarrier}, {});
+
+    commandPool.endSingleTimeCommands(commandBuffer, queue);
+
+    const void* mapped = readbackBuffer.map();
+    readbackBuffer.invalidate();
+    pixels.resize(static_cast<size_t>(byteCount));
+    std::memcpy(pixels.data(), mapped, pixels.size());
+    readbackBuffer.unmap();
+    readbackBuffer.cleanup();
+}
+
+void VulkanOffscreenTarget::writePPM(const std::string& path, uint32_t width, uint32_t height,
+                                     const std::vector<uint8_t>& pixels) {
+    if (pixels.size() < static_cast<size_t>(width) * height * 4) {
+        throw std::runtime_error("Not enough pixel data for a " + std::to_string(width) + "x" +
+                                 std::to_string(height) + " image");
+    }
+
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        throw std::runtime_error("Failed to open " + path + " for writing");
+    }
+
+    std::fprintf(file, "P6\n%u %u\n255\n", width, height);
+
+    std::vector<uint8_t> row(static_cast<size_t>(width) * 3);
+    for (uint32_t y = 0; y < height; ++y) {
+        const uint8_t* source = pixels.data() + static_cast<size_t>(y) * width * 4;
+        for (uint32_t x = 0; x < width; ++x) {
+            row[x * 3 + 0] = source[x * 4 + 0];
+            row[x * 3 + 1] = source[x * 4 + 1];
+            row[x * 3 + 2] = source[x * 4 + 2];
+        }
+        std::fwrite(row.data(), 1, row.size(), file);
+    }
+
+    const bool failed = std::ferror(file) != 0;
+    std::fclose(file);
+    if (failed) {
+        throw std::runtime_error("Failed to write " + path);
+    }
+}
+
+uint32_t VulkanOffscreenTarget::findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties) const {
+    VkPhysicalDeviceMemoryProperties memProperties;
+    vkGetPhysicalDeviceMemoryProperties(m_physicalDevice, &memProperties);
+
+    for (uint32_t i = 0; i < memProperties.memoryTypeCount; i++) {
+        if ((typeFilter & (1u << i)) &&
+            (memProperties.memoryTypes[i].propertyFlags & properties) == properties) {
+            return i;
+        }
+    }
+
+    throw std::runtime_error("Failed to find suitable memory type for offscreen image");
+}
+
+} // namespace VulkanGameEngine
@@ -12,7 +12,9 @@ void VulkanPipeline::createGraphicsPipeline(VkDevice device,
                                            VkRenderPass renderPass,
                                            const std::string& vertexShaderPath,
                                            const std::string& fragmentShaderPath,
-                                           VkExtent2D extent) {
+                                           VkExtent2D extent,
+                                           const std::vector<char>& vertexShaderCode,
+                                           const std::vector<char>& fragmentShaderCode) {
     // Validate input parameters
     if (device == VK_NULL_HANDLE) {
         throw std::runtime_error("Invalid device handle provided to createGraphicsPipeline");
@@ -39,10 +41,10 @@ void VulkanPipeline::createGraphicsPipeline(VkDevice device,
     // Shader modules contain the compiled SPIR-V bytecode that defines
     // the behavior of programmable pipeline stages
     std::cout << "Loading vertex shader: " << vertexShaderPath << std::endl;
-    VkShaderModule vertexShaderModule = loadShader(vertexShaderPath);
+    VkShaderModule vertexShaderModule = loadShader(vertexShaderPath, vertexShaderCode);
     
     std::cout << "Loading fragment shader: " << fragmentShaderPath << std::endl;
-    VkShaderModule fragmentShaderModule = loadShader(fragmentShaderPath);
+    VkShaderModule fragmentShaderModule = loadShader(fragmentShaderPath, fragmentShaderCode);
     
     // Step 2: Create shader stage info structures
     // These structures tell Vulkan which shader modules to use for which stages
@@ -190,15 +192,21 @@ VkShaderModule VulkanPipeline::createShaderModule(const std::vector<char>& shade
     return shaderModule;
 }
 
-VkShaderModule VulkanPipeline::loadShader(const std::string& shaderPath) {
+VkShaderModule VulkanPipeline::loadShader(const std::string& shaderPath, const std::vector<char>& shaderCode) {
+    if (!shaderCode.empty()) {
+        std::cout << "Using in-memory shader: " << shaderPath
+                  << " (" << shaderCode.size() << " bytes)" << std::endl;
+        return createShaderModule(shaderCode);
+    }
+
     // Load SPIR-V bytecode from file
-    std::vector<char> shaderCode = VulkanUtils::readFile(shaderPath);
+    std::vector<char> fileCode = VulkanUtils::readFile(shaderPath);
     
     std::cout << "Loaded shader file: " << shaderPath 
-              << " (" << shaderCode.size() << " bytes)" << std::endl;
+              << " (" << fileCode.size() << " bytes)" << std::endl;
     
     // Create and return shader module
-    return createShaderModule(shaderCode);
+    return createShaderModule(fileCode);
 }
 
 void VulkanPipeline::createDescriptorSetLayout() {
@@ -237,9 +245,13 @@ void VulkanPipeline::createPipelineLayout() {
     pipelineLayoutInfo.setLayoutCount = 1;
     pipelineLayoutInfo.pSetLayouts = &descriptorSetLayout;
     
-    // No push constants for now (could be added later for small, frequent updates)
-    pipelineLayoutInfo.pushConstantRangeCount = 0;
-    pipelineLayoutInfo.pPushConstantRanges = nullptr;
+    // Per-draw model matrix, tint and color mode (ObjectConstants), read by the vertex shader
+    VkPushConstantRange pushConstantRange{};
+    pushConstantRange.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+    pushConstantRange.offset = 0;
+    pushConstantRange.size = sizeof(ObjectConstants);
+    pipelineLayoutInfo.pushConstantRangeCount = 1;
+    pipelineLayoutInfo.pPushConstantRanges = &pushConstantRange;
     
     VkResult result = vkCreatePipelineLayout(device, &pipelineLayoutInfo, nullptr, &pipelineLayout);
     VK_CHECK_RESULT(result, "Failed to create pipeline layout");
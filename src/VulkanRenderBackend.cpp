@@ -0,0 +1,1156 @@
+#include "../headers/VulkanRenderBackend.h"
+#include "../headers/VulkanUtils.h"
+#include "../headers/Logger.h"
+#include "../headers/Profiler.h"
+#include "../headers/Metrics.h"
+#include "../headers/AllocationTracker.h"
+#include "../headers/VulkanCallStats.h"
+#include <algorithm>
+#include <iterator>
+
+namespace VulkanGameEngine {
+
+VulkanRenderBackend::VulkanRenderBackend()
+    : m_surface(VK_NULL_HANDLE)
+    , m_depthImage(VK_NULL_HANDLE)
+    , m_depthImageMemory(VK_NULL_HANDLE)
+    , m_depthImageView(VK_NULL_HANDLE)
+    , m_descriptorPool(VK_NULL_HANDLE)
+    , m_descriptorSetCount(0)
+    , m_initState(InitializationState::NOT_INITIALIZED)
+    , m_headless(false)
+    , m_width(0)
+    , m_height(0)
+    , m_frameSlot(0)
+    , m_imageIndex(0)
+    , m_lastRenderedImage(0)
+    , m_hasRenderedFrame(false)
+    , m_frameInProgress(false)
+    , m_requestedReadback(0)
+    , m_submissionCount(0)
+    , m_slotSubmission{}
+    , m_completedSubmission{} {
+}
+
+VulkanRenderBackend::~VulkanRenderBackend() {
+    cleanup();
+}
+
+void VulkanRenderBackend::initialize(const BackendConfig& config) {
+    PROFILE_ZONE("VulkanRenderBackend::initialize");
+
+    m_headless = (config.window == nullptr);
+    m_width = config.width;
+    m_height = config.height;
+
+    VulkanUtils::logObjectCreation("VulkanRenderBackend", m_headless ? "Beginning headless initialization sequence"
+                                                                     : "Beginning initialization sequence");
+
+    try {
+        // Step 1: Create Vulkan instance
+        logInitializationState(InitializationState::INSTANCE_CREATED, "Creating Vulkan instance");
+
+        if (m_headless) {
+            // No window system integration; validation only in debug builds so CI nodes
+            // without the validation layers installed can still run release builds
+            m_instance.create({}, ENABLE_VALIDATION_LAYERS);
+        } else {
+            // Get required extensions from SDL
+            uint32_t extensionCount = 0;
+            const char* const* extensions = SDL_Vulkan_GetInstanceExtensions(&extensionCount);
+            if (!extensions) {
+                throw std::runtime_error("Failed to get Vulkan extensions from SDL: " + std::string(SDL_GetError()));
+            }
+
+            std::vector<const char*> requiredExtensions(extensions, extensions + extensionCount);
+            m_instance.create(requiredExtensions);
+        }
+        m_initState = InitializationState::INSTANCE_CREATED;
+
+        // Step 2: Create window surface (headless mode has none)
+        if (!m_headless) {
+            logInitializationState(InitializationState::SURFACE_CREATED, "Creating window surface");
+            createSurface(config.window);
+        }
+        m_initState = InitializationState::SURFACE_CREATED;
+
+        // Step 3: Create device (physical and logical); a null surface selects a headless device
+        logInitializationState(InitializationState::DEVICE_CREATED, "Creating Vulkan device");
+        m_device.create(m_instance.getInstance(), m_surface);
+        m_initState = InitializationState::DEVICE_CREATED;
+
+        // Step 4: Create swapchain, or offscreen color images when headless
+        logInitializationState(InitializationState::SWAPCHAIN_CREATED,
+                               m_headless ? "Creating offscreen color images" : "Creating swapchain");
+        createColorTarget();
+        m_initState = InitializationState::SWAPCHAIN_CREATED;
+
+        // Step 5: Create render pass, depth buffer and framebuffers
+        logInitializationState(InitializationState::RENDER_PASS_CREATED, "Creating render pass and framebuffers");
+        createRenderTargets();
+        m_initState = InitializationState::RENDER_PASS_CREATED;
+
+        // Step 6: Create descriptor pool (sets are allocated per uniform buffer)
+        logInitializationState(InitializationState::DESCRIPTORS_CREATED, "Creating descriptor pool");
+        createDescriptorPool();
+        m_initState = InitializationState::DESCRIPTORS_CREATED;
+
+        // Step 7: Create command pool and command buffers
+        logInitializationState(InitializationState::COMMAND_POOL_CREATED, "Creating command pool and buffers");
+        m_commandPool.create(m_device.getLogicalDevice(),
+                            m_device.getQueueFamilyIndices().graphicsFamily.value());
+        m_commandBuffers = m_commandPool.allocateCommandBuffers(MAX_FRAMES_IN_FLIGHT);
+        m_initState = InitializationState::COMMAND_POOL_CREATED;
+
+        // Step 8: Create synchronization objects
+        logInitializationState(InitializationState::SYNCHRONIZATION_CREATED, "Creating synchronization objects");
+        m_synchronization.create(m_device.getLogicalDevice(), MAX_FRAMES_IN_FLIGHT);
+        m_gpuProfiler.create(m_device, MAX_FRAMES_IN_FLIGHT);
+        m_initState = InitializationState::FULLY_INITIALIZED;
+
+        VulkanUtils::logObjectCreation("VulkanRenderBackend", "Initialization completed successfully");
+        LOG_INFO(std::string(m_headless ? "  - Offscreen images: " : "  - Swapchain images: ") +
+                 std::to_string(getColorImageViews().size()), "Engine");
+
+    } catch (const std::exception& e) {
+        LOG_ERROR("Vulkan backend initialization failed at state " +
+                  std::to_string(static_cast<int>(m_initState)) + ": " + e.what(), "Engine");
+        cleanup();
+        throw;
+    }
+}
+
+void VulkanRenderBackend::cleanup() {
+    if (m_initState == InitializationState::NOT_INITIALIZED) {
+        return;
+    }
+
+    VulkanUtils::logObjectDestruction("VulkanRenderBackend", "Beginning cleanup sequence");
+
+    // Wait for all operations to complete
+    if (m_initState >= InitializationState::DEVICE_CREATED) {
+        waitIdle();
+    }
+
+    // Clean up in reverse order of creation
+    if (m_initState >= InitializationState::FULLY_INITIALIZED) {
+        m_gpuProfiler.cleanup();
+        m_synchronization.cleanup();
+    }
+
+    destroyReadbacks();
+
+    // The device is idle: nothing retired or queued for upload is in use any more
+    releaseRetired(true);
+    m_pendingUploads.clear();
+
+    // Anything the engine did not destroy itself
+    for (BufferSlot& slot : m_buffers) {
+        slot.buffer.cleanup();
+    }
+    m_buffers.clear();
+    m_freeBufferSlots.clear();
+
+    if (m_initState >= InitializationState::COMMAND_POOL_CREATED) {
+        m_commandPool.cleanup();
+        m_commandBuffers.clear();
+    }
+
+    if (m_initState >= InitializationState::DESCRIPTORS_CREATED) {
+        // Descriptor sets are freed together with the pool
+        if (m_descriptorPool != VK_NULL_HANDLE) {
+            vkDestroyDescriptorPool(m_device.getLogicalDevice(), m_descriptorPool, nullptr);
+            m_descriptorPool = VK_NULL_HANDLE;
+            m_descriptorSetCount = 0;
+            VulkanUtils::logObjectDestruction("VkDescriptorPool");
+        }
+    }
+
+    for (PipelineSlot& slot : m_pipelines) {
+        if (slot.pipeline) {
+            slot.pipeline->cleanup();
+        }
+    }
+    m_pipelines.clear();
+
+    if (m_initState >= InitializationState::RENDER_PASS_CREATED) {
+        destroyRenderTargets();
+    }
+
+    if (m_initState >= InitializationState::SWAPCHAIN_CREATED) {
+        destroyColorTarget();
+    }
+
+    if (m_initState >= InitializationState::SURFACE_CREATED && m_surface != VK_NULL_HANDLE) {
+        vkDestroySurfaceKHR(m_instance.getInstance(), m_surface, nullptr);
+        m_surface = VK_NULL_HANDLE;
+        VulkanUtils::logObjectDestruction("VkSurfaceKHR");
+    }
+
+    if (m_initState >= InitializationState::DEVICE_CREATED) {
+        m_device.cleanup();
+    }
+
+    if (m_initState >= InitializationState::INSTANCE_CREATED) {
+        m_instance.cleanup();
+    }
+
+    m_initState = InitializationState::NOT_INITIALIZED;
+    m_frameSlot = 0;
+    m_hasRenderedFrame = false;
+    m_frameInProgress = false;
+
+    VulkanUtils::logObjectDestruction("VulkanRenderBackend", "Cleanup completed");
+}
+
+void VulkanRenderBackend::waitIdle() {
+    if (m_device.getLogicalDevice() != VK_NULL_HANDLE) {
+        VK_CHECK(VK_TRACKED(DeviceWaitIdle, vkDeviceWaitIdle(m_device.getLogicalDevice())), "Failed to wait for device idle");
+        // Everything submitted has finished, including pending readback copies
+        for (uint32_t slot = 0; slot < MAX_FRAMES_IN_FLIGHT; ++slot) {
+            m_completedSubmission[slot] = m_slotSubmission[slot];
+        }
+        releaseRetired();
+    }
+}
+
+void VulkanRenderBackend::resize(uint32_t width, uint32_t height) {
+    m_width = width;
+    m_height = height;
+    recreateSwapchain();
+}
+
+void VulkanRenderBackend::getRenderExtent(uint32_t& width, uint32_t& height) const {
+    const VkExtent2D extent = getColorExtent();
+    width = extent.width;
+    height = extent.height;
+}
+
+BufferHandle VulkanRenderBackend::createBuffer(BufferType type, const void* data, size_t size) {
+    if (size == 0) {
+        throw std::runtime_error("Cannot create an empty buffer");
+    }
+
+    VulkanBuffer buffer;
+    VulkanBuffer staging;
+    VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
+    uint8_t* mapped = nullptr;
+    VkDeviceSize regionStride = 0;
+    switch (type) {
+        case BufferType::VERTEX:
+        case BufferType::INDEX: {
+            const VulkanBuffer::Usage usage =
+                type == BufferType::VERTEX ? VulkanBuffer::Usage::VERTEX_BUFFER : VulkanBuffer::Usage::INDEX_BUFFER;
+            if (!m_hasRenderedFrame) {
+                // Startup: nothing is in flight, so a blocking copy costs nothing
+                buffer = BufferUtils::createDeviceLocalBuffer(
+                    m_device.getLogicalDevice(), m_device.getPhysicalDevice(),
+                    m_commandPool.getCommandPool(), m_device.getGraphicsQueue(), data, size, usage);
+            } else {
+                // Frames are in flight: copy in the next frame's command buffer instead of waiting for the queue
+                staging.createWithData(m_device.getLogicalDevice(), m_device.getPhysicalDevice(), data, size,
+                                       VulkanBuffer::Usage::STAGING_BUFFER, VulkanBuffer::MemoryProperty::STAGING);
+                buffer.create(m_device.getLogicalDevice(), m_device.getPhysicalDevice(), size, usage,
+                              VulkanBuffer::MemoryProperty::DEVICE_LOCAL);
+            }
+            break;
+        }
+
+        case BufferType::UNIFORM:
+            buffer.create(m_device.getLogicalDevice(), m_device.getPhysicalDevice(), size,
+                          VulkanBuffer::Usage::UNIFORM_BUFFER, VulkanBuffer::MemoryProperty::HOST_VISIBLE);
+            if (data) {
+                buffer.uploadData(data, size);
+            }
+            descriptorSet = allocateUniformDescriptorSet(buffer, size);
+            break;
+
+        case BufferType::DYNAMIC_VERTEX:
+            // Regions start on their own cache lines so writes to one never touch the memory of another
+            regionStride = (static_cast<VkDeviceSize>(size) + DYNAMIC_REGION_ALIGNMENT - 1) &
+                           ~(DYNAMIC_REGION_ALIGNMENT - 1);
+            buffer.create(m_device.getLogicalDevice(), m_device.getPhysicalDevice(), regionStride * MAX_FRAMES_IN_FLIGHT,
+                          VulkanBuffer::Usage::VERTEX_BUFFER, VulkanBuffer::MemoryProperty::HOST_VISIBLE);
+            mapped = static_cast<uint8_t*>(buffer.map());
+            if (data) {
+                for (uint32_t region = 0; region < MAX_FRAMES_IN_FLIGHT; ++region) {
+                    std::memcpy(mapped + regionStride * region, data, size);
+                }
+            }
+            break;
+    }
+
+    // Reuse a destroyed slot if there is one so handles stay small
+    uint32_t index;
+    if (!m_freeBufferSlots.empty()) {
+        index = m_freeBufferSlots.back();
+        m_freeBufferSlots.pop_back();
+    } else {
+        index = static_cast<uint32_t>(m_buffers.size());
+        m_buffers.emplace_back();
+    }
+
+    BufferSlot& slot = m_buffers[index];
+    slot.buffer = std::move(buffer);
+    slot.type = type;
+    slot.descriptorSet = descriptorSet;
+    slot.mapped = mapped;
+    slot.regionSize = regionStride != 0 ? static_cast<VkDeviceSize>(size) : 0;
+    slot.regionStride = regionStride;
+    slot.live = true;
+    if (staging.getBuffer() != VK_NULL_HANDLE) {
+        m_pendingUploads.push_back({std::move(staging), index, static_cast<VkDeviceSize>(size)});
+    }
+    return index + 1;
+}
+
+void VulkanRenderBackend::updateBuffer(BufferHandle buffer, const void* data, size_t size) {
+    BufferSlot& slot = getBufferSlot(buffer);
+    if (slot.type == BufferType::DYNAMIC_VERTEX) {
+        writeDynamicRegion(slot, 0, data, size);
+        return;
+    }
+    if (slot.type != BufferType::UNIFORM) {
+        throw std::runtime_error("Only uniform and dynamic vertex buffers can be updated after creation");
+    }
+    slot.buffer.uploadData(data, size);
+}
+
+void VulkanRenderBackend::updateBufferRange(BufferHandle buffer, size_t offset, const void* data, size_t size) {
+    BufferSlot& slot = getBufferSlot(buffer);
+    switch (slot.type) {
+        case BufferType::DYNAMIC_VERTEX:
+            writeDynamicRegion(slot, offset, data, size);
+            break;
+
+        case BufferType::UNIFORM:
+            if (offset > slot.buffer.getSize() || size > slot.buffer.getSize() - offset) {
+                throw std::runtime_error("Uniform buffer update out of range");
+            }
+            slot.buffer.uploadData(data, size, offset);
+            break;
+
+        default:
+            throw std::runtime_error("Only uniform and dynamic vertex buffers can be updated after creation");
+    }
+}
+
+void VulkanRenderBackend::destroyBuffer(BufferHandle buffer) {
+    if (buffer == INVALID_HANDLE) {
+        return;
+    }
+
+    BufferSlot& slot = getBufferSlot(buffer);
+    const uint32_t index = buffer - 1;
+    // An upload that was never recorded has nothing to wait for
+    m_pendingUploads.erase(std::remove_if(m_pendingUploads.begin(), m_pendingUploads.end(),
+                                          [index](const PendingUpload& upload) { return upload.bufferSlot == index; }),
+                           m_pendingUploads.end());
+
+    // The descriptor set stays allocated until the pool is destroyed (the pool is not
+    // created with FREE_DESCRIPTOR_SET; uniform buffers live as long as the backend)
+    slot.descriptorSet = VK_NULL_HANDLE;
+    slot.mapped = nullptr;      // Unmapped when the buffer is freed
+    slot.live = false;
+
+    // Frames in flight may still read the buffer; the slot is reused once they finish
+    RetiredResource retired;
+    retired.buffer = std::move(slot.buffer);
+    retired.bufferSlot = index;
+    retire(std::move(retired));
+}
+
+PipelineHandle VulkanRenderBackend::createPipeline(const PipelineDesc& desc) {
+    PipelineSlot slot;
+    slot.desc = desc;
+    buildPipeline(slot);
+    m_pipelines.push_back(std::move(slot));
+    return static_cast<PipelineHandle>(m_pipelines.size());
+}
+
+void VulkanRenderBackend::destroyPipeline(PipelineHandle pipeline) {
+    if (pipeline == INVALID_HANDLE || pipeline > m_pipelines.size()) {
+        return;
+    }
+
+    PipelineSlot& slot = m_pipelines[pipeline - 1];
+    if (slot.pipeline) {
+        RetiredResource retired;
+        retired.pipeline = std::move(slot.pipeline);
+        retire(std::move(retired));
+    }
+}
+
+void VulkanRenderBackend::replacePipeline(PipelineHandle pipeline, const PipelineDesc& desc) {
+    getPipeline(pipeline);  // Throws for unknown or destroyed handles
+
+    // Build the replacement first, so a shader that fails to compile leaves the old pipeline in place
+    PipelineSlot replacement;
+    replacement.desc = desc;
+    buildPipeline(replacement);
+
+    PipelineSlot& slot = m_pipelines[pipeline - 1];
+    RetiredResource retired;
+    retired.pipeline = std::move(slot.pipeline);
+    retire(std::move(retired));
+    slot = std::move(replacement);
+}
+
+FrameStatus VulkanRenderBackend::beginFrame(uint32_t frameSlot) {
+    if (m_initState != InitializationState::FULLY_INITIALIZED) {
+        throw std::runtime_error("Cannot render: Vulkan backend not initialized");
+    }
+
+    m_frameSlot = frameSlot;
+    m_timings = BackendTimings{};
+
+    // Wait for the previous use of this frame slot to complete
+    {
+        PROFILE_ZONE("WaitForFrame");
+        const int64_t waitStart = MetricsRegistry::now();
+        if (!m_synchronization.waitForFrame(frameSlot, UINT64_MAX)) { // Infinite timeout
+            LOG_WARN("Failed to wait for frame {}", "Engine", frameSlot);
+            return FrameStatus::SKIPPED;
+        }
+        m_timings.fenceWaitNs = MetricsRegistry::now() - waitStart;
+    }
+
+    // The fence has signalled, so this slot's queries (and readback copies) from its previous use are complete
+    m_gpuProfiler.collectResults(frameSlot);
+    m_completedSubmission[frameSlot] = m_slotSubmission[frameSlot];
+    if (!m_retired.empty()) {
+        releaseRetired();
+    }
+
+    // Acquire next image from swapchain
+    if (m_headless) {
+        // One offscreen image per frame slot; the fence wait above already made it free
+        m_imageIndex = frameSlot;
+    } else {
+        VkResult result;
+        {
+            PROFILE_ZONE("AcquireImage");
+            const int64_t acquireStart = MetricsRegistry::now();
+            result = m_synchronization.acquireNextImage(
+                m_device.getLogicalDevice(),
+                m_swapchain.getSwapchain(),
+                UINT64_MAX,
+                m_synchronization.getImageAvailableSemaphore(frameSlot),
+                VK_NULL_HANDLE,
+                &m_imageIndex
+            );
+            m_timings.acquireNs = MetricsRegistry::now() - acquireStart;
+        }
+
+        // Handle swapchain recreation if needed
+        if (result == VK_ERROR_OUT_OF_DATE_KHR) {
+            recreateSwapchain();
+            return FrameStatus::SKIPPED;
+        } else if (result != VK_SUCCESS && result != VK_SUBOPTIMAL_KHR) {
+            throw std::runtime_error("Failed to acquire swapchain image: " +
+                                   VulkanUtils::vulkanResultToString(result));
+        }
+    }
+
+    // Reset fence for this frame
+    m_synchronization.resetFrameFence(frameSlot);
+    m_frameInProgress = true;
+    return FrameStatus::READY;
+}
+
+void VulkanRenderBackend::recordFrame(const CommandList& commands) {
+    VkCommandBuffer commandBuffer = m_commandBuffers[m_frameSlot];
+    VK_CHECK(VK_TRACKED(ResetCommandBuffer, vkResetCommandBuffer(commandBuffer, 0)), "Failed to reset command buffer");
+
+    // Begin recording
+    m_commandPool.beginCommandBuffer(commandBuffer, VulkanCommandPool::Usage::SINGLE_USE);
+
+    // Query resets and buffer uploads must be recorded outside the render pass
+    m_gpuProfiler.beginFrame(commandBuffer, m_frameSlot);
+    if (!m_pendingUploads.empty()) {
+        recordPendingUploads(commandBuffer);
+    }
+
+    const VkExtent2D extent = getColorExtent();
+    const std::vector<VkFramebuffer>& framebuffers = m_renderPass.getFramebuffers();
+    if (m_imageIndex >= framebuffers.size()) {
+        throw std::runtime_error("Image index out of range for framebuffers");
+    }
+
+    VkPipelineLayout pipelineLayout = VK_NULL_HANDLE;
+    uint32_t zoneStack[GpuProfiler::MAX_ZONES_PER_FRAME];
+    uint32_t zoneDepth = 0;
+
+    for (const Command& command : commands.getCommands()) {
+        switch (command.type) {
+            case CommandType::BEGIN_PASS: {
+                VkRect2D renderArea{};
+                renderArea.offset = {0, 0};
+                renderArea.extent = extent;
+
+                std::array<VkClearValue, 2> clearValues{};
+                clearValues[0].color = {{command.clearColor[0], command.clearColor[1],
+                                         command.clearColor[2], command.clearColor[3]}};
+                clearValues[1].depthStencil = {1.0f, 0};
+
+                m_commandPool.beginRenderPass(commandBuffer, m_renderPass.getRenderPass(),
+                                              framebuffers[m_imageIndex], renderArea,
+                                              clearValues.data(), static_cast<uint32_t>(clearValues.size()));
+                m_gpuProfiler.beginStatistics(commandBuffer);
+                break;
+            }
+
+            case CommandType::END_PASS:
+                m_gpuProfiler.endStatistics(commandBuffer);
+                m_commandPool.endRenderPass(commandBuffer);
+                break;
+
+            case CommandType::BIND_PIPELINE: {
+                const VulkanPipeline& pipeline = getPipeline(command.handle);
+                m_commandPool.bindPipeline(commandBuffer, pipeline.getPipeline());
+                pipelineLayout = pipeline.getPipelineLayout();
+                break;
+            }
+
+            case CommandType::SET_FULL_VIEWPORT:
+                m_commandPool.setViewport(commandBuffer, 0.0f, 0.0f,
+                                          static_cast<float>(extent.width),
+                                          static_cast<float>(extent.height));
+                m_commandPool.setScissor(commandBuffer, 0, 0, extent.width, extent.height);
+                break;
+
+            case CommandType::BIND_VERTEX_BUFFER: {
+                // Dynamic vertex buffers bind the frame slot's region (the stride is 0 for the others)
+                const BufferSlot& slot = getBufferSlot(command.handle);
+                const VkBuffer vertexBuffer = slot.buffer.getBuffer();
+                const VkDeviceSize vertexOffset = slot.regionStride * m_frameSlot;
+                m_commandPool.bindVertexBuffers(commandBuffer, 0, 1, &vertexBuffer, &vertexOffset);
+                break;
+            }
+
+            case CommandType::BIND_INDEX_BUFFER:
+                m_commandPool.bindIndexBuffer(commandBuffer, getBufferSlot(command.handle).buffer.getBuffer());
+                break;
+
+            case CommandType::BIND_UNIFORMS: {
+                if (pipelineLayout == VK_NULL_HANDLE) {
+                    throw std::runtime_error("Uniforms bound before a pipeline");
+                }
+                const VkDescriptorSet descriptorSet = getBufferSlot(command.handle).descriptorSet;
+                m_commandPool.bindDescriptorSets(commandBuffer, pipelineLayout, 0, 1, &descriptorSet);
+                break;
+            }
+
+            case CommandType::PUSH_OBJECT_CONSTANTS: {
+                if (pipelineLayout == VK_NULL_HANDLE) {
+                    throw std::runtime_error("Object constants pushed before a pipeline");
+                }
+                m_commandPool.pushConstants(commandBuffer, pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0,
+                                            sizeof(ObjectConstants), &commands.getObjectConstants(command.handle));
+                break;
+            }
+
+            case CommandType::DRAW_INDEXED:
+                m_commandPool.drawIndexed(commandBuffer, command.indexCount, 1,
+                                          command.firstIndex, command.vertexOffset);
+                break;
+
+            case CommandType::BEGIN_ZONE:
+                if (zoneDepth < GpuProfiler::MAX_ZONES_PER_FRAME) {
+                    zoneStack[zoneDepth] = m_gpuProfiler.beginZone(commandBuffer, command.name);
+                }
+                zoneDepth++;
+                break;
+
+            case CommandType::END_ZONE:
+                if (zoneDepth > 0) {
+                    zoneDepth--;
+                    if (zoneDepth < GpuProfiler::MAX_ZONES_PER_FRAME) {
+                        m_gpuProfiler.endZone(commandBuffer, zoneStack[zoneDepth]);
+                    }
+                }
+                break;
+        }
+    }
+
+    // Copy the finished image out for an asynchronous readback, if one was requested
+    if (m_requestedReadback != 0) {
+        recordReadbackCopy(commandBuffer, m_readbacks[m_requestedReadback - 1]);
+        m_requestedReadback = 0;
+    }
+
+    // End recording
+    m_commandPool.endCommandBuffer(commandBuffer);
+}
+
+void VulkanRenderBackend::submitFrame() {
+    // Headless frames have no acquire to wait for and no present to signal
+    VkSemaphore imageAvailableSemaphore = m_headless ? VK_NULL_HANDLE : m_synchronization.getImageAvailableSemaphore(m_frameSlot);
+    VkSemaphore renderFinishedSemaphore = m_headless ? VK_NULL_HANDLE : m_synchronization.getRenderFinishedSemaphore(m_frameSlot);
+
+    // Single-buffer overload: no per-frame vectors
+    m_gpuProfiler.endFrame(m_frameSlot);
+    m_synchronization.submitCommandBuffer(
+        m_device.getGraphicsQueue(),
+        m_commandBuffers[m_frameSlot],
+        imageAvailableSemaphore,
+        VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+        renderFinishedSemaphore,
+        m_synchronization.getInFlightFence(m_frameSlot)
+    );
+
+    m_lastRenderedImage = m_imageIndex;
+    m_hasRenderedFrame = true;
+    m_frameInProgress = false;
+    m_slotSubmission[m_frameSlot] = ++m_submissionCount;
+}
+
+FrameStatus VulkanRenderBackend::presentFrame() {
+    if (m_headless) {
+        // Nothing to present; the image stays in TRANSFER_SRC for readback
+        return FrameStatus::READY;
+    }
+
+    const int64_t presentStart = MetricsRegistry::now();
+    VkResult result = m_synchronization.presentImage(
+        m_device.getPresentQueue(),
+        m_swapchain.getSwapchain(),
+        m_imageIndex,
+        m_synchronization.getRenderFinishedSemaphore(m_frameSlot)
+    );
+    m_timings.presentNs = MetricsRegistry::now() - presentStart;
+
+    // Handle swapchain recreation if needed
+    if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR) {
+        recreateSwapchain();
+        return FrameStatus::SKIPPED;
+    } else if (result != VK_SUCCESS) {
+        throw std::runtime_error("Failed to present swapchain image: " +
+                               VulkanUtils::vulkanResultToString(result));
+    }
+    return FrameStatus::READY;
+}
+
+void VulkanRenderBackend::readbackFrame(std::vector<uint8_t>& pixels, uint32_t& width, uint32_t& height) {
+    if (!m_headless) {
+        throw std::runtime_error("Frame readback is only available in headless mode");
+    }
+    if (!m_hasRenderedFrame) {
+        throw std::runtime_error("Cannot read back a frame before one has been rendered");
+    }
+
+    waitIdle();
+    m_offscreenTarget.readback(m_commandPool, m_device.getGraphicsQueue(), m_lastRenderedImage, pixels);
+    width = m_offscreenTarget.getExtent().width;
+    height = m_offscreenTarget.getExtent().height;
+}
+
+bool VulkanRenderBackend::requestReadback(uint64_t tag) {
+    if (!m_headless && !m_swapchain.isTransferSource()) {
+        return false;
+    }
+
+    // Any free buffer will do; the consumer may release them out of order
+    uint32_t index = READBACK_RING_SIZE;
+    for (uint32_t i = 0; i < READBACK_RING_SIZE; ++i) {
+        if (m_readbacks[i].state.load(std::memory_order_acquire) == ReadbackSlot::FREE) {
+            index = i;
+            break;
+        }
+    }
+    if (index == READBACK_RING_SIZE) {
+        return false;
+    }
+
+    ReadbackSlot& slot = m_readbacks[index];
+    const VkExtent2D extent = getColorExtent();
+    const VkDeviceSize byteCount = static_cast<VkDeviceSize>(extent.width) * extent.height * 4;
+    if (slot.capacity < byteCount) {
+        // First use or a larger render target; steady-state frames reuse the buffer
+        ALLOW_ALLOCATIONS();
+        VK_ALLOW_HAZARDS();
+        slot.buffer.cleanup();
+        slot.buffer.create(m_device.getLogicalDevice(), m_device.getPhysicalDevice(), byteCount,
+                           VulkanBuffer::Usage::READBACK_BUFFER, VulkanBuffer::MemoryProperty::STAGING);
+        slot.mapped = static_cast<const uint8_t*>(slot.buffer.map());
+        slot.capacity = byteCount;
+    }
+
+    const VkFormat format = getColorFormat();
+    slot.width = extent.width;
+    slot.height = extent.height;
+    slot.bgra = format == VK_FORMAT_B8G8R8A8_SRGB || format == VK_FORMAT_B8G8R8A8_UNORM;
+    slot.tag = tag;
+    slot.frameSlot = m_frameSlot;
+    slot.submission = m_submissionCount + 1;    // The submission submitFrame is about to make
+    slot.state.store(ReadbackSlot::PENDING, std::memory_order_relaxed);
+    m_requestedReadback = index + 1;
+    return true;
+}
+
+bool VulkanRenderBackend::pollReadback(ReadbackFrame& frame) {
+    // Oldest finished copy first, so consumers see frames in order
+    ReadbackSlot* oldest = nullptr;
+    uint32_t oldestIndex = 0;
+    for (uint32_t i = 0; i < READBACK_RING_SIZE; ++i) {
+        ReadbackSlot& slot = m_readbacks[i];
+        if (slot.state.load(std::memory_order_acquire) != ReadbackSlot::PENDING ||
+            m_completedSubmission[slot.frameSlot] < slot.submission) {
+            continue;
+        }
+        if (!oldest || slot.tag < oldest->tag) {
+            oldest = &slot;
+            oldestIndex = i;
+        }
+    }
+    if (!oldest) {
+        return false;
+    }
+
+    oldest->buffer.invalidate();
+    oldest->state.store(ReadbackSlot::IN_USE, std::memory_order_release);
+    frame.id = oldestIndex + 1;
+    frame.tag = oldest->tag;
+    frame.width = oldest->width;
+    frame.height = oldest->height;
+    frame.bgra = oldest->bgra;
+    frame.pixels = oldest->mapped;
+    return true;
+}
+
+void VulkanRenderBackend::releaseReadback(uint32_t id) {
+    if (id == 0 || id > READBACK_RING_SIZE) {
+        return;
+    }
+    m_readbacks[id - 1].state.store(ReadbackSlot::FREE, std::memory_order_release);
+}
+
+void VulkanRenderBackend::recordReadbackCopy(VkCommandBuffer commandBuffer, ReadbackSlot& slot) {
+    const VkImage image = m_headless ? m_offscreenTarget.getImages()[m_imageIndex] : m_swapchain.getImages()[m_imageIndex];
+    const VkImageLayout finalLayout = m_headless ? VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL : VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+
+    // Wait for the render pass's color writes; swapchain images move out of PRESENT_SRC for the copy
+    VkImageMemoryBarrier imageBarrier{};
+    imageBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    imageBarrier.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+    imageBarrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+    imageBarrier.oldLayout = finalLayout;
+    imageBarrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+    imageBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    imageBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    imageBarrier.image = image;
+    imageBarrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    imageBarrier.subresourceRange.levelCount = 1;
+    imageBarrier.subresourceRange.layerCount = 1;
+    // Direct calls: the pool's vector-based pipelineBarrier would allocate every frame
+    VK_TRACKED(CmdPipelineBarrier, vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                                                        VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr,
+                                                        1, &imageBarrier));
+
+    VkBufferImageCopy region{};
+    region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    region.imageSubresource.layerCount = 1;
+    region.imageExtent = {slot.width, slot.height, 1};
+    VK_TRACKED(CmdCopyImageToBuffer, vkCmdCopyImageToBuffer(commandBuffer, image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                                                            slot.buffer.getBuffer(), 1, &region));
+
+    // Make the copy visible to host reads once the fence has signalled, and hand the image back to presentation
+    VkBufferMemoryBarrier bufferBarrier{};
+    bufferBarrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+    bufferBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    bufferBarrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+    bufferBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    bufferBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    bufferBarrier.buffer = slot.buffer.getBuffer();
+    bufferBarrier.size = VK_WHOLE_SIZE;
+
+    imageBarrier.srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+    imageBarrier.dstAccessMask = 0;
+    imageBarrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+    imageBarrier.newLayout = finalLayout;
+    VK_TRACKED(CmdPipelineBarrier, vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                                                        VK_PIPELINE_STAGE_HOST_BIT | VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                                                        0, 0, nullptr, 1, &bufferBarrier,
+                                                        m_headless ? 0 : 1, &imageBarrier));
+}
+
+void VulkanRenderBackend::retire(RetiredResource&& resource) {
+    // Ask for each slot's latest submission, and for the one being recorded if a frame is open
+    std::copy(std::begin(m_slotSubmission), std::end(m_slotSubmission), std::begin(resource.submissions));
+    if (m_frameInProgress) {
+        resource.submissions[m_frameSlot] = m_submissionCount + 1;
+    }
+    m_retired.push_back(std::move(resource));
+}
+
+void VulkanRenderBackend::releaseRetired(bool all) {
+    size_t kept = 0;
+    for (size_t i = 0; i < m_retired.size(); ++i) {
+        RetiredResource& resource = m_retired[i];
+        bool finished = true;
+        for (uint32_t slot = 0; slot < MAX_FRAMES_IN_FLIGHT; ++slot) {
+            finished = finished && m_completedSubmission[slot] >= resource.submissions[slot];
+        }
+
+        if (!finished && !all) {
+            if (kept != i) {
+                m_retired[kept] = std::move(resource);
+            }
+            ++kept;
+            continue;
+        }
+
+        resource.buffer.cleanup();
+        if (resource.pipeline) {
+            resource.pipeline->cleanup();
+        }
+        if (resource.bufferSlot != UINT32_MAX) {
+            m_freeBufferSlots.push_back(resource.bufferSlot);
+        }
+    }
+    m_retired.erase(m_retired.begin() + static_cast<std::ptrdiff_t>(kept), m_retired.end());
+}
+
+void VulkanRenderBackend::recordPendingUploads(VkCommandBuffer commandBuffer) {
+    for (PendingUpload& upload : m_pendingUploads) {
+        VkBufferCopy region{};
+        region.size = upload.size;
+        VK_TRACKED(CmdCopyBuffer, vkCmdCopyBuffer(commandBuffer, upload.staging.getBuffer(),
+                                                  m_buffers[upload.bufferSlot].buffer.getBuffer(), 1, &region));
+    }
+
+    // One barrier covers every copy: the frame's draws read the new buffers right after
+    VkMemoryBarrier barrier{};
+    barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT;
+    VK_TRACKED(CmdPipelineBarrier, vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                                                        VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, 0, 1, &barrier,
+                                                        0, nullptr, 0, nullptr));
+
+    // The staging buffers are read by this frame, so they go when its fence signals
+    for (PendingUpload& upload : m_pendingUploads) {
+        RetiredResource retired;
+        retired.buffer = std::move(upload.staging);
+        retire(std::move(retired));
+    }
+    m_pendingUploads.clear();
+}
+
+void VulkanRenderBackend::destroyReadbacks() {
+    m_requestedReadback = 0;
+    for (ReadbackSlot& slot : m_readbacks) {
+        if (slot.state.load(std::memory_order_acquire) == ReadbackSlot::IN_USE) {
+            LOG_WARN("Readback of frame {} was not released before backend cleanup", "Engine", slot.tag);
+        }
+        if (slot.mapped) {
+            slot.buffer.unmap();
+            slot.mapped = nullptr;
+        }
+        slot.buffer.cleanup();
+        slot.capacity = 0;
+        slot.state.store(ReadbackSlot::FREE, std::memory_order_release);
+    }
+}
+
+void VulkanRenderBackend::createSurface(SDL_Window* window) {
+    if (!SDL_Vulkan_CreateSurface(window, m_instance.getInstance(), nullptr, &m_surface)) {
+        throw std::runtime_error("Failed to create Vulkan surface: " + std::string(SDL_GetError()));
+    }
+
+    VulkanUtils::logObjectCreation("VkSurfaceKHR", "Created SDL Vulkan surface");
+}
+
+void VulkanRenderBackend::createColorTarget() {
+    if (m_headless) {
+        m_offscreenTarget.create(m_device, m_width, m_height, MAX_FRAMES_IN_FLIGHT);
+    } else {
+        m_swapchain.create(m_device, m_surface, m_width, m_height);
+    }
+}
+
+void VulkanRenderBackend::destroyColorTarget() {
+    if (m_headless) {
+        m_offscreenTarget.cleanup();
+    } else {
+        m_swapchain.cleanup();
+    }
+}
+
+VkExtent2D VulkanRenderBackend::getColorExtent() const {
+    return m_headless ? m_offscreenTarget.getExtent() : m_swapchain.getExtent();
+}
+
+VkFormat VulkanRenderBackend::getColorFormat() const {
+    return m_headless ? m_offscreenTarget.getImageFormat() : m_swapchain.getImageFormat();
+}
+
+const std::vector<VkImageView>& VulkanRenderBackend::getColorImageViews() const {
+    return m_headless ? m_offscreenTarget.getImageViews() : m_swapchain.getImageViews();
+}
+
+void VulkanRenderBackend::createRenderTargets() {
+    // Headless images are left ready for a transfer instead of presentation
+    m_renderPass.create(m_device.getLogicalDevice(), getColorFormat(), findDepthFormat(), VK_SAMPLE_COUNT_1_BIT,
+                        m_headless ? VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL : VK_IMAGE_LAYOUT_PRESENT_SRC_KHR);
+    createDepthBuffer();
+    m_renderPass.createFramebuffers(getColorImageViews(), m_depthImageView, getColorExtent());
+}
+
+void VulkanRenderBackend::destroyRenderTargets() {
+    // Clean up depth buffer
+    if (m_depthImageView != VK_NULL_HANDLE) {
+        vkDestroyImageView(m_device.getLogicalDevice(), m_depthImageView, nullptr);
+        m_depthImageView = VK_NULL_HANDLE;
+        VulkanUtils::logObjectDestruction("VkImageView (depth)");
+    }
+
+    if (m_depthImage != VK_NULL_HANDLE) {
+        vkDestroyImage(m_device.getLogicalDevice(), m_depthImage, nullptr);
+        m_depthImage = VK_NULL_HANDLE;
+        VulkanUtils::logObjectDestruction("VkImage (depth)");
+    }
+
+    if (m_depthImageMemory != VK_NULL_HANDLE) {
+        VK_TRACKED(FreeMemory, vkFreeMemory(m_device.getLogicalDevice(), m_depthImageMemory, nullptr));
+        m_depthImageMemory = VK_NULL_HANDLE;
+        VulkanUtils::logObjectDestruction("VkDeviceMemory (depth)");
+    }
+
+    m_renderPass.cleanup();
+}
+
+void VulkanRenderBackend::recreateSwapchain() {
+    PROFILE_ZONE("RecreateSwapchain");
+    // A resize is not steady state; rebuilding the swapchain may allocate freely
+    ALLOW_ALLOCATIONS();
+    VK_ALLOW_HAZARDS();
+    VulkanUtils::logObjectCreation("VulkanRenderBackend", "Recreating swapchain");
+
+    // Wait for device to be idle
+    waitIdle();
+
+    // Clean up old swapchain-dependent resources
+    for (PipelineSlot& slot : m_pipelines) {
+        if (slot.pipeline) {
+            slot.pipeline->cleanup();
+        }
+    }
+    destroyRenderTargets();
+    destroyColorTarget();
+
+    // Recreate swapchain (or offscreen images), then everything sized or formatted after it
+    createColorTarget();
+    createRenderTargets();
+    for (PipelineSlot& slot : m_pipelines) {
+        if (slot.pipeline) {
+            buildPipeline(slot);
+        }
+    }
+
+    LOG_INFO("Swapchain recreated successfully", "Engine");
+}
+
+void VulkanRenderBackend::buildPipeline(PipelineSlot& slot) {
+    if (!slot.pipeline) {
+        slot.pipeline = std::make_unique<VulkanPipeline>();
+    }
+    slot.pipeline->createGraphicsPipeline(m_device.getLogicalDevice(), m_renderPass.getRenderPass(),
+                                          slot.desc.vertexShaderPath, slot.desc.fragmentShaderPath,
+                                          getColorExtent(), slot.desc.vertexShaderCode, slot.desc.fragmentShaderCode);
+}
+
+void VulkanRenderBackend::createDescriptorPool() {
+    VkDescriptorPoolSize poolSize{};
+    poolSize.type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    poolSize.descriptorCount = MAX_UNIFORM_BUFFERS;
+
+    VkDescriptorPoolCreateInfo poolInfo{};
+    poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    poolInfo.poolSizeCount = 1;
+    poolInfo.pPoolSizes = &poolSize;
+    poolInfo.maxSets = MAX_UNIFORM_BUFFERS;
+
+    VK_CHECK(vkCreateDescriptorPool(m_device.getLogicalDevice(), &poolInfo, nullptr, &m_descriptorPool),
+             "Failed to create descriptor pool");
+
+    VulkanUtils::logObjectCreation("VkDescriptorPool", "Created for uniform buffers");
+}
+
+VkDescriptorSet VulkanRenderBackend::allocateUniformDescriptorSet(const VulkanBuffer& buffer, VkDeviceSize size) {
+    // All pipelines share the same set layout (one uniform buffer at binding 0)
+    const VulkanPipeline* layoutSource = nullptr;
+    for (const PipelineSlot& slot : m_pipelines) {
+        if (slot.pipeline) {
+            layoutSource = slot.pipeline.get();
+            break;
+        }
+    }
+    if (!layoutSource) {
+        throw std::runtime_error("Create a pipeline before creating uniform buffers");
+    }
+    if (m_descriptorSetCount >= MAX_UNIFORM_BUFFERS) {
+        throw std::runtime_error("Out of uniform buffer descriptor sets (max " +
+                                 std::to_string(MAX_UNIFORM_BUFFERS) + ")");
+    }
+
+    VkDescriptorSetLayout setLayout = layoutSource->getDescriptorSetLayout();
+
+    VkDescriptorSetAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    allocInfo.descriptorPool = m_descriptorPool;
+    allocInfo.descriptorSetCount = 1;
+    allocInfo.pSetLayouts = &setLayout;
+
+    VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
+    VK_CHECK(vkAllocateDescriptorSets(m_device.getLogicalDevice(), &allocInfo, &descriptorSet),
+             "Failed to allocate descriptor set");
+    m_descriptorSetCount++;
+
+    VkDescriptorBufferInfo bufferInfo{};
+    bufferInfo.buffer = buffer.getBuffer();
+    bufferInfo.offset = 0;
+    bufferInfo.range = size;
+
+    VkWriteDescriptorSet descriptorWrite{};
+    descriptorWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    descriptorWrite.dstSet = descriptorSet;
+    descriptorWrite.dstBinding = 0;
+    descriptorWrite.dstArrayElement = 0;
+    descriptorWrite.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    descriptorWrite.descriptorCount = 1;
+    descriptorWrite.pBufferInfo = &bufferInfo;
+
+    VK_TRACKED(UpdateDescriptorSets, vkUpdateDescriptorSets(m_device.getLogicalDevice(), 1, &descriptorWrite, 0, nullptr));
+    return descriptorSet;
+}
+
+VulkanRenderBackend::BufferSlot& VulkanRenderBackend::getBufferSlot(BufferHandle buffer) {
+    if (buffer == INVALID_HANDLE || buffer > m_buffers.size() || !m_buffers[buffer - 1].live) {
+        throw std::runtime_error("Invalid buffer handle " + std::to_string(buffer));
+    }
+    return m_buffers[buffer - 1];
+}
+
+void VulkanRenderBackend::writeDynamicRegion(BufferSlot& slot, size_t offset, const void* data, size_t size) {
+    if (!m_frameInProgress) {
+        // Outside a frame there is no slot whose region the GPU is known to be done with
+        throw std::runtime_error("Dynamic vertex buffers can only be updated between beginFrame and submitFrame");
+    }
+    if (offset > slot.regionSize || size > slot.regionSize - offset) {
+        throw std::runtime_error("Dynamic vertex buffer update out of range");
+    }
+
+    // Host-visible memory is coherent, so nothing needs flushing before the submit
+    std::memcpy(slot.mapped + slot.regionStride * m_frameSlot + offset, data, size);
+    static MetricCounter& uploadBytes = MetricsRegistry::getInstance().counter("gpu.upload_bytes");
+    uploadBytes.add(size);
+}
+
+VulkanPipeline& VulkanRenderBackend::getPipeline(PipelineHandle pipeline) {
+    if (pipeline == INVALID_HANDLE || pipeline > m_pipelines.size() || !m_pipelines[pipeline - 1].pipeline) {
+        throw std::runtime_error("Invalid pipeline handle " + std::to_string(pipeline));
+    }
+    return *m_pipelines[pipeline - 1].pipeline;
+}
+
+void VulkanRenderBackend::createDepthBuffer() {
+    VkFormat depthFormat = findDepthFormat();
+
+    // Create depth image
+    VkImageCreateInfo imageInfo{};
+    imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+    imageInfo.imageType = VK_IMAGE_TYPE_2D;
+    imageInfo.extent.width = getColorExtent().width;
+    imageInfo.extent.height = getColorExtent().height;
+    imageInfo.extent.depth = 1;
+    imageInfo.mipLevels = 1;
+    imageInfo.arrayLayers = 1;
+    imageInfo.format = depthFormat;
+    imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+    imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    imageInfo.usage = VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
+    imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+    imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+    VK_CHECK(vkCreateImage(m_device.getLogicalDevice(), &imageInfo, nullptr, &m_depthImage),
+             "Failed to create depth image");
+
+    // Allocate memory for depth image
+    VkMemoryRequirements memRequirements;
+    vkGetImageMemoryRequirements(m_device.getLogicalDevice(), m_depthImage, &memRequirements);
+
+    // Find suitable memory type
+    VkPhysicalDeviceMemoryProperties memProperties;
+    vkGetPhysicalDeviceMemoryProperties(m_device.getPhysicalDevice(), &memProperties);
+
+    uint32_t memoryTypeIndex = UINT32_MAX;
+    for (uint32_t i = 0; i < memProperties.memoryTypeCount; i++) {
+        if ((memRequirements.memoryTypeBits & (1 << i)) &&
+            (memProperties.memoryTypes[i].propertyFlags & VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT) == VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT) {
+            memoryTypeIndex = i;
+            break;
+        }
+    }
+
+    if (memoryTypeIndex == UINT32_MAX) {
+        throw std::runtime_error("Failed to find suitable memory type for depth buffer");
+    }
+
+    VkMemoryAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    allocInfo.allocationSize = memRequirements.size;
+    allocInfo.memoryTypeIndex = memoryTypeIndex;
+
+    VK_CHECK(VK_TRACKED(AllocateMemory, vkAllocateMemory(m_device.getLogicalDevice(), &allocInfo, nullptr, &m_depthImageMemory)),
+             "Failed to allocate depth image memory");
+
+    vkBindImageMemory(m_device.getLogicalDevice(), m_depthImage, m_depthImageMemory, 0);
+
+    // Create depth image view
+    VkImageViewCreateInfo viewInfo{};
+    viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+    viewInfo.image = m_depthImage;
+    viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+    viewInfo.format = depthFormat;
+    viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT;
+    viewInfo.subresourceRange.baseMipLevel = 0;
+    viewInfo.subresourceRange.levelCount = 1;
+    viewInfo.subresourceRange.baseArrayLayer = 0;
+    viewInfo.subresourceRange.layerCount = 1;
+
+    VK_CHECK(vkCreateImageView(m_device.getLogicalDevice(), &viewInfo, nullptr, &m_depthImageView),
+             "Failed to create depth image view");
+
+    LOG_DEBUG("Depth buffer created successfully", "Engine");
+}
+
+VkFormat VulkanRenderBackend::findDepthFormat() {
+    return findSupportedFormat(
+        {VK_FORMAT_D32_SFLOAT, VK_FORMAT_D32_SFLOAT_S8_UINT, VK_FORMAT_D24_UNORM_S8_UINT},
+        VK_IMAGE_TILING_OPTIMAL,
+        VK_FORMAT_FEATURE_DEPTH_STENCIL_ATTACHMENT_BIT
+    );
+}
+
+VkFormat VulkanRenderBackend::findSupportedFormat(const std::vector<VkFormat>& candidates,
+                                                  VkImageTiling tiling, VkFormatFeatureFlags features) {
+    for (VkFormat format : candidates) {
+        VkFormatProperties props;
+        vkGetPhysicalDeviceFormatProperties(m_device.getPhysicalDevice(), format, &props);
+
+        if (tiling == VK_IMAGE_TILING_LINEAR && (props.linearTilingFeatures & features) == features) {
+            return format;
+        } else if (tiling == VK_IMAGE_TILING_OPTIMAL && (props.optimalTilingFeatures & features) == features) {
+            return format;
+        }
+    }
+
+    throw std::runtime_error("Failed to find supported format");
+}
+
+void VulkanRenderBackend::logInitializationState(InitializationState state, const std::string& operation) {
+    LOG_DEBUG("[VulkanRenderBackend] " + operation + "...", "Engine");
+}
+
+} // namespace VulkanGameEngine
@@ -8,13 +8,13 @@ VulkanRenderPass::~VulkanRenderPass() {
 }
 
 void VulkanRenderPass::create(VkDevice device, VkFormat colorFormat, VkFormat depthFormat, 
-                             VkSampleCountFlagBits msaaSamples) {
+                             VkSampleCountFlagBits msaaSamples, VkImageLayout colorFinalLayout) {
     this->device = device;
-    createRenderPass(colorFormat, depthFormat, msaaSamples);
+    createRenderPass(colorFormat, depthFormat, msaaSamples, colorFinalLayout);
 }
 
 void VulkanRenderPass::createRenderPass(VkFormat colorFormat, VkFormat depthFormat, 
-                                       VkSampleCountFlagBits msaaSamples) {
+                                       VkSampleCountFlagBits msaaSamples, VkImageLayout colorFinalLayout) {
     /*
      * Render Pass Creation Overview:
      * 
@@ -58,9 +58,10 @@ void VulkanRenderPass::createRenderPass(VkFormat colorFormat, VkFormat depthForm
      * - VK_IMAGE_LAYOUT_UNDEFINED: Don't care about previous contents
      * - VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL: Optimal for color attachment
      * - VK_IMAGE_LAYOUT_PRESENT_SRC_KHR: Optimal for presentation to swapchain
+     * - VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL: Optimal for copying out (headless readback)
      */
     colorAttachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-    colorAttachment.finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+    colorAttachment.finalLayout = colorFinalLayout;
 
     // Define depth attachment (for 3D depth testing)
     VkAttachmentDescription depthAttachment{};
@@ -10,6 +10,7 @@ VulkanSwapchain::VulkanSwapchain()
     : m_swapchain(VK_NULL_HANDLE)
     , m_imageFormat(VK_FORMAT_UNDEFINED)
     , m_extent({0, 0})
+    , m_transferSource(false)
     , m_device(VK_NULL_HANDLE)
     , m_physicalDevice(VK_NULL_HANDLE)
 {
@@ -54,6 +55,12 @@ void VulkanSwapchain::create(const VulkanDevice& device, VkSurfaceKHR surface, u
     createInfo.imageArrayLayers = 1;  // Always 1 unless developing stereoscopic 3D application
     createInfo.imageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;  // Render directly to images
     
+    // Also copyable where the surface allows it, so frames can be read back for recording
+    m_transferSource = (swapchainSupport.capabilities.supportedUsageFlags & VK_IMAGE_USAGE_TRANSFER_SRC_BIT) != 0;
+    if (m_transferSource) {
+        createInfo.imageUsage |= VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+    }
+    
     // Queue family handling
     const auto& queueFamilyIndices = device.getQueueFamilyIndices();
     uint32_t queueFamilyIndicesArray[] = {
@@ -141,6 +148,7 @@ void VulkanSwapchain::cleanup() {
     // Reset properties
     m_imageFormat = VK_FORMAT_UNDEFINED;
     m_extent = {0, 0};
+    m_transferSource = false;
     m_device = VK_NULL_HANDLE;
     m_physicalDevice = VK_NULL_HANDLE;
 }
@@ -1,5 +1,6 @@
 #include "../headers/VulkanSynchronization.h"
 #include "../headers/VulkanUtils.h"
+#include "../headers/VulkanCallStats.h"
 
 namespace VulkanGameEngine {
 
@@ -52,7 +53,7 @@ bool VulkanSynchronization::waitForFrame(uint32_t frameIndex, uint64_t timeout)
     }
     
     VkFence fence = m_frameSyncObjects[frameIndex].inFlightFence;
-    VkResult result = vkWaitForFences(m_device, 1, &fence, VK_TRUE, timeout);
+    VkResult result = VK_TRACKED(WaitForFences, vkWaitForFences(m_device, 1, &fence, VK_TRUE, timeout));
     
     if (result == VK_SUCCESS) {
         return true;
@@ -71,7 +72,7 @@ void VulkanSynchronization::resetFrameFence(uint32_t frameIndex) {
     }
     
     VkFence fence = m_frameSyncObjects[frameIndex].inFlightFence;
-    VK_CHECK(vkResetFences(m_device, 1, &fence), "Failed to reset frame fence");
+    VK_CHECK(VK_TRACKED(ResetFences, vkResetFences(m_device, 1, &fence)), "Failed to reset frame fence");
 }
 
 bool VulkanSynchronization::waitForAllFrames(uint64_t timeout) {
@@ -89,8 +90,8 @@ bool VulkanSynchronization::waitForAllFrames(uint64_t timeout) {
         allFences.push_back(frameSync.inFlightFence);
     }
     
-    VkResult result = vkWaitForFences(m_device, static_cast<uint32_t>(allFences.size()),
-                                     allFences.data(), VK_TRUE, timeout);
+    VkResult result = VK_TRACKED(WaitForFences, vkWaitForFences(m_device, static_cast<uint32_t>(allFences.size()),
+                                                               allFences.data(), VK_TRUE, timeout));
     
     if (result == VK_SUCCESS) {
         std::cout << "All frames completed successfully\n";
@@ -173,10 +174,35 @@ void VulkanSynchronization::submitCommandBuffers(VkQueue queue,
     submitInfo.pSignalSemaphores = signalSemaphores.empty() ? nullptr : signalSemaphores.data();
     
     // Submit to queue
-    VK_CHECK(vkQueueSubmit(queue, 1, &submitInfo, fence),
+    VK_CHECK(VK_TRACKED(QueueSubmit, vkQueueSubmit(queue, 1, &submitInfo, fence)),
              "Failed to submit command buffers to queue");
 }
 
+void VulkanSynchronization::submitCommandBuffer(VkQueue queue, VkCommandBuffer commandBuffer,
+                                                VkSemaphore waitSemaphore, VkPipelineStageFlags waitStage,
+                                                VkSemaphore signalSemaphore, VkFence fence) {
+    
+    VkSubmitInfo submitInfo{};
+    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    
+    if (waitSemaphore != VK_NULL_HANDLE) {
+        submitInfo.waitSemaphoreCount = 1;
+        submitInfo.pWaitSemaphores = &waitSemaphore;
+        submitInfo.pWaitDstStageMask = &waitStage;
+    }
+    
+    submitInfo.commandBufferCount = 1;
+    submitInfo.pCommandBuffers = &commandBuffer;
+    
+    if (signalSemaphore != VK_NULL_HANDLE) {
+        submitInfo.signalSemaphoreCount = 1;
+        submitInfo.pSignalSemaphores = &signalSemaphore;
+    }
+    
+    VK_CHECK(VK_TRACKED(QueueSubmit, vkQueueSubmit(queue, 1, &submitInfo, fence)),
+             "Failed to submit command buffer to queue");
+}
+
 VkResult VulkanSynchronization::presentImage(VkQueue presentQueue, VkSwapchainKHR swapchain,
                                             uint32_t imageIndex, const std::vector<VkSemaphore>& waitSemaphores) {
     
@@ -195,14 +221,28 @@ VkResult VulkanSynchronization::presentImage(VkQueue presentQueue, VkSwapchainKH
     presentInfo.pResults = nullptr; // Optional per-swapchain results
     
     // Present the image
-    return vkQueuePresentKHR(presentQueue, &presentInfo);
+    return VK_TRACKED(QueuePresent, vkQueuePresentKHR(presentQueue, &presentInfo));
+}
+
+VkResult VulkanSynchronization::presentImage(VkQueue presentQueue, VkSwapchainKHR swapchain,
+                                            uint32_t imageIndex, VkSemaphore waitSemaphore) {
+    
+    VkPresentInfoKHR presentInfo{};
+    presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
+    presentInfo.waitSemaphoreCount = waitSemaphore != VK_NULL_HANDLE ? 1 : 0;
+    presentInfo.pWaitSemaphores = waitSemaphore != VK_NULL_HANDLE ? &waitSemaphore : nullptr;
+    presentInfo.swapchainCount = 1;
+    presentInfo.pSwapchains = &swapchain;
+    presentInfo.pImageIndices = &imageIndex;
+    
+    return VK_TRACKED(QueuePresent, vkQueuePresentKHR(presentQueue, &presentInfo));
 }
 
 VkResult VulkanSynchronization::acquireNextImage(VkDevice device, VkSwapchainKHR swapchain,
                                                 uint64_t timeout, VkSemaphore semaphore,
                                                 VkFence fence, uint32_t* imageIndex) {
     
-    return vkAcquireNextImageKHR(device, swapchain, timeout, semaphore, fence, imageIndex);
+    return VK_TRACKED(AcquireNextImage, vkAcquireNextImageKHR(device, swapchain, timeout, semaphore, fence, imageIndex));
 }
 
 void VulkanSynchronization::cleanup() {
@@ -372,13 +412,13 @@ VkResult waitForFences(VkDevice device, const std::vector<VkFence>& fences,
         return VK_SUCCESS;
     }
     
-    return vkWaitForFences(device, static_cast<uint32_t>(fences.size()),
-                          fences.data(), waitAll ? VK_TRUE : VK_FALSE, timeout);
+    return VK_TRACKED(WaitForFences, vkWaitForFences(device, static_cast<uint32_t>(fences.size()),
+                                                    fences.data(), waitAll ? VK_TRUE : VK_FALSE, timeout));
 }
 
 void resetFences(VkDevice device, const std::vector<VkFence>& fences) {
     if (!fences.empty()) {
-        VK_CHECK(vkResetFences(device, static_cast<uint32_t>(fences.size()), fences.data()),
+        VK_CHECK(VK_TRACKED(ResetFences, vkResetFences(device, static_cast<uint32_t>(fences.size()), fences.data())),
                  "Failed to reset fences");
     }
 }
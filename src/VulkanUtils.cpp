@@ -1,4 +1,5 @@
 #include "../headers/VulkanUtils.h"
+#include "../headers/AssetArchive.h"
 
 namespace VulkanGameEngine {
 namespace VulkanUtils {
@@ -91,6 +92,17 @@ namespace VulkanUtils {
     }
 
     std::vector<char> readFile(const std::string& filename) {
+        // Mounted archives take precedence over loose files
+        std::vector<char> buffer;
+        if (AssetFileSystem::getInstance().readArchived(filename, buffer)) {
+            if (buffer.empty()) {
+                throw std::runtime_error("Shader file is empty: " + filename + " (in archive)");
+            }
+            LOG_DEBUG("Successfully loaded shader file: " + filename + " (" + std::to_string(buffer.size()) +
+                      " bytes, from archive)", "Shader");
+            return buffer;
+        }
+
         // Check if file exists first for better error messages
         if (!fileExists(filename)) {
             throw std::runtime_error("Shader file not found: " + filename + 
@@ -114,7 +126,7 @@ namespace VulkanUtils {
         }
 
         // Allocate buffer and read file
-        std::vector<char> buffer(fileSize);
+        buffer.resize(fileSize);
         file.seekg(0);  // Go back to beginning
         file.read(buffer.data(), fileSize);
         file.close();
@@ -2,7 +2,16 @@
 #include "VulkanEngine.h"
 #include "VulkanUtils.h"
 #include "Logger.h"
+#include "Profiler.h"
+#include "Metrics.h"
+#include "HitchDetector.h"
+#include "AllocationTracker.h"
+#include "VulkanCallStats.h"
+#include "Benchmark.h"
+#include "SceneGenerator.h"
+#include "AssetArchive.h"
 #include <chrono>
+#include <cstdlib>
 #include <thread>
 
 using namespace VulkanGameEngine;
@@ -19,11 +28,136 @@ using namespace VulkanGameEngine;
  */
 class Application {
 public:
+    // setFrameCapture frame meaning "no fixed frame"
+    static constexpr uint64_t NO_CAPTURE_FRAME = UINT64_MAX;
+
     Application() 
         : m_window(nullptr)
         , m_running(false)
         , m_windowWidth(DEFAULT_WINDOW_WIDTH)
-        , m_windowHeight(DEFAULT_WINDOW_HEIGHT) {
+        , m_windowHeight(DEFAULT_WINDOW_HEIGHT)
+        , m_assertNoAllocations(false)
+        , m_headless(false)
+        , m_headlessFrames(DEFAULT_HEADLESS_FRAMES)
+        , m_backend(BackendType::VULKAN)
+        , m_benchmarking(false)
+        , m_recordingBenchmark(false)
+        , m_hasScene(false)
+        , m_captureFrame(NO_CAPTURE_FRAME)
+        , m_recording(false)
+        , m_hotReload(false) {
+    }
+
+    /**
+     * Renders offscreen without creating a window: no SDL video, no input, a
+     * fixed 60 Hz simulation step, and exit after a set number of frames.
+     * 
+     * @param frames Frames to render before exiting (0 = default)
+     * @param framePath If not empty, the last frame is written there as a PPM
+     * @param backend Backend to render with; the null backend measures CPU cost only
+     */
+    void setHeadless(uint64_t frames, const std::string& framePath, BackendType backend = BackendType::VULKAN) {
+        m_headless = true;
+        m_headlessFrames = frames > 0 ? frames : DEFAULT_HEADLESS_FRAMES;
+        m_headlessFramePath = framePath;
+        m_backend = backend;
+    }
+
+    /**
+     * Replays a benchmark script instead of live input: fixed time step,
+     * scripted camera path and movement, warmup then measured frames, and a
+     * JSON report written on exit.
+     * 
+     * @param scriptPath Script to replay (format in headers/Benchmark.h)
+     * @param reportPath Where the JSON report is written
+     * @return false if the script could not be loaded
+     */
+    bool setBenchmark(const std::string& scriptPath, const std::string& reportPath) {
+        std::string error;
+        if (!BenchmarkScript::load(scriptPath, m_benchmarkScript, error)) {
+            std::cerr << error << std::endl;
+            return false;
+        }
+        m_benchmarking = true;
+        m_benchmarkScriptPath = scriptPath;
+        m_benchmarkReportPath = reportPath;
+        m_headlessFrames = m_benchmarkScript.getTotalFrames();
+        if (m_benchmarkScript.width > 0 && m_benchmarkScript.height > 0) {
+            m_windowWidth = m_benchmarkScript.width;
+            m_windowHeight = m_benchmarkScript.height;
+        }
+        return true;
+    }
+
+    /**
+     * Records the camera path of an interactive session and writes it as a
+     * benchmark script on exit.
+     */
+    void setRecordBenchmark(const std::string& scriptPath) {
+        m_recordingBenchmark = true;
+        m_recordScriptPath = scriptPath;
+        m_recordedScript = BenchmarkScript();
+        m_recordedScript.name = "recorded";
+    }
+
+    /**
+     * Replaces the default content with a generated scene (see SceneGenerator).
+     * Benchmarks and headless runs follow the generated camera path; windowed
+     * runs start on it and then take WASD input as usual.
+     */
+    void setScene(const SceneGenerator::Config& config) {
+        m_hasScene = true;
+        m_sceneConfig = config;
+    }
+
+    /**
+     * Enables frame capture (see FrameCapture). Headless and benchmark runs
+     * capture the given frame, or their last one; windowed runs capture it
+     * too if given, and capture the next frame whenever F9 is pressed.
+     * 
+     * @param path Where captures are written (F9 overwrites it)
+     * @param frame Frame to capture (NO_CAPTURE_FRAME = last headless frame / F9 only)
+     */
+    void setFrameCapture(const std::string& path, uint64_t frame) {
+        m_capturePath = path;
+        m_captureFrame = frame;
+        m_engine.enableFrameCapture();
+    }
+
+    /**
+     * Writes the startup timeline (every startup phase on the thread that ran
+     * it) as Chrome trace JSON once initialization has finished
+     */
+    void setStartupTrace(const std::string& path) { m_startupTracePath = path; }
+
+    /**
+     * Records frames to disk for the whole run (see FrameRecorder)
+     */
+    void setRecording(const FrameRecorder::Config& config) {
+        m_recording = true;
+        m_recordingConfig = config;
+    }
+
+    /**
+     * Reloads changed meshes and shaders while the game runs (see VulkanEngine::enableHotReload)
+     */
+    void setHotReload(bool enabled) { m_hotReload = enabled; }
+
+    /**
+     * Fails the run (abort) if render() allocates once the loop has warmed up.
+     * Only effective in builds with ENABLE_ALLOCATION_TRACKING.
+     */
+    void setAssertNoAllocations(bool enabled) {
+        m_assertNoAllocations = enabled;
+        AllocationTracker::setAbortOnViolation(enabled);
+    }
+
+    /**
+     * Fails the run (abort) if render() makes a stalling or allocating Vulkan
+     * call such as vkQueueWaitIdle or vkAllocateMemory.
+     */
+    void setAssertNoStalls(bool enabled) {
+        VulkanCallStats::setAbortOnHazard(enabled);
     }
 
     ~Application() {
@@ -41,51 +175,135 @@ public:
         Logger::getInstance().setColorEnabled(true);
         Logger::getInstance().setTimestampEnabled(true);
         
+        // Format and write log output on a background thread so the render loop never waits on the terminal
+        Logger::getInstance().enableAsync();
+        Profiler::getInstance().setThreadName("Main");
+        
+        // Frame-time percentiles over a rolling 10 s window, appended to metrics.csv every 10 s
+        MetricsRegistry::Config metricsConfig;
+        metricsConfig.exportPath = "metrics.csv";
+        MetricsRegistry::getInstance().configure(metricsConfig);
+        
+        // Frames over 2x the median frame time dump the surrounding frames to hitch_<frame>.json
+        HitchDetector::getInstance().watchCounter("gpu.upload_bytes");
+        HitchDetector::getInstance().watchCounter("alloc.count");
+        HitchDetector::getInstance().watchCounter("vk.calls");
+        HitchDetector::getInstance().watchCounter("vk.cpu_us");
+        HitchDetector::getInstance().watchCounter("vk.hazards");
+        
         LOG_INFO("=== Vulkan 3D Game Engine ===", "App");
         LOG_INFO("Initializing application...", "App");
         
-        // Initialize SDL
-        if (!SDL_Init(SDL_INIT_VIDEO)) {
-            LOG_ERROR("Failed to initialize SDL: " + std::string(SDL_GetError()), "SDL");
+        // SDL and the engine start as one dependency graph: file reads and parsing
+        // run on worker threads while the main thread brings up SDL and the device
+        StartupGraph graph;
+        std::vector<StartupGraph::PhaseId> windowPhases;
+        if (!m_headless) {
+            windowPhases.push_back(addWindowPhases(graph));
+        }
+        const StartupGraph::PhaseId engineReady = m_engine.addStartupPhases(
+            graph, m_window, windowPhases, m_windowWidth, m_windowHeight, m_backend);
+        graph.add("GenerateScene", [this] {
+            if (!generateScene()) {
+                throw std::runtime_error("Scene generation failed");
+            }
+        }, {engineReady}, StartupGraph::Affinity::MAIN_THREAD);
+        
+        try {
+            m_engine.runStartup(graph);
+        } catch (const std::exception& e) {
+            LOG_ERROR("Failed to initialize: " + std::string(e.what()), "App");
             return false;
         }
         
-        LOG_INFO("SDL initialized successfully", "SDL");
+        if (m_headless) {
+            // Same animation on every run, independent of how fast frames render
+            m_engine.setFixedTimeStep(1.0f / 60.0f);
+            LOG_INFO("Engine initialized headless ({} backend): {}x{}, {} frames", "Engine",
+                     getBackendName(m_backend), m_windowWidth, m_windowHeight, m_headlessFrames);
+        } else {
+            LOG_INFO("Vulkan engine initialized successfully!", "Engine");
+        }
         
-        // Check if Vulkan is supported
-        if (!SDL_Vulkan_LoadLibrary(nullptr)) {
-            LOG_ERROR("Failed to load Vulkan library: " + std::string(SDL_GetError()), "SDL");
-            return false;
+        // Everything so far ran before the first frame mark, i.e. in profiler frame 0
+        if (!m_startupTracePath.empty() &&
+            Profiler::getInstance().exportChromeTrace(m_startupTracePath, 0, 0)) {
+            LOG_INFO("Wrote startup trace to " + m_startupTracePath, "App");
         }
         
-        LOG_INFO("Vulkan library loaded successfully", "SDL");
+        m_running = true;
+        return true;
+    }
+
+    /**
+     * Adds SDL initialization and window creation to the startup graph
+     * (main thread only, as SDL requires)
+     * 
+     * @return Phase that creates m_window
+     */
+    StartupGraph::PhaseId addWindowPhases(StartupGraph& graph) {
+        using Affinity = StartupGraph::Affinity;
+        
+        const StartupGraph::PhaseId initSdl = graph.add("InitSDL", [] {
+            if (!SDL_Init(SDL_INIT_VIDEO)) {
+                throw std::runtime_error("Failed to initialize SDL: " + std::string(SDL_GetError()));
+            }
+            LOG_INFO("SDL initialized successfully", "SDL");
+        }, {}, Affinity::MAIN_THREAD);
         
-        // Create window
-        m_window = SDL_CreateWindow(
-            APPLICATION_NAME,
-            m_windowWidth, m_windowHeight,
-            SDL_WINDOW_VULKAN | SDL_WINDOW_RESIZABLE
-        );
+        // Check if Vulkan is supported
+        const StartupGraph::PhaseId loadVulkan = graph.add("LoadVulkanLibrary", [] {
+            if (!SDL_Vulkan_LoadLibrary(nullptr)) {
+                throw std::runtime_error("Failed to load Vulkan library: " + std::string(SDL_GetError()));
+            }
+            LOG_INFO("Vulkan library loaded successfully", "SDL");
+        }, {initSdl}, Affinity::MAIN_THREAD);
         
-        if (!m_window) {
-            LOG_ERROR("Failed to create SDL window: " + std::string(SDL_GetError()), "SDL");
-            return false;
+        return graph.add("CreateWindow", [this] {
+            m_window = SDL_CreateWindow(
+                APPLICATION_NAME,
+                m_windowWidth, m_windowHeight,
+                SDL_WINDOW_VULKAN | SDL_WINDOW_RESIZABLE
+            );
+            if (!m_window) {
+                throw std::runtime_error("Failed to create SDL window: " + std::string(SDL_GetError()));
+            }
+            LOG_INFO("Window created: " + std::to_string(m_windowWidth) + "x" + std::to_string(m_windowHeight), "SDL");
+        }, {loadVulkan}, Affinity::MAIN_THREAD);
+    }
+
+    /**
+     * Builds the scene requested with setScene() and points the camera at it
+     * 
+     * @return false if the scene could not be generated
+     */
+    bool generateScene() {
+        if (!m_hasScene) {
+            return true;
         }
         
-        LOG_INFO("Window created: " + std::to_string(m_windowWidth) + "x" + std::to_string(m_windowHeight), "SDL");
-        
-        // Initialize Vulkan engine
         try {
-            LOG_PERF_START(VulkanEngineInit);
-            m_engine.initialize(m_window, m_windowWidth, m_windowHeight);
-            LOG_PERF_END(VulkanEngineInit);
-            LOG_INFO("Vulkan engine initialized successfully!", "Engine");
+            SceneGenerator::generate(m_sceneConfig, m_engine.getScene(), m_engine.getBackend());
         } catch (const std::exception& e) {
-            LOG_ERROR("Failed to initialize Vulkan engine: " + std::string(e.what()), "Engine");
+            LOG_ERROR("Failed to generate scene: " + std::string(e.what()), "Scene");
             return false;
         }
+        m_engine.setViewDistance(SceneGenerator::getViewDistance(m_engine.getScene()));
         
-        m_running = true;
+        // Benchmarks swap in the generated camera path; other runs get it spread over their frame count
+        BenchmarkScript& cameraScript = m_benchmarking ? m_benchmarkScript : m_sceneCameraScript;
+        if (!m_benchmarking) {
+            m_sceneCameraScript.warmupFrames = 0;
+            m_sceneCameraScript.measuredFrames = m_headlessFrames;
+        }
+        SceneGenerator::generateCameraPath(m_sceneConfig, m_engine.getScene(), cameraScript);
+        
+        glm::vec3 position;
+        glm::vec3 target;
+        if (cameraScript.sampleCamera(0, position, target)) {
+            m_engine.setCamera(position, target);
+        }
+        LOG_INFO("Scene: {}", "Scene", SceneGenerator::describe(m_sceneConfig));
         return true;
     }
 
@@ -105,15 +323,34 @@ public:
         }
         
         LOG_INFO("=== Starting Main Loop ===", "App");
-        LOG_INFO("Controls:", "App");
-        LOG_INFO("  - WASD: Move camera around the scene", "App");
-        LOG_INFO("  - ESC: Exit application", "App");
-        LOG_INFO("  - F11: Toggle fullscreen (not implemented)", "App");
-        LOG_INFO("  - Resize window to test swapchain recreation", "App");
-        LOG_INFO("  - Close window with X button to exit", "App");
-        
-        // Check if we're rendering character or fallback cube
-        if (m_engine.getMainCharacter().isLoaded()) {
+        if (m_benchmarking) {
+            // The script's time step replaces the real frame time, so every run simulates the same frames
+            m_engine.setFixedTimeStep(m_benchmarkScript.timeStep);
+            m_benchmarkReport.begin(m_benchmarkScript.measuredFrames);
+            LOG_INFO("Benchmark '{}': {} warmup + {} measured frames", "Benchmark",
+                     m_benchmarkScript.name, m_benchmarkScript.warmupFrames, m_benchmarkScript.measuredFrames);
+        } else if (m_headless) {
+            LOG_INFO("Headless: rendering {} frames offscreen", "App", m_headlessFrames);
+        } else {
+            LOG_INFO("Controls:", "App");
+            LOG_INFO("  - WASD: Move camera around the scene", "App");
+            LOG_INFO("  - C: Cycle the character's vertex color mode", "App");
+            LOG_INFO("  - ESC: Exit application", "App");
+            LOG_INFO("  - F11: Toggle fullscreen (not implemented)", "App");
+            LOG_INFO("  - F12: Capture a CPU trace of the next 120 frames", "App");
+            if (!m_capturePath.empty()) {
+                LOG_INFO("  - F9: Capture the next frame to " + m_capturePath, "App");
+            }
+            LOG_INFO("  - Resize window to test swapchain recreation", "App");
+            LOG_INFO("  - Close window with X button to exit", "App");
+        }
+        
+        // Check if we're rendering a generated scene, the character or the fallback cube
+        if (!m_engine.getScene().empty()) {
+            const Scene::Stats& sceneStats = m_engine.getScene().getStats();
+            LOG_INFO("Rendering generated scene: {} objects, {} triangles per frame", "App",
+                     sceneStats.objects, sceneStats.trianglesPerFrame);
+        } else if (m_engine.getMainCharacter().isLoaded()) {
             LOG_INFO("Rendering 3D character model at origin (0,0,0)...", "App");
             LOG_INFO("Camera positioned at (10,5,10) looking at character", "App");
         } else {
@@ -121,46 +358,140 @@ public:
             LOG_INFO("Camera positioned at (10,5,10) looking at cube", "App");
         }
         
+        // Runs with a known length capture their last frame unless told otherwise
+        if (!m_capturePath.empty() && m_captureFrame == NO_CAPTURE_FRAME && (m_headless || m_benchmarking)) {
+            m_captureFrame = m_headlessFrames - 1;
+        }
+        
+        if (m_recording) {
+            try {
+                m_engine.startRecording(m_recordingConfig);
+            } catch (const std::exception& e) {
+                LOG_ERROR("Failed to start recording: " + std::string(e.what()), "App");
+                return;
+            }
+        }
+        
+        if (m_hotReload) {
+            m_engine.enableHotReload();
+        }
+        
         auto lastTime = std::chrono::high_resolution_clock::now();
         uint64_t frameCount = 0;
         float fpsTimer = 0.0f;
         uint32_t consecutiveErrors = 0;
         const uint32_t maxConsecutiveErrors = 5;
         
+        MetricsRegistry& metrics = MetricsRegistry::getInstance();
+        MetricHistogram& frameTimeMetric = metrics.histogram("frame.total", "ms", 1e6);
+        
         LOG_INFO("Entering render loop - window should now be visible!", "App");
         
         while (m_running) {
+            PROFILE_FRAME_MARK();
+            PROFILE_ZONE("Frame");
+            
             auto currentTime = std::chrono::high_resolution_clock::now();
             float deltaTime = std::chrono::duration<float>(currentTime - lastTime).count();
+            const int64_t frameNs = std::chrono::duration_cast<std::chrono::nanoseconds>(currentTime - lastTime).count();
+            // Fold the finished frame into its counters before a hitch dump snapshots them
+            AllocationTracker::endFrame();
+            VulkanCallStats::endFrame();
+            if (frameCount > 0) {
+                frameTimeMetric.record(static_cast<uint64_t>(frameNs));
+                // PROFILE_FRAME_MARK above already started the next frame
+                HitchDetector::getInstance().endFrame(Profiler::getInstance().getFrameIndex() - 1, frameNs);
+            }
             lastTime = currentTime;
+            metrics.update();
             
-            // Process events first - this is critical for keeping window responsive
-            processEvents();
+            if (m_benchmarking && frameCount > m_benchmarkScript.warmupFrames) {
+                recordBenchmarkFrame(frameNs);
+            }
             
-            // Only exit if user explicitly requested it
-            if (!m_running) {
-                LOG_INFO("Exit requested by user", "App");
-                break;
+            if (m_headless) {
+                // No window, no input: stop once the requested number of frames is rendered
+                if (frameCount >= m_headlessFrames) {
+                    break;
+                }
+            } else {
+                // Process events first - this is critical for keeping window responsive
+                {
+                    PROFILE_ZONE("ProcessEvents");
+                    processEvents();
+                }
+                
+                // Only exit if user explicitly requested it
+                if (!m_running) {
+                    LOG_INFO("Exit requested by user", "App");
+                    break;
+                }
+                
+                // Handle camera movement with WASD keys (benchmarks replay their script instead)
+                if (m_benchmarking) {
+                    if (frameCount >= m_headlessFrames) {
+                        break;
+                    }
+                } else {
+                    handleCameraMovement(deltaTime);
+                }
+                if (m_recordingBenchmark) {
+                    // Replays hold the starting camera through the warmup frames
+                    if (m_recordedScript.cameraPath.empty()) {
+                        m_recordedScript.addCameraKey(0, m_engine.getCameraPosition(), m_engine.getCameraTarget());
+                    }
+                    m_recordedScript.addCameraKey(m_recordedScript.warmupFrames + frameCount,
+                                                  m_engine.getCameraPosition(), m_engine.getCameraTarget());
+                }
             }
             
-            // Handle camera movement with WASD keys
-            handleCameraMovement(deltaTime);
+            if (m_benchmarking) {
+                applyScriptFrame(m_benchmarkScript, frameCount);
+            } else if (m_headless && m_hasScene) {
+                applyScriptFrame(m_sceneCameraScript, frameCount);
+            }
             
             // Render frame with error handling
             try {
-                m_engine.render();
+                if (frameCount == m_captureFrame) {
+                    m_engine.captureNextFrame(m_capturePath);
+                }
+                // Wait-idle and allocation calls made by render() are reported as hazards
+                VK_FRAME_SCOPE();
+                if (m_assertNoAllocations && frameCount >= ALLOCATION_WARMUP_FRAMES) {
+                    // Steady state: the render path must not touch the heap
+                    ASSERT_NO_ALLOCATIONS();
+                    m_engine.render();
+                } else {
+                    m_engine.render();
+                }
                 frameCount++;
                 consecutiveErrors = 0; // Reset error counter on successful render
                 
                 // Update FPS counter every second
                 fpsTimer += deltaTime;
                 if (fpsTimer >= 1.0f) {
-                    float fps, frameTime;
-                    m_engine.getFrameStats(fps, frameTime);
+                    VulkanEngine::FrameStats stats;
+                    m_engine.getFrameStats(stats);
                     
-                    LOG_INFO("FPS: " + std::to_string(static_cast<int>(fps)) + 
-                            " | Frame Time: " + std::to_string(frameTime) + "ms" +
-                            " | Total Frames: " + std::to_string(frameCount), "Performance");
+                    if (stats.gpuTimeValid) {
+                        LOG_INFO("FPS: {} | CPU: {:.2f}ms | GPU: {:.2f}ms | Fence wait: {:.2f}ms ({}-bound) | Total Frames: {}",
+                                 "Performance", static_cast<int>(stats.fps), stats.cpuFrameTimeMs, stats.gpuTimeMs,
+                                 stats.fenceWaitMs, stats.gpuBound ? "GPU" : "CPU", frameCount);
+                    } else {
+                        LOG_INFO("FPS: {} | CPU: {:.2f}ms | Total Frames: {}", "Performance",
+                                 static_cast<int>(stats.fps), stats.cpuFrameTimeMs, frameCount);
+                    }
+                    LOG_INFO("Commands: {} ({} draws, {} triangles) | Vulkan calls: {} ({} draws) | Vulkan CPU: {:.3f}ms | Stalls: {}",
+                             "Performance", stats.commandCount, stats.recordedDraws, stats.recordedTriangles,
+                             stats.vulkanCalls, stats.drawCalls, stats.vulkanCpuMs, stats.vulkanHazards);
+                    
+                    // Averages hide stutters; the tail of the rolling window shows them
+                    HistogramSummary frameSummary;
+                    if (metrics.getSummary("frame.total", frameSummary) && frameSummary.count > 0) {
+                        LOG_INFO("Frame time p50: {:.2f}ms | p95: {:.2f}ms | p99: {:.2f}ms | max: {:.2f}ms", "Performance",
+                                 frameSummary.p50, frameSummary.p95, frameSummary.p99, frameSummary.max);
+                    }
                     
                     fpsTimer = 0.0f;
                 }
@@ -186,6 +517,29 @@ public:
         }
         
         LOG_INFO("Main loop ended. Total frames rendered: " + std::to_string(frameCount), "App");
+        
+        // Frames still in flight are written before the run reports anything else
+        m_engine.stopRecording();
+        
+        if (m_benchmarking) {
+            writeBenchmarkReport();
+        }
+        if (m_recordingBenchmark && frameCount > 0) {
+            m_recordedScript.measuredFrames = frameCount;
+            m_recordedScript.width = m_windowWidth;
+            m_recordedScript.height = m_windowHeight;
+            if (m_recordedScript.save(m_recordScriptPath)) {
+                LOG_INFO("Recorded camera path of {} frames to {}", "Benchmark", frameCount, m_recordScriptPath);
+            }
+        }
+        
+        if (m_headless && !m_headlessFramePath.empty() && frameCount > 0) {
+            try {
+                m_engine.saveFrame(m_headlessFramePath);
+            } catch (const std::exception& e) {
+                LOG_ERROR("Failed to save frame: " + std::string(e.what()), "App");
+            }
+        }
     }
 
     /**
@@ -194,6 +548,9 @@ public:
     void cleanup() {
         LOG_INFO("Cleaning up application...", "App");
         
+        // Write the final metrics window before shutting anything down
+        MetricsRegistry::getInstance().exportNow();
+        
         // Clean up Vulkan engine first
         m_engine.cleanup();
         
@@ -204,8 +561,11 @@ public:
             VulkanUtils::logObjectDestruction("SDL_Window");
         }
         
-        SDL_Vulkan_UnloadLibrary();
-        SDL_Quit();
+        // Headless runs never initialized SDL
+        if (!m_headless) {
+            SDL_Vulkan_UnloadLibrary();
+            SDL_Quit();
+        }
         
         LOG_INFO("Application cleanup completed", "App");
     }
@@ -216,6 +576,46 @@ private:
     bool m_running;
     uint32_t m_windowWidth;
     uint32_t m_windowHeight;
+    bool m_assertNoAllocations;             // Abort if the steady-state render path allocates
+    bool m_headless;                        // Render offscreen without a window
+    uint64_t m_headlessFrames;              // Frames to render before a headless run exits
+    std::string m_headlessFramePath;        // PPM file for the last headless frame (empty = none)
+    BackendType m_backend;                  // Backend a headless run renders with
+    std::string m_startupTracePath;         // Chrome trace of startup (empty = none)
+    
+    // Benchmark replay and recording
+    bool m_benchmarking;                    // Replaying m_benchmarkScript instead of live input
+    BenchmarkScript m_benchmarkScript;
+    std::string m_benchmarkScriptPath;
+    std::string m_benchmarkReportPath;
+    BenchmarkReport m_benchmarkReport;
+    bool m_recordingBenchmark;              // Writing the session's camera path as a script on exit
+    BenchmarkScript m_recordedScript;
+    std::string m_recordScriptPath;
+    
+    // Generated scene
+    bool m_hasScene;                        // Render a SceneGenerator scene instead of the character
+    SceneGenerator::Config m_sceneConfig;
+    BenchmarkScript m_sceneCameraScript;    // Camera path of non-benchmark scene runs
+    
+    // Frame capture (framereplay input)
+    std::string m_capturePath;              // Empty = capture disabled
+    uint64_t m_captureFrame;                // Frame to capture automatically
+    
+    // Frame recording (images or video of the run)
+    bool m_recording;
+    FrameRecorder::Config m_recordingConfig;
+    
+    bool m_hotReload;                       // Watch assets and shaders and reload them on change
+    
+    // Frames rendered before the no-allocation assertion kicks in (lazy first-use setup is allowed)
+    static constexpr uint64_t ALLOCATION_WARMUP_FRAMES = 120;
+    
+    // Frames a headless run renders unless --frames says otherwise
+    static constexpr uint64_t DEFAULT_HEADLESS_FRAMES = 300;
+    
+    // Color modes the C key cycles through (FACES only suits the cube's face layout)
+    static constexpr uint32_t CHARACTER_COLOR_MODES = static_cast<uint32_t>(ColorMode::FACES);
 
     /**
      * Processes SDL events (keyboard, mouse, window events).
@@ -257,6 +657,73 @@ private:
         }
     }
 
+    /**
+     * Applies a script's camera and movement for a frame.
+     */
+    void applyScriptFrame(const BenchmarkScript& script, uint64_t frame) {
+        glm::vec3 position;
+        glm::vec3 target;
+        if (script.sampleCamera(frame, position, target)) {
+            m_engine.setCamera(position, target);
+        }
+        
+        // Scripted movement goes through the same path as WASD, advanced by the fixed step
+        float forward = 0.0f;
+        float right = 0.0f;
+        script.sampleInput(frame, forward, right);
+        if (forward != 0.0f || right != 0.0f) {
+            m_engine.moveCamera(forward, right, script.timeStep);
+        }
+    }
+
+    /**
+     * Adds the frame that just finished to the benchmark report
+     */
+    void recordBenchmarkFrame(int64_t frameNs) {
+        VulkanEngine::FrameStats stats;
+        m_engine.getFrameStats(stats);
+        
+        BenchmarkFrame frame;
+        frame.frameMs = frameNs / 1e6;
+        frame.cpuMs = stats.cpuFrameTimeMs;
+        frame.fenceWaitMs = stats.fenceWaitMs;
+        frame.gpuTimeValid = stats.gpuTimeValid;
+        frame.gpuMs = stats.gpuTimeMs;
+        frame.allocations = AllocationTracker::getLastFrameAllocations();
+        frame.vulkanCalls = stats.vulkanCalls;
+        frame.drawCalls = stats.drawCalls;
+        frame.recordedDraws = stats.recordedDraws;
+        frame.triangles = stats.recordedTriangles;
+        m_benchmarkReport.recordFrame(frame);
+    }
+
+    void writeBenchmarkReport() {
+        BenchmarkRunInfo info;
+        info.scriptPath = m_benchmarkScriptPath;
+        info.backend = getBackendName(m_backend);
+        info.headless = m_headless;
+        info.width = m_windowWidth;
+        info.height = m_windowHeight;
+        if (m_hasScene) {
+            const Scene::Stats& sceneStats = m_engine.getScene().getStats();
+            info.scene = SceneGenerator::describe(m_sceneConfig);
+            info.sceneObjects = sceneStats.objects;
+            info.sceneDynamicObjects = sceneStats.dynamicObjects;
+            info.sceneMeshes = sceneStats.meshes;
+            info.sceneMaterials = sceneStats.materials;
+        }
+        
+        if (m_benchmarkReport.getFrameCount() < m_benchmarkScript.measuredFrames) {
+            LOG_WARN("Benchmark stopped early: {} of {} frames measured", "Benchmark",
+                     m_benchmarkReport.getFrameCount(), m_benchmarkScript.measuredFrames);
+        }
+        if (m_benchmarkReport.write(m_benchmarkReportPath, m_benchmarkScript, info)) {
+            LOG_INFO("Benchmark '{}': median frame {:.3f}ms over {} frames, report written to {}", "Benchmark",
+                     m_benchmarkScript.name, m_benchmarkReport.getMedianFrameMs(),
+                     m_benchmarkReport.getFrameCount(), m_benchmarkReportPath);
+        }
+    }
+
     /**
      * Handles WASD camera movement based on current keyboard state.
      */
@@ -298,10 +765,32 @@ private:
                 m_running = false;
                 break;
             
+            case SDLK_C: {
+                // Colors come from the vertex shader, so this only changes the next frame's push constants
+                MainCharacter& character = m_engine.getMainCharacter();
+                const auto next = (static_cast<uint32_t>(character.getColorMode()) + 1) % CHARACTER_COLOR_MODES;
+                character.setColorMode(static_cast<ColorMode>(next));
+                LOG_INFO("Character color mode {}", "Input", next);
+                break;
+            }
+            
             case SDLK_F11:
                 LOG_DEBUG("F11 pressed - fullscreen toggle not implemented", "Input");
                 break;
             
+            case SDLK_F9:
+                if (m_capturePath.empty()) {
+                    LOG_INFO("F9 pressed - run with --capture <file> to enable frame capture", "Input");
+                } else {
+                    m_engine.captureNextFrame(m_capturePath);
+                }
+                break;
+            
+            case SDLK_F12:
+                // Open the result in chrome://tracing or ui.perfetto.dev
+                Profiler::getInstance().captureFrames(120, "trace.json");
+                break;
+            
             default:
                 // Ignore other keys
                 break;
@@ -341,8 +830,156 @@ private:
  * 3. Handles any top-level exceptions
  * 4. Ensures proper cleanup on exit
  */
-int main() {
+int main(int argc, char* argv[]) {
     Application app;
+    bool headless = false;
+    uint64_t headlessFrames = 0;
+    std::string headlessFramePath;
+    BackendType backend = BackendType::VULKAN;
+    std::string benchmarkScript;
+    std::string benchmarkReport = "benchmark.json";
+    std::string recordScript;
+    std::string sceneSpec;
+    bool hasScene = false;
+    std::string capturePath;
+    uint64_t captureFrame = Application::NO_CAPTURE_FRAME;
+    FrameRecorder::Config recordConfig;
+    std::vector<std::string> archives;
+    bool hotReload = false;
+    
+    for (int i = 1; i < argc; ++i) {
+        const std::string argument = argv[i];
+        if (argument == "--assert-no-alloc") {
+            if (!AllocationTracker::isCompiledIn()) {
+                std::cerr << "--assert-no-alloc requires a build with ENABLE_ALLOCATION_TRACKING=ON" << std::endl;
+                return 1;
+            }
+            app.setAssertNoAllocations(true);
+        } else if (argument == "--assert-no-stalls") {
+            app.setAssertNoStalls(true);
+        } else if (argument == "--headless") {
+            headless = true;
+        } else if (argument == "--frames" && i + 1 < argc) {
+            headlessFrames = std::strtoull(argv[++i], nullptr, 10);
+        } else if (argument == "--save-frame" && i + 1 < argc) {
+            headlessFramePath = argv[++i];
+        } else if (argument == "--benchmark" && i + 1 < argc) {
+            benchmarkScript = argv[++i];
+        } else if (argument == "--benchmark-report" && i + 1 < argc) {
+            benchmarkReport = argv[++i];
+        } else if (argument == "--record-benchmark" && i + 1 < argc) {
+            recordScript = argv[++i];
+        } else if (argument == "--scene" && i + 1 < argc) {
+            sceneSpec = argv[++i];
+            hasScene = true;
+        } else if (argument == "--capture" && i + 1 < argc) {
+            capturePath = argv[++i];
+        } else if (argument == "--capture-frame" && i + 1 < argc) {
+            captureFrame = std::strtoull(argv[++i], nullptr, 10);
+        } else if (argument == "--startup-trace" && i + 1 < argc) {
+            app.setStartupTrace(argv[++i]);
+        } else if (argument == "--record" && i + 1 < argc) {
+            recordConfig.path = argv[++i];
+            recordConfig.format = FrameRecorder::getFormatForPath(recordConfig.path);
+        } else if (argument == "--record-every" && i + 1 < argc) {
+            recordConfig.every = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (argument == "--record-fps" && i + 1 < argc) {
+            recordConfig.fps = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (argument == "--pak" && i + 1 < argc) {
+            archives.push_back(argv[++i]);
+        } else if (argument == "--hot-reload") {
+            hotReload = true;
+        } else if (argument == "--backend" && i + 1 < argc) {
+            if (!parseBackendType(argv[++i], backend)) {
+                std::cerr << "Unknown backend: " << argv[i] << " (expected vulkan or null)" << std::endl;
+                return 1;
+            }
+        } else {
+            std::cerr << "Unknown argument: " << argument << std::endl;
+            return 1;
+        }
+    }
+    
+    // The null backend has nothing to present, so it always runs headless
+    if (backend == BackendType::NULL_BACKEND) {
+        headless = true;
+        if (!headlessFramePath.empty() || !recordConfig.path.empty()) {
+            std::cerr << "--save-frame and --record need the vulkan backend; the null backend produces no images" << std::endl;
+            return 1;
+        }
+    }
+    
+    if (headless) {
+        app.setHeadless(headlessFrames, headlessFramePath, backend);
+    } else if (headlessFrames > 0 || !headlessFramePath.empty()) {
+        std::cerr << "--frames and --save-frame require --headless" << std::endl;
+        return 1;
+    }
+    
+    // Benchmarks run as many frames as their script says, windowed or headless
+    if (!benchmarkScript.empty()) {
+        if (headlessFrames > 0 || !recordScript.empty()) {
+            std::cerr << "--benchmark cannot be combined with --frames or --record-benchmark" << std::endl;
+            return 1;
+        }
+        if (!app.setBenchmark(benchmarkScript, benchmarkReport)) {
+            return 1;
+        }
+    }
+    if (!recordScript.empty()) {
+        if (headless) {
+            std::cerr << "--record-benchmark records live input and needs a window" << std::endl;
+            return 1;
+        }
+        app.setRecordBenchmark(recordScript);
+    }
+    
+    if (!capturePath.empty()) {
+        app.setFrameCapture(capturePath, captureFrame);
+    } else if (captureFrame != Application::NO_CAPTURE_FRAME) {
+        std::cerr << "--capture-frame requires --capture" << std::endl;
+        return 1;
+    }
+    
+    if (!recordConfig.path.empty()) {
+        if (recordConfig.every == 0 || recordConfig.fps == 0) {
+            std::cerr << "--record-every and --record-fps must be at least 1" << std::endl;
+            return 1;
+        }
+        app.setRecording(recordConfig);
+    } else if (recordConfig.every != 1 || recordConfig.fps != 60) {
+        std::cerr << "--record-every and --record-fps require --record" << std::endl;
+        return 1;
+    }
+    
+    if (hasScene) {
+        SceneGenerator::Config sceneConfig;
+        std::string error;
+        if (!SceneGenerator::parseSpec(sceneSpec, sceneConfig, error)) {
+            std::cerr << error << std::endl;
+            return 1;
+        }
+        app.setScene(sceneConfig);
+    }
+    
+    // Archives are mapped before any loading phase reads from them (later ones take precedence).
+    // Hot reload edits loose files, which the default archive would hide.
+    if (hotReload) {
+        app.setHotReload(true);
+        if (!archives.empty()) {
+            std::cerr << "Warning: assets in the --pak archives are not hot reloaded" << std::endl;
+        }
+    } else if (archives.empty() && VulkanUtils::fileExists(AssetFileSystem::DEFAULT_ARCHIVE)) {
+        archives.push_back(AssetFileSystem::DEFAULT_ARCHIVE);
+    }
+    for (const std::string& archive : archives) {
+        try {
+            AssetFileSystem::getInstance().mount(archive);
+        } catch (const std::exception& e) {
+            std::cerr << e.what() << std::endl;
+            return 1;
+        }
+    }
     
     try {
         // Initialize the application
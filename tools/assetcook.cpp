@@ -0,0 +1,299 @@
+/**
+ * assetcook - converts source assets into the runtime formats the engine
+ * loads, so shipping builds never parse OBJ text on the player's machine.
+ *
+ * Usage:
+ *   assetcook [--out <dir>] [--pak <file>] [--force] [--lods <count>] <file or directory> [more...]
+ *
+ * Every OBJ file found is parsed, deduplicated, given normals and tangents,
+ * optimized for the vertex cache and fetch order, simplified into LODs and
+ * split into meshlets (MeshAsset::cook), then written as a MeshAsset to
+ * <out>/<path>.vgemesh; the default output directory "." puts each cooked
+ * mesh next to its source, where the engine looks for it. Files are cooked
+ * in parallel on the shared thread pool.
+ *
+ * Rebuilds are incremental: <out>/.assetcook records a hash of each
+ * source's contents, the cooker version and the options, and files whose
+ * hash is unchanged (and whose output still exists) are skipped. --force
+ * cooks everything.
+ *
+ * --pak also writes an archive (see AssetArchive.h) holding the cooked
+ * meshes and every other input file, without the OBJ sources:
+ *   assetcook --pak data.pak assets shaders
+ */
+
+#include "AssetArchive.h"
+#include "MeshAsset.h"
+#include "ObjLoader.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace VulkanGameEngine;
+
+namespace {
+
+constexpr const char* CACHE_FILE = ".assetcook";
+
+struct CookJob {
+    enum class Status { FAILED, COOKED, UP_TO_DATE };
+
+    std::string sourcePath;                 // As the engine requests it
+    std::string cookedPath;
+    uint64_t key = 0;                       // Contents, cooker version and options
+    Status status = Status::FAILED;
+    std::string message;                    // Summary or error
+};
+
+bool readFile(const std::filesystem::path& path, std::vector<char>& data) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        return false;
+    }
+    data.resize(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    file.read(data.data(), static_cast<std::streamsize>(data.size()));
+    return static_cast<bool>(file);
+}
+
+bool isObj(const std::filesystem::path& path) {
+    std::string extension = path.extension().string();
+    std::transform(extension.begin(), extension.end(), extension.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return extension == ".obj";
+}
+
+/**
+ * Collects the regular files under the inputs, sorted, as normalized relative paths
+ */
+bool collectFiles(const std::vector<std::string>& inputs, std::vector<std::string>& files) {
+    for (const std::string& input : inputs) {
+        std::error_code error;
+        if (std::filesystem::is_directory(input, error)) {
+            for (const auto& item : std::filesystem::recursive_directory_iterator(input, error)) {
+                if (item.is_regular_file()) {
+                    files.push_back(item.path().lexically_normal().generic_string());
+                }
+            }
+        } else if (std::filesystem::is_regular_file(input, error)) {
+            files.push_back(std::filesystem::path(input).lexically_normal().generic_string());
+        } else {
+            std::cerr << "Cannot read " << input << std::endl;
+            return false;
+        }
+        if (error) {
+            std::cerr << "Cannot read " << input << ": " << error.message() << std::endl;
+            return false;
+        }
+    }
+    std::sort(files.begin(), files.end());
+    files.erase(std::unique(files.begin(), files.end()), files.end());
+    return true;
+}
+
+std::map<std::string, uint64_t> loadCache(const std::filesystem::path& path) {
+    std::map<std::string, uint64_t> cache;
+    std::ifstream file(path);
+    std::string line;
+    while (std::getline(file, line)) {
+        std::istringstream stream(line);
+        std::string key;
+        std::string source;
+        if (stream >> key && std::getline(stream >> std::ws, source)) {
+            cache[source] = std::strtoull(key.c_str(), nullptr, 16);
+        }
+    }
+    return cache;
+}
+
+void saveCache(const std::filesystem::path& path, const std::vector<CookJob>& jobs) {
+    std::ofstream file(path, std::ios::trunc);
+    for (const CookJob& job : jobs) {
+        if (job.status != CookJob::Status::FAILED) {
+            char key[17];
+            std::snprintf(key, sizeof(key), "%016llx", static_cast<unsigned long long>(job.key));
+            file << key << ' ' << job.sourcePath << '\n';
+        }
+    }
+}
+
+void cookMesh(CookJob& job, const std::filesystem::path& outputDirectory, const MeshAsset::CookOptions& options,
+              uint64_t settingsHash, const std::map<std::string, uint64_t>& cache, bool force) {
+    const auto start = std::chrono::steady_clock::now();
+
+    std::vector<char> source;
+    if (!readFile(job.sourcePath, source)) {
+        job.message = "cannot read the source";
+        return;
+    }
+    const uint64_t sourceHash = AssetArchive::hashBytes(source.data(), source.size());
+    job.key = AssetArchive::hashBytes(source.data(), source.size(), settingsHash);
+
+    const std::filesystem::path output = outputDirectory / job.cookedPath;
+    const auto cached = cache.find(job.sourcePath);
+    if (!force && cached != cache.end() && cached->second == job.key && std::filesystem::exists(output)) {
+        job.status = CookJob::Status::UP_TO_DATE;
+        job.message = "up to date";
+        return;
+    }
+
+    ObjLoader::OBJData objData;
+    if (!ObjLoader::parseOBJBuffer(source, objData)) {
+        job.message = "not a valid OBJ file";
+        return;
+    }
+    const MeshAsset asset = MeshAsset::cook(objData, sourceHash, options);
+
+    std::error_code error;
+    std::filesystem::create_directories(output.parent_path(), error);
+    if (!asset.save(output.string())) {
+        job.message = "cannot write " + output.generic_string();
+        return;
+    }
+
+    const double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    char summary[160];
+    std::snprintf(summary, sizeof(summary), "%zu vertices, %zu triangles, %zu LODs, %zu meshlets in %.1f ms",
+                  asset.vertices.size(), static_cast<size_t>(asset.lods[0].indexCount / 3), asset.lods.size(),
+                  asset.meshlets.meshlets.size(), milliseconds);
+    job.status = CookJob::Status::COOKED;
+    job.message = summary;
+}
+
+void printUsage() {
+    std::cerr << "Usage: assetcook [--out <dir>] [--pak <file>] [--force] [--lods <count>] <file or directory> [more...]"
+              << std::endl;
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[]) {
+    std::filesystem::path outputDirectory = ".";
+    std::string pakPath;
+    bool force = false;
+    MeshAsset::CookOptions options;
+    std::vector<std::string> inputs;
+    for (int i = 1; i < argc; ++i) {
+        const std::string argument = argv[i];
+        if (argument == "--out" && i + 1 < argc) {
+            outputDirectory = argv[++i];
+        } else if (argument == "--pak" && i + 1 < argc) {
+            pakPath = argv[++i];
+        } else if (argument == "--force") {
+            force = true;
+        } else if (argument == "--lods" && i + 1 < argc) {
+            options.maxLods = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else {
+            inputs.push_back(argument);
+        }
+    }
+    if (inputs.empty() || options.maxLods == 0) {
+        printUsage();
+        return 1;
+    }
+
+    try {
+        std::vector<std::string> files;
+        if (!collectFiles(inputs, files)) {
+            return 1;
+        }
+
+        std::vector<CookJob> jobs;
+        std::vector<std::string> otherFiles;
+        for (const std::string& file : files) {
+            const std::string extension = std::filesystem::path(file).extension().string();
+            if (isObj(file)) {
+                CookJob job;
+                job.sourcePath = file;
+                job.cookedPath = MeshAsset::getCookedPath(file);
+                jobs.push_back(job);
+            } else if (extension != MeshAsset::EXTENSION && std::filesystem::path(file).filename() != CACHE_FILE) {
+                // Earlier outputs cooked in place are not inputs
+                otherFiles.push_back(file);
+            }
+        }
+
+        // Anything that changes the output invalidates the cache
+        const uint32_t settings[] = {MeshAsset::VERSION, options.maxLods, options.minLodTriangles,
+                                     options.maxMeshletVertices, options.maxMeshletTriangles};
+        uint64_t settingsHash = AssetArchive::hashBytes(settings, sizeof(settings));
+        settingsHash = AssetArchive::hashBytes(&options.lodReduction, sizeof(options.lodReduction), settingsHash);
+
+        const std::filesystem::path cachePath = outputDirectory / CACHE_FILE;
+        const std::map<std::string, uint64_t> cache = loadCache(cachePath);
+
+        // One file per task; the passes inside a file run on the same pool
+        ThreadPool& pool = ThreadPool::getInstance();
+        const auto start = std::chrono::steady_clock::now();
+        pool.parallelFor(jobs.size(), 1, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                try {
+                    cookMesh(jobs[i], outputDirectory, options, settingsHash, cache, force);
+                } catch (const std::exception& e) {
+                    jobs[i].message = e.what();
+                }
+            }
+        });
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        size_t cooked = 0;
+        size_t failed = 0;
+        for (const CookJob& job : jobs) {
+            std::printf("%-11s %s: %s\n",
+                        job.status == CookJob::Status::COOKED       ? "cooked"
+                        : job.status == CookJob::Status::UP_TO_DATE ? "skipped"
+                                                                    : "FAILED",
+                        job.sourcePath.c_str(), job.message.c_str());
+            cooked += job.status == CookJob::Status::COOKED;
+            failed += job.status == CookJob::Status::FAILED;
+        }
+        std::printf("%zu meshes: %zu cooked, %zu up to date, %zu failed (%.2f s, %u workers)\n", jobs.size(), cooked,
+                    jobs.size() - cooked - failed, failed, seconds, pool.getThreadCount());
+
+        std::error_code error;
+        std::filesystem::create_directories(outputDirectory, error);
+        saveCache(cachePath, jobs);
+        if (failed > 0) {
+            return 1;
+        }
+
+        if (!pakPath.empty()) {
+            AssetArchiveWriter writer;
+            std::vector<char> data;
+            for (const CookJob& job : jobs) {
+                if (!readFile(outputDirectory / job.cookedPath, data)) {
+                    std::cerr << "Cannot read " << job.cookedPath << std::endl;
+                    return 1;
+                }
+                writer.add(job.cookedPath, std::move(data));
+            }
+            for (const std::string& file : otherFiles) {
+                if (!readFile(file, data)) {
+                    std::cerr << "Cannot read " << file << std::endl;
+                    return 1;
+                }
+                writer.add(file, std::move(data));
+            }
+            writer.write(pakPath, pool);
+
+            const AssetArchiveWriter::Stats& stats = writer.getStats();
+            std::printf("%s: %u assets, %llu -> %llu bytes\n", pakPath.c_str(), stats.entries,
+                        static_cast<unsigned long long>(stats.inputBytes),
+                        static_cast<unsigned long long>(stats.archiveBytes));
+        }
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+}
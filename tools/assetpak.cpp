@@ -0,0 +1,136 @@
+/**
+ * assetpak - packs loose asset files into a pak archive read by the engine
+ * (see AssetArchive.h), and lists the contents of existing archives.
+ *
+ * Usage:
+ *   assetpak [--chunk-size <bytes>] <output.pak> <file or directory> [more...]
+ *   assetpak --list <archive.pak>
+ *
+ * Directories are packed recursively. Assets are stored under the paths
+ * given (relative to the current directory), which must match the paths
+ * the engine requests, so run it from the directory the game runs in:
+ *   assetpak data.pak assets shaders
+ */
+
+#include "AssetArchive.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace VulkanGameEngine;
+
+namespace {
+
+bool readFile(const std::filesystem::path& path, std::vector<char>& data) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        return false;
+    }
+    data.resize(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    file.read(data.data(), static_cast<std::streamsize>(data.size()));
+    return static_cast<bool>(file);
+}
+
+bool addPath(AssetArchiveWriter& writer, const std::filesystem::path& path) {
+    std::error_code error;
+    if (std::filesystem::is_directory(path, error)) {
+        // Sorted so the same inputs always give the same archive
+        std::vector<std::filesystem::path> files;
+        for (const auto& item : std::filesystem::recursive_directory_iterator(path, error)) {
+            if (item.is_regular_file()) {
+                files.push_back(item.path());
+            }
+        }
+        std::sort(files.begin(), files.end());
+        for (const auto& file : files) {
+            if (!addPath(writer, file)) {
+                return false;
+            }
+        }
+        return !error;
+    }
+
+    std::vector<char> data;
+    if (!readFile(path, data)) {
+        std::cerr << "Cannot read " << path.generic_string() << std::endl;
+        return false;
+    }
+    writer.add(path.lexically_normal().generic_string(), std::move(data));
+    return true;
+}
+
+int listArchive(const std::string& path) {
+    AssetArchive archive;
+    archive.open(path);
+    const AssetArchive::Entry* entries = archive.getEntries();
+    for (uint32_t i = 0; i < archive.getEntryCount(); ++i) {
+        const AssetArchive::Entry& entry = entries[i];
+        std::printf("%12llu %12llu %6u  %s\n", static_cast<unsigned long long>(entry.size),
+                    static_cast<unsigned long long>(archive.getStoredSize(entry)), entry.chunkCount,
+                    archive.getEntryPath(entry).c_str());
+    }
+    std::printf("%u assets, chunk size %u\n", archive.getEntryCount(), archive.getHeader().chunkSize);
+    return 0;
+}
+
+void printUsage() {
+    std::cerr << "Usage: assetpak [--chunk-size <bytes>] <output.pak> <file or directory> [more...]\n"
+              << "       assetpak --list <archive.pak>" << std::endl;
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[]) {
+    uint32_t chunkSize = AssetArchive::DEFAULT_CHUNK_SIZE;
+    std::vector<std::string> positional;
+    bool list = false;
+    for (int i = 1; i < argc; ++i) {
+        const std::string argument = argv[i];
+        if (argument == "--list") {
+            list = true;
+        } else if (argument == "--chunk-size" && i + 1 < argc) {
+            chunkSize = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else {
+            positional.push_back(argument);
+        }
+    }
+
+    try {
+        if (list) {
+            if (positional.size() != 1) {
+                printUsage();
+                return 1;
+            }
+            return listArchive(positional[0]);
+        }
+
+        if (positional.size() < 2 || chunkSize == 0) {
+            printUsage();
+            return 1;
+        }
+
+        AssetArchiveWriter writer;
+        for (size_t i = 1; i < positional.size(); ++i) {
+            if (!addPath(writer, positional[i])) {
+                return 1;
+            }
+        }
+        writer.write(positional[0], ThreadPool::getInstance(), chunkSize);
+
+        const AssetArchiveWriter::Stats& stats = writer.getStats();
+        std::printf("%s: %u assets, %llu -> %llu bytes (%u of %u chunks compressed)\n", positional[0].c_str(),
+                    stats.entries, static_cast<unsigned long long>(stats.inputBytes),
+                    static_cast<unsigned long long>(stats.archiveBytes), stats.compressedChunks, stats.chunks);
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,323 @@
+/**
+ * framereplay - re-executes a frame captured with `game --capture` and
+ * reports how long it takes, without the game, its assets or its scene
+ * update in the way.
+ *
+ * Usage:
+ *   framereplay [options] <capture.vgecap>
+ *
+ *   --frames N         Frames to replay (default 500)
+ *   --warmup N         Frames replayed before timing starts (default 50)
+ *   --backend NAME     vulkan (default) or null
+ *   --json PATH        Write the results as JSON
+ *   --save-frame PATH  Write the last replayed image as a PPM (vulkan only)
+ *
+ * The capture's pipelines and buffers are recreated on a headless backend at
+ * the captured size, and its command list is remapped onto them. Every
+ * replayed frame then submits exactly the same work, so differences between
+ * two replays (driver versions, GPUs, shader changes rebuilt into a capture)
+ * are not hidden by scene or camera variation.
+ */
+
+#include "FrameCapture.h"
+#include "VulkanOffscreenTarget.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace VulkanGameEngine;
+
+namespace {
+
+struct Options {
+    std::string capturePath;
+    uint64_t frames = 500;
+    uint64_t warmup = 50;
+    BackendType backend = BackendType::VULKAN;
+    std::string jsonPath;
+    std::string framePath;
+};
+
+struct Summary {
+    double median = 0.0;
+    double p95 = 0.0;
+    double max = 0.0;
+    size_t count = 0;
+};
+
+Summary summarize(std::vector<double> samples) {
+    Summary summary;
+    summary.count = samples.size();
+    if (samples.empty()) {
+        return summary;
+    }
+    std::sort(samples.begin(), samples.end());
+    summary.median = samples[samples.size() / 2];
+    summary.p95 = samples[std::min(samples.size() - 1, samples.size() * 95 / 100)];
+    summary.max = samples.back();
+    return summary;
+}
+
+/**
+ * The capture's resources recreated on the replay backend. Uniform buffers get
+ * one copy per frame slot, so no frame rewrites a buffer the GPU may still read.
+ */
+struct ReplayResources {
+    std::unordered_map<PipelineHandle, PipelineHandle> pipelines;
+    std::unordered_map<BufferHandle, BufferHandle> buffers[MAX_FRAMES_IN_FLIGHT];
+    std::vector<BufferHandle> created;
+    std::vector<PipelineHandle> createdPipelines;
+    CommandList commands[MAX_FRAMES_IN_FLIGHT];
+};
+
+void createResources(const FrameCapture& capture, RenderBackend& backend, ReplayResources& resources) {
+    for (const FrameCapture::Pipeline& pipeline : capture.pipelines) {
+        const PipelineHandle handle = backend.createPipeline(pipeline.desc);
+        resources.pipelines[pipeline.handle] = handle;
+        resources.createdPipelines.push_back(handle);
+    }
+
+    for (const FrameCapture::Buffer& buffer : capture.buffers) {
+        for (uint32_t slot = 0; slot < MAX_FRAMES_IN_FLIGHT; ++slot) {
+            if (slot > 0 && buffer.type != BufferType::UNIFORM) {
+                resources.buffers[slot][buffer.handle] = resources.buffers[0][buffer.handle];
+                continue;
+            }
+            const BufferHandle handle = backend.createBuffer(buffer.type, buffer.contents.data(), buffer.contents.size());
+            resources.buffers[slot][buffer.handle] = handle;
+            resources.created.push_back(handle);
+        }
+    }
+}
+
+uint32_t remap(const std::unordered_map<uint32_t, uint32_t>& handles, uint32_t handle) {
+    auto it = handles.find(handle);
+    if (it == handles.end()) {
+        throw std::runtime_error("Capture references resource " + std::to_string(handle) + " it does not contain");
+    }
+    return it->second;
+}
+
+void remapCommands(const FrameCapture& capture, ReplayResources& resources) {
+    for (uint32_t slot = 0; slot < MAX_FRAMES_IN_FLIGHT; ++slot) {
+        CommandList& commands = resources.commands[slot];
+        const auto& buffers = resources.buffers[slot];
+        commands.reserve(capture.commands.size(), capture.commands.size());
+        for (const Command& command : capture.commands.getCommands()) {
+            switch (command.type) {
+                case CommandType::BEGIN_PASS:
+                    commands.beginPass(command.clearColor[0], command.clearColor[1],
+                                       command.clearColor[2], command.clearColor[3]);
+                    break;
+                case CommandType::END_PASS:
+                    commands.endPass();
+                    break;
+                case CommandType::BIND_PIPELINE:
+                    commands.bindPipeline(remap(resources.pipelines, command.handle));
+                    break;
+                case CommandType::SET_FULL_VIEWPORT:
+                    commands.setFullViewport();
+                    break;
+                case CommandType::BIND_VERTEX_BUFFER:
+                    commands.bindVertexBuffer(remap(buffers, command.handle));
+                    break;
+                case CommandType::BIND_INDEX_BUFFER:
+                    commands.bindIndexBuffer(remap(buffers, command.handle));
+                    break;
+                case CommandType::BIND_UNIFORMS:
+                    commands.bindUniforms(remap(buffers, command.handle));
+                    break;
+                case CommandType::PUSH_OBJECT_CONSTANTS:
+                    commands.pushObjectConstants(capture.commands.getObjectConstants(command.handle));
+                    break;
+                case CommandType::DRAW_INDEXED:
+                    commands.drawIndexed(command.indexCount, command.firstIndex, command.vertexOffset);
+                    break;
+                case CommandType::BEGIN_ZONE:
+                    commands.beginZone(command.name);   // Owned by the capture, which outlives the replay
+                    break;
+                case CommandType::END_ZONE:
+                    commands.endZone();
+                    break;
+            }
+        }
+    }
+}
+
+void writeJson(const Options& options, const FrameCapture& capture, const char* backendName,
+               const Summary& cpu, const Summary& gpu, size_t draws) {
+    std::ofstream file(options.jsonPath);
+    if (!file.is_open()) {
+        std::cerr << "Cannot write " << options.jsonPath << std::endl;
+        return;
+    }
+    char buffer[256];
+    file << "{\n";
+    file << "  \"capture\": \"" << options.capturePath << "\",\n";
+    file << "  \"capturedOn\": \"" << capture.backend << "\",\n";
+    file << "  \"backend\": \"" << backendName << "\",\n";
+    file << "  \"width\": " << capture.width << ",\n";
+    file << "  \"height\": " << capture.height << ",\n";
+    file << "  \"commands\": " << capture.commands.size() << ",\n";
+    file << "  \"draws\": " << draws << ",\n";
+    file << "  \"frames\": " << cpu.count << ",\n";
+    std::snprintf(buffer, sizeof(buffer), "  \"cpuMs\": {\"median\": %.4f, \"p95\": %.4f, \"max\": %.4f},\n",
+                  cpu.median, cpu.p95, cpu.max);
+    file << buffer;
+    if (gpu.count > 0) {
+        std::snprintf(buffer, sizeof(buffer), "  \"gpuMs\": {\"median\": %.4f, \"p95\": %.4f, \"max\": %.4f, \"frames\": %zu}\n",
+                      gpu.median, gpu.p95, gpu.max, gpu.count);
+        file << buffer;
+    } else {
+        file << "  \"gpuMs\": null\n";
+    }
+    file << "}\n";
+}
+
+bool parseArguments(int argc, char* argv[], Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string argument = argv[i];
+        if (argument == "--frames" && i + 1 < argc) {
+            options.frames = std::strtoull(argv[++i], nullptr, 10);
+        } else if (argument == "--warmup" && i + 1 < argc) {
+            options.warmup = std::strtoull(argv[++i], nullptr, 10);
+        } else if (argument == "--backend" && i + 1 < argc) {
+            if (!parseBackendType(argv[++i], options.backend)) {
+                std::cerr << "Unknown backend: " << argv[i] << " (expected vulkan or null)" << std::endl;
+                return false;
+            }
+        } else if (argument == "--json" && i + 1 < argc) {
+            options.jsonPath = argv[++i];
+        } else if (argument == "--save-frame" && i + 1 < argc) {
+            options.framePath = argv[++i];
+        } else if (!argument.empty() && argument[0] != '-' && options.capturePath.empty()) {
+            options.capturePath = argument;
+        } else {
+            std::cerr << "Unknown argument: " << argument << std::endl;
+            return false;
+        }
+    }
+    if (options.capturePath.empty() || options.frames == 0) {
+        std::cerr << "Usage: framereplay [--frames N] [--warmup N] [--backend vulkan|null] "
+                     "[--json out.json] [--save-frame out.ppm] <capture.vgecap>" << std::endl;
+        return false;
+    }
+    if (options.backend == BackendType::NULL_BACKEND && !options.framePath.empty()) {
+        std::cerr << "--save-frame needs the vulkan backend; the null backend produces no images" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseArguments(argc, argv, options)) {
+        return 1;
+    }
+
+    FrameCapture capture;
+    std::string error;
+    if (!FrameCapture::load(options.capturePath, capture, error)) {
+        std::cerr << error << std::endl;
+        return 1;
+    }
+
+    size_t draws = 0;
+    for (const Command& command : capture.commands.getCommands()) {
+        draws += command.type == CommandType::DRAW_INDEXED ? 1 : 0;
+    }
+    std::cout << "Capture " << options.capturePath << ": frame " << capture.frameIndex << " on " << capture.backend
+              << ", " << capture.width << "x" << capture.height << ", " << capture.commands.size() << " commands ("
+              << draws << " draws), " << capture.pipelines.size() << " pipelines, " << capture.buffers.size()
+              << " buffers" << std::endl;
+
+    std::unique_ptr<RenderBackend> backend = createRenderBackend(options.backend);
+    ReplayResources resources;
+    try {
+        BackendConfig config;
+        config.width = capture.width;
+        config.height = capture.height;
+        backend->initialize(config);
+        createResources(capture, *backend, resources);
+        remapCommands(capture, resources);
+    } catch (const std::exception& e) {
+        std::cerr << "Replay setup failed: " << e.what() << std::endl;
+        return 1;
+    }
+
+    std::vector<double> cpuSamples;
+    std::vector<double> gpuSamples;
+    cpuSamples.reserve(options.frames);
+    gpuSamples.reserve(options.frames);
+    uint64_t lastGpuFrame = UINT64_MAX;
+    int exitCode = 0;
+
+    try {
+        const uint64_t totalFrames = options.warmup + options.frames;
+        for (uint64_t frame = 0; frame < totalFrames; ++frame) {
+            const uint32_t slot = static_cast<uint32_t>(frame % MAX_FRAMES_IN_FLIGHT);
+            const auto start = std::chrono::steady_clock::now();
+            if (backend->beginFrame(slot) == FrameStatus::SKIPPED) {
+                continue;
+            }
+            backend->recordFrame(resources.commands[slot]);
+            backend->submitFrame();
+            backend->presentFrame();
+            const auto end = std::chrono::steady_clock::now();
+
+            if (frame < options.warmup) {
+                continue;
+            }
+            cpuSamples.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+            const GpuProfiler::FrameResults& gpuResults = backend->getGpuResults();
+            if (gpuResults.valid && gpuResults.frame != lastGpuFrame) {
+                gpuSamples.push_back(gpuResults.gpuTimeMs);
+                lastGpuFrame = gpuResults.frame;
+            }
+        }
+        backend->waitIdle();
+
+        if (!options.framePath.empty()) {
+            std::vector<uint8_t> pixels;
+            uint32_t width = 0;
+            uint32_t height = 0;
+            backend->readbackFrame(pixels, width, height);
+            VulkanOffscreenTarget::writePPM(options.framePath, width, height, pixels);
+            std::cout << "Saved last frame to " << options.framePath << std::endl;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Replay failed: " << e.what() << std::endl;
+        exitCode = 1;
+    }
+
+    const Summary cpu = summarize(cpuSamples);
+    const Summary gpu = summarize(gpuSamples);
+    std::printf("Replayed %zu frames on %s\n", cpu.count, backend->getName());
+    std::printf("  CPU (begin to present): median %.3f ms, p95 %.3f ms, max %.3f ms\n", cpu.median, cpu.p95, cpu.max);
+    if (gpu.count > 0) {
+        std::printf("  GPU:                    median %.3f ms, p95 %.3f ms, max %.3f ms\n", gpu.median, gpu.p95, gpu.max);
+    } else {
+        std::printf("  GPU: no timings (null backend or no timestamp support)\n");
+    }
+    if (!options.jsonPath.empty()) {
+        writeJson(options, capture, backend->getName(), cpu, gpu, draws);
+    }
+
+    backend->waitIdle();
+    for (BufferHandle buffer : resources.created) {
+        backend->destroyBuffer(buffer);
+    }
+    for (PipelineHandle pipeline : resources.createdPipelines) {
+        backend->destroyPipeline(pipeline);
+    }
+    backend->cleanup();
+    return exitCode;
+}
@@ -0,0 +1,404 @@
+/**
+ * logdecode - converts binary log files (*.blog) written by BinaryLogSink
+ * back into readable text or JSON.
+ *
+ * Usage:
+ *   logdecode [--json] <file.blog> [more files...]
+ *
+ * Text output matches the console format of the text logger:
+ *   [HH:MM:SS.mmm] [LEVEL][Category] message   (with the thread ID after the level)
+ *
+ * JSON output is a single array with one object per message, including the
+ * absolute timestamp in nanoseconds, the original format string and the raw
+ * argument values.
+ */
+
+#include "BinaryLogFormat.h"
+#include "Logger.h"
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace VulkanGameEngine;
+
+namespace {
+
+/**
+ * One argument read back from a MESSAGE record
+ */
+struct DecodedArgument {
+    BinaryLogFormat::ArgumentType type;
+    int64_t signedValue = 0;
+    uint64_t unsignedValue = 0;
+    double floatValue = 0.0;
+    std::string text;
+};
+
+const char* levelName(uint8_t level) {
+    static const char* names[] = {"TRACE", "DEBUG", "INFO ", "WARN ", "ERROR", "FATAL"};
+    return level < 6 ? names[level] : "?????";
+}
+
+const char* levelNameTrimmed(uint8_t level) {
+    static const char* names[] = {"TRACE", "DEBUG", "INFO", "WARN", "ERROR", "FATAL"};
+    return level < 6 ? names[level] : "UNKNOWN";
+}
+
+bool readFile(const std::string& path, std::vector<uint8_t>& data) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        return false;
+    }
+    data.resize(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    file.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size()));
+    return static_cast<bool>(file);
+}
+
+bool decodeArguments(const uint8_t* data, size_t size, std::vector<DecodedArgument>& arguments) {
+    arguments.clear();
+    size_t offset = 0;
+
+    while (offset < size) {
+        DecodedArgument argument;
+        argument.type = static_cast<BinaryLogFormat::ArgumentType>(data[offset++]);
+
+        switch (argument.type) {
+            case BinaryLogFormat::ARG_INT64:
+                if (offset + 8 > size) return false;
+                std::memcpy(&argument.signedValue, data + offset, 8);
+                offset += 8;
+                break;
+            case BinaryLogFormat::ARG_UINT64:
+            case BinaryLogFormat::ARG_POINTER:
+                if (offset + 8 > size) return false;
+                std::memcpy(&argument.unsignedValue, data + offset, 8);
+                offset += 8;
+                break;
+            case BinaryLogFormat::ARG_DOUBLE:
+                if (offset + 8 > size) return false;
+                std::memcpy(&argument.floatValue, data + offset, 8);
+                offset += 8;
+                break;
+            case BinaryLogFormat::ARG_BOOL:
+            case BinaryLogFormat::ARG_CHAR:
+                if (offset + 1 > size) return false;
+                argument.signedValue = static_cast<int8_t>(data[offset]);
+                offset += 1;
+                break;
+            case BinaryLogFormat::ARG_STRING: {
+                uint32_t length;
+                if (offset + 4 > size) return false;
+                std::memcpy(&length, data + offset, 4);
+                offset += 4;
+                if (offset + length > size) return false;
+                argument.text.assign(reinterpret_cast<const char*>(data + offset), length);
+                offset += length;
+                break;
+            }
+            default:
+                return false;
+        }
+
+        arguments.push_back(std::move(argument));
+    }
+
+    return true;
+}
+
+void appendDecoded(std::string& out, const DecodedArgument& argument, const char* spec) {
+    switch (argument.type) {
+        case BinaryLogFormat::ARG_INT64:   LogFormat::appendArgument(out, argument.signedValue, spec); break;
+        case BinaryLogFormat::ARG_UINT64:  LogFormat::appendArgument(out, argument.unsignedValue, spec); break;
+        case BinaryLogFormat::ARG_DOUBLE:  LogFormat::appendArgument(out, argument.floatValue, spec); break;
+        case BinaryLogFormat::ARG_BOOL:    LogFormat::appendArgument(out, argument.signedValue != 0, spec); break;
+        case BinaryLogFormat::ARG_CHAR:    LogFormat::appendArgument(out, static_cast<char>(argument.signedValue), spec); break;
+        case BinaryLogFormat::ARG_STRING:  out += argument.text; break;
+        case BinaryLogFormat::ARG_POINTER: {
+            char buffer[32];
+            std::snprintf(buffer, sizeof(buffer), "0x%llx", static_cast<unsigned long long>(argument.unsignedValue));
+            out += buffer;
+            break;
+        }
+    }
+}
+
+/**
+ * Substitutes arguments (after the category) into the format string
+ */
+std::string formatMessage(const std::string& format, const std::vector<DecodedArgument>& arguments) {
+    std::string out;
+    char spec[16];
+    const char* cursor = format.c_str();
+
+    for (size_t i = 1; i < arguments.size() && cursor; ++i) {
+        cursor = LogFormat::copyUntilPlaceholder(out, cursor, spec);
+        if (cursor) {
+            appendDecoded(out, arguments[i], spec);
+        }
+    }
+    while (cursor) {
+        cursor = LogFormat::copyUntilPlaceholder(out, cursor, spec);
+    }
+    return out;
+}
+
+std::string escapeJson(const std::string& text) {
+    std::string out;
+    out.reserve(text.size() + 8);
+    for (char c : text) {
+        switch (c) {
+            case '"':  out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char buffer[8];
+                    std::snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+                    out += buffer;
+                } else {
+                    out += c;
+                }
+        }
+    }
+    return out;
+}
+
+std::string jsonArgument(const DecodedArgument& argument) {
+    std::string out;
+    switch (argument.type) {
+        case BinaryLogFormat::ARG_STRING: return "\"" + escapeJson(argument.text) + "\"";
+        case BinaryLogFormat::ARG_CHAR:   return "\"" + escapeJson(std::string(1, static_cast<char>(argument.signedValue))) + "\"";
+        case BinaryLogFormat::ARG_BOOL:   return argument.signedValue ? "true" : "false";
+        case BinaryLogFormat::ARG_POINTER:
+        case BinaryLogFormat::ARG_UINT64: LogFormat::appendArgument(out, argument.unsignedValue, nullptr); return out;
+        case BinaryLogFormat::ARG_INT64:  LogFormat::appendArgument(out, argument.signedValue, nullptr); return out;
+        case BinaryLogFormat::ARG_DOUBLE: {
+            char buffer[64];
+            std::snprintf(buffer, sizeof(buffer), "%.17g", argument.floatValue);
+            return buffer;
+        }
+    }
+    return "null";
+}
+
+std::string formatTime(int64_t systemTimeNs) {
+    std::time_t seconds = static_cast<std::time_t>(systemTimeNs / 1000000000);
+    int milliseconds = static_cast<int>((systemTimeNs / 1000000) % 1000);
+    std::tm localTime{};
+#ifdef _WIN32
+    localtime_s(&localTime, &seconds);
+#else
+    localtime_r(&seconds, &localTime);
+#endif
+    char prefix[16];
+    char buffer[32];
+    std::strftime(prefix, sizeof(prefix), "%H:%M:%S", &localTime);
+    std::snprintf(buffer, sizeof(buffer), "%s.%03d", prefix, milliseconds);
+    return buffer;
+}
+
+/**
+ * Checks that the record at offset is committed, lies inside the file and
+ * is large enough for its own header and payload
+ */
+bool isValidRecord(const std::vector<uint8_t>& data, size_t offset) {
+    BinaryLogFormat::RecordHeader record;
+    std::memcpy(&record, data.data() + offset, sizeof(record));
+    if (record.size < sizeof(record) || record.size % BinaryLogFormat::RECORD_ALIGNMENT != 0 ||
+        record.size > data.size() - offset) {
+        return false;
+    }
+
+    if (record.type == BinaryLogFormat::RECORD_FORMAT_DEFINITION) {
+        BinaryLogFormat::FormatDefinitionRecord definition;
+        if (record.size < sizeof(definition)) {
+            return false;
+        }
+        std::memcpy(&definition, data.data() + offset, sizeof(definition));
+        return definition.formatLength <= record.size - sizeof(definition);
+    }
+    if (record.type == BinaryLogFormat::RECORD_MESSAGE) {
+        BinaryLogFormat::MessageRecord message;
+        if (record.size < sizeof(message)) {
+            return false;
+        }
+        std::memcpy(&message, data.data() + offset, sizeof(message));
+        return message.argumentBytes <= record.size - sizeof(message);
+    }
+    return true; // Unknown record types are skipped by their size
+}
+
+/**
+ * Finds the first valid record at or after offset (in record alignment steps)
+ *
+ * @return Offset of the record, or data.size() if there is none
+ */
+size_t findNextRecord(const std::vector<uint8_t>& data, size_t offset) {
+    for (; offset + sizeof(BinaryLogFormat::RecordHeader) <= data.size(); offset += BinaryLogFormat::RECORD_ALIGNMENT) {
+        uint32_t size;
+        std::memcpy(&size, data.data() + offset, sizeof(size));
+        if (size != 0 && isValidRecord(data, offset)) {
+            return offset;
+        }
+    }
+    return data.size();
+}
+
+/**
+ * Decodes one file and writes its messages to stdout
+ *
+ * @return Number of messages decoded, or -1 if the file is not a binary log
+ */
+long decodeFile(const std::string& path, bool json, bool& firstJsonEntry) {
+    std::vector<uint8_t> data;
+    if (!readFile(path, data) || data.size() < sizeof(BinaryLogFormat::FileHeader)) {
+        std::cerr << "logdecode: cannot read " << path << std::endl;
+        return -1;
+    }
+
+    BinaryLogFormat::FileHeader header;
+    std::memcpy(&header, data.data(), sizeof(header));
+    if (!BinaryLogFormat::isValidHeader(header)) {
+        std::cerr << "logdecode: " << path << " is not a binary log file" << std::endl;
+        return -1;
+    }
+
+    // First pass: collect the valid records. Format definitions may appear
+    // after the messages that use them when a rotation raced with a new
+    // format being registered.
+    std::unordered_map<uint32_t, std::string> formats;
+    formats[BinaryLogFormat::TEXT_MESSAGE_FORMAT_ID] = "{}";
+    std::vector<size_t> records;
+
+    size_t offset = header.headerSize;
+    while (offset + sizeof(BinaryLogFormat::RecordHeader) <= data.size()) {
+        BinaryLogFormat::RecordHeader record;
+        std::memcpy(&record, data.data() + offset, sizeof(record));
+
+        if (record.size == 0 || !isValidRecord(data, offset)) {
+            // A zero size is the end of data unless a later record was
+            // committed: then a writer stopped (crashed) between reserving and
+            // committing, and decoding resumes at the next valid record
+            const size_t next = findNextRecord(data, offset + BinaryLogFormat::RECORD_ALIGNMENT);
+            if (record.size == 0 && next == data.size()) {
+                break;
+            }
+            std::cerr << "logdecode: " << (record.size == 0 ? "uncommitted" : "corrupt") << " record at offset "
+                      << offset << " in " << path << ", skipped " << (next - offset) << " bytes" << std::endl;
+            offset = next;
+            continue;
+        }
+
+        if (record.type == BinaryLogFormat::RECORD_FORMAT_DEFINITION) {
+            BinaryLogFormat::FormatDefinitionRecord definition;
+            std::memcpy(&definition, data.data() + offset, sizeof(definition));
+            const char* text = reinterpret_cast<const char*>(data.data() + offset + sizeof(definition));
+            formats[definition.formatId].assign(text, definition.formatLength);
+        }
+        records.push_back(offset);
+        offset += record.size;
+    }
+
+    // Second pass: messages
+    long messageCount = 0;
+    std::vector<DecodedArgument> arguments;
+
+    for (size_t recordOffset : records) {
+        BinaryLogFormat::RecordHeader record;
+        std::memcpy(&record, data.data() + recordOffset, sizeof(record));
+
+        if (record.type == BinaryLogFormat::RECORD_MESSAGE) {
+            BinaryLogFormat::MessageRecord message;
+            std::memcpy(&message, data.data() + recordOffset, sizeof(message));
+            const uint8_t* argumentData = data.data() + recordOffset + sizeof(message);
+
+            if (!decodeArguments(argumentData, message.argumentBytes, arguments) || arguments.empty()) {
+                std::cerr << "logdecode: corrupt message at offset " << recordOffset << " in " << path << std::endl;
+                continue;
+            }
+
+            auto format = formats.find(message.formatId);
+            const std::string& formatString = (format != formats.end()) ? format->second : std::string("<unknown format>");
+            const std::string& category = arguments[0].text;
+            std::string text = formatMessage(formatString, arguments);
+            int64_t systemTimeNs = header.systemTimeAtStartNs + (message.timestampNs - header.steadyTimeAtStartNs);
+
+            if (json) {
+                std::cout << (firstJsonEntry ? "\n" : ",\n");
+                firstJsonEntry = false;
+                std::cout << "  {\"timestampNs\": " << systemTimeNs
+                          << ", \"time\": \"" << formatTime(systemTimeNs) << "\""
+                          << ", \"level\": \"" << levelNameTrimmed(message.level) << "\""
+                          << ", \"thread\": " << message.threadId
+                          << ", \"category\": \"" << escapeJson(category) << "\""
+                          << ", \"message\": \"" << escapeJson(text) << "\"";
+                if (message.formatId != BinaryLogFormat::TEXT_MESSAGE_FORMAT_ID) {
+                    std::cout << ", \"format\": \"" << escapeJson(formatString) << "\", \"args\": [";
+                    for (size_t i = 1; i < arguments.size(); ++i) {
+                        std::cout << (i > 1 ? ", " : "") << jsonArgument(arguments[i]);
+                    }
+                    std::cout << "]";
+                }
+                std::cout << "}";
+            } else {
+                std::cout << "[" << formatTime(systemTimeNs) << "] [" << levelName(message.level) << "]"
+                          << "[tid " << message.threadId << "]";
+                if (!category.empty()) {
+                    std::cout << "[" << category << "]";
+                }
+                std::cout << " " << text << "\n";
+            }
+            messageCount++;
+        }
+    }
+
+    return messageCount;
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv) {
+    bool json = false;
+    std::vector<std::string> files;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string argument = argv[i];
+        if (argument == "--json") {
+            json = true;
+        } else if (argument == "--help" || argument == "-h") {
+            std::cout << "Usage: logdecode [--json] <file.blog> [more files...]" << std::endl;
+            return 0;
+        } else {
+            files.push_back(argument);
+        }
+    }
+
+    if (files.empty()) {
+        std::cerr << "Usage: logdecode [--json] <file.blog> [more files...]" << std::endl;
+        return 1;
+    }
+
+    bool firstJsonEntry = true;
+    bool failed = false;
+
+    if (json) {
+        std::cout << "[";
+    }
+    for (const std::string& file : files) {
+        if (decodeFile(file, json, firstJsonEntry) < 0) {
+            failed = true;
+        }
+    }
+    if (json) {
+        std::cout << "\n]" << std::endl;
+    }
+
+    return failed ? 1 : 0;
+}